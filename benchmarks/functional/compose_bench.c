@@ -0,0 +1,193 @@
+#include ".\functional_bench.h"
+
+
+// D_BENCH_COMPOSE_MAX_STAGES
+//   constant: most stages of a composed chain case.
+#define D_BENCH_COMPOSE_MAX_STAGES 64
+
+
+// d_bench_compose_state
+//   helper: the input and composition of a compose case.
+struct d_bench_compose_state
+{
+    struct d_bench_data            data;
+    struct d_composed_chain*       chain;
+    struct d_composed_transformer* pair;
+};
+
+// d_bench_compose_apply_array
+//   helper: one d_functional_compose_apply_array of the state's chain.
+static bool
+d_bench_compose_apply_array
+(
+    void* _context
+)
+{
+    struct d_bench_compose_state* state;
+
+    state = (struct d_bench_compose_state*)_context;
+
+    return d_functional_compose_apply_array(state->chain,
+                                            state->data.elements,
+                                            state->data.count,
+                                            state->data.element_size,
+                                            state->data.output);
+}
+
+// d_bench_compose_apply_pair
+//   helper: d_functional_compose_apply of the state's pair to every
+// element.
+static bool
+d_bench_compose_apply_pair
+(
+    void* _context
+)
+{
+    struct d_bench_compose_state* state;
+    size_t                        offset;
+    size_t                        i;
+
+    state = (struct d_bench_compose_state*)_context;
+
+    for (i = 0; i < state->data.count; i++)
+    {
+        offset = i * state->data.element_size;
+
+        if (!d_functional_compose_apply(state->pair,
+                                        state->data.elements + offset,
+                                        state->data.output + offset))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// d_bench_compose_chain
+//   helper: a composed chain of _length key-bumping stages over elements
+// of the state's size.
+static struct d_composed_chain*
+d_bench_compose_chain
+(
+    struct d_bench_compose_state* _state,
+    size_t                        _length
+)
+{
+    struct d_compose_stage stages[D_BENCH_COMPOSE_MAX_STAGES];
+    size_t                 i;
+
+    if ( (_length == 0) ||
+         (_length > D_BENCH_COMPOSE_MAX_STAGES) )
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < _length; i++)
+    {
+        stages[i].transform   = d_bench_bump_key;
+        stages[i].context     = &_state->data.element_size;
+        stages[i].output_size = _state->data.element_size;
+    }
+
+    return d_functional_compose_many(stages, _length);
+}
+
+
+/*
+d_bench_compose_all
+  Runs the composition scenarios over every element size and count: a
+d_functional_compose_many chain applied with
+d_functional_compose_apply_array over every chain length, and a
+d_functional_compose_new pair applied element by element.
+
+Parameter(s):
+  _bench: the run.
+Return:
+  true if every case succeeded.
+*/
+bool
+d_bench_compose_all
+(
+    struct d_bench* _bench
+)
+{
+    struct d_bench_compose_state state;
+    struct d_bench_case          bench_case;
+    const struct d_bench_sweep*  sweep;
+    size_t                       s;
+    size_t                       c;
+    size_t                       n;
+    bool                         result;
+
+    result = true;
+    sweep  = &_bench->sweep;
+
+    for (s = 0; s < sweep->element_size_count; s++)
+    {
+        for (c = 0; c < sweep->count_count; c++)
+        {
+            if (!d_bench_data_new(&state.data,
+                                  sweep->counts[c],
+                                  sweep->element_sizes[s],
+                                  0xC0DE + c))
+            {
+                return false;
+            }
+
+            bench_case.element_size = sweep->element_sizes[s];
+            bench_case.count        = sweep->counts[c];
+            bench_case.selectivity  = -1.0;
+            bench_case.scenario     = "compose/many";
+
+            for (n = 0; n < sweep->chain_length_count; n++)
+            {
+                bench_case.chain_length = sweep->chain_lengths[n];
+                state.chain             = d_bench_compose_chain(
+                                              &state,
+                                              sweep->chain_lengths[n]);
+
+                if (!state.chain)
+                {
+                    _bench->failed++;
+                    result = false;
+
+                    continue;
+                }
+
+                result = d_bench_run(_bench, &bench_case,
+                                     d_bench_compose_apply_array, &state) &&
+                         result;
+
+                d_functional_compose_many_free(state.chain);
+            }
+
+            bench_case.scenario     = "compose/pair";
+            bench_case.chain_length = 2;
+            state.pair              = d_functional_compose_new(
+                                          d_bench_bump_key,
+                                          &state.data.element_size,
+                                          d_bench_bump_key,
+                                          &state.data.element_size,
+                                          state.data.element_size);
+
+            if (!state.pair)
+            {
+                _bench->failed++;
+                result = false;
+            }
+            else
+            {
+                result = d_bench_run(_bench, &bench_case,
+                                     d_bench_compose_apply_pair, &state) &&
+                         result;
+
+                d_functional_compose_free(state.pair);
+            }
+
+            d_bench_data_free(&state.data);
+        }
+    }
+
+    return result;
+}
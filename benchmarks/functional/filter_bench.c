@@ -0,0 +1,723 @@
+#include ".\functional_bench.h"
+
+
+// D_BENCH_FILTER_STRIDE
+//   constant: spacing of the indices selected by the INDICES scenario.
+#define D_BENCH_FILTER_STRIDE 8
+
+// D_BENCH_FILTER_TOP_K
+//   constant: k of the TOP_K scenario.
+#define D_BENCH_FILTER_TOP_K 10
+
+// D_BENCH_FILTER_CLASSES
+//   constant: number of distinct keys the DISTINCT scenario compares by.
+// DISTINCT is quadratic in the number of distinct elements, so it is run
+// over key classes rather than the (nearly all unique) raw keys.
+#define D_BENCH_FILTER_CLASSES 256
+
+// D_BENCH_FILTER_MATCHING_MAX_COUNT
+//   constant: largest input the combinator and iterator scenarios run on.
+// Both map results back to input positions by comparing every result
+// element with every input element, so larger inputs take minutes.
+#ifndef D_BENCH_FILTER_MATCHING_MAX_COUNT
+    #define D_BENCH_FILTER_MATCHING_MAX_COUNT 10000
+#endif
+
+
+// d_bench_filter_state
+//   helper: the input and filters of a filter case.
+struct d_bench_filter_state
+{
+    struct d_bench_data           data;
+    struct d_filter_chain*        chain;
+    struct d_filter_chain*        second;
+    struct d_filter_union*        union_of;
+    struct d_filter_intersection* intersection;
+    struct d_filter_difference*   difference;
+    uint32_t                      thresholds[2];
+};
+
+// d_bench_filter_compare_class
+//   helper: orders elements by key class, for DISTINCT.
+static int
+d_bench_filter_compare_class
+(
+    const void* _a,
+    const void* _b,
+    void*       _context
+)
+{
+    uint32_t a;
+    uint32_t b;
+
+    (void)_context;
+
+    memcpy(&a, _a, sizeof(a));
+    memcpy(&b, _b, sizeof(b));
+
+    a %= D_BENCH_FILTER_CLASSES;
+    b %= D_BENCH_FILTER_CLASSES;
+
+    return (a > b) - (a < b);
+}
+
+// d_bench_filter_chain_of
+//   helper: a new chain holding _op, which is consumed. Returns NULL if
+// _op is NULL or allocation failed.
+static struct d_filter_chain*
+d_bench_filter_chain_of
+(
+    struct d_filter_operation* _op
+)
+{
+    struct d_filter_chain* chain;
+
+    if (!_op)
+    {
+        return NULL;
+    }
+
+    chain = d_filter_chain_new();
+
+    if ( (!chain) ||
+         (!d_filter_chain_add(chain, _op)) )
+    {
+        d_filter_operation_free(_op);
+        d_filter_chain_free(chain);
+
+        return NULL;
+    }
+
+    // the chain took a copy of the operation and its parameters
+    d_functional_free(_op);
+
+    return chain;
+}
+
+// d_bench_filter_none
+//   helper: a D_FILTER_OP_NONE operation, which has no constructor.
+static struct d_filter_operation*
+d_bench_filter_none
+(
+    void
+)
+{
+    struct d_filter_operation* op;
+
+    op = d_functional_malloc(sizeof(struct d_filter_operation));
+
+    // ensure that memory allocation was successful
+    if (!op)
+    {
+        return NULL;
+    }
+
+    memset(op, 0, sizeof(*op));
+
+    op->type = D_FILTER_OP_NONE;
+
+    return op;
+}
+
+// d_bench_filter_indices
+//   helper: an INDICES operation selecting every D_BENCH_FILTER_STRIDE-th
+// element of _count.
+static struct d_filter_operation*
+d_bench_filter_indices
+(
+    size_t _count
+)
+{
+    struct d_filter_operation* op;
+    size_t*                    indices;
+    size_t                     n;
+    size_t                     i;
+
+    n       = (_count + D_BENCH_FILTER_STRIDE - 1) / D_BENCH_FILTER_STRIDE;
+    indices = malloc(n * sizeof(size_t));
+
+    // ensure that memory allocation was successful
+    if (!indices)
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        indices[i] = i * D_BENCH_FILTER_STRIDE;
+    }
+
+    op = d_filter_at_indices(indices, n);
+
+    free(indices);
+
+    return op;
+}
+
+// d_bench_filter_result_ok
+//   helper: frees a filter result and its struct, reporting whether it
+// succeeded.
+static bool
+d_bench_filter_result_ok
+(
+    struct d_filter_result* _result
+)
+{
+    bool ok;
+
+    if (!_result)
+    {
+        return false;
+    }
+
+    ok = (_result->status == D_FILTER_RESULT_SUCCESS) ||
+         (_result->status == D_FILTER_RESULT_EMPTY);
+
+    d_filter_result_free(_result);
+    d_functional_free(_result);
+
+    return ok;
+}
+
+// d_bench_filter_apply_chain
+//   helper: one d_filter_apply_chain of the state's chain.
+static bool
+d_bench_filter_apply_chain
+(
+    void* _context
+)
+{
+    struct d_bench_filter_state* state;
+
+    state = (struct d_bench_filter_state*)_context;
+
+    return d_bench_filter_result_ok(
+               d_filter_apply_chain(state->chain,
+                                    state->data.elements,
+                                    state->data.count,
+                                    state->data.element_size));
+}
+
+// d_bench_filter_apply_union
+//   helper: one d_filter_apply_union.
+static bool
+d_bench_filter_apply_union
+(
+    void* _context
+)
+{
+    struct d_bench_filter_state* state;
+
+    state = (struct d_bench_filter_state*)_context;
+
+    return d_bench_filter_result_ok(
+               d_filter_apply_union(state->union_of,
+                                    state->data.elements,
+                                    state->data.count,
+                                    state->data.element_size));
+}
+
+// d_bench_filter_apply_intersection
+//   helper: one d_filter_apply_intersection.
+static bool
+d_bench_filter_apply_intersection
+(
+    void* _context
+)
+{
+    struct d_bench_filter_state* state;
+
+    state = (struct d_bench_filter_state*)_context;
+
+    return d_bench_filter_result_ok(
+               d_filter_apply_intersection(state->intersection,
+                                           state->data.elements,
+                                           state->data.count,
+                                           state->data.element_size));
+}
+
+// d_bench_filter_apply_difference
+//   helper: one d_filter_apply_difference.
+static bool
+d_bench_filter_apply_difference
+(
+    void* _context
+)
+{
+    struct d_bench_filter_state* state;
+
+    state = (struct d_bench_filter_state*)_context;
+
+    return d_bench_filter_result_ok(
+               d_filter_apply_difference(state->difference,
+                                         state->data.elements,
+                                         state->data.count,
+                                         state->data.element_size));
+}
+
+// d_bench_filter_iterate
+//   helper: one d_filter_iterator over the state's chain, visiting every
+// element it yields.
+static bool
+d_bench_filter_iterate
+(
+    void* _context
+)
+{
+    struct d_bench_filter_state* state;
+    struct d_filter_iterator*    iterator;
+    volatile uint32_t            sink;
+    uint32_t                     key;
+    void*                        element;
+
+    state    = (struct d_bench_filter_state*)_context;
+    iterator = d_filter_iterator_new(state->chain,
+                                     state->data.elements,
+                                     state->data.count,
+                                     state->data.element_size);
+
+    if (!iterator)
+    {
+        return false;
+    }
+
+    sink = 0;
+
+    while (d_filter_iterator_has_next(iterator))
+    {
+        element = d_filter_iterator_next(iterator);
+
+        if (element)
+        {
+            memcpy(&key, element, sizeof(key));
+            sink ^= key;
+        }
+    }
+
+    (void)sink;
+    d_filter_iterator_free(iterator);
+
+    return true;
+}
+
+// d_bench_filter_release
+//   helper: frees the filters of a case, keeping the input.
+static void
+d_bench_filter_release
+(
+    struct d_bench_filter_state* _state
+)
+{
+    d_filter_union_free(_state->union_of);
+    d_filter_intersection_free(_state->intersection);
+    d_filter_difference_free(_state->difference);
+    d_filter_chain_free(_state->chain);
+    d_filter_chain_free(_state->second);
+
+    _state->union_of     = NULL;
+    _state->intersection = NULL;
+    _state->difference   = NULL;
+    _state->chain        = NULL;
+    _state->second       = NULL;
+
+    return;
+}
+
+// d_bench_filter_measure
+//   helper: runs one case over the state's current filters, then releases
+// them. A case whose filters could not be built is reported as failed.
+static bool
+d_bench_filter_measure
+(
+    struct d_bench*              _bench,
+    struct d_bench_case*         _case,
+    const char*                  _scenario,
+    fn_bench_body                _body,
+    struct d_bench_filter_state* _state,
+    bool                         _built
+)
+{
+    bool result;
+
+    _case->scenario = _scenario;
+
+    if (!d_bench_wants(_bench, _scenario))
+    {
+        d_bench_filter_release(_state);
+
+        return true;
+    }
+
+    result = (_built) &&
+             d_bench_run(_bench, _case, _body, _state);
+
+    if (!_built)
+    {
+        _bench->failed++;
+        fprintf(stderr, "bench: could not build %s\n", _scenario);
+    }
+
+    d_bench_filter_release(_state);
+
+    return result;
+}
+
+// d_bench_filter_operations
+//   helper: every D_FILTER_OP_* as a one-operation chain over the state's
+// input. WHERE and WHERE_NOT are swept over the selectivities.
+static bool
+d_bench_filter_operations
+(
+    struct d_bench*              _bench,
+    struct d_bench_case*         _case,
+    struct d_bench_filter_state* _state
+)
+{
+    const struct d_bench_sweep* sweep;
+    size_t                      count;
+    size_t                      k;
+    bool                        result;
+
+    sweep  = &_bench->sweep;
+    count  = _state->data.count;
+    result = true;
+
+    _case->selectivity  = -1.0;
+    _case->chain_length = 1;
+
+    _state->chain = d_bench_filter_chain_of(d_bench_filter_none());
+    result = d_bench_filter_measure(_bench, _case, "filter/none",
+                 d_bench_filter_apply_chain, _state,
+                 (_state->chain != NULL)) && result;
+
+    _state->chain = d_bench_filter_chain_of(d_filter_take_first(count / 2));
+    result = d_bench_filter_measure(_bench, _case, "filter/take_first",
+                 d_bench_filter_apply_chain, _state,
+                 (_state->chain != NULL)) && result;
+
+    _state->chain = d_bench_filter_chain_of(d_filter_take_last(count / 2));
+    result = d_bench_filter_measure(_bench, _case, "filter/take_last",
+                 d_bench_filter_apply_chain, _state,
+                 (_state->chain != NULL)) && result;
+
+    _state->chain = d_bench_filter_chain_of(d_filter_skip_first(count / 2));
+    result = d_bench_filter_measure(_bench, _case, "filter/skip_first",
+                 d_bench_filter_apply_chain, _state,
+                 (_state->chain != NULL)) && result;
+
+    _state->chain = d_bench_filter_chain_of(d_filter_skip_last(count / 2));
+    result = d_bench_filter_measure(_bench, _case, "filter/skip_last",
+                 d_bench_filter_apply_chain, _state,
+                 (_state->chain != NULL)) && result;
+
+    _state->chain = d_bench_filter_chain_of(d_filter_take_nth(3));
+    result = d_bench_filter_measure(_bench, _case, "filter/take_nth",
+                 d_bench_filter_apply_chain, _state,
+                 (_state->chain != NULL)) && result;
+
+    _state->chain = d_bench_filter_chain_of(
+                        d_filter_range(count / 4, (3 * count) / 4));
+    result = d_bench_filter_measure(_bench, _case, "filter/range",
+                 d_bench_filter_apply_chain, _state,
+                 (_state->chain != NULL)) && result;
+
+    _state->chain = d_bench_filter_chain_of(d_filter_slice(0, count, 2));
+    result = d_bench_filter_measure(_bench, _case, "filter/slice",
+                 d_bench_filter_apply_chain, _state,
+                 (_state->chain != NULL)) && result;
+
+    _state->chain = d_bench_filter_chain_of(d_bench_filter_indices(count));
+    result = d_bench_filter_measure(_bench, _case, "filter/indices",
+                 d_bench_filter_apply_chain, _state,
+                 (_state->chain != NULL)) && result;
+
+    _state->chain = d_bench_filter_chain_of(
+                        d_filter_distinct(d_bench_filter_compare_class));
+    result = d_bench_filter_measure(_bench, _case, "filter/distinct",
+                 d_bench_filter_apply_chain, _state,
+                 (_state->chain != NULL)) && result;
+
+    _state->chain = d_bench_filter_chain_of(d_filter_reverse());
+    result = d_bench_filter_measure(_bench, _case, "filter/reverse",
+                 d_bench_filter_apply_chain, _state,
+                 (_state->chain != NULL)) && result;
+
+    _state->chain = d_bench_filter_chain_of(d_filter_head());
+    result = d_bench_filter_measure(_bench, _case, "filter/head",
+                 d_bench_filter_apply_chain, _state,
+                 (_state->chain != NULL)) && result;
+
+    _state->chain = d_bench_filter_chain_of(d_filter_tail());
+    result = d_bench_filter_measure(_bench, _case, "filter/tail",
+                 d_bench_filter_apply_chain, _state,
+                 (_state->chain != NULL)) && result;
+
+    _state->chain = d_bench_filter_chain_of(d_filter_init());
+    result = d_bench_filter_measure(_bench, _case, "filter/init",
+                 d_bench_filter_apply_chain, _state,
+                 (_state->chain != NULL)) && result;
+
+    _state->chain = d_bench_filter_chain_of(d_filter_rest());
+    result = d_bench_filter_measure(_bench, _case, "filter/rest",
+                 d_bench_filter_apply_chain, _state,
+                 (_state->chain != NULL)) && result;
+
+    _state->chain = d_bench_filter_chain_of(
+                        d_filter_top_k(D_BENCH_FILTER_TOP_K,
+                                       d_bench_compare_key,
+                                       NULL));
+    result = d_bench_filter_measure(_bench, _case, "filter/top_k",
+                 d_bench_filter_apply_chain, _state,
+                 (_state->chain != NULL)) && result;
+
+    for (k = 0; k < sweep->selectivity_count; k++)
+    {
+        _case->selectivity = sweep->selectivities[k];
+
+        // WHERE keeps keys below the threshold
+        _state->thresholds[0] = d_bench_threshold(sweep->selectivities[k]);
+        _state->chain = d_bench_filter_chain_of(
+                            d_filter_where_context(d_bench_key_below,
+                                                   &_state->thresholds[0]));
+        result = d_bench_filter_measure(_bench, _case, "filter/where",
+                     d_bench_filter_apply_chain, _state,
+                     (_state->chain != NULL)) && result;
+
+        // WHERE_NOT drops keys at or above the threshold
+        _state->chain = d_bench_filter_chain_of(
+                            d_filter_where_not_context(
+                                d_bench_key_at_least,
+                                &_state->thresholds[0]));
+        result = d_bench_filter_measure(_bench, _case, "filter/where_not",
+                     d_bench_filter_apply_chain, _state,
+                     (_state->chain != NULL)) && result;
+    }
+
+    return result;
+}
+
+// d_bench_filter_where_chain
+//   helper: a chain of _length WHERE operations whose combined selectivity
+// is that of the state's first threshold; the first operation does all
+// the selecting and the rest keep every survivor.
+static struct d_filter_chain*
+d_bench_filter_where_chain
+(
+    struct d_bench_filter_state* _state,
+    size_t                       _length
+)
+{
+    struct d_filter_chain* chain;
+    size_t                 i;
+
+    chain = d_bench_filter_chain_of(
+                d_filter_where_context(d_bench_key_below,
+                                       &_state->thresholds[0]));
+
+    for (i = 1; (chain) && (i < _length); i++)
+    {
+        struct d_filter_operation* op;
+
+        op = d_filter_where_context(d_bench_key_below,
+                                    &_state->thresholds[0]);
+
+        if ( (!op) ||
+             (!d_filter_chain_add(chain, op)) )
+        {
+            d_filter_operation_free(op);
+            d_filter_chain_free(chain);
+
+            return NULL;
+        }
+
+        d_functional_free(op);
+    }
+
+    return chain;
+}
+
+// d_bench_filter_combinators
+//   helper: union, intersection, and difference of two WHERE chains whose
+// result keeps the selectivity's fraction of the input.
+static bool
+d_bench_filter_combinators
+(
+    struct d_bench*              _bench,
+    struct d_bench_case*         _case,
+    struct d_bench_filter_state* _state,
+    double                       _selectivity
+)
+{
+    bool result;
+    bool built;
+
+    result              = true;
+    _case->selectivity  = _selectivity;
+    _case->chain_length = 2;
+
+    // union: the lowest s/2 or the highest s/2 of the keys
+    _state->thresholds[0] = d_bench_threshold(_selectivity / 2.0);
+    _state->thresholds[1] = d_bench_threshold(1.0 - (_selectivity / 2.0));
+    _state->chain         = d_bench_filter_chain_of(
+                                d_filter_where_context(
+                                    d_bench_key_below,
+                                    &_state->thresholds[0]));
+    _state->second        = d_bench_filter_chain_of(
+                                d_filter_where_context(
+                                    d_bench_key_at_least,
+                                    &_state->thresholds[1]));
+    _state->union_of      = d_filter_union_new(2);
+    built = (_state->chain)    &&
+            (_state->second)   &&
+            (_state->union_of) &&
+            d_filter_union_add(_state->union_of, _state->chain) &&
+            d_filter_union_add(_state->union_of, _state->second);
+    result = d_bench_filter_measure(_bench, _case, "filter/union",
+                 d_bench_filter_apply_union, _state, built) && result;
+
+    // intersection: the middle s of the keys
+    _state->thresholds[0] = d_bench_threshold((1.0 - _selectivity) / 2.0);
+    _state->thresholds[1] = d_bench_threshold((1.0 + _selectivity) / 2.0);
+    _state->chain         = d_bench_filter_chain_of(
+                                d_filter_where_context(
+                                    d_bench_key_at_least,
+                                    &_state->thresholds[0]));
+    _state->second        = d_bench_filter_chain_of(
+                                d_filter_where_context(
+                                    d_bench_key_below,
+                                    &_state->thresholds[1]));
+    _state->intersection  = d_filter_intersection_new(2);
+    built = (_state->chain)        &&
+            (_state->second)       &&
+            (_state->intersection) &&
+            d_filter_intersection_add(_state->intersection,
+                                      _state->chain) &&
+            d_filter_intersection_add(_state->intersection,
+                                      _state->second);
+    result = d_bench_filter_measure(_bench, _case, "filter/intersection",
+                 d_bench_filter_apply_intersection, _state, built) &&
+             result;
+
+    // difference: the lowest (1+s)/2 of the keys minus the lowest (1-s)/2
+    _state->thresholds[0] = d_bench_threshold((1.0 + _selectivity) / 2.0);
+    _state->thresholds[1] = d_bench_threshold((1.0 - _selectivity) / 2.0);
+    _state->chain         = d_bench_filter_chain_of(
+                                d_filter_where_context(
+                                    d_bench_key_below,
+                                    &_state->thresholds[0]));
+    _state->second        = d_bench_filter_chain_of(
+                                d_filter_where_context(
+                                    d_bench_key_below,
+                                    &_state->thresholds[1]));
+    built = (_state->chain) &&
+            (_state->second);
+
+    if (built)
+    {
+        _state->difference = d_filter_difference_new(_state->chain,
+                                                     _state->second);
+        built              = (_state->difference != NULL);
+    }
+
+    result = d_bench_filter_measure(_bench, _case, "filter/difference",
+                 d_bench_filter_apply_difference, _state, built) && result;
+
+    return result;
+}
+
+
+/*
+d_bench_filter_all
+  Runs the filter scenarios over every element size and count: each
+D_FILTER_OP_* through d_filter_apply_chain, WHERE chains of every chain
+length, the union, intersection, and difference combinators, and a
+d_filter_iterator, the predicate-driven ones over every selectivity. The
+combinators and the iterator are skipped for counts above
+D_BENCH_FILTER_MATCHING_MAX_COUNT.
+
+Parameter(s):
+  _bench: the run.
+Return:
+  true if every case succeeded.
+*/
+bool
+d_bench_filter_all
+(
+    struct d_bench* _bench
+)
+{
+    struct d_bench_filter_state state;
+    struct d_bench_case         bench_case;
+    const struct d_bench_sweep* sweep;
+    size_t                      s;
+    size_t                      c;
+    size_t                      k;
+    size_t                      n;
+    bool                        result;
+
+    result = true;
+    sweep  = &_bench->sweep;
+
+    memset(&state, 0, sizeof(state));
+
+    for (s = 0; s < sweep->element_size_count; s++)
+    {
+        for (c = 0; c < sweep->count_count; c++)
+        {
+            if (!d_bench_data_new(&state.data,
+                                  sweep->counts[c],
+                                  sweep->element_sizes[s],
+                                  0xF11 + c))
+            {
+                return false;
+            }
+
+            bench_case.element_size = sweep->element_sizes[s];
+            bench_case.count        = sweep->counts[c];
+
+            result = d_bench_filter_operations(_bench, &bench_case, &state) &&
+                     result;
+
+            for (k = 0; k < sweep->selectivity_count; k++)
+            {
+                bench_case.selectivity = sweep->selectivities[k];
+                state.thresholds[0]    = d_bench_threshold(
+                                             sweep->selectivities[k]);
+
+                for (n = 0; n < sweep->chain_length_count; n++)
+                {
+                    bench_case.chain_length = sweep->chain_lengths[n];
+                    state.chain = d_bench_filter_where_chain(
+                                      &state, sweep->chain_lengths[n]);
+                    result = d_bench_filter_measure(_bench, &bench_case,
+                                 "filter/chain_where",
+                                 d_bench_filter_apply_chain, &state,
+                                 (state.chain != NULL)) && result;
+                }
+
+                // the matching scenarios are quadratic in the input
+                if (sweep->counts[c] > D_BENCH_FILTER_MATCHING_MAX_COUNT)
+                {
+                    continue;
+                }
+
+                bench_case.chain_length = 1;
+                state.chain = d_bench_filter_where_chain(&state, 1);
+                result = d_bench_filter_measure(_bench, &bench_case,
+                             "filter/iterator",
+                             d_bench_filter_iterate, &state,
+                             (state.chain != NULL)) && result;
+
+                result = d_bench_filter_combinators(_bench,
+                                                    &bench_case,
+                                                    &state,
+                                                    sweep->selectivities[k]) &&
+                         result;
+            }
+
+            d_bench_data_free(&state.data);
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,161 @@
+#include ".\functional_bench.h"
+
+
+// d_bench_fn_builder_state
+//   helper: the input and builder of a fn_builder case.
+struct d_bench_fn_builder_state
+{
+    struct d_bench_data  data;
+    struct d_fn_builder* builder;
+    size_t               out_count;
+};
+
+// d_bench_fn_builder_low_half
+//   helper: keeps elements whose key is in the lower half of its range.
+// fn_builder calls its predicates without a context, so the threshold is
+// fixed.
+static bool
+d_bench_fn_builder_low_half
+(
+    const void* _element,
+    void*       _context
+)
+{
+    uint32_t key;
+
+    (void)_context;
+
+    memcpy(&key, _element, sizeof(key));
+
+    return (key < 0x80000000u);
+}
+
+// d_bench_fn_builder_execute
+//   helper: one d_fn_builder_execute of the state's builder.
+static bool
+d_bench_fn_builder_execute
+(
+    void* _context
+)
+{
+    struct d_bench_fn_builder_state* state;
+
+    state = (struct d_bench_fn_builder_state*)_context;
+
+    return d_fn_builder_execute(state->builder,
+                                state->data.elements,
+                                state->data.count,
+                                state->data.element_size,
+                                state->data.output,
+                                &state->out_count);
+}
+
+// d_bench_fn_builder_build
+//   helper: a builder of _length key-bumping maps followed by the
+// lower-half predicate.
+static struct d_fn_builder*
+d_bench_fn_builder_build
+(
+    size_t _length
+)
+{
+    struct d_fn_builder* builder;
+    size_t               i;
+
+    builder = d_fn_builder_new();
+
+    for (i = 0; (builder) && (i < _length); i++)
+    {
+        if (!d_funtional_builder_map(builder, d_bench_bump_key))
+        {
+            d_fn_builder_free(builder);
+
+            return NULL;
+        }
+    }
+
+    if ( (builder) &&
+         (!d_funtional_builder_filter(builder, d_bench_fn_builder_low_half)) )
+    {
+        d_fn_builder_free(builder);
+
+        return NULL;
+    }
+
+    return builder;
+}
+
+
+/*
+d_bench_fn_builder_all
+  Runs d_fn_builder_execute over every count and chain length. The
+builder's transformers get no context, so the elements are 4-byte keys.
+
+Parameter(s):
+  _bench: the run.
+Return:
+  true if every case succeeded.
+*/
+bool
+d_bench_fn_builder_all
+(
+    struct d_bench* _bench
+)
+{
+    struct d_bench_fn_builder_state state;
+    struct d_bench_case             bench_case;
+    const struct d_bench_sweep*     sweep;
+    size_t                          c;
+    size_t                          n;
+    bool                            result;
+
+    result = true;
+    sweep  = &_bench->sweep;
+
+    if (!d_bench_wants(_bench, "fn_builder/execute"))
+    {
+        return true;
+    }
+
+    bench_case.scenario     = "fn_builder/execute";
+    bench_case.element_size = sizeof(uint32_t);
+    bench_case.selectivity  = 0.5;
+
+    for (c = 0; c < sweep->count_count; c++)
+    {
+        if (!d_bench_data_new(&state.data,
+                              sweep->counts[c],
+                              sizeof(uint32_t),
+                              0xB1D + c))
+        {
+            return false;
+        }
+
+        bench_case.count = sweep->counts[c];
+
+        for (n = 0; n < sweep->chain_length_count; n++)
+        {
+            bench_case.chain_length = sweep->chain_lengths[n];
+            state.builder           = d_bench_fn_builder_build(
+                                          sweep->chain_lengths[n]);
+
+            if (!state.builder)
+            {
+                _bench->failed++;
+                result = false;
+
+                continue;
+            }
+
+            result = d_bench_run(_bench, &bench_case,
+                                 d_bench_fn_builder_execute, &state) &&
+                     result;
+
+            d_fn_builder_free(state.builder);
+        }
+
+        d_bench_data_free(&state.data);
+    }
+
+    return result;
+}
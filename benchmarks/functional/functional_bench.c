@@ -0,0 +1,658 @@
+#include ".\functional_bench.h"
+
+
+// D_BENCH_LENGTH
+//   macro: number of elements of a static array.
+#define D_BENCH_LENGTH(array) (sizeof(array) / sizeof((array)[0]))
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             I.    ALLOCATION COUNTING                                   ///
+///////////////////////////////////////////////////////////////////////////////
+
+// d_bench_allocation_count
+//   static: heap allocations (malloc, calloc, realloc) made so far; only
+// maintained with D_BENCH_WRAP_MALLOC.
+static size_t d_bench_allocation_count = 0;
+
+#if defined(D_BENCH_WRAP_MALLOC)
+
+void* __real_malloc(size_t _size);
+void* __real_calloc(size_t _count, size_t _size);
+void* __real_realloc(void* _block, size_t _size);
+void  __real_free(void* _block);
+
+/*
+__wrap_malloc, __wrap_calloc, __wrap_realloc, __wrap_free
+  Linker wrappers (-Wl,--wrap=...) counting the allocations of everything
+linked into the benchmark, then forwarding to the C library.
+*/
+void*
+__wrap_malloc
+(
+    size_t _size
+)
+{
+    d_bench_allocation_count++;
+
+    return __real_malloc(_size);
+}
+
+void*
+__wrap_calloc
+(
+    size_t _count,
+    size_t _size
+)
+{
+    d_bench_allocation_count++;
+
+    return __real_calloc(_count, _size);
+}
+
+void*
+__wrap_realloc
+(
+    void*  _block,
+    size_t _size
+)
+{
+    d_bench_allocation_count++;
+
+    return __real_realloc(_block, _size);
+}
+
+void
+__wrap_free
+(
+    void* _block
+)
+{
+    __real_free(_block);
+
+    return;
+}
+
+#endif  // D_BENCH_WRAP_MALLOC
+
+/*
+d_bench_allocations
+  Reads the number of heap allocations made so far.
+
+Parameter(s):
+  (none)
+Return:
+  The count, or (size_t)-1 if allocations are not being counted (the
+benchmark was built without D_BENCH_WRAP_MALLOC).
+*/
+size_t
+d_bench_allocations
+(
+    void
+)
+{
+#if defined(D_BENCH_WRAP_MALLOC)
+    return d_bench_allocation_count;
+#else
+    (void)d_bench_allocation_count;
+
+    return (size_t)-1;
+#endif
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             II.   HARNESS                                               ///
+///////////////////////////////////////////////////////////////////////////////
+
+// the full sweep
+static const size_t d_bench_full_sizes[]        = { 4, 8, 16, 64 };
+static const size_t d_bench_full_counts[]       = { 1000, 100000, 1000000 };
+static const double d_bench_full_selectivity[]  = { 0.01, 0.5, 0.99 };
+static const size_t d_bench_full_lengths[]      = { 1, 4, 16 };
+
+// the quick sweep, for smoke runs
+static const size_t d_bench_quick_sizes[]       = { 4, 16 };
+static const size_t d_bench_quick_counts[]      = { 1000, 10000 };
+static const double d_bench_quick_selectivity[] = { 0.5 };
+static const size_t d_bench_quick_lengths[]     = { 1, 4 };
+
+/*
+d_bench_begin
+  Starts a benchmark run: sets the default minimum time and the sweep, and
+writes the opening of the JSON report.
+
+Parameter(s):
+  _bench:  the run to start.
+  _output: where the report is written.
+  _quick:  true for the small sweep, false for the full one.
+Return:
+  true if started, false if a parameter is NULL.
+*/
+bool
+d_bench_begin
+(
+    struct d_bench* _bench,
+    FILE*           _output,
+    bool            _quick
+)
+{
+    // validate parameters
+    if ( (!_bench) ||
+         (!_output) )
+    {
+        return false;
+    }
+
+    memset(_bench, 0, sizeof(*_bench));
+
+    _bench->output      = _output;
+    _bench->min_time_ns = (uint64_t)D_BENCH_MIN_TIME_MS * 1000000u;
+
+    if (_quick)
+    {
+        _bench->sweep.element_sizes      = d_bench_quick_sizes;
+        _bench->sweep.element_size_count =
+            D_BENCH_LENGTH(d_bench_quick_sizes);
+        _bench->sweep.counts             = d_bench_quick_counts;
+        _bench->sweep.count_count        =
+            D_BENCH_LENGTH(d_bench_quick_counts);
+        _bench->sweep.selectivities      = d_bench_quick_selectivity;
+        _bench->sweep.selectivity_count  =
+            D_BENCH_LENGTH(d_bench_quick_selectivity);
+        _bench->sweep.chain_lengths      = d_bench_quick_lengths;
+        _bench->sweep.chain_length_count =
+            D_BENCH_LENGTH(d_bench_quick_lengths);
+    }
+    else
+    {
+        _bench->sweep.element_sizes      = d_bench_full_sizes;
+        _bench->sweep.element_size_count =
+            D_BENCH_LENGTH(d_bench_full_sizes);
+        _bench->sweep.counts             = d_bench_full_counts;
+        _bench->sweep.count_count        =
+            D_BENCH_LENGTH(d_bench_full_counts);
+        _bench->sweep.selectivities      = d_bench_full_selectivity;
+        _bench->sweep.selectivity_count  =
+            D_BENCH_LENGTH(d_bench_full_selectivity);
+        _bench->sweep.chain_lengths      = d_bench_full_lengths;
+        _bench->sweep.chain_length_count =
+            D_BENCH_LENGTH(d_bench_full_lengths);
+    }
+
+    fprintf(_output,
+            "{\n  \"suite\": \"djinterp-functional\",\n"
+            "  \"format\": %d,\n"
+            "  \"allocations_counted\": %s,\n"
+            "  \"results\": [",
+            D_BENCH_FORMAT_VERSION,
+            (d_bench_allocations() == (size_t)-1) ? "false" : "true");
+
+    return true;
+}
+
+/*
+d_bench_wants
+  Tests whether a scenario is selected: every scenario is, unless the run
+was limited to names containing `only`.
+
+Parameter(s):
+  _bench:    the run.
+  _scenario: the scenario name.
+Return:
+  true if the scenario should run.
+*/
+bool
+d_bench_wants
+(
+    const struct d_bench* _bench,
+    const char*           _scenario
+)
+{
+    return (!_bench->only) ||
+           (strstr(_scenario, _bench->only) != NULL);
+}
+
+/*
+d_bench_report
+  Internal helper: writes one case as a JSON object.
+*/
+static void
+d_bench_report
+(
+    struct d_bench*            _bench,
+    const struct d_bench_case* _case,
+    bool                       _ok,
+    size_t                     _iterations,
+    uint64_t                   _elapsed,
+    size_t                     _allocations
+)
+{
+    double elements;
+    double seconds;
+
+    elements = (double)_iterations * (double)_case->count;
+    seconds  = (double)_elapsed / 1e9;
+
+    fprintf(_bench->output,
+            "%s\n    { \"scenario\": \"%s\", \"element_size\": %zu, "
+            "\"count\": %zu, ",
+            (_bench->reported > 0) ? "," : "",
+            _case->scenario,
+            _case->element_size,
+            _case->count);
+
+    if (_case->selectivity < 0.0)
+    {
+        fprintf(_bench->output, "\"selectivity\": null, ");
+    }
+    else
+    {
+        fprintf(_bench->output, "\"selectivity\": %g, ", _case->selectivity);
+    }
+
+    if (_case->chain_length == 0)
+    {
+        fprintf(_bench->output, "\"chain_length\": null, ");
+    }
+    else
+    {
+        fprintf(_bench->output, "\"chain_length\": %zu, ",
+                _case->chain_length);
+    }
+
+    fprintf(_bench->output, "\"ok\": %s, \"iterations\": %zu, ",
+            (_ok) ? "true" : "false",
+            _iterations);
+
+    if ( (!_ok) ||
+         (elements <= 0.0) ||
+         (seconds <= 0.0) )
+    {
+        fprintf(_bench->output,
+                "\"ns_per_element\": null, \"bytes_per_second\": null, ");
+    }
+    else
+    {
+        fprintf(_bench->output,
+                "\"ns_per_element\": %.4f, \"bytes_per_second\": %.6g, ",
+                (double)_elapsed / elements,
+                (elements * (double)_case->element_size) / seconds);
+    }
+
+    if ( (!_ok) ||
+         (_allocations == (size_t)-1) )
+    {
+        fprintf(_bench->output, "\"allocations_per_iteration\": null, ");
+    }
+    else
+    {
+        fprintf(_bench->output, "\"allocations_per_iteration\": %.2f, ",
+                (double)_allocations / (double)_iterations);
+    }
+
+    fprintf(_bench->output, "\"peak_rss_bytes\": %zu }",
+            d_functional_peak_rss());
+
+    _bench->reported++;
+
+    return;
+}
+
+/*
+d_bench_run
+  Measures one case. The body runs once to warm caches, then in batches
+that double in size until a batch takes at least the minimum time; that
+batch is reported. A failing body is reported with "ok": false.
+
+Parameter(s):
+  _bench:   the run.
+  _case:    the parameters being measured.
+  _body:    one iteration.
+  _context: forwarded to _body.
+Return:
+  true if the body succeeded, false otherwise.
+*/
+bool
+d_bench_run
+(
+    struct d_bench*            _bench,
+    const struct d_bench_case* _case,
+    fn_bench_body              _body,
+    void*                      _context
+)
+{
+    uint64_t start;
+    uint64_t elapsed;
+    size_t   allocations;
+    size_t   before;
+    size_t   iterations;
+    size_t   i;
+    bool     ok;
+
+    // validate parameters
+    if ( (!_bench) ||
+         (!_case)  ||
+         (!_body) )
+    {
+        return false;
+    }
+
+    if (!d_bench_wants(_bench, _case->scenario))
+    {
+        return true;
+    }
+
+    iterations = 1;
+    elapsed    = 0;
+    before     = 0;
+    ok         = _body(_context);
+
+    while (ok)
+    {
+        before = d_bench_allocations();
+        start  = d_functional_nanoseconds();
+
+        for (i = 0; (ok) && (i < iterations); i++)
+        {
+            ok = _body(_context);
+        }
+
+        elapsed = d_functional_nanoseconds() - start;
+
+        if ( (elapsed >= _bench->min_time_ns) ||
+             (iterations >= D_BENCH_MAX_ITERATIONS) )
+        {
+            break;
+        }
+
+        iterations *= 2;
+    }
+
+    allocations = d_bench_allocations();
+
+    if (allocations != (size_t)-1)
+    {
+        allocations -= before;
+    }
+
+    if (!ok)
+    {
+        _bench->failed++;
+    }
+
+    d_bench_report(_bench, _case, ok, iterations, elapsed, allocations);
+
+    return ok;
+}
+
+/*
+d_bench_end
+  Closes the JSON report.
+
+Parameter(s):
+  _bench: the run.
+Return:
+  none.
+*/
+void
+d_bench_end
+(
+    struct d_bench* _bench
+)
+{
+    if (!_bench)
+    {
+        return;
+    }
+
+    fprintf(_bench->output,
+            "\n  ],\n  \"failed\": %zu\n}\n",
+            _bench->failed);
+    fflush(_bench->output);
+
+    return;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             III.  INPUT DATA                                            ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_bench_data_new
+  Generates an input of _count elements of _element_size bytes (at least
+4) from a seed, and an output buffer of the same size.
+
+Parameter(s):
+  _data:         receives the input.
+  _count:        the number of elements.
+  _element_size: the size of each element in bytes; at least 4.
+  _seed:         the generator seed; equal seeds give equal data.
+Return:
+  true if generated, false if a parameter is invalid or allocation failed.
+*/
+bool
+d_bench_data_new
+(
+    struct d_bench_data* _data,
+    size_t               _count,
+    size_t               _element_size,
+    uint64_t             _seed
+)
+{
+    uint64_t state;
+    uint32_t key;
+    size_t   i;
+    size_t   j;
+
+    // validate parameters
+    if ( (!_data)                             ||
+         (_count == 0)                        ||
+         (_element_size < sizeof(uint32_t)) )
+    {
+        return false;
+    }
+
+    _data->element_size = _element_size;
+    _data->count        = _count;
+    _data->elements     = malloc(_count * _element_size);
+    _data->output       = malloc(_count * _element_size);
+
+    // ensure that memory allocation was successful
+    if ( (!_data->elements) ||
+         (!_data->output) )
+    {
+        d_bench_data_free(_data);
+
+        return false;
+    }
+
+    state = _seed | 1;
+
+    for (i = 0; i < _count; i++)
+    {
+        // xorshift64*
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        key    = (uint32_t)((state * 0x2545F4914F6CDD1Dull) >> 32);
+
+        memcpy(_data->elements + (i * _element_size), &key, sizeof(key));
+
+        for (j = sizeof(key); j < _element_size; j++)
+        {
+            _data->elements[(i * _element_size) + j] = (unsigned char)(i + j);
+        }
+    }
+
+    return true;
+}
+
+/*
+d_bench_data_free
+  Frees a generated input.
+
+Parameter(s):
+  _data: the input; may be NULL.
+Return:
+  none.
+*/
+void
+d_bench_data_free
+(
+    struct d_bench_data* _data
+)
+{
+    if (!_data)
+    {
+        return;
+    }
+
+    free(_data->elements);
+    free(_data->output);
+
+    _data->elements = NULL;
+    _data->output   = NULL;
+
+    return;
+}
+
+/*
+d_bench_threshold
+  Converts a selectivity to the key threshold d_bench_key_below keeps that
+fraction of a generated input under.
+
+Parameter(s):
+  _selectivity: the fraction in [0, 1].
+Return:
+  The threshold.
+*/
+uint32_t
+d_bench_threshold
+(
+    double _selectivity
+)
+{
+    if (_selectivity <= 0.0)
+    {
+        return 0;
+    }
+
+    if (_selectivity >= 1.0)
+    {
+        return UINT32_MAX;
+    }
+
+    return (uint32_t)(_selectivity * 4294967296.0);
+}
+
+/*
+d_bench_key_below
+  Predicate: the element's key is below the uint32_t threshold in
+_context.
+*/
+bool
+d_bench_key_below
+(
+    const void* _element,
+    void*       _context
+)
+{
+    uint32_t key;
+
+    memcpy(&key, _element, sizeof(key));
+
+    return (key < *(const uint32_t*)_context);
+}
+
+/*
+d_bench_key_at_least
+  Predicate: the element's key is at least the uint32_t threshold in
+_context.
+*/
+bool
+d_bench_key_at_least
+(
+    const void* _element,
+    void*       _context
+)
+{
+    uint32_t key;
+
+    memcpy(&key, _element, sizeof(key));
+
+    return (key >= *(const uint32_t*)_context);
+}
+
+/*
+d_bench_compare_key
+  Comparator: orders elements by key.
+*/
+int
+d_bench_compare_key
+(
+    const void* _a,
+    const void* _b,
+    void*       _context
+)
+{
+    uint32_t a;
+    uint32_t b;
+
+    (void)_context;
+
+    memcpy(&a, _a, sizeof(a));
+    memcpy(&b, _b, sizeof(b));
+
+    return (a > b) - (a < b);
+}
+
+/*
+d_bench_bump_key
+  Transformer: copies the element and adds one to its key. _context points
+to the element size, or is NULL for 4-byte elements.
+*/
+bool
+d_bench_bump_key
+(
+    const void* _input,
+    void*       _output,
+    void*       _context
+)
+{
+    uint32_t key;
+
+    if (_context)
+    {
+        memcpy(_output, _input, *(const size_t*)_context);
+    }
+
+    memcpy(&key, _input, sizeof(key));
+    key++;
+    memcpy(_output, &key, sizeof(key));
+
+    return true;
+}
+
+/*
+d_bench_sum_key
+  Accumulator: adds the element's key to a uint64_t sum.
+*/
+bool
+d_bench_sum_key
+(
+    void*       _accumulated,
+    const void* _element,
+    void*       _context
+)
+{
+    uint32_t key;
+
+    (void)_context;
+
+    memcpy(&key, _element, sizeof(key));
+    *(uint64_t*)_accumulated += key;
+
+    return true;
+}
@@ -0,0 +1,142 @@
+/******************************************************************************
+* djinterp [bench]                                         functional_bench.h
+*
+*   Benchmark harness for the functional module.
+*   Each scenario times one hot path - d_functional_map / filter /
+* fold_left, every D_FILTER_OP_* through d_filter_apply_chain, the filter
+* combinators, d_filter_iterator, d_fn_builder_execute, pipelines, and
+* composed transformers - over a sweep of element sizes, element counts,
+* selectivities, and chain lengths. A case is repeated until it has run for
+* at least the minimum time, and reported as one JSON object with its
+* nanoseconds per element, bytes per second, allocations per iteration, and
+* the process's peak resident set size, so that runs can be compared by a
+* script and upgrades gated on regressions.
+*   Allocations are counted when the benchmark is linked with
+* -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free and built
+* with D_BENCH_WRAP_MALLOC defined; otherwise they are reported as null.
+*
+*
+* path:      \benchmarks\functional\functional_bench.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_BENCH_FUNCTIONAL_
+#define DJINTERP_BENCH_FUNCTIONAL_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "..\..\inc\djinterp.h"
+#include "..\..\inc\functional\functional.h"
+#include "..\..\inc\functional\filter.h"
+#include "..\..\inc\functional\functional_platform.h"
+
+
+// D_BENCH_MIN_TIME_MS
+//   constant: default minimum measured time of each case, in milliseconds.
+#ifndef D_BENCH_MIN_TIME_MS
+    #define D_BENCH_MIN_TIME_MS 200
+#endif
+
+// D_BENCH_MAX_ITERATIONS
+//   constant: most repetitions of a case, however fast it is.
+#ifndef D_BENCH_MAX_ITERATIONS
+    #define D_BENCH_MAX_ITERATIONS (1u << 24)
+#endif
+
+// D_BENCH_FORMAT_VERSION
+//   constant: version of the JSON report layout.
+#define D_BENCH_FORMAT_VERSION 1
+
+
+// fn_bench_body
+//   function pointer: one iteration of a case. Returns false if the
+// operation under test failed.
+typedef bool (*fn_bench_body)(void* _context);
+
+// d_bench_sweep
+//   struct: the values a sweep runs over.
+struct d_bench_sweep
+{
+    const size_t* element_sizes;
+    size_t        element_size_count;
+    const size_t* counts;
+    size_t        count_count;
+    const double* selectivities;
+    size_t        selectivity_count;
+    const size_t* chain_lengths;
+    size_t        chain_length_count;
+};
+
+// d_bench
+//   struct: a benchmark run writing its report to `output`.
+struct d_bench
+{
+    FILE*                output;
+    const char*          only;         // run scenarios containing this
+    uint64_t             min_time_ns;  // minimum measured time per case
+    struct d_bench_sweep sweep;
+    size_t               reported;     // cases written so far
+    size_t               failed;       // cases whose body failed
+};
+
+// d_bench_case
+//   struct: the parameters of one measured case.
+struct d_bench_case
+{
+    const char* scenario;      // "module/operation"
+    size_t      element_size;  // bytes per element
+    size_t      count;         // elements per iteration
+    double      selectivity;   // fraction kept; negative if not applicable
+    size_t      chain_length;  // operations or stages; 0 if not applicable
+};
+
+// d_bench_data
+//   struct: a generated input. Every element starts with a uniformly
+// distributed uint32_t key; the remaining bytes are filler.
+struct d_bench_data
+{
+    unsigned char* elements;
+    unsigned char* output;        // room for count elements
+    size_t         element_size;
+    size_t         count;
+};
+
+
+/******************************************************************************
+ * I. HARNESS
+ *****************************************************************************/
+bool   d_bench_begin(struct d_bench* _bench, FILE* _output, bool _quick);
+bool   d_bench_wants(const struct d_bench* _bench, const char* _scenario);
+bool   d_bench_run(struct d_bench* _bench, const struct d_bench_case* _case, fn_bench_body _body, void* _context);
+void   d_bench_end(struct d_bench* _bench);
+size_t d_bench_allocations(void);
+
+
+/******************************************************************************
+ * II. INPUT DATA
+ *****************************************************************************/
+bool     d_bench_data_new(struct d_bench_data* _data, size_t _count, size_t _element_size, uint64_t _seed);
+void     d_bench_data_free(struct d_bench_data* _data);
+uint32_t d_bench_threshold(double _selectivity);
+bool     d_bench_key_below(const void* _element, void* _context);
+bool     d_bench_key_at_least(const void* _element, void* _context);
+int      d_bench_compare_key(const void* _a, const void* _b, void* _context);
+bool     d_bench_bump_key(const void* _input, void* _output, void* _context);
+bool     d_bench_sum_key(void* _accumulated, const void* _element, void* _context);
+
+
+/******************************************************************************
+ * III. SCENARIOS
+ *****************************************************************************/
+bool d_bench_functional_common_all(struct d_bench* _bench);
+bool d_bench_filter_all(struct d_bench* _bench);
+bool d_bench_fn_builder_all(struct d_bench* _bench);
+bool d_bench_pipeline_all(struct d_bench* _bench);
+bool d_bench_compose_all(struct d_bench* _bench);
+
+
+#endif  // DJINTERP_BENCH_FUNCTIONAL_
@@ -0,0 +1,131 @@
+#include ".\functional_bench.h"
+
+
+/*
+d_bench_usage
+  Internal helper: prints the command line options.
+*/
+static void
+d_bench_usage
+(
+    const char* _program
+)
+{
+    fprintf(stderr,
+            "usage: %s [--quick] [--only <text>] [--min-time-ms <n>] "
+            "[--output <path>]\n"
+            "  --quick            small sweep, for smoke runs\n"
+            "  --only <text>      run scenarios whose name contains <text>\n"
+            "  --min-time-ms <n>  minimum measured time per case (default "
+            "%d)\n"
+            "  --output <path>    write the JSON report to <path> instead "
+            "of stdout\n",
+            _program,
+            D_BENCH_MIN_TIME_MS);
+
+    return;
+}
+
+/*
+main
+  Runs every benchmark scenario and writes one JSON report.
+
+Parameter(s):
+  argc: the number of arguments.
+  argv: the arguments; see d_bench_usage.
+Return:
+  0 if every case ran, 1 if a case failed, 2 on a usage error.
+*/
+int
+main
+(
+    int    argc,
+    char** argv
+)
+{
+    struct d_bench bench;
+    FILE*          output;
+    const char*    only;
+    const char*    path;
+    long           min_time_ms;
+    bool           quick;
+    int            i;
+
+    output      = stdout;
+    only        = NULL;
+    path        = NULL;
+    min_time_ms = -1;
+    quick       = false;
+
+    for (i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--quick") == 0)
+        {
+            quick = true;
+        }
+        else if ( (strcmp(argv[i], "--only") == 0) &&
+                  (i + 1 < argc) )
+        {
+            only = argv[++i];
+        }
+        else if ( (strcmp(argv[i], "--min-time-ms") == 0) &&
+                  (i + 1 < argc) )
+        {
+            min_time_ms = strtol(argv[++i], NULL, 10);
+
+            if (min_time_ms < 0)
+            {
+                d_bench_usage(argv[0]);
+
+                return 2;
+            }
+        }
+        else if ( (strcmp(argv[i], "--output") == 0) &&
+                  (i + 1 < argc) )
+        {
+            path = argv[++i];
+        }
+        else
+        {
+            d_bench_usage(argv[0]);
+
+            return 2;
+        }
+    }
+
+    if (path)
+    {
+        output = fopen(path, "w");
+
+        if (!output)
+        {
+            fprintf(stderr, "bench: cannot open %s\n", path);
+
+            return 2;
+        }
+    }
+
+    d_bench_begin(&bench, output, quick);
+
+    bench.only = only;
+
+    if (min_time_ms >= 0)
+    {
+        bench.min_time_ns = (uint64_t)min_time_ms * 1000000u;
+    }
+
+    d_bench_functional_common_all(&bench);
+    d_bench_filter_all(&bench);
+    d_bench_fn_builder_all(&bench);
+    d_bench_pipeline_all(&bench);
+    d_bench_compose_all(&bench);
+
+    d_bench_end(&bench);
+
+    if (path)
+    {
+        fclose(output);
+    }
+
+    return (bench.failed > 0) ? 1 : 0;
+}
@@ -0,0 +1,146 @@
+#include ".\functional_bench.h"
+
+
+// d_bench_common_state
+//   helper: the input of a map / filter / fold_left case.
+struct d_bench_common_state
+{
+    struct d_bench_data data;
+    uint32_t            threshold;
+    uint64_t            sum;
+};
+
+// d_bench_common_map
+//   helper: one d_functional_map over the input.
+static bool
+d_bench_common_map
+(
+    void* _context
+)
+{
+    struct d_bench_common_state* state;
+
+    state = (struct d_bench_common_state*)_context;
+
+    return d_functional_map(state->data.elements,
+                            state->data.output,
+                            state->data.count,
+                            state->data.element_size,
+                            d_bench_bump_key,
+                            &state->data.element_size);
+}
+
+// d_bench_common_filter
+//   helper: one d_functional_filter over the input.
+static bool
+d_bench_common_filter
+(
+    void* _context
+)
+{
+    struct d_bench_common_state* state;
+
+    state = (struct d_bench_common_state*)_context;
+
+    return (d_functional_filter(state->data.elements,
+                                state->data.output,
+                                state->data.count,
+                                state->data.element_size,
+                                d_bench_key_below,
+                                &state->threshold) <= state->data.count);
+}
+
+// d_bench_common_fold_left
+//   helper: one d_functional_fold_left summing the keys.
+static bool
+d_bench_common_fold_left
+(
+    void* _context
+)
+{
+    struct d_bench_common_state* state;
+
+    state      = (struct d_bench_common_state*)_context;
+    state->sum = 0;
+
+    return d_functional_fold_left(state->data.elements,
+                                  state->data.count,
+                                  state->data.element_size,
+                                  &state->sum,
+                                  d_bench_sum_key,
+                                  NULL);
+}
+
+
+/*
+d_bench_functional_common_all
+  Runs the d_functional_map, d_functional_filter, and
+d_functional_fold_left scenarios over every element size and count, and
+the filter over every selectivity.
+
+Parameter(s):
+  _bench: the run.
+Return:
+  true if every case succeeded.
+*/
+bool
+d_bench_functional_common_all
+(
+    struct d_bench* _bench
+)
+{
+    struct d_bench_common_state state;
+    struct d_bench_case         bench_case;
+    const struct d_bench_sweep* sweep;
+    size_t                      s;
+    size_t                      c;
+    size_t                      k;
+    bool                        result;
+
+    result = true;
+    sweep  = &_bench->sweep;
+
+    for (s = 0; s < sweep->element_size_count; s++)
+    {
+        for (c = 0; c < sweep->count_count; c++)
+        {
+            if (!d_bench_data_new(&state.data,
+                                  sweep->counts[c],
+                                  sweep->element_sizes[s],
+                                  0x5EED + c))
+            {
+                return false;
+            }
+
+            bench_case.element_size = sweep->element_sizes[s];
+            bench_case.count        = sweep->counts[c];
+            bench_case.selectivity  = -1.0;
+            bench_case.chain_length = 0;
+
+            bench_case.scenario = "functional/map";
+            result = d_bench_run(_bench, &bench_case,
+                                 d_bench_common_map, &state) && result;
+
+            bench_case.scenario = "functional/fold_left";
+            result = d_bench_run(_bench, &bench_case,
+                                 d_bench_common_fold_left, &state) && result;
+
+            bench_case.scenario = "functional/filter";
+
+            for (k = 0; k < sweep->selectivity_count; k++)
+            {
+                bench_case.selectivity = sweep->selectivities[k];
+                state.threshold        = d_bench_threshold(
+                                             sweep->selectivities[k]);
+
+                result = d_bench_run(_bench, &bench_case,
+                                     d_bench_common_filter, &state) &&
+                         result;
+            }
+
+            d_bench_data_free(&state.data);
+        }
+    }
+
+    return result;
+}
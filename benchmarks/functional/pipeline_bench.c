@@ -0,0 +1,157 @@
+#include ".\functional_bench.h"
+
+
+// d_bench_pipeline_state
+//   helper: the input and stages of a pipeline case.
+struct d_bench_pipeline_state
+{
+    struct d_bench_data data;
+    uint32_t            threshold;
+    size_t              maps;
+    uint64_t            sum;
+};
+
+// d_bench_pipeline_map_filter_fold
+//   helper: one begin_copy -> map -> filter -> fold pipeline.
+static bool
+d_bench_pipeline_map_filter_fold
+(
+    void* _context
+)
+{
+    struct d_bench_pipeline_state* state;
+    struct d_functional_pipeline   pipe;
+    bool                           ok;
+
+    state      = (struct d_bench_pipeline_state*)_context;
+    state->sum = 0;
+
+    pipe = d_functional_pipeline_begin_copy(state->data.elements,
+                                            state->data.count,
+                                            state->data.element_size);
+    pipe = d_functional_pipeline_map(pipe,
+                                     d_bench_bump_key,
+                                     &state->data.element_size);
+    pipe = d_functional_pipeline_filter(pipe,
+                                        d_bench_key_below,
+                                        &state->threshold);
+    pipe = d_functional_pipeline_fold(pipe,
+                                      &state->sum,
+                                      sizeof(state->sum),
+                                      d_bench_sum_key,
+                                      NULL);
+    ok   = (pipe.error_code == 0);
+
+    d_functional_pipeline_free(&pipe);
+
+    return ok;
+}
+
+// d_bench_pipeline_maps
+//   helper: one begin_copy followed by the state's number of maps.
+static bool
+d_bench_pipeline_maps
+(
+    void* _context
+)
+{
+    struct d_bench_pipeline_state* state;
+    struct d_functional_pipeline   pipe;
+    size_t                         i;
+    bool                           ok;
+
+    state = (struct d_bench_pipeline_state*)_context;
+    pipe  = d_functional_pipeline_begin_copy(state->data.elements,
+                                             state->data.count,
+                                             state->data.element_size);
+
+    for (i = 0; i < state->maps; i++)
+    {
+        pipe = d_functional_pipeline_map(pipe,
+                                         d_bench_bump_key,
+                                         &state->data.element_size);
+    }
+
+    ok = (pipe.error_code == 0);
+
+    d_functional_pipeline_free(&pipe);
+
+    return ok;
+}
+
+
+/*
+d_bench_pipeline_all
+  Runs the pipeline scenarios over every element size and count: a
+map -> filter -> fold pipeline over every selectivity, and chains of maps
+over every chain length.
+
+Parameter(s):
+  _bench: the run.
+Return:
+  true if every case succeeded.
+*/
+bool
+d_bench_pipeline_all
+(
+    struct d_bench* _bench
+)
+{
+    struct d_bench_pipeline_state state;
+    struct d_bench_case           bench_case;
+    const struct d_bench_sweep*   sweep;
+    size_t                        s;
+    size_t                        c;
+    size_t                        k;
+    bool                          result;
+
+    result = true;
+    sweep  = &_bench->sweep;
+
+    for (s = 0; s < sweep->element_size_count; s++)
+    {
+        for (c = 0; c < sweep->count_count; c++)
+        {
+            if (!d_bench_data_new(&state.data,
+                                  sweep->counts[c],
+                                  sweep->element_sizes[s],
+                                  0x919E + c))
+            {
+                return false;
+            }
+
+            bench_case.element_size = sweep->element_sizes[s];
+            bench_case.count        = sweep->counts[c];
+            bench_case.scenario     = "pipeline/map_filter_fold";
+            bench_case.chain_length = 3;
+
+            for (k = 0; k < sweep->selectivity_count; k++)
+            {
+                bench_case.selectivity = sweep->selectivities[k];
+                state.threshold        = d_bench_threshold(
+                                             sweep->selectivities[k]);
+
+                result = d_bench_run(_bench, &bench_case,
+                                     d_bench_pipeline_map_filter_fold,
+                                     &state) && result;
+            }
+
+            bench_case.scenario    = "pipeline/maps";
+            bench_case.selectivity = -1.0;
+
+            for (k = 0; k < sweep->chain_length_count; k++)
+            {
+                bench_case.chain_length = sweep->chain_lengths[k];
+                state.maps              = sweep->chain_lengths[k];
+
+                result = d_bench_run(_bench, &bench_case,
+                                     d_bench_pipeline_maps, &state) &&
+                         result;
+            }
+
+            d_bench_data_free(&state.data);
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,115 @@
+/******************************************************************************
+* djinterp [functional]                                          allocator.h
+*
+* Pluggable allocation and allocation accounting for the functional module.
+*   Every allocation the module makes goes through d_functional_malloc,
+* d_functional_calloc, d_functional_realloc, and d_functional_free, which
+* use the calling thread's current allocator: the innermost one pushed on
+* the thread with d_functional_allocator_push, else the global one set with
+* d_functional_allocator_set_global, else the C library.
+*   An installed d_functional_allocator forwards to its callbacks (the C
+* library's by default), and counts allocations, bytes, and the high-water
+* mark of live bytes. Every block, including those taken from the C
+* library with no allocator installed, is prefixed with a small header
+* naming its allocator (or none) and its size, so a block is always resized
+* by and released to the allocator it came from, whichever is current at
+* the time: objects may be built in one scope and grown or freed in
+* another, and reallocation works with allocators that cannot resize.
+* Memory the module returns must therefore be released with
+* d_functional_free rather than free(), or dropped together with an arena
+* (d_functional_allocator_init_arena).
+*
+*
+* path:      \inc\functional\allocator.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_C_FUNCTIONAL_ALLOCATOR_
+#define DJINTERP_C_FUNCTIONAL_ALLOCATOR_ 1
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "..\djinterp.h"
+#include ".\fn_arena.h"
+#include ".\functional_platform.h"
+
+
+// D_FUNCTIONAL_ALLOC_HEADER_SIZE
+//   constant: bytes in front of every block the module hands out; keeps
+// blocks aligned as malloc's are, and must hold a pointer and a size_t.
+#ifndef D_FUNCTIONAL_ALLOC_HEADER_SIZE
+    #define D_FUNCTIONAL_ALLOC_HEADER_SIZE 16
+#endif
+
+// fn_allocate
+//   function pointer: returns _size bytes, or NULL on failure.
+typedef void* (*fn_allocate)(size_t _size, void* _context);
+
+// fn_reallocate
+//   function pointer: resizes a block returned by the matching fn_allocate,
+// as realloc; returns NULL on failure, leaving the block intact.
+typedef void* (*fn_reallocate)(void* _block, size_t _size, void* _context);
+
+// fn_deallocate
+//   function pointer: releases a block returned by the matching
+// fn_allocate or fn_reallocate.
+typedef void  (*fn_deallocate)(void* _block, void* _context);
+
+// d_functional_allocator_stats
+//   struct: counters kept by an installed allocator. Sizes are the sizes
+// requested by the module, without headers.
+struct d_functional_allocator_stats
+{
+    size_t allocations;      // blocks allocated, including by realloc(NULL)
+    size_t reallocations;    // blocks resized
+    size_t frees;            // blocks released
+    size_t failures;         // requests the callbacks could not satisfy
+    size_t bytes_allocated;  // bytes requested by allocations and resizes
+    size_t bytes_live;       // bytes in blocks not yet released
+    size_t high_water;       // largest bytes_live reached
+};
+
+// d_functional_allocator
+//   struct: an allocator the module can be routed to. A NULL reallocate is
+// emulated with allocate, a copy, and deallocate; a NULL deallocate makes
+// releasing a block a no-op, as for arenas. A shared allocator serializes
+// its callbacks and counters with a mutex, so that several threads may use
+// it at once.
+struct d_functional_allocator
+{
+    fn_allocate                         allocate;
+    fn_reallocate                       reallocate;  // may be NULL
+    fn_deallocate                       deallocate;  // may be NULL
+    void*                               context;
+    bool                                shared;
+    d_functional_mutex                  mutex;       // used if shared
+    struct d_functional_allocator_stats stats;
+};
+
+
+// i.    allocator lifetime
+bool                           d_functional_allocator_init(struct d_functional_allocator* _allocator, fn_allocate _allocate, fn_reallocate _reallocate, fn_deallocate _deallocate, void* _context, bool _shared);
+bool                           d_functional_allocator_init_arena(struct d_functional_allocator* _allocator, struct d_fn_arena* _arena);
+void                           d_functional_allocator_destroy(struct d_functional_allocator* _allocator);
+
+// ii.   installation
+struct d_functional_allocator* d_functional_allocator_set_global(struct d_functional_allocator* _allocator);
+struct d_functional_allocator* d_functional_allocator_push(struct d_functional_allocator* _allocator);
+void                           d_functional_allocator_pop(struct d_functional_allocator* _previous);
+struct d_functional_allocator* d_functional_allocator_current(void);
+
+// iii.  accounting
+void                           d_functional_allocator_get_stats(struct d_functional_allocator* _allocator, struct d_functional_allocator_stats* _stats);
+void                           d_functional_allocator_reset_stats(struct d_functional_allocator* _allocator);
+
+// iv.   allocation
+void*                          d_functional_malloc(size_t _size);
+void*                          d_functional_calloc(size_t _count, size_t _size);
+void*                          d_functional_realloc(void* _block, size_t _size);
+void                           d_functional_free(void* _block);
+void                           d_functional_allocator_release(struct d_functional_allocator* _allocator, void* _block);
+
+
+#endif  // DJINTERP_C_FUNCTIONAL_ALLOCATOR_
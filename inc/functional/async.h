@@ -0,0 +1,169 @@
+/******************************************************************************
+* djinterp [functional]                                              async.h
+*
+* Asynchronous, multi-threaded execution of chunked pipelines.
+*   A d_functional_stream (stream.h) runs every stage of a chunk on the
+* calling thread before pulling the next chunk, so when one stage costs far
+* more than the others the remaining cores sit idle. A d_functional_async
+* runs the same map, filter, and for_each stages over a d_functional_source,
+* but splits them into stage groups, each served by its own worker threads.
+* A stage added with a worker count starts a new group served by that many
+* workers; one added with 0 workers is fused into the group before it. A
+* source thread pulls chunks and copies them into owned buffers, every
+* group's workers take chunks from the queue in front of the group, run the
+* group's stages on them in place, and pass them to the queue behind it,
+* and a sink thread folds or collects the result.
+*   The queues are bounded: a stage that runs ahead of its successor blocks
+* once D_FUNCTIONAL_ASYNC_QUEUE_DEPTH chunks are waiting, so memory stays
+* proportional to the chunk size times the number of queued and in-flight
+* chunks, however large the input. A group with several workers processes
+* several chunks at once; chunks may then reach later stages out of order,
+* but the sink restores source order, so fold and collect see the elements
+* in the same order as a serial stream would.
+*   Starting the pipeline returns at once; the caller polls for completion
+* with d_functional_async_ready or blocks in d_functional_async_wait, which
+* returns the pipeline's error_code. As with pipelines and streams, an
+* error while adding stages makes later calls no-ops and is reported on
+* completion; an error while running (a failing callback, a source read
+* error, or an allocation failure) stops every thread and is reported the
+* same way.
+*   The callbacks of a stage with several workers are called concurrently
+* and must be thread-safe. Blocks are allocated from the allocator current
+* when the pipeline starts (see allocator.h), which must then be shared.
+*
+*
+* path:      \inc\functional\async.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_C_FUNCTIONAL_ASYNC_
+#define DJINTERP_C_FUNCTIONAL_ASYNC_ 1
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "..\djinterp.h"
+#include ".\functional_common.h"
+#include ".\allocator.h"
+#include ".\functional_platform.h"
+#include ".\stream.h"
+
+
+// D_FUNCTIONAL_ASYNC_QUEUE_DEPTH
+//   constant: default number of chunks a queue between two stage groups
+// holds before its producer blocks.
+#ifndef D_FUNCTIONAL_ASYNC_QUEUE_DEPTH
+    #define D_FUNCTIONAL_ASYNC_QUEUE_DEPTH 4
+#endif
+
+// d_async_chunk
+//   struct: an owned chunk travelling between stage groups; sequence is its
+// position in the source, used by the sink to restore order.
+struct d_async_chunk
+{
+    unsigned char*        data;
+    size_t                count;     // elements in data
+    size_t                sequence;  // 0 for the first chunk pulled
+    struct d_async_chunk* next;      // sink reorder list
+};
+
+// d_async_queue
+//   struct: bounded multi-producer, multi-consumer ring of chunks. It is
+// closed once every producer has closed it, and aborted on an error.
+struct d_async_queue
+{
+    struct d_async_chunk** slots;
+    size_t                 capacity;   // slots
+    size_t                 head;       // next slot to take
+    size_t                 count;      // chunks waiting
+    size_t                 producers;  // producers that have not closed it
+    bool                   aborted;
+    d_functional_mutex     mutex;
+    d_functional_cond      not_empty;
+    d_functional_cond      not_full;
+};
+
+// d_async_group
+//   struct: consecutive stages run together on each chunk by the group's
+// worker threads; queue i feeds group i.
+struct d_async_group
+{
+    struct d_stream_stage* stages;
+    size_t                 stage_count;
+    size_t                 stage_capacity;
+    size_t                 workers;
+};
+
+// d_async_thread
+//   struct: one thread of a running pipeline: the source, a worker of a
+// group, or the sink.
+struct d_async_thread
+{
+    struct d_functional_async* async;
+    size_t                     group;    // group served by a worker
+    fn_callback                entry;    // what the thread runs
+    d_functional_thread        handle;
+    bool                       started;
+};
+
+// d_async_sink_kind
+//   enum: terminal operation run by the sink thread.
+enum d_async_sink_kind
+{
+    D_ASYNC_SINK_NONE = 0,
+    D_ASYNC_SINK_FOLD,
+    D_ASYNC_SINK_COLLECT
+};
+
+// d_functional_async
+//   struct: an asynchronous pipeline over a source. Stage groups are added
+// up front; once started, the pipeline runs until its source ends or an
+// error stops it. error_code is 0 on success.
+struct d_functional_async
+{
+    struct d_functional_source     source;
+    struct d_async_group*          groups;
+    size_t                         group_count;
+    size_t                         group_capacity;
+    size_t                         queue_depth;
+    struct d_async_queue*          queues;        // group_count + 1
+    struct d_async_thread*         threads;
+    size_t                         thread_count;
+    struct d_functional_allocator* allocator;     // current when started
+    enum d_async_sink_kind         sink;
+    void*                          accumulator;   // fold
+    fn_accumulator                 combine;       // fold
+    void*                          sink_context;  // fold
+    void**                         out_data;      // collect
+    size_t*                        out_count;     // collect
+    size_t                         running;       // threads not finished
+    bool                           launched;      // start was called
+    bool                           joined;        // threads joined
+    d_functional_mutex             mutex;         // guards error, running
+    int                            error_code;    // 0 = success
+};
+
+
+// i.    creation
+struct d_functional_async* d_functional_async_new(struct d_functional_source _source, size_t _queue_depth);
+
+// ii.   stages (chainable)
+struct d_functional_async* d_functional_async_map(struct d_functional_async* _async, fn_transformer _transform, void* _context, size_t _workers);
+struct d_functional_async* d_functional_async_filter(struct d_functional_async* _async, fn_predicate _test, void* _context, size_t _workers);
+struct d_functional_async* d_functional_async_for_each(struct d_functional_async* _async, fn_consumer _apply, void* _context, size_t _workers);
+
+// iii.  execution
+bool                       d_functional_async_start(struct d_functional_async* _async);
+bool                       d_functional_async_start_fold(struct d_functional_async* _async, void* _accumulator, fn_accumulator _combine, void* _context);
+bool                       d_functional_async_start_collect(struct d_functional_async* _async, void** _out_data, size_t* _out_count);
+
+// iv.   completion
+bool                       d_functional_async_ready(struct d_functional_async* _async);
+int                        d_functional_async_wait(struct d_functional_async* _async);
+
+// v.    cleanup
+void                       d_functional_async_free(struct d_functional_async* _async);
+
+
+#endif  // DJINTERP_C_FUNCTIONAL_ASYNC_
@@ -17,6 +17,8 @@
 #include <stdlib.h>
 #include "..\djinterp.h"
 #include ".\functional_common.h"
+#include ".\allocator.h"
+#include ".\fn_arena.h"
 
 
 // convenience composition marcos
@@ -138,6 +140,7 @@ struct d_composed_transformer
 
 // i.    transformer composition
 struct d_composed_transformer* d_functional_compose_new(fn_transformer _first, void* _context1, fn_transformer _second, void* _context2, size_t _temp_size);
+struct d_composed_transformer* d_functional_compose_new_in(struct d_fn_arena* _arena, fn_transformer _first, void* _context1, fn_transformer _second, void* _context2, size_t _temp_size);
 bool                           d_functional_compose_apply(const struct d_composed_transformer* _composed, const void* _input, void* _output);
 void                           d_functional_compose_free(struct d_composed_transformer* _composed);
 
@@ -152,8 +155,62 @@ struct d_partial_consumer
 
 // ii.   partial application operations
 struct d_partial_consumer* d_functional_partial_consumer_new(fn_consumer _consumer, void* _context);
+struct d_partial_consumer* d_functional_partial_consumer_new_in(struct d_fn_arena* _arena, fn_consumer _consumer, void* _context);
 void                       d_functional_partial_consumer_apply(const struct d_partial_consumer* _partial, void* _element);
 void                       d_functional_partial_consumer_free(struct d_partial_consumer* _partial);
 
 
+// D_FUNCTIONAL_COMPOSE_BLOCK_SIZE
+//   constant: number of elements processed per stage before moving to the
+// next stage in d_functional_compose_apply_array.
+#ifndef D_FUNCTIONAL_COMPOSE_BLOCK_SIZE
+    #define D_FUNCTIONAL_COMPOSE_BLOCK_SIZE 64
+#endif
+
+// D_FUNCTIONAL_COMPOSE_ALIGNMENT
+//   constant: alignment, in bytes, of each scratch slot and block of an
+// n-ary composition; a power of two suiting any intermediate type.
+#ifndef D_FUNCTIONAL_COMPOSE_ALIGNMENT
+    #define D_FUNCTIONAL_COMPOSE_ALIGNMENT 16
+#endif
+
+// d_compose_stage
+//   struct: one step of an n-ary composition.
+// output_size is the size in bytes of the value written by transform; the
+// output_size of the last stage is the size of the composition's result.
+struct d_compose_stage
+{
+    fn_transformer transform;    // transformer for this stage
+    void*          context;      // context for transform; may be NULL
+    size_t         output_size;  // size of this stage's output
+};
+
+// d_composed_chain
+//   struct: flattened composition of n transformers (fn . ... . f1).
+// Intermediate results alternate between two scratch slots sized for the
+// largest intermediate value, so the cost of a stage does not depend on how
+// deep the composition is. block_buf holds the same two slots widened to
+// D_FUNCTIONAL_COMPOSE_BLOCK_SIZE elements for bulk application. Both belong
+// to the composition, so applying it from several threads at once needs the
+// _with functions and a buffer per thread.
+struct d_composed_chain
+{
+    struct d_compose_stage* stages;        // stages, in application order
+    size_t                  count;         // number of stages
+    size_t                  scratch_size;  // largest intermediate size
+    void*                   scratch[2];    // ping-pong slots for apply
+    void*                   block_buf[2];  // ping-pong blocks for arrays
+};
+
+// iii.  n-ary composition
+struct d_composed_chain* d_functional_compose_many(const struct d_compose_stage* _stages, size_t _count);
+bool                     d_functional_compose_many_apply(struct d_composed_chain* _chain, const void* _input, void* _output);
+bool                     d_functional_compose_many_apply_with(const struct d_composed_chain* _chain, void* _scratch, const void* _input, void* _output);
+bool                     d_functional_compose_apply_array(struct d_composed_chain* _chain, const void* _input, size_t _count, size_t _input_size, void* _output);
+bool                     d_functional_compose_apply_array_with(const struct d_composed_chain* _chain, void* _scratch, const void* _input, size_t _count, size_t _input_size, void* _output);
+size_t                   d_functional_compose_many_scratch_size(const struct d_composed_chain* _chain);
+size_t                   d_functional_compose_many_output_size(const struct d_composed_chain* _chain);
+void                     d_functional_compose_many_free(struct d_composed_chain* _chain);
+
+
 #endif  // DJINTERP_C_FUNCTIONAL_COMPOSE_
@@ -50,6 +50,7 @@ II.   CORE FILTER TYPES
       4.  Filter operation structure
       5.  Filter chain structure
       6.  Filter result structure
+      7.  Parse error structure
 
 III.  FILTER OPERATIONS
       ------------------
@@ -58,7 +59,7 @@ III.  FILTER OPERATIONS
       3.  Range and slice operations
       4.  Predicate-based filtering
       5.  Index-based selection
-      6.  Transformation operations (distinct, reverse)
+      6.  Transformation operations (distinct, reverse, top-k)
       7.  Operation cleanup
 
 IV.   FILTER CHAIN MANAGEMENT
@@ -90,16 +91,19 @@ VI.   EXECUTION AND APPLICATION
 VII.  UTILITY FUNCTIONS
       ------------------
       1.  Validation
-      2.  Description / serialization
+      2.  Description / serialization (registered names, canonical form)
       3.  Parsing (from string)
       4.  Optimization
       5.  Statistics
+      6.  Binary encoding
+      7.  Profiling (EXPLAIN ANALYZE)
 
 VIII. ITERATOR INTERFACE
       -------------------------
       1.  Iterator creation
       2.  Iterator operations
       3.  Iterator cleanup
+      4.  Streaming over a chunked source
 
 IX.   FLUENT FILTER BUILDER
       ----------------------
@@ -126,6 +130,7 @@ XI.   TYPED FILTER WRAPPERS (C11+)
 ///             I.    CONFIGURATION                                         ///
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <errno.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -142,6 +147,11 @@ XI.   TYPED FILTER WRAPPERS (C11+)
     #define D_FILTER_MAX_CHAIN_LENGTH 32
 #endif
 
+// D_FILTER_ENCODING_VERSION
+//   constant: version byte of the binary chain encoding written by
+// d_filter_chain_encode; the decoders reject any other version.
+#define D_FILTER_ENCODING_VERSION 1
+
 
 ///////////////////////////////////////////////////////////////////////////////
 ///             II.   CORE FILTER TYPES                                     ///
@@ -167,7 +177,8 @@ enum d_filter_op_type
     D_FILTER_OP_HEAD        = 0x0D,  // alias for take_first(1)
     D_FILTER_OP_TAIL        = 0x0E,  // alias for take_last(1)
     D_FILTER_OP_INIT        = 0x0F,  // all except last
-    D_FILTER_OP_REST        = 0x10   // all except first
+    D_FILTER_OP_REST        = 0x10,  // all except first
+    D_FILTER_OP_TOP_K       = 0x11   // k greatest elements, greatest first
 };
 
 // d_filter_result_type
@@ -181,6 +192,18 @@ enum d_filter_result_type
     D_FILTER_RESULT_NO_MEMORY  = -3   // allocation failed
 };
 
+// d_filter_monotone
+//   enum: shape of a WHERE predicate over input sorted by the chain's
+// `sorted_by` comparator. A shaped WHERE on sorted input is applied as a
+// binary-searched range instead of a scan. A BETWEEN is a RISING lower
+// bound followed by a FALLING upper bound.
+enum d_filter_monotone
+{
+    D_FILTER_MONOTONE_NONE    = 0,  // arbitrary; always scanned
+    D_FILTER_MONOTONE_RISING  = 1,  // false then true (e.g. GT, GE)
+    D_FILTER_MONOTONE_FALLING = 2   // true then false (e.g. LT, LE)
+};
+
 // struct d_filter_op_params
 //   struct: parameters for a filter operation.
 struct d_filter_op_params
@@ -193,7 +216,8 @@ struct d_filter_op_params
     size_t                 indices_count;  // number of indices
     fn_predicate           test;           // predicate function
     void*                  context;        // context for predicate
-    fn_function_comparator comparator;     // comparator (for distinct)
+    fn_function_comparator comparator;     // comparator (for distinct/top-k)
+    enum d_filter_monotone monotone;       // predicate shape (for where)
 };
 
 // struct d_filter_operation
@@ -202,7 +226,7 @@ struct d_filter_operation
 {
     enum d_filter_op_type     type;    // operation type
     struct d_filter_op_params params;  // operation parameters
-    char*                     name;    // optional name/description
+    char*                     name;    // optional, malloc'd by the caller
 };
 
 // struct d_filter_chain
@@ -213,6 +237,8 @@ struct d_filter_chain
     size_t                     count;           // number of operations
     size_t                     capacity;        // allocated capacity
     bool                       owns_operations; // whether chain owns ops
+    fn_function_comparator     sorted_by;       // input order hint, or NULL
+    void*                      sorted_context;  // context for sorted_by
 };
 
 // struct d_filter_result
@@ -226,6 +252,14 @@ struct d_filter_result
     char*                     error_message; // error description if failed
 };
 
+// struct d_filter_parse_error
+//   struct: where and why a chain failed to parse or decode.
+struct d_filter_parse_error
+{
+    size_t      position;  // byte offset of the error in the text or data
+    const char* message;   // static description, or NULL if none
+};
+
 
 ///////////////////////////////////////////////////////////////////////////////
 ///             III.  FILTER OPERATIONS                                     ///
@@ -256,6 +290,9 @@ struct d_filter_operation* d_filter_where_context(fn_predicate _test,
 struct d_filter_operation* d_filter_where_not(fn_predicate _test);
 struct d_filter_operation* d_filter_where_not_context(fn_predicate _test,
                                                   void* _context);
+struct d_filter_operation* d_filter_where_monotone(fn_predicate _test,
+                                               void* _context,
+                                               enum d_filter_monotone _shape);
 
 // v.    index-based operations
 struct d_filter_operation* d_filter_at(size_t _index);
@@ -265,6 +302,9 @@ struct d_filter_operation* d_filter_at_indices(const size_t* _indices,
 // vi.   transformation operations
 struct d_filter_operation* d_filter_distinct(fn_function_comparator _comparator);
 struct d_filter_operation* d_filter_reverse(void);
+struct d_filter_operation* d_filter_top_k(size_t _k,
+                                          fn_function_comparator _comparator,
+                                          void* _context);
 
 // vii.  operation cleanup
 void d_filter_operation_free(struct d_filter_operation* _op);
@@ -316,8 +356,12 @@ void d_filter_chain_clear(struct d_filter_chain* _chain);
 // vi.   chain properties
 size_t d_filter_chain_length(const struct d_filter_chain* _chain);
 bool   d_filter_chain_is_empty(const struct d_filter_chain* _chain);
+bool   d_filter_chain_set_sorted(struct d_filter_chain* _chain,
+                                 fn_function_comparator _comparator,
+                                 void* _context);
 
 // vii.  chain cleanup
+void d_filter_chain_release(struct d_filter_chain* _chain);
 void d_filter_chain_free(struct d_filter_chain* _chain);
 
 
@@ -457,12 +501,22 @@ char* d_filter_operation_to_string(
           const struct d_filter_operation* _op);
 char* d_filter_chain_to_string(
           const struct d_filter_chain* _chain);
+char* d_filter_chain_canonical(
+          const struct d_filter_chain* _chain);
 
 // iii.  parsing (from string)
 struct d_filter_operation* d_filter_operation_from_string(
                                const char* _str);
 struct d_filter_chain*     d_filter_chain_from_string(
                                const char* _str);
+bool                       d_filter_chain_parse(
+                               struct d_filter_chain* _chain,
+                               const char* _str,
+                               struct d_filter_parse_error* _error);
+struct d_filter_chain*     d_filter_chain_parse_in(
+                               struct d_fn_arena* _arena,
+                               const char* _str,
+                               struct d_filter_parse_error* _error);
 
 // iv.   optimization
 struct d_filter_chain* d_filter_chain_optimize(
@@ -473,6 +527,27 @@ size_t d_filter_estimate_result_size(
            const struct d_filter_chain* _chain,
            size_t _input_count);
 
+// vi.   binary encoding
+size_t                 d_filter_chain_encode(
+                           const struct d_filter_chain* _chain,
+                           void* _buffer, size_t _capacity);
+size_t                 d_filter_chain_decoded_size(
+                           const void* _data, size_t _size,
+                           struct d_filter_parse_error* _error);
+struct d_filter_chain* d_filter_chain_decode_into(
+                           void* _buffer, size_t _capacity,
+                           const void* _data, size_t _size,
+                           struct d_filter_parse_error* _error);
+struct d_filter_chain* d_filter_chain_decode(
+                           const void* _data, size_t _size,
+                           struct d_filter_parse_error* _error);
+
+// vii.  profiling
+char* d_filter_chain_explain_analyze(
+          const struct d_filter_chain* _chain,
+          const void* _input, size_t _count,
+          size_t _element_size);
+
 
 ///////////////////////////////////////////////////////////////////////////////
 ///             VIII. ITERATOR INTERFACE                                    ///
@@ -509,6 +584,63 @@ void  d_filter_iterator_reset(struct d_filter_iterator* _iter);
 // iii.  iterator cleanup
 void d_filter_iterator_free(struct d_filter_iterator* _iter);
 
+// struct d_filter_stream_state
+//   struct: per-operation state of a d_filter_stream, carried across
+// chunks. `held` is the TAKE_LAST / SKIP_LAST ring, the DISTINCT sorted
+// set, or the TOP_K candidates.
+struct d_filter_stream_state
+{
+    size_t         seen;              // elements that reached the operation
+    size_t         next_index;        // next entry of an INDICES list
+    unsigned char* held;              // elements held across chunks
+    size_t         held_count;        // number of held elements
+    size_t         held_capacity;     // allocated capacity (elements)
+    size_t         head;              // oldest element of a full ring
+    unsigned char* scratch;           // flush / merge space
+    size_t         scratch_capacity;  // allocated capacity (elements)
+    bool           exhausted;         // no further input can pass
+};
+
+// struct d_filter_stream
+//   struct: a filter chain applied to a chunked d_functional_source.
+// Positional counters, distinct sets, and take-last / skip-last / top-k
+// buffers carry across chunk boundaries, so the output equals
+// d_filter_apply_chain over the concatenated input. Once an operation can
+// pass no further input (a satisfied take_first, range, or at_indices),
+// no further chunks are pulled. REVERSE, and at_indices with indices that
+// are not strictly increasing, need the whole input and are rejected. The
+// stream does not own the chain or the source.
+struct d_filter_stream
+{
+    const struct d_filter_chain*  chain;            // filter chain (ref)
+    struct d_functional_source    source;           // input
+    struct d_filter_stream_state* states;           // one per operation
+    unsigned char*                buffer;           // chunk working space
+    size_t                        buffer_capacity;  // elements
+    unsigned char*                output;           // flushed output
+    size_t                        output_count;
+    size_t                        output_capacity;  // elements
+    unsigned char*                element;          // one-element temporary
+    bool                          finished;         // no more chunks to pull
+    bool                          flushed;          // end-of-input output done
+    int                           error_code;       // 0 = success
+};
+
+// iv.   streaming over a source
+struct d_filter_stream*    d_filter_stream_new(
+                               const struct d_filter_chain* _chain,
+                               struct d_functional_source _source);
+bool                       d_filter_stream_next(
+                               struct d_filter_stream* _stream,
+                               const void** _chunk, size_t* _count);
+struct d_functional_source d_filter_stream_source(
+                               struct d_filter_stream* _stream);
+struct d_filter_result*    d_filter_apply_chain_source(
+                               const struct d_filter_chain* _chain,
+                               struct d_functional_source _source);
+void                       d_filter_stream_free(
+                               struct d_filter_stream* _stream);
+
 
 ///////////////////////////////////////////////////////////////////////////////
 ///             IX.   FLUENT FILTER BUILDER                                 ///
@@ -556,6 +688,14 @@ struct d_filter_builder* d_filter_builder_where_context(
 struct d_filter_builder* d_filter_builder_where_not(
                              struct d_filter_builder* _builder,
                              fn_predicate _test);
+struct d_filter_builder* d_filter_builder_where_monotone(
+                             struct d_filter_builder* _builder,
+                             fn_predicate _test, void* _context,
+                             enum d_filter_monotone _shape);
+struct d_filter_builder* d_filter_builder_sorted(
+                             struct d_filter_builder* _builder,
+                             fn_function_comparator _comparator,
+                             void* _context);
 struct d_filter_builder* d_filter_builder_range(
                              struct d_filter_builder* _builder,
                              size_t _start, size_t _end);
@@ -568,6 +708,11 @@ struct d_filter_builder* d_filter_builder_distinct(
                              fn_function_comparator _comparator);
 struct d_filter_builder* d_filter_builder_reverse(
                              struct d_filter_builder* _builder);
+struct d_filter_builder* d_filter_builder_top_k(
+                             struct d_filter_builder* _builder,
+                             size_t _k,
+                             fn_function_comparator _comparator,
+                             void* _context);
 struct d_filter_builder* d_filter_builder_at(
                              struct d_filter_builder* _builder,
                              size_t _index);
@@ -696,6 +841,11 @@ void d_filter_builder_free(struct d_filter_builder* _builder);
 #define D_THEN_REVERSE(BUILDER)                                      \
     d_filter_builder_reverse((BUILDER))
 
+// D_THEN_TOP_K
+//   macro: chains top-k operation.
+#define D_THEN_TOP_K(BUILDER, K, CMP, CTX)                           \
+    d_filter_builder_top_k((BUILDER), (K), (CMP), (CTX))
+
 // D_FILTER_END
 //   macro: finalizes and executes filter chain.
 #define D_FILTER_END(BUILDER, INPUT, COUNT, SIZE)                    \
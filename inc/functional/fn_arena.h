@@ -0,0 +1,70 @@
+/******************************************************************************
+* djinterp [functional]                                          fn_arena.h
+*
+* Bump-pointer arena for short-lived functional objects.
+*   A d_fn_arena hands out memory from large chunks by advancing a pointer,
+* so building a graph of combinators costs a few pointer bumps instead of one
+* malloc per node, and the nodes end up next to each other in memory. The
+* whole graph is released at once with d_fn_arena_reset or d_fn_arena_free;
+* individual allocations are never freed.
+*   The `_new_in` constructors of the predicate and compose modules build
+* their objects inside an arena. Objects created that way must not be passed
+* to the matching `_free` functions.
+*
+*
+* path:      \inc\functional\fn_arena.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_C_FUNCTIONAL_FN_ARENA_
+#define DJINTERP_C_FUNCTIONAL_FN_ARENA_ 1
+
+#include <stddef.h>
+#include <stdlib.h>
+#include "..\djinterp.h"
+
+
+// D_FN_ARENA_DEFAULT_CHUNK_SIZE
+//   constant: usable bytes per chunk when a chunk size of 0 is requested.
+#ifndef D_FN_ARENA_DEFAULT_CHUNK_SIZE
+    #define D_FN_ARENA_DEFAULT_CHUNK_SIZE 4096
+#endif
+
+// D_FN_ARENA_ALIGNMENT
+//   constant: alignment of every arena allocation; must be a power of two.
+#ifndef D_FN_ARENA_ALIGNMENT
+    #define D_FN_ARENA_ALIGNMENT 16
+#endif
+
+// d_fn_arena_chunk
+//   struct: one block of arena memory; its data follows the header.
+struct d_fn_arena_chunk
+{
+    struct d_fn_arena_chunk* next;
+    size_t                   capacity;  // usable bytes after the header
+    size_t                   used;
+};
+
+// d_fn_arena
+//   struct: bump allocator over a list of chunks. `head` is the chunk being
+// bumped; requests larger than chunk_size get a dedicated chunk.
+struct d_fn_arena
+{
+    struct d_fn_arena_chunk* head;
+    size_t                   chunk_size;
+    size_t                   bytes_allocated;  // requested bytes since reset
+    size_t                   allocations;      // requests since reset
+};
+
+
+// i.    arena lifetime
+struct d_fn_arena* d_fn_arena_new(size_t _chunk_size);
+void               d_fn_arena_reset(struct d_fn_arena* _arena);
+void               d_fn_arena_free(struct d_fn_arena* _arena);
+
+// ii.   allocation
+void*              d_fn_arena_alloc(struct d_fn_arena* _arena, size_t _size);
+
+
+#endif  // DJINTERP_C_FUNCTIONAL_FN_ARENA_
@@ -17,6 +17,8 @@
 #include <stdlib.h>
 #include "..\djinterp.h"
 #include ".\functional_common.h"
+#include ".\allocator.h"
+#include ".\profile.h"
 
 
 // D_FN_BUILDER_INITIAL_CAPACITY
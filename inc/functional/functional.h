@@ -34,10 +34,24 @@
 
 #include "..\djinterp.h"
 #include ".\functional_common.h"
+#include ".\allocator.h"
 #include ".\predicate.h"
 #include ".\compose.h"
 #include ".\fn_builder.h"
 #include ".\pipeline.h"
+#include ".\memoize.h"
+#include ".\fn_arena.h"
+#include ".\reduce.h"
+#include ".\numeric.h"
+#include ".\group.h"
+#include ".\sort.h"
+#include ".\scan.h"
+#include ".\specialize.h"
+#include ".\stream.h"
+#include ".\async.h"
+#include ".\mapped_io.h"
+#include ".\predicate_registry.h"
+#include ".\profile.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1389,10 +1403,15 @@
 // Generate inline fn_accumulator-compatible functions for common
 // reduction patterns.  Each reads both _accumulated and _element
 // as pointers to TYPE.
+//   Every generator also emits NAME##_merge, an fn_combiner that
+// folds another partial state (_partial) into _accumulated.  Merges
+// let independent partial folds over disjoint ranges be combined,
+// as done by d_functional_fold_parallel.
 //
 
 // D_DEFINE_ACC_SUM
-//   macro: generates an accumulator that computes a running sum.
+//   macro: generates an accumulator that computes a running sum,
+// and NAME##_merge, which adds two partial sums.
 #define D_DEFINE_ACC_SUM(name,                          \
                          type)                          \
     D_INLINE bool                                       \
@@ -1410,11 +1429,28 @@
         }                                               \
         *(type*)_accumulated += *(const type*)_element; \
         return true;                                    \
+    }                                                   \
+                                                        \
+    D_INLINE bool                                       \
+    name##_merge                                        \
+    (                                                   \
+        void*       _accumulated,                       \
+        const void* _partial,                           \
+        void*       _context                            \
+    )                                                   \
+    {                                                   \
+        (void)_context;                                 \
+        if ( (!_accumulated) || (!_partial) )           \
+        {                                               \
+            return false;                               \
+        }                                               \
+        *(type*)_accumulated += *(const type*)_partial; \
+        return true;                                    \
     }
 
 // D_DEFINE_ACC_PRODUCT
 //   macro: generates an accumulator that computes a running
-// product.
+// product, and NAME##_merge, which multiplies two partial products.
 #define D_DEFINE_ACC_PRODUCT(name,                      \
                              type)                      \
     D_INLINE bool                                       \
@@ -1432,10 +1468,28 @@
         }                                               \
         *(type*)_accumulated *= *(const type*)_element; \
         return true;                                    \
+    }                                                   \
+                                                        \
+    D_INLINE bool                                       \
+    name##_merge                                        \
+    (                                                   \
+        void*       _accumulated,                       \
+        const void* _partial,                           \
+        void*       _context                            \
+    )                                                   \
+    {                                                   \
+        (void)_context;                                 \
+        if ( (!_accumulated) || (!_partial) )           \
+        {                                               \
+            return false;                               \
+        }                                               \
+        *(type*)_accumulated *= *(const type*)_partial; \
+        return true;                                    \
     }
 
 // D_DEFINE_ACC_MIN
-//   macro: generates an accumulator that tracks the minimum.
+//   macro: generates an accumulator that tracks the minimum, and
+// NAME##_merge, which keeps the smaller of two partial minima.
 #define D_DEFINE_ACC_MIN(name,                             \
                          type)                             \
     D_INLINE bool                                          \
@@ -1456,10 +1510,31 @@
             *(type*)_accumulated = *(const type*)_element; \
         }                                                  \
         return true;                                       \
+    }                                                      \
+                                                           \
+    D_INLINE bool                                          \
+    name##_merge                                           \
+    (                                                      \
+        void*       _accumulated,                          \
+        const void* _partial,                              \
+        void*       _context                               \
+    )                                                      \
+    {                                                      \
+        (void)_context;                                    \
+        if ( (!_accumulated) || (!_partial) )              \
+        {                                                  \
+            return false;                                  \
+        }                                                  \
+        if (*(const type*)_partial < *(type*)_accumulated) \
+        {                                                  \
+            *(type*)_accumulated = *(const type*)_partial; \
+        }                                                  \
+        return true;                                       \
     }
 
 // D_DEFINE_ACC_MAX
-//   macro: generates an accumulator that tracks the maximum.
+//   macro: generates an accumulator that tracks the maximum, and
+// NAME##_merge, which keeps the larger of two partial maxima.
 #define D_DEFINE_ACC_MAX(name,                             \
                          type)                             \
     D_INLINE bool                                          \
@@ -1480,11 +1555,32 @@
             *(type*)_accumulated = *(const type*)_element; \
         }                                                  \
         return true;                                       \
+    }                                                      \
+                                                           \
+    D_INLINE bool                                          \
+    name##_merge                                           \
+    (                                                      \
+        void*       _accumulated,                          \
+        const void* _partial,                              \
+        void*       _context                               \
+    )                                                      \
+    {                                                      \
+        (void)_context;                                    \
+        if ( (!_accumulated) || (!_partial) )              \
+        {                                                  \
+            return false;                                  \
+        }                                                  \
+        if (*(const type*)_partial > *(type*)_accumulated) \
+        {                                                  \
+            *(type*)_accumulated = *(const type*)_partial; \
+        }                                                  \
+        return true;                                       \
     }
 
 // D_DEFINE_ACC_BITWISE_OR
 //   macro: generates an accumulator that computes a running
-// bitwise OR.  TYPE must be an integral type.
+// bitwise OR, and NAME##_merge, which ORs two partial results.
+// TYPE must be an integral type.
 #define D_DEFINE_ACC_BITWISE_OR(name,                   \
                                 type)                   \
     D_INLINE bool                                       \
@@ -1502,11 +1598,29 @@
         }                                               \
         *(type*)_accumulated |= *(const type*)_element; \
         return true;                                    \
+    }                                                   \
+                                                        \
+    D_INLINE bool                                       \
+    name##_merge                                        \
+    (                                                   \
+        void*       _accumulated,                       \
+        const void* _partial,                           \
+        void*       _context                            \
+    )                                                   \
+    {                                                   \
+        (void)_context;                                 \
+        if ( (!_accumulated) || (!_partial) )           \
+        {                                               \
+            return false;                               \
+        }                                               \
+        *(type*)_accumulated |= *(const type*)_partial; \
+        return true;                                    \
     }
 
 // D_DEFINE_ACC_BITWISE_AND
 //   macro: generates an accumulator that computes a running
-// bitwise AND.  TYPE must be an integral type.
+// bitwise AND, and NAME##_merge, which ANDs two partial results.
+// TYPE must be an integral type.
 #define D_DEFINE_ACC_BITWISE_AND(name,                  \
                                  type)                  \
     D_INLINE bool                                       \
@@ -1524,29 +1638,63 @@
         }                                               \
         *(type*)_accumulated &= *(const type*)_element; \
         return true;                                    \
+    }                                                   \
+                                                        \
+    D_INLINE bool                                       \
+    name##_merge                                        \
+    (                                                   \
+        void*       _accumulated,                       \
+        const void* _partial,                           \
+        void*       _context                            \
+    )                                                   \
+    {                                                   \
+        (void)_context;                                 \
+        if ( (!_accumulated) || (!_partial) )           \
+        {                                               \
+            return false;                               \
+        }                                               \
+        *(type*)_accumulated &= *(const type*)_partial; \
+        return true;                                    \
     }
 
 // D_DEFINE_ACC_COUNT
 //   macro: generates an accumulator that counts elements.
 // _accumulated is a pointer to size_t; the element value is
-// ignored.
-#define D_DEFINE_ACC_COUNT(name)    \
-    D_INLINE bool                   \
-    name                            \
-    (                               \
-        void*       _accumulated,   \
-        const void* _element,       \
-        void*       _context        \
-    )                               \
-    {                               \
-        (void)_element;             \
-        (void)_context;             \
-        if ( !_accumulated )        \
-        {                           \
-            return false;           \
-        }                           \
-        (*(size_t*)_accumulated)++; \
-        return true;                \
+// ignored.  NAME##_merge adds two partial counts.
+#define D_DEFINE_ACC_COUNT(name)                            \
+    D_INLINE bool                                           \
+    name                                                    \
+    (                                                       \
+        void*       _accumulated,                           \
+        const void* _element,                               \
+        void*       _context                                \
+    )                                                       \
+    {                                                       \
+        (void)_element;                                     \
+        (void)_context;                                     \
+        if ( !_accumulated )                                \
+        {                                                   \
+            return false;                                   \
+        }                                                   \
+        (*(size_t*)_accumulated)++;                         \
+        return true;                                        \
+    }                                                       \
+                                                            \
+    D_INLINE bool                                           \
+    name##_merge                                            \
+    (                                                       \
+        void*       _accumulated,                           \
+        const void* _partial,                               \
+        void*       _context                                \
+    )                                                       \
+    {                                                       \
+        (void)_context;                                     \
+        if ( (!_accumulated) || (!_partial) )               \
+        {                                                   \
+            return false;                                   \
+        }                                                   \
+        *(size_t*)_accumulated += *(const size_t*)_partial; \
+        return true;                                        \
     }
 
 // D_DEFINE_ACC_MEAN_STATE
@@ -1562,26 +1710,49 @@ struct d_acc_mean_state
 // _accumulated must point to a struct d_acc_mean_state, and
 // _element must point to a TYPE value.  The mean can be read
 // from state.sum / state.count after the fold completes.
-#define D_DEFINE_ACC_MEAN(name,                       \
-                          type)                       \
-    D_INLINE bool                                     \
-    name                                              \
-    (                                                 \
-        void*       _accumulated,                     \
-        const void* _element,                         \
-        void*       _context                          \
-    )                                                 \
-    {                                                 \
-        struct d_acc_mean_state* _st;                 \
-        (void)_context;                               \
-        if ( (!_accumulated) || (!_element) )         \
-        {                                             \
-            return false;                             \
-        }                                             \
-        _st = (struct d_acc_mean_state*)_accumulated; \
-        _st->sum += (double)(*(const type*)_element); \
-        _st->count++;                                 \
-        return true;                                  \
+// NAME##_merge adds the sums and counts of two partial states.
+#define D_DEFINE_ACC_MEAN(name,                            \
+                          type)                            \
+    D_INLINE bool                                          \
+    name                                                   \
+    (                                                      \
+        void*       _accumulated,                          \
+        const void* _element,                              \
+        void*       _context                               \
+    )                                                      \
+    {                                                      \
+        struct d_acc_mean_state* _st;                      \
+        (void)_context;                                    \
+        if ( (!_accumulated) || (!_element) )              \
+        {                                                  \
+            return false;                                  \
+        }                                                  \
+        _st = (struct d_acc_mean_state*)_accumulated;      \
+        _st->sum += (double)(*(const type*)_element);      \
+        _st->count++;                                      \
+        return true;                                       \
+    }                                                      \
+                                                           \
+    D_INLINE bool                                          \
+    name##_merge                                           \
+    (                                                      \
+        void*       _accumulated,                          \
+        const void* _partial,                              \
+        void*       _context                               \
+    )                                                      \
+    {                                                      \
+        struct d_acc_mean_state*       _st;                \
+        const struct d_acc_mean_state* _other;             \
+        (void)_context;                                    \
+        if ( (!_accumulated) || (!_partial) )              \
+        {                                                  \
+            return false;                                  \
+        }                                                  \
+        _st    = (struct d_acc_mean_state*)_accumulated;   \
+        _other = (const struct d_acc_mean_state*)_partial; \
+        _st->sum   += _other->sum;                         \
+        _st->count += _other->count;                       \
+        return true;                                       \
     }
 
 
@@ -1971,6 +2142,30 @@ struct d_acc_mean_state
                                sizeof(type),                                \
                                (test))
 
+// D_FUNCTIONAL_INDEX_OF_VALUE
+//   macro: returns the zero-based index of the first element equal to the
+// value of TYPE at value_ptr, or (size_t)-1 if not found.
+#define D_FUNCTIONAL_INDEX_OF_VALUE(type,                                   \
+                                    in,                                     \
+                                    count,                                  \
+                                    value_ptr)                              \
+    d_functional_index_of_value((in),                                       \
+                                (count),                                    \
+                                sizeof(type),                               \
+                                (value_ptr))
+
+// D_FUNCTIONAL_LAST_INDEX_OF_VALUE
+//   macro: returns the zero-based index of the last element equal to the
+// value of TYPE at value_ptr, or (size_t)-1 if not found.
+#define D_FUNCTIONAL_LAST_INDEX_OF_VALUE(type,                              \
+                                         in,                                \
+                                         count,                             \
+                                         value_ptr)                         \
+    d_functional_last_index_of_value((in),                                  \
+                                     (count),                               \
+                                     sizeof(type),                          \
+                                     (value_ptr))
+
 
 
 bool   d_functional_is_sorted(const void* _input, size_t _count, size_t _element_size, fn_function_comparator _function_comparator);
@@ -2021,6 +2216,27 @@ size_t d_functional_last_index_of(const void* _input, size_t _count, size_t _ele
                               (fn),                                         \
                               (context))
 
+// D_FUNCTIONAL_PIPE_MAP_TO
+//   macro: pipeline map to elements of a new type, with NULL context.
+#define D_FUNCTIONAL_PIPE_MAP_TO(type,                                      \
+                                 pipe,                                      \
+                                 fn)                                        \
+    d_functional_pipeline_map_to((pipe),                                    \
+                                 sizeof(type),                              \
+                                 (fn),                                      \
+                                 NULL)
+
+// D_FUNCTIONAL_PIPE_MAP_TO_CONTEXT
+//   macro: pipeline map to elements of a new type, with explicit context.
+#define D_FUNCTIONAL_PIPE_MAP_TO_CONTEXT(type,                              \
+                                         pipe,                              \
+                                         fn,                                \
+                                         context)                           \
+    d_functional_pipeline_map_to((pipe),                                    \
+                                 sizeof(type),                              \
+                                 (fn),                                      \
+                                 (context))
+
 // D_FUNCTIONAL_PIPE_FILTER
 //   macro: pipeline filter with NULL context.
 #define D_FUNCTIONAL_PIPE_FILTER(pipe,                                      \
@@ -2095,6 +2311,69 @@ size_t d_functional_last_index_of(const void* _input, size_t _count, size_t _ele
     d_functional_pipeline_skip((pipe),                                      \
                                (n))
 
+// D_FUNCTIONAL_PIPE_FLAT_MAP
+//   macro: pipeline flat-map into elements of a new type, with NULL
+// context.
+#define D_FUNCTIONAL_PIPE_FLAT_MAP(type,                                    \
+                                   pipe,                                    \
+                                   max_count,                               \
+                                   fn)                                      \
+    d_functional_pipeline_flat_map((pipe),                                  \
+                                   sizeof(type),                            \
+                                   (max_count),                             \
+                                   (fn),                                    \
+                                   NULL)
+
+// D_FUNCTIONAL_PIPE_ZIP
+//   macro: pipeline zip into elements of a new type, with NULL context.
+#define D_FUNCTIONAL_PIPE_ZIP(type,                                         \
+                              pipe,                                         \
+                              other,                                        \
+                              fn)                                           \
+    d_functional_pipeline_zip((pipe),                                       \
+                              (other),                                      \
+                              sizeof(type),                                 \
+                              (fn),                                         \
+                              NULL)
+
+// D_FUNCTIONAL_PIPE_CHUNK
+//   macro: pipeline chunk with NULL context and typed summaries.
+#define D_FUNCTIONAL_PIPE_CHUNK(type,                                       \
+                                pipe,                                       \
+                                size,                                       \
+                                fn)                                         \
+    d_functional_pipeline_chunk((pipe),                                     \
+                                (size),                                     \
+                                sizeof(type),                               \
+                                (fn),                                       \
+                                NULL)
+
+// D_FUNCTIONAL_PIPE_WINDOW
+//   macro: pipeline sliding window advancing one element at a time, with
+// NULL context and typed summaries.
+#define D_FUNCTIONAL_PIPE_WINDOW(type,                                      \
+                                 pipe,                                      \
+                                 size,                                      \
+                                 fn)                                        \
+    d_functional_pipeline_window((pipe),                                    \
+                                 (size),                                    \
+                                 1,                                         \
+                                 sizeof(type),                              \
+                                 (fn),                                      \
+                                 NULL)
+
+// D_FUNCTIONAL_PIPE_SCAN
+//   macro: pipeline scan with NULL context and typed accumulator size.
+#define D_FUNCTIONAL_PIPE_SCAN(type,                                        \
+                               pipe,                                        \
+                               init,                                        \
+                               combine)                                     \
+    d_functional_pipeline_scan((pipe),                                      \
+                               (init),                                      \
+                               sizeof(type),                                \
+                               (combine),                                   \
+                               NULL)
+
 // D_FUNCTIONAL_PIPE_END
 //   macro: finalize pipeline and retrieve result.
 #define D_FUNCTIONAL_PIPE_END(pipe,                                         \
@@ -3,18 +3,22 @@
 *
 * Common types, macros, and utilities for the functional programming module.
 *   Provides function pointer type definitions (predicates, transformers,
-* consumers, producers, comparators, accumulators, reducers, generic
-* callbacks), inline/composition macro helpers, type-generic utilities
-* (C11+), user-defined typed function wrappers, and commonly used utility
-* functions (identity, constant, comparison, null-checking).
+* expanders, consumers, producers, comparators, accumulators, aggregators,
+* reducers, generic callbacks), inline/composition macro helpers,
+* type-generic utilities (C11+), user-defined typed function wrappers, and
+* commonly used utility functions (identity, constant, comparison,
+* null-checking).
 *
 * NAMING CONVENTIONS:
 *   fn_predicate         - function returning bool, taking one argument
 *   fn_transformer       - function transforming input to output
+*   fn_expander          - function transforming input to zero or more outputs
 *   fn_consumer          - function consuming value, returning void
 *   fn_producer          - function producing value, taking no input
 *   fn_comparator        - function comparing two values
 *   fn_accumulator       - function combining accumulated value with element
+*   fn_aggregator        - function summarizing a run of elements
+*   fn_combiner          - accumulator merging two partial states
 *
 * path:      \inc\functional\functional_common.h
 * link(s):   TBA
@@ -73,6 +77,25 @@ typedef bool (*fn_transformer)(const void* _input,
 //   type alias: alias for fn_transformer (common terminology).
 typedef fn_transformer d_mapper;
 
+// fn_expander
+//   function pointer: function transforming one input into zero or more
+// outputs. On entry *_count holds the most elements _output can take; on
+// return it holds the number written. Returns success status.
+// Note: `_context` may be NULL.
+typedef bool (*fn_expander)(const void* _input,
+                            void*       _output,
+                            size_t*     _count,
+                            void*       _context);
+
+// fn_aggregator
+//   function pointer: function summarizing a run of consecutive elements
+// (a chunk or a window) into one output. Returns success status.
+// Note: `_context` may be NULL.
+typedef bool (*fn_aggregator)(const void* _elements,
+                              size_t      _count,
+                              void*       _output,
+                              void*       _context);
+
 
 ///////////////////////////////////////////////////////////////////////////////
 ///             III.  CONSUMERS AND PRODUCERS                               ///
@@ -120,6 +143,12 @@ typedef bool (*fn_reducer)(const void* _element1,
                            void*       _result,
                            void*       _context);
 
+// fn_combiner
+//   type alias: fn_accumulator that merges a second partial state into
+// _accumulated (e.g. two partial sums). Must be associative so that partial
+// folds over adjacent ranges can be combined in any grouping.
+typedef fn_accumulator fn_combiner;
+
 
 ///////////////////////////////////////////////////////////////////////////////
 ///             V.    GENERIC CALLBACKS AND OPERATIONS                      ///
@@ -412,8 +441,9 @@ bool     d_functional_is_not_null(const void* _element, void* _context);
 ///             X.    HIGHER-ORDER FUNCTIONS                                ///
 ///////////////////////////////////////////////////////////////////////////////
 
-// i.    map
+// i.    map and filter
 bool     d_functional_map(const void* _input, void* _output, size_t _count, size_t _element_size, fn_transformer _transform, void* _context);
+size_t   d_functional_filter(const void* _input, void* _output, size_t _count, size_t _element_size, fn_predicate _test, void* _context);
          
 // ii.     fold
 bool     d_functional_fold_left(const void* _input, size_t _count, size_t _element_size, void* _accumulator, fn_accumulator _combine, void* _context);
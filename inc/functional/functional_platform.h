@@ -0,0 +1,146 @@
+/******************************************************************************
+* djinterp [functional]                                   functional_platform.h
+*
+* Minimal platform layer for the functional module.
+*   Wraps the few operating-system facilities the functional module needs -
+* thread-local storage, a mutex and condition variable, one-time
+* initialization, joinable worker threads, a cheap monotonic tick counter
+* and a nanosecond clock, memory-mapped files, and the process's peak memory
+* use - behind a small portable interface, so that the rest of the module
+* stays free of platform #ifs.
+*
+*
+* path:      \inc\functional\functional_platform.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_C_FUNCTIONAL_PLATFORM_
+#define DJINTERP_C_FUNCTIONAL_PLATFORM_ 1
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "..\djinterp.h"
+#include ".\functional_common.h"
+
+#if defined(_WIN32)
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <unistd.h>
+#endif
+
+
+// D_FUNCTIONAL_THREAD_LOCAL
+//   macro: storage class of a static variable with one instance per
+// thread.
+#if defined(_MSC_VER)
+    #define D_FUNCTIONAL_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+    #define D_FUNCTIONAL_THREAD_LOCAL _Thread_local
+#else
+    #define D_FUNCTIONAL_THREAD_LOCAL __thread
+#endif
+
+// d_functional_mutex
+//   type: non-recursive mutual exclusion lock.
+#if defined(_WIN32)
+    typedef CRITICAL_SECTION d_functional_mutex;
+#else
+    typedef pthread_mutex_t  d_functional_mutex;
+#endif
+
+// d_functional_cond
+//   type: condition variable, waited on together with a d_functional_mutex.
+#if defined(_WIN32)
+    typedef CONDITION_VARIABLE d_functional_cond;
+#else
+    typedef pthread_cond_t   d_functional_cond;
+#endif
+
+// d_functional_once
+//   type: flag of a one-time initialization; statically initialized with
+// D_FUNCTIONAL_ONCE_INIT.
+#if defined(_WIN32)
+    typedef INIT_ONCE        d_functional_once;
+    #define D_FUNCTIONAL_ONCE_INIT INIT_ONCE_STATIC_INIT
+#else
+    typedef pthread_once_t   d_functional_once;
+    #define D_FUNCTIONAL_ONCE_INIT PTHREAD_ONCE_INIT
+#endif
+
+// fn_once
+//   function pointer: one-time initializer run by d_functional_once_run.
+typedef void (*fn_once)(void);
+
+// d_functional_thread
+//   type: handle of a joinable worker thread.
+#if defined(_WIN32)
+    typedef HANDLE           d_functional_thread;
+#else
+    typedef pthread_t        d_functional_thread;
+#endif
+
+// d_functional_map_advice
+//   enum: expected access pattern of a range of a file mapping.
+enum d_functional_map_advice
+{
+    D_FUNCTIONAL_MAP_SEQUENTIAL = 0,  // read front to back; read ahead
+    D_FUNCTIONAL_MAP_WILLNEED,        // will be read soon; prefetch
+    D_FUNCTIONAL_MAP_DONTNEED         // no longer needed; may be dropped
+};
+
+// d_functional_mapping
+//   struct: a file mapped into memory, either privately (copy-on-write:
+// writes are visible only to this process) or shared for writing back to
+// the file. An empty file has a NULL data pointer.
+struct d_functional_mapping
+{
+    void*  data;      // start of the mapping, or NULL if size is 0
+    size_t size;      // mapped size in bytes
+    bool   writable;  // shared, written back to the file
+#if defined(_WIN32)
+    HANDLE file;
+    HANDLE map;
+#else
+    int    fd;
+#endif
+};
+
+
+// i.    synchronization
+bool     d_functional_mutex_init(d_functional_mutex* _mutex);
+void     d_functional_mutex_lock(d_functional_mutex* _mutex);
+void     d_functional_mutex_unlock(d_functional_mutex* _mutex);
+void     d_functional_mutex_destroy(d_functional_mutex* _mutex);
+void     d_functional_once_run(d_functional_once* _once, fn_once _initialize);
+bool     d_functional_cond_init(d_functional_cond* _cond);
+void     d_functional_cond_wait(d_functional_cond* _cond, d_functional_mutex* _mutex);
+void     d_functional_cond_signal(d_functional_cond* _cond);
+void     d_functional_cond_broadcast(d_functional_cond* _cond);
+void     d_functional_cond_destroy(d_functional_cond* _cond);
+
+// ii.   threads
+bool     d_functional_thread_start(d_functional_thread* _thread, fn_callback _entry, void* _argument);
+void     d_functional_thread_join(d_functional_thread _thread);
+size_t   d_functional_cpu_count(void);
+
+// iii.  timing
+uint64_t d_functional_ticks(void);
+uint64_t d_functional_nanoseconds(void);
+
+// iv.   file mapping
+bool     d_functional_map_open(struct d_functional_mapping* _mapping, const char* _path);
+bool     d_functional_map_create(struct d_functional_mapping* _mapping, const char* _path, size_t _size);
+bool     d_functional_map_resize(struct d_functional_mapping* _mapping, size_t _size);
+void     d_functional_map_advise(struct d_functional_mapping* _mapping, size_t _offset, size_t _length, enum d_functional_map_advice _advice);
+bool     d_functional_map_close(struct d_functional_mapping* _mapping, size_t _final_size);
+
+// v.    process
+size_t   d_functional_peak_rss(void);
+
+
+#endif  // DJINTERP_C_FUNCTIONAL_PLATFORM_
@@ -0,0 +1,77 @@
+/******************************************************************************
+* djinterp [functional]                                              group.h
+*
+* Keyed (group-by) aggregation.
+*   d_functional_group_fold extracts a key from every element with an
+* fn_transformer, finds the element's group in an open-addressing hash table
+* with linear probing, and folds the element into that group's state with an
+* fn_accumulator. New groups start from a copy of a caller-supplied initial
+* state. The result is a d_group_table whose keys and states are stored in
+* two compact arrays, in order of first appearance, so it can be iterated
+* like a plain array or queried with d_group_table_find.
+*   Keys are hashed with an fn_hasher (FNV-1a over the key bytes if none is
+* given) and compared with an fn_binary_predicate (byte comparison if none
+* is given). User hashes are scrambled before use, so weak hashers such as
+* the identity on integers are fine.
+*   d_functional_group_fold_parallel builds one table per thread over
+* contiguous chunks of the input, then merges the per-thread tables by hash
+* partition, one partition per thread, with an fn_combiner.
+*
+*
+* path:      \inc\functional\group.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_C_FUNCTIONAL_GROUP_
+#define DJINTERP_C_FUNCTIONAL_GROUP_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "..\djinterp.h"
+#include ".\functional_common.h"
+#include ".\allocator.h"
+#include ".\functional_platform.h"
+#include ".\reduce.h"
+
+
+// D_GROUP_INITIAL_CAPACITY
+//   constant: number of groups a new table has room for before growing.
+#ifndef D_GROUP_INITIAL_CAPACITY
+    #define D_GROUP_INITIAL_CAPACITY 16
+#endif
+
+// d_group_table
+//   struct: result of a grouped fold. Group i has key
+// (keys + i * key_size), state (states + i * state_size), and hash
+// hashes[i]. slots is the open-addressing index: 0 marks an empty slot,
+// otherwise the slot holds a group index + 1.
+struct d_group_table
+{
+    unsigned char*      keys;            // count keys, compact
+    unsigned char*      states;          // count states, compact
+    size_t*             hashes;          // mixed hash of every group
+    size_t              count;           // number of groups
+    size_t              key_size;
+    size_t              state_size;
+    size_t              group_capacity;  // groups allocated in the arrays
+    size_t*             slots;           // index; slot_count entries
+    size_t              slot_count;      // power of two
+    fn_hasher           hasher;          // NULL: FNV-1a over key bytes
+    fn_binary_predicate equal;           // NULL: byte comparison
+    void*               key_context;     // forwarded to hasher and equal
+};
+
+
+// i.    grouped folds
+struct d_group_table* d_functional_group_fold(const void* _input, size_t _count, size_t _element_size, fn_transformer _key, size_t _key_size, fn_hasher _hasher, fn_binary_predicate _equal, void* _key_context, fn_accumulator _step, const void* _initial, size_t _state_size, void* _context);
+struct d_group_table* d_functional_group_fold_parallel(const void* _input, size_t _count, size_t _element_size, fn_transformer _key, size_t _key_size, fn_hasher _hasher, fn_binary_predicate _equal, void* _key_context, fn_accumulator _step, fn_combiner _merge, const void* _initial, size_t _state_size, void* _context, size_t _threads);
+
+// ii.   table access
+void*                 d_group_table_find(const struct d_group_table* _table, const void* _key);
+void                  d_group_table_free(struct d_group_table* _table);
+
+
+#endif  // DJINTERP_C_FUNCTIONAL_GROUP_
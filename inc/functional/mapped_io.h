@@ -0,0 +1,88 @@
+/******************************************************************************
+* djinterp [functional]                                          mapped_io.h
+*
+* Memory-mapped record files as pipeline input and output.
+*   A d_mapped_input maps a file of fixed-size records into memory instead
+* of reading it into a malloc'd buffer. The mapping is private and
+* copy-on-write, so d_mapped_input_pipeline begins a pipeline in place
+* over it (d_functional_pipeline_begin_in_place): stages that fit write
+* into the mapping rather than a heap copy, the file never changing, and
+* d_mapped_input_source hands it out in chunks to a d_functional_stream or
+* d_filter_stream with no copying at all. The kernel is told the file will
+* be read sequentially, and each chunk prefetches the next.
+*   A d_mapped_output is a growing, shared mapping of an output file:
+* records are written (or produced in place through reserve / commit)
+* directly into the page cache, and the file is cut to the records
+* written when it is closed.
+*
+*
+* path:      \inc\functional\mapped_io.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_C_FUNCTIONAL_MAPPED_IO_
+#define DJINTERP_C_FUNCTIONAL_MAPPED_IO_ 1
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "..\djinterp.h"
+#include ".\functional_common.h"
+#include ".\allocator.h"
+#include ".\functional_platform.h"
+#include ".\pipeline.h"
+#include ".\stream.h"
+
+
+// D_MAPPED_IO_CHUNK_BYTES
+//   constant: default size in bytes of the chunks a mapped input hands
+// out, and of a mapped output's initial capacity.
+#ifndef D_MAPPED_IO_CHUNK_BYTES
+    #define D_MAPPED_IO_CHUNK_BYTES (1u << 20)
+#endif
+
+
+// d_mapped_input
+//   struct: a file of fixed-size records, mapped for reading.
+struct d_mapped_input
+{
+    struct d_functional_mapping mapping;
+    size_t                      element_size;  // bytes per record
+    size_t                      count;         // records in the file
+    size_t                      position;      // next record of the source
+    size_t                      chunk_count;   // records per source chunk
+};
+
+// d_mapped_output
+//   struct: a file of fixed-size records being written through a growing
+// shared mapping. If an error occurs, subsequent writes fail and
+// error_code is non-zero.
+struct d_mapped_output
+{
+    struct d_functional_mapping mapping;
+    size_t                      element_size;  // bytes per record
+    size_t                      count;         // records written
+    size_t                      capacity;      // records the mapping holds
+    int                         error_code;    // 0 = success
+};
+
+
+// i.    mapped input
+struct d_mapped_input*       d_functional_mapped_input(const char* _path, size_t _element_size);
+const void*                  d_mapped_input_data(const struct d_mapped_input* _input);
+size_t                       d_mapped_input_count(const struct d_mapped_input* _input);
+struct d_functional_source   d_mapped_input_source(struct d_mapped_input* _input, size_t _chunk_count);
+struct d_functional_pipeline d_mapped_input_pipeline(struct d_mapped_input* _input);
+void                         d_mapped_input_free(struct d_mapped_input* _input);
+
+// ii.   mapped output
+struct d_mapped_output*      d_functional_mapped_output(const char* _path, size_t _element_size, size_t _initial_count);
+void*                        d_mapped_output_reserve(struct d_mapped_output* _output, size_t _count);
+bool                         d_mapped_output_commit(struct d_mapped_output* _output, size_t _count);
+bool                         d_mapped_output_write(struct d_mapped_output* _output, const void* _elements, size_t _count);
+bool                         d_mapped_output_drain(struct d_mapped_output* _output, struct d_functional_source* _source);
+bool                         d_mapped_output_close(struct d_mapped_output* _output);
+
+
+#endif  // DJINTERP_C_FUNCTIONAL_MAPPED_IO_
@@ -0,0 +1,121 @@
+/******************************************************************************
+* djinterp [functional]                                           memoize.h
+*
+* Memoization of pure predicates and transformers.
+*   A d_memoize wraps an expensive, pure fn_predicate or fn_transformer with a
+* bounded cache keyed on the input's bytes. Lookups hash the key with an
+* fn_hasher (FNV-1a over the key bytes by default) into a 4-way
+* set-associative table; full sets evict with the CLOCK (second chance)
+* policy. The wrapped function is exposed again through the
+* d_functional_memoized_test / d_functional_memoized_apply adapters, so it
+* plugs in anywhere an fn_predicate or fn_transformer is accepted.
+*   A memo created with one or more shards splits its table into
+* independently locked shards and may be used from several threads at once;
+* a memo created with zero shards takes no locks.
+*
+*
+* path:      \inc\functional\memoize.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_C_FUNCTIONAL_MEMOIZE_
+#define DJINTERP_C_FUNCTIONAL_MEMOIZE_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "..\djinterp.h"
+#include ".\functional_common.h"
+#include ".\allocator.h"
+#include ".\functional_platform.h"
+
+
+// D_MEMOIZE_WAYS
+//   constant: number of entries per set of the cache.
+#ifndef D_MEMOIZE_WAYS
+    #define D_MEMOIZE_WAYS 4
+#endif
+
+// D_MEMOIZE_DEFAULT_CAPACITY
+//   constant: number of entries used when a capacity of 0 is requested.
+#ifndef D_MEMOIZE_DEFAULT_CAPACITY
+    #define D_MEMOIZE_DEFAULT_CAPACITY 1024
+#endif
+
+// d_memoize_kind
+//   enum: the kind of function wrapped by a d_memoize.
+enum d_memoize_kind
+{
+    D_MEMOIZE_PREDICATE   = 0,
+    D_MEMOIZE_TRANSFORMER = 1
+};
+
+// d_memoize_stats
+//   struct: cache counters, summed over all shards.
+struct d_memoize_stats
+{
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    size_t   entries;   // valid entries currently cached
+    size_t   capacity;  // total entries the cache can hold
+};
+
+// d_memoize_shard
+//   struct: one independently locked part of a memo's cache. Shard i owns
+// sets [i * sets, (i + 1) * sets) of the memo's slot arrays.
+struct d_memoize_shard
+{
+    size_t             first_set;
+    uint64_t           hits;
+    uint64_t           misses;
+    uint64_t           evictions;
+    d_functional_mutex lock;
+};
+
+// d_memoize
+//   struct: a memoized predicate or transformer.
+// Slot arrays are stored set-major: entry w of set s is slot
+// (s * D_MEMOIZE_WAYS + w).
+struct d_memoize
+{
+    enum d_memoize_kind     kind;
+    fn_predicate            predicate;
+    fn_transformer          transform;
+    void*                   context;
+    fn_hasher               hasher;          // NULL hashes the key bytes
+    void*                   hasher_context;
+    fn_binary_predicate     equal;           // NULL compares the key bytes
+    void*                   equal_context;
+    size_t                  key_size;
+    size_t                  value_size;
+    size_t                  sets_per_shard;  // power of two
+    size_t                  shard_count;     // power of two
+    bool                    locking;
+    struct d_memoize_shard* shards;
+    size_t*                 hashes;
+    unsigned char*          keys;
+    unsigned char*          values;
+    unsigned char*          flags;           // valid / referenced bits
+    unsigned char*          hands;           // CLOCK hand per set
+};
+
+
+// i.    construction
+struct d_memoize* d_functional_memoize_predicate(fn_predicate _predicate, void* _context, size_t _key_size, fn_hasher _hasher, void* _hasher_context, size_t _capacity, size_t _shards);
+struct d_memoize* d_functional_memoize_transformer(fn_transformer _transform, void* _context, size_t _key_size, size_t _output_size, fn_hasher _hasher, void* _hasher_context, size_t _capacity, size_t _shards);
+bool              d_functional_memoize_set_equality(struct d_memoize* _memo, fn_binary_predicate _equal, void* _context);
+
+// ii.   evaluation
+bool              d_functional_memoized_test(const void* _element, void* _context);
+bool              d_functional_memoized_apply(const void* _input, void* _output, void* _context);
+
+// iii.  statistics and cleanup
+bool              d_functional_memoize_stats(struct d_memoize* _memo, struct d_memoize_stats* _stats);
+void              d_functional_memoize_clear(struct d_memoize* _memo);
+void              d_functional_memoize_free(struct d_memoize* _memo);
+
+
+#endif  // DJINTERP_C_FUNCTIONAL_MEMOIZE_
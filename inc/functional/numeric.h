@@ -0,0 +1,79 @@
+/******************************************************************************
+* djinterp [functional]                                            numeric.h
+*
+* Typed numeric reductions.
+*   The generic fold (d_functional_fold_left with a D_DEFINE_ACC_*
+* accumulator) makes one indirect call and one store through _accumulated
+* per element, which keeps compilers from vectorizing it. The functions here
+* reduce plain int32_t / int64_t / size_t / float / double arrays directly:
+* every kernel keeps several independent accumulators to break the
+* loop-carried dependency chain, and the hottest kernels (32-bit integer and
+* double sums, double and 32-bit integer extrema) have explicit SSE2 / AVX2
+* paths on x86. Define D_FUNCTIONAL_NO_SIMD to force the portable kernels.
+*   Integer sums widen to 64 bits; float sums accumulate in double. Double
+* sums come in three flavours: the fast multi-accumulator sum, a pairwise
+* sum (O(log n) error growth at nearly the same speed), and a compensated
+* (Kahan-Babuska) sum for ill-conditioned data. The compensated sum must not
+* be compiled with value-unsafe float optimizations such as -ffast-math.
+*   Results are unspecified for floating-point inputs containing NaN.
+*
+*
+* path:      \inc\functional\numeric.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_C_FUNCTIONAL_NUMERIC_
+#define DJINTERP_C_FUNCTIONAL_NUMERIC_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include "..\djinterp.h"
+
+
+// D_NUMERIC_PAIRWISE_BLOCK
+//   constant: block length below which the pairwise sum stops recursing and
+// sums directly.
+#ifndef D_NUMERIC_PAIRWISE_BLOCK
+    #define D_NUMERIC_PAIRWISE_BLOCK 128
+#endif
+
+
+// i.    sums
+int64_t d_functional_sum_i32(const int32_t* _values, size_t _count);
+int64_t d_functional_sum_i64(const int64_t* _values, size_t _count);
+size_t  d_functional_sum_size(const size_t* _values, size_t _count);
+double  d_functional_sum_f32(const float* _values, size_t _count);
+double  d_functional_sum_f64(const double* _values, size_t _count);
+double  d_functional_sum_f64_pairwise(const double* _values, size_t _count);
+double  d_functional_sum_f64_compensated(const double* _values, size_t _count);
+
+// ii.   extrema
+bool    d_functional_min_i32(const int32_t* _values, size_t _count, int32_t* _min);
+bool    d_functional_max_i32(const int32_t* _values, size_t _count, int32_t* _max);
+bool    d_functional_minmax_i32(const int32_t* _values, size_t _count, int32_t* _min, int32_t* _max);
+bool    d_functional_min_i64(const int64_t* _values, size_t _count, int64_t* _min);
+bool    d_functional_max_i64(const int64_t* _values, size_t _count, int64_t* _max);
+bool    d_functional_minmax_i64(const int64_t* _values, size_t _count, int64_t* _min, int64_t* _max);
+bool    d_functional_min_size(const size_t* _values, size_t _count, size_t* _min);
+bool    d_functional_max_size(const size_t* _values, size_t _count, size_t* _max);
+bool    d_functional_minmax_size(const size_t* _values, size_t _count, size_t* _min, size_t* _max);
+bool    d_functional_min_f64(const double* _values, size_t _count, double* _min);
+bool    d_functional_max_f64(const double* _values, size_t _count, double* _max);
+bool    d_functional_minmax_f64(const double* _values, size_t _count, double* _min, double* _max);
+
+// iii.  extremum positions
+bool    d_functional_argmin_i32(const int32_t* _values, size_t _count, size_t* _index);
+bool    d_functional_argmax_i32(const int32_t* _values, size_t _count, size_t* _index);
+bool    d_functional_argmin_f64(const double* _values, size_t _count, size_t* _index);
+bool    d_functional_argmax_f64(const double* _values, size_t _count, size_t* _index);
+
+// iv.   moments
+bool    d_functional_mean_i32(const int32_t* _values, size_t _count, double* _mean);
+bool    d_functional_mean_i64(const int64_t* _values, size_t _count, double* _mean);
+bool    d_functional_mean_f64(const double* _values, size_t _count, double* _mean);
+bool    d_functional_variance_i32(const int32_t* _values, size_t _count, bool _sample, double* _variance);
+bool    d_functional_variance_f64(const double* _values, size_t _count, bool _sample, double* _variance);
+
+
+#endif  // DJINTERP_C_FUNCTIONAL_NUMERIC_
@@ -3,9 +3,18 @@
 *
 * Function pipeline for chaining operations in the functional module.
 *   Provides a pipeline struct that holds intermediate results and supports
-* chainable map, filter, fold, for-each, take, and skip operations. Each
-* operation accepts a void* _context parameter (may be NULL) that is
-* forwarded to the callback.
+* chainable map, type-changing map, filter, fold, multi-aggregate fold,
+* for-each, take, skip, flat-map, zip, chunk, sliding-window, and scan
+* (running fold) operations. Each operation accepts a void* _context
+* parameter (may be NULL) that is forwarded to the callback.
+*   A pipeline that owns its data works in place wherever it can: maps,
+* narrowing map_to, zip, chunk, window, and scan stages overwrite the owned
+* buffer element by element, and filters compact it. Stages that cannot
+* (large or widened elements) write into a second, recycled buffer and swap
+* the two, so that an N-stage pipeline never holds more than two buffers
+* and allocates only when a buffer has to grow. Stages over borrowed data
+* allocate the buffer the pipeline then owns. A pipeline begun in place
+* treats the caller's data as owned, but never frees it.
 *
 * path:      \inc\functional\pipeline.h
 * link(s):   TBA
@@ -18,13 +27,25 @@
 #include <stdlib.h>
 #include "..\djinterp.h"
 #include ".\functional_common.h"
+#include ".\allocator.h"
+#include ".\profile.h"
+#include ".\reduce.h"
 
 
+// D_FUNCTIONAL_PIPELINE_SCRATCH_SIZE
+//   constant: largest element, in bytes, that a map over owned data
+// transforms in place through a stack buffer; larger elements are mapped
+// into the spare buffer.
+#ifndef D_FUNCTIONAL_PIPELINE_SCRATCH_SIZE
+    #define D_FUNCTIONAL_PIPELINE_SCRATCH_SIZE 64
+#endif
+
 // d_functional_pipeline
 //   struct: holds intermediate results for a function pipeline.
 // Operations return a new pipeline struct, allowing chaining. If an error
 // occurs at any stage, subsequent operations are no-ops and the error_code
-// is propagated through.
+// is propagated through. The buffer fields are only meaningful while the
+// pipeline owns its data; data may point into buffer after a skip.
 struct d_functional_pipeline
 {
     void*  data;           // current data pointer
@@ -32,19 +53,32 @@ struct d_functional_pipeline
     size_t count;          // number of elements
     bool   owns_data;      // whether pipeline owns the data
     int    error_code;     // error status (0 = success)
+    void*  buffer;         // owned allocation holding data
+    size_t capacity;       // size of buffer in bytes
+    void*  spare;          // recycled second buffer, or NULL
+    size_t spare_capacity; // size of spare in bytes
+    void*  lent;           // caller's buffer written in place, never freed
 };
 
 // i.    pipeline creation
 struct d_functional_pipeline d_functional_pipeline_begin(void* _data, size_t _count, size_t _element_size);
 struct d_functional_pipeline d_functional_pipeline_begin_copy(const void* _data, size_t _count, size_t _element_size);
+struct d_functional_pipeline d_functional_pipeline_begin_in_place(void* _data, size_t _count, size_t _element_size);
 
 // ii.   pipeline operations (chainable)
 struct d_functional_pipeline d_functional_pipeline_map(struct d_functional_pipeline _pipe, fn_transformer _transform, void* _context);
+struct d_functional_pipeline d_functional_pipeline_map_to(struct d_functional_pipeline _pipe, size_t _output_size, fn_transformer _transform, void* _context);
 struct d_functional_pipeline d_functional_pipeline_filter(struct d_functional_pipeline _pipe, fn_predicate _test, void* _context);
 struct d_functional_pipeline d_functional_pipeline_fold(struct d_functional_pipeline _pipe, void* _initial, size_t _accumulator_size, fn_accumulator _combine, void* _context);
+struct d_functional_pipeline d_functional_pipeline_fold_multi(struct d_functional_pipeline _pipe, const struct d_fold_spec* _specs, size_t _spec_count);
 struct d_functional_pipeline d_functional_pipeline_for_each(struct d_functional_pipeline _pipe, fn_consumer _apply, void* _context);
 struct d_functional_pipeline d_functional_pipeline_take(struct d_functional_pipeline _pipe, size_t _n);
 struct d_functional_pipeline d_functional_pipeline_skip(struct d_functional_pipeline _pipe, size_t _n);
+struct d_functional_pipeline d_functional_pipeline_flat_map(struct d_functional_pipeline _pipe, size_t _output_size, size_t _max_count, fn_expander _expand, void* _context);
+struct d_functional_pipeline d_functional_pipeline_zip(struct d_functional_pipeline _pipe, struct d_functional_pipeline _other, size_t _output_size, fn_binary_operation _combine, void* _context);
+struct d_functional_pipeline d_functional_pipeline_chunk(struct d_functional_pipeline _pipe, size_t _size, size_t _output_size, fn_aggregator _aggregate, void* _context);
+struct d_functional_pipeline d_functional_pipeline_window(struct d_functional_pipeline _pipe, size_t _size, size_t _step, size_t _output_size, fn_aggregator _aggregate, void* _context);
+struct d_functional_pipeline d_functional_pipeline_scan(struct d_functional_pipeline _pipe, void* _initial, size_t _accumulator_size, fn_accumulator _combine, void* _context);
 
 // iii.  pipeline finalization
 void* d_functional_pipeline_end(struct d_functional_pipeline _pipe, size_t* _out_count);
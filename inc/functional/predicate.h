@@ -5,6 +5,12 @@
 *   Provides structs and functions for combining predicates with logical AND,
 * OR, and NOT operations. Each combinator stores fn_predicate function pointers
 * with nullable context fields.
+*   Larger expressions can instead be assembled with a d_predicate_expr
+* builder and compiled into a flat d_predicate_program, which evaluates the
+* whole expression in one loop with short-circuiting.
+*   Adaptive conjunctions and disjunctions measure how often each leaf decides
+* the result and how much it costs, and periodically reorder their leaves so
+* that cheap, selective tests run first.
 *
 * 
 * path:      \inc\functional\predicate.h
@@ -15,9 +21,14 @@
 #ifndef DJINTERP_C_FUNCTIONAL_PREDICATE_
 #define DJINTERP_C_FUNCTIONAL_PREDICATE_ 1
 
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include "..\djinterp.h"
 #include ".\functional_common.h"
+#include ".\allocator.h"
+#include ".\fn_arena.h"
+#include ".\functional_platform.h"
 
 
 // d_predicate_and
@@ -142,10 +153,192 @@ struct d_predicate_or*  d_predicate_or_new( fn_predicate _predicate1, void* _con
 struct d_predicate_xor* d_predicate_xor_new(fn_predicate _predicate1, void* _context1, fn_predicate _predicate2, void* _context2);
 struct d_predicate_not* d_predicate_not_new(fn_predicate _predicate,  void* _context);
 
+// arena-backed constructors; release with d_fn_arena_reset/d_fn_arena_free
+struct d_predicate_and* d_predicate_and_new_in(struct d_fn_arena* _arena, fn_predicate _predicate1, void* _context1, fn_predicate _predicate2, void* _context2);
+struct d_predicate_or*  d_predicate_or_new_in( struct d_fn_arena* _arena, fn_predicate _predicate1, void* _context1, fn_predicate _predicate2, void* _context2);
+struct d_predicate_xor* d_predicate_xor_new_in(struct d_fn_arena* _arena, fn_predicate _predicate1, void* _context1, fn_predicate _predicate2, void* _context2);
+struct d_predicate_not* d_predicate_not_new_in(struct d_fn_arena* _arena, fn_predicate _predicate,  void* _context);
+
 bool d_predicate_and_eval(const struct d_predicate_and* _combo, const void* _element);
 bool d_predicate_or_eval( const struct d_predicate_or*  _combo, const void* _element);
 bool d_predicate_xor_eval(const struct d_predicate_xor* _combo, const void* _element);
 bool d_predicate_not_eval(const struct d_predicate_not* _combo, const void* _element);
 
 
+// D_PREDICATE_EXPR_MAX_DEPTH
+//   constant: maximum number of values a d_predicate_program may hold on its
+// evaluation stack (nested XOR and N_OF operands).
+#ifndef D_PREDICATE_EXPR_MAX_DEPTH
+    #define D_PREDICATE_EXPR_MAX_DEPTH 64
+#endif
+
+// d_predicate_expr_op
+//   enum: node kinds of a predicate expression.
+enum d_predicate_expr_op
+{
+    D_PREDICATE_EXPR_LEAF = 0,  // a single fn_predicate
+    D_PREDICATE_EXPR_AND  = 1,  // all operands true
+    D_PREDICATE_EXPR_OR   = 2,  // any operand true
+    D_PREDICATE_EXPR_XOR  = 3,  // odd number of operands true
+    D_PREDICATE_EXPR_NOT  = 4,  // operand false
+    D_PREDICATE_EXPR_N_OF = 5   // at least n operands true
+};
+
+// d_predicate_leaf
+//   struct: a predicate and the context it is evaluated with.
+struct d_predicate_leaf
+{
+    fn_predicate predicate;
+    void*        context;
+};
+
+// d_predicate_expr_node
+//   struct: one node of an expression under construction, in postfix order.
+// span counts the node itself plus every node of its operands, so the
+// operands of the node at index i end at index i - 1.
+struct d_predicate_expr_node
+{
+    enum d_predicate_expr_op op;
+    size_t                   arity;  // number of operands
+    size_t                   arg;    // leaf index (LEAF) or threshold (N_OF)
+    size_t                   span;   // size of this subtree in nodes
+};
+
+// d_predicate_expr
+//   struct: stack-based builder for predicate expressions.
+// Each leaf pushes a subexpression; each combinator pops its operands and
+// pushes the combined subexpression. A builder holding exactly one
+// subexpression can be compiled with d_predicate_expr_compile.
+struct d_predicate_expr
+{
+    struct d_predicate_expr_node* nodes;
+    size_t                        node_count;
+    size_t                        node_capacity;
+    struct d_predicate_leaf*      leaves;
+    size_t                        leaf_count;
+    size_t                        leaf_capacity;
+    size_t                        pending;  // subexpressions on the stack
+    bool                          failed;   // a previous call failed
+};
+
+// d_predicate_instr
+//   struct: one instruction of a compiled predicate program.
+struct d_predicate_instr
+{
+    uint16_t op;      // opcode (internal)
+    uint16_t negate;  // invert a leaf's result
+    uint32_t arg;     // leaf index, constant, or N_OF threshold
+    uint32_t remain;  // N_OF operands left after this one
+    uint32_t target;  // jump target for short-circuit opcodes
+};
+
+// d_predicate_program
+//   struct: compiled, flat form of a predicate expression.
+// The header, leaf table and instructions live in a single allocation.
+struct d_predicate_program
+{
+    const struct d_predicate_leaf*  leaves;
+    const struct d_predicate_instr* code;
+    size_t                          leaf_count;
+    size_t                          code_count;
+    size_t                          max_depth;
+};
+
+// i.    expression building
+struct d_predicate_expr* d_predicate_expr_new(void);
+bool                     d_predicate_expr_leaf(struct d_predicate_expr* _expr, fn_predicate _predicate, void* _context);
+bool                     d_predicate_expr_and(struct d_predicate_expr* _expr, size_t _arity);
+bool                     d_predicate_expr_or(struct d_predicate_expr* _expr, size_t _arity);
+bool                     d_predicate_expr_xor(struct d_predicate_expr* _expr, size_t _arity);
+bool                     d_predicate_expr_not(struct d_predicate_expr* _expr);
+bool                     d_predicate_expr_n_of(struct d_predicate_expr* _expr, size_t _n, size_t _arity);
+void                     d_predicate_expr_free(struct d_predicate_expr* _expr);
+
+// ii.   compilation and evaluation
+struct d_predicate_program* d_predicate_expr_compile(const struct d_predicate_expr* _expr);
+bool                        d_predicate_program_eval(const struct d_predicate_program* _program, const void* _element);
+bool                        d_predicate_program_test(const void* _element, void* _context);
+size_t                      d_predicate_program_eval_array(const struct d_predicate_program* _program, const void* _input, size_t _count, size_t _element_size, uint64_t* _bitmask);
+void                        d_predicate_program_free(struct d_predicate_program* _program);
+
+
+// D_PREDICATE_ADAPTIVE_REORDER_INTERVAL
+//   constant: default number of evaluations between reorders of a
+// d_predicate_adaptive.
+#ifndef D_PREDICATE_ADAPTIVE_REORDER_INTERVAL
+    #define D_PREDICATE_ADAPTIVE_REORDER_INTERVAL 1024
+#endif
+
+// D_PREDICATE_ADAPTIVE_SAMPLE_INTERVAL
+//   constant: a leaf's cost is timed on one of every this many calls; the
+// remaining calls pay no timing overhead. Should be a power of two.
+#ifndef D_PREDICATE_ADAPTIVE_SAMPLE_INTERVAL
+    #define D_PREDICATE_ADAPTIVE_SAMPLE_INTERVAL 16
+#endif
+
+// d_predicate_adaptive_mode
+//   enum: how the leaves of a d_predicate_adaptive are combined.
+enum d_predicate_adaptive_mode
+{
+    D_PREDICATE_ADAPTIVE_AND = 0,  // all leaves true; decided by a false leaf
+    D_PREDICATE_ADAPTIVE_OR  = 1   // any leaf true; decided by a true leaf
+};
+
+// d_predicate_adaptive_leaf
+//   struct: a leaf of an adaptive combinator with its running statistics.
+// Counters are halved after every reorder so that the ordering follows
+// changes in the data.
+struct d_predicate_adaptive_leaf
+{
+    fn_predicate predicate;
+    void*        context;
+    size_t       index;          // position given to d_predicate_adaptive_new
+    uint64_t     calls;          // evaluations of this leaf
+    uint64_t     decisive;       // evaluations that decided the result
+    uint64_t     sampled_calls;  // evaluations that were timed
+    uint64_t     sampled_ticks;  // total ticks of the timed evaluations
+};
+
+// d_predicate_adaptive_stats
+//   struct: published statistics for one leaf of a d_predicate_adaptive.
+struct d_predicate_adaptive_stats
+{
+    size_t   index;     // position given to d_predicate_adaptive_new
+    size_t   position;  // current evaluation position (0 runs first)
+    uint64_t calls;
+    uint64_t decisive;
+    double   cost;      // mean ticks per timed call
+    double   rank;      // ordering key; lower runs earlier
+};
+
+// d_predicate_adaptive
+//   struct: AND/OR combinator over any number of leaves that reorders its
+// leaves by observed cost and decisiveness.
+//   Evaluation updates the statistics without locking, so an instance must
+// only be evaluated by one thread at a time. Each reorder publishes a copy of
+// the statistics under `lock`, which d_predicate_adaptive_snapshot may read
+// from any thread.
+struct d_predicate_adaptive
+{
+    enum d_predicate_adaptive_mode     mode;
+    struct d_predicate_adaptive_leaf*  leaves;   // in evaluation order
+    size_t                             count;
+    uint64_t                           evaluations;
+    uint64_t                           next_reorder;
+    size_t                             reorder_interval;
+    uint64_t                           reorders;
+    struct d_predicate_adaptive_stats* published;
+    uint64_t                           published_evaluations;
+    d_functional_mutex                 lock;
+};
+
+// iii.  adaptive combinators
+struct d_predicate_adaptive* d_predicate_adaptive_new(enum d_predicate_adaptive_mode _mode, const struct d_predicate_leaf* _leaves, size_t _count);
+bool                         d_predicate_adaptive_eval(struct d_predicate_adaptive* _adaptive, const void* _element);
+bool                         d_predicate_adaptive_test(const void* _element, void* _context);
+void                         d_predicate_adaptive_reorder(struct d_predicate_adaptive* _adaptive);
+size_t                       d_predicate_adaptive_snapshot(struct d_predicate_adaptive* _adaptive, struct d_predicate_adaptive_stats* _stats, size_t _capacity, uint64_t* _evaluations);
+void                         d_predicate_adaptive_free(struct d_predicate_adaptive* _adaptive);
+
+
 #endif  // DJINTERP_C_FUNCTIONAL_PREDICATE_
\ No newline at end of file
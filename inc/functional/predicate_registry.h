@@ -0,0 +1,168 @@
+/******************************************************************************
+* djinterp [functional]                                 predicate_registry.h
+*
+* Named, parameterized predicates and comparators.
+*   A filter operation holds a bare fn_predicate / fn_function_comparator
+* and a context pointer, neither of which means anything outside the
+* process that created it. A d_predicate_registry maps stable names with
+* typed parameters - `gt_i32, 100`, `between_f64, 0.5, 2`, `desc_i64` - to
+* a function and a context holding the bound parameters, and back again,
+* so that filter chains can be written out, parsed in another process, and
+* keyed by a canonical string (see d_filter_chain_to_string,
+* d_filter_chain_from_string, and d_filter_chain_canonical). The binary
+* encoding (d_filter_chain_encode) refers to entries by their id instead.
+*   Resolved instances are interned: while a context is held, the same name
+* and arguments give the same context pointer. Two chains built from the
+* same text therefore compare equal operation by operation, and formatting
+* an operation is a lookup rather than a guess. Each resolution adds a
+* reference that its holder gives back with d_predicate_registry_release,
+* and the context is freed with the last one; filter operations and chains
+* release the contexts they were built with when they are freed.
+*   d_predicate_registry_global is the process-wide registry used by the
+* filter serializers; it starts with the built-in comparisons (eq, ne, lt,
+* le, gt, ge, between) and comparators (asc, desc) for i32, i64, and f64,
+* plus even / odd for the integer types. Registries are thread-safe.
+*   Registries from d_predicate_registry_new allocate from the current
+* allocator (allocator.h); the global registry lives for the whole process,
+* past any allocator scope, and so always uses the C library.
+*
+*
+* path:      \inc\functional\predicate_registry.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_C_FUNCTIONAL_PREDICATE_REGISTRY_
+#define DJINTERP_C_FUNCTIONAL_PREDICATE_REGISTRY_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "..\djinterp.h"
+#include ".\functional_common.h"
+#include ".\allocator.h"
+#include ".\functional_platform.h"
+
+
+// D_REGISTRY_MAX_PARAMS
+//   constant: maximum number of parameters of a registered function.
+#ifndef D_REGISTRY_MAX_PARAMS
+    #define D_REGISTRY_MAX_PARAMS 4
+#endif
+
+// D_REGISTRY_MAX_NAME
+//   constant: maximum length of a registered name, including the
+// terminator.
+#ifndef D_REGISTRY_MAX_NAME
+    #define D_REGISTRY_MAX_NAME 48
+#endif
+
+
+// d_registry_kind
+//   enum: what a registry entry names.
+enum d_registry_kind
+{
+    D_REGISTRY_PREDICATE = 0,
+    D_REGISTRY_COMPARATOR
+};
+
+// d_registry_param
+//   enum: type of a parameter. Bound parameters are laid out in the
+// context like the members of a C struct of these types, so a single
+// `i32` parameter is an `int32_t` context and `between_i32` receives an
+// `int32_t[2]`.
+enum d_registry_param
+{
+    D_REGISTRY_PARAM_I32 = 0,  // int32_t
+    D_REGISTRY_PARAM_I64,      // int64_t
+    D_REGISTRY_PARAM_F64       // double
+};
+
+// d_registry_arg
+//   struct: a parsed argument: an integer literal, or a real literal when
+// is_real is set. Integers convert to any parameter type they fit; reals
+// only to f64.
+struct d_registry_arg
+{
+    bool    is_real;
+    int64_t integer;
+    double  real;
+};
+
+// d_registry_entry
+//   struct: a registered name. `id` is its registration order, stable for
+// a given sequence of registrations.
+struct d_registry_entry
+{
+    char                   name[D_REGISTRY_MAX_NAME];
+    enum d_registry_kind   kind;
+    fn_predicate           test;          // predicates
+    fn_function_comparator compare;       // comparators
+    enum d_registry_param  params[D_REGISTRY_MAX_PARAMS];
+    size_t                 param_count;
+    size_t                 context_size;  // bytes of bound parameters
+    uint32_t               id;
+};
+
+// d_registry_instance
+//   struct: an interned entry with bound parameters; `context` points just
+// past the struct and never moves. Each instance is on two hash chains: by
+// entry and parameters, to intern, and by context address, to look it up.
+struct d_registry_instance
+{
+    size_t                      entry;         // index into the entries
+    size_t                      hash;          // of entry and parameters
+    size_t                      references;    // holders of the context
+    struct d_registry_instance* next;          // in its `instances` bucket
+    struct d_registry_instance* next_address;  // in its `addresses` bucket
+    void*                       context;       // bound parameters
+};
+
+// d_predicate_registry
+//   struct: registered names and their interned instances.
+struct d_predicate_registry
+{
+    struct d_registry_entry*     entries;
+    size_t                       entry_count;
+    size_t                       entry_capacity;
+    struct d_registry_instance** instances;     // buckets by parameters
+    struct d_registry_instance** addresses;     // buckets by context
+    size_t                       instance_count;
+    size_t                       bucket_count;  // a power of two, or 0
+    bool                         global;        // outside any allocator
+    d_functional_mutex           lock;
+};
+
+
+// i.    registry creation
+struct d_predicate_registry* d_predicate_registry_new(void);
+struct d_predicate_registry* d_predicate_registry_global(void);
+bool                         d_predicate_registry_add_builtins(struct d_predicate_registry* _registry);
+void                         d_predicate_registry_free(struct d_predicate_registry* _registry);
+
+// ii.   registration
+bool d_predicate_registry_add_predicate(struct d_predicate_registry* _registry, const char* _name, fn_predicate _test, const enum d_registry_param* _params, size_t _param_count);
+bool d_predicate_registry_add_comparator(struct d_predicate_registry* _registry, const char* _name, fn_function_comparator _compare, const enum d_registry_param* _params, size_t _param_count);
+
+// iii.  resolution (name and arguments to function and context)
+bool d_predicate_registry_predicate(struct d_predicate_registry* _registry, const char* _name, size_t _name_length, const struct d_registry_arg* _args, size_t _arg_count, fn_predicate* _test, void** _context);
+bool d_predicate_registry_comparator(struct d_predicate_registry* _registry, const char* _name, size_t _name_length, const struct d_registry_arg* _args, size_t _arg_count, fn_function_comparator* _compare, void** _context);
+bool d_predicate_registry_predicate_by_id(struct d_predicate_registry* _registry, uint32_t _id, const struct d_registry_arg* _args, size_t _arg_count, fn_predicate* _test, void** _context);
+bool d_predicate_registry_comparator_by_id(struct d_predicate_registry* _registry, uint32_t _id, const struct d_registry_arg* _args, size_t _arg_count, fn_function_comparator* _compare, void** _context);
+
+// iv.   formatting (function and context to name and arguments)
+size_t d_predicate_registry_format_predicate(struct d_predicate_registry* _registry, fn_predicate _test, const void* _context, char* _buffer, size_t _size);
+size_t d_predicate_registry_format_comparator(struct d_predicate_registry* _registry, fn_function_comparator _compare, const void* _context, char* _buffer, size_t _size);
+
+// v.    identification (function and context to entry and arguments)
+bool   d_predicate_registry_identify_predicate(struct d_predicate_registry* _registry, fn_predicate _test, const void* _context, struct d_registry_entry* _entry, struct d_registry_arg* _args);
+bool   d_predicate_registry_identify_comparator(struct d_predicate_registry* _registry, fn_function_comparator _compare, const void* _context, struct d_registry_entry* _entry, struct d_registry_arg* _args);
+
+// vi.   references (holding and releasing interned contexts)
+bool d_predicate_registry_retain(struct d_predicate_registry* _registry, const void* _context);
+void d_predicate_registry_release(struct d_predicate_registry* _registry, const void* _context);
+
+
+#endif  // DJINTERP_C_FUNCTIONAL_PREDICATE_REGISTRY_
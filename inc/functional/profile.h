@@ -0,0 +1,118 @@
+/******************************************************************************
+* djinterp [functional]                                            profile.h
+*
+* Per-operator profiling of filter chains, pipelines, and fn_builders.
+*   When the module is compiled with D_FUNCTIONAL_PROFILE defined,
+* d_filter_apply_chain, the d_functional_pipeline_* stages, and
+* d_fn_builder_execute time every operator they run and describe it in a
+* d_profile_record: rows in and out, elapsed ticks (CPU cycles on x86, see
+* d_functional_ticks), bytes allocated for its result, and predicate
+* calls. Records go to the calling thread's innermost open d_profile
+* session and to the process-wide hook, if either exists; with neither,
+* an instrumented call costs one check. Without D_FUNCTIONAL_PROFILE the
+* instrumentation is not compiled at all, and sessions stay empty.
+*   d_filter_chain_explain_analyze (filter.h) builds an EXPLAIN ANALYZE
+* report of a chain on top of a session.
+*
+*
+* path:      \inc\functional\profile.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_C_FUNCTIONAL_PROFILE_
+#define DJINTERP_C_FUNCTIONAL_PROFILE_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "..\djinterp.h"
+#include ".\functional_common.h"
+#include ".\allocator.h"
+#include ".\functional_platform.h"
+
+
+// D_PROFILE_NO_INDEX
+//   constant: index of a record whose operator is not part of an indexed
+// chain (pipeline stages).
+#define D_PROFILE_NO_INDEX ((size_t)-1)
+
+// D_PROFILE_ROW_MAX
+//   constant: size of a buffer that holds any row written by
+// d_profile_format_row with a label of up to 64 characters.
+#define D_PROFILE_ROW_MAX 256
+
+
+// d_profile_record
+//   struct: measurements of one operator run.
+struct d_profile_record
+{
+    const char* source;           // "filter", "pipeline", or "fn_builder"
+    const char* operation;        // operator name, e.g. "where" or "map"
+    size_t      index;            // position in its chain, or NO_INDEX
+    size_t      rows_in;          // elements the operator received
+    size_t      rows_out;         // elements it produced
+    uint64_t    elapsed_ticks;    // d_functional_ticks spent in it
+    size_t      bytes_allocated;  // bytes allocated for its result
+    size_t      predicate_calls;  // calls made to its predicate
+};
+
+// fn_profile_hook
+//   function pointer: receives every record, on the thread that produced
+// it, e.g. to forward it to a metrics system.
+typedef void (*fn_profile_hook)(const struct d_profile_record* _record,
+                                void*                          _context);
+
+// d_profile
+//   struct: a profiling session collecting the records of its thread into
+// caller-provided storage. Sessions nest; records go to the innermost.
+struct d_profile
+{
+    struct d_profile_record* records;   // storage for the records
+    size_t                   capacity;  // records that fit
+    size_t                   count;     // records collected
+    size_t                   dropped;   // records that did not fit
+    struct d_profile*        outer;     // session this one interrupted
+};
+
+
+// D_PROFILE_START, D_PROFILE_STOP
+//   macro: instrumentation of an operator. START reads the clock into a
+// uint64_t declared under D_FUNCTIONAL_PROFILE (0 when nothing is
+// listening); STOP reports the operator if START was not 0. Both compile
+// to nothing without D_FUNCTIONAL_PROFILE.
+#if defined(D_FUNCTIONAL_PROFILE)
+    #define D_PROFILE_START(START)                                      \
+        ((START) = d_profile_start())
+    #define D_PROFILE_STOP(START, SOURCE, OPERATION, INDEX,             \
+                           ROWS_IN, ROWS_OUT, BYTES, CALLS)             \
+        d_profile_stop((START), (SOURCE), (OPERATION), (INDEX),         \
+                       (ROWS_IN), (ROWS_OUT), (BYTES), (CALLS))
+#else
+    #define D_PROFILE_START(START)                                      \
+        ((void)0)
+    #define D_PROFILE_STOP(START, SOURCE, OPERATION, INDEX,             \
+                           ROWS_IN, ROWS_OUT, BYTES, CALLS)             \
+        ((void)0)
+#endif
+
+
+// i.    sessions
+void d_profile_begin(struct d_profile* _profile, struct d_profile_record* _records, size_t _capacity);
+void d_profile_end(struct d_profile* _profile);
+
+// ii.   hook
+void d_profile_set_hook(fn_profile_hook _hook, void* _context);
+
+// iii.  recording (used by instrumented operators)
+uint64_t d_profile_start(void);
+void     d_profile_stop(uint64_t _start, const char* _source, const char* _operation, size_t _index, size_t _rows_in, size_t _rows_out, size_t _bytes_allocated, size_t _predicate_calls);
+void     d_profile_emit(const struct d_profile_record* _record);
+
+// iv.   reporting
+int   d_profile_format_row(char* _buffer, size_t _capacity, const char* _label, const struct d_profile_record* _record);
+char* d_profile_to_string(const struct d_profile* _profile);
+
+
+#endif  // DJINTERP_C_FUNCTIONAL_PROFILE_
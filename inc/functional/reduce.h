@@ -0,0 +1,81 @@
+/******************************************************************************
+* djinterp [functional]                                             reduce.h
+*
+* Parallel and tree-shaped reductions.
+*   d_functional_fold_parallel splits its input into contiguous chunks, folds
+* each chunk into its own partial state (started from a caller-supplied
+* identity) on a worker thread, and then combines the partial states with an
+* fn_combiner in a balanced pairwise tree. The D_DEFINE_ACC_* generators in
+* functional.h emit a matching NAME##_merge combiner for every accumulator.
+*   d_functional_reduce_tree reduces with an fn_reducer in a balanced tree
+* rather than a left-leaning chain, which keeps floating-point rounding error
+* at O(log n) and exposes independent work to the CPU. It preserves element
+* order, so the reducer only needs to be associative, not commutative.
+*   d_functional_fold_multi feeds every element to several accumulators in a
+* single pass, so computing e.g. sum, min, max, and count of one array reads
+* it from memory once instead of once per aggregate.
+*   Inputs shorter than D_FUNCTIONAL_PARALLEL_MIN_CHUNK elements per thread
+* are processed on the calling thread without spawning workers.
+*
+*
+* path:      \inc\functional\reduce.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_C_FUNCTIONAL_REDUCE_
+#define DJINTERP_C_FUNCTIONAL_REDUCE_ 1
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "..\djinterp.h"
+#include ".\functional_common.h"
+#include ".\allocator.h"
+#include ".\functional_platform.h"
+
+
+// D_FUNCTIONAL_PARALLEL_MIN_CHUNK
+//   constant: minimum number of elements handed to one thread; smaller
+// inputs use fewer threads.
+#ifndef D_FUNCTIONAL_PARALLEL_MIN_CHUNK
+    #define D_FUNCTIONAL_PARALLEL_MIN_CHUNK 4096
+#endif
+
+// D_FUNCTIONAL_FOLD_MULTI_BLOCK_BYTES
+//   constant: size of the input blocks d_functional_fold_multi hands to each
+// accumulator in turn; chosen so that a block stays in the L1 cache while
+// all accumulators consume it.
+#ifndef D_FUNCTIONAL_FOLD_MULTI_BLOCK_BYTES
+    #define D_FUNCTIONAL_FOLD_MULTI_BLOCK_BYTES 4096
+#endif
+
+// D_FUNCTIONAL_MAX_THREADS
+//   constant: upper bound on the number of threads used by one reduction.
+#ifndef D_FUNCTIONAL_MAX_THREADS
+    #define D_FUNCTIONAL_MAX_THREADS 64
+#endif
+
+
+// d_fold_spec
+//   struct: one aggregate of a multi-accumulator fold: the accumulator
+// function, the state it folds into, and its context.
+struct d_fold_spec
+{
+    void*          accumulator;  // state; initial value and result
+    fn_accumulator step;         // folds one element into accumulator
+    void*          context;      // forwarded to step; may be NULL
+};
+
+
+// i.    parallel fold
+bool d_functional_fold_parallel(const void* _input, size_t _count, size_t _element_size, void* _accumulator, size_t _state_size, const void* _identity, fn_accumulator _step, fn_combiner _merge, void* _context, size_t _threads);
+
+// ii.   tree reduction
+bool d_functional_reduce_tree(const void* _input, size_t _count, size_t _element_size, void* _result, fn_reducer _reducer, void* _context, size_t _threads);
+
+// iii.  multi-accumulator fold
+bool d_functional_fold_multi(const void* _input, size_t _count, size_t _element_size, const struct d_fold_spec* _specs, size_t _spec_count);
+
+
+#endif  // DJINTERP_C_FUNCTIONAL_REDUCE_
@@ -0,0 +1,48 @@
+/******************************************************************************
+* djinterp [functional]                                               scan.h
+*
+* Linear searches with early exit.
+*   d_functional_index_of, d_functional_find_last, and
+* d_functional_last_index_of call their predicate with a NULL context. The
+* _context variants here forward a context, so parameterized predicates
+* (thresholds, keys, compiled predicate programs) can be searched for.
+* Reverse searches step a pointer backwards rather than recomputing each
+* element's address, and stop at the first match from the end.
+*   When the predicate is d_predicate_program_test, the program is evaluated
+* 64 elements at a time with d_predicate_program_eval_array and the match is
+* read off the resulting bitmask.
+*   d_functional_index_of_value and d_functional_last_index_of_value search
+* for an element bytewise equal to a given value. For 1-, 2-, 4-, and 8-byte
+* elements they compare a 64-byte chunk per iteration with SSE2 on x86
+* (typed scalar loops elsewhere, or with D_FUNCTIONAL_NO_SIMD defined), in
+* the manner of memchr. Bytewise equality means that for floating-point
+* elements -0.0 does not match 0.0, and a NaN matches only the same NaN.
+*
+*
+* path:      \inc\functional\scan.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_C_FUNCTIONAL_SCAN_
+#define DJINTERP_C_FUNCTIONAL_SCAN_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "..\djinterp.h"
+#include ".\functional_common.h"
+#include ".\predicate.h"
+
+
+// i.    predicate searches
+size_t d_functional_index_of_context(const void* _input, size_t _count, size_t _element_size, fn_predicate _test, void* _context);
+void*  d_functional_find_last_context(const void* _input, size_t _count, size_t _element_size, fn_predicate _test, void* _context);
+size_t d_functional_last_index_of_context(const void* _input, size_t _count, size_t _element_size, fn_predicate _test, void* _context);
+
+// ii.   value searches
+size_t d_functional_index_of_value(const void* _input, size_t _count, size_t _element_size, const void* _value);
+size_t d_functional_last_index_of_value(const void* _input, size_t _count, size_t _element_size, const void* _value);
+
+
+#endif  // DJINTERP_C_FUNCTIONAL_SCAN_
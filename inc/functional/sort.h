@@ -0,0 +1,74 @@
+/******************************************************************************
+* djinterp [functional]                                               sort.h
+*
+* Sorting and selection with context-carrying comparators.
+*   qsort cannot pass a context to its comparator, so callers with
+* parameterized orderings had to smuggle state through globals. The
+* functions here take an fn_function_comparator together with the context it
+* is called with.
+*   d_functional_sort is an introsort: median-of-three quicksort that
+* switches to heapsort when the recursion gets too deep (O(n log n) worst
+* case) and finishes short ranges with insertion sort. It is not stable.
+* When the comparator is one of d_functional_compare_int,
+* d_functional_compare_size_t, or d_functional_compare_double and the
+* element size matches, large arrays are sorted with an LSD radix sort
+* instead; for doubles, -0.0 sorts before 0.0 and NaNs sort to the ends.
+*   d_functional_partial_sort and d_functional_nth_element order only part
+* of an array; d_functional_top_k copies the K greatest elements of an
+* array into an output buffer using a bounded heap, in O(n log k) time
+* without modifying the input.
+*   The binary searches take the same comparator and context as the sort
+* that ordered the array. lower_bound / upper_bound / equal_range search
+* for a value; partition_point finds the end of the leading run of elements
+* satisfying a predicate that is true on a prefix of the array and false
+* after it (such as "x < 10" over ascending data). The built-in int, size_t,
+* and double comparators are searched with typed loops.
+*
+*
+* path:      \inc\functional\sort.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_C_FUNCTIONAL_SORT_
+#define DJINTERP_C_FUNCTIONAL_SORT_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "..\djinterp.h"
+#include ".\functional_common.h"
+#include ".\allocator.h"
+
+
+// D_SORT_INSERTION_THRESHOLD
+//   constant: range length at or below which introsort switches to
+// insertion sort.
+#ifndef D_SORT_INSERTION_THRESHOLD
+    #define D_SORT_INSERTION_THRESHOLD 16
+#endif
+
+// D_SORT_RADIX_THRESHOLD
+//   constant: minimum element count for the radix-sort fast path.
+#ifndef D_SORT_RADIX_THRESHOLD
+    #define D_SORT_RADIX_THRESHOLD 256
+#endif
+
+
+// i.    sorting
+bool   d_functional_sort(void* _input, size_t _count, size_t _element_size, fn_function_comparator _comparator, void* _context);
+bool   d_functional_partial_sort(void* _input, size_t _count, size_t _element_size, size_t _k, fn_function_comparator _comparator, void* _context);
+
+// ii.   selection
+bool   d_functional_nth_element(void* _input, size_t _count, size_t _element_size, size_t _n, fn_function_comparator _comparator, void* _context);
+size_t d_functional_top_k(const void* _input, size_t _count, size_t _element_size, size_t _k, void* _output, fn_function_comparator _comparator, void* _context);
+
+// iii.  binary search
+size_t d_functional_lower_bound(const void* _input, size_t _count, size_t _element_size, const void* _value, fn_function_comparator _comparator, void* _context);
+size_t d_functional_upper_bound(const void* _input, size_t _count, size_t _element_size, const void* _value, fn_function_comparator _comparator, void* _context);
+bool   d_functional_equal_range(const void* _input, size_t _count, size_t _element_size, const void* _value, fn_function_comparator _comparator, void* _context, size_t* _first, size_t* _last);
+size_t d_functional_partition_point(const void* _input, size_t _count, size_t _element_size, fn_predicate _test, void* _context);
+
+
+#endif  // DJINTERP_C_FUNCTIONAL_SORT_
@@ -0,0 +1,350 @@
+/******************************************************************************
+* djinterp [functional]                                         specialize.h
+*
+* Typed specializations of the core higher-order functions.
+*   The generic API passes elements as const void* with a run-time
+* _element_size and calls every callback through a function pointer, so the
+* compiler can neither fold the stride into the addressing nor inline the
+* callback. D_FUNCTIONAL_SPECIALIZE(prefix, type) emits static inline copies
+* of map, filter, fold, count_if, any / all / none, find_if, and a fused
+* filter-map-fold, operating on TYPE arrays with a constant stride.
+*   The emitted functions take the module's ordinary fn_predicate,
+* fn_transformer, and fn_accumulator callbacks, and behave like their
+* d_functional_* counterparts (including parameter validation). When such a
+* function is called with a callback whose definition is visible - one
+* written in the same file, or generated with the D_GEN_FUNCTIONAL_* /
+* D_DEFINE_ACC_* macros - an optimizing compiler inlines the specialized
+* function at the call site and the callback into its loop.
+*   For example,
+*
+*     D_GEN_FUNCTIONAL_PREDICATE_POSITIVE(is_positive, int)
+*     D_GEN_FUNCTIONAL_DEFINE_XFORM_SQUARE(square_int, int)
+*     D_DEFINE_ACC_SUM(sum_int, int)
+*     D_FUNCTIONAL_SPECIALIZE(int_array, int)
+*
+*     total = 0;
+*     int_array_filter_map_fold(values, count,
+*                               is_positive, NULL,
+*                               square_int, NULL,
+*                               &total, sum_int, NULL);
+*
+* sums the squares of the positive values in one pass, without indirect
+* calls. The per-function generators (D_FUNCTIONAL_SPECIALIZE_MAP, ...) emit
+* a subset.
+*
+*
+* path:      \inc\functional\specialize.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_C_FUNCTIONAL_SPECIALIZE_
+#define DJINTERP_C_FUNCTIONAL_SPECIALIZE_ 1
+
+#include <stddef.h>
+#include "..\djinterp.h"
+#include ".\functional_common.h"
+
+
+// D_FUNCTIONAL_SPECIALIZE_LINKAGE
+//   constant: storage class of the specialized functions. They are static,
+// so that several translation units may specialize the same type.
+#ifndef D_FUNCTIONAL_SPECIALIZE_LINKAGE
+    #define D_FUNCTIONAL_SPECIALIZE_LINKAGE static D_INLINE
+#endif
+
+
+// D_FUNCTIONAL_SPECIALIZE_MAP
+//   macro: emits PREFIX_map, a typed d_functional_map.
+#define D_FUNCTIONAL_SPECIALIZE_MAP(prefix,                                 \
+                                    type)                                   \
+    D_FUNCTIONAL_SPECIALIZE_LINKAGE bool                                    \
+    prefix##_map                                                            \
+    (                                                                       \
+        const type*    _input,                                              \
+        type*          _output,                                             \
+        size_t         _count,                                              \
+        fn_transformer _transform,                                          \
+        void*          _context                                             \
+    )                                                                       \
+    {                                                                       \
+        size_t i;                                                           \
+                                                                            \
+        if ( (!_input)     ||                                               \
+             (!_output)    ||                                               \
+             (!_transform) ||                                               \
+             (_count == 0) )                                                \
+        {                                                                   \
+            return false;                                                   \
+        }                                                                   \
+                                                                            \
+        for (i = 0; i < _count; i++)                                        \
+        {                                                                   \
+            if (!_transform(&_input[i], &_output[i], _context))             \
+            {                                                               \
+                return false;                                               \
+            }                                                               \
+        }                                                                   \
+                                                                            \
+        return true;                                                        \
+    }
+
+// D_FUNCTIONAL_SPECIALIZE_FILTER
+//   macro: emits PREFIX_filter, a typed d_functional_filter. Returns the
+// number of elements written to _output.
+#define D_FUNCTIONAL_SPECIALIZE_FILTER(prefix,                              \
+                                       type)                                \
+    D_FUNCTIONAL_SPECIALIZE_LINKAGE size_t                                  \
+    prefix##_filter                                                         \
+    (                                                                       \
+        const type*  _input,                                                \
+        type*        _output,                                               \
+        size_t       _count,                                                \
+        fn_predicate _test,                                                 \
+        void*        _context                                               \
+    )                                                                       \
+    {                                                                       \
+        size_t out_count;                                                   \
+        size_t i;                                                           \
+                                                                            \
+        if ( (!_input)  ||                                                  \
+             (!_output) ||                                                  \
+             (!_test) )                                                     \
+        {                                                                   \
+            return 0;                                                       \
+        }                                                                   \
+                                                                            \
+        out_count = 0;                                                      \
+                                                                            \
+        for (i = 0; i < _count; i++)                                        \
+        {                                                                   \
+            if (_test(&_input[i], _context))                                \
+            {                                                               \
+                _output[out_count++] = _input[i];                           \
+            }                                                               \
+        }                                                                   \
+                                                                            \
+        return out_count;                                                   \
+    }
+
+// D_FUNCTIONAL_SPECIALIZE_FOLD
+//   macro: emits PREFIX_fold, a typed d_functional_fold_left. The
+// accumulator may be of any type the accumulator function expects.
+#define D_FUNCTIONAL_SPECIALIZE_FOLD(prefix,                                \
+                                     type)                                  \
+    D_FUNCTIONAL_SPECIALIZE_LINKAGE bool                                    \
+    prefix##_fold                                                           \
+    (                                                                       \
+        const type*    _input,                                              \
+        size_t         _count,                                              \
+        void*          _accumulator,                                        \
+        fn_accumulator _combine,                                            \
+        void*          _context                                             \
+    )                                                                       \
+    {                                                                       \
+        size_t i;                                                           \
+                                                                            \
+        if ( (!_input)       ||                                             \
+             (!_accumulator) ||                                             \
+             (!_combine)     ||                                             \
+             (_count == 0) )                                                \
+        {                                                                   \
+            return false;                                                   \
+        }                                                                   \
+                                                                            \
+        for (i = 0; i < _count; i++)                                        \
+        {                                                                   \
+            if (!_combine(_accumulator, &_input[i], _context))              \
+            {                                                               \
+                return false;                                               \
+            }                                                               \
+        }                                                                   \
+                                                                            \
+        return true;                                                        \
+    }
+
+// D_FUNCTIONAL_SPECIALIZE_QUERY
+//   macro: emits PREFIX_count_if, PREFIX_any, PREFIX_all, PREFIX_none, and
+// PREFIX_find_if, typed versions of the d_functional_* quantifiers. The
+// quantifiers short-circuit.
+#define D_FUNCTIONAL_SPECIALIZE_QUERY(prefix,                               \
+                                      type)                                 \
+    D_FUNCTIONAL_SPECIALIZE_LINKAGE size_t                                  \
+    prefix##_count_if                                                       \
+    (                                                                       \
+        const type*  _input,                                                \
+        size_t       _count,                                                \
+        fn_predicate _test,                                                 \
+        void*        _context                                               \
+    )                                                                       \
+    {                                                                       \
+        size_t matches;                                                     \
+        size_t i;                                                           \
+                                                                            \
+        if ( (!_input) ||                                                   \
+             (!_test) )                                                     \
+        {                                                                   \
+            return 0;                                                       \
+        }                                                                   \
+                                                                            \
+        matches = 0;                                                        \
+                                                                            \
+        for (i = 0; i < _count; i++)                                        \
+        {                                                                   \
+            matches += (_test(&_input[i], _context)) ? 1 : 0;               \
+        }                                                                   \
+                                                                            \
+        return matches;                                                     \
+    }                                                                       \
+                                                                            \
+    D_FUNCTIONAL_SPECIALIZE_LINKAGE type*                                   \
+    prefix##_find_if                                                        \
+    (                                                                       \
+        const type*  _input,                                                \
+        size_t       _count,                                                \
+        fn_predicate _test,                                                 \
+        void*        _context                                               \
+    )                                                                       \
+    {                                                                       \
+        size_t i;                                                           \
+                                                                            \
+        if ( (!_input) ||                                                   \
+             (!_test) )                                                     \
+        {                                                                   \
+            return NULL;                                                    \
+        }                                                                   \
+                                                                            \
+        for (i = 0; i < _count; i++)                                        \
+        {                                                                   \
+            if (_test(&_input[i], _context))                                \
+            {                                                               \
+                return (type*)&_input[i];                                   \
+            }                                                               \
+        }                                                                   \
+                                                                            \
+        return NULL;                                                        \
+    }                                                                       \
+                                                                            \
+    D_FUNCTIONAL_SPECIALIZE_LINKAGE bool                                    \
+    prefix##_any                                                            \
+    (                                                                       \
+        const type*  _input,                                                \
+        size_t       _count,                                                \
+        fn_predicate _test,                                                 \
+        void*        _context                                               \
+    )                                                                       \
+    {                                                                       \
+        return (prefix##_find_if(_input, _count, _test, _context) != NULL); \
+    }                                                                       \
+                                                                            \
+    D_FUNCTIONAL_SPECIALIZE_LINKAGE bool                                    \
+    prefix##_all                                                            \
+    (                                                                       \
+        const type*  _input,                                                \
+        size_t       _count,                                                \
+        fn_predicate _test,                                                 \
+        void*        _context                                               \
+    )                                                                       \
+    {                                                                       \
+        size_t i;                                                           \
+                                                                            \
+        if ( (!_input)     ||                                               \
+             (!_test)      ||                                               \
+             (_count == 0) )                                                \
+        {                                                                   \
+            return false;                                                   \
+        }                                                                   \
+                                                                            \
+        for (i = 0; i < _count; i++)                                        \
+        {                                                                   \
+            if (!_test(&_input[i], _context))                               \
+            {                                                               \
+                return false;                                               \
+            }                                                               \
+        }                                                                   \
+                                                                            \
+        return true;                                                        \
+    }                                                                       \
+                                                                            \
+    D_FUNCTIONAL_SPECIALIZE_LINKAGE bool                                    \
+    prefix##_none                                                           \
+    (                                                                       \
+        const type*  _input,                                                \
+        size_t       _count,                                                \
+        fn_predicate _test,                                                 \
+        void*        _context                                               \
+    )                                                                       \
+    {                                                                       \
+        if ( (!_input)     ||                                               \
+             (!_test)      ||                                               \
+             (_count == 0) )                                                \
+        {                                                                   \
+            return false;                                                   \
+        }                                                                   \
+                                                                            \
+        return (prefix##_find_if(_input, _count, _test, _context) == NULL); \
+    }
+
+// D_FUNCTIONAL_SPECIALIZE_FUSED
+//   macro: emits PREFIX_filter_map_fold, a single pass that folds the
+// transformed value of every element passing a test, without materializing
+// the intermediate arrays of the equivalent pipeline. Each stage has its
+// own context. Returns false on invalid parameters or if a transform or
+// accumulation fails.
+#define D_FUNCTIONAL_SPECIALIZE_FUSED(prefix,                               \
+                                      type)                                 \
+    D_FUNCTIONAL_SPECIALIZE_LINKAGE bool                                    \
+    prefix##_filter_map_fold                                                \
+    (                                                                       \
+        const type*    _input,                                              \
+        size_t         _count,                                              \
+        fn_predicate   _test,                                               \
+        void*          _test_context,                                       \
+        fn_transformer _transform,                                          \
+        void*          _transform_context,                                  \
+        void*          _accumulator,                                        \
+        fn_accumulator _combine,                                            \
+        void*          _combine_context                                     \
+    )                                                                       \
+    {                                                                       \
+        type   mapped;                                                      \
+        size_t i;                                                           \
+                                                                            \
+        if ( (!_input)       ||                                             \
+             (!_transform)   ||                                             \
+             (!_accumulator) ||                                             \
+             (!_combine) )                                                  \
+        {                                                                   \
+            return false;                                                   \
+        }                                                                   \
+                                                                            \
+        for (i = 0; i < _count; i++)                                        \
+        {                                                                   \
+            if ( (_test) &&                                                 \
+                 (!_test(&_input[i], _test_context)) )                      \
+            {                                                               \
+                continue;                                                   \
+            }                                                               \
+                                                                            \
+            if ( (!_transform(&_input[i], &mapped, _transform_context)) ||  \
+                 (!_combine(_accumulator, &mapped, _combine_context)) )     \
+            {                                                               \
+                return false;                                               \
+            }                                                               \
+        }                                                                   \
+                                                                            \
+        return true;                                                        \
+    }
+
+// D_FUNCTIONAL_SPECIALIZE
+//   macro: emits the complete typed family for TYPE under PREFIX.
+#define D_FUNCTIONAL_SPECIALIZE(prefix,                                     \
+                                type)                                       \
+    D_FUNCTIONAL_SPECIALIZE_MAP(prefix, type)                               \
+    D_FUNCTIONAL_SPECIALIZE_FILTER(prefix, type)                            \
+    D_FUNCTIONAL_SPECIALIZE_FOLD(prefix, type)                              \
+    D_FUNCTIONAL_SPECIALIZE_QUERY(prefix, type)                             \
+    D_FUNCTIONAL_SPECIALIZE_FUSED(prefix, type)
+
+
+#endif  // DJINTERP_C_FUNCTIONAL_SPECIALIZE_
@@ -0,0 +1,134 @@
+/******************************************************************************
+* djinterp [functional]                                             stream.h
+*
+* Chunked, pull-based input for pipelines.
+*   d_functional_pipeline_begin needs the whole input as one array. A
+* d_functional_source instead hands out the input one chunk at a time
+* through its next_chunk callback, so input read from a file or socket can
+* be processed in memory proportional to the chunk size rather than the
+* input size.
+*   A d_functional_stream is a pipeline over a source. Stages (map, filter,
+* for_each, take, skip) are added up front and run on each chunk as it is
+* pulled. Take and skip keep their counters across chunk boundaries, and a
+* satisfied take stops pulling from the source. The result is consumed a
+* chunk at a time with d_functional_stream_next (a stream is itself a
+* source, see d_functional_stream_source), or by one of the terminal
+* operations: fold and fold_multi carry their accumulators across chunks,
+* and collect gathers the output into one array.
+*   d_filter_stream (filter.h) runs a filter chain over a source in the same
+* way.
+*
+*
+* path:      \inc\functional\stream.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_C_FUNCTIONAL_STREAM_
+#define DJINTERP_C_FUNCTIONAL_STREAM_ 1
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "..\djinterp.h"
+#include ".\functional_common.h"
+#include ".\allocator.h"
+#include ".\reduce.h"
+
+
+// fn_source_next
+//   function pointer: pulls the next chunk from a source, setting *_chunk
+// and *_count. A count of 0 marks the end of the input. The chunk must stay
+// valid until the next call. Returns false on a read error.
+// Note: `_context` may be NULL.
+typedef bool (*fn_source_next)(void*        _context,
+                               const void** _chunk,
+                               size_t*      _count);
+
+// d_functional_source
+//   struct: a chunked input of elements of element_size bytes.
+struct d_functional_source
+{
+    fn_source_next next_chunk;    // pulls the next chunk
+    void*          context;       // forwarded to next_chunk
+    size_t         element_size;  // size of each element in bytes
+};
+
+// d_functional_array_source
+//   struct: state of a source reading an in-memory array in fixed-size
+// chunks; see d_functional_source_array.
+struct d_functional_array_source
+{
+    const unsigned char* data;
+    size_t               count;         // elements in data
+    size_t               position;      // next element to hand out
+    size_t               chunk_count;   // elements per chunk
+    size_t               element_size;
+};
+
+// d_stream_stage_kind
+//   enum: kind of a stream stage.
+enum d_stream_stage_kind
+{
+    D_STREAM_STAGE_MAP = 0,
+    D_STREAM_STAGE_FILTER,
+    D_STREAM_STAGE_FOR_EACH,
+    D_STREAM_STAGE_TAKE,
+    D_STREAM_STAGE_SKIP
+};
+
+// d_stream_stage
+//   struct: one stage of a stream; remaining is the take / skip counter
+// carried across chunks.
+struct d_stream_stage
+{
+    enum d_stream_stage_kind kind;
+    fn_transformer           transform;  // map
+    fn_predicate             test;       // filter
+    fn_consumer              apply;      // for_each
+    void*                    context;
+    size_t                   remaining;  // take / skip
+};
+
+// d_functional_stream
+//   struct: a pipeline over a source. If an error occurs, subsequent
+// operations are no-ops and error_code is non-zero.
+struct d_functional_stream
+{
+    struct d_functional_source source;
+    struct d_stream_stage*     stages;
+    size_t                     stage_count;
+    size_t                     stage_capacity;
+    unsigned char*             buffers[2];       // chunk working space
+    size_t                     buffer_capacity;  // elements per buffer
+    bool                       finished;         // no more chunks to pull
+    int                        error_code;       // 0 = success
+};
+
+
+// i.    sources
+struct d_functional_source  d_functional_source_array(struct d_functional_array_source* _state, const void* _data, size_t _count, size_t _element_size, size_t _chunk_count);
+bool                        d_functional_source_next(struct d_functional_source* _source, const void** _chunk, size_t* _count);
+
+// ii.   stream creation
+struct d_functional_stream* d_functional_stream_new(struct d_functional_source _source);
+
+// iii.  stream stages (chainable)
+struct d_functional_stream* d_functional_stream_map(struct d_functional_stream* _stream, fn_transformer _transform, void* _context);
+struct d_functional_stream* d_functional_stream_filter(struct d_functional_stream* _stream, fn_predicate _test, void* _context);
+struct d_functional_stream* d_functional_stream_for_each(struct d_functional_stream* _stream, fn_consumer _apply, void* _context);
+struct d_functional_stream* d_functional_stream_take(struct d_functional_stream* _stream, size_t _n);
+struct d_functional_stream* d_functional_stream_skip(struct d_functional_stream* _stream, size_t _n);
+
+// iv.   consumption
+bool                        d_functional_stream_next(struct d_functional_stream* _stream, const void** _chunk, size_t* _count);
+struct d_functional_source  d_functional_stream_source(struct d_functional_stream* _stream);
+bool                        d_functional_stream_fold(struct d_functional_stream* _stream, void* _accumulator, fn_accumulator _combine, void* _context);
+bool                        d_functional_stream_fold_multi(struct d_functional_stream* _stream, const struct d_fold_spec* _specs, size_t _spec_count);
+void*                       d_functional_stream_collect(struct d_functional_stream* _stream, size_t* _out_count);
+
+// v.    cleanup
+void                        d_functional_stream_free(struct d_functional_stream* _stream);
+
+
+#endif  // DJINTERP_C_FUNCTIONAL_STREAM_
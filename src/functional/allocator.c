@@ -0,0 +1,767 @@
+#include "..\..\inc\functional\allocator.h"
+
+
+// d_functional_alloc_header
+//   struct: what precedes every block the module hands out; allocator is
+// NULL for a block of the C library.
+struct d_functional_alloc_header
+{
+    struct d_functional_allocator* allocator;
+    size_t                         size;
+};
+
+// d_functional_allocator_global
+//   static: the allocator used by threads with none pushed, or NULL.
+static struct d_functional_allocator* d_functional_allocator_global = NULL;
+
+// d_functional_allocator_scope
+//   static: the calling thread's innermost pushed allocator, or NULL.
+static D_FUNCTIONAL_THREAD_LOCAL struct d_functional_allocator*
+    d_functional_allocator_scope = NULL;
+
+
+/*
+d_functional_allocator_system_allocate
+  Internal helper: fn_allocate over malloc.
+*/
+static void*
+d_functional_allocator_system_allocate
+(
+    size_t _size,
+    void*  _context
+)
+{
+    (void)_context;
+
+    return malloc(_size);
+}
+
+/*
+d_functional_allocator_system_reallocate
+  Internal helper: fn_reallocate over realloc.
+*/
+static void*
+d_functional_allocator_system_reallocate
+(
+    void*  _block,
+    size_t _size,
+    void*  _context
+)
+{
+    (void)_context;
+
+    return realloc(_block, _size);
+}
+
+/*
+d_functional_allocator_system_deallocate
+  Internal helper: fn_deallocate over free.
+*/
+static void
+d_functional_allocator_system_deallocate
+(
+    void* _block,
+    void* _context
+)
+{
+    (void)_context;
+
+    free(_block);
+
+    return;
+}
+
+/*
+d_functional_allocator_arena_allocate
+  Internal helper: fn_allocate over d_fn_arena_alloc.
+*/
+static void*
+d_functional_allocator_arena_allocate
+(
+    size_t _size,
+    void*  _context
+)
+{
+    return d_fn_arena_alloc((struct d_fn_arena*)_context, _size);
+}
+
+/*
+d_functional_allocator_lock
+  Internal helper: locks a shared allocator.
+*/
+static void
+d_functional_allocator_lock
+(
+    struct d_functional_allocator* _allocator
+)
+{
+    if (_allocator->shared)
+    {
+        d_functional_mutex_lock(&_allocator->mutex);
+    }
+
+    return;
+}
+
+/*
+d_functional_allocator_unlock
+  Internal helper: unlocks a shared allocator.
+*/
+static void
+d_functional_allocator_unlock
+(
+    struct d_functional_allocator* _allocator
+)
+{
+    if (_allocator->shared)
+    {
+        d_functional_mutex_unlock(&_allocator->mutex);
+    }
+
+    return;
+}
+
+/*
+d_functional_allocator_account
+  Internal helper: counts _added live bytes replacing _removed ones.
+Expects the allocator to be locked.
+*/
+static void
+d_functional_allocator_account
+(
+    struct d_functional_allocator* _allocator,
+    size_t                         _added,
+    size_t                         _removed
+)
+{
+    _allocator->stats.bytes_allocated += _added;
+    _allocator->stats.bytes_live      += _added;
+    _allocator->stats.bytes_live      -= _removed;
+
+    if (_allocator->stats.bytes_live > _allocator->stats.high_water)
+    {
+        _allocator->stats.high_water = _allocator->stats.bytes_live;
+    }
+
+    return;
+}
+
+/*
+d_functional_allocator_allocate
+  Internal helper: allocates a block with a header from an allocator.
+*/
+static void*
+d_functional_allocator_allocate
+(
+    struct d_functional_allocator* _allocator,
+    size_t                         _size
+)
+{
+    struct d_functional_alloc_header* header;
+
+    header = NULL;
+
+    d_functional_allocator_lock(_allocator);
+
+    if (_size <= (size_t)-1 - D_FUNCTIONAL_ALLOC_HEADER_SIZE)
+    {
+        header = _allocator->allocate(D_FUNCTIONAL_ALLOC_HEADER_SIZE + _size,
+                                      _allocator->context);
+    }
+
+    if (header)
+    {
+        header->allocator = _allocator;
+        header->size      = _size;
+
+        _allocator->stats.allocations++;
+        d_functional_allocator_account(_allocator, _size, 0);
+    }
+    else
+    {
+        _allocator->stats.failures++;
+    }
+
+    d_functional_allocator_unlock(_allocator);
+
+    return (header)
+        ? (char*)header + D_FUNCTIONAL_ALLOC_HEADER_SIZE
+        : NULL;
+}
+
+/*
+d_functional_allocator_header
+  Internal helper: the header of a block of an installed allocator.
+*/
+static struct d_functional_alloc_header*
+d_functional_allocator_header
+(
+    void* _block
+)
+{
+    return (struct d_functional_alloc_header*)
+        ((char*)_block - D_FUNCTIONAL_ALLOC_HEADER_SIZE);
+}
+
+/*
+d_functional_allocator_system_block
+  Internal helper: allocates a block with a header from the C library, for
+use with no allocator installed; _zero clears it.
+*/
+static void*
+d_functional_allocator_system_block
+(
+    size_t _size,
+    bool   _zero
+)
+{
+    struct d_functional_alloc_header* header;
+
+    if (_size > (size_t)-1 - D_FUNCTIONAL_ALLOC_HEADER_SIZE)
+    {
+        return NULL;
+    }
+
+    header = (_zero)
+        ? calloc(1, D_FUNCTIONAL_ALLOC_HEADER_SIZE + _size)
+        : malloc(D_FUNCTIONAL_ALLOC_HEADER_SIZE + _size);
+
+    // ensure that memory allocation was successful
+    if (!header)
+    {
+        return NULL;
+    }
+
+    header->allocator = NULL;
+    header->size      = _size;
+
+    return (char*)header + D_FUNCTIONAL_ALLOC_HEADER_SIZE;
+}
+
+
+/*
+d_functional_allocator_init
+  Initializes an allocator over the given callbacks, with zeroed counters.
+If _allocate is NULL, the C library's malloc, realloc, and free are used
+instead of all three callbacks, which gives an accounting-only allocator.
+
+Parameter(s):
+  _allocator:  the allocator to initialize.
+  _allocate:   allocates blocks, or NULL for the C library.
+  _reallocate: resizes blocks; NULL to emulate it.
+  _deallocate: releases blocks; NULL to never release them.
+  _context:    passed to the callbacks.
+  _shared:     whether several threads may use the allocator at once.
+Return:
+  A boolean value corresponding to either:
+  - true, if the allocator was initialized, or
+  - false, if _allocator was NULL or its mutex could not be initialized.
+*/
+bool
+d_functional_allocator_init
+(
+    struct d_functional_allocator* _allocator,
+    fn_allocate                    _allocate,
+    fn_reallocate                  _reallocate,
+    fn_deallocate                  _deallocate,
+    void*                          _context,
+    bool                           _shared
+)
+{
+    // validate parameters
+    if (!_allocator)
+    {
+        return false;
+    }
+
+    memset(_allocator, 0, sizeof(struct d_functional_allocator));
+
+    if (_allocate)
+    {
+        _allocator->allocate   = _allocate;
+        _allocator->reallocate = _reallocate;
+        _allocator->deallocate = _deallocate;
+        _allocator->context    = _context;
+    }
+    else
+    {
+        _allocator->allocate   = d_functional_allocator_system_allocate;
+        _allocator->reallocate = d_functional_allocator_system_reallocate;
+        _allocator->deallocate = d_functional_allocator_system_deallocate;
+        _allocator->context    = NULL;
+    }
+
+    _allocator->shared = _shared;
+
+    if (_shared)
+    {
+        return d_functional_mutex_init(&_allocator->mutex);
+    }
+
+    return true;
+}
+
+/*
+d_functional_allocator_init_arena
+  Initializes an allocator handing out memory from an arena. Releasing a
+block is a no-op; the memory is reclaimed all at once by d_fn_arena_reset
+or d_fn_arena_free, after which the allocator may be reused and its
+counters reset. The allocator is not shared.
+
+Parameter(s):
+  _allocator: the allocator to initialize.
+  _arena:     the arena; must outlive the allocator's use.
+Return:
+  A boolean value corresponding to either:
+  - true, if the allocator was initialized, or
+  - false, if either parameter was NULL.
+*/
+bool
+d_functional_allocator_init_arena
+(
+    struct d_functional_allocator* _allocator,
+    struct d_fn_arena*             _arena
+)
+{
+    // validate parameters
+    if (!_arena)
+    {
+        return false;
+    }
+
+    return d_functional_allocator_init(_allocator,
+                                       d_functional_allocator_arena_allocate,
+                                       NULL,
+                                       NULL,
+                                       _arena,
+                                       false);
+}
+
+/*
+d_functional_allocator_destroy
+  Releases the resources of an allocator (its mutex, if shared). Its
+blocks are not released.
+
+Parameter(s):
+  _allocator: the allocator; must not be installed.
+Return:
+  none.
+*/
+void
+d_functional_allocator_destroy
+(
+    struct d_functional_allocator* _allocator
+)
+{
+    // validate parameters
+    if (!_allocator)
+    {
+        return;
+    }
+
+    if (_allocator->shared)
+    {
+        d_functional_mutex_destroy(&_allocator->mutex);
+        _allocator->shared = false;
+    }
+
+    return;
+}
+
+/*
+d_functional_allocator_set_global
+  Sets the allocator used by threads that have none pushed. Set it before
+other threads use the module; it is not synchronized. An allocator used by
+several threads must be shared.
+
+Parameter(s):
+  _allocator: the allocator, or NULL for the C library.
+Return:
+  The previous global allocator, or NULL if there was none.
+*/
+struct d_functional_allocator*
+d_functional_allocator_set_global
+(
+    struct d_functional_allocator* _allocator
+)
+{
+    struct d_functional_allocator* previous;
+
+    previous                      = d_functional_allocator_global;
+    d_functional_allocator_global = _allocator;
+
+    return previous;
+}
+
+/*
+d_functional_allocator_push
+  Makes an allocator current on the calling thread until the matching
+d_functional_allocator_pop, which is how a single call is routed to an
+allocator:
+    previous = d_functional_allocator_push(&request_allocator);
+    ...
+    d_functional_allocator_pop(previous);
+
+Parameter(s):
+  _allocator: the allocator, or NULL to fall back to the global one.
+Return:
+  The thread's previously pushed allocator, to be passed to
+d_functional_allocator_pop.
+*/
+struct d_functional_allocator*
+d_functional_allocator_push
+(
+    struct d_functional_allocator* _allocator
+)
+{
+    struct d_functional_allocator* previous;
+
+    previous                     = d_functional_allocator_scope;
+    d_functional_allocator_scope = _allocator;
+
+    return previous;
+}
+
+/*
+d_functional_allocator_pop
+  Ends the calling thread's innermost d_functional_allocator_push.
+
+Parameter(s):
+  _previous: the value the matching push returned.
+Return:
+  none.
+*/
+void
+d_functional_allocator_pop
+(
+    struct d_functional_allocator* _previous
+)
+{
+    d_functional_allocator_scope = _previous;
+
+    return;
+}
+
+/*
+d_functional_allocator_current
+  Gets the allocator the calling thread's allocations go to.
+
+Parameter(s):
+  (none)
+Return:
+  The innermost pushed allocator, else the global one, else NULL for the C
+library.
+*/
+struct d_functional_allocator*
+d_functional_allocator_current
+(
+    void
+)
+{
+    return (d_functional_allocator_scope)
+        ? d_functional_allocator_scope
+        : d_functional_allocator_global;
+}
+
+/*
+d_functional_allocator_get_stats
+  Copies an allocator's counters.
+
+Parameter(s):
+  _allocator: the allocator.
+  _stats:     receives the counters.
+Return:
+  none.
+*/
+void
+d_functional_allocator_get_stats
+(
+    struct d_functional_allocator*       _allocator,
+    struct d_functional_allocator_stats* _stats
+)
+{
+    // validate parameters
+    if ( (!_allocator) ||
+         (!_stats) )
+    {
+        return;
+    }
+
+    d_functional_allocator_lock(_allocator);
+    *_stats = _allocator->stats;
+    d_functional_allocator_unlock(_allocator);
+
+    return;
+}
+
+/*
+d_functional_allocator_reset_stats
+  Zeroes an allocator's counters, e.g. after resetting its arena. The
+high-water mark restarts from zero, not from the live bytes.
+
+Parameter(s):
+  _allocator: the allocator.
+Return:
+  none.
+*/
+void
+d_functional_allocator_reset_stats
+(
+    struct d_functional_allocator* _allocator
+)
+{
+    // validate parameters
+    if (!_allocator)
+    {
+        return;
+    }
+
+    d_functional_allocator_lock(_allocator);
+    memset(&_allocator->stats, 0, sizeof(struct d_functional_allocator_stats));
+    d_functional_allocator_unlock(_allocator);
+
+    return;
+}
+
+/*
+d_functional_malloc
+  Allocates a block from the current allocator, as malloc.
+
+Parameter(s):
+  _size: size of the block in bytes.
+Return:
+  The block, or NULL if allocation failed.
+*/
+void*
+d_functional_malloc
+(
+    size_t _size
+)
+{
+    struct d_functional_allocator* allocator;
+
+    allocator = d_functional_allocator_current();
+
+    if (!allocator)
+    {
+        return d_functional_allocator_system_block(_size, false);
+    }
+
+    return d_functional_allocator_allocate(allocator, _size);
+}
+
+/*
+d_functional_calloc
+  Allocates a zeroed block from the current allocator, as calloc.
+
+Parameter(s):
+  _count: number of elements.
+  _size:  size of each element in bytes.
+Return:
+  The block, or NULL if allocation failed or the size overflows.
+*/
+void*
+d_functional_calloc
+(
+    size_t _count,
+    size_t _size
+)
+{
+    struct d_functional_allocator* allocator;
+    void*                          block;
+
+    if ( (_size != 0) &&
+         (_count > (size_t)-1 / _size) )
+    {
+        return NULL;
+    }
+
+    allocator = d_functional_allocator_current();
+
+    if (!allocator)
+    {
+        return d_functional_allocator_system_block(_count * _size, true);
+    }
+
+    block = d_functional_allocator_allocate(allocator, _count * _size);
+
+    if (block)
+    {
+        memset(block, 0, _count * _size);
+    }
+
+    return block;
+}
+
+/*
+d_functional_realloc
+  Resizes a block, as realloc. The block stays with the allocator (or the
+C library) it came from, whichever is current now; a NULL block is
+allocated from the current one. Without a reallocate callback the block is
+moved into a new one.
+
+Parameter(s):
+  _block: the block, or NULL to allocate a new one.
+  _size:  the new size in bytes.
+Return:
+  The resized block, or NULL if allocation failed, in which case _block is
+left intact.
+*/
+void*
+d_functional_realloc
+(
+    void*  _block,
+    size_t _size
+)
+{
+    struct d_functional_allocator*    allocator;
+    struct d_functional_alloc_header* header;
+    struct d_functional_alloc_header* resized;
+    void*                             moved;
+    size_t                            old_size;
+
+    if (!_block)
+    {
+        return d_functional_malloc(_size);
+    }
+
+    header    = d_functional_allocator_header(_block);
+    allocator = header->allocator;
+    old_size  = header->size;
+
+    // a block of the C library
+    if (!allocator)
+    {
+        resized = NULL;
+
+        if (_size <= (size_t)-1 - D_FUNCTIONAL_ALLOC_HEADER_SIZE)
+        {
+            resized = realloc(header, D_FUNCTIONAL_ALLOC_HEADER_SIZE + _size);
+        }
+
+        if (!resized)
+        {
+            return NULL;
+        }
+
+        resized->size = _size;
+
+        return (char*)resized + D_FUNCTIONAL_ALLOC_HEADER_SIZE;
+    }
+
+    if (!allocator->reallocate)
+    {
+        moved = d_functional_allocator_allocate(allocator, _size);
+
+        if (moved)
+        {
+            memcpy(moved, _block, (old_size < _size) ? old_size : _size);
+            d_functional_allocator_release(allocator, _block);
+        }
+
+        return moved;
+    }
+
+    resized = NULL;
+
+    d_functional_allocator_lock(allocator);
+
+    if (_size <= (size_t)-1 - D_FUNCTIONAL_ALLOC_HEADER_SIZE)
+    {
+        resized = allocator->reallocate(header,
+                                        D_FUNCTIONAL_ALLOC_HEADER_SIZE + _size,
+                                        allocator->context);
+    }
+
+    if (resized)
+    {
+        resized->size = _size;
+
+        allocator->stats.reallocations++;
+        d_functional_allocator_account(allocator, _size, old_size);
+    }
+    else
+    {
+        allocator->stats.failures++;
+    }
+
+    d_functional_allocator_unlock(allocator);
+
+    return (resized)
+        ? (char*)resized + D_FUNCTIONAL_ALLOC_HEADER_SIZE
+        : NULL;
+}
+
+/*
+d_functional_free
+  Releases a block to the allocator (or the C library) it came from,
+whichever is current now, as free.
+
+Parameter(s):
+  _block: the block, or NULL.
+Return:
+  none.
+*/
+void
+d_functional_free
+(
+    void* _block
+)
+{
+    d_functional_allocator_release(NULL, _block);
+
+    return;
+}
+
+/*
+d_functional_allocator_release
+  Releases a block to the allocator named in its header, as
+d_functional_free; _allocator is only kept for compatibility, since every
+block records where it came from.
+
+Parameter(s):
+  _allocator: ignored; may be NULL.
+  _block:     the block, or NULL.
+Return:
+  none.
+*/
+void
+d_functional_allocator_release
+(
+    struct d_functional_allocator* _allocator,
+    void*                          _block
+)
+{
+    struct d_functional_alloc_header* header;
+
+    // validate parameters
+    if (!_block)
+    {
+        return;
+    }
+
+    // release to the allocator named in the header
+    header     = d_functional_allocator_header(_block);
+    _allocator = header->allocator;
+
+    if (!_allocator)
+    {
+        free(header);
+
+        return;
+    }
+
+    d_functional_allocator_lock(_allocator);
+
+    _allocator->stats.frees++;
+    _allocator->stats.bytes_live -= header->size;
+
+    if (_allocator->deallocate)
+    {
+        _allocator->deallocate(header, _allocator->context);
+    }
+
+    d_functional_allocator_unlock(_allocator);
+
+    return;
+}
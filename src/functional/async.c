@@ -0,0 +1,1373 @@
+#include "..\..\inc\functional\async.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             I.    QUEUES                                                ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_async_chunk_free
+  Internal helper freeing a chunk and its data; NULL is ignored.
+*/
+static void
+d_async_chunk_free
+(
+    struct d_async_chunk* _chunk
+)
+{
+    if (_chunk)
+    {
+        d_functional_free(_chunk->data);
+        d_functional_free(_chunk);
+    }
+
+    return;
+}
+
+/*
+d_async_queue_init
+  Internal helper preparing an empty queue of _capacity slots fed by
+_producers producers.
+*/
+static bool
+d_async_queue_init
+(
+    struct d_async_queue* _queue,
+    size_t                _capacity,
+    size_t                _producers
+)
+{
+    memset(_queue, 0, sizeof(*_queue));
+
+    _queue->slots = d_functional_malloc(_capacity *
+                                        sizeof(struct d_async_chunk*));
+
+    // ensure that memory allocation was successful
+    if (!_queue->slots)
+    {
+        return false;
+    }
+
+    if (!d_functional_mutex_init(&_queue->mutex))
+    {
+        d_functional_free(_queue->slots);
+        _queue->slots = NULL;
+
+        return false;
+    }
+
+    if (!d_functional_cond_init(&_queue->not_empty))
+    {
+        d_functional_mutex_destroy(&_queue->mutex);
+        d_functional_free(_queue->slots);
+        _queue->slots = NULL;
+
+        return false;
+    }
+
+    if (!d_functional_cond_init(&_queue->not_full))
+    {
+        d_functional_cond_destroy(&_queue->not_empty);
+        d_functional_mutex_destroy(&_queue->mutex);
+        d_functional_free(_queue->slots);
+        _queue->slots = NULL;
+
+        return false;
+    }
+
+    _queue->capacity  = _capacity;
+    _queue->producers = _producers;
+
+    return true;
+}
+
+/*
+d_async_queue_destroy
+  Internal helper freeing the chunks left in a queue and its resources. A
+queue whose initialization failed has no slots and is skipped.
+*/
+static void
+d_async_queue_destroy
+(
+    struct d_async_queue* _queue
+)
+{
+    if (!_queue->slots)
+    {
+        return;
+    }
+
+    while (_queue->count > 0)
+    {
+        d_async_chunk_free(_queue->slots[_queue->head]);
+
+        _queue->head = (_queue->head + 1) % _queue->capacity;
+        _queue->count--;
+    }
+
+    d_functional_cond_destroy(&_queue->not_full);
+    d_functional_cond_destroy(&_queue->not_empty);
+    d_functional_mutex_destroy(&_queue->mutex);
+    d_functional_free(_queue->slots);
+    _queue->slots = NULL;
+
+    return;
+}
+
+/*
+d_async_queue_push
+  Internal helper appending a chunk to a queue, blocking while the queue
+is full. Returns false, without taking the chunk, if the queue was
+aborted.
+*/
+static bool
+d_async_queue_push
+(
+    struct d_async_queue* _queue,
+    struct d_async_chunk* _chunk
+)
+{
+    d_functional_mutex_lock(&_queue->mutex);
+
+    // backpressure: wait for the consumers to make room
+    while ( (_queue->count == _queue->capacity) &&
+            (!_queue->aborted) )
+    {
+        d_functional_cond_wait(&_queue->not_full, &_queue->mutex);
+    }
+
+    if (_queue->aborted)
+    {
+        d_functional_mutex_unlock(&_queue->mutex);
+
+        return false;
+    }
+
+    _queue->slots[(_queue->head + _queue->count) % _queue->capacity] =
+        _chunk;
+    _queue->count++;
+
+    d_functional_cond_signal(&_queue->not_empty);
+    d_functional_mutex_unlock(&_queue->mutex);
+
+    return true;
+}
+
+/*
+d_async_queue_pop
+  Internal helper taking the oldest chunk from a queue, blocking while the
+queue is empty and still has open producers. Returns NULL once the queue
+is closed and drained, or aborted.
+*/
+static struct d_async_chunk*
+d_async_queue_pop
+(
+    struct d_async_queue* _queue
+)
+{
+    struct d_async_chunk* chunk;
+
+    d_functional_mutex_lock(&_queue->mutex);
+
+    while ( (_queue->count == 0)     &&
+            (_queue->producers > 0)  &&
+            (!_queue->aborted) )
+    {
+        d_functional_cond_wait(&_queue->not_empty, &_queue->mutex);
+    }
+
+    if ( (_queue->aborted) ||
+         (_queue->count == 0) )
+    {
+        d_functional_mutex_unlock(&_queue->mutex);
+
+        return NULL;
+    }
+
+    chunk         = _queue->slots[_queue->head];
+    _queue->head  = (_queue->head + 1) % _queue->capacity;
+    _queue->count--;
+
+    d_functional_cond_signal(&_queue->not_full);
+    d_functional_mutex_unlock(&_queue->mutex);
+
+    return chunk;
+}
+
+/*
+d_async_queue_close
+  Internal helper recording that one producer of a queue is done; the last
+one wakes every consumer so that they can drain the queue and stop.
+*/
+static void
+d_async_queue_close
+(
+    struct d_async_queue* _queue
+)
+{
+    d_functional_mutex_lock(&_queue->mutex);
+
+    if (_queue->producers > 0)
+    {
+        _queue->producers--;
+    }
+
+    if (_queue->producers == 0)
+    {
+        d_functional_cond_broadcast(&_queue->not_empty);
+    }
+
+    d_functional_mutex_unlock(&_queue->mutex);
+
+    return;
+}
+
+/*
+d_async_queue_abort
+  Internal helper waking every thread blocked on a queue and making every
+later push and pop fail.
+*/
+static void
+d_async_queue_abort
+(
+    struct d_async_queue* _queue
+)
+{
+    d_functional_mutex_lock(&_queue->mutex);
+
+    _queue->aborted = true;
+
+    d_functional_cond_broadcast(&_queue->not_empty);
+    d_functional_cond_broadcast(&_queue->not_full);
+    d_functional_mutex_unlock(&_queue->mutex);
+
+    return;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             II.   CONSTRUCTION                                          ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_functional_async_new
+  Creates an asynchronous pipeline over a source, with no stages.
+
+Parameter(s):
+  _source:      the source to pull from; must outlive the pipeline. It is
+                only ever read by the pipeline's source thread.
+  _queue_depth: chunks each queue holds before its producer blocks; 0 uses
+                D_FUNCTIONAL_ASYNC_QUEUE_DEPTH.
+Return:
+  A pointer to the new pipeline, or NULL if the source has no next_chunk
+or element size, or allocation failed.
+*/
+struct d_functional_async*
+d_functional_async_new
+(
+    struct d_functional_source _source,
+    size_t                     _queue_depth
+)
+{
+    struct d_functional_async* async;
+
+    // validate parameters
+    if ( (!_source.next_chunk) ||
+         (_source.element_size == 0) )
+    {
+        return NULL;
+    }
+
+    async = d_functional_malloc(sizeof(struct d_functional_async));
+
+    // ensure that memory allocation was successful
+    if (!async)
+    {
+        return NULL;
+    }
+
+    memset(async, 0, sizeof(*async));
+
+    if (!d_functional_mutex_init(&async->mutex))
+    {
+        d_functional_free(async);
+
+        return NULL;
+    }
+
+    async->source      = _source;
+    async->queue_depth = (_queue_depth > 0)
+                         ? _queue_depth
+                         : D_FUNCTIONAL_ASYNC_QUEUE_DEPTH;
+
+    return async;
+}
+
+
+/*
+d_async_fail
+  Internal helper recording the first error of a pipeline and aborting
+every queue it has, so that all of its threads stop.
+*/
+static void
+d_async_fail
+(
+    struct d_functional_async* _async,
+    int                        _error_code
+)
+{
+    size_t i;
+
+    d_functional_mutex_lock(&_async->mutex);
+
+    if (_async->error_code == 0)
+    {
+        _async->error_code = _error_code;
+    }
+
+    d_functional_mutex_unlock(&_async->mutex);
+
+    if (_async->queues)
+    {
+        for (i = 0; i <= _async->group_count; i++)
+        {
+            if (_async->queues[i].slots)
+            {
+                d_async_queue_abort(&_async->queues[i]);
+            }
+        }
+    }
+
+    return;
+}
+
+
+/*
+d_async_add_stage
+  Internal helper appending a stage to a new group of _workers workers, or
+to the last group if _workers is 0, setting error_code on failure. A stage
+added once the pipeline has started fails it.
+*/
+static struct d_functional_async*
+d_async_add_stage
+(
+    struct d_functional_async*   _async,
+    const struct d_stream_stage* _stage,
+    size_t                       _workers
+)
+{
+    struct d_async_group*  group;
+    struct d_async_group*  grown_groups;
+    struct d_stream_stage* grown;
+    size_t                 capacity;
+
+    if (!_async)
+    {
+        return NULL;
+    }
+
+    // stages cannot change while threads may be running them
+    if (_async->launched)
+    {
+        d_async_fail(_async, -1);
+
+        return _async;
+    }
+
+    // propagate prior errors
+    if (_async->error_code != 0)
+    {
+        return _async;
+    }
+
+    // validate the stage's callback
+    if ( (!_stage->transform) &&
+         (!_stage->test)      &&
+         (!_stage->apply) )
+    {
+        _async->error_code = -1;
+
+        return _async;
+    }
+
+    // start a new group
+    if ( (_workers > 0) ||
+         (_async->group_count == 0) )
+    {
+        if (_async->group_count == _async->group_capacity)
+        {
+            capacity     = (_async->group_capacity == 0)
+                           ? 4
+                           : (_async->group_capacity * 2);
+            grown_groups = d_functional_realloc(_async->groups,
+                                                capacity *
+                                                sizeof(struct d_async_group));
+
+            // ensure that memory allocation was successful
+            if (!grown_groups)
+            {
+                _async->error_code = -1;
+
+                return _async;
+            }
+
+            _async->groups         = grown_groups;
+            _async->group_capacity = capacity;
+        }
+
+        group = &_async->groups[_async->group_count++];
+
+        memset(group, 0, sizeof(*group));
+        group->workers = (_workers > D_FUNCTIONAL_MAX_THREADS)
+                         ? D_FUNCTIONAL_MAX_THREADS
+                         : ((_workers > 0) ? _workers : 1);
+    }
+
+    group = &_async->groups[_async->group_count - 1];
+
+    if (group->stage_count == group->stage_capacity)
+    {
+        capacity = (group->stage_capacity == 0)
+                   ? 4
+                   : (group->stage_capacity * 2);
+        grown    = d_functional_realloc(group->stages,
+                                        capacity *
+                                        sizeof(struct d_stream_stage));
+
+        // ensure that memory allocation was successful
+        if (!grown)
+        {
+            _async->error_code = -1;
+
+            return _async;
+        }
+
+        group->stages         = grown;
+        group->stage_capacity = capacity;
+    }
+
+    group->stages[group->stage_count++] = *_stage;
+
+    return _async;
+}
+
+
+/*
+d_functional_async_map
+  Adds a map stage, applying a transformer to every element. The output
+elements have the same size as the input elements.
+
+Parameter(s):
+  _async:     the pipeline.
+  _transform: transformer applied to each element.
+  _context:   context forwarded to _transform; may be NULL.
+  _workers:   number of threads running a new stage group starting with
+              this stage, at most D_FUNCTIONAL_MAX_THREADS; 0 fuses the
+              stage into the previous group.
+Return:
+  _async, for chaining. error_code is set if _transform is NULL or the
+stage could not be added; adding a stage to a started pipeline fails it.
+*/
+struct d_functional_async*
+d_functional_async_map
+(
+    struct d_functional_async* _async,
+    fn_transformer             _transform,
+    void*                      _context,
+    size_t                     _workers
+)
+{
+    struct d_stream_stage stage;
+
+    memset(&stage, 0, sizeof(stage));
+    stage.kind      = D_STREAM_STAGE_MAP;
+    stage.transform = _transform;
+    stage.context   = _context;
+
+    return d_async_add_stage(_async, &stage, _workers);
+}
+
+
+/*
+d_functional_async_filter
+  Adds a filter stage, keeping the elements satisfying a predicate.
+
+Parameter(s):
+  _async:   the pipeline.
+  _test:    predicate each kept element satisfies.
+  _context: context forwarded to _test; may be NULL.
+  _workers: number of threads running a new stage group starting with
+            this stage, at most D_FUNCTIONAL_MAX_THREADS; 0 fuses the
+            stage into the previous group.
+Return:
+  _async, for chaining. error_code is set if _test is NULL or the stage
+could not be added; adding a stage to a started pipeline fails it.
+*/
+struct d_functional_async*
+d_functional_async_filter
+(
+    struct d_functional_async* _async,
+    fn_predicate               _test,
+    void*                      _context,
+    size_t                     _workers
+)
+{
+    struct d_stream_stage stage;
+
+    memset(&stage, 0, sizeof(stage));
+    stage.kind    = D_STREAM_STAGE_FILTER;
+    stage.test    = _test;
+    stage.context = _context;
+
+    return d_async_add_stage(_async, &stage, _workers);
+}
+
+
+/*
+d_functional_async_for_each
+  Adds a stage calling a consumer on every element reaching it. The
+consumer may modify the element.
+
+Parameter(s):
+  _async:   the pipeline.
+  _apply:   consumer called on each element.
+  _context: context forwarded to _apply; may be NULL.
+  _workers: number of threads running a new stage group starting with
+            this stage, at most D_FUNCTIONAL_MAX_THREADS; 0 fuses the
+            stage into the previous group.
+Return:
+  _async, for chaining. error_code is set if _apply is NULL or the stage
+could not be added; adding a stage to a started pipeline fails it.
+*/
+struct d_functional_async*
+d_functional_async_for_each
+(
+    struct d_functional_async* _async,
+    fn_consumer                _apply,
+    void*                      _context,
+    size_t                     _workers
+)
+{
+    struct d_stream_stage stage;
+
+    memset(&stage, 0, sizeof(stage));
+    stage.kind    = D_STREAM_STAGE_FOR_EACH;
+    stage.apply   = _apply;
+    stage.context = _context;
+
+    return d_async_add_stage(_async, &stage, _workers);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             III.  THREADS                                               ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_async_finish
+  Internal helper recording that one thread of a pipeline is done.
+*/
+static void
+d_async_finish
+(
+    struct d_functional_async* _async
+)
+{
+    d_functional_mutex_lock(&_async->mutex);
+
+    _async->running--;
+
+    d_functional_mutex_unlock(&_async->mutex);
+
+    return;
+}
+
+/*
+d_async_run_source
+  Internal fn_callback of the source thread: pulls every chunk from the
+source, copies it into an owned chunk numbered in source order, and feeds
+it to the first queue.
+*/
+static void
+d_async_run_source
+(
+    void* _thread
+)
+{
+    struct d_functional_async*     async;
+    struct d_functional_allocator* previous;
+    struct d_async_chunk*          chunk;
+    const void*                    data;
+    size_t                         count;
+    size_t                         size;
+    size_t                         sequence;
+
+    async    = ((struct d_async_thread*)_thread)->async;
+    previous = d_functional_allocator_push(async->allocator);
+    size     = async->source.element_size;
+    sequence = 0;
+
+    for (;;)
+    {
+        if (!d_functional_source_next(&async->source, &data, &count))
+        {
+            d_async_fail(async, -1);
+
+            break;
+        }
+
+        // the end of the input
+        if (count == 0)
+        {
+            break;
+        }
+
+        chunk = d_functional_malloc(sizeof(struct d_async_chunk));
+
+        // ensure that memory allocation was successful
+        if (!chunk)
+        {
+            d_async_fail(async, -1);
+
+            break;
+        }
+
+        chunk->data     = d_functional_malloc(count * size);
+        chunk->count    = count;
+        chunk->sequence = sequence++;
+        chunk->next     = NULL;
+
+        // ensure that memory allocation was successful
+        if (!chunk->data)
+        {
+            d_functional_free(chunk);
+            d_async_fail(async, -1);
+
+            break;
+        }
+
+        memcpy(chunk->data, data, count * size);
+
+        if (!d_async_queue_push(&async->queues[0], chunk))
+        {
+            d_async_chunk_free(chunk);
+
+            break;
+        }
+    }
+
+    d_async_queue_close(&async->queues[0]);
+    d_functional_allocator_pop(previous);
+    d_async_finish(async);
+
+    return;
+}
+
+/*
+d_async_run_stages
+  Internal helper running a group's stages over one chunk in place. Map
+writes each element through _scratch, one element in size; filter
+compacts the chunk.
+*/
+static bool
+d_async_run_stages
+(
+    const struct d_async_group* _group,
+    struct d_async_chunk*       _chunk,
+    size_t                      _size,
+    unsigned char*              _scratch
+)
+{
+    const struct d_stream_stage* stage;
+    unsigned char*               data;
+    size_t                       kept;
+    size_t                       s;
+    size_t                       i;
+
+    data = _chunk->data;
+
+    for (s = 0; (s < _group->stage_count) && (_chunk->count > 0); s++)
+    {
+        stage = &_group->stages[s];
+
+        switch (stage->kind)
+        {
+        case D_STREAM_STAGE_MAP:
+            for (i = 0; i < _chunk->count; i++)
+            {
+                if (!stage->transform(data + (i * _size),
+                                      _scratch,
+                                      stage->context))
+                {
+                    return false;
+                }
+
+                memcpy(data + (i * _size), _scratch, _size);
+            }
+
+            break;
+
+        case D_STREAM_STAGE_FILTER:
+            kept = 0;
+
+            for (i = 0; i < _chunk->count; i++)
+            {
+                if (stage->test(data + (i * _size), stage->context))
+                {
+                    if (kept != i)
+                    {
+                        memcpy(data + (kept * _size),
+                               data + (i * _size),
+                               _size);
+                    }
+
+                    kept++;
+                }
+            }
+
+            _chunk->count = kept;
+
+            break;
+
+        case D_STREAM_STAGE_FOR_EACH:
+            for (i = 0; i < _chunk->count; i++)
+            {
+                stage->apply(data + (i * _size), stage->context);
+            }
+
+            break;
+
+        default:
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+d_async_run_worker
+  Internal fn_callback of a worker thread: takes chunks from the queue in
+front of its group, runs the group's stages on them, and passes them on.
+Chunks a filter empties are still passed on, so that the sink sees every
+sequence number.
+*/
+static void
+d_async_run_worker
+(
+    void* _thread
+)
+{
+    struct d_async_thread*         thread;
+    struct d_functional_async*     async;
+    struct d_functional_allocator* previous;
+    struct d_async_chunk*          chunk;
+    unsigned char*                 scratch;
+
+    thread   = (struct d_async_thread*)_thread;
+    async    = thread->async;
+    previous = d_functional_allocator_push(async->allocator);
+    scratch  = d_functional_malloc(async->source.element_size);
+
+    // ensure that memory allocation was successful
+    if (!scratch)
+    {
+        d_async_fail(async, -1);
+    }
+
+    while ( (scratch) &&
+            ((chunk = d_async_queue_pop(&async->queues[thread->group]))) )
+    {
+        if (!d_async_run_stages(&async->groups[thread->group],
+                                chunk,
+                                async->source.element_size,
+                                scratch))
+        {
+            d_async_chunk_free(chunk);
+            d_async_fail(async, -1);
+
+            break;
+        }
+
+        if (!d_async_queue_push(&async->queues[thread->group + 1], chunk))
+        {
+            d_async_chunk_free(chunk);
+
+            break;
+        }
+    }
+
+    d_async_queue_close(&async->queues[thread->group + 1]);
+    d_functional_free(scratch);
+    d_functional_allocator_pop(previous);
+    d_async_finish(async);
+
+    return;
+}
+
+/*
+d_async_consume
+  Internal helper applying the sink's terminal operation to one chunk, in
+source order. *_collected grows as needed, tracking *_capacity elements.
+*/
+static bool
+d_async_consume
+(
+    struct d_functional_async*  _async,
+    const struct d_async_chunk* _chunk,
+    unsigned char**             _collected,
+    size_t*                     _count,
+    size_t*                     _capacity
+)
+{
+    unsigned char* grown;
+    size_t         size;
+    size_t         capacity;
+    size_t         i;
+
+    size = _async->source.element_size;
+
+    switch (_async->sink)
+    {
+    case D_ASYNC_SINK_FOLD:
+        for (i = 0; i < _chunk->count; i++)
+        {
+            if (!_async->combine(_async->accumulator,
+                                 _chunk->data + (i * size),
+                                 _async->sink_context))
+            {
+                return false;
+            }
+        }
+
+        return true;
+
+    case D_ASYNC_SINK_COLLECT:
+        if (*_count + _chunk->count > *_capacity)
+        {
+            capacity = *_capacity;
+
+            while (*_count + _chunk->count > capacity)
+            {
+                capacity *= 2;
+            }
+
+            grown = d_functional_realloc(*_collected, capacity * size);
+
+            // ensure that memory allocation was successful
+            if (!grown)
+            {
+                return false;
+            }
+
+            *_collected = grown;
+            *_capacity  = capacity;
+        }
+
+        memcpy(*_collected + (*_count * size),
+               _chunk->data,
+               _chunk->count * size);
+        *_count += _chunk->count;
+
+        return true;
+
+    default:
+        return true;
+    }
+}
+
+/*
+d_async_run_sink
+  Internal fn_callback of the sink thread: takes chunks from the last
+queue, holds back those that arrive ahead of their turn, and consumes the
+rest in source order. The held-back chunks are bounded by the number of
+chunks in flight.
+*/
+static void
+d_async_run_sink
+(
+    void* _thread
+)
+{
+    struct d_functional_async*     async;
+    struct d_functional_allocator* previous;
+    struct d_async_chunk*          chunk;
+    struct d_async_chunk*          pending;
+    struct d_async_chunk**         link;
+    unsigned char*                 collected;
+    size_t                         count;
+    size_t                         capacity;
+    size_t                         expected;
+    bool                           success;
+
+    async     = ((struct d_async_thread*)_thread)->async;
+    previous  = d_functional_allocator_push(async->allocator);
+    pending   = NULL;
+    collected = NULL;
+    count     = 0;
+    capacity  = 16;
+    expected  = 0;
+    success   = true;
+
+    if (async->sink == D_ASYNC_SINK_COLLECT)
+    {
+        collected = d_functional_malloc(capacity *
+                                        async->source.element_size);
+
+        // ensure that memory allocation was successful
+        if (!collected)
+        {
+            d_async_fail(async, -1);
+            success = false;
+        }
+    }
+
+    while ( (success) &&
+            ((chunk = d_async_queue_pop(
+                          &async->queues[async->group_count]))) )
+    {
+        // insert into the pending list, ordered by sequence
+        link = &pending;
+
+        while ( (*link) &&
+                ((*link)->sequence < chunk->sequence) )
+        {
+            link = &(*link)->next;
+        }
+
+        chunk->next = *link;
+        *link       = chunk;
+
+        // consume every chunk whose turn has come
+        while ( (success) &&
+                (pending) &&
+                (pending->sequence == expected) )
+        {
+            chunk   = pending;
+            pending = chunk->next;
+            success = d_async_consume(async, chunk, &collected, &count,
+                                      &capacity);
+
+            d_async_chunk_free(chunk);
+            expected++;
+        }
+
+        if (!success)
+        {
+            d_async_fail(async, -1);
+        }
+    }
+
+    while (pending)
+    {
+        chunk   = pending;
+        pending = chunk->next;
+
+        d_async_chunk_free(chunk);
+    }
+
+    // every other thread has stopped producing; publish the result
+    if (async->sink == D_ASYNC_SINK_COLLECT)
+    {
+        d_functional_mutex_lock(&async->mutex);
+        success = (async->error_code == 0);
+        d_functional_mutex_unlock(&async->mutex);
+
+        if (success)
+        {
+            *async->out_data = collected;
+
+            if (async->out_count)
+            {
+                *async->out_count = count;
+            }
+        }
+        else
+        {
+            d_functional_free(collected);
+        }
+    }
+
+    d_functional_allocator_pop(previous);
+    d_async_finish(async);
+
+    return;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             IV.   EXECUTION                                             ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_async_launch
+  Internal helper creating the queues and threads of a pipeline and
+starting them. A thread that cannot be started fails the pipeline, which
+then stops the others.
+*/
+static bool
+d_async_launch
+(
+    struct d_functional_async* _async
+)
+{
+    struct d_async_thread* thread;
+    size_t                 threads;
+    size_t                 t;
+    size_t                 g;
+    size_t                 w;
+
+    // propagate prior errors, and run only once
+    if ( (_async->error_code != 0) ||
+         (_async->launched) )
+    {
+        return false;
+    }
+
+    _async->launched  = true;
+    _async->allocator = d_functional_allocator_current();
+
+    // the source, every worker, and the sink
+    threads = 2;
+
+    for (g = 0; g < _async->group_count; g++)
+    {
+        threads += _async->groups[g].workers;
+    }
+
+    _async->queues  = d_functional_calloc(_async->group_count + 1,
+                                          sizeof(struct d_async_queue));
+    _async->threads = d_functional_calloc(threads,
+                                          sizeof(struct d_async_thread));
+
+    // ensure that memory allocation was successful
+    if ( (!_async->queues) ||
+         (!_async->threads) )
+    {
+        _async->error_code = -1;
+
+        return false;
+    }
+
+    // queue 0 is fed by the source, queue g + 1 by the workers of group g
+    for (g = 0; g <= _async->group_count; g++)
+    {
+        if (!d_async_queue_init(&_async->queues[g],
+                                _async->queue_depth,
+                                (g == 0) ? 1 : _async->groups[g - 1].workers))
+        {
+            _async->error_code = -1;
+
+            return false;
+        }
+    }
+
+    _async->threads[0].entry = d_async_run_source;
+    t                        = 1;
+
+    for (g = 0; g < _async->group_count; g++)
+    {
+        for (w = 0; w < _async->groups[g].workers; w++)
+        {
+            _async->threads[t].entry = d_async_run_worker;
+            _async->threads[t].group = g;
+            t++;
+        }
+    }
+
+    _async->threads[t].entry = d_async_run_sink;
+    _async->thread_count     = threads;
+    _async->running          = threads;
+
+    for (t = 0; t < threads; t++)
+    {
+        thread        = &_async->threads[t];
+        thread->async = _async;
+
+        thread->started = d_functional_thread_start(&thread->handle,
+                                                    thread->entry,
+                                                    thread);
+
+        if (!thread->started)
+        {
+            d_async_fail(_async, -1);
+            d_async_finish(_async);
+        }
+    }
+
+    return true;
+}
+
+
+/*
+d_functional_async_start
+  Starts the pipeline and returns at once. The output of the last stage is
+discarded, so the pipeline runs for its for_each stages' effects.
+
+Parameter(s):
+  _async: the pipeline; runs at most once.
+Return:
+  A boolean value corresponding to either:
+  - true, if the pipeline was started; its outcome is reported by
+    d_functional_async_wait, or
+  - false, if _async was NULL or already started, or the pipeline was in
+    an error state or its queues and threads could not be allocated;
+    error_code then holds the error.
+*/
+bool
+d_functional_async_start
+(
+    struct d_functional_async* _async
+)
+{
+    if (!_async)
+    {
+        return false;
+    }
+
+    return d_async_launch(_async);
+}
+
+
+/*
+d_functional_async_start_fold
+  Starts the pipeline, folding its output into an accumulator on the sink
+thread, and returns at once. The elements are folded in source order,
+whatever the number of workers.
+
+Parameter(s):
+  _async:       the pipeline; runs at most once.
+  _accumulator: the accumulator, holding the initial value; modified
+                in-place and must not be read until the pipeline
+                completes.
+  _combine:     accumulator function applied to each element.
+  _context:     context forwarded to _combine; may be NULL.
+Return:
+  A boolean value corresponding to either:
+  - true, if the pipeline was started, or
+  - false, if _async was NULL or already started, or the pipeline was in
+    an error state, a parameter was NULL, or it could not be started;
+    error_code then holds the error.
+*/
+bool
+d_functional_async_start_fold
+(
+    struct d_functional_async* _async,
+    void*                      _accumulator,
+    fn_accumulator             _combine,
+    void*                      _context
+)
+{
+    if ( (!_async) ||
+         (_async->launched) )
+    {
+        return false;
+    }
+
+    // validate parameters
+    if ( (!_accumulator) ||
+         (!_combine) )
+    {
+        _async->error_code = -1;
+
+        return false;
+    }
+
+    _async->sink         = D_ASYNC_SINK_FOLD;
+    _async->accumulator  = _accumulator;
+    _async->combine      = _combine;
+    _async->sink_context = _context;
+
+    return d_async_launch(_async);
+}
+
+
+/*
+d_functional_async_start_collect
+  Starts the pipeline, gathering its output into one newly allocated array
+on the sink thread, and returns at once. The elements are gathered in
+source order, whatever the number of workers.
+
+Parameter(s):
+  _async:     the pipeline; runs at most once.
+  _out_data:  receives, on completion, the array, which the caller must
+              free, or NULL if the pipeline failed. An empty output is a
+              non-NULL allocation with a count of 0.
+  _out_count: receives, on completion, the number of elements; may be
+              NULL.
+Return:
+  A boolean value corresponding to either:
+  - true, if the pipeline was started, or
+  - false, if _async was NULL or already started, or the pipeline was in
+    an error state, _out_data was NULL, or it could not be started;
+    error_code then holds the error.
+*/
+bool
+d_functional_async_start_collect
+(
+    struct d_functional_async* _async,
+    void**                     _out_data,
+    size_t*                    _out_count
+)
+{
+    if ( (!_async) ||
+         (_async->launched) )
+    {
+        return false;
+    }
+
+    // validate parameters
+    if (!_out_data)
+    {
+        _async->error_code = -1;
+
+        return false;
+    }
+
+    *_out_data = NULL;
+
+    if (_out_count)
+    {
+        *_out_count = 0;
+    }
+
+    _async->sink      = D_ASYNC_SINK_COLLECT;
+    _async->out_data  = _out_data;
+    _async->out_count = _out_count;
+
+    return d_async_launch(_async);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             V.    COMPLETION                                            ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_functional_async_ready
+  Polls a pipeline for completion without blocking.
+
+Parameter(s):
+  _async: the pipeline.
+Return:
+  A boolean value corresponding to either:
+  - true, if no thread of the pipeline is still running: it completed, or
+    was never started; d_functional_async_wait then returns at once, or
+  - false, if it is still running, or _async was NULL.
+*/
+bool
+d_functional_async_ready
+(
+    struct d_functional_async* _async
+)
+{
+    bool ready;
+
+    if (!_async)
+    {
+        return false;
+    }
+
+    d_functional_mutex_lock(&_async->mutex);
+    ready = (_async->running == 0);
+    d_functional_mutex_unlock(&_async->mutex);
+
+    return ready;
+}
+
+
+/*
+d_functional_async_wait
+  Blocks until every thread of a pipeline has finished, then reports its
+outcome. Fold and collect results are only valid once this returns 0.
+Must not be called concurrently on the same pipeline.
+
+Parameter(s):
+  _async: the pipeline.
+Return:
+  The pipeline's error_code: 0 if every chunk was processed, non-zero if
+a stage could not be added, the pipeline could not be started, or a
+callback, the source, or an allocation failed while it ran. -1 if _async
+was NULL.
+*/
+int
+d_functional_async_wait
+(
+    struct d_functional_async* _async
+)
+{
+    size_t t;
+
+    if (!_async)
+    {
+        return -1;
+    }
+
+    if ( (_async->threads) &&
+         (!_async->joined) )
+    {
+        for (t = 0; t < _async->thread_count; t++)
+        {
+            if (_async->threads[t].started)
+            {
+                d_functional_thread_join(_async->threads[t].handle);
+            }
+        }
+
+        _async->joined = true;
+    }
+
+    return _async->error_code;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             VI.   CLEANUP                                               ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_functional_async_free
+  Frees a pipeline, first waiting for it to complete if it is running.
+Chunks still queued after an error are freed with it.
+
+Parameter(s):
+  _async: the pipeline; may be NULL.
+Return:
+  none.
+*/
+void
+d_functional_async_free
+(
+    struct d_functional_async* _async
+)
+{
+    size_t g;
+
+    if (!_async)
+    {
+        return;
+    }
+
+    d_functional_async_wait(_async);
+
+    if (_async->queues)
+    {
+        for (g = 0; g <= _async->group_count; g++)
+        {
+            d_async_queue_destroy(&_async->queues[g]);
+        }
+    }
+
+    for (g = 0; g < _async->group_count; g++)
+    {
+        d_functional_free(_async->groups[g].stages);
+    }
+
+    d_functional_mutex_destroy(&_async->mutex);
+    d_functional_free(_async->queues);
+    d_functional_free(_async->threads);
+    d_functional_free(_async->groups);
+    d_functional_free(_async);
+
+    return;
+}
@@ -40,7 +40,7 @@ d_functional_compose_new
         return NULL;
     }
 
-    result = malloc(sizeof(struct d_composed_transformer));
+    result = d_functional_malloc(sizeof(struct d_composed_transformer));
 
     // check allocation
     if (!result)
@@ -48,12 +48,12 @@ d_functional_compose_new
         return NULL;
     }
 
-    temp_buf = malloc(_temp_size);
+    temp_buf = d_functional_malloc(_temp_size);
 
     // ensure that memory allocation was successful
     if (!temp_buf)
     {
-        free(result);
+        d_functional_free(result);
 
         return NULL;
     }
@@ -68,6 +68,69 @@ d_functional_compose_new
     return result;
 }
 
+/*
+d_functional_compose_new_in
+  Creates a composed transformer inside an arena. Identical to
+d_functional_compose_new except that the transformer and its temporary
+buffer are bump-allocated from _arena; both are released with the arena and
+must not be passed to d_functional_compose_free.
+
+Parameter(s):
+  _arena:     the arena to allocate from.
+  _first:     the transformer to apply first (g).
+  _context1:  context forwarded to _first; may be NULL.
+  _second:    the transformer to apply second (f).
+  _context2:  context forwarded to _second; may be NULL.
+  _temp_size: size in bytes of the intermediate result between _first and
+              _second.
+Return:
+  A pointer to the new composed transformer, or NULL if _arena, _first or
+_second was NULL, _temp_size was 0, or the arena could not grow.
+*/
+struct d_composed_transformer*
+d_functional_compose_new_in
+(
+    struct d_fn_arena* _arena,
+    fn_transformer     _first,
+    void*              _context1,
+    fn_transformer     _second,
+    void*              _context2,
+    size_t             _temp_size
+)
+{
+    struct d_composed_transformer* result;
+    void*                          temp_buf;
+
+    // validate parameters
+    if ( (!_arena)  ||
+         (!_first)  ||
+         (!_second) ||
+         (_temp_size == 0) )
+    {
+        return NULL;
+    }
+
+    result   = d_fn_arena_alloc(_arena, sizeof(struct d_composed_transformer));
+    temp_buf = d_fn_arena_alloc(_arena, _temp_size);
+
+    // ensure that memory allocation was successful; whatever was obtained is
+    // reclaimed with the arena
+    if ( (!result) ||
+         (!temp_buf) )
+    {
+        return NULL;
+    }
+
+    result->first     = _first;
+    result->second    = _second;
+    result->context1  = _context1;
+    result->context2  = _context2;
+    result->temp_size = _temp_size;
+    result->temp_buf  = temp_buf;
+
+    return result;
+}
+
 /*
 d_functional_compose_apply
   Applies a composed transformer to an input, writing the final result to
@@ -145,10 +208,10 @@ d_functional_compose_free
     {
         if (_composed->temp_buf)
         {
-            free(_composed->temp_buf);
+            d_functional_free(_composed->temp_buf);
         }
 
-        free(_composed);
+        d_functional_free(_composed);
     }
 
     return;
@@ -182,7 +245,52 @@ d_functional_partial_consumer_new
         return NULL;
     }
 
-    result = malloc(sizeof(struct d_partial_consumer));
+    result = d_functional_malloc(sizeof(struct d_partial_consumer));
+
+    // ensure that memory allocation was successful
+    if (!result)
+    {
+        return NULL;
+    }
+
+    result->consumer = _consumer;
+    result->context  = _context;
+
+    return result;
+}
+
+/*
+d_functional_partial_consumer_new_in
+  Creates a partial consumer inside an arena. Identical to
+d_functional_partial_consumer_new except for where the consumer lives; it is
+released with the arena and must not be passed to
+d_functional_partial_consumer_free.
+
+Parameter(s):
+  _arena:    the arena to allocate from.
+  _consumer: the consumer function to partially apply.
+  _context:  context to bind to the consumer; may be NULL.
+Return:
+  A pointer to the new partial consumer, or NULL if _arena or _consumer was
+NULL or the arena could not grow.
+*/
+struct d_partial_consumer*
+d_functional_partial_consumer_new_in
+(
+    struct d_fn_arena* _arena,
+    fn_consumer        _consumer,
+    void*              _context
+)
+{
+    struct d_partial_consumer* result;
+
+    // validate parameters
+    if (!_consumer)
+    {
+        return NULL;
+    }
+
+    result = d_fn_arena_alloc(_arena, sizeof(struct d_partial_consumer));
 
     // ensure that memory allocation was successful
     if (!result)
@@ -242,7 +350,582 @@ d_functional_partial_consumer_free
 {
     if (_partial)
     {
-        free(_partial);
+        d_functional_free(_partial);
+    }
+
+    return;
+}
+
+/*
+d_compose_stride
+  Internal helper: rounds a slot size up to D_FUNCTIONAL_COMPOSE_ALIGNMENT,
+so that every slot and block of an n-ary composition starts aligned for the
+typed transformers that write into it.
+*/
+static size_t
+d_compose_stride
+(
+    size_t _size
+)
+{
+    return (_size + (D_FUNCTIONAL_COMPOSE_ALIGNMENT - 1)) &
+           ~(size_t)(D_FUNCTIONAL_COMPOSE_ALIGNMENT - 1);
+}
+
+/*
+d_compose_layout
+  Internal helper: places the two scratch slots and the two blocks of an
+n-ary composition in a buffer of d_functional_compose_many_scratch_size
+bytes. A single stage needs no buffer, and its slots are left NULL.
+*/
+static void
+d_compose_layout
+(
+    const struct d_composed_chain* _chain,
+    void*                          _buffer,
+    void**                         _slots,
+    void**                         _blocks
+)
+{
+    unsigned char* base;
+    size_t         stride;
+
+    if (!_buffer)
+    {
+        _slots[0]  = NULL;
+        _slots[1]  = NULL;
+        _blocks[0] = NULL;
+        _blocks[1] = NULL;
+
+        return;
+    }
+
+    base   = (unsigned char*)_buffer;
+    stride = d_compose_stride(_chain->scratch_size);
+
+    _slots[0]  = base;
+    _slots[1]  = base + stride;
+    _blocks[0] = base + (2 * stride);
+    _blocks[1] = base + (2 * stride) +
+                 (stride * D_FUNCTIONAL_COMPOSE_BLOCK_SIZE);
+
+    return;
+}
+
+/*
+d_compose_run
+  Internal helper: applies every stage to one input, alternating the
+intermediate results between _slots[0] and _slots[1].
+*/
+static bool
+d_compose_run
+(
+    const struct d_composed_chain* _chain,
+    void* const*                   _slots,
+    const void*                    _input,
+    void*                          _output
+)
+{
+    const struct d_compose_stage* stage;
+    const void*                   src;
+    void*                         dst;
+    size_t                        last;
+    size_t                        i;
+
+    src  = _input;
+    last = _chain->count - 1;
+
+    for (i = 0; i < _chain->count; i++)
+    {
+        stage = &_chain->stages[i];
+        dst   = (i == last)
+                ? _output
+                : _slots[i & 1];
+
+        if (!stage->transform(src, dst, stage->context))
+        {
+            return false;
+        }
+
+        src = dst;
+    }
+
+    return true;
+}
+
+/*
+d_compose_run_array
+  Internal helper: maps an array through every stage a block at a time,
+alternating the intermediate blocks between _blocks[0] and _blocks[1].
+*/
+static bool
+d_compose_run_array
+(
+    const struct d_composed_chain* _chain,
+    void* const*                   _blocks,
+    const void*                    _input,
+    size_t                         _count,
+    size_t                         _input_size,
+    void*                          _output
+)
+{
+    const struct d_compose_stage* stage;
+    const unsigned char*          src;
+    unsigned char*                dst;
+    size_t                        src_stride;
+    size_t                        dst_stride;
+    size_t                        out_size;
+    size_t                        base;
+    size_t                        n;
+    size_t                        s;
+    size_t                        j;
+
+    out_size = _chain->stages[_chain->count - 1].output_size;
+
+    for (base = 0; base < _count; base += n)
+    {
+        n = _count - base;
+
+        if (n > D_FUNCTIONAL_COMPOSE_BLOCK_SIZE)
+        {
+            n = D_FUNCTIONAL_COMPOSE_BLOCK_SIZE;
+        }
+
+        src        = (const unsigned char*)_input + (base * _input_size);
+        src_stride = _input_size;
+
+        // run each stage over the whole block
+        for (s = 0; s < _chain->count; s++)
+        {
+            stage = &_chain->stages[s];
+
+            if (s + 1 == _chain->count)
+            {
+                dst        = (unsigned char*)_output + (base * out_size);
+                dst_stride = out_size;
+            }
+            else
+            {
+                dst        = (unsigned char*)_blocks[s & 1];
+                dst_stride = stage->output_size;
+            }
+
+            for (j = 0; j < n; j++)
+            {
+                if (!stage->transform(src + (j * src_stride),
+                                      dst + (j * dst_stride),
+                                      stage->context))
+                {
+                    return false;
+                }
+            }
+
+            src        = dst;
+            src_stride = dst_stride;
+        }
+    }
+
+    return true;
+}
+
+/*
+d_functional_compose_many
+  Creates a heap-allocated n-ary composition from an array of stages. The
+stages are copied, so _stages may be released after this call. Stage i
+receives the output of stage i - 1; the first stage receives the caller's
+input and the last stage writes the caller's output.
+  Two scratch slots, each sized for the largest intermediate value, are
+allocated once and reused for every application, along with two block
+buffers used by d_functional_compose_apply_array. The _with variants of
+those functions use a caller's buffer instead, so that one composition can
+be applied from several threads at once.
+
+Parameter(s):
+  _stages: array of _count stages, in application order.
+  _count:  number of stages; must be at least 1.
+Return:
+  A pointer to a newly allocated d_composed_chain, or NULL if _stages was
+NULL, _count was 0, any stage had a NULL transform or a zero output_size,
+or allocation failed.
+*/
+struct d_composed_chain*
+d_functional_compose_many
+(
+    const struct d_compose_stage* _stages,
+    size_t                        _count
+)
+{
+    struct d_composed_chain* result;
+    void*                    buffers;
+    size_t                   scratch_size;
+    size_t                   i;
+
+    // validate parameters
+    if ( (!_stages) ||
+         (_count == 0) )
+    {
+        return NULL;
+    }
+
+    scratch_size = 0;
+
+    for (i = 0; i < _count; i++)
+    {
+        if ( (!_stages[i].transform) ||
+             (_stages[i].output_size == 0) )
+        {
+            return NULL;
+        }
+
+        // the last stage writes directly into the caller's output
+        if ( (i + 1 < _count) &&
+             (_stages[i].output_size > scratch_size) )
+        {
+            scratch_size = _stages[i].output_size;
+        }
+    }
+
+    result = d_functional_malloc(sizeof(struct d_composed_chain));
+
+    // ensure that memory allocation was successful
+    if (!result)
+    {
+        return NULL;
+    }
+
+    result->stages = d_functional_malloc(_count *
+                                         sizeof(struct d_compose_stage));
+
+    if (!result->stages)
+    {
+        d_functional_free(result);
+
+        return NULL;
+    }
+
+    memcpy(result->stages, _stages, _count * sizeof(struct d_compose_stage));
+
+    result->count        = _count;
+    result->scratch_size = scratch_size;
+    result->scratch[0]   = NULL;
+    result->scratch[1]   = NULL;
+    result->block_buf[0] = NULL;
+    result->block_buf[1] = NULL;
+
+    // a single stage has no intermediate results
+    if (scratch_size == 0)
+    {
+        return result;
+    }
+
+    // both scratch slots and both blocks share one allocation
+    buffers = d_functional_malloc(
+                  d_functional_compose_many_scratch_size(result));
+
+    if (!buffers)
+    {
+        d_functional_free(result->stages);
+        d_functional_free(result);
+
+        return NULL;
+    }
+
+    d_compose_layout(result, buffers, result->scratch, result->block_buf);
+
+    return result;
+}
+
+/*
+d_functional_compose_many_apply
+  Applies every stage of an n-ary composition to a single input, writing
+the final result to _output. Intermediate results alternate between the two
+scratch slots; unlike d_functional_compose_apply, the slots are not zeroed
+between stages, so each transformer must fully write its output.
+  The slots belong to the composition, so it must not be applied from
+several threads at once; use d_functional_compose_many_apply_with for that.
+
+Parameter(s):
+  _chain:  pointer to the n-ary composition.
+  _input:  pointer to the input element.
+  _output: pointer to the output destination; must hold at least
+           d_functional_compose_many_output_size(_chain) bytes.
+Return:
+  A boolean value corresponding to either:
+  - true, if every stage succeeded, or
+  - false, if any parameter was NULL, the composition has no stages, or
+    any stage failed.
+*/
+bool
+d_functional_compose_many_apply
+(
+    struct d_composed_chain* _chain,
+    const void*              _input,
+    void*                    _output
+)
+{
+    // validate parameters
+    if ( (!_chain)             ||
+         (!_chain->stages)     ||
+         (_chain->count == 0)  ||
+         (!_input)             ||
+         (!_output) )
+    {
+        return false;
+    }
+
+    return d_compose_run(_chain, _chain->scratch, _input, _output);
+}
+
+/*
+d_functional_compose_many_apply_with
+  Variant of d_functional_compose_many_apply whose intermediate results go
+to a caller's buffer instead of the composition's own slots; the
+composition is only read, so threads applying it with separate buffers do
+not interfere.
+
+Parameter(s):
+  _chain:   pointer to the n-ary composition.
+  _scratch: buffer of d_functional_compose_many_scratch_size(_chain) bytes,
+            aligned to D_FUNCTIONAL_COMPOSE_ALIGNMENT; may be NULL when
+            that size is 0.
+  _input:   pointer to the input element.
+  _output:  pointer to the output destination; must hold at least
+            d_functional_compose_many_output_size(_chain) bytes.
+Return:
+  A boolean value corresponding to either:
+  - true, if every stage succeeded, or
+  - false, if any required parameter was NULL, the composition has no
+    stages, or any stage failed.
+*/
+bool
+d_functional_compose_many_apply_with
+(
+    const struct d_composed_chain* _chain,
+    void*                          _scratch,
+    const void*                    _input,
+    void*                          _output
+)
+{
+    void* slots[2];
+    void* blocks[2];
+
+    // validate parameters
+    if ( (!_chain)                                      ||
+         (!_chain->stages)                              ||
+         (_chain->count == 0)                           ||
+         ( (!_scratch) && (_chain->scratch_size > 0) )  ||
+         (!_input)                                      ||
+         (!_output) )
+    {
+        return false;
+    }
+
+    d_compose_layout(_chain, _scratch, slots, blocks);
+
+    return d_compose_run(_chain, slots, _input, _output);
+}
+
+/*
+d_functional_compose_apply_array
+  Maps an entire array through an n-ary composition. The input is processed
+in blocks of D_FUNCTIONAL_COMPOSE_BLOCK_SIZE elements: each stage is run
+over the whole block before the next stage starts, so consecutive calls go
+to the same transformer and the block's intermediates stay cache-resident.
+The first stage reads directly from _input and the last stage writes
+directly into _output.
+  The blocks belong to the composition, so it must not be applied from
+several threads at once; use d_functional_compose_apply_array_with for
+that.
+
+Parameter(s):
+  _chain:      pointer to the n-ary composition.
+  _input:      pointer to the input array.
+  _count:      number of elements in the input array.
+  _input_size: size in bytes of each input element.
+  _output:     pointer to the output array; must hold at least
+               _count * d_functional_compose_many_output_size(_chain) bytes.
+Return:
+  A boolean value corresponding to either:
+  - true, if every stage succeeded for every element, or
+  - false, if any parameter was NULL/zero, the composition has no stages,
+    or any stage failed. Elements before the failing block may already
+    have been written to _output.
+*/
+bool
+d_functional_compose_apply_array
+(
+    struct d_composed_chain* _chain,
+    const void*              _input,
+    size_t                   _count,
+    size_t                   _input_size,
+    void*                    _output
+)
+{
+    // validate parameters
+    if ( (!_chain)             ||
+         (!_chain->stages)     ||
+         (_chain->count == 0)  ||
+         (!_input)             ||
+         (!_output)            ||
+         (_count == 0)         ||
+         (_input_size == 0) )
+    {
+        return false;
+    }
+
+    return d_compose_run_array(_chain,
+                               _chain->block_buf,
+                               _input,
+                               _count,
+                               _input_size,
+                               _output);
+}
+
+/*
+d_functional_compose_apply_array_with
+  Variant of d_functional_compose_apply_array whose intermediate blocks go
+to a caller's buffer instead of the composition's own; see
+d_functional_compose_many_apply_with.
+
+Parameter(s):
+  _chain:      pointer to the n-ary composition.
+  _scratch:    buffer of d_functional_compose_many_scratch_size(_chain)
+               bytes, aligned to D_FUNCTIONAL_COMPOSE_ALIGNMENT; may be
+               NULL when that size is 0.
+  _input:      pointer to the input array.
+  _count:      number of elements in the input array.
+  _input_size: size in bytes of each input element.
+  _output:     pointer to the output array; must hold at least
+               _count * d_functional_compose_many_output_size(_chain) bytes.
+Return:
+  A boolean value, as d_functional_compose_apply_array; also false if
+_scratch is NULL but needed.
+*/
+bool
+d_functional_compose_apply_array_with
+(
+    const struct d_composed_chain* _chain,
+    void*                          _scratch,
+    const void*                    _input,
+    size_t                         _count,
+    size_t                         _input_size,
+    void*                          _output
+)
+{
+    void* slots[2];
+    void* blocks[2];
+
+    // validate parameters
+    if ( (!_chain)                                      ||
+         (!_chain->stages)                              ||
+         (_chain->count == 0)                           ||
+         ( (!_scratch) && (_chain->scratch_size > 0) )  ||
+         (!_input)                                      ||
+         (!_output)                                     ||
+         (_count == 0)                                  ||
+         (_input_size == 0) )
+    {
+        return false;
+    }
+
+    d_compose_layout(_chain, _scratch, slots, blocks);
+
+    return d_compose_run_array(_chain,
+                               blocks,
+                               _input,
+                               _count,
+                               _input_size,
+                               _output);
+}
+
+/*
+d_functional_compose_many_scratch_size
+  Returns the size in bytes of the buffer the _with variants of
+d_functional_compose_many_apply and d_functional_compose_apply_array need
+for an n-ary composition: two slots and two blocks for its largest
+intermediate value.
+
+Parameter(s):
+  _chain: pointer to the n-ary composition.
+Return:
+  The buffer size in bytes, or 0 if _chain was NULL or has no intermediate
+values (a single stage).
+*/
+size_t
+d_functional_compose_many_scratch_size
+(
+    const struct d_composed_chain* _chain
+)
+{
+    size_t stride;
+
+    if ( (!_chain) ||
+         (_chain->scratch_size == 0) )
+    {
+        return 0;
+    }
+
+    stride = d_compose_stride(_chain->scratch_size);
+
+    return (2 * stride) + (2 * stride * D_FUNCTIONAL_COMPOSE_BLOCK_SIZE);
+}
+
+/*
+d_functional_compose_many_output_size
+  Returns the size in bytes of the value produced by an n-ary composition,
+i.e. the output_size of its last stage.
+
+Parameter(s):
+  _chain: pointer to the n-ary composition.
+Return:
+  The output size in bytes, or 0 if _chain was NULL or has no stages.
+*/
+size_t
+d_functional_compose_many_output_size
+(
+    const struct d_composed_chain* _chain
+)
+{
+    if ( (!_chain)             ||
+         (!_chain->stages)     ||
+         (_chain->count == 0) )
+    {
+        return 0;
+    }
+
+    return _chain->stages[_chain->count - 1].output_size;
+}
+
+/*
+d_functional_compose_many_free
+  Frees an n-ary composition, its copied stages, and its scratch buffers.
+Does not free any stage context.
+
+Parameter(s):
+  _chain: pointer to the n-ary composition to free; may be NULL.
+Return:
+  none.
+*/
+void
+d_functional_compose_many_free
+(
+    struct d_composed_chain* _chain
+)
+{
+    if (_chain)
+    {
+        // scratch[0] is the base of the shared buffer allocation
+        if (_chain->scratch[0])
+        {
+            d_functional_free(_chain->scratch[0]);
+        }
+
+        if (_chain->stages)
+        {
+            d_functional_free(_chain->stages);
+        }
+
+        d_functional_free(_chain);
     }
 
     return;
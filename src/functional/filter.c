@@ -22,7 +22,7 @@ d_filter_take_first
 {
     struct d_filter_operation* op;
 
-    op = malloc(sizeof(struct d_filter_operation));
+    op = d_functional_malloc(sizeof(struct d_filter_operation));
 
     if (!op)
     {
@@ -53,7 +53,7 @@ d_filter_take_last
 {
     struct d_filter_operation* op;
 
-    op = malloc(sizeof(struct d_filter_operation));
+    op = d_functional_malloc(sizeof(struct d_filter_operation));
 
     if (!op)
     {
@@ -84,7 +84,7 @@ d_filter_take_nth
 {
     struct d_filter_operation* op;
 
-    op = malloc(sizeof(struct d_filter_operation));
+    op = d_functional_malloc(sizeof(struct d_filter_operation));
 
     if (!op)
     {
@@ -115,7 +115,7 @@ d_filter_head
 {
     struct d_filter_operation* op;
 
-    op = malloc(sizeof(struct d_filter_operation));
+    op = d_functional_malloc(sizeof(struct d_filter_operation));
 
     if (!op)
     {
@@ -146,7 +146,7 @@ d_filter_tail
 {
     struct d_filter_operation* op;
 
-    op = malloc(sizeof(struct d_filter_operation));
+    op = d_functional_malloc(sizeof(struct d_filter_operation));
 
     if (!op)
     {
@@ -177,7 +177,7 @@ d_filter_skip_first
 {
     struct d_filter_operation* op;
 
-    op = malloc(sizeof(struct d_filter_operation));
+    op = d_functional_malloc(sizeof(struct d_filter_operation));
 
     if (!op)
     {
@@ -208,7 +208,7 @@ d_filter_skip_last
 {
     struct d_filter_operation* op;
 
-    op = malloc(sizeof(struct d_filter_operation));
+    op = d_functional_malloc(sizeof(struct d_filter_operation));
 
     if (!op)
     {
@@ -239,7 +239,7 @@ d_filter_init
 {
     struct d_filter_operation* op;
 
-    op = malloc(sizeof(struct d_filter_operation));
+    op = d_functional_malloc(sizeof(struct d_filter_operation));
 
     if (!op)
     {
@@ -269,7 +269,7 @@ d_filter_rest
 {
     struct d_filter_operation* op;
 
-    op = malloc(sizeof(struct d_filter_operation));
+    op = d_functional_malloc(sizeof(struct d_filter_operation));
 
     if (!op)
     {
@@ -302,7 +302,7 @@ d_filter_range
 {
     struct d_filter_operation* op;
 
-    op = malloc(sizeof(struct d_filter_operation));
+    op = d_functional_malloc(sizeof(struct d_filter_operation));
 
     if (!op)
     {
@@ -339,7 +339,7 @@ d_filter_slice
 {
     struct d_filter_operation* op;
 
-    op = malloc(sizeof(struct d_filter_operation));
+    op = d_functional_malloc(sizeof(struct d_filter_operation));
 
     if (!op)
     {
@@ -372,7 +372,7 @@ d_filter_where
 {
     struct d_filter_operation* op;
 
-    op = malloc(sizeof(struct d_filter_operation));
+    op = d_functional_malloc(sizeof(struct d_filter_operation));
 
     if (!op)
     {
@@ -407,7 +407,7 @@ d_filter_where_context
 {
     struct d_filter_operation* op;
 
-    op = malloc(sizeof(struct d_filter_operation));
+    op = d_functional_malloc(sizeof(struct d_filter_operation));
 
     if (!op)
     {
@@ -440,7 +440,7 @@ d_filter_where_not
 {
     struct d_filter_operation* op;
 
-    op = malloc(sizeof(struct d_filter_operation));
+    op = d_functional_malloc(sizeof(struct d_filter_operation));
 
     if (!op)
     {
@@ -476,7 +476,7 @@ d_filter_where_not_context
 {
     struct d_filter_operation* op;
 
-    op = malloc(sizeof(struct d_filter_operation));
+    op = d_functional_malloc(sizeof(struct d_filter_operation));
 
     if (!op)
     {
@@ -491,6 +491,47 @@ d_filter_where_not_context
     return op;
 }
 
+/*
+d_filter_where_monotone
+  Creates a filter operation that selects elements matching a predicate
+whose result is monotone over sorted input. When the chain carries a sorted
+hint (d_filter_chain_set_sorted), the matching elements are located with a
+binary search instead of a scan; otherwise the operation behaves like
+d_filter_where_context.
+
+Parameter(s):
+  _test:    the predicate function to test each element.
+  _context: the context pointer passed to the predicate.
+  _shape:   how the predicate changes along the sorted order.
+Return:
+  A d_filter_operation configured for monotone-predicate filtering.
+*/
+struct d_filter_operation*
+d_filter_where_monotone
+(
+    fn_predicate           _test,
+    void*                  _context,
+    enum d_filter_monotone _shape
+)
+{
+    struct d_filter_operation* op;
+
+    op = d_functional_malloc(sizeof(struct d_filter_operation));
+
+    if (!op)
+    {
+        return NULL;
+    }
+
+    memset(op, 0, sizeof(*op));
+    op->type            = D_FILTER_OP_WHERE;
+    op->params.test     = _test;
+    op->params.context  = _context;
+    op->params.monotone = _shape;
+
+    return op;
+}
+
 /*
 d_filter_at
   Creates a filter operation that selects a single element by index.
@@ -508,7 +549,7 @@ d_filter_at
 {
     struct d_filter_operation* op;
 
-    op = malloc(sizeof(struct d_filter_operation));
+    op = d_functional_malloc(sizeof(struct d_filter_operation));
 
     if (!op)
     {
@@ -543,7 +584,7 @@ d_filter_at_indices
 {
     struct d_filter_operation* op;
 
-    op = malloc(sizeof(struct d_filter_operation));
+    op = d_functional_malloc(sizeof(struct d_filter_operation));
 
     if (!op)
     {
@@ -558,7 +599,7 @@ d_filter_at_indices
     if ( (_indices)  &&
          (_count > 0) )
     {
-        op->params.indices = malloc(_count * sizeof(size_t));
+        op->params.indices = d_functional_malloc(_count * sizeof(size_t));
 
         if (op->params.indices)
         {
@@ -589,7 +630,7 @@ d_filter_distinct
 {
     struct d_filter_operation* op;
 
-    op = malloc(sizeof(struct d_filter_operation));
+    op = d_functional_malloc(sizeof(struct d_filter_operation));
 
     // ensure that memory allocation was successful
     if (!op)
@@ -622,7 +663,7 @@ d_filter_reverse
 {
     struct d_filter_operation* op;
 
-    op = malloc(sizeof(struct d_filter_operation));
+    op = d_functional_malloc(sizeof(struct d_filter_operation));
 
     if (!op)
     {
@@ -635,9 +676,91 @@ d_filter_reverse
     return op;
 }
 
+/*
+d_filter_top_k
+  Creates a filter operation that keeps the k greatest elements under a
+comparator, greatest first. Selection uses a bounded heap
+(d_functional_top_k), so it does not sort the whole input.
+
+Parameter(s):
+  _k:          the number of elements to keep.
+  _comparator: the comparator defining the order.
+  _context:    context passed to the comparator; may be NULL.
+Return:
+  A d_filter_operation configured for top-k selection.
+*/
+struct d_filter_operation*
+d_filter_top_k
+(
+    size_t                 _k,
+    fn_function_comparator _comparator,
+    void*                  _context
+)
+{
+    struct d_filter_operation* op;
+
+    op = d_functional_malloc(sizeof(struct d_filter_operation));
+
+    // ensure that memory allocation was successful
+    if (!op)
+    {
+        return NULL;
+    }
+
+    memset(op, 0, sizeof(*op));
+
+    op->type              = D_FILTER_OP_TOP_K;
+    op->params.count      = _k;
+    op->params.comparator = _comparator;
+    op->params.context    = _context;
+
+    return op;
+}
+
+/*
+d_filter_context_retain
+  Internal helper: adds a reference to a context if the global predicate
+registry handed it out; used when an operation or hint is copied.
+*/
+static void
+d_filter_context_retain
+(
+    const void* _context
+)
+{
+    if (_context)
+    {
+        d_predicate_registry_retain(d_predicate_registry_global(), _context);
+    }
+
+    return;
+}
+
+/*
+d_filter_context_release
+  Internal helper: gives back a reference to a context if the global
+predicate registry handed it out.
+*/
+static void
+d_filter_context_release
+(
+    const void* _context
+)
+{
+    if (_context)
+    {
+        d_predicate_registry_release(d_predicate_registry_global(),
+                                     _context);
+    }
+
+    return;
+}
+
 /*
 d_filter_operation_free
-  Frees resources owned by a filter operation.
+  Frees resources owned by a filter operation: its index list and, if the
+predicate registry handed out its context (d_filter_operation_from_string,
+or a context from d_predicate_registry_predicate), its reference to it.
 
 Parameter(s):
   _op: the filter operation to clean up; may be NULL.
@@ -655,6 +778,7 @@ d_filter_operation_free
         return;
     }
 
+    // the name is the caller's, e.g. from d_strdup, not the module's
     if (_op->name)
     {
         free(_op->name);
@@ -663,10 +787,13 @@ d_filter_operation_free
 
     if (_op->params.indices)
     {
-        free(_op->params.indices);
+        d_functional_free(_op->params.indices);
         _op->params.indices = NULL;
     }
 
+    d_filter_context_release(_op->params.context);
+    _op->params.context = NULL;
+
     return;
 }
 
@@ -693,7 +820,7 @@ d_filter_chain_new
 {
     struct d_filter_chain* chain;
 
-    chain = malloc(sizeof(struct d_filter_chain));
+    chain = d_functional_malloc(sizeof(struct d_filter_chain));
 
     if (!chain)
     {
@@ -704,6 +831,8 @@ d_filter_chain_new
     chain->count           = 0;
     chain->capacity        = 0;
     chain->owns_operations = true;
+    chain->sorted_by       = NULL;
+    chain->sorted_context  = NULL;
 
     return chain;
 }
@@ -726,7 +855,7 @@ d_filter_chain_new_with_capacity
 {
     struct d_filter_chain* chain;
 
-    chain = malloc(sizeof(struct d_filter_chain));
+    chain = d_functional_malloc(sizeof(struct d_filter_chain));
 
     if (!chain)
     {
@@ -737,15 +866,17 @@ d_filter_chain_new_with_capacity
     chain->count           = 0;
     chain->capacity        = 0;
     chain->owns_operations = true;
+    chain->sorted_by       = NULL;
+    chain->sorted_context  = NULL;
 
     if (_capacity > 0)
     {
-        chain->operations = malloc(_capacity * 
-                                   sizeof(struct d_filter_operation));
+        chain->operations = d_functional_malloc(
+            _capacity * sizeof(struct d_filter_operation));
 
         if (!chain->operations)
         {
-            free(chain);
+            d_functional_free(chain);
 
             return NULL;
         }
@@ -756,6 +887,29 @@ d_filter_chain_new_with_capacity
     return chain;
 }
 
+/*
+d_filter_chain_retain_contexts
+  Internal helper: adds a reference to every registry context a chain's
+operations and sorted hint use, for a chain copied from another.
+*/
+static void
+d_filter_chain_retain_contexts
+(
+    const struct d_filter_chain* _chain
+)
+{
+    size_t i;
+
+    for (i = 0; i < _chain->count; i++)
+    {
+        d_filter_context_retain(_chain->operations[i].params.context);
+    }
+
+    d_filter_context_retain(_chain->sorted_context);
+
+    return;
+}
+
 /*
 d_filter_chain_clone
   Creates a deep copy of a filter chain.
@@ -794,6 +948,11 @@ d_filter_chain_clone
         clone->count = _chain->count;
     }
 
+    clone->sorted_by      = _chain->sorted_by;
+    clone->sorted_context = _chain->sorted_context;
+
+    d_filter_chain_retain_contexts(clone);
+
     return clone;
 }
 
@@ -808,7 +967,8 @@ Parameter(s):
 Return:
   A boolean value corresponding to either:
   - true, if the operation was added successfully, or
-  - false, if either parameter is NULL or allocation fails.
+  - false, if either parameter is NULL, allocation fails, or the chain is
+    full and does not own its operations.
 */
 bool
 d_filter_chain_add
@@ -826,13 +986,18 @@ d_filter_chain_add
         return false;
     }
 
-    // grow capacity if needed
+    // grow capacity if needed; borrowed operations cannot grow
     if (_chain->count >= _chain->capacity)
     {
+        if (!_chain->owns_operations)
+        {
+            return false;
+        }
+
         new_capacity = (_chain->capacity == 0)
                        ? 4
                        : (_chain->capacity * 2);
-        new_ops = (struct d_filter_operation*)realloc(
+        new_ops = (struct d_filter_operation*)d_functional_realloc(
                       _chain->operations,
                       new_capacity
                       * sizeof(struct d_filter_operation));
@@ -1047,7 +1212,11 @@ d_filter_chain_concat
                _second->count * sizeof(struct d_filter_operation));
     }
 
-    result->count = total;
+    result->count          = total;
+    result->sorted_by      = _first->sorted_by;
+    result->sorted_context = _first->sorted_context;
+
+    d_filter_chain_retain_contexts(result);
 
     return result;
 }
@@ -1083,6 +1252,9 @@ d_filter_chain_append
         {
             return false;
         }
+
+        // both chains now hold the operation's context
+        d_filter_context_retain(_source->operations[i].params.context);
     }
 
     return true;
@@ -1117,13 +1289,18 @@ d_filter_chain_insert
         return false;
     }
 
-    // grow capacity if needed
+    // grow capacity if needed; borrowed operations cannot grow
     if (_chain->count >= _chain->capacity)
     {
+        if (!_chain->owns_operations)
+        {
+            return false;
+        }
+
         new_capacity = (_chain->capacity == 0)
                        ? 4
                        : (_chain->capacity * 2);
-        new_ops = (struct d_filter_operation*)realloc(
+        new_ops = (struct d_filter_operation*)d_functional_realloc(
                       _chain->operations,
                       new_capacity
                       * sizeof(struct d_filter_operation));
@@ -1268,9 +1445,91 @@ d_filter_chain_is_empty
     return (_chain->count == 0);
 }
 
+/*
+d_filter_chain_set_sorted
+  Records that inputs to the chain are sorted ascending under a
+comparator. WHERE operations created with d_filter_where_monotone are then
+applied with a binary search until an operation that reorders elements
+(reverse, indices, top-k) is reached. The hint is trusted, not verified.
+
+Parameter(s):
+  _chain:      the chain to annotate.
+  _comparator: the order of the input, or NULL to clear the hint.
+  _context:    the context the order's comparator is called with.
+Return:
+  A boolean value corresponding to either:
+  - true, if the hint was recorded, or
+  - false, if _chain is NULL.
+*/
+bool
+d_filter_chain_set_sorted
+(
+    struct d_filter_chain* _chain,
+    fn_function_comparator _comparator,
+    void*                  _context
+)
+{
+    if (!_chain)
+    {
+        return false;
+    }
+
+    _context = (_comparator) ? _context : NULL;
+
+    // a hint parsed from text held its context
+    if (_chain->sorted_context != _context)
+    {
+        d_filter_context_release(_chain->sorted_context);
+    }
+
+    _chain->sorted_by      = _comparator;
+    _chain->sorted_context = _context;
+
+    return true;
+}
+
+/*
+d_filter_chain_release
+  Gives back the predicate registry contexts a chain holds, without freeing
+anything else. Chains laid out in memory they do not own
+(d_filter_chain_parse_in, d_filter_chain_decode_into) must be released
+before their arena is reset or their buffer reused; d_filter_chain_free
+does this itself. The chain's predicates must not be called afterwards.
+
+Parameter(s):
+  _chain: the chain; may be NULL.
+Return:
+  none.
+*/
+void
+d_filter_chain_release
+(
+    struct d_filter_chain* _chain
+)
+{
+    size_t i;
+
+    if (!_chain)
+    {
+        return;
+    }
+
+    for (i = 0; i < _chain->count; i++)
+    {
+        d_filter_context_release(_chain->operations[i].params.context);
+        _chain->operations[i].params.context = NULL;
+    }
+
+    d_filter_context_release(_chain->sorted_context);
+    _chain->sorted_context = NULL;
+
+    return;
+}
+
 /*
 d_filter_chain_free
-  Frees a filter chain and all owned operations.
+  Frees a filter chain and all owned operations. A chain that does not own
+its operations (from d_filter_chain_decode) is freed as a single block.
 
 Parameter(s):
   _chain: the filter chain to free; may be NULL.
@@ -1290,17 +1549,24 @@ d_filter_chain_free
         return;
     }
 
-    if (_chain->operations)
+    // a decoded chain is one block (d_filter_chain_decode)
+    if ( (_chain->operations) &&
+         (_chain->owns_operations) )
     {
         for (i = 0; i < _chain->count; i++)
         {
             d_filter_operation_free(&_chain->operations[i]);
         }
 
-        free(_chain->operations);
+        d_functional_free(_chain->operations);
+    }
+    else
+    {
+        d_filter_chain_release(_chain);
     }
 
-    free(_chain);
+    d_filter_context_release(_chain->sorted_context);
+    d_functional_free(_chain);
 
     return;
 }
@@ -1363,7 +1629,7 @@ d_filter_apply_operation_internal
         n = (_op->params.count < _count)
             ? _op->params.count
             : _count;
-        output = malloc(n * _element_size);
+        output = d_functional_malloc(n * _element_size);
 
         if (output)
         {
@@ -1378,7 +1644,7 @@ d_filter_apply_operation_internal
         n = (_op->params.count < _count)
             ? _op->params.count
             : _count;
-        output = malloc(n * _element_size);
+        output = d_functional_malloc(n * _element_size);
 
         if (output)
         {
@@ -1400,14 +1666,14 @@ d_filter_apply_operation_internal
         if (n >= _count)
         {
             // skip all -> empty result
-            output = malloc(_element_size);
+            output = d_functional_malloc(_element_size);
             *_out_count = 0;
 
             return output;
         }
 
         actual_count = _count - n;
-        output       = malloc(actual_count * _element_size);
+        output       = d_functional_malloc(actual_count * _element_size);
 
         if (output)
         {
@@ -1427,14 +1693,14 @@ d_filter_apply_operation_internal
 
         if (n >= _count)
         {
-            output = malloc(_element_size);
+            output = d_functional_malloc(_element_size);
             *_out_count = 0;
 
             return output;
         }
 
         actual_count = _count - n;
-        output       = malloc(actual_count * _element_size);
+        output       = d_functional_malloc(actual_count * _element_size);
 
         if (output)
         {
@@ -1460,7 +1726,7 @@ d_filter_apply_operation_internal
             actual_count++;
         }
 
-        output = malloc(actual_count * _element_size);
+        output = d_functional_malloc(actual_count * _element_size);
 
         if (!output)
         {
@@ -1488,7 +1754,7 @@ d_filter_apply_operation_internal
 
         if (start >= _count)
         {
-            output = malloc(_element_size);
+            output = d_functional_malloc(_element_size);
             *_out_count = 0;
 
             return output;
@@ -1501,14 +1767,14 @@ d_filter_apply_operation_internal
 
         if (start >= end)
         {
-            output = malloc(_element_size);
+            output = d_functional_malloc(_element_size);
             *_out_count = 0;
 
             return output;
         }
 
         n      = end - start;
-        output = malloc(n * _element_size);
+        output = d_functional_malloc(n * _element_size);
 
         if (output)
         {
@@ -1528,7 +1794,7 @@ d_filter_apply_operation_internal
             return NULL;
         }
 
-        output = malloc(_count * _element_size);
+        output = d_functional_malloc(_count * _element_size);
 
         if (!output)
         {
@@ -1572,13 +1838,13 @@ d_filter_apply_operation_internal
         {
             if (_op->params.start >= _count)
             {
-                output = malloc(_element_size);
+                output = d_functional_malloc(_element_size);
                 *_out_count = 0;
 
                 return output;
             }
 
-            output = malloc(_element_size);
+            output = d_functional_malloc(_element_size);
 
             if (output)
             {
@@ -1596,13 +1862,13 @@ d_filter_apply_operation_internal
         if ( (!_op->params.indices)        ||
              (_op->params.indices_count == 0) )
         {
-            output = malloc(_element_size);
+            output = d_functional_malloc(_element_size);
             *_out_count = 0;
 
             return output;
         }
 
-        output = malloc(
+        output = d_functional_malloc(
             _op->params.indices_count * _element_size);
 
         if (!output)
@@ -1632,7 +1898,7 @@ d_filter_apply_operation_internal
         return output;
 
     case D_FILTER_OP_REVERSE:
-        output = malloc(_count * _element_size);
+        output = d_functional_malloc(_count * _element_size);
 
         if (!output)
         {
@@ -1660,7 +1926,7 @@ d_filter_apply_operation_internal
 
         if (start >= _count)
         {
-            output = malloc(_element_size);
+            output = d_functional_malloc(_element_size);
             *_out_count = 0;
 
             return output;
@@ -1679,7 +1945,7 @@ d_filter_apply_operation_internal
             actual_count++;
         }
 
-        output = malloc(actual_count * _element_size);
+        output = d_functional_malloc(actual_count * _element_size);
 
         if (!output)
         {
@@ -1707,7 +1973,7 @@ d_filter_apply_operation_internal
             return NULL;
         }
 
-        output = malloc(_count * _element_size);
+        output = d_functional_malloc(_count * _element_size);
 
         if (!output)
         {
@@ -1753,9 +2019,42 @@ d_filter_apply_operation_internal
 
         return output;
 
+    case D_FILTER_OP_TOP_K:
+        if (!_op->params.comparator)
+        {
+            return NULL;
+        }
+
+        n = (_op->params.count < _count)
+            ? _op->params.count
+            : _count;
+
+        if (n == 0)
+        {
+            output = d_functional_malloc(_element_size);
+            *_out_count = 0;
+
+            return output;
+        }
+
+        output = d_functional_malloc(n * _element_size);
+
+        if (output)
+        {
+            *_out_count = d_functional_top_k(_input,
+                                             _count,
+                                             _element_size,
+                                             n,
+                                             output,
+                                             _op->params.comparator,
+                                             _op->params.context);
+        }
+
+        return output;
+
     case D_FILTER_OP_NONE:
         // no-op: copy input unchanged
-        output = malloc(_count * _element_size);
+        output = d_functional_malloc(_count * _element_size);
 
         if (output)
         {
@@ -1771,6 +2070,92 @@ d_filter_apply_operation_internal
     }
 }
 
+/*
+d_filter_negated_test
+  Internal fn_predicate negating the predicate of the operation passed as
+context.
+*/
+static bool
+d_filter_negated_test
+(
+    const void* _element,
+    void*       _context
+)
+{
+    const struct d_filter_operation* op;
+
+    op = (const struct d_filter_operation*)_context;
+
+    return !op->params.test(_element, op->params.context);
+}
+
+/*
+d_filter_apply_monotone
+  Internal implementation of a shaped WHERE / WHERE_NOT over sorted input.
+The matching elements form a prefix (FALLING) or suffix (RISING) of the
+input, whose boundary is found with d_functional_partition_point.
+
+Parameter(s):
+  _op:           the WHERE or WHERE_NOT operation with a monotone shape.
+  _input:        the sorted source array.
+  _count:        the number of elements in the input.
+  _element_size: the size in bytes of each element.
+  _out_count:    output parameter for the result count.
+Return:
+  A pointer to a newly allocated array containing the matching range, or
+NULL on failure. Caller is responsible for freeing the result.
+*/
+static void*
+d_filter_apply_monotone
+(
+    const struct d_filter_operation* _op,
+    const void*                      _input,
+    size_t                           _count,
+    size_t                           _element_size,
+    size_t*                          _out_count
+)
+{
+    void*  output;
+    size_t edge;
+    size_t start;
+    size_t end;
+    bool   rising;
+    bool   negate;
+
+    rising = (_op->params.monotone == D_FILTER_MONOTONE_RISING);
+
+    if (_op->type == D_FILTER_OP_WHERE_NOT)
+    {
+        rising = !rising;
+    }
+
+    // the kept range is a prefix when the effective predicate is falling;
+    // partition_point needs a predicate that is true on the prefix
+    negate = (rising != (_op->type == D_FILTER_OP_WHERE_NOT));
+    edge   = d_functional_partition_point(_input,
+                                          _count,
+                                          _element_size,
+                                          (negate) ? d_filter_negated_test
+                                                   : _op->params.test,
+                                          (negate) ? (void*)_op
+                                                   : _op->params.context);
+    start = (rising) ? edge : 0;
+    end   = (rising) ? _count : edge;
+
+    output = d_functional_malloc(((end > start) ? (end - start) : 1) *
+                                 _element_size);
+
+    if (output)
+    {
+        memcpy(output,
+               (const char*)_input + (start * _element_size),
+               (end - start) * _element_size);
+        *_out_count = end - start;
+    }
+
+    return output;
+}
+
 /*
 d_filter_apply_operation
   Applies a single filter operation to an input array and returns a
@@ -1797,7 +2182,7 @@ d_filter_apply_operation
     size_t                  out_count;
     void*                   output;
 
-    result = malloc(sizeof(struct d_filter_result));
+    result = d_functional_malloc(sizeof(struct d_filter_result));
 
     if (!result)
     {
@@ -1834,6 +2219,76 @@ d_filter_apply_operation
     return result;
 }
 
+#if defined(D_FUNCTIONAL_PROFILE)
+
+static const char* d_filter_op_type_name(enum d_filter_op_type _type);
+
+// d_filter_counted_test
+//   struct: a predicate and context wrapped to count its calls.
+struct d_filter_counted_test
+{
+    fn_predicate test;
+    void*        context;
+    size_t       calls;
+};
+
+/*
+d_filter_counted_call
+  Internal helper: predicate standing in for a d_filter_counted_test's
+predicate while a chain is profiled; counts the call and forwards it.
+*/
+static bool
+d_filter_counted_call
+(
+    const void* _element,
+    void*       _context
+)
+{
+    struct d_filter_counted_test* counted;
+
+    counted = (struct d_filter_counted_test*)_context;
+    counted->calls++;
+
+    return counted->test(_element, counted->context);
+}
+
+/*
+d_filter_profile_bytes
+  Internal helper: size of the output buffer an operation allocated. The
+scanning operations allocate for every input row; the others, and
+binary-searched WHEREs, for the rows they produce (at least one).
+*/
+static size_t
+d_filter_profile_bytes
+(
+    const struct d_filter_operation* _op,
+    bool                             _searched,
+    size_t                           _rows_in,
+    size_t                           _rows_out,
+    size_t                           _element_size
+)
+{
+    if (!_searched)
+    {
+        switch (_op->type)
+        {
+        case D_FILTER_OP_WHERE:
+        case D_FILTER_OP_WHERE_NOT:
+        case D_FILTER_OP_REVERSE:
+        case D_FILTER_OP_DISTINCT:
+        case D_FILTER_OP_NONE:
+            return _rows_in * _element_size;
+
+        default:
+            break;
+        }
+    }
+
+    return ((_rows_out > 0) ? _rows_out : 1) * _element_size;
+}
+
+#endif  // D_FUNCTIONAL_PROFILE
+
 /*
 d_filter_apply_chain
   Applies a chain of filter operations sequentially to an input array.
@@ -1856,14 +2311,22 @@ d_filter_apply_chain
     size_t                       _element_size
 )
 {
-    struct d_filter_result* result;
-    size_t                  i;
-    void*                   current_data;
-    size_t                  current_count;
-    void*                   next_data;
-    size_t                  next_count;
-
-    result = malloc(sizeof(struct d_filter_result));
+    struct d_filter_result*          result;
+    const struct d_filter_operation* op;
+    size_t                           i;
+    void*                            current_data;
+    size_t                           current_count;
+    void*                            next_data;
+    size_t                           next_count;
+    bool                             sorted;
+    bool                             searched;
+#if defined(D_FUNCTIONAL_PROFILE)
+    struct d_filter_operation        profiled;
+    struct d_filter_counted_test     counted;
+    uint64_t                         profile_start;
+#endif
+
+    result = d_functional_malloc(sizeof(struct d_filter_result));
 
     if (!result)
     {
@@ -1884,7 +2347,7 @@ d_filter_apply_chain
     // empty chain returns a copy of the input
     if (_chain->count == 0)
     {
-        result->elements = malloc(_count * _element_size);
+        result->elements = d_functional_malloc(_count * _element_size);
 
         if (!result->elements)
         {
@@ -1901,7 +2364,7 @@ d_filter_apply_chain
     }
 
     // copy input for first operation
-    current_data = malloc(_count * _element_size);
+    current_data = d_functional_malloc(_count * _element_size);
 
     if (!current_data)
     {
@@ -1913,16 +2376,76 @@ d_filter_apply_chain
     memcpy(current_data, _input, _count * _element_size);
     current_count = _count;
 
+    sorted = (_chain->sorted_by != NULL);
+
     // apply each operation in sequence
     for (i = 0; i < _chain->count; i++)
     {
-        next_data = d_filter_apply_operation_internal(
-                        &_chain->operations[i],
-                        current_data,
-                        current_count,
-                        _element_size,
-                        &next_count);
-        free(current_data);
+        op = &_chain->operations[i];
+
+#if defined(D_FUNCTIONAL_PROFILE)
+        counted.calls = 0;
+
+        // count the predicate's calls through a stand-in
+        if ( (D_PROFILE_START(profile_start) != 0) &&
+             (op->params.test) )
+        {
+            counted.test            = op->params.test;
+            counted.context         = op->params.context;
+            profiled                = *op;
+            profiled.params.test    = d_filter_counted_call;
+            profiled.params.context = &counted;
+            op                      = &profiled;
+        }
+#endif
+
+        // shaped predicates over sorted input are binary-searched
+        searched = (sorted)                                        &&
+                   ( (op->type == D_FILTER_OP_WHERE) ||
+                     (op->type == D_FILTER_OP_WHERE_NOT) )         &&
+                   (op->params.test)                               &&
+                   (op->params.monotone != D_FILTER_MONOTONE_NONE);
+
+        if (searched)
+        {
+            next_count = 0;
+            next_data  = d_filter_apply_monotone(op,
+                                                 current_data,
+                                                 current_count,
+                                                 _element_size,
+                                                 &next_count);
+        }
+        else
+        {
+            next_data = d_filter_apply_operation_internal(
+                            op,
+                            current_data,
+                            current_count,
+                            _element_size,
+                            &next_count);
+        }
+
+        D_PROFILE_STOP(profile_start, "filter",
+                       d_filter_op_type_name(op->type), i,
+                       current_count,
+                       (next_data) ? next_count : 0,
+                       (next_data)
+                           ? d_filter_profile_bytes(op, searched,
+                                                    current_count,
+                                                    next_count,
+                                                    _element_size)
+                           : 0,
+                       counted.calls);
+
+        // these operations no longer preserve the input order
+        if ( (op->type == D_FILTER_OP_REVERSE) ||
+             (op->type == D_FILTER_OP_INDICES) ||
+             (op->type == D_FILTER_OP_TOP_K) )
+        {
+            sorted = false;
+        }
+
+        d_functional_free(current_data);
 
         if (!next_data)
         {
@@ -1988,7 +2511,7 @@ d_filter_apply_in_place
         result->status != D_FILTER_RESULT_EMPTY)
     {
         d_filter_result_free(result);
-        free(result);
+        d_functional_free(result);
 
         return 0;
     }
@@ -2002,7 +2525,7 @@ d_filter_apply_in_place
     }
 
     d_filter_result_free(result);
-    free(result);
+    d_functional_free(result);
 
     return new_count;
 }
@@ -2109,7 +2632,7 @@ d_filter_chain_matches_element
          (result->status != D_FILTER_RESULT_EMPTY) )
     {
         d_filter_result_free(result);
-        free(result);
+        d_functional_free(result);
 
         return false;
     }
@@ -2117,7 +2640,7 @@ d_filter_chain_matches_element
     matches = (result->count == 1);
 
     d_filter_result_free(result);
-    free(result);
+    d_functional_free(result);
 
     return matches;
 }
@@ -2144,19 +2667,19 @@ d_filter_result_free
 
     if (_result->elements)
     {
-        free(_result->elements);
+        d_functional_free(_result->elements);
         _result->elements = NULL;
     }
 
     if (_result->indices)
     {
-        free(_result->indices);
+        d_functional_free(_result->indices);
         _result->indices = NULL;
     }
 
     if (_result->error_message)
     {
-        free(_result->error_message);
+        d_functional_free(_result->error_message);
         _result->error_message = NULL;
     }
 
@@ -2188,7 +2711,7 @@ d_filter_union_new
 {
     struct d_filter_union* u;
 
-    u = malloc(sizeof(struct d_filter_union));
+    u = d_functional_malloc(sizeof(struct d_filter_union));
 
     if (!u)
     {
@@ -2201,12 +2724,12 @@ d_filter_union_new
 
     if (_capacity > 0)
     {
-        u->filters = malloc(_capacity * 
-                            sizeof(struct d_filter_chain*));
+        u->filters = d_functional_malloc(_capacity * 
+                                         sizeof(struct d_filter_chain*));
 
         if (!u->filters)
         {
-            free(u);
+            d_functional_free(u);
 
             return NULL;
         }
@@ -2234,7 +2757,7 @@ d_filter_intersection_new
 {
     struct d_filter_intersection* inter;
 
-    inter = malloc(sizeof(struct d_filter_intersection));
+    inter = d_functional_malloc(sizeof(struct d_filter_intersection));
 
     if (!inter)
     {
@@ -2247,11 +2770,12 @@ d_filter_intersection_new
 
     if (_capacity > 0)
     {
-        inter->filters = malloc(_capacity * sizeof(struct d_filter_chain*));
+        inter->filters = d_functional_malloc(_capacity *
+                                             sizeof(struct d_filter_chain*));
 
         if (!inter->filters)
         {
-            free(inter);
+            d_functional_free(inter);
 
             return NULL;
         }
@@ -2280,7 +2804,7 @@ d_filter_difference_new
 {
     struct d_filter_difference* diff;
 
-    diff = malloc(sizeof(struct d_filter_difference));
+    diff = d_functional_malloc(sizeof(struct d_filter_difference));
 
     if (!diff)
     {
@@ -2376,10 +2900,10 @@ d_filter_union_free
 
     if (_union->filters)
     {
-        free(_union->filters);
+        d_functional_free(_union->filters);
     }
 
-    free(_union);
+    d_functional_free(_union);
 
     return;
 }
@@ -2407,10 +2931,10 @@ d_filter_intersection_free
 
     if (_intersection->filters)
     {
-        free(_intersection->filters);
+        d_functional_free(_intersection->filters);
     }
 
-    free(_intersection);
+    d_functional_free(_intersection);
 
     return;
 }
@@ -2436,7 +2960,7 @@ d_filter_difference_free
         return;
     }
 
-    free(_difference);
+    d_functional_free(_difference);
 
     return;
 }
@@ -2480,7 +3004,7 @@ d_filter_apply_union
     const char*             in_bytes;
     const char*             res_bytes;
 
-    result = malloc(sizeof(struct d_filter_result));
+    result = d_functional_malloc(sizeof(struct d_filter_result));
 
     if (!result)
     {
@@ -2498,7 +3022,7 @@ d_filter_apply_union
         return result;
     }
 
-    included = (bool*)calloc(_count, sizeof(bool));
+    included = (bool*)d_functional_calloc(_count, sizeof(bool));
 
     if (!included)
     {
@@ -2521,7 +3045,7 @@ d_filter_apply_union
               sub_result->status != D_FILTER_RESULT_EMPTY) )
         {
             d_filter_result_free(sub_result);
-            free(sub_result);
+            d_functional_free(sub_result);
 
             continue;
         }
@@ -2547,7 +3071,7 @@ d_filter_apply_union
         }
 
         d_filter_result_free(sub_result);
-        free(sub_result);
+        d_functional_free(sub_result);
     }
 
     // count and build result
@@ -2563,18 +3087,18 @@ d_filter_apply_union
 
     if (out_count == 0)
     {
-        free(included);
+        d_functional_free(included);
         result->status = D_FILTER_RESULT_EMPTY;
-        result->elements = malloc(_element_size);
+        result->elements = d_functional_malloc(_element_size);
 
         return result;
     }
 
-    result->elements = malloc(out_count * _element_size);
+    result->elements = d_functional_malloc(out_count * _element_size);
 
     if (!result->elements)
     {
-        free(included);
+        d_functional_free(included);
         result->status = D_FILTER_RESULT_NO_MEMORY;
 
         return result;
@@ -2597,7 +3121,7 @@ d_filter_apply_union
     result->count  = out_count;
     result->status = D_FILTER_RESULT_SUCCESS;
 
-    free(included);
+    d_functional_free(included);
 
     return result;
 }
@@ -2631,7 +3155,7 @@ d_filter_apply_intersection
     size_t                  current_count;
     size_t                  i;
 
-    result = malloc(sizeof(struct d_filter_result));
+    result = d_functional_malloc(sizeof(struct d_filter_result));
 
     if (!result)
     {
@@ -2650,7 +3174,7 @@ d_filter_apply_intersection
     }
 
     // start with a copy of the input
-    current_data = malloc(_count * _element_size);
+    current_data = d_functional_malloc(_count * _element_size);
 
     if (!current_data)
     {
@@ -2670,14 +3194,14 @@ d_filter_apply_intersection
                          current_data,
                          current_count,
                          _element_size);
-        free(current_data);
+        d_functional_free(current_data);
 
         if ( (!sub_result) ||
              (sub_result->status != D_FILTER_RESULT_SUCCESS &&
               sub_result->status != D_FILTER_RESULT_EMPTY) )
         {
             d_filter_result_free(sub_result);
-            free(sub_result);
+            d_functional_free(sub_result);
             result->status = D_FILTER_RESULT_ERROR;
 
             return result;
@@ -2690,7 +3214,7 @@ d_filter_apply_intersection
         sub_result->elements = NULL;
         sub_result->count    = 0;
         d_filter_result_free(sub_result);
-        free(sub_result);
+        d_functional_free(sub_result);
 
         // early exit if empty
         if (current_count == 0)
@@ -2742,7 +3266,7 @@ d_filter_apply_difference
     const char*             exc_bytes;
     bool                    excluded;
 
-    result = malloc(sizeof(struct d_filter_result));
+    result = d_functional_malloc(sizeof(struct d_filter_result));
 
     if (!result)
     {
@@ -2771,7 +3295,7 @@ d_filter_apply_difference
           (include_result->status != D_FILTER_RESULT_EMPTY)) )
     {
         d_filter_result_free(include_result);
-        free(include_result);
+        d_functional_free(include_result);
         result->status = D_FILTER_RESULT_ERROR;
 
         return result;
@@ -2783,7 +3307,7 @@ d_filter_apply_difference
         result->elements = include_result->elements;
         include_result->elements = NULL;
         d_filter_result_free(include_result);
-        free(include_result);
+        d_functional_free(include_result);
 
         return result;
     }
@@ -2800,7 +3324,7 @@ d_filter_apply_difference
     {
         // exclude failed — return include result as-is
         d_filter_result_free(exclude_result);
-        free(exclude_result);
+        d_functional_free(exclude_result);
 
         // transfer include_result contents to result
         result->elements = include_result->elements;
@@ -2808,21 +3332,21 @@ d_filter_apply_difference
         result->status   = include_result->status;
         include_result->elements = NULL;
         d_filter_result_free(include_result);
-        free(include_result);
+        d_functional_free(include_result);
 
         return result;
     }
 
     // subtract: keep include elements not in exclude
-    result->elements = malloc(
+    result->elements = d_functional_malloc(
         include_result->count * _element_size);
 
     if (!result->elements)
     {
         d_filter_result_free(include_result);
-        free(include_result);
+        d_functional_free(include_result);
         d_filter_result_free(exclude_result);
-        free(exclude_result);
+        d_functional_free(exclude_result);
         result->status = D_FILTER_RESULT_NO_MEMORY;
 
         return result;
@@ -2860,9 +3384,9 @@ d_filter_apply_difference
     }
 
     d_filter_result_free(include_result);
-    free(include_result);
+    d_functional_free(include_result);
     d_filter_result_free(exclude_result);
-    free(exclude_result);
+    d_functional_free(exclude_result);
 
     result->count  = out_count;
     result->status = (out_count == 0)
@@ -2911,7 +3435,7 @@ d_filter_count_matches
           (result->status != D_FILTER_RESULT_EMPTY)) )
     {
         d_filter_result_free(result);
-        free(result);
+        d_functional_free(result);
 
         return 0;
     }
@@ -2919,7 +3443,7 @@ d_filter_count_matches
     match_count = result->count;
 
     d_filter_result_free(result);
-    free(result);
+    d_functional_free(result);
 
     return match_count;
 }
@@ -3054,7 +3578,7 @@ d_filter_get_indices
           result->status != D_FILTER_RESULT_EMPTY) )
     {
         d_filter_result_free(result);
-        free(result);
+        d_functional_free(result);
 
         return NULL;
     }
@@ -3062,22 +3586,22 @@ d_filter_get_indices
     if (result->count == 0)
     {
         d_filter_result_free(result);
-        free(result);
+        d_functional_free(result);
 
         return NULL;
     }
 
-    indices = malloc(result->count * sizeof(size_t));
-    used    = calloc(_count, sizeof(bool));
+    indices = d_functional_malloc(result->count * sizeof(size_t));
+    used    = d_functional_calloc(_count, sizeof(bool));
 
     if ( (!indices) ||
          (!used) )
     {
-        free(indices);
-        free(used);
+        d_functional_free(indices);
+        d_functional_free(used);
 
         d_filter_result_free(result);
-        free(result);
+        d_functional_free(result);
 
         return NULL;
     }
@@ -3104,9 +3628,9 @@ d_filter_get_indices
         }
     }
 
-    free(used);
+    d_functional_free(used);
     d_filter_result_free(result);
-    free(result);
+    d_functional_free(result);
 
     *(_out_count) = idx_count;
 
@@ -3139,7 +3663,7 @@ d_filter_operation_is_valid
     }
 
     if ( (_op->type < D_FILTER_OP_NONE) ||
-         (_op->type > D_FILTER_OP_REST) )
+         (_op->type > D_FILTER_OP_TOP_K) )
     {
         return false;
     }
@@ -3152,8 +3676,17 @@ d_filter_operation_is_valid
         return false;
     }
 
-    // validate distinct has a comparator
-    if ( (_op->type == D_FILTER_OP_DISTINCT) &&
+    // validate the predicate shape
+    if ( (_op->params.monotone != D_FILTER_MONOTONE_NONE)    &&
+         (_op->params.monotone != D_FILTER_MONOTONE_RISING)  &&
+         (_op->params.monotone != D_FILTER_MONOTONE_FALLING) )
+    {
+        return false;
+    }
+
+    // validate distinct and top-k have a comparator
+    if ( (_op->type == D_FILTER_OP_DISTINCT ||
+          _op->type == D_FILTER_OP_TOP_K)     &&
          (!_op->params.comparator) )
     {
         return false;
@@ -3230,50 +3763,145 @@ d_filter_op_type_name
     case D_FILTER_OP_TAIL:       return "tail";
     case D_FILTER_OP_INIT:       return "init";
     case D_FILTER_OP_REST:       return "rest";
+    case D_FILTER_OP_TOP_K:      return "top_k";
     default:                     return "unknown";
     }
 }
 
 /*
-d_filter_operation_to_string
-  Creates a human-readable string description of a filter operation.
-
-Parameter(s):
-  _op: the operation to describe.
-Return:
-  A newly allocated string, or NULL on failure. Caller must free.
+d_filter_operation_format
+  Internal helper: formats an operation for d_filter_operation_to_string
+(_canonical false) or d_filter_chain_canonical (_canonical true).
+Predicates and comparators are written by their names in the global
+registry (predicate_registry.h). An unregistered one is written as its
+address, which cannot be parsed back, and fails the canonical form. The
+canonical form also writes head, tail, init, and rest as the take or skip
+they stand for.
 */
-char*
-d_filter_operation_to_string
+static char*
+d_filter_operation_format
 (
-    const struct d_filter_operation* _op
+    const struct d_filter_operation* _op,
+    bool                             _canonical
 )
 {
-    char*  buffer;
-    size_t buf_size;
-
-    if (!_op)
+    struct d_predicate_registry* registry;
+    enum d_filter_op_type        type;
+    const char*                  label;
+    char*                        buffer;
+    char                         name[D_REGISTRY_MAX_NAME +
+                                      (D_REGISTRY_MAX_PARAMS * 32)];
+    size_t                       buf_size;
+    size_t                       offset;
+    size_t                       named;
+    size_t                       count;
+    size_t                       i;
+
+    registry = d_predicate_registry_global();
+    named    = 0;
+    name[0]  = '\0';
+
+    // name the predicate or comparator, if registered
+    if ( (_op->type == D_FILTER_OP_WHERE) ||
+         (_op->type == D_FILTER_OP_WHERE_NOT) )
+    {
+        named = d_predicate_registry_format_predicate(registry,
+                                                      _op->params.test,
+                                                      _op->params.context,
+                                                      name,
+                                                      sizeof(name));
+    }
+    else if ( (_op->type == D_FILTER_OP_DISTINCT) ||
+              (_op->type == D_FILTER_OP_TOP_K) )
+    {
+        named = d_predicate_registry_format_comparator(registry,
+                                                       _op->params.comparator,
+                                                       _op->params.context,
+                                                       name,
+                                                       sizeof(name));
+    }
+
+    if (named >= sizeof(name))
+    {
+        named = 0;
+    }
+
+    if ( (_canonical) &&
+         (named == 0) &&
+         ( (_op->type == D_FILTER_OP_WHERE)     ||
+           (_op->type == D_FILTER_OP_WHERE_NOT) ||
+           (_op->type == D_FILTER_OP_DISTINCT)  ||
+           (_op->type == D_FILTER_OP_TOP_K) ) )
     {
         return NULL;
     }
 
-    buf_size = 128;
-    buffer   = malloc(buf_size);
+    buf_size = 64 + sizeof(name) + (_op->params.indices_count * 24);
+    buffer   = d_functional_malloc(buf_size);
 
     if (!buffer)
     {
         return NULL;
     }
 
-    switch (_op->type)
+    type  = _op->type;
+    count = _op->params.count;
+
+    // aliases take their general form
+    if (_canonical)
+    {
+        switch (type)
+        {
+        case D_FILTER_OP_HEAD:
+            type = D_FILTER_OP_TAKE_FIRST;
+
+            break;
+
+        case D_FILTER_OP_TAIL:
+            type = D_FILTER_OP_TAKE_LAST;
+
+            break;
+
+        case D_FILTER_OP_INIT:
+            type  = D_FILTER_OP_SKIP_LAST;
+            count = 1;
+
+            break;
+
+        case D_FILTER_OP_REST:
+            type  = D_FILTER_OP_SKIP_FIRST;
+            count = 1;
+
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    switch (type)
     {
     case D_FILTER_OP_TAKE_FIRST:
     case D_FILTER_OP_TAKE_LAST:
     case D_FILTER_OP_SKIP_FIRST:
     case D_FILTER_OP_SKIP_LAST:
         snprintf(buffer, buf_size, "%s(%zu)",
-                 d_filter_op_type_name(_op->type),
-                 _op->params.count);
+                 d_filter_op_type_name(type),
+                 count);
+
+        break;
+
+    case D_FILTER_OP_TOP_K:
+        if (named > 0)
+        {
+            snprintf(buffer, buf_size, "top_k(%zu, %s)",
+                     count, name);
+        }
+        else
+        {
+            snprintf(buffer, buf_size, "top_k(%zu)",
+                     count);
+        }
 
         break;
 
@@ -3297,26 +3925,61 @@ d_filter_operation_to_string
         break;
 
     case D_FILTER_OP_WHERE:
-        snprintf(buffer, buf_size, "where(%p)",
-                 (const void*)_op->params.test);
+    case D_FILTER_OP_WHERE_NOT:
+        label = (type == D_FILTER_OP_WHERE_NOT)
+            ? "where_not"
+            : (_op->params.monotone == D_FILTER_MONOTONE_RISING)
+                ? "where_rising"
+                : (_op->params.monotone == D_FILTER_MONOTONE_FALLING)
+                    ? "where_falling"
+                    : "where";
+
+        if (named > 0)
+        {
+            snprintf(buffer, buf_size, "%s(%s)", label, name);
+        }
+        else
+        {
+            snprintf(buffer, buf_size, "%s(%p)", label,
+                     (const void*)_op->params.test);
+        }
 
         break;
 
-    case D_FILTER_OP_WHERE_NOT:
-        snprintf(buffer, buf_size, "where_not(%p)",
-                 (const void*)_op->params.test);
+    case D_FILTER_OP_DISTINCT:
+        snprintf(buffer, buf_size, (named > 0) ? "distinct(%s)" : "distinct",
+                 name);
 
         break;
 
     case D_FILTER_OP_INDICES:
-        snprintf(buffer, buf_size, "indices(%zu)",
-                 _op->params.indices_count);
+        // a single index from d_filter_at has no list
+        if (!_op->params.indices)
+        {
+            snprintf(buffer, buf_size,
+                     (_canonical) ? "at_indices(%zu)" : "at(%zu)",
+                     _op->params.start);
+
+            break;
+        }
+
+        offset = (size_t)snprintf(buffer, buf_size, "at_indices(");
+
+        for (i = 0; i < _op->params.indices_count; i++)
+        {
+            offset += (size_t)snprintf(buffer + offset,
+                                       buf_size - offset,
+                                       (i > 0) ? ", %zu" : "%zu",
+                                       _op->params.indices[i]);
+        }
+
+        snprintf(buffer + offset, buf_size - offset, ")");
 
         break;
 
     default:
         snprintf(buffer, buf_size, "%s",
-                 d_filter_op_type_name(_op->type));
+                 d_filter_op_type_name(type));
 
         break;
     }
@@ -3325,48 +3988,79 @@ d_filter_operation_to_string
 }
 
 /*
-d_filter_chain_to_string
-  Creates a human-readable string description of a filter chain.
-Operations are separated by " -> ".
-
-Parameter(s):
-  _chain: the chain to describe.
-Return:
-  A newly allocated string, or NULL on failure. Caller must free.
+d_filter_text_append
+  Internal helper: appends _length characters of _text to a growable,
+terminated string.
 */
-char*
-d_filter_chain_to_string
+static bool
+d_filter_text_append
 (
-    const struct d_filter_chain* _chain
+    char**      _buffer,
+    size_t*     _used,
+    size_t*     _capacity,
+    const char* _text,
+    size_t      _length
 )
 {
-    char*  buffer;
-    size_t buf_size;
-    size_t offset;
-    size_t i;
-    char*  op_str;
-    size_t op_len;
+    char*  grown;
+    size_t capacity;
 
-    if (!_chain)
+    if (*_used + _length + 1 > *_capacity)
     {
-        return NULL;
-    }
+        capacity = *_capacity * 2;
 
-    if (_chain->count == 0)
-    {
-        buffer = malloc(8);
+        while (*_used + _length + 1 > capacity)
+        {
+            capacity *= 2;
+        }
 
-        if (buffer)
+        grown = d_functional_realloc(*_buffer, capacity);
+
+        // ensure that memory allocation was successful
+        if (!grown)
         {
-            snprintf(buffer, 8, "(empty)");
+            return false;
         }
 
-        return buffer;
+        *_buffer   = grown;
+        *_capacity = capacity;
     }
 
-    // allocate a generous buffer
-    buf_size = _chain->count * 64;
-    buffer   = malloc(buf_size);
+    memcpy(*_buffer + *_used, _text, _length);
+    *_used             += _length;
+    (*_buffer)[*_used]  = '\0';
+
+    return true;
+}
+
+/*
+d_filter_chain_format
+  Internal helper: formats a chain for d_filter_chain_to_string or
+d_filter_chain_canonical, joining the operations with _separator. A sorted
+hint is written first, as "sorted(comparator)". The canonical form leaves
+out no-op operations.
+*/
+static char*
+d_filter_chain_format
+(
+    const struct d_filter_chain* _chain,
+    const char*                  _separator,
+    bool                         _canonical
+)
+{
+    char*  buffer;
+    char*  op_str;
+    char   name[D_REGISTRY_MAX_NAME + (D_REGISTRY_MAX_PARAMS * 32)];
+    char   hint[sizeof(name) + 16];
+    size_t used;
+    size_t capacity;
+    size_t named;
+    size_t i;
+    bool   ok;
+
+    capacity = 64;
+    used     = 0;
+    buffer   = d_functional_malloc(capacity);
 
     if (!buffer)
     {
@@ -3374,637 +4068,3917 @@ d_filter_chain_to_string
     }
 
     buffer[0] = '\0';
-    offset    = 0;
+    ok        = true;
 
-    for (i = 0; i < _chain->count; i++)
+    // the order hint changes how the chain runs, so it is part of the text
+    if (_chain->sorted_by)
     {
-        if (i > 0)
+        named = d_predicate_registry_format_comparator(
+                    d_predicate_registry_global(),
+                    _chain->sorted_by,
+                    _chain->sorted_context,
+                    name,
+                    sizeof(name));
+
+        if ( (named > 0) &&
+             (named < sizeof(name)) )
+        {
+            snprintf(hint, sizeof(hint), "sorted(%s)", name);
+        }
+        else
         {
-            op_len = strlen(" -> ");
+            snprintf(hint, sizeof(hint), "sorted(%p)",
+                     (const void*)_chain->sorted_by);
+            ok = !_canonical;
+        }
 
-            if (offset + op_len < buf_size)
-            {
-                memcpy(buffer + offset, " -> ", op_len);
-                offset += op_len;
-                buffer[offset] = '\0';
-            }
+        ok = ok && d_filter_text_append(&buffer, &used, &capacity,
+                                        hint, strlen(hint));
+    }
+
+    for (i = 0; (ok) && (i < _chain->count); i++)
+    {
+        if ( (_canonical) &&
+             (_chain->operations[i].type == D_FILTER_OP_NONE) )
+        {
+            continue;
         }
 
-        op_str = d_filter_operation_to_string(
-                     &_chain->operations[i]);
+        op_str = d_filter_operation_format(&_chain->operations[i],
+                                           _canonical);
 
-        if (op_str)
+        if (!op_str)
         {
-            op_len = strlen(op_str);
+            ok = false;
 
-            if (offset + op_len < buf_size)
-            {
-                memcpy(buffer + offset, op_str, op_len);
-                offset += op_len;
-                buffer[offset] = '\0';
-            }
+            break;
+        }
 
-            free(op_str);
+        if (used > 0)
+        {
+            ok = d_filter_text_append(&buffer, &used, &capacity,
+                                      _separator, strlen(_separator));
         }
+
+        ok = ok && d_filter_text_append(&buffer, &used, &capacity,
+                                        op_str, strlen(op_str));
+
+        d_functional_free(op_str);
+    }
+
+    if (!ok)
+    {
+        d_functional_free(buffer);
+
+        return NULL;
     }
 
     return buffer;
 }
 
 /*
-d_filter_operation_from_string
-  Parses a string into a filter operation. Supports basic formats:
-  "take_first(N)", "take_last(N)", "skip_first(N)", "skip_last(N)",
-  "range(S, E)", "head", "tail", "init", "rest", "reverse".
+d_filter_operation_to_string
+  Creates a string description of a filter operation, in the form read by
+d_filter_operation_from_string. Predicates and comparators are written by
+their names in the global registry, e.g. "where(gt_i32, 100)" or
+"top_k(5, desc_i32)"; an unregistered one is written as its address, and
+such an operation does not parse back.
 
 Parameter(s):
-  _str: the string to parse.
+  _op: the operation to describe.
 Return:
-  A pointer to a newly allocated operation, or NULL on failure.
+  A newly allocated string, or NULL on failure. Caller must free.
 */
-struct d_filter_operation*
-d_filter_operation_from_string
+char*
+d_filter_operation_to_string
 (
-    const char* _str
+    const struct d_filter_operation* _op
 )
 {
-    struct d_filter_operation* op;
-    size_t                    n;
-    size_t                    s;
-    size_t                    e;
-    size_t                    step;
-
-    if (!_str)
+    if (!_op)
     {
         return NULL;
     }
 
-    op = malloc(sizeof(struct d_filter_operation));
+    return d_filter_operation_format(_op, false);
+}
 
-    // ensure that memory allocation was successful
-    if (!op)
-    {
-        return NULL;
-    }
+/*
+d_filter_chain_to_string
+  Creates a string description of a filter chain, in the form read by
+d_filter_chain_from_string. Operations are separated by " -> ", preceded
+by "sorted(comparator)" if the chain has a sorted hint.
 
-    memset(op, 0, sizeof(*op));
+Parameter(s):
+  _chain: the chain to describe.
+Return:
+  A newly allocated string, or NULL on failure. Caller must free.
+*/
+char*
+d_filter_chain_to_string
+(
+    const struct d_filter_chain* _chain
+)
+{
+    char* buffer;
 
-    // parse known formats
-    if (d_sscanf_s(_str, "take_first(%zu)", &n) == 1)
+    if (!_chain)
     {
-        op = d_filter_take_first(n);
-
-        return op;
+        return NULL;
     }
 
-    if (d_sscanf_s(_str, "take_last(%zu)", &n) == 1)
+    if ( (_chain->count == 0) &&
+         (!_chain->sorted_by) )
     {
-        op = d_filter_take_last(n);
-
-        return op;
-    }
+        buffer = d_functional_malloc(8);
 
-    if (d_sscanf_s(_str, "skip_first(%zu)", &n) == 1)
-    {
-        op = d_filter_skip_first(n);
+        if (buffer)
+        {
+            snprintf(buffer, 8, "(empty)");
+        }
 
-        return op;
+        return buffer;
     }
 
-    if (d_sscanf_s(_str, "skip_last(%zu)", &n) == 1)
-    {
-        op = d_filter_skip_last(n);
+    return d_filter_chain_format(_chain, " -> ", false);
+}
 
-        return op;
-    }
+/*
+d_filter_chain_canonical
+  Creates the canonical text of a filter chain: aliases (head, tail, init,
+rest) are written in their general form, no-op operations are left out,
+operations are separated by "|", and every predicate and comparator must
+be registered. Chains with equal canonical text filter every input
+identically, so the text can key a cache of parsed or optimized chains;
+it is also accepted by d_filter_chain_from_string.
 
-    if (d_sscanf_s(_str, "take_nth(%zu)", &n) == 1)
+Parameter(s):
+  _chain: the chain.
+Return:
+  A newly allocated string ("" for an empty chain), or NULL if _chain is
+NULL, uses an unregistered predicate or comparator, or allocation failed.
+Caller must free.
+*/
+char*
+d_filter_chain_canonical
+(
+    const struct d_filter_chain* _chain
+)
+{
+    if (!_chain)
     {
-        op = d_filter_take_nth(n);
-
-        return op;
+        return NULL;
     }
 
-    if (d_sscanf_s(_str, "range(%zu, %zu)", &s, &e) == 2)
-    {
-        op = d_filter_range(s, e);
+    return d_filter_chain_format(_chain, "|", true);
+}
 
-        return op;
-    }
+/*
+d_filter_parser
+  Internal state of the chain parser: the text and the read position, the
+chain operations are built into, where index lists are allocated, and the
+first error.
+*/
+struct d_filter_parser
+{
+    const char*                  text;
+    const char*                  cursor;
+    struct d_filter_chain*       chain;
+    struct d_fn_arena*           arena;     // index lists; NULL for malloc
+    bool                         growable;  // chain->operations may grow
+    bool                         sorted;    // the text set the sorted hint
+    struct d_filter_parse_error* error;
+};
 
-    if (d_sscanf_s(_str, "slice(%zu, %zu, %zu)", &s, &e, &step) == 3)
-    {
-        op = d_filter_slice(s, e, step);
+/*
+d_filter_args
+  Internal argument list shape of an operation keyword.
+*/
+enum d_filter_args
+{
+    D_FILTER_ARGS_NONE = 0,    // head
+    D_FILTER_ARGS_COUNT,       // take_first(N)
+    D_FILTER_ARGS_RANGE,       // range(S, E)
+    D_FILTER_ARGS_SLICE,       // slice(S, E, STEP)
+    D_FILTER_ARGS_INDEX,       // at(I)
+    D_FILTER_ARGS_INDICES,     // at_indices(I, ...)
+    D_FILTER_ARGS_PREDICATE,   // where(P)
+    D_FILTER_ARGS_COMPARATOR,  // distinct(C)
+    D_FILTER_ARGS_TOP_K,       // top_k(K, C)
+    D_FILTER_ARGS_SORTED       // sorted(C), the chain's sorted hint
+};
 
-        return op;
-    }
+/*
+d_filter_keyword
+  Internal description of an operation keyword of the chain grammar.
+*/
+struct d_filter_keyword
+{
+    const char*            name;
+    enum d_filter_op_type  type;
+    enum d_filter_args     args;
+    enum d_filter_monotone monotone;
+};
+
+// the operation keywords, as written by d_filter_operation_to_string
+static const struct d_filter_keyword d_filter_keywords[] =
+{
+    { "take_first",    D_FILTER_OP_TAKE_FIRST, D_FILTER_ARGS_COUNT,
+                       D_FILTER_MONOTONE_NONE                           },
+    { "take_last",     D_FILTER_OP_TAKE_LAST,  D_FILTER_ARGS_COUNT,
+                       D_FILTER_MONOTONE_NONE                           },
+    { "skip_first",    D_FILTER_OP_SKIP_FIRST, D_FILTER_ARGS_COUNT,
+                       D_FILTER_MONOTONE_NONE                           },
+    { "skip_last",     D_FILTER_OP_SKIP_LAST,  D_FILTER_ARGS_COUNT,
+                       D_FILTER_MONOTONE_NONE                           },
+    { "take_nth",      D_FILTER_OP_TAKE_NTH,   D_FILTER_ARGS_COUNT,
+                       D_FILTER_MONOTONE_NONE                           },
+    { "top_k",         D_FILTER_OP_TOP_K,      D_FILTER_ARGS_TOP_K,
+                       D_FILTER_MONOTONE_NONE                           },
+    { "range",         D_FILTER_OP_RANGE,      D_FILTER_ARGS_RANGE,
+                       D_FILTER_MONOTONE_NONE                           },
+    { "slice",         D_FILTER_OP_SLICE,      D_FILTER_ARGS_SLICE,
+                       D_FILTER_MONOTONE_NONE                           },
+    { "where",         D_FILTER_OP_WHERE,      D_FILTER_ARGS_PREDICATE,
+                       D_FILTER_MONOTONE_NONE                           },
+    { "where_not",     D_FILTER_OP_WHERE_NOT,  D_FILTER_ARGS_PREDICATE,
+                       D_FILTER_MONOTONE_NONE                           },
+    { "where_rising",  D_FILTER_OP_WHERE,      D_FILTER_ARGS_PREDICATE,
+                       D_FILTER_MONOTONE_RISING                         },
+    { "where_falling", D_FILTER_OP_WHERE,      D_FILTER_ARGS_PREDICATE,
+                       D_FILTER_MONOTONE_FALLING                        },
+    { "distinct",      D_FILTER_OP_DISTINCT,   D_FILTER_ARGS_COMPARATOR,
+                       D_FILTER_MONOTONE_NONE                           },
+    { "at",            D_FILTER_OP_INDICES,    D_FILTER_ARGS_INDEX,
+                       D_FILTER_MONOTONE_NONE                           },
+    { "at_indices",    D_FILTER_OP_INDICES,    D_FILTER_ARGS_INDICES,
+                       D_FILTER_MONOTONE_NONE                           },
+    { "head",          D_FILTER_OP_HEAD,       D_FILTER_ARGS_NONE,
+                       D_FILTER_MONOTONE_NONE                           },
+    { "tail",          D_FILTER_OP_TAIL,       D_FILTER_ARGS_NONE,
+                       D_FILTER_MONOTONE_NONE                           },
+    { "init",          D_FILTER_OP_INIT,       D_FILTER_ARGS_NONE,
+                       D_FILTER_MONOTONE_NONE                           },
+    { "rest",          D_FILTER_OP_REST,       D_FILTER_ARGS_NONE,
+                       D_FILTER_MONOTONE_NONE                           },
+    { "reverse",       D_FILTER_OP_REVERSE,    D_FILTER_ARGS_NONE,
+                       D_FILTER_MONOTONE_NONE                           },
+    { "none",          D_FILTER_OP_NONE,       D_FILTER_ARGS_NONE,
+                       D_FILTER_MONOTONE_NONE                           },
+    { "sorted",        D_FILTER_OP_NONE,       D_FILTER_ARGS_SORTED,
+                       D_FILTER_MONOTONE_NONE                           }
+};
 
-    if (strcmp(_str, "head") == 0)
+/*
+d_filter_parser_fail
+  Internal helper: records an error at _at, unless one is already recorded,
+and returns false.
+*/
+static bool
+d_filter_parser_fail
+(
+    struct d_filter_parser* _parser,
+    const char*             _at,
+    const char*             _message
+)
+{
+    if (!_parser->error->message)
     {
-        op = d_filter_head();
-
-        return op;
+        _parser->error->position = (size_t)(_at - _parser->text);
+        _parser->error->message  = _message;
     }
 
-    if (strcmp(_str, "tail") == 0)
-    {
-        op = d_filter_tail();
-
-        return op;
-    }
+    return false;
+}
 
-    if (strcmp(_str, "init") == 0)
+/*
+d_filter_parser_skip
+  Internal helper: advances past whitespace.
+*/
+static void
+d_filter_parser_skip
+(
+    struct d_filter_parser* _parser
+)
+{
+    while ( (*_parser->cursor == ' ')  ||
+            (*_parser->cursor == '\t') ||
+            (*_parser->cursor == '\r') ||
+            (*_parser->cursor == '\n') )
     {
-        op = d_filter_init();
-
-        return op;
+        _parser->cursor++;
     }
 
-    if (strcmp(_str, "rest") == 0)
-    {
-        op = d_filter_rest();
+    return;
+}
 
-        return op;
-    }
+/*
+d_filter_parser_expect
+  Internal helper: consumes _symbol after optional whitespace.
+*/
+static bool
+d_filter_parser_expect
+(
+    struct d_filter_parser* _parser,
+    char                    _symbol,
+    const char*             _message
+)
+{
+    d_filter_parser_skip(_parser);
 
-    if (strcmp(_str, "reverse") == 0)
+    if (*_parser->cursor != _symbol)
     {
-        op = d_filter_reverse();
-
-        return op;
+        return d_filter_parser_fail(_parser, _parser->cursor, _message);
     }
 
-    // unknown format
-    free(op);
+    _parser->cursor++;
 
-    return NULL;
+    return true;
 }
 
 /*
-d_filter_chain_from_string
-  Parses a string into a filter chain. Operations are separated by
-" -> ". Each operation is parsed by d_filter_operation_from_string.
-
-Parameter(s):
-  _str: the string to parse.
-Return:
-  A pointer to a newly allocated chain, or NULL on failure.
+d_filter_parser_identifier
+  Internal helper: consumes an identifier ([A-Za-z_][A-Za-z0-9_]*) and
+returns its length, 0 if there is none.
 */
-struct d_filter_chain*
-d_filter_chain_from_string
+static size_t
+d_filter_parser_identifier
 (
-    const char* _str
+    struct d_filter_parser* _parser
 )
 {
-    struct d_filter_chain*     chain;
-    struct d_filter_operation* op;
-    char*                      copy;
-    char*                      token;
-    char*                      save_ptr;
-    size_t                     len;
+    const char* start;
+    char        c;
 
-    if (!_str)
+    start = _parser->cursor;
+    c     = *_parser->cursor;
+
+    if ( !( ( (c >= 'a') && (c <= 'z') ) ||
+            ( (c >= 'A') && (c <= 'Z') ) ||
+            (c == '_') ) )
     {
-        return NULL;
+        return 0;
     }
 
-    chain = d_filter_chain_new();
+    do
+    {
+        _parser->cursor++;
+        c = *_parser->cursor;
+    } while ( ( (c >= 'a') && (c <= 'z') ) ||
+              ( (c >= 'A') && (c <= 'Z') ) ||
+              ( (c >= '0') && (c <= '9') ) ||
+              (c == '_') );
 
-    if (!chain)
+    return (size_t)(_parser->cursor - start);
+}
+
+/*
+d_filter_parser_size
+  Internal helper: consumes an unsigned decimal that fits in a size_t.
+*/
+static bool
+d_filter_parser_size
+(
+    struct d_filter_parser* _parser,
+    size_t*                 _value
+)
+{
+    const char* start;
+    size_t      value;
+    size_t      digit;
+
+    d_filter_parser_skip(_parser);
+
+    start = _parser->cursor;
+    value = 0;
+
+    if ( (*start < '0') ||
+         (*start > '9') )
     {
-        return NULL;
+        return d_filter_parser_fail(_parser, start, "expected a count");
     }
 
-    len  = strlen(_str);
+    while ( (*_parser->cursor >= '0') &&
+            (*_parser->cursor <= '9') )
+    {
+        digit = (size_t)(*_parser->cursor - '0');
 
-    copy = malloc(len + 1);
+        if (value > (SIZE_MAX - digit) / 10)
+        {
+            return d_filter_parser_fail(_parser, start, "count too large");
+        }
 
-    if (!copy)
-    {
-        d_filter_chain_free(chain);
+        value = (value * 10) + digit;
+        _parser->cursor++;
+    }
 
-        return NULL;
+    *_value = value;
+
+    return true;
+}
+
+/*
+d_filter_parser_argument
+  Internal helper: consumes a predicate argument: a decimal integer that
+fits in an int64_t, or otherwise a real.
+*/
+static bool
+d_filter_parser_argument
+(
+    struct d_filter_parser* _parser,
+    struct d_registry_arg*  _arg
+)
+{
+    const char* start;
+    const char* digits;
+    char*       end;
+    uint64_t    magnitude;
+    uint64_t    limit;
+    bool        negative;
+    bool        fits;
+
+    d_filter_parser_skip(_parser);
+
+    start    = _parser->cursor;
+    digits   = start;
+    negative = (*digits == '-');
+
+    if ( (*digits == '-') ||
+         (*digits == '+') )
+    {
+        digits++;
     }
 
-    memcpy(copy, _str, len + 1);
+    if ( (*digits < '0') ||
+         (*digits > '9') )
+    {
+        return d_filter_parser_fail(_parser, start, "expected a number");
+    }
 
-    // split on " -> " delimiter
-    token = d_strtok_r(copy, "|", &save_ptr);
+    limit     = (negative) ? ((uint64_t)INT64_MAX + 1) : (uint64_t)INT64_MAX;
+    magnitude = 0;
+    fits      = true;
 
-    while (token)
+    while ( (*digits >= '0') &&
+            (*digits <= '9') )
     {
-        // trim leading whitespace
-        while (*token == ' ')
+        if (magnitude > (limit - (uint64_t)(*digits - '0')) / 10)
         {
-            token++;
+            fits = false;
         }
-
-        // trim " -> " prefix if present
-        if (strncmp(token, "-> ", 3) == 0)
+        else
         {
-            token += 3;
+            magnitude = (magnitude * 10) + (uint64_t)(*digits - '0');
         }
 
-        // trim trailing whitespace
-        len = strlen(token);
+        digits++;
+    }
+
+    memset(_arg, 0, sizeof(*_arg));
+
+    // fractions, exponents, and integers beyond int64_t are reals
+    if ( (!fits)          ||
+         (*digits == '.') ||
+         (*digits == 'e') ||
+         (*digits == 'E') )
+    {
+        _arg->is_real   = true;
+        _arg->real      = strtod(start, &end);
+        _parser->cursor = end;
+
+        return true;
+    }
+
+    _arg->integer = (!negative)
+        ? (int64_t)magnitude
+        : (magnitude == (uint64_t)INT64_MAX + 1)
+            ? INT64_MIN
+            : -(int64_t)magnitude;
+    _parser->cursor = digits;
+
+    return true;
+}
+
+/*
+d_filter_parser_named
+  Internal helper: consumes "name" or "name, arg, ..." and resolves it in
+the global registry as a predicate (if _test is non-NULL) or a comparator.
+*/
+static bool
+d_filter_parser_named
+(
+    struct d_filter_parser* _parser,
+    fn_predicate*           _test,
+    fn_function_comparator* _compare,
+    void**                  _context
+)
+{
+    struct d_registry_arg args[D_REGISTRY_MAX_PARAMS];
+    const char*           name;
+    size_t                length;
+    size_t                count;
+    bool                  resolved;
+
+    d_filter_parser_skip(_parser);
+
+    name   = _parser->cursor;
+    length = d_filter_parser_identifier(_parser);
+    count  = 0;
+
+    if (length == 0)
+    {
+        return d_filter_parser_fail(_parser,
+                                    name,
+                                    (_test) ? "expected a predicate name"
+                                            : "expected a comparator name");
+    }
+
+    d_filter_parser_skip(_parser);
+
+    while (*_parser->cursor == ',')
+    {
+        _parser->cursor++;
 
-        while ( (len > 0) &&
-                (token[len - 1] == ' ') )
+        if (count == D_REGISTRY_MAX_PARAMS)
         {
-            token[len - 1] = '\0';
-            len--;
+            return d_filter_parser_fail(_parser,
+                                        _parser->cursor,
+                                        "too many arguments");
         }
 
-        if (len > 0)
+        if (!d_filter_parser_argument(_parser, &args[count]))
         {
-            op = d_filter_operation_from_string(token);
-
-            if (op)
-            {
-                d_filter_chain_add(chain, op);
-
-                free(op);
-            }
+            return false;
         }
 
-        token = d_strtok_r(NULL, "|", &save_ptr);
+        count++;
+        d_filter_parser_skip(_parser);
     }
 
-    free(copy);
+    resolved = (_test)
+        ? d_predicate_registry_predicate(d_predicate_registry_global(),
+                                         name,
+                                         length,
+                                         args,
+                                         count,
+                                         _test,
+                                         _context)
+        : d_predicate_registry_comparator(d_predicate_registry_global(),
+                                          name,
+                                          length,
+                                          args,
+                                          count,
+                                          _compare,
+                                          _context);
 
-    return chain;
+    if (!resolved)
+    {
+        return d_filter_parser_fail(_parser,
+                                    name,
+                                    "unregistered name or arguments");
+    }
+
+    return true;
 }
 
 /*
-d_filter_chain_optimize
-  Creates an optimized copy of a filter chain. Current optimizations:
-  - Adjacent take_first ops are merged to the smaller count
-  - Adjacent skip_first ops are merged to the sum
-  - Remove no-ops
-
-Parameter(s):
-  _chain: the chain to optimize.
-Return:
-  A pointer to a newly allocated optimized chain, or NULL on failure.
+d_filter_parser_indices
+  Internal helper: consumes a non-empty index list into _op. The list is
+counted first (up to the closing parenthesis) so that it is allocated
+once, from the arena if there is one.
 */
-struct d_filter_chain*
-d_filter_chain_optimize
+static bool
+d_filter_parser_indices
 (
-    const struct d_filter_chain* _chain
+    struct d_filter_parser*    _parser,
+    struct d_filter_operation* _op
 )
 {
-    struct d_filter_chain*    result;
-    struct d_filter_operation prev;
-    struct d_filter_operation curr;
-    size_t                    i;
-    bool                      has_prev;
+    const char* scan;
+    size_t*     indices;
+    size_t      capacity;
+    size_t      count;
 
-    if (!_chain)
+    capacity = 1;
+
+    for (scan = _parser->cursor; (*scan != '\0') && (*scan != ')'); scan++)
     {
-        return NULL;
+        capacity += (*scan == ',') ? 1 : 0;
     }
 
-    result = d_filter_chain_new();
+    indices = (_parser->arena)
+        ? d_fn_arena_alloc(_parser->arena, capacity * sizeof(size_t))
+        : d_functional_malloc(capacity * sizeof(size_t));
 
-    if (!result)
+    // ensure that memory allocation was successful
+    if (!indices)
     {
-        return NULL;
+        return d_filter_parser_fail(_parser,
+                                    _parser->cursor,
+                                    "out of memory");
     }
 
-    has_prev = false;
-    memset(&prev, 0, sizeof(prev));
+    _op->params.indices = indices;
+    count               = 0;
 
-    for (i = 0; i < _chain->count; i++)
+    for (;;)
     {
-        curr = _chain->operations[i];
+        if ( (count == capacity) ||
+             (!d_filter_parser_size(_parser, &indices[count])) )
+        {
+            return d_filter_parser_fail(_parser,
+                                        _parser->cursor,
+                                        "malformed index list");
+        }
 
-        // skip no-ops
-        if (curr.type == D_FILTER_OP_NONE)
+        count++;
+        d_filter_parser_skip(_parser);
+
+        if (*_parser->cursor != ',')
         {
-            continue;
+            break;
         }
 
-        if (has_prev)
+        _parser->cursor++;
+    }
+
+    _op->params.indices_count = count;
+
+    return true;
+}
+
+/*
+d_filter_parser_slot
+  Internal helper: returns the zeroed operation after the chain's last
+one, growing the chain if it may; errors are reported at _at.
+*/
+static struct d_filter_operation*
+d_filter_parser_slot
+(
+    struct d_filter_parser* _parser,
+    const char*             _at
+)
+{
+    struct d_filter_chain*     chain;
+    struct d_filter_operation* grown;
+    size_t                     capacity;
+
+    chain = _parser->chain;
+
+    if (chain->count == chain->capacity)
+    {
+        if (!_parser->growable)
         {
-            // merge adjacent take_first
-            if ( (prev.type == D_FILTER_OP_TAKE_FIRST) &&
-                 (curr.type == D_FILTER_OP_TAKE_FIRST) )
-            {
-                prev.params.count = (prev.params.count < curr.params.count)
-                    ? prev.params.count
-                    : curr.params.count;
+            d_filter_parser_fail(_parser, _at, "too many operations");
 
-                continue;
-            }
+            return NULL;
+        }
 
-            // merge adjacent skip_first
-            if ( (prev.type == D_FILTER_OP_SKIP_FIRST) &&
-                 (curr.type == D_FILTER_OP_SKIP_FIRST) )
-            {
-                prev.params.count += curr.params.count;
+        capacity = (chain->capacity == 0) ? 4 : (chain->capacity * 2);
+        grown    = d_functional_realloc(chain->operations,
+                                        capacity *
+                                        sizeof(struct d_filter_operation));
 
-                continue;
-            }
+        // ensure that memory allocation was successful
+        if (!grown)
+        {
+            d_filter_parser_fail(_parser, _at, "out of memory");
 
-            // flush prev
-            d_filter_chain_add(result, &prev);
+            return NULL;
         }
 
-        prev     = curr;
-        has_prev = true;
+        chain->operations = grown;
+        chain->capacity   = capacity;
     }
 
-    // flush last buffered op
-    if (has_prev)
-    {
-        d_filter_chain_add(result, &prev);
-    }
+    memset(&chain->operations[chain->count],
+           0,
+           sizeof(struct d_filter_operation));
 
-    return result;
+    return &chain->operations[chain->count];
 }
 
 /*
-d_filter_estimate_result_size
-  Estimates the result size for a filter chain. Walks the chain and
-estimates conservatively based on operation types.
-
-Parameter(s):
-  _chain:       the filter chain.
-  _input_count: the number of input elements.
-Return:
-  An estimated number of output elements.
+d_filter_parser_operation
+  Internal helper: consumes one operation, building it in the next slot of
+the chain (or setting the chain's sorted hint, for "sorted(C)").
 */
-size_t
-d_filter_estimate_result_size
+static bool
+d_filter_parser_operation
 (
-    const struct d_filter_chain* _chain,
-    size_t                       _input_count
+    struct d_filter_parser* _parser
 )
 {
-    size_t estimated;
-    size_t i;
+    const struct d_filter_keyword* keyword;
+    struct d_filter_operation*     op;
+    fn_function_comparator         compare;
+    void*                          context;
+    const char*                    name;
+    size_t                         length;
+    size_t                         i;
+    bool                           ok;
+
+    name    = _parser->cursor;
+    length  = d_filter_parser_identifier(_parser);
+    keyword = NULL;
+
+    for (i = 0;
+         (length > 0) &&
+         (i < sizeof(d_filter_keywords) / sizeof(d_filter_keywords[0]));
+         i++)
+    {
+        if ( (strncmp(d_filter_keywords[i].name, name, length) == 0) &&
+             (d_filter_keywords[i].name[length] == '\0') )
+        {
+            keyword = &d_filter_keywords[i];
 
-    if (!_chain)
+            break;
+        }
+    }
+
+    if (!keyword)
     {
-        return 0;
+        return d_filter_parser_fail(_parser, name, "unknown operation");
     }
 
-    estimated = _input_count;
+    if (keyword->args == D_FILTER_ARGS_SORTED)
+    {
+        context = NULL;
+        ok      = d_filter_parser_expect(_parser, '(', "expected '('")      &&
+                  d_filter_parser_named(_parser, NULL, &compare, &context) &&
+                  d_filter_parser_expect(_parser, ')', "expected ')'");
 
-    for (i = 0; i < _chain->count; i++)
+        if (!ok)
+        {
+            d_filter_context_release(context);
+
+            return false;
+        }
+
+        // a second hint in the same text replaces the first
+        if (_parser->sorted)
+        {
+            d_filter_context_release(_parser->chain->sorted_context);
+        }
+
+        _parser->chain->sorted_by      = compare;
+        _parser->chain->sorted_context = context;
+        _parser->sorted                = true;
+
+        return true;
+    }
+
+    op = d_filter_parser_slot(_parser, name);
+
+    if (!op)
     {
-        const struct d_filter_operation* op;
+        return false;
+    }
 
-        op = &_chain->operations[i];
+    op->type            = keyword->type;
+    op->params.monotone = keyword->monotone;
+    ok                  = (keyword->args == D_FILTER_ARGS_NONE) ||
+                          d_filter_parser_expect(_parser, '(',
+                                                 "expected '('");
 
-        switch (op->type)
+    switch (keyword->args)
+    {
+    case D_FILTER_ARGS_NONE:
+        op->params.count = ( (op->type == D_FILTER_OP_HEAD) ||
+                             (op->type == D_FILTER_OP_TAIL) ) ? 1 : 0;
+
+        break;
+
+    case D_FILTER_ARGS_COUNT:
+        ok = ok && d_filter_parser_size(_parser, &op->params.count);
+
+        // take_nth keeps its stride in `step`, like d_filter_take_nth
+        if (op->type == D_FILTER_OP_TAKE_NTH)
         {
-        case D_FILTER_OP_TAKE_FIRST:
-        case D_FILTER_OP_TAKE_LAST:
-        case D_FILTER_OP_HEAD:
-        case D_FILTER_OP_TAIL:
-            if (op->params.count < estimated)
-            {
-                estimated = op->params.count;
-            }
+            op->params.step  = (op->params.count == 0) ? 1
+                                                       : op->params.count;
+            op->params.count = 0;
+        }
 
-            break;
+        break;
 
-        case D_FILTER_OP_SKIP_FIRST:
-        case D_FILTER_OP_SKIP_LAST:
-            if (op->params.count < estimated)
-            {
-                estimated -= op->params.count;
-            }
-            else
-            {
-                estimated = 0;
-            }
+    case D_FILTER_ARGS_RANGE:
+        ok = ok && d_filter_parser_size(_parser, &op->params.start)       &&
+             d_filter_parser_expect(_parser, ',', "expected ','")          &&
+             d_filter_parser_size(_parser, &op->params.end);
 
-            break;
+        break;
 
-        case D_FILTER_OP_INIT:
-        case D_FILTER_OP_REST:
-            if (estimated > 0)
-            {
-                estimated--;
-            }
+    case D_FILTER_ARGS_SLICE:
+        ok = ok && d_filter_parser_size(_parser, &op->params.start)       &&
+             d_filter_parser_expect(_parser, ',', "expected ','")          &&
+             d_filter_parser_size(_parser, &op->params.end)                &&
+             d_filter_parser_expect(_parser, ',', "expected ','")          &&
+             d_filter_parser_size(_parser, &op->params.step);
 
-            break;
+        op->params.step = (op->params.step == 0) ? 1 : op->params.step;
+
+        break;
+
+    case D_FILTER_ARGS_INDEX:
+        ok = ok && d_filter_parser_size(_parser, &op->params.start);
+
+        op->params.count = 1;
+
+        break;
+
+    case D_FILTER_ARGS_INDICES:
+        ok = ok && d_filter_parser_indices(_parser, op);
+
+        break;
+
+    case D_FILTER_ARGS_PREDICATE:
+        ok = ok && d_filter_parser_named(_parser,
+                                         &op->params.test,
+                                         NULL,
+                                         &op->params.context);
+
+        break;
+
+    case D_FILTER_ARGS_COMPARATOR:
+        ok = ok && d_filter_parser_named(_parser,
+                                         NULL,
+                                         &op->params.comparator,
+                                         &op->params.context);
+
+        break;
+
+    case D_FILTER_ARGS_TOP_K:
+        ok = ok && d_filter_parser_size(_parser, &op->params.count)       &&
+             d_filter_parser_expect(_parser, ',', "expected ','")          &&
+             d_filter_parser_named(_parser,
+                                   NULL,
+                                   &op->params.comparator,
+                                   &op->params.context);
+
+        break;
+
+    default:
+        break;
+    }
+
+    ok = ok && ( (keyword->args == D_FILTER_ARGS_NONE) ||
+                 d_filter_parser_expect(_parser, ')', "expected ')'") );
+
+    if (!ok)
+    {
+        if (!_parser->arena)
+        {
+            d_functional_free(op->params.indices);
+        }
+
+        d_filter_context_release(op->params.context);
+
+        return false;
+    }
+
+    _parser->chain->count++;
+
+    return true;
+}
+
+/*
+d_filter_parser_recover
+  Internal helper: skips to the next separator after a malformed
+operation.
+*/
+static void
+d_filter_parser_recover
+(
+    struct d_filter_parser* _parser
+)
+{
+    while ( (*_parser->cursor != '\0') &&
+            (*_parser->cursor != '|')  &&
+            ( (_parser->cursor[0] != '-') ||
+              (_parser->cursor[1] != '>') ) )
+    {
+        _parser->cursor++;
+    }
+
+    return;
+}
+
+/*
+d_filter_parser_chain
+  Internal helper: parses a whole chain in one pass:
+
+    chain     := [ operation { ( "|" | "->" ) operation } ] | "(empty)"
+    operation := keyword [ "(" arguments ")" ]
+
+With _lenient set, malformed operations are skipped (the behavior of
+d_filter_chain_from_string); otherwise the first error stops the parse.
+*/
+static bool
+d_filter_parser_chain
+(
+    struct d_filter_parser* _parser,
+    bool                    _lenient
+)
+{
+    d_filter_parser_skip(_parser);
+
+    // the text d_filter_chain_to_string writes for an empty chain
+    if (strncmp(_parser->cursor, "(empty)", 7) == 0)
+    {
+        _parser->cursor += 7;
+        d_filter_parser_skip(_parser);
+    }
+    else if (*_parser->cursor != '\0')
+    {
+        for (;;)
+        {
+            d_filter_parser_skip(_parser);
+
+            if ( (!d_filter_parser_operation(_parser)) &&
+                 (!_lenient) )
+            {
+                return false;
+            }
+
+            d_filter_parser_skip(_parser);
+
+            if (*_parser->cursor == '|')
+            {
+                _parser->cursor++;
+            }
+            else if ( (_parser->cursor[0] == '-') &&
+                      (_parser->cursor[1] == '>') )
+            {
+                _parser->cursor += 2;
+            }
+            else if (*_parser->cursor == '\0')
+            {
+                break;
+            }
+            else if (_lenient)
+            {
+                d_filter_parser_recover(_parser);
+
+                continue;
+            }
+            else
+            {
+                return d_filter_parser_fail(_parser,
+                                            _parser->cursor,
+                                            "expected '|' or '->'");
+            }
+
+            d_filter_parser_skip(_parser);
+
+            if (*_parser->cursor == '\0')
+            {
+                return (_lenient) ||
+                       d_filter_parser_fail(_parser,
+                                            _parser->cursor,
+                                            "expected an operation");
+            }
+        }
+    }
+
+    if (*_parser->cursor != '\0')
+    {
+        return d_filter_parser_fail(_parser,
+                                    _parser->cursor,
+                                    "unexpected text after the chain");
+    }
+
+    return true;
+}
+
+/*
+d_filter_operation_from_string
+  Parses a single operation, in the form written by
+d_filter_operation_to_string:
+  "take_first(N)", "take_last(N)", "skip_first(N)", "skip_last(N)",
+  "take_nth(N)", "range(S, E)", "slice(S, E, STEP)", "at(I)",
+  "at_indices(I, ...)", "head", "tail", "init", "rest", "reverse", and,
+  with predicates and comparators named in the global registry, "where(P)",
+  "where_not(P)", "where_rising(P)", "where_falling(P)", "distinct(C)",
+  and "top_k(K, C)", where P and C are "name" or "name, arg, ...".
+
+Parameter(s):
+  _str: the string to parse.
+Return:
+  A pointer to a newly allocated operation, or NULL if _str is not exactly
+one operation.
+*/
+struct d_filter_operation*
+d_filter_operation_from_string
+(
+    const char* _str
+)
+{
+    struct d_filter_parser      parser;
+    struct d_filter_parse_error error;
+    struct d_filter_chain       chain;
+    struct d_filter_operation   parsed;
+    struct d_filter_operation*  op;
+    bool                        ok;
+
+    if (!_str)
+    {
+        return NULL;
+    }
+
+    // parse into a one-slot chain on the stack
+    memset(&chain, 0, sizeof(chain));
+    memset(&error, 0, sizeof(error));
+
+    chain.operations = &parsed;
+    chain.capacity   = 1;
+    parser.text      = _str;
+    parser.cursor    = _str;
+    parser.chain     = &chain;
+    parser.arena     = NULL;
+    parser.growable  = false;
+    parser.sorted    = false;
+    parser.error     = &error;
+
+    ok = d_filter_parser_chain(&parser, false) &&
+         (chain.count == 1);
+
+    // an operation has no sorted hint to keep
+    d_filter_context_release(chain.sorted_context);
+
+    if (!ok)
+    {
+        if (chain.count == 1)
+        {
+            d_filter_operation_free(&parsed);
+        }
+
+        return NULL;
+    }
+
+    op = d_functional_malloc(sizeof(struct d_filter_operation));
+
+    // ensure that memory allocation was successful
+    if (!op)
+    {
+        d_filter_operation_free(&parsed);
+
+        return NULL;
+    }
+
+    memcpy(op, &parsed, sizeof(parsed));
+
+    return op;
+}
+
+/*
+d_filter_chain_parse
+  Parses a chain in one pass, appending its operations to _chain and
+setting its sorted hint if the text has one. Operations are built in
+place in the chain's array, so a chain with enough capacity (see
+d_filter_chain_new_with_capacity) is filled without allocating; only index
+lists are allocated. On failure _chain is left as it was.
+
+Parameter(s):
+  _chain: the chain to append to.
+  _str:   the text, as written by d_filter_chain_to_string or
+          d_filter_chain_canonical.
+  _error: receives the byte offset and a description of the first error;
+          may be NULL.
+Return:
+  true if the whole text parsed, false otherwise.
+*/
+bool
+d_filter_chain_parse
+(
+    struct d_filter_chain*       _chain,
+    const char*                  _str,
+    struct d_filter_parse_error* _error
+)
+{
+    struct d_filter_parser      parser;
+    struct d_filter_parse_error error;
+    fn_function_comparator      sorted_by;
+    void*                       sorted_context;
+    size_t                      count;
+
+    memset(&error, 0, sizeof(error));
+
+    // validate parameters
+    if ( (!_chain) ||
+         (!_str) )
+    {
+        error.message = "NULL chain or text";
+
+        if (_error)
+        {
+            *_error = error;
+        }
+
+        return false;
+    }
+
+    count           = _chain->count;
+    sorted_by       = _chain->sorted_by;
+    sorted_context  = _chain->sorted_context;
+    parser.text     = _str;
+    parser.cursor   = _str;
+    parser.chain    = _chain;
+    parser.arena    = NULL;
+    parser.growable = true;
+    parser.sorted   = false;
+    parser.error    = &error;
+
+    if (!d_filter_parser_chain(&parser, false))
+    {
+        // roll back the operations this text added
+        while (_chain->count > count)
+        {
+            _chain->count--;
+            d_filter_operation_free(&_chain->operations[_chain->count]);
+        }
+
+        if (parser.sorted)
+        {
+            d_filter_context_release(_chain->sorted_context);
+        }
+
+        _chain->sorted_by      = sorted_by;
+        _chain->sorted_context = sorted_context;
+
+        if (_error)
+        {
+            *_error = error;
+        }
+
+        return false;
+    }
+
+    // the text's hint replaced the chain's
+    if (parser.sorted)
+    {
+        d_filter_context_release(sorted_context);
+    }
+
+    if (_error)
+    {
+        *_error = error;
+    }
+
+    return true;
+}
+
+/*
+d_filter_chain_parse_in
+  Parses a chain in one pass into an arena: the chain, room for
+D_FILTER_MAX_CHAIN_LENGTH operations, and index lists are all arena
+allocations, so parsing makes no other allocation. The chain's memory is
+released with the arena; it must not be passed to d_filter_chain_free or
+grown with d_filter_chain_add. Its predicates' arguments are interned in
+the global registry; give them back with d_filter_chain_release before the
+arena is reset or freed.
+
+Parameter(s):
+  _arena: the arena.
+  _str:   the text.
+  _error: receives the byte offset and a description of the first error;
+          may be NULL.
+Return:
+  The chain, or NULL if a parameter is NULL, the text does not parse, it
+has more than D_FILTER_MAX_CHAIN_LENGTH operations, or the arena is out of
+memory.
+*/
+struct d_filter_chain*
+d_filter_chain_parse_in
+(
+    struct d_fn_arena*           _arena,
+    const char*                  _str,
+    struct d_filter_parse_error* _error
+)
+{
+    struct d_filter_parser      parser;
+    struct d_filter_parse_error error;
+    struct d_filter_chain*      chain;
+    bool                        ok;
+
+    memset(&error, 0, sizeof(error));
+
+    chain = NULL;
+    ok    = false;
+
+    // validate parameters
+    if ( (!_arena) ||
+         (!_str) )
+    {
+        error.message = "NULL arena or text";
+    }
+    else
+    {
+        chain = d_fn_arena_alloc(_arena, sizeof(struct d_filter_chain));
+
+        if (chain)
+        {
+            memset(chain, 0, sizeof(*chain));
+
+            chain->operations = d_fn_arena_alloc(
+                                    _arena,
+                                    D_FILTER_MAX_CHAIN_LENGTH *
+                                    sizeof(struct d_filter_operation));
+            chain->capacity   = D_FILTER_MAX_CHAIN_LENGTH;
+        }
+
+        // ensure that memory allocation was successful
+        if ( (!chain) ||
+             (!chain->operations) )
+        {
+            error.message = "out of memory";
+        }
+        else
+        {
+            parser.text     = _str;
+            parser.cursor   = _str;
+            parser.chain    = chain;
+            parser.arena    = _arena;
+            parser.growable = false;
+            parser.sorted   = false;
+            parser.error    = &error;
+
+            ok = d_filter_parser_chain(&parser, false);
+
+            if (!ok)
+            {
+                d_filter_chain_release(chain);
+            }
+        }
+    }
+
+    if (_error)
+    {
+        *_error = error;
+    }
+
+    return (ok) ? chain : NULL;
+}
+
+/*
+d_filter_chain_from_string
+  Parses a string into a filter chain. Operations are separated by
+" -> " (as written by d_filter_chain_to_string) or "|" (as written by
+d_filter_chain_canonical), and have the forms read by
+d_filter_operation_from_string; a "sorted(C)" entry sets the chain's
+sorted hint to the registered comparator C. Malformed operations are
+skipped; use d_filter_chain_parse to reject them and locate the error.
+
+Parameter(s):
+  _str: the string to parse.
+Return:
+  A pointer to a newly allocated chain, or NULL on failure.
+*/
+struct d_filter_chain*
+d_filter_chain_from_string
+(
+    const char* _str
+)
+{
+    struct d_filter_parser      parser;
+    struct d_filter_parse_error error;
+    struct d_filter_chain*      chain;
+
+    if (!_str)
+    {
+        return NULL;
+    }
+
+    chain = d_filter_chain_new();
+
+    if (!chain)
+    {
+        return NULL;
+    }
+
+    memset(&error, 0, sizeof(error));
+
+    parser.text     = _str;
+    parser.cursor   = _str;
+    parser.chain    = chain;
+    parser.arena    = NULL;
+    parser.growable = true;
+    parser.sorted   = false;
+    parser.error    = &error;
+
+    d_filter_parser_chain(&parser, true);
+
+    return chain;
+}
+
+/*
+d_filter_chain_optimize
+  Creates an optimized copy of a filter chain. Current optimizations:
+  - Adjacent take_first ops are merged to the smaller count
+  - Adjacent skip_first ops are merged to the sum
+  - Remove no-ops
+
+Parameter(s):
+  _chain: the chain to optimize.
+Return:
+  A pointer to a newly allocated optimized chain, or NULL on failure.
+*/
+struct d_filter_chain*
+d_filter_chain_optimize
+(
+    const struct d_filter_chain* _chain
+)
+{
+    struct d_filter_chain*    result;
+    struct d_filter_operation prev;
+    struct d_filter_operation curr;
+    size_t                    i;
+    bool                      has_prev;
+
+    if (!_chain)
+    {
+        return NULL;
+    }
+
+    result = d_filter_chain_new();
+
+    if (!result)
+    {
+        return NULL;
+    }
+
+    result->sorted_by      = _chain->sorted_by;
+    result->sorted_context = _chain->sorted_context;
+    has_prev               = false;
+    memset(&prev, 0, sizeof(prev));
+
+    for (i = 0; i < _chain->count; i++)
+    {
+        curr = _chain->operations[i];
+
+        // skip no-ops
+        if (curr.type == D_FILTER_OP_NONE)
+        {
+            continue;
+        }
+
+        if (has_prev)
+        {
+            // merge adjacent take_first
+            if ( (prev.type == D_FILTER_OP_TAKE_FIRST) &&
+                 (curr.type == D_FILTER_OP_TAKE_FIRST) )
+            {
+                prev.params.count = (prev.params.count < curr.params.count)
+                    ? prev.params.count
+                    : curr.params.count;
+
+                continue;
+            }
+
+            // merge adjacent skip_first
+            if ( (prev.type == D_FILTER_OP_SKIP_FIRST) &&
+                 (curr.type == D_FILTER_OP_SKIP_FIRST) )
+            {
+                prev.params.count += curr.params.count;
+
+                continue;
+            }
+
+            // flush prev
+            d_filter_chain_add(result, &prev);
+        }
+
+        prev     = curr;
+        has_prev = true;
+    }
+
+    // flush last buffered op
+    if (has_prev)
+    {
+        d_filter_chain_add(result, &prev);
+    }
+
+    d_filter_chain_retain_contexts(result);
+
+    return result;
+}
+
+/*
+d_filter_estimate_result_size
+  Estimates the result size for a filter chain. Walks the chain and
+estimates conservatively based on operation types.
+
+Parameter(s):
+  _chain:       the filter chain.
+  _input_count: the number of input elements.
+Return:
+  An estimated number of output elements.
+*/
+size_t
+d_filter_estimate_result_size
+(
+    const struct d_filter_chain* _chain,
+    size_t                       _input_count
+)
+{
+    size_t estimated;
+    size_t i;
+
+    if (!_chain)
+    {
+        return 0;
+    }
+
+    estimated = _input_count;
+
+    for (i = 0; i < _chain->count; i++)
+    {
+        const struct d_filter_operation* op;
+
+        op = &_chain->operations[i];
+
+        switch (op->type)
+        {
+        case D_FILTER_OP_TAKE_FIRST:
+        case D_FILTER_OP_TAKE_LAST:
+        case D_FILTER_OP_HEAD:
+        case D_FILTER_OP_TAIL:
+        case D_FILTER_OP_TOP_K:
+            if (op->params.count < estimated)
+            {
+                estimated = op->params.count;
+            }
+
+            break;
+
+        case D_FILTER_OP_SKIP_FIRST:
+        case D_FILTER_OP_SKIP_LAST:
+            if (op->params.count < estimated)
+            {
+                estimated -= op->params.count;
+            }
+            else
+            {
+                estimated = 0;
+            }
+
+            break;
+
+        case D_FILTER_OP_INIT:
+        case D_FILTER_OP_REST:
+            if (estimated > 0)
+            {
+                estimated--;
+            }
+
+            break;
+
+        case D_FILTER_OP_RANGE:
+            if ( (op->params.start < estimated) &&
+                 (op->params.end > op->params.start) )
+            {
+                size_t range = op->params.end - op->params.start;
+
+                if (range < estimated)
+                {
+                    estimated = range;
+                }
+            }
+            else
+            {
+                estimated = 0;
+            }
+
+            break;
+
+        case D_FILTER_OP_INDICES:
+            if (op->params.indices_count < estimated)
+            {
+                estimated = op->params.indices_count;
+            }
+
+            break;
+
+        default:
+            // WHERE, DISTINCT, etc. are data-dependent;
+            // keep current estimate
+            break;
+        }
+    }
+
+    return estimated;
+}
+
+
+// d_filter_encoding_magic
+//   static: the first bytes of every binary-encoded chain.
+static const unsigned char d_filter_encoding_magic[3] = { 'D', 'F', 'C' };
+
+// d_filter_encoding_flag
+//   enum: header flag bits of the binary encoding.
+enum d_filter_encoding_flag
+{
+    D_FILTER_ENCODING_SORTED = 0x01  // a sorted hint follows the op count
+};
+
+/*
+d_filter_encoder
+  Internal state of d_filter_chain_encode: the output, and the number of
+bytes the encoding needs so far (which may exceed the capacity, in which
+case nothing past the capacity is written).
+*/
+struct d_filter_encoder
+{
+    unsigned char* buffer;
+    size_t         capacity;
+    size_t         used;
+};
+
+/*
+d_filter_encoder_byte
+  Internal helper: appends one byte.
+*/
+static void
+d_filter_encoder_byte
+(
+    struct d_filter_encoder* _encoder,
+    unsigned char            _byte
+)
+{
+    if (_encoder->used < _encoder->capacity)
+    {
+        _encoder->buffer[_encoder->used] = _byte;
+    }
+
+    _encoder->used++;
+
+    return;
+}
+
+/*
+d_filter_encoder_varint
+  Internal helper: appends an unsigned LEB128 varint: seven bits per byte,
+least significant first, the high bit set on all but the last byte.
+*/
+static void
+d_filter_encoder_varint
+(
+    struct d_filter_encoder* _encoder,
+    uint64_t                 _value
+)
+{
+    while (_value >= 0x80)
+    {
+        d_filter_encoder_byte(_encoder,
+                              (unsigned char)((_value & 0x7F) | 0x80));
+        _value >>= 7;
+    }
+
+    d_filter_encoder_byte(_encoder, (unsigned char)_value);
+
+    return;
+}
+
+/*
+d_filter_encoder_ref
+  Internal helper: appends a registered predicate (_test) or comparator
+(_compare) as its registry id, an arity byte (argument count in the low
+four bits, a bit per real argument in the high four), and the arguments:
+integers as zigzag varints, reals as 8 little-endian bytes. Fails if the
+function and context are not registered.
+*/
+static bool
+d_filter_encoder_ref
+(
+    struct d_filter_encoder* _encoder,
+    fn_predicate             _test,
+    fn_function_comparator   _compare,
+    void*                    _context
+)
+{
+    struct d_predicate_registry* registry;
+    struct d_registry_entry      entry;
+    struct d_registry_arg        args[D_REGISTRY_MAX_PARAMS];
+    unsigned char                arity;
+    uint64_t                     bits;
+    size_t                       i;
+    size_t                       j;
+    bool                         ok;
+
+    registry = d_predicate_registry_global();
+
+    ok = (_test)
+        ? d_predicate_registry_identify_predicate(registry,
+                                                  _test,
+                                                  _context,
+                                                  &entry,
+                                                  args)
+        : d_predicate_registry_identify_comparator(registry,
+                                                   _compare,
+                                                   _context,
+                                                   &entry,
+                                                   args);
+
+    // the arity byte has room for four arguments
+    if ( (!ok) ||
+         (entry.param_count > 4) )
+    {
+        return false;
+    }
+
+    arity = (unsigned char)entry.param_count;
+
+    for (i = 0; i < entry.param_count; i++)
+    {
+        if (args[i].is_real)
+        {
+            arity |= (unsigned char)(0x10 << i);
+        }
+    }
+
+    d_filter_encoder_varint(_encoder, entry.id);
+    d_filter_encoder_byte(_encoder, arity);
+
+    for (i = 0; i < entry.param_count; i++)
+    {
+        if (args[i].is_real)
+        {
+            memcpy(&bits, &args[i].real, sizeof(bits));
+
+            for (j = 0; j < 8; j++)
+            {
+                d_filter_encoder_byte(_encoder,
+                                      (unsigned char)(bits >> (j * 8)));
+            }
+        }
+        else
+        {
+            bits = ((uint64_t)args[i].integer << 1) ^
+                   ((args[i].integer < 0) ? UINT64_MAX : 0);
+
+            d_filter_encoder_varint(_encoder, bits);
+        }
+    }
+
+    return true;
+}
+
+/*
+d_filter_encoder_operation
+  Internal helper: appends an operation as its type byte followed by the
+parameters its type uses.
+*/
+static bool
+d_filter_encoder_operation
+(
+    struct d_filter_encoder*         _encoder,
+    const struct d_filter_operation* _op
+)
+{
+    size_t i;
+
+    if (!d_filter_operation_is_valid(_op))
+    {
+        return false;
+    }
+
+    d_filter_encoder_byte(_encoder, (unsigned char)_op->type);
+
+    switch (_op->type)
+    {
+    case D_FILTER_OP_TAKE_FIRST:
+    case D_FILTER_OP_TAKE_LAST:
+    case D_FILTER_OP_SKIP_FIRST:
+    case D_FILTER_OP_SKIP_LAST:
+        d_filter_encoder_varint(_encoder, _op->params.count);
+
+        break;
+
+    case D_FILTER_OP_TAKE_NTH:
+        d_filter_encoder_varint(_encoder, _op->params.step);
+
+        break;
+
+    case D_FILTER_OP_RANGE:
+        d_filter_encoder_varint(_encoder, _op->params.start);
+        d_filter_encoder_varint(_encoder, _op->params.end);
+
+        break;
+
+    case D_FILTER_OP_SLICE:
+        d_filter_encoder_varint(_encoder, _op->params.start);
+        d_filter_encoder_varint(_encoder, _op->params.end);
+        d_filter_encoder_varint(_encoder, _op->params.step);
+
+        break;
+
+    case D_FILTER_OP_WHERE:
+    case D_FILTER_OP_WHERE_NOT:
+        d_filter_encoder_byte(_encoder, (unsigned char)_op->params.monotone);
+
+        return d_filter_encoder_ref(_encoder,
+                                    _op->params.test,
+                                    NULL,
+                                    _op->params.context);
+
+    case D_FILTER_OP_TOP_K:
+        d_filter_encoder_varint(_encoder, _op->params.count);
+
+        return d_filter_encoder_ref(_encoder,
+                                    NULL,
+                                    _op->params.comparator,
+                                    _op->params.context);
+
+    case D_FILTER_OP_DISTINCT:
+        return d_filter_encoder_ref(_encoder,
+                                    NULL,
+                                    _op->params.comparator,
+                                    _op->params.context);
+
+    case D_FILTER_OP_INDICES:
+        // 0 is the single index from d_filter_at; n + 1 a list of n
+        if ( (!_op->params.indices) &&
+             (_op->params.count == 1) )
+        {
+            d_filter_encoder_varint(_encoder, 0);
+            d_filter_encoder_varint(_encoder, _op->params.start);
+
+            break;
+        }
+
+        if ( (!_op->params.indices) &&
+             (_op->params.indices_count > 0) )
+        {
+            return false;
+        }
+
+        d_filter_encoder_varint(_encoder,
+                                (uint64_t)_op->params.indices_count + 1);
+
+        for (i = 0; i < _op->params.indices_count; i++)
+        {
+            d_filter_encoder_varint(_encoder, _op->params.indices[i]);
+        }
+
+        break;
+
+    default:
+        // head, tail, init, rest, reverse, and none have no parameters
+        break;
+    }
+
+    return true;
+}
+
+/*
+d_filter_chain_encode
+  Writes a chain in the compact binary encoding: the magic "DFC", the
+D_FILTER_ENCODING_VERSION byte, a flags byte, the operation count, the
+sorted hint (if any), then each operation as a type byte and its
+parameters. Counts, positions, and index lists are varints, so small
+values take one byte; predicates and comparators are written by their id
+in the global registry (predicate_registry.h) with their bound arguments.
+Ids are registration order, so the reading process must register its
+application predicates in the same order as the writer. Operation names
+are not written. Optimized chains (d_filter_chain_optimize) are encoded
+the same way, so a planned chain can be stored and reloaded without
+planning it again.
+  Like snprintf, returns the size the encoding needs; nothing is written
+past _capacity, so a call with a NULL buffer sizes the output.
+
+Parameter(s):
+  _chain:    the chain to encode.
+  _buffer:   the output; may be NULL when _capacity is 0.
+  _capacity: the size of _buffer in bytes.
+Return:
+  The size of the encoding in bytes (complete only if at most _capacity),
+or 0 if a parameter is invalid, an operation is invalid, or a predicate or
+comparator is not registered.
+*/
+size_t
+d_filter_chain_encode
+(
+    const struct d_filter_chain* _chain,
+    void*                        _buffer,
+    size_t                       _capacity
+)
+{
+    struct d_filter_encoder encoder;
+    size_t                  i;
+
+    // validate parameters
+    if ( (!_chain)                                   ||
+         ( (!_buffer) && (_capacity > 0) )           ||
+         ( (!_chain->operations) && (_chain->count > 0) ) )
+    {
+        return 0;
+    }
+
+    encoder.buffer   = (unsigned char*)_buffer;
+    encoder.capacity = _capacity;
+    encoder.used     = 0;
+
+    for (i = 0; i < sizeof(d_filter_encoding_magic); i++)
+    {
+        d_filter_encoder_byte(&encoder, d_filter_encoding_magic[i]);
+    }
+
+    d_filter_encoder_byte(&encoder, D_FILTER_ENCODING_VERSION);
+    d_filter_encoder_byte(&encoder,
+                          (_chain->sorted_by) ? D_FILTER_ENCODING_SORTED : 0);
+    d_filter_encoder_varint(&encoder, _chain->count);
+
+    if ( (_chain->sorted_by) &&
+         (!d_filter_encoder_ref(&encoder,
+                                NULL,
+                                _chain->sorted_by,
+                                _chain->sorted_context)) )
+    {
+        return 0;
+    }
+
+    for (i = 0; i < _chain->count; i++)
+    {
+        if (!d_filter_encoder_operation(&encoder, &_chain->operations[i]))
+        {
+            return 0;
+        }
+    }
+
+    return encoder.used;
+}
+
+/*
+d_filter_decoder
+  Internal state of the binary decoder: the input and the read position,
+and the first error. It runs twice over the same input: with a NULL chain
+it only validates and counts operations and indices; with a chain it
+fills the chain's operations and hands out index lists from `indices`.
+*/
+struct d_filter_decoder
+{
+    const unsigned char*         data;
+    size_t                       size;
+    size_t                       position;
+    struct d_filter_chain*       chain;        // NULL when measuring
+    size_t*                      indices;      // next free index slot
+    size_t                       op_count;     // operations read
+    size_t                       index_count;  // list indices read
+    struct d_filter_parse_error* error;
+};
+
+/*
+d_filter_decoder_fail
+  Internal helper: records an error at byte _at, unless one is already
+recorded, and returns false.
+*/
+static bool
+d_filter_decoder_fail
+(
+    struct d_filter_decoder* _decoder,
+    size_t                   _at,
+    const char*              _message
+)
+{
+    if (!_decoder->error->message)
+    {
+        _decoder->error->position = _at;
+        _decoder->error->message  = _message;
+    }
+
+    return false;
+}
+
+/*
+d_filter_decoder_byte
+  Internal helper: reads one byte.
+*/
+static bool
+d_filter_decoder_byte
+(
+    struct d_filter_decoder* _decoder,
+    unsigned char*           _byte
+)
+{
+    if (_decoder->position >= _decoder->size)
+    {
+        return d_filter_decoder_fail(_decoder,
+                                     _decoder->position,
+                                     "truncated input");
+    }
+
+    *_byte = _decoder->data[_decoder->position++];
+
+    return true;
+}
+
+/*
+d_filter_decoder_varint
+  Internal helper: reads an unsigned LEB128 varint of at most 64 bits.
+*/
+static bool
+d_filter_decoder_varint
+(
+    struct d_filter_decoder* _decoder,
+    uint64_t*                _value
+)
+{
+    unsigned char byte;
+    size_t        at;
+    unsigned      shift;
+
+    at      = _decoder->position;
+    *_value = 0;
+
+    for (shift = 0; ; shift += 7)
+    {
+        if (!d_filter_decoder_byte(_decoder, &byte))
+        {
+            return false;
+        }
+
+        // the tenth byte holds only the top bit
+        if ( (shift == 63) &&
+             (byte > 1) )
+        {
+            return d_filter_decoder_fail(_decoder, at, "varint overflow");
+        }
+
+        *_value |= (uint64_t)(byte & 0x7F) << shift;
+
+        if (!(byte & 0x80))
+        {
+            return true;
+        }
+    }
+}
+
+/*
+d_filter_decoder_size
+  Internal helper: reads a varint that must fit a size_t.
+*/
+static bool
+d_filter_decoder_size
+(
+    struct d_filter_decoder* _decoder,
+    size_t*                  _value
+)
+{
+    uint64_t value;
+    size_t   at;
+
+    at = _decoder->position;
+
+    if (!d_filter_decoder_varint(_decoder, &value))
+    {
+        return false;
+    }
+
+    if (value > (uint64_t)SIZE_MAX)
+    {
+        return d_filter_decoder_fail(_decoder, at, "value out of range");
+    }
+
+    *_value = (size_t)value;
+
+    return true;
+}
+
+/*
+d_filter_decoder_ref
+  Internal helper: reads a registry reference written by
+d_filter_encoder_ref and resolves it by id in the global registry, as a
+predicate into *_test or, if _test is NULL, a comparator into *_compare.
+*/
+static bool
+d_filter_decoder_ref
+(
+    struct d_filter_decoder* _decoder,
+    fn_predicate*            _test,
+    fn_function_comparator*  _compare,
+    void**                   _context
+)
+{
+    struct d_predicate_registry* registry;
+    struct d_registry_arg        args[D_REGISTRY_MAX_PARAMS];
+    unsigned char                arity;
+    unsigned char                byte;
+    uint64_t                     value;
+    uint32_t                     id;
+    size_t                       count;
+    size_t                       at;
+    size_t                       i;
+    size_t                       j;
+    bool                         ok;
+
+    at = _decoder->position;
+
+    if (!d_filter_decoder_varint(_decoder, &value))
+    {
+        return false;
+    }
+
+    if (value > UINT32_MAX)
+    {
+        return d_filter_decoder_fail(_decoder, at, "value out of range");
+    }
+
+    id = (uint32_t)value;
+
+    if (!d_filter_decoder_byte(_decoder, &arity))
+    {
+        return false;
+    }
+
+    count = (size_t)(arity & 0x0F);
+
+    // real flags only for arguments that exist
+    if ( (count > D_REGISTRY_MAX_PARAMS) ||
+         ((arity >> 4) >> count) )
+    {
+        return d_filter_decoder_fail(_decoder,
+                                     _decoder->position - 1,
+                                     "bad argument count");
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        args[i].is_real = ((arity >> (4 + i)) & 1) != 0;
+        args[i].integer = 0;
+        args[i].real    = 0.0;
+
+        if (args[i].is_real)
+        {
+            value = 0;
+
+            for (j = 0; j < 8; j++)
+            {
+                if (!d_filter_decoder_byte(_decoder, &byte))
+                {
+                    return false;
+                }
+
+                value |= (uint64_t)byte << (j * 8);
+            }
+
+            memcpy(&args[i].real, &value, sizeof(value));
+        }
+        else
+        {
+            if (!d_filter_decoder_varint(_decoder, &value))
+            {
+                return false;
+            }
+
+            args[i].integer = (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+        }
+    }
+
+    registry = d_predicate_registry_global();
+
+    ok = (_test)
+        ? d_predicate_registry_predicate_by_id(registry,
+                                               id,
+                                               args,
+                                               count,
+                                               _test,
+                                               _context)
+        : d_predicate_registry_comparator_by_id(registry,
+                                                id,
+                                                args,
+                                                count,
+                                                _compare,
+                                                _context);
+
+    if (!ok)
+    {
+        return d_filter_decoder_fail(_decoder,
+                                     at,
+                                     (_test) ? "unregistered predicate"
+                                             : "unregistered comparator");
+    }
+
+    // measuring only validates; the fill pass resolves again and keeps it
+    if (!_decoder->chain)
+    {
+        d_filter_context_release(*_context);
+        *_context = NULL;
+    }
+
+    return true;
+}
+
+/*
+d_filter_decoder_operation
+  Internal helper: reads one operation; when filling, stores it at the
+next slot of the chain and its index list at the next free index slot.
+*/
+static bool
+d_filter_decoder_operation
+(
+    struct d_filter_decoder* _decoder
+)
+{
+    struct d_filter_operation op;
+    unsigned char             byte;
+    size_t                    listed;
+    size_t                    at;
+    size_t                    i;
+    bool                      ok;
+
+    at = _decoder->position;
+
+    if (!d_filter_decoder_byte(_decoder, &byte))
+    {
+        return false;
+    }
+
+    if (byte > D_FILTER_OP_TOP_K)
+    {
+        return d_filter_decoder_fail(_decoder, at, "unknown operation");
+    }
+
+    memset(&op, 0, sizeof(op));
+    op.type = (enum d_filter_op_type)byte;
+    ok      = true;
+
+    switch (op.type)
+    {
+    case D_FILTER_OP_TAKE_FIRST:
+    case D_FILTER_OP_TAKE_LAST:
+    case D_FILTER_OP_SKIP_FIRST:
+    case D_FILTER_OP_SKIP_LAST:
+        ok = d_filter_decoder_size(_decoder, &op.params.count);
+
+        break;
+
+    case D_FILTER_OP_HEAD:
+    case D_FILTER_OP_TAIL:
+        op.params.count = 1;
+
+        break;
+
+    case D_FILTER_OP_TAKE_NTH:
+        ok = d_filter_decoder_size(_decoder, &op.params.step);
+
+        break;
+
+    case D_FILTER_OP_RANGE:
+        ok = d_filter_decoder_size(_decoder, &op.params.start) &&
+             d_filter_decoder_size(_decoder, &op.params.end);
+
+        break;
+
+    case D_FILTER_OP_SLICE:
+        ok = d_filter_decoder_size(_decoder, &op.params.start) &&
+             d_filter_decoder_size(_decoder, &op.params.end)   &&
+             d_filter_decoder_size(_decoder, &op.params.step);
+
+        break;
+
+    case D_FILTER_OP_WHERE:
+    case D_FILTER_OP_WHERE_NOT:
+        if (!d_filter_decoder_byte(_decoder, &byte))
+        {
+            return false;
+        }
+
+        if (byte > D_FILTER_MONOTONE_FALLING)
+        {
+            return d_filter_decoder_fail(_decoder,
+                                         _decoder->position - 1,
+                                         "bad monotone shape");
+        }
+
+        op.params.monotone = (enum d_filter_monotone)byte;
+        ok                 = d_filter_decoder_ref(_decoder,
+                                                  &op.params.test,
+                                                  NULL,
+                                                  &op.params.context);
+
+        break;
+
+    case D_FILTER_OP_TOP_K:
+        ok = d_filter_decoder_size(_decoder, &op.params.count) &&
+             d_filter_decoder_ref(_decoder,
+                                  NULL,
+                                  &op.params.comparator,
+                                  &op.params.context);
+
+        break;
+
+    case D_FILTER_OP_DISTINCT:
+        ok = d_filter_decoder_ref(_decoder,
+                                  NULL,
+                                  &op.params.comparator,
+                                  &op.params.context);
+
+        break;
+
+    case D_FILTER_OP_INDICES:
+        at = _decoder->position;
+
+        if (!d_filter_decoder_size(_decoder, &listed))
+        {
+            return false;
+        }
+
+        // 0 is a single index; n + 1 a list of n, at least a byte each
+        if (listed == 0)
+        {
+            op.params.count = 1;
+            ok              = d_filter_decoder_size(_decoder,
+                                                    &op.params.start);
+
+            break;
+        }
+
+        listed--;
+
+        if (listed > _decoder->size - _decoder->position)
+        {
+            return d_filter_decoder_fail(_decoder,
+                                         at,
+                                         "index count exceeds input");
+        }
+
+        if ( (_decoder->chain) &&
+             (listed > 0) )
+        {
+            op.params.indices   = _decoder->indices;
+            _decoder->indices  += listed;
+        }
+
+        op.params.indices_count  = listed;
+        _decoder->index_count   += listed;
+
+        for (i = 0; (ok) && (i < listed); i++)
+        {
+            ok = (op.params.indices)
+                ? d_filter_decoder_size(_decoder, &op.params.indices[i])
+                : d_filter_decoder_size(_decoder, &at);
+        }
+
+        break;
+
+    default:
+        break;
+    }
+
+    if (!ok)
+    {
+        return false;
+    }
+
+    if (_decoder->chain)
+    {
+        _decoder->chain->operations[_decoder->op_count] = op;
+    }
+
+    _decoder->op_count++;
+
+    return true;
+}
+
+/*
+d_filter_decoder_run
+  Internal helper: reads and validates a whole encoding: the header, the
+sorted hint, every operation, and no trailing bytes.
+*/
+static bool
+d_filter_decoder_run
+(
+    struct d_filter_decoder* _decoder
+)
+{
+    fn_function_comparator sorted_by;
+    void*                  sorted_context;
+    unsigned char          byte;
+    size_t                 count;
+    size_t                 at;
+    size_t                 i;
+
+    for (i = 0; i < sizeof(d_filter_encoding_magic); i++)
+    {
+        if (!d_filter_decoder_byte(_decoder, &byte))
+        {
+            return false;
+        }
+
+        if (byte != d_filter_encoding_magic[i])
+        {
+            return d_filter_decoder_fail(_decoder, 0, "bad magic");
+        }
+    }
+
+    if (!d_filter_decoder_byte(_decoder, &byte))
+    {
+        return false;
+    }
+
+    if (byte != D_FILTER_ENCODING_VERSION)
+    {
+        return d_filter_decoder_fail(_decoder,
+                                     _decoder->position - 1,
+                                     "unsupported version");
+    }
+
+    if (!d_filter_decoder_byte(_decoder, &byte))
+    {
+        return false;
+    }
+
+    if (byte & ~D_FILTER_ENCODING_SORTED)
+    {
+        return d_filter_decoder_fail(_decoder,
+                                     _decoder->position - 1,
+                                     "unknown flags");
+    }
+
+    at = _decoder->position;
+
+    if (!d_filter_decoder_size(_decoder, &count))
+    {
+        return false;
+    }
+
+    // every operation takes at least its type byte
+    if (count > _decoder->size - _decoder->position)
+    {
+        return d_filter_decoder_fail(_decoder,
+                                     at,
+                                     "operation count exceeds input");
+    }
+
+    sorted_by      = NULL;
+    sorted_context = NULL;
+
+    if ( (byte & D_FILTER_ENCODING_SORTED) &&
+         (!d_filter_decoder_ref(_decoder,
+                                NULL,
+                                &sorted_by,
+                                &sorted_context)) )
+    {
+        return false;
+    }
+
+    // set now, so that a failed fill releases the hint with the operations
+    if (_decoder->chain)
+    {
+        _decoder->chain->sorted_by      = sorted_by;
+        _decoder->chain->sorted_context = sorted_context;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        if (!d_filter_decoder_operation(_decoder))
+        {
+            return false;
+        }
+    }
+
+    if (_decoder->position != _decoder->size)
+    {
+        return d_filter_decoder_fail(_decoder,
+                                     _decoder->position,
+                                     "trailing bytes");
+    }
+
+    return true;
+}
+
+/*
+d_filter_decoder_measure
+  Internal helper: validates an encoding without building it; returns the
+size of the block d_filter_decoder_fill lays the chain out in, or 0 on
+error.
+*/
+static size_t
+d_filter_decoder_measure
+(
+    struct d_filter_decoder*     _decoder,
+    const void*                  _data,
+    size_t                       _size,
+    struct d_filter_parse_error* _error
+)
+{
+    memset(_decoder, 0, sizeof(*_decoder));
+
+    _decoder->data  = (const unsigned char*)_data;
+    _decoder->size  = _size;
+    _decoder->error = _error;
+
+    if (!d_filter_decoder_run(_decoder))
+    {
+        return 0;
+    }
+
+    return sizeof(struct d_filter_chain)                            +
+           (_decoder->op_count * sizeof(struct d_filter_operation)) +
+           (_decoder->index_count * sizeof(size_t));
+}
+
+/*
+d_filter_decoder_fill
+  Internal helper: decodes a measured encoding into _block: the chain,
+then its operations, then the index lists.
+*/
+static struct d_filter_chain*
+d_filter_decoder_fill
+(
+    struct d_filter_decoder* _decoder,
+    void*                    _block
+)
+{
+    struct d_filter_chain* chain;
+    size_t                 count;
+
+    count = _decoder->op_count;
+    chain = (struct d_filter_chain*)_block;
+
+    memset(chain, 0, sizeof(*chain));
+
+    chain->operations      = (struct d_filter_operation*)(chain + 1);
+    chain->count           = count;
+    chain->capacity        = count;
+    chain->owns_operations = false;
+
+    _decoder->position    = 0;
+    _decoder->chain       = chain;
+    _decoder->indices     = (size_t*)(chain->operations + count);
+    _decoder->op_count    = 0;
+    _decoder->index_count = 0;
+
+    if (!d_filter_decoder_run(_decoder))
+    {
+        // only resolving a context can fail the second time
+        chain->count = _decoder->op_count;
+        d_filter_chain_release(chain);
+
+        return NULL;
+    }
+
+    return chain;
+}
+
+/*
+d_filter_chain_decoded_size
+  Validates a binary-encoded chain and returns the buffer size
+d_filter_chain_decode_into needs for it.
+
+Parameter(s):
+  _data:  the encoding.
+  _size:  its size in bytes.
+  _error: receives the byte offset and a description of the first error;
+          may be NULL.
+Return:
+  The size in bytes, or 0 if the encoding is invalid (see
+d_filter_chain_decode).
+*/
+size_t
+d_filter_chain_decoded_size
+(
+    const void*                  _data,
+    size_t                       _size,
+    struct d_filter_parse_error* _error
+)
+{
+    struct d_filter_decoder     decoder;
+    struct d_filter_parse_error error;
+    size_t                      needed;
+
+    memset(&error, 0, sizeof(error));
+
+    needed = 0;
+
+    // validate parameters
+    if (!_data)
+    {
+        error.message = "NULL data";
+    }
+    else
+    {
+        needed = d_filter_decoder_measure(&decoder, _data, _size, &error);
+    }
+
+    if (_error)
+    {
+        *_error = error;
+    }
+
+    return needed;
+}
+
+/*
+d_filter_chain_decode_into
+  Decodes a binary-encoded chain into a caller-provided buffer without
+allocating: the chain, its operations, and its index lists are laid out in
+_buffer, which must be aligned for a pointer and at least
+d_filter_chain_decoded_size bytes. The chain does not own its operations;
+d_filter_chain_add will not grow it, and it must not be passed to
+d_filter_chain_free. Its predicates' arguments are interned in the global
+registry; give them back with d_filter_chain_release before the buffer is
+reused.
+
+Parameter(s):
+  _buffer:   the memory to decode into.
+  _capacity: the size of _buffer in bytes.
+  _data:     the encoding.
+  _size:     its size in bytes.
+  _error:    receives the byte offset and a description of the first
+             error; may be NULL.
+Return:
+  The chain (at the start of _buffer), or NULL if a parameter is NULL, the
+buffer is too small, or the encoding is invalid (see
+d_filter_chain_decode).
+*/
+struct d_filter_chain*
+d_filter_chain_decode_into
+(
+    void*                        _buffer,
+    size_t                       _capacity,
+    const void*                  _data,
+    size_t                       _size,
+    struct d_filter_parse_error* _error
+)
+{
+    struct d_filter_decoder     decoder;
+    struct d_filter_parse_error error;
+    struct d_filter_chain*      chain;
+    size_t                      needed;
+
+    memset(&error, 0, sizeof(error));
+
+    chain = NULL;
+
+    // validate parameters
+    if ( (!_buffer) ||
+         (!_data) )
+    {
+        error.message = "NULL buffer or data";
+    }
+    else
+    {
+        needed = d_filter_decoder_measure(&decoder, _data, _size, &error);
+
+        if ( (needed > 0) &&
+             (needed > _capacity) )
+        {
+            error.message = "buffer too small";
+        }
+        else if (needed > 0)
+        {
+            chain = d_filter_decoder_fill(&decoder, _buffer);
+        }
+    }
+
+    if (_error)
+    {
+        *_error = error;
+    }
+
+    return chain;
+}
+
+/*
+d_filter_chain_decode
+  Decodes a chain written by d_filter_chain_encode with a single
+allocation holding the chain, its operations, and its index lists. The
+input is validated completely before anything is allocated: the magic and
+version, truncation, operation types, varint overflow, predicate shapes,
+registry ids and argument counts, counts larger than the remaining input,
+and trailing bytes. The chain is released with d_filter_chain_free;
+d_filter_chain_add will not grow it.
+
+Parameter(s):
+  _data:  the encoding.
+  _size:  its size in bytes.
+  _error: receives the byte offset and a description of the first error;
+          may be NULL.
+Return:
+  A pointer to the chain, or NULL if the encoding is invalid or allocation
+failed.
+*/
+struct d_filter_chain*
+d_filter_chain_decode
+(
+    const void*                  _data,
+    size_t                       _size,
+    struct d_filter_parse_error* _error
+)
+{
+    struct d_filter_decoder     decoder;
+    struct d_filter_parse_error error;
+    struct d_filter_chain*      chain;
+    void*                       block;
+    size_t                      needed;
+
+    memset(&error, 0, sizeof(error));
+
+    chain = NULL;
+
+    // validate parameters
+    if (!_data)
+    {
+        error.message = "NULL data";
+    }
+    else
+    {
+        needed = d_filter_decoder_measure(&decoder, _data, _size, &error);
+
+        if (needed > 0)
+        {
+            block = d_functional_malloc(needed);
+
+            // ensure that memory allocation was successful
+            if (!block)
+            {
+                error.message = "out of memory";
+            }
+            else
+            {
+                chain = d_filter_decoder_fill(&decoder, block);
+
+                if (!chain)
+                {
+                    d_functional_free(block);
+                }
+            }
+        }
+    }
+
+    if (_error)
+    {
+        *_error = error;
+    }
+
+    return chain;
+}
+
+/*
+d_filter_chain_explain_analyze
+  Runs a chain over an input under a profiling session and reports, after
+the chain's d_filter_chain_to_string text, one row per operation - rows
+in and out, ticks, bytes allocated, and predicate calls (see
+d_profile_format_row) - and a total. The operations are only measured
+when the module is built with D_FUNCTIONAL_PROFILE; otherwise the report
+says so and gives the rows in and out of the whole chain.
+
+Parameter(s):
+  _chain:        the chain to run.
+  _input:        the input array.
+  _count:        the number of elements in the input.
+  _element_size: the size in bytes of each element.
+Return:
+  A newly allocated report the caller must free, or NULL if _chain is NULL
+or allocation failed.
+*/
+char*
+d_filter_chain_explain_analyze
+(
+    const struct d_filter_chain* _chain,
+    const void*                  _input,
+    size_t                       _count,
+    size_t                       _element_size
+)
+{
+    struct d_profile         profile;
+    struct d_profile_record* records;
+    struct d_filter_result*  result;
+    char*                    plan;
+    char*                    text;
+    size_t                   rows_out;
+    size_t                   capacity;
+    size_t                   length;
+    bool                     failed;
+#if defined(D_FUNCTIONAL_PROFILE)
+    struct d_profile_record  total;
+    char*                    operation;
+    char                     label[64];
+    size_t                   i;
+#endif
+
+    // validate parameters
+    if (!_chain)
+    {
+        return NULL;
+    }
+
+    plan    = d_filter_chain_to_string(_chain);
+    records = d_functional_malloc(((_chain->count > 0) ? _chain->count : 1) *
+                                  sizeof(struct d_profile_record));
+
+    // ensure that memory allocation was successful
+    if ( (!plan) ||
+         (!records) )
+    {
+        d_functional_free(plan);
+        d_functional_free(records);
+
+        return NULL;
+    }
+
+    d_profile_begin(&profile, records, _chain->count);
+    result = d_filter_apply_chain(_chain, _input, _count, _element_size);
+    d_profile_end(&profile);
+
+    failed   = (!result) ||
+               ( (result->status != D_FILTER_RESULT_SUCCESS) &&
+                 (result->status != D_FILTER_RESULT_EMPTY) );
+    rows_out = (failed) ? 0 : result->count;
+
+    if (result)
+    {
+        d_filter_result_free(result);
+        d_functional_free(result);
+    }
+
+    capacity = strlen(plan) + 64 + ((profile.count + 2) * D_PROFILE_ROW_MAX);
+    text     = d_functional_malloc(capacity);
+
+    // ensure that memory allocation was successful
+    if (!text)
+    {
+        d_functional_free(plan);
+        d_functional_free(records);
+
+        return NULL;
+    }
+
+    length = (size_t)snprintf(text, capacity, "EXPLAIN ANALYZE %s\n", plan);
+
+#if defined(D_FUNCTIONAL_PROFILE)
+    memset(&total, 0, sizeof(total));
+
+    for (i = 0; i < profile.count; i++)
+    {
+        operation = d_filter_operation_to_string(
+                        &_chain->operations[records[i].index]);
+
+        snprintf(label, sizeof(label), "#%lu %s",
+                 (unsigned long)records[i].index,
+                 (operation) ? operation : "?");
+        d_functional_free(operation);
+
+        length += (size_t)snprintf(text + length, capacity - length, "  ");
+        length += (size_t)d_profile_format_row(text + length,
+                                               capacity - length,
+                                               label,
+                                               &records[i]);
+        length += (size_t)snprintf(text + length, capacity - length, "\n");
+
+        total.elapsed_ticks   += records[i].elapsed_ticks;
+        total.bytes_allocated += records[i].bytes_allocated;
+        total.predicate_calls += records[i].predicate_calls;
+    }
+
+    total.rows_in  = _count;
+    total.rows_out = rows_out;
+
+    length += (size_t)snprintf(text + length, capacity - length, "  ");
+    length += (size_t)d_profile_format_row(text + length,
+                                           capacity - length,
+                                           "total",
+                                           &total);
+    length += (size_t)snprintf(text + length, capacity - length, "\n");
+#else
+    length += (size_t)snprintf(text + length, capacity - length,
+                               "  (operations not measured: built without "
+                               "D_FUNCTIONAL_PROFILE)\n"
+                               "  total rows %lu -> %lu\n",
+                               (unsigned long)_count,
+                               (unsigned long)rows_out);
+#endif
+
+    if (failed)
+    {
+        snprintf(text + length, capacity - length, "  (chain failed)\n");
+    }
+
+    d_functional_free(plan);
+    d_functional_free(records);
+
+    return text;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///             VIII. ITERATOR INTERFACE                                    ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_filter_iterator_new
+  Creates a new filter iterator. Precomputes matching indices by
+applying the filter chain and mapping results back to original
+positions.
+
+Parameter(s):
+  _chain:        the filter chain to iterate.
+  _input:        the source array.
+  _count:        the number of elements.
+  _element_size: the size in bytes of each element.
+Return:
+  A pointer to a newly allocated iterator, or NULL on failure.
+*/
+struct d_filter_iterator*
+d_filter_iterator_new
+(
+    const struct d_filter_chain* _chain,
+    const void*                  _input,
+    size_t                       _count,
+    size_t                       _element_size
+)
+{
+    struct d_filter_iterator* iter;
+    size_t                    idx_count;
+
+    iter = d_functional_malloc(sizeof(struct d_filter_iterator));
+
+    if (!iter)
+    {
+        return NULL;
+    }
+
+    iter->input         = _input;
+    iter->input_count   = _count;
+    iter->element_size  = _element_size;
+    iter->chain         = _chain;
+    iter->indices       = NULL;
+    iter->indices_count = 0;
+    iter->indices_pos   = 0;
+    iter->exhausted     = true;
+
+    // precompute matching indices
+    if ( (_chain) &&
+         (_input) &&
+         (_count > 0)        &&
+         (_element_size > 0) )
+    {
+        iter->indices = d_filter_get_indices(
+                            _chain, _input, _count,
+                            _element_size, &idx_count);
+        iter->indices_count = idx_count;
+        iter->exhausted     = (idx_count == 0);
+    }
+
+    return iter;
+}
+
+/*
+d_filter_iterator_has_next
+  Tests whether the iterator has more elements.
+
+Parameter(s):
+  _iter: the iterator to query.
+Return:
+  true if more elements are available.
+*/
+bool
+d_filter_iterator_has_next
+(
+    const struct d_filter_iterator* _iter
+)
+{
+    if (!_iter)
+    {
+        return false;
+    }
+
+    return (!_iter->exhausted);
+}
+
+/*
+d_filter_iterator_next
+  Advances the iterator and returns the next matching element.
+
+Parameter(s):
+  _iter: the iterator to advance.
+Return:
+  A pointer to the next matching element, or NULL if exhausted.
+*/
+void*
+d_filter_iterator_next
+(
+    struct d_filter_iterator* _iter
+)
+{
+    const char* bytes;
+    size_t      idx;
+    void*       element;
+
+    if ( (!_iter) ||
+         (_iter->exhausted) )
+    {
+        return NULL;
+    }
+
+    bytes   = (const char*)_iter->input;
+    idx     = _iter->indices[_iter->indices_pos];
+    element = (void*)(bytes + (idx * _iter->element_size));
+
+    _iter->indices_pos++;
+
+    if (_iter->indices_pos >= _iter->indices_count)
+    {
+        _iter->exhausted = true;
+    }
+
+    return element;
+}
+
+/*
+d_filter_iterator_reset
+  Resets the iterator to the beginning.
+
+Parameter(s):
+  _iter: the iterator to reset.
+Return:
+  none.
+*/
+void
+d_filter_iterator_reset
+(
+    struct d_filter_iterator* _iter
+)
+{
+    if (!_iter)
+    {
+        return;
+    }
+
+    _iter->indices_pos = 0;
+    _iter->exhausted   = (_iter->indices_count == 0);
+
+    return;
+}
+
+/*
+d_filter_iterator_free
+  Frees all resources owned by a filter iterator.
+
+Parameter(s):
+  _iter: the iterator to free; may be NULL.
+Return:
+  none.
+*/
+void
+d_filter_iterator_free
+(
+    struct d_filter_iterator* _iter
+)
+{
+    if (!_iter)
+    {
+        return;
+    }
+
+    if (_iter->indices)
+    {
+        d_functional_free(_iter->indices);
+    }
+
+    d_functional_free(_iter);
+
+    return;
+}
+
+/*
+d_filter_stream_grow
+  Internal helper growing a buffer to hold at least _count elements.
+*/
+static bool
+d_filter_stream_grow
+(
+    unsigned char** _buffer,
+    size_t*         _capacity,
+    size_t          _count,
+    size_t          _element_size
+)
+{
+    unsigned char* grown;
+    size_t         capacity;
+
+    if (_count <= *_capacity)
+    {
+        return true;
+    }
+
+    capacity = (*_capacity < 16) ? 16 : *_capacity;
+
+    while (capacity < _count)
+    {
+        capacity *= 2;
+    }
+
+    grown = d_functional_realloc(*_buffer, capacity * _element_size);
+
+    if (!grown)
+    {
+        return false;
+    }
+
+    *_buffer   = grown;
+    *_capacity = capacity;
+
+    return true;
+}
+
+/*
+d_filter_stream_is_exhausted
+  Internal helper reporting whether no further input can pass an
+operation.
+*/
+static bool
+d_filter_stream_is_exhausted
+(
+    const struct d_filter_operation*    _op,
+    const struct d_filter_stream_state* _state
+)
+{
+    switch (_op->type)
+    {
+    case D_FILTER_OP_TAKE_FIRST:
+    case D_FILTER_OP_HEAD:
+        return (_state->seen >= _op->params.count);
+
+    case D_FILTER_OP_RANGE:
+    case D_FILTER_OP_SLICE:
+        return ( (_state->seen >= _op->params.end) ||
+                 (_op->params.start >= _op->params.end) );
+
+    case D_FILTER_OP_INDICES:
+        if (!_op->params.indices)
+        {
+            return (_state->seen > _op->params.start);
+        }
+
+        return (_state->next_index >= _op->params.indices_count);
+
+    case D_FILTER_OP_TAKE_LAST:
+    case D_FILTER_OP_TAIL:
+    case D_FILTER_OP_TOP_K:
+        return (_op->params.count == 0);
+
+    default:
+        return false;
+    }
+}
+
+/*
+d_filter_stream_hold
+  Internal helper pushing an element into the bounded ring of a TAKE_LAST
+or SKIP_LAST operation. Once the ring holds _limit elements, the oldest
+is evicted into _evicted (if non-NULL) and *_was_evicted is set. _element
+and _evicted may alias.
+*/
+static bool
+d_filter_stream_hold
+(
+    struct d_filter_stream*       _stream,
+    struct d_filter_stream_state* _state,
+    size_t                        _limit,
+    const unsigned char*          _element,
+    unsigned char*                _evicted,
+    bool*                         _was_evicted
+)
+{
+    size_t         size;
+    unsigned char* slot;
+
+    size         = _stream->source.element_size;
+    *_was_evicted = false;
+
+    if (_limit == 0)
+    {
+        if (_evicted)
+        {
+            memmove(_evicted, _element, size);
+        }
+
+        *_was_evicted = true;
+
+        return true;
+    }
+
+    // filling: the ring is still linear
+    if (_state->held_count < _limit)
+    {
+        if (!d_filter_stream_grow(&_state->held,
+                                  &_state->held_capacity,
+                                  _state->held_count + 1,
+                                  size))
+        {
+            return false;
+        }
+
+        memcpy(_state->held + (_state->held_count * size), _element, size);
+        _state->held_count++;
+
+        return true;
+    }
+
+    slot = _state->held + (_state->head * size);
+
+    if (_evicted)
+    {
+        memcpy(_stream->element, _element, size);
+        memcpy(_evicted, slot, size);
+        memcpy(slot, _stream->element, size);
+    }
+    else
+    {
+        memcpy(slot, _element, size);
+    }
+
+    _state->head  = (_state->head + 1) % _limit;
+    *_was_evicted = true;
+
+    return true;
+}
+
+/*
+d_filter_stream_process
+  Internal helper feeding _n elements to operation _index of a stream.
+The passed elements are written to _output, which may equal _input; an
+operation never passes more elements than it receives.
+*/
+static bool
+d_filter_stream_process
+(
+    struct d_filter_stream* _stream,
+    size_t                  _index,
+    const unsigned char*    _input,
+    size_t                  _n,
+    unsigned char*          _output,
+    size_t*                 _out_count
+)
+{
+    const struct d_filter_operation* op;
+    struct d_filter_stream_state*    state;
+    const unsigned char*             element;
+    size_t                           size;
+    size_t                           kept;
+    size_t                           g;
+    size_t                           i;
+    size_t                           pos;
+    size_t                           total;
+    bool                             keep;
+    bool                             evicted;
+
+    op    = &_stream->chain->operations[_index];
+    state = &_stream->states[_index];
+    size  = _stream->source.element_size;
+    kept  = 0;
+
+    // top-k is applied per chunk below
+    for (i = 0; (op->type != D_FILTER_OP_TOP_K) && (i < _n); i++)
+    {
+        element = _input + (i * size);
+        g       = state->seen + i;
+        keep    = false;
+
+        switch (op->type)
+        {
+        case D_FILTER_OP_NONE:
+            keep = true;
+
+            break;
+
+        case D_FILTER_OP_TAKE_FIRST:
+        case D_FILTER_OP_HEAD:
+            keep = (g < op->params.count);
+
+            break;
+
+        case D_FILTER_OP_SKIP_FIRST:
+            keep = (g >= op->params.count);
+
+            break;
+
+        case D_FILTER_OP_REST:
+            keep = (g >= 1);
+
+            break;
+
+        case D_FILTER_OP_TAKE_NTH:
+            keep = ((g % ((op->params.step == 0) ? 1 : op->params.step)) == 0);
+
+            break;
+
+        case D_FILTER_OP_RANGE:
+            keep = ( (g >= op->params.start) &&
+                     (g < op->params.end) );
+
+            break;
+
+        case D_FILTER_OP_SLICE:
+            keep = ( (g >= op->params.start) &&
+                     (g < op->params.end)    &&
+                     (((g - op->params.start) %
+                       ((op->params.step == 0) ? 1 : op->params.step)) == 0) );
+
+            break;
+
+        case D_FILTER_OP_WHERE:
+        case D_FILTER_OP_WHERE_NOT:
+            keep = op->params.test(element, op->params.context);
+
+            if (op->type == D_FILTER_OP_WHERE_NOT)
+            {
+                keep = !keep;
+            }
+
+            break;
+
+        case D_FILTER_OP_INDICES:
+            if (!op->params.indices)
+            {
+                keep = (g == op->params.start);
+
+                break;
+            }
+
+            if ( (state->next_index < op->params.indices_count) &&
+                 (op->params.indices[state->next_index] == g) )
+            {
+                keep = true;
+                state->next_index++;
+            }
+
+            break;
+
+        case D_FILTER_OP_DISTINCT:
+            pos = (state->held_count == 0)
+                  ? 0
+                  : d_functional_lower_bound(state->held,
+                                             state->held_count,
+                                             size,
+                                             element,
+                                             op->params.comparator,
+                                             op->params.context);
+
+            if ( (pos < state->held_count) &&
+                 (op->params.comparator(element,
+                                        state->held + (pos * size),
+                                        op->params.context) == 0) )
+            {
+                break;
+            }
+
+            if (!d_filter_stream_grow(&state->held,
+                                      &state->held_capacity,
+                                      state->held_count + 1,
+                                      size))
+            {
+                return false;
+            }
+
+            memmove(state->held + ((pos + 1) * size),
+                    state->held + (pos * size),
+                    (state->held_count - pos) * size);
+            memcpy(state->held + (pos * size), element, size);
+            state->held_count++;
+            keep = true;
+
+            break;
+
+        case D_FILTER_OP_TAKE_LAST:
+        case D_FILTER_OP_TAIL:
+            if (!d_filter_stream_hold(_stream,
+                                      state,
+                                      op->params.count,
+                                      element,
+                                      NULL,
+                                      &evicted))
+            {
+                return false;
+            }
+
+            break;
+
+        case D_FILTER_OP_SKIP_LAST:
+        case D_FILTER_OP_INIT:
+            if (!d_filter_stream_hold(_stream,
+                                      state,
+                                      (op->type == D_FILTER_OP_INIT)
+                                          ? 1
+                                          : op->params.count,
+                                      element,
+                                      _output + (kept * size),
+                                      &evicted))
+            {
+                return false;
+            }
+
+            // the evicted element is already in place
+            kept += (evicted) ? 1 : 0;
+
+            break;
+
+        default:
+            return false;
+        }
+
+        if (keep)
+        {
+            if (_output + (kept * size) != element)
+            {
+                memmove(_output + (kept * size), element, size);
+            }
+
+            kept++;
+        }
+    }
+
+    // top-k keeps the best k of the candidates so far and this chunk
+    if ( (op->type == D_FILTER_OP_TOP_K) &&
+         (op->params.count > 0) )
+    {
+        total = state->held_count + _n;
+
+        if ( (!d_filter_stream_grow(&state->scratch,
+                                    &state->scratch_capacity,
+                                    total,
+                                    size))                        ||
+             (!d_filter_stream_grow(&state->held,
+                                    &state->held_capacity,
+                                    (op->params.count < total)
+                                        ? op->params.count
+                                        : total,
+                                    size)) )
+        {
+            return false;
+        }
+
+        memcpy(state->scratch, state->held, state->held_count * size);
+        memcpy(state->scratch + (state->held_count * size),
+               _input,
+               _n * size);
+
+        state->held_count = d_functional_top_k(state->scratch,
+                                               total,
+                                               size,
+                                               op->params.count,
+                                               state->held,
+                                               op->params.comparator,
+                                               op->params.context);
+    }
+
+    state->seen     += _n;
+    state->exhausted = d_filter_stream_is_exhausted(op, state);
+    *_out_count      = kept;
+
+    return true;
+}
+
+/*
+d_filter_stream_flush
+  Internal helper returning the elements operation _index still holds at
+the end of the input.
+*/
+static bool
+d_filter_stream_flush
+(
+    struct d_filter_stream* _stream,
+    size_t                  _index,
+    const unsigned char**   _data,
+    size_t*                 _count
+)
+{
+    const struct d_filter_operation* op;
+    struct d_filter_stream_state*    state;
+    size_t                           size;
+    size_t                           tail;
+
+    op     = &_stream->chain->operations[_index];
+    state  = &_stream->states[_index];
+    size   = _stream->source.element_size;
+    *_data  = NULL;
+    *_count = 0;
+
+    switch (op->type)
+    {
+    case D_FILTER_OP_TAKE_LAST:
+    case D_FILTER_OP_TAIL:
+        // nothing held: the buffers may not even exist
+        if (state->held_count == 0)
+        {
+            return true;
+        }
+
+        if (!d_filter_stream_grow(&state->scratch,
+                                  &state->scratch_capacity,
+                                  state->held_count,
+                                  size))
+        {
+            return false;
+        }
+
+        // unroll the ring, oldest first
+        tail = state->held_count - state->head;
+        memcpy(state->scratch,
+               state->held + (state->head * size),
+               tail * size);
+        memcpy(state->scratch + (tail * size),
+               state->held,
+               state->head * size);
+
+        *_data  = state->scratch;
+        *_count = state->held_count;
+
+        break;
+
+    case D_FILTER_OP_TOP_K:
+        *_data  = state->held;
+        *_count = state->held_count;
+
+        break;
+
+    default:
+        break;
+    }
+
+    return true;
+}
+
+/*
+d_filter_stream_run
+  Internal helper passing _n elements through operations _first onward.
+The result is left in the stream's working buffer (or is _input itself
+if no operation ran).
+*/
+static bool
+d_filter_stream_run
+(
+    struct d_filter_stream* _stream,
+    size_t                  _first,
+    const unsigned char*    _input,
+    size_t                  _n,
+    const unsigned char**   _result,
+    size_t*                 _result_count
+)
+{
+    const unsigned char* data;
+    size_t               i;
+
+    data = _input;
+
+    if ( (_first < _stream->chain->count) &&
+         (!d_filter_stream_grow(&_stream->buffer,
+                                &_stream->buffer_capacity,
+                                _n,
+                                _stream->source.element_size)) )
+    {
+        return false;
+    }
+
+    for (i = _first; (i < _stream->chain->count) && (_n > 0); i++)
+    {
+        if (!d_filter_stream_process(_stream,
+                                     i,
+                                     data,
+                                     _n,
+                                     _stream->buffer,
+                                     &_n))
+        {
+            return false;
+        }
+
+        data = _stream->buffer;
+    }
+
+    *_result       = data;
+    *_result_count = _n;
+
+    return true;
+}
+
+/*
+d_filter_stream_new
+  Creates a stream applying a filter chain to a chunked source.
+
+Parameter(s):
+  _chain:  the filter chain; must outlive the stream.
+  _source: the input; must outlive the stream.
+Return:
+  A pointer to the new stream, or NULL if a parameter is invalid, the
+chain contains an operation that needs the whole input (REVERSE, or
+at_indices with indices that are not strictly increasing) or lacks its
+predicate / comparator, or allocation failed.
+*/
+struct d_filter_stream*
+d_filter_stream_new
+(
+    const struct d_filter_chain* _chain,
+    struct d_functional_source   _source
+)
+{
+    struct d_filter_stream*          stream;
+    const struct d_filter_operation* op;
+    size_t                           i;
+    size_t                           j;
+
+    if ( (!_chain)                   ||
+         (!_source.next_chunk)       ||
+         (_source.element_size == 0) )
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < _chain->count; i++)
+    {
+        op = &_chain->operations[i];
+
+        switch (op->type)
+        {
+        case D_FILTER_OP_REVERSE:
+            return NULL;
+
+        case D_FILTER_OP_WHERE:
+        case D_FILTER_OP_WHERE_NOT:
+            if (!op->params.test)
+            {
+                return NULL;
+            }
+
+            break;
+
+        case D_FILTER_OP_DISTINCT:
+        case D_FILTER_OP_TOP_K:
+            if (!op->params.comparator)
+            {
+                return NULL;
+            }
+
+            break;
+
+        case D_FILTER_OP_INDICES:
+            for (j = 1; (op->params.indices) &&
+                        (j < op->params.indices_count); j++)
+            {
+                if (op->params.indices[j] <= op->params.indices[j - 1])
+                {
+                    return NULL;
+                }
+            }
+
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    stream = d_functional_malloc(sizeof(struct d_filter_stream));
+
+    if (!stream)
+    {
+        return NULL;
+    }
+
+    memset(stream, 0, sizeof(*stream));
+    stream->chain   = _chain;
+    stream->source  = _source;
+    stream->element = d_functional_malloc(_source.element_size);
+    stream->states  = d_functional_calloc(
+        (_chain->count == 0) ? 1 : _chain->count,
+        sizeof(struct d_filter_stream_state));
+
+    if ( (!stream->element) ||
+         (!stream->states) )
+    {
+        d_filter_stream_free(stream);
+
+        return NULL;
+    }
+
+    for (i = 0; i < _chain->count; i++)
+    {
+        stream->states[i].exhausted = d_filter_stream_is_exhausted(
+                                          &_chain->operations[i],
+                                          &stream->states[i]);
+    }
+
+    return stream;
+}
+
+/*
+d_filter_stream_next
+  Pulls chunks from the source through the chain until some output is
+produced, and returns it. At the end of the input, the elements held by
+take_last, skip_last, and top_k operations are flushed through the rest
+of the chain and returned as one final chunk.
+
+Parameter(s):
+  _stream: the stream.
+  _chunk:  receives the output chunk; valid until the next call or until
+           the stream is freed.
+  _count:  receives the number of elements in the chunk; 0 at the end.
+Return:
+  true if a chunk (or the end of the output) was returned, or false if a
+parameter was NULL or the source or an operation failed; error_code is
+then set.
+*/
+bool
+d_filter_stream_next
+(
+    struct d_filter_stream* _stream,
+    const void**            _chunk,
+    size_t*                 _count
+)
+{
+    const void*          pulled;
+    const unsigned char* data;
+    size_t               n;
+    size_t               i;
+    size_t               size;
+
+    if ( (!_stream)                  ||
+         (_stream->error_code != 0)  ||
+         (!_chunk)                   ||
+         (!_count) )
+    {
+        return false;
+    }
 
-        case D_FILTER_OP_RANGE:
-            if ( (op->params.start < estimated) &&
-                 (op->params.end > op->params.start) )
-            {
-                size_t range = op->params.end - op->params.start;
+    *_chunk = NULL;
+    *_count = 0;
+    size    = _stream->source.element_size;
 
-                if (range < estimated)
-                {
-                    estimated = range;
-                }
-            }
-            else
+    while (!_stream->finished)
+    {
+        // nothing more can pass an exhausted operation
+        for (i = 0; i < _stream->chain->count; i++)
+        {
+            if (_stream->states[i].exhausted)
             {
-                estimated = 0;
+                _stream->finished = true;
             }
+        }
 
+        if (_stream->finished)
+        {
             break;
+        }
 
-        case D_FILTER_OP_INDICES:
-            if (op->params.indices_count < estimated)
-            {
-                estimated = op->params.indices_count;
-            }
+        if (!d_functional_source_next(&_stream->source, &pulled, &n))
+        {
+            _stream->error_code = -1;
 
-            break;
+            return false;
+        }
+
+        if (n == 0)
+        {
+            _stream->finished = true;
 
-        default:
-            // WHERE, DISTINCT, etc. are data-dependent;
-            // keep current estimate
             break;
         }
-    }
 
-    return estimated;
-}
+        if (!d_filter_stream_run(_stream,
+                                 0,
+                                 (const unsigned char*)pulled,
+                                 n,
+                                 &data,
+                                 &n))
+        {
+            _stream->error_code = -1;
 
+            return false;
+        }
 
-///////////////////////////////////////////////////////////////////////////////
-///             VIII. ITERATOR INTERFACE                                    ///
-///////////////////////////////////////////////////////////////////////////////
+        if (n > 0)
+        {
+            *_chunk = data;
+            *_count = n;
 
-/*
-d_filter_iterator_new
-  Creates a new filter iterator. Precomputes matching indices by
-applying the filter chain and mapping results back to original
-positions.
+            return true;
+        }
+    }
 
-Parameter(s):
-  _chain:        the filter chain to iterate.
-  _input:        the source array.
-  _count:        the number of elements.
-  _element_size: the size in bytes of each element.
-Return:
-  A pointer to a newly allocated iterator, or NULL on failure.
-*/
-struct d_filter_iterator*
-d_filter_iterator_new
-(
-    const struct d_filter_chain* _chain,
-    const void*                  _input,
-    size_t                       _count,
-    size_t                       _element_size
-)
-{
-    struct d_filter_iterator* iter;
-    size_t                    idx_count;
+    if (_stream->flushed)
+    {
+        return true;
+    }
 
-    iter = malloc(sizeof(struct d_filter_iterator));
+    _stream->flushed      = true;
+    _stream->output_count = 0;
 
-    if (!iter)
+    // flush each operation through the operations after it
+    for (i = 0; i < _stream->chain->count; i++)
     {
-        return NULL;
-    }
+        if ( (!d_filter_stream_flush(_stream, i, &data, &n))  ||
+             (!d_filter_stream_run(_stream, i + 1, data, n, &data, &n)) ||
+             (!d_filter_stream_grow(&_stream->output,
+                                    &_stream->output_capacity,
+                                    _stream->output_count + n,
+                                    size)) )
+        {
+            _stream->error_code = -1;
 
-    iter->input         = _input;
-    iter->input_count   = _count;
-    iter->element_size  = _element_size;
-    iter->chain         = _chain;
-    iter->indices       = NULL;
-    iter->indices_count = 0;
-    iter->indices_pos   = 0;
-    iter->exhausted     = true;
+            return false;
+        }
 
-    // precompute matching indices
-    if ( (_chain) &&
-         (_input) &&
-         (_count > 0)        &&
-         (_element_size > 0) )
+        if (n > 0)
+        {
+            memcpy(_stream->output + (_stream->output_count * size),
+                   data,
+                   n * size);
+            _stream->output_count += n;
+        }
+    }
+
+    if (_stream->output_count > 0)
     {
-        iter->indices = d_filter_get_indices(
-                            _chain, _input, _count,
-                            _element_size, &idx_count);
-        iter->indices_count = idx_count;
-        iter->exhausted     = (idx_count == 0);
+        *_chunk = _stream->output;
+        *_count = _stream->output_count;
     }
 
-    return iter;
+    return true;
 }
 
 /*
-d_filter_iterator_has_next
-  Tests whether the iterator has more elements.
+d_filter_stream_source_next
+  Internal fn_source_next adapting a filter stream to a source.
+*/
+static bool
+d_filter_stream_source_next
+(
+    void*        _context,
+    const void** _chunk,
+    size_t*      _count
+)
+{
+    return d_filter_stream_next((struct d_filter_stream*)_context,
+                                _chunk,
+                                _count);
+}
+
+/*
+d_filter_stream_source
+  Returns a source yielding a filter stream's output, so that it can feed
+a d_functional_stream or another filter stream.
 
 Parameter(s):
-  _iter: the iterator to query.
+  _stream: the filter stream; must outlive the source.
 Return:
-  true if more elements are available.
+  The source, whose next_chunk is NULL if _stream is NULL.
 */
-bool
-d_filter_iterator_has_next
+struct d_functional_source
+d_filter_stream_source
 (
-    const struct d_filter_iterator* _iter
+    struct d_filter_stream* _stream
 )
 {
-    if (!_iter)
-    {
-        return false;
-    }
+    struct d_functional_source source;
 
-    return (!_iter->exhausted);
+    source.next_chunk   = (_stream) ? d_filter_stream_source_next : NULL;
+    source.context      = _stream;
+    source.element_size = (_stream) ? _stream->source.element_size : 0;
+
+    return source;
 }
 
 /*
-d_filter_iterator_next
-  Advances the iterator and returns the next matching element.
+d_filter_apply_chain_source
+  Applies a filter chain to a chunked source, collecting the output. Only
+the output and the chain's carried state are held in memory, never the
+whole input.
 
 Parameter(s):
-  _iter: the iterator to advance.
+  _chain:  the filter chain to apply.
+  _source: the input.
 Return:
-  A pointer to the next matching element, or NULL if exhausted.
+  A d_filter_result containing the filtered elements and status; the
+status is D_FILTER_RESULT_INVALID if the chain cannot be streamed (see
+d_filter_stream_new).
 */
-void*
-d_filter_iterator_next
+struct d_filter_result*
+d_filter_apply_chain_source
 (
-    struct d_filter_iterator* _iter
+    const struct d_filter_chain* _chain,
+    struct d_functional_source   _source
 )
 {
-    const char* bytes;
-    size_t      idx;
-    void*       element;
+    struct d_filter_result* result;
+    struct d_filter_stream* stream;
+    unsigned char*          elements;
+    const void*             chunk;
+    size_t                  n;
+    size_t                  capacity;
+    size_t                  size;
 
-    if ( (!_iter) ||
-         (_iter->exhausted) )
+    result = d_functional_malloc(sizeof(struct d_filter_result));
+
+    if (!result)
     {
         return NULL;
     }
 
-    bytes   = (const char*)_iter->input;
-    idx     = _iter->indices[_iter->indices_pos];
-    element = (void*)(bytes + (idx * _iter->element_size));
+    memset(result, 0, sizeof(*result));
 
-    _iter->indices_pos++;
+    stream = d_filter_stream_new(_chain, _source);
 
-    if (_iter->indices_pos >= _iter->indices_count)
+    if (!stream)
     {
-        _iter->exhausted = true;
+        result->status = D_FILTER_RESULT_INVALID;
+
+        return result;
     }
 
-    return element;
-}
+    size     = _source.element_size;
+    elements = NULL;
+    capacity = 0;
 
-/*
-d_filter_iterator_reset
-  Resets the iterator to the beginning.
+    while (d_filter_stream_next(stream, &chunk, &n))
+    {
+        if (n == 0)
+        {
+            break;
+        }
 
-Parameter(s):
-  _iter: the iterator to reset.
-Return:
-  none.
-*/
-void
-d_filter_iterator_reset
-(
-    struct d_filter_iterator* _iter
-)
-{
-    if (!_iter)
+        if (!d_filter_stream_grow(&elements,
+                                  &capacity,
+                                  result->count + n,
+                                  size))
+        {
+            stream->error_code = -1;
+
+            break;
+        }
+
+        memcpy(elements + (result->count * size),
+               chunk,
+               n * size);
+        result->count += n;
+    }
+
+    // an empty result still carries an allocation, as d_filter_apply_chain
+    if ( (stream->error_code == 0) &&
+         (!elements)               &&
+         (!d_filter_stream_grow(&elements,
+                                &capacity,
+                                1,
+                                size)) )
     {
-        return;
+        stream->error_code = -1;
     }
 
-    _iter->indices_pos = 0;
-    _iter->exhausted   = (_iter->indices_count == 0);
+    result->elements = elements;
 
-    return;
+    if (stream->error_code != 0)
+    {
+        result->status = D_FILTER_RESULT_ERROR;
+    }
+    else
+    {
+        result->status = (result->count == 0)
+                         ? D_FILTER_RESULT_EMPTY
+                         : D_FILTER_RESULT_SUCCESS;
+    }
+
+    d_filter_stream_free(stream);
+
+    return result;
 }
 
 /*
-d_filter_iterator_free
-  Frees all resources owned by a filter iterator.
+d_filter_stream_free
+  Frees a filter stream and its carried state. Does not free the chain or
+the source.
 
 Parameter(s):
-  _iter: the iterator to free; may be NULL.
+  _stream: the stream to free; may be NULL.
 Return:
   none.
 */
 void
-d_filter_iterator_free
+d_filter_stream_free
 (
-    struct d_filter_iterator* _iter
+    struct d_filter_stream* _stream
 )
 {
-    if (!_iter)
+    size_t i;
+
+    if (!_stream)
     {
         return;
     }
 
-    if (_iter->indices)
+    if (_stream->states)
     {
-        free(_iter->indices);
+        for (i = 0; i < _stream->chain->count; i++)
+        {
+            d_functional_free(_stream->states[i].held);
+            d_functional_free(_stream->states[i].scratch);
+        }
+
+        d_functional_free(_stream->states);
     }
 
-    free(_iter);
+    d_functional_free(_stream->buffer);
+    d_functional_free(_stream->output);
+    d_functional_free(_stream->element);
+    d_functional_free(_stream);
 
     return;
 }
@@ -4031,7 +8005,7 @@ d_filter_builder_new
 {
     struct d_filter_builder* builder;
 
-    builder = malloc(sizeof(struct d_filter_builder));
+    builder = d_functional_malloc(sizeof(struct d_filter_builder));
 
     if (!builder)
     {
@@ -4044,7 +8018,7 @@ d_filter_builder_new
 
     if (!builder->chain)
     {
-        free(builder);
+        d_functional_free(builder);
 
         return NULL;
     }
@@ -4069,7 +8043,7 @@ d_filter_builder_from_chain
 {
     struct d_filter_builder* builder;
 
-    builder = malloc(sizeof(struct d_filter_builder));
+    builder = d_functional_malloc(sizeof(struct d_filter_builder));
 
     if (!builder)
     {
@@ -4277,6 +8251,63 @@ d_filter_builder_where_not
     return d_filter_builder_add_op_internal(_builder, d_filter_where_not(_test));
 }
 
+/*
+d_filter_builder_where_monotone
+  Adds a monotone where operation to the builder.
+
+Parameter(s):
+  _builder: the builder.
+  _test:    the predicate function.
+  _context: the context pointer passed to the predicate.
+  _shape:   how the predicate changes along the sorted order.
+Return:
+  The builder pointer for chaining.
+*/
+D_INLINE struct d_filter_builder*
+d_filter_builder_where_monotone
+(
+    struct d_filter_builder* _builder,
+    fn_predicate             _test,
+    void*                    _context,
+    enum d_filter_monotone   _shape
+)
+{
+    return d_filter_builder_add_op_internal(_builder, d_filter_where_monotone(_test, _context, _shape));
+}
+
+/*
+d_filter_builder_sorted
+  Records on the builder's chain that its inputs are sorted.
+
+Parameter(s):
+  _builder:    the builder.
+  _comparator: the order of the input, or NULL to clear the hint.
+  _context:    the context the order's comparator is called with.
+Return:
+  The builder pointer for chaining.
+*/
+struct d_filter_builder*
+d_filter_builder_sorted
+(
+    struct d_filter_builder* _builder,
+    fn_function_comparator   _comparator,
+    void*                    _context
+)
+{
+    if ( (!_builder) ||
+         (_builder->error_code != 0) )
+    {
+        return _builder;
+    }
+
+    if (!d_filter_chain_set_sorted(_builder->chain, _comparator, _context))
+    {
+        _builder->error_code = -1;
+    }
+
+    return _builder;
+}
+
 /*
 d_filter_builder_range
   Adds a range operation to the builder.
@@ -4362,6 +8393,30 @@ d_filter_builder_reverse
     return d_filter_builder_add_op_internal(_builder, d_filter_reverse());
 }
 
+/*
+d_filter_builder_top_k
+  Adds a top-k operation to the builder.
+
+Parameter(s):
+  _builder:    the builder.
+  _k:          the number of elements to keep.
+  _comparator: the comparator defining the order.
+  _context:    context passed to the comparator; may be NULL.
+Return:
+  The builder pointer for chaining.
+*/
+D_INLINE struct d_filter_builder*
+d_filter_builder_top_k
+(
+    struct d_filter_builder* _builder,
+    size_t                   _k,
+    fn_function_comparator   _comparator,
+    void*                    _context
+)
+{
+    return d_filter_builder_add_op_internal(_builder, d_filter_top_k(_k, _comparator, _context));
+}
+
 /*
 d_filter_builder_at
   Adds a single-index selection operation to the builder.
@@ -4456,7 +8511,7 @@ d_filter_builder_apply
 {
     struct d_filter_result* result;
 
-    result = malloc(sizeof(struct d_filter_result));
+    result = d_functional_malloc(sizeof(struct d_filter_result));
 
     if (!result)
     {
@@ -4491,7 +8546,7 @@ d_filter_builder_apply
         // transfer ownership
         *(result) = *(chain_result);
 
-        free(chain_result);
+        d_functional_free(chain_result);
     }
 
     return result;
@@ -4593,10 +8648,10 @@ d_filter_builder_free
 
     if (_builder->error_message)
     {
-        free(_builder->error_message);
+        d_functional_free(_builder->error_message);
     }
 
-    free(_builder);
+    d_functional_free(_builder);
 
     return;
 }
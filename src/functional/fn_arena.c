@@ -0,0 +1,242 @@
+#include "..\..\inc\functional\fn_arena.h"
+
+
+// size of a chunk header, rounded so that chunk data starts aligned
+#define D_FN_ARENA_HEADER_SIZE                                              \
+    ( (sizeof(struct d_fn_arena_chunk) + (D_FN_ARENA_ALIGNMENT - 1)) &      \
+      ~(size_t)(D_FN_ARENA_ALIGNMENT - 1) )
+
+
+/*
+d_fn_arena_chunk_new
+  Internal helper allocating a chunk with _capacity usable bytes.
+*/
+static struct d_fn_arena_chunk*
+d_fn_arena_chunk_new
+(
+    size_t _capacity
+)
+{
+    struct d_fn_arena_chunk* chunk;
+
+    chunk = malloc(D_FN_ARENA_HEADER_SIZE + _capacity);
+
+    // ensure that memory allocation was successful
+    if (!chunk)
+    {
+        return NULL;
+    }
+
+    chunk->next     = NULL;
+    chunk->capacity = _capacity;
+    chunk->used     = 0;
+
+    return chunk;
+}
+
+/*
+d_fn_arena_new
+  Creates an arena with one empty chunk.
+
+Parameter(s):
+  _chunk_size: usable bytes per chunk; 0 selects
+               D_FN_ARENA_DEFAULT_CHUNK_SIZE.
+Return:
+  A pointer to a newly allocated d_fn_arena, or NULL if allocation failed.
+*/
+struct d_fn_arena*
+d_fn_arena_new
+(
+    size_t _chunk_size
+)
+{
+    struct d_fn_arena* arena;
+
+    if (_chunk_size == 0)
+    {
+        _chunk_size = D_FN_ARENA_DEFAULT_CHUNK_SIZE;
+    }
+
+    arena = malloc(sizeof(struct d_fn_arena));
+
+    // ensure that memory allocation was successful
+    if (!arena)
+    {
+        return NULL;
+    }
+
+    arena->head = d_fn_arena_chunk_new(_chunk_size);
+
+    if (!arena->head)
+    {
+        free(arena);
+
+        return NULL;
+    }
+
+    arena->chunk_size      = _chunk_size;
+    arena->bytes_allocated = 0;
+    arena->allocations     = 0;
+
+    return arena;
+}
+
+/*
+d_fn_arena_alloc
+  Allocates _size bytes from an arena, aligned to D_FN_ARENA_ALIGNMENT. The
+memory is not zeroed and stays valid until the arena is reset or freed.
+
+Parameter(s):
+  _arena: the arena.
+  _size:  number of bytes to allocate; must be non-zero.
+Return:
+  A pointer to the allocated memory, or NULL if _arena was NULL, _size was
+0, or a new chunk could not be allocated.
+*/
+void*
+d_fn_arena_alloc
+(
+    struct d_fn_arena* _arena,
+    size_t             _size
+)
+{
+    struct d_fn_arena_chunk* chunk;
+    size_t                   rounded;
+    void*                    result;
+
+    // validate parameters
+    if ( (!_arena) ||
+         (_size == 0) )
+    {
+        return NULL;
+    }
+
+    rounded = (_size + (D_FN_ARENA_ALIGNMENT - 1)) &
+              ~(size_t)(D_FN_ARENA_ALIGNMENT - 1);
+
+    // overflow of the rounding
+    if (rounded < _size)
+    {
+        return NULL;
+    }
+
+    chunk = _arena->head;
+
+    if (rounded > (chunk->capacity - chunk->used))
+    {
+        if (rounded > _arena->chunk_size)
+        {
+            // oversized request: dedicated chunk behind the head, so the
+            // head keeps serving small requests
+            chunk = d_fn_arena_chunk_new(rounded);
+
+            if (!chunk)
+            {
+                return NULL;
+            }
+
+            chunk->next        = _arena->head->next;
+            _arena->head->next = chunk;
+        }
+        else
+        {
+            chunk = d_fn_arena_chunk_new(_arena->chunk_size);
+
+            if (!chunk)
+            {
+                return NULL;
+            }
+
+            chunk->next  = _arena->head;
+            _arena->head = chunk;
+        }
+    }
+
+    result       = (unsigned char*)chunk +
+                   D_FN_ARENA_HEADER_SIZE +
+                   chunk->used;
+    chunk->used += rounded;
+
+    _arena->bytes_allocated += _size;
+    _arena->allocations++;
+
+    return result;
+}
+
+/*
+d_fn_arena_reset
+  Releases every allocation of an arena at once. The head chunk is kept for
+reuse; all other chunks are freed.
+
+Parameter(s):
+  _arena: the arena; may be NULL.
+Return:
+  none.
+*/
+void
+d_fn_arena_reset
+(
+    struct d_fn_arena* _arena
+)
+{
+    struct d_fn_arena_chunk* chunk;
+    struct d_fn_arena_chunk* next;
+
+    if (!_arena)
+    {
+        return;
+    }
+
+    chunk = _arena->head->next;
+
+    while (chunk)
+    {
+        next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+
+    _arena->head->next      = NULL;
+    _arena->head->used      = 0;
+    _arena->bytes_allocated = 0;
+    _arena->allocations     = 0;
+
+    return;
+}
+
+/*
+d_fn_arena_free
+  Frees an arena and every allocation made from it.
+
+Parameter(s):
+  _arena: the arena to free; may be NULL.
+Return:
+  none.
+*/
+void
+d_fn_arena_free
+(
+    struct d_fn_arena* _arena
+)
+{
+    struct d_fn_arena_chunk* chunk;
+    struct d_fn_arena_chunk* next;
+
+    if (!_arena)
+    {
+        return;
+    }
+
+    chunk = _arena->head;
+
+    while (chunk)
+    {
+        next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+
+    free(_arena);
+
+    return;
+}
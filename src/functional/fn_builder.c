@@ -20,7 +20,7 @@ d_fn_builder_new
 {
     struct d_fn_builder* builder;
 
-    builder = malloc(sizeof(struct d_fn_builder));
+    builder = d_functional_malloc(sizeof(struct d_fn_builder));
 
     // check allocation
     if (!builder)
@@ -35,23 +35,23 @@ d_fn_builder_new
     builder->capacity        = 0;
 
     // pre-allocate arrays
-    builder->transforms = malloc(D_FN_BUILDER_INITIAL_CAPACITY * 
-                                 sizeof(fn_transformer));
+    builder->transforms = d_functional_malloc(D_FN_BUILDER_INITIAL_CAPACITY * 
+                                              sizeof(fn_transformer));
 
     if (!builder->transforms)
     {
-        free(builder);
+        d_functional_free(builder);
 
         return NULL;
     }
 
-    builder->predicates = malloc(D_FN_BUILDER_INITIAL_CAPACITY *
-                                 sizeof(fn_predicate));
+    builder->predicates = d_functional_malloc(D_FN_BUILDER_INITIAL_CAPACITY *
+                                              sizeof(fn_predicate));
 
     if (!builder->predicates)
     {
-        free(builder->transforms);
-        free(builder);
+        d_functional_free(builder->transforms);
+        d_functional_free(builder);
 
         return NULL;
     }
@@ -96,7 +96,7 @@ d_fn_builder_grow
         new_capacity = _min_count;
     }
 
-    new_transforms = (fn_transformer*)realloc(
+    new_transforms = (fn_transformer*)d_functional_realloc(
                          _builder->transforms,
                          new_capacity * sizeof(fn_transformer));
 
@@ -107,7 +107,7 @@ d_fn_builder_grow
 
     _builder->transforms = new_transforms;
 
-    new_predicates = (fn_predicate*)realloc(
+    new_predicates = (fn_predicate*)d_functional_realloc(
                          _builder->predicates,
                          new_capacity * sizeof(fn_predicate));
 
@@ -242,6 +242,167 @@ d_funtional_builder_where
     return d_funtional_builder_filter(_builder, _test);
 }
 
+#if defined(D_FUNCTIONAL_PROFILE)
+
+// d_fn_builder_stage_stats
+//   struct: measurements of one stage of a profiled execution.
+struct d_fn_builder_stage_stats
+{
+    size_t   rows_in;
+    size_t   rows_out;
+    uint64_t ticks;
+};
+
+/*
+d_fn_builder_execute_profiled
+  Internal helper: d_fn_builder_execute with every transformer and
+predicate call timed, reporting one record per stage: the transformers in
+order, then the predicates. The element-at-a-time order of the calls, and
+so the result, is the same as the unprofiled path.
+*/
+static bool
+d_fn_builder_execute_profiled
+(
+    const struct d_fn_builder* _builder,
+    const void*                _input,
+    size_t                     _count,
+    size_t                     _element_size,
+    void*                      _output,
+    size_t*                    _out_count
+)
+{
+    struct d_fn_builder_stage_stats* stats;
+    unsigned char*                   slots;
+    const unsigned char*             current;
+    unsigned char*                   destination;
+    const unsigned char*             in_bytes;
+    unsigned char*                   out_bytes;
+    size_t                           stage_count;
+    size_t                           out_count;
+    size_t                           i;
+    size_t                           t;
+    uint64_t                         start;
+    bool                             passes;
+    bool                             ok;
+
+    stage_count = _builder->transform_count + _builder->predicate_count;
+    stats       = d_functional_calloc((stage_count > 0) ? stage_count : 1,
+                                      sizeof(*stats));
+    slots       = d_functional_malloc(2 * _element_size);
+
+    // ensure that memory allocation was successful
+    if ( (!stats) ||
+         (!slots) )
+    {
+        d_functional_free(stats);
+        d_functional_free(slots);
+
+        *(_out_count) = 0;
+
+        return false;
+    }
+
+    in_bytes  = (const unsigned char*)_input;
+    out_bytes = (unsigned char*)_output;
+    out_count = 0;
+    ok        = true;
+
+    for (i = 0; (ok) && (i < _count); i++)
+    {
+        current = in_bytes + (i * _element_size);
+
+        // transformers, alternating between the two slots
+        for (t = 0; t < _builder->transform_count; t++)
+        {
+            destination = slots + ((t & 1) * _element_size);
+            memset(destination, 0, _element_size);
+
+            stats[t].rows_in++;
+            start = d_functional_ticks();
+            ok    = _builder->transforms[t](current, destination, NULL);
+            stats[t].ticks += d_functional_ticks() - start;
+
+            if (!ok)
+            {
+                break;
+            }
+
+            stats[t].rows_out++;
+            current = destination;
+        }
+
+        if (!ok)
+        {
+            break;
+        }
+
+        // predicates (conjunction)
+        passes = true;
+
+        for (t = 0; t < _builder->predicate_count; t++)
+        {
+            struct d_fn_builder_stage_stats* stage;
+
+            stage = &stats[_builder->transform_count + t];
+
+            stage->rows_in++;
+            start  = d_functional_ticks();
+            passes = _builder->predicates[t](current, NULL);
+            stage->ticks += d_functional_ticks() - start;
+
+            if (!passes)
+            {
+                break;
+            }
+
+            stage->rows_out++;
+        }
+
+        if (passes)
+        {
+            memcpy(out_bytes + (out_count * _element_size),
+                   current,
+                   _element_size);
+            out_count++;
+        }
+    }
+
+    // report each stage, failed or not
+    for (t = 0; t < stage_count; t++)
+    {
+        struct d_profile_record record;
+
+        record.source          = "fn_builder";
+        record.index           = t;
+        record.rows_in         = stats[t].rows_in;
+        record.rows_out        = stats[t].rows_out;
+        record.elapsed_ticks   = stats[t].ticks;
+        record.bytes_allocated = 0;
+
+        if (t < _builder->transform_count)
+        {
+            record.operation       = "map";
+            record.predicate_calls = 0;
+        }
+        else
+        {
+            record.operation       = "filter";
+            record.predicate_calls = stats[t].rows_in;
+        }
+
+        d_profile_emit(&record);
+    }
+
+    d_functional_free(stats);
+    d_functional_free(slots);
+
+    *(_out_count) = (ok) ? out_count : 0;
+
+    return ok;
+}
+
+#endif  // D_FUNCTIONAL_PROFILE
+
 /*
 d_fn_builder_execute
   Executes the accumulated function chain on an input array. First applies
@@ -284,6 +445,9 @@ d_fn_builder_execute
     size_t               i;
     size_t               t;
     bool                 passes;
+#if defined(D_FUNCTIONAL_PROFILE)
+    uint64_t             profile_start;
+#endif
 
     // validate parameters
     if ( (!_builder)   ||
@@ -301,6 +465,19 @@ d_fn_builder_execute
         return false;
     }
 
+#if defined(D_FUNCTIONAL_PROFILE)
+    // time each stage when someone is listening
+    if (D_PROFILE_START(profile_start) != 0)
+    {
+        return d_fn_builder_execute_profiled(_builder,
+                                             _input,
+                                             _count,
+                                             _element_size,
+                                             _output,
+                                             _out_count);
+    }
+#endif
+
     in_bytes  = (const unsigned char*)_input;
     out_bytes = (unsigned char*)_output;
     out_count = 0;
@@ -323,7 +500,7 @@ d_fn_builder_execute
 
     if (_builder->transform_count > 0)
     {
-        temp_a = malloc(_element_size);
+        temp_a = d_functional_malloc(_element_size);
 
         if (!temp_a)
         {
@@ -334,11 +511,11 @@ d_fn_builder_execute
 
         if (_builder->transform_count > 1)
         {
-            temp_b = malloc(_element_size);
+            temp_b = d_functional_malloc(_element_size);
 
             if (!temp_b)
             {
-                free(temp_a);
+                d_functional_free(temp_a);
 
                 *(_out_count) = 0;
 
@@ -361,11 +538,11 @@ d_fn_builder_execute
                     temp_a,
                     NULL))
             {
-                free(temp_a);
+                d_functional_free(temp_a);
 
                 if (temp_b)
                 {
-                    free(temp_b);
+                    d_functional_free(temp_b);
                 }
 
                 *(_out_count) = 0;
@@ -386,11 +563,11 @@ d_fn_builder_execute
 
                 if (!_builder->transforms[t](src, destination, NULL))
                 {
-                    free(temp_a);
+                    d_functional_free(temp_a);
 
                     if (temp_b)
                     {
-                        free(temp_b);
+                        d_functional_free(temp_b);
                     }
 
                     *(_out_count) = 0;
@@ -462,12 +639,12 @@ d_fn_builder_execute
     // cleanup
     if (temp_a)
     {
-        free(temp_a);
+        d_functional_free(temp_a);
     }
 
     if (temp_b)
     {
-        free(temp_b);
+        d_functional_free(temp_b);
     }
 
     *(_out_count) = out_count;
@@ -497,15 +674,15 @@ d_fn_builder_free
 
     if (_builder->transforms)
     {
-        free(_builder->transforms);
+        d_functional_free(_builder->transforms);
     }
 
     if (_builder->predicates)
     {
-        free(_builder->predicates);
+        d_functional_free(_builder->predicates);
     }
 
-    free(_builder);
+    d_functional_free(_builder);
 
     return;
 }
\ No newline at end of file
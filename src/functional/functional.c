@@ -44,32 +44,11 @@ d_functional_index_of
     fn_predicate _test
 )
 {
-    void*  found;
-    size_t offset;
-
-    if ( (!_input)     ||
-         (!_test)      ||
-         (_count == 0) ||
-         (_element_size == 0) )
-    {
-        return (size_t)-1;
-    }
-
-    found = d_functional_find_if(_input,
-                                 _count,
-                                 _element_size,
-                                 _test,
-                                 NULL);
-
-    if (!found)
-    {
-        return (size_t)-1;
-    }
-
-    offset = (size_t)((const unsigned char*)found
-             - (const unsigned char*)_input);
-
-    return offset / _element_size;
+    return d_functional_index_of_context(_input,
+                                         _count,
+                                         _element_size,
+                                         _test,
+                                         NULL);
 }
 
 D_INLINE void*
@@ -81,28 +60,11 @@ d_functional_find_last
     fn_predicate _test
 )
 {
-    const unsigned char* src;
-    size_t               i;
-
-    if ( (!_input)     ||
-         (!_test)      ||
-         (_count == 0) ||
-         (_element_size == 0) )
-    {
-        return NULL;
-    }
-
-    src = (const unsigned char*)_input;
-
-    for (i = _count; i > 0; i--)
-    {
-        if (_test(src + ((i - 1) * _element_size), NULL))
-        {
-            return (void*)(src + ((i - 1) * _element_size));
-        }
-    }
-
-    return NULL;
+    return d_functional_find_last_context(_input,
+                                          _count,
+                                          _element_size,
+                                          _test,
+                                          NULL);
 }
 
 D_INLINE size_t
@@ -114,26 +76,9 @@ d_functional_last_index_of
     fn_predicate _test
 )
 {
-    const unsigned char* src;
-    size_t               i;
-
-    if ( (!_input)     ||
-         (!_test)      ||
-         (_count == 0) ||
-         (_element_size == 0) )
-    {
-        return (size_t)-1;
-    }
-
-    src = (const unsigned char*)_input;
-
-    for (i = _count; i > 0; i--)
-    {
-        if (_test(src + ((i - 1) * _element_size), NULL))
-        {
-            return i - 1;
-        }
-    }
-
-    return (size_t)-1;
+    return d_functional_last_index_of_context(_input,
+                                              _count,
+                                              _element_size,
+                                              _test,
+                                              NULL);
 }
\ No newline at end of file
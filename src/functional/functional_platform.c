@@ -0,0 +1,1053 @@
+#include "..\..\inc\functional\functional_platform.h"
+
+#if defined(_MSC_VER) && ( defined(_M_X64) || defined(_M_IX86) )
+    #include <intrin.h>
+#elif !defined(_WIN32)
+    #include <time.h>
+#endif
+
+#if defined(_WIN32)
+    #include <psapi.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/resource.h>
+    #include <sys/stat.h>
+#endif
+
+
+/*
+d_functional_mutex_init
+  Initializes a mutex.
+
+Parameter(s):
+  _mutex: the mutex to initialize.
+Return:
+  A boolean value corresponding to either:
+  - true, if the mutex was initialized, or
+  - false, if _mutex was NULL or initialization failed.
+*/
+bool
+d_functional_mutex_init
+(
+    d_functional_mutex* _mutex
+)
+{
+    if (!_mutex)
+    {
+        return false;
+    }
+
+#if defined(_WIN32)
+    InitializeCriticalSection(_mutex);
+
+    return true;
+#else
+    return (pthread_mutex_init(_mutex, NULL) == 0);
+#endif
+}
+
+/*
+d_functional_mutex_lock
+  Acquires a mutex, blocking until it is available.
+
+Parameter(s):
+  _mutex: the mutex to acquire.
+Return:
+  none.
+*/
+void
+d_functional_mutex_lock
+(
+    d_functional_mutex* _mutex
+)
+{
+#if defined(_WIN32)
+    EnterCriticalSection(_mutex);
+#else
+    pthread_mutex_lock(_mutex);
+#endif
+
+    return;
+}
+
+/*
+d_functional_mutex_unlock
+  Releases a mutex held by the calling thread.
+
+Parameter(s):
+  _mutex: the mutex to release.
+Return:
+  none.
+*/
+void
+d_functional_mutex_unlock
+(
+    d_functional_mutex* _mutex
+)
+{
+#if defined(_WIN32)
+    LeaveCriticalSection(_mutex);
+#else
+    pthread_mutex_unlock(_mutex);
+#endif
+
+    return;
+}
+
+/*
+d_functional_mutex_destroy
+  Releases the resources held by an unlocked mutex.
+
+Parameter(s):
+  _mutex: the mutex to destroy.
+Return:
+  none.
+*/
+void
+d_functional_mutex_destroy
+(
+    d_functional_mutex* _mutex
+)
+{
+#if defined(_WIN32)
+    DeleteCriticalSection(_mutex);
+#else
+    pthread_mutex_destroy(_mutex);
+#endif
+
+    return;
+}
+
+/*
+d_functional_cond_init
+  Initializes a condition variable.
+
+Parameter(s):
+  _cond: the condition variable to initialize.
+Return:
+  A boolean value corresponding to either:
+  - true, if the condition variable was initialized, or
+  - false, if _cond was NULL or initialization failed.
+*/
+bool
+d_functional_cond_init
+(
+    d_functional_cond* _cond
+)
+{
+    if (!_cond)
+    {
+        return false;
+    }
+
+#if defined(_WIN32)
+    InitializeConditionVariable(_cond);
+
+    return true;
+#else
+    return (pthread_cond_init(_cond, NULL) == 0);
+#endif
+}
+
+/*
+d_functional_cond_wait
+  Atomically releases a mutex held by the calling thread and blocks until
+the condition variable is signalled, then reacquires the mutex. Wakeups
+may be spurious, so callers re-check their condition in a loop.
+
+Parameter(s):
+  _cond:  the condition variable to wait on.
+  _mutex: the mutex guarding the condition, held by the caller.
+Return:
+  none.
+*/
+void
+d_functional_cond_wait
+(
+    d_functional_cond*  _cond,
+    d_functional_mutex* _mutex
+)
+{
+#if defined(_WIN32)
+    SleepConditionVariableCS(_cond, _mutex, INFINITE);
+#else
+    pthread_cond_wait(_cond, _mutex);
+#endif
+
+    return;
+}
+
+/*
+d_functional_cond_signal
+  Wakes one thread waiting on a condition variable, if any.
+
+Parameter(s):
+  _cond: the condition variable.
+Return:
+  none.
+*/
+void
+d_functional_cond_signal
+(
+    d_functional_cond* _cond
+)
+{
+#if defined(_WIN32)
+    WakeConditionVariable(_cond);
+#else
+    pthread_cond_signal(_cond);
+#endif
+
+    return;
+}
+
+/*
+d_functional_cond_broadcast
+  Wakes every thread waiting on a condition variable.
+
+Parameter(s):
+  _cond: the condition variable.
+Return:
+  none.
+*/
+void
+d_functional_cond_broadcast
+(
+    d_functional_cond* _cond
+)
+{
+#if defined(_WIN32)
+    WakeAllConditionVariable(_cond);
+#else
+    pthread_cond_broadcast(_cond);
+#endif
+
+    return;
+}
+
+/*
+d_functional_cond_destroy
+  Releases the resources held by a condition variable no thread waits on.
+
+Parameter(s):
+  _cond: the condition variable to destroy.
+Return:
+  none.
+*/
+void
+d_functional_cond_destroy
+(
+    d_functional_cond* _cond
+)
+{
+#if defined(_WIN32)
+    // condition variables hold no resources on Windows
+    (void)_cond;
+#else
+    pthread_cond_destroy(_cond);
+#endif
+
+    return;
+}
+
+#if defined(_WIN32)
+/*
+d_functional_once_thunk
+  Internal InitOnceExecuteOnce callback running the fn_once passed as its
+parameter.
+*/
+static BOOL CALLBACK
+d_functional_once_thunk
+(
+    PINIT_ONCE _once,
+    PVOID      _initialize,
+    PVOID*     _context
+)
+{
+    (void)_once;
+    (void)_context;
+
+    ((fn_once)_initialize)();
+
+    return TRUE;
+}
+#endif
+
+/*
+d_functional_once_run
+  Runs _initialize exactly once per flag, however many threads call this
+concurrently; every caller returns only after it has completed.
+
+Parameter(s):
+  _once:       the flag, statically initialized with D_FUNCTIONAL_ONCE_INIT.
+  _initialize: the initializer.
+Return:
+  none.
+*/
+void
+d_functional_once_run
+(
+    d_functional_once* _once,
+    fn_once            _initialize
+)
+{
+#if defined(_WIN32)
+    InitOnceExecuteOnce(_once,
+                        d_functional_once_thunk,
+                        (PVOID)_initialize,
+                        NULL);
+#else
+    pthread_once(_once, _initialize);
+#endif
+
+    return;
+}
+
+/*
+d_functional_ticks
+  Reads a cheap, monotonically increasing tick counter. The unit is
+platform-dependent (CPU timestamp cycles on x86, performance-counter ticks
+on Windows, nanoseconds elsewhere); only differences between two readings
+on the same machine are meaningful.
+
+Parameter(s):
+  (none)
+Return:
+  The current tick count.
+*/
+uint64_t
+d_functional_ticks
+(
+    void
+)
+{
+#if defined(_MSC_VER) && ( defined(_M_X64) || defined(_M_IX86) )
+    return (uint64_t)__rdtsc();
+#elif defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) )
+    return (uint64_t)__builtin_ia32_rdtsc();
+#elif defined(_WIN32)
+    LARGE_INTEGER counter;
+
+    QueryPerformanceCounter(&counter);
+
+    return (uint64_t)counter.QuadPart;
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ( ((uint64_t)now.tv_sec * 1000000000u) +
+             (uint64_t)now.tv_nsec );
+#endif
+}
+
+/*
+d_functional_nanoseconds
+  Reads a monotonic clock in nanoseconds. Slower than d_functional_ticks,
+but in a fixed unit, for reporting durations.
+
+Parameter(s):
+  (none)
+Return:
+  Nanoseconds since an arbitrary fixed point.
+*/
+uint64_t
+d_functional_nanoseconds
+(
+    void
+)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+
+    // split to avoid overflowing counter * 1e9
+    return ( ((uint64_t)(counter.QuadPart / frequency.QuadPart) *
+              1000000000u) +
+             ((uint64_t)(counter.QuadPart % frequency.QuadPart) *
+              1000000000u / (uint64_t)frequency.QuadPart) );
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ( ((uint64_t)now.tv_sec * 1000000000u) +
+             (uint64_t)now.tv_nsec );
+#endif
+}
+
+/*
+d_functional_thread_trampoline
+  Internal state handed to a new thread: the entry point and its argument.
+The thread frees it before running the entry point.
+*/
+struct d_functional_thread_trampoline
+{
+    fn_callback entry;
+    void*       argument;
+};
+
+#if defined(_WIN32)
+static DWORD WINAPI
+d_functional_thread_main
+(
+    LPVOID _trampoline
+)
+#else
+static void*
+d_functional_thread_main
+(
+    void* _trampoline
+)
+#endif
+{
+    struct d_functional_thread_trampoline trampoline;
+
+    trampoline = *(struct d_functional_thread_trampoline*)_trampoline;
+    free(_trampoline);
+
+    trampoline.entry(trampoline.argument);
+
+#if defined(_WIN32)
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+/*
+d_functional_thread_start
+  Starts a joinable thread running _entry(_argument).
+
+Parameter(s):
+  _thread:   receives the handle of the new thread.
+  _entry:    function run by the thread.
+  _argument: argument passed to _entry; may be NULL.
+Return:
+  A boolean value corresponding to either:
+  - true, if the thread was started; it must later be joined with
+    d_functional_thread_join, or
+  - false, if _thread or _entry was NULL or the thread could not be
+    started.
+*/
+bool
+d_functional_thread_start
+(
+    d_functional_thread* _thread,
+    fn_callback          _entry,
+    void*                _argument
+)
+{
+    struct d_functional_thread_trampoline* trampoline;
+
+    // validate parameters
+    if ( (!_thread) ||
+         (!_entry) )
+    {
+        return false;
+    }
+
+    trampoline = malloc(sizeof(struct d_functional_thread_trampoline));
+
+    // ensure that memory allocation was successful
+    if (!trampoline)
+    {
+        return false;
+    }
+
+    trampoline->entry    = _entry;
+    trampoline->argument = _argument;
+
+#if defined(_WIN32)
+    *_thread = CreateThread(NULL,
+                            0,
+                            d_functional_thread_main,
+                            trampoline,
+                            0,
+                            NULL);
+
+    if (!*_thread)
+    {
+        free(trampoline);
+
+        return false;
+    }
+#else
+    if (pthread_create(_thread,
+                       NULL,
+                       d_functional_thread_main,
+                       trampoline) != 0)
+    {
+        free(trampoline);
+
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+/*
+d_functional_thread_join
+  Waits for a thread started by d_functional_thread_start to finish and
+releases its handle.
+
+Parameter(s):
+  _thread: the thread to join.
+Return:
+  none.
+*/
+void
+d_functional_thread_join
+(
+    d_functional_thread _thread
+)
+{
+#if defined(_WIN32)
+    WaitForSingleObject(_thread, INFINITE);
+    CloseHandle(_thread);
+#else
+    pthread_join(_thread, NULL);
+#endif
+
+    return;
+}
+
+/*
+d_functional_cpu_count
+  Returns the number of processors available to the process.
+
+Parameter(s):
+  (none)
+Return:
+  The number of online processors, or 1 if it cannot be determined.
+*/
+size_t
+d_functional_cpu_count
+(
+    void
+)
+{
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+
+    GetSystemInfo(&info);
+
+    return (info.dwNumberOfProcessors > 0)
+           ? (size_t)info.dwNumberOfProcessors
+           : 1;
+#else
+    long count;
+
+    count = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return (count > 0) ? (size_t)count : 1;
+#endif
+}
+
+/*
+d_functional_map_view
+  Internal helper mapping the first `size` bytes of a mapping's file:
+shared and writable for output mappings, private copy-on-write otherwise.
+*/
+static bool
+d_functional_map_view
+(
+    struct d_functional_mapping* _mapping
+)
+{
+    _mapping->data = NULL;
+
+    // an empty file has nothing to map
+    if (_mapping->size == 0)
+    {
+        return true;
+    }
+
+#if defined(_WIN32)
+    _mapping->map = CreateFileMappingA(
+                        _mapping->file,
+                        NULL,
+                        (_mapping->writable) ? PAGE_READWRITE
+                                             : PAGE_WRITECOPY,
+                        (DWORD)((uint64_t)_mapping->size >> 32),
+                        (DWORD)((uint64_t)_mapping->size & 0xFFFFFFFFu),
+                        NULL);
+
+    if (!_mapping->map)
+    {
+        return false;
+    }
+
+    _mapping->data = MapViewOfFile(_mapping->map,
+                                   (_mapping->writable) ? FILE_MAP_WRITE
+                                                        : FILE_MAP_COPY,
+                                   0,
+                                   0,
+                                   _mapping->size);
+
+    if (!_mapping->data)
+    {
+        CloseHandle(_mapping->map);
+        _mapping->map = NULL;
+
+        return false;
+    }
+#else
+    _mapping->data = mmap(NULL,
+                          _mapping->size,
+                          PROT_READ | PROT_WRITE,
+                          (_mapping->writable) ? MAP_SHARED : MAP_PRIVATE,
+                          _mapping->fd,
+                          0);
+
+    if (_mapping->data == MAP_FAILED)
+    {
+        _mapping->data = NULL;
+
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+/*
+d_functional_map_unview
+  Internal helper unmapping a mapping's view, keeping the file open.
+*/
+static void
+d_functional_map_unview
+(
+    struct d_functional_mapping* _mapping
+)
+{
+    if (!_mapping->data)
+    {
+        return;
+    }
+
+#if defined(_WIN32)
+    UnmapViewOfFile(_mapping->data);
+    CloseHandle(_mapping->map);
+    _mapping->map = NULL;
+#else
+    munmap(_mapping->data, _mapping->size);
+#endif
+
+    _mapping->data = NULL;
+
+    return;
+}
+
+/*
+d_functional_map_open
+  Maps an existing file for reading. The mapping is private and
+copy-on-write: it may be modified in memory, but the file is never
+changed.
+
+Parameter(s):
+  _mapping: receives the mapping.
+  _path:    path of the file to map.
+Return:
+  A boolean value corresponding to either:
+  - true, if the file was mapped (an empty file gives a NULL data
+    pointer), or
+  - false, if a parameter was NULL or the file could not be opened or
+    mapped.
+*/
+bool
+d_functional_map_open
+(
+    struct d_functional_mapping* _mapping,
+    const char*                  _path
+)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER size;
+#else
+    struct stat info;
+#endif
+
+    // validate parameters
+    if ( (!_mapping) ||
+         (!_path) )
+    {
+        return false;
+    }
+
+    memset(_mapping, 0, sizeof(*_mapping));
+
+#if defined(_WIN32)
+    _mapping->file = CreateFileA(_path,
+                                 GENERIC_READ,
+                                 FILE_SHARE_READ,
+                                 NULL,
+                                 OPEN_EXISTING,
+                                 FILE_FLAG_SEQUENTIAL_SCAN,
+                                 NULL);
+
+    if (_mapping->file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    if (!GetFileSizeEx(_mapping->file, &size))
+    {
+        CloseHandle(_mapping->file);
+
+        return false;
+    }
+
+    _mapping->size = (size_t)size.QuadPart;
+
+    if (!d_functional_map_view(_mapping))
+    {
+        CloseHandle(_mapping->file);
+
+        return false;
+    }
+#else
+    _mapping->fd = open(_path, O_RDONLY);
+
+    if (_mapping->fd < 0)
+    {
+        return false;
+    }
+
+    if (fstat(_mapping->fd, &info) != 0)
+    {
+        close(_mapping->fd);
+
+        return false;
+    }
+
+    _mapping->size = (size_t)info.st_size;
+
+    if (!d_functional_map_view(_mapping))
+    {
+        close(_mapping->fd);
+
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+/*
+d_functional_map_create
+  Creates (or truncates) a file of _size bytes and maps it shared and
+writable, so that writes to the mapping reach the file.
+
+Parameter(s):
+  _mapping: receives the mapping.
+  _path:    path of the file to create.
+  _size:    initial size of the file in bytes.
+Return:
+  A boolean value corresponding to either:
+  - true, if the file was created and mapped, or
+  - false, if a parameter was NULL or the file could not be created,
+    sized, or mapped.
+*/
+bool
+d_functional_map_create
+(
+    struct d_functional_mapping* _mapping,
+    const char*                  _path,
+    size_t                       _size
+)
+{
+    // validate parameters
+    if ( (!_mapping) ||
+         (!_path) )
+    {
+        return false;
+    }
+
+    memset(_mapping, 0, sizeof(*_mapping));
+    _mapping->size     = _size;
+    _mapping->writable = true;
+
+#if defined(_WIN32)
+    _mapping->file = CreateFileA(_path,
+                                 GENERIC_READ | GENERIC_WRITE,
+                                 0,
+                                 NULL,
+                                 CREATE_ALWAYS,
+                                 FILE_ATTRIBUTE_NORMAL,
+                                 NULL);
+
+    if (_mapping->file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    // creating the file mapping extends the file
+    if (!d_functional_map_view(_mapping))
+    {
+        CloseHandle(_mapping->file);
+
+        return false;
+    }
+#else
+    _mapping->fd = open(_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+    if (_mapping->fd < 0)
+    {
+        return false;
+    }
+
+    if ( (ftruncate(_mapping->fd, (off_t)_size) != 0) ||
+         (!d_functional_map_view(_mapping)) )
+    {
+        close(_mapping->fd);
+
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+/*
+d_functional_map_resize
+  Grows a writable mapping and its file to _size bytes. The mapping may
+move, so pointers into it are invalidated.
+
+Parameter(s):
+  _mapping: the writable mapping to grow.
+  _size:    the new size in bytes; not smaller than the current size.
+Return:
+  A boolean value corresponding to either:
+  - true, if the mapping was grown, or
+  - false, if the mapping is not writable, _size is smaller than the
+    current size, or the file could not be grown or remapped; the mapping
+    is then unmapped.
+*/
+bool
+d_functional_map_resize
+(
+    struct d_functional_mapping* _mapping,
+    size_t                       _size
+)
+{
+    // validate parameters
+    if ( (!_mapping)           ||
+         (!_mapping->writable) ||
+         (_size < _mapping->size) )
+    {
+        return false;
+    }
+
+    d_functional_map_unview(_mapping);
+    _mapping->size = _size;
+
+#if defined(_WIN32)
+    // creating the larger file mapping extends the file
+    return d_functional_map_view(_mapping);
+#else
+    if (ftruncate(_mapping->fd, (off_t)_size) != 0)
+    {
+        _mapping->size = 0;
+
+        return false;
+    }
+
+    return d_functional_map_view(_mapping);
+#endif
+}
+
+/*
+d_functional_map_advise
+  Tells the operating system how a range of a mapping will be accessed.
+The range is widened to whole pages. This is only a hint; it is ignored
+where the platform has no equivalent.
+
+Parameter(s):
+  _mapping: the mapping.
+  _offset:  start of the range in bytes.
+  _length:  length of the range in bytes; clamped to the mapping.
+  _advice:  the expected access pattern.
+Return:
+  none.
+*/
+void
+d_functional_map_advise
+(
+    struct d_functional_mapping* _mapping,
+    size_t                       _offset,
+    size_t                       _length,
+    enum d_functional_map_advice _advice
+)
+{
+#if !defined(_WIN32)
+    size_t page;
+    size_t start;
+    int    hint;
+#endif
+
+    // validate parameters
+    if ( (!_mapping)       ||
+         (!_mapping->data) ||
+         (_offset >= _mapping->size) )
+    {
+        return;
+    }
+
+    if (_length > _mapping->size - _offset)
+    {
+        _length = _mapping->size - _offset;
+    }
+
+#if defined(_WIN32)
+    #if defined(_WIN32_WINNT) && (_WIN32_WINNT >= 0x0602)
+    if (_advice == D_FUNCTIONAL_MAP_WILLNEED)
+    {
+        WIN32_MEMORY_RANGE_ENTRY range;
+
+        range.VirtualAddress = (unsigned char*)_mapping->data + _offset;
+        range.NumberOfBytes  = _length;
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+    #else
+    (void)_advice;
+    #endif
+#else
+    page  = (size_t)sysconf(_SC_PAGESIZE);
+    page  = (page == 0) ? 4096 : page;
+    start = _offset - (_offset % page);
+
+    switch (_advice)
+    {
+    case D_FUNCTIONAL_MAP_SEQUENTIAL:
+        hint = POSIX_MADV_SEQUENTIAL;
+
+        break;
+
+    case D_FUNCTIONAL_MAP_WILLNEED:
+        hint = POSIX_MADV_WILLNEED;
+
+        break;
+
+    default:
+        hint = POSIX_MADV_DONTNEED;
+
+        break;
+    }
+
+    posix_madvise((unsigned char*)_mapping->data + start,
+                  _length + (_offset - start),
+                  hint);
+#endif
+
+    return;
+}
+
+/*
+d_functional_map_close
+  Unmaps a mapping and closes its file. A writable mapping's file is
+first cut to _final_size bytes, dropping unused capacity.
+
+Parameter(s):
+  _mapping:    the mapping to close.
+  _final_size: final size of a writable mapping's file in bytes; ignored
+               for read mappings.
+Return:
+  A boolean value corresponding to either:
+  - true, if the mapping was closed, or
+  - false, if _mapping was NULL or the file could not be truncated; the
+    mapping is closed regardless.
+*/
+bool
+d_functional_map_close
+(
+    struct d_functional_mapping* _mapping,
+    size_t                       _final_size
+)
+{
+    bool ok;
+#if defined(_WIN32)
+    LARGE_INTEGER end;
+#endif
+
+    if (!_mapping)
+    {
+        return false;
+    }
+
+    ok = true;
+
+    d_functional_map_unview(_mapping);
+
+#if defined(_WIN32)
+    if (_mapping->writable)
+    {
+        end.QuadPart = (LONGLONG)_final_size;
+        ok           = (SetFilePointerEx(_mapping->file, end, NULL,
+                                         FILE_BEGIN))              &&
+                       (SetEndOfFile(_mapping->file));
+    }
+
+    CloseHandle(_mapping->file);
+#else
+    if (_mapping->writable)
+    {
+        ok = (ftruncate(_mapping->fd, (off_t)_final_size) == 0);
+    }
+
+    close(_mapping->fd);
+#endif
+
+    _mapping->size = 0;
+
+    return ok;
+}
+
+/*
+d_functional_peak_rss
+  Reads the peak resident set size of the process: the most physical
+memory it has held at once.
+
+Parameter(s):
+  (none)
+Return:
+  The peak resident set size in bytes, or 0 if it is not available.
+*/
+size_t
+d_functional_peak_rss
+(
+    void
+)
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+
+    if (!GetProcessMemoryInfo(GetCurrentProcess(),
+                              &counters,
+                              sizeof(counters)))
+    {
+        return 0;
+    }
+
+    return (size_t)counters.PeakWorkingSetSize;
+#else
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+
+    // ru_maxrss is in bytes on macOS and kilobytes elsewhere
+    #if defined(__APPLE__)
+        return (size_t)usage.ru_maxrss;
+    #else
+        return (size_t)usage.ru_maxrss * 1024;
+    #endif
+#endif
+}
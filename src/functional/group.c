@@ -0,0 +1,976 @@
+#include "..\..\inc\functional\group.h"
+
+
+// marks "no group" for d_group_table_locate
+#define D_GROUP_NONE ((size_t)-1)
+
+
+/*
+d_group_job
+  Internal description of a grouped fold shared by every task of a parallel
+run.
+*/
+struct d_group_job
+{
+    size_t                         element_size;
+    fn_transformer                 key;
+    size_t                         key_size;
+    fn_hasher                      hasher;
+    fn_binary_predicate            equal;
+    void*                          key_context;
+    fn_accumulator                 step;
+    fn_combiner                    merge;
+    const void*                    initial;
+    size_t                         state_size;
+    void*                          context;
+    struct d_functional_allocator* allocator;  // the caller's current one
+};
+
+/*
+d_group_task
+  Internal unit of work of a parallel grouped fold. In the build phase a task
+folds [input, input + count) into its own table; in the merge phase it
+merges the groups of hash partition `partition` from every local table into
+its own table.
+*/
+struct d_group_task
+{
+    const struct d_group_job* job;
+    const unsigned char*      input;
+    size_t                    count;
+    struct d_group_table**    locals;
+    size_t                    local_count;
+    size_t                    partition;
+    size_t                    partition_count;
+    struct d_group_table*     table;
+    bool                      success;
+};
+
+
+/*
+d_group_hash_bytes
+  Internal default hasher: 64-bit FNV-1a over the key bytes.
+*/
+static size_t
+d_group_hash_bytes
+(
+    const void* _key,
+    size_t      _key_size
+)
+{
+    const unsigned char* bytes;
+    uint64_t             hash;
+    size_t               i;
+
+    bytes = (const unsigned char*)_key;
+    hash  = 14695981039346656037ULL;
+
+    for (i = 0; i < _key_size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return (size_t)hash;
+}
+
+/*
+d_group_mix
+  Internal helper that scrambles a user hash (64-bit finalizer from
+MurmurHash3), so that weak hashers still spread evenly over the slots and
+partitions.
+*/
+static size_t
+d_group_mix
+(
+    size_t _hash
+)
+{
+    uint64_t hash;
+
+    hash  = (uint64_t)_hash;
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+
+    return (size_t)hash;
+}
+
+/*
+d_group_hash
+  Internal helper computing the mixed hash of a key.
+*/
+static size_t
+d_group_hash
+(
+    const struct d_group_table* _table,
+    const void*                 _key
+)
+{
+    size_t hash;
+
+    hash = (_table->hasher)
+           ? _table->hasher(_key, _table->key_context)
+           : d_group_hash_bytes(_key, _table->key_size);
+
+    return d_group_mix(hash);
+}
+
+/*
+d_group_table_new
+  Internal constructor for an empty table.
+*/
+static struct d_group_table*
+d_group_table_new
+(
+    size_t              _key_size,
+    size_t              _state_size,
+    fn_hasher           _hasher,
+    fn_binary_predicate _equal,
+    void*               _key_context
+)
+{
+    struct d_group_table* table;
+
+    table = d_functional_malloc(sizeof(struct d_group_table));
+
+    // ensure that memory allocation was successful
+    if (!table)
+    {
+        return NULL;
+    }
+
+    table->count          = 0;
+    table->key_size       = _key_size;
+    table->state_size     = _state_size;
+    table->group_capacity = D_GROUP_INITIAL_CAPACITY;
+    table->slot_count     = 1;
+    table->hasher         = _hasher;
+    table->equal          = _equal;
+    table->key_context    = _key_context;
+
+    // keep the load factor at or below one half
+    while (table->slot_count < (2 * D_GROUP_INITIAL_CAPACITY))
+    {
+        table->slot_count <<= 1;
+    }
+
+    table->keys   = d_functional_malloc(table->group_capacity * _key_size);
+    table->states = d_functional_malloc(table->group_capacity * _state_size);
+    table->hashes = d_functional_malloc(table->group_capacity * sizeof(size_t));
+    table->slots  = d_functional_calloc(table->slot_count, sizeof(size_t));
+
+    if ( (!table->keys)   ||
+         (!table->states) ||
+         (!table->hashes) ||
+         (!table->slots) )
+    {
+        d_group_table_free(table);
+
+        return NULL;
+    }
+
+    return table;
+}
+
+/*
+d_group_table_locate
+  Internal helper probing for _key. Returns the group index, or D_GROUP_NONE
+with *_slot set to the empty slot where the key would be inserted.
+*/
+static size_t
+d_group_table_locate
+(
+    const struct d_group_table* _table,
+    const void*                 _key,
+    size_t                      _hash,
+    size_t*                     _slot
+)
+{
+    size_t mask;
+    size_t slot;
+    size_t group;
+
+    mask = _table->slot_count - 1;
+    slot = _hash & mask;
+
+    while (_table->slots[slot] != 0)
+    {
+        group = _table->slots[slot] - 1;
+
+        if ( (_table->hashes[group] == _hash) &&
+             ( (_table->equal)
+               ? _table->equal(_table->keys + (group * _table->key_size),
+                               _key,
+                               _table->key_context)
+               : (memcmp(_table->keys + (group * _table->key_size),
+                         _key,
+                         _table->key_size) == 0) ) )
+        {
+            return group;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    if (_slot)
+    {
+        *_slot = slot;
+    }
+
+    return D_GROUP_NONE;
+}
+
+/*
+d_group_table_rehash
+  Internal helper doubling the slot index and reinserting every group from
+its stored hash.
+*/
+static bool
+d_group_table_rehash
+(
+    struct d_group_table* _table
+)
+{
+    size_t* slots;
+    size_t  slot_count;
+    size_t  mask;
+    size_t  slot;
+    size_t  i;
+
+    slot_count = _table->slot_count * 2;
+    slots      = d_functional_calloc(slot_count, sizeof(size_t));
+
+    // ensure that memory allocation was successful
+    if (!slots)
+    {
+        return false;
+    }
+
+    mask = slot_count - 1;
+
+    for (i = 0; i < _table->count; i++)
+    {
+        slot = _table->hashes[i] & mask;
+
+        while (slots[slot] != 0)
+        {
+            slot = (slot + 1) & mask;
+        }
+
+        slots[slot] = i + 1;
+    }
+
+    d_functional_free(_table->slots);
+
+    _table->slots      = slots;
+    _table->slot_count = slot_count;
+
+    return true;
+}
+
+/*
+d_group_table_reserve
+  Internal helper making room for one more group in the compact arrays.
+*/
+static bool
+d_group_table_reserve
+(
+    struct d_group_table* _table
+)
+{
+    unsigned char* keys;
+    unsigned char* states;
+    size_t*        hashes;
+    size_t         capacity;
+
+    if (_table->count < _table->group_capacity)
+    {
+        return true;
+    }
+
+    capacity = _table->group_capacity * 2;
+
+    keys = d_functional_realloc(_table->keys, capacity * _table->key_size);
+
+    if (!keys)
+    {
+        return false;
+    }
+
+    _table->keys = keys;
+    states       = d_functional_realloc(_table->states,
+                                        capacity * _table->state_size);
+
+    if (!states)
+    {
+        return false;
+    }
+
+    _table->states = states;
+    hashes         = d_functional_realloc(_table->hashes,
+                                          capacity * sizeof(size_t));
+
+    if (!hashes)
+    {
+        return false;
+    }
+
+    _table->hashes         = hashes;
+    _table->group_capacity = capacity;
+
+    return true;
+}
+
+/*
+d_group_table_append
+  Internal helper adding a new group with a copy of _key and _state. The key
+must not already be present. Returns the new group's state, or NULL if
+memory could not be allocated.
+*/
+static void*
+d_group_table_append
+(
+    struct d_group_table* _table,
+    const void*           _key,
+    size_t                _hash,
+    const void*           _state
+)
+{
+    size_t group;
+    size_t slot;
+
+    if ( ((_table->count + 1) * 2 > _table->slot_count) &&
+         (!d_group_table_rehash(_table)) )
+    {
+        return NULL;
+    }
+
+    if (!d_group_table_reserve(_table))
+    {
+        return NULL;
+    }
+
+    // find the empty slot at the end of the probe sequence
+    slot = _hash & (_table->slot_count - 1);
+
+    while (_table->slots[slot] != 0)
+    {
+        slot = (slot + 1) & (_table->slot_count - 1);
+    }
+
+    group = _table->count;
+
+    memcpy(_table->keys + (group * _table->key_size),
+           _key,
+           _table->key_size);
+    memcpy(_table->states + (group * _table->state_size),
+           _state,
+           _table->state_size);
+
+    _table->hashes[group] = _hash;
+    _table->slots[slot]   = group + 1;
+    _table->count++;
+
+    return _table->states + (group * _table->state_size);
+}
+
+/*
+d_group_fold_into
+  Internal helper folding [_input, _input + _count) into _table.
+*/
+static bool
+d_group_fold_into
+(
+    struct d_group_table*     _table,
+    const struct d_group_job* _job,
+    const unsigned char*      _input,
+    size_t                    _count
+)
+{
+    unsigned char* key;
+    void*          state;
+    size_t         hash;
+    size_t         group;
+    size_t         i;
+    bool           success;
+
+    key = d_functional_malloc(_job->key_size);
+
+    // ensure that memory allocation was successful
+    if (!key)
+    {
+        return false;
+    }
+
+    success = true;
+
+    for (i = 0; (success) && (i < _count); i++)
+    {
+        if (!_job->key(_input + (i * _job->element_size),
+                       key,
+                       _job->key_context))
+        {
+            success = false;
+
+            break;
+        }
+
+        hash  = d_group_hash(_table, key);
+        group = d_group_table_locate(_table, key, hash, NULL);
+        state = (group != D_GROUP_NONE)
+                ? _table->states + (group * _table->state_size)
+                : d_group_table_append(_table, key, hash, _job->initial);
+
+        success = (state != NULL) &&
+                  _job->step(state,
+                             _input + (i * _job->element_size),
+                             _job->context);
+    }
+
+    d_functional_free(key);
+
+    return success;
+}
+
+/*
+d_group_task_build
+  Internal fn_callback for the build phase: folds one chunk into a new
+table.
+*/
+static void
+d_group_task_build
+(
+    void* _task
+)
+{
+    struct d_group_task*           task;
+    struct d_functional_allocator* previous;
+
+    task     = (struct d_group_task*)_task;
+    previous = d_functional_allocator_push(task->job->allocator);
+
+    task->table   = d_group_table_new(task->job->key_size,
+                                      task->job->state_size,
+                                      task->job->hasher,
+                                      task->job->equal,
+                                      task->job->key_context);
+    task->success = (task->table != NULL) &&
+                    d_group_fold_into(task->table,
+                                      task->job,
+                                      task->input,
+                                      task->count);
+
+    d_functional_allocator_pop(previous);
+
+    return;
+}
+
+/*
+d_group_merge_partition
+  Internal helper for the merge phase: collects the groups of one hash
+partition from every local table into a new table, merging states of equal
+keys.
+*/
+static bool
+d_group_merge_partition
+(
+    struct d_group_task* _task
+)
+{
+    const struct d_group_table* local;
+    const unsigned char*        key;
+    const unsigned char*        state;
+    size_t                      hash;
+    size_t                      group;
+    size_t                      t;
+    size_t                      g;
+
+    _task->table = d_group_table_new(_task->job->key_size,
+                                     _task->job->state_size,
+                                     _task->job->hasher,
+                                     _task->job->equal,
+                                     _task->job->key_context);
+
+    if (!_task->table)
+    {
+        return false;
+    }
+
+    for (t = 0; t < _task->local_count; t++)
+    {
+        local = _task->locals[t];
+
+        for (g = 0; g < local->count; g++)
+        {
+            hash = local->hashes[g];
+
+            // partition on the high half so it is independent of the slot
+            if ( ((hash >> (sizeof(size_t) * 4)) % _task->partition_count) !=
+                 _task->partition )
+            {
+                continue;
+            }
+
+            key   = local->keys + (g * local->key_size);
+            state = local->states + (g * local->state_size);
+            group = d_group_table_locate(_task->table, key, hash, NULL);
+
+            if (group == D_GROUP_NONE)
+            {
+                if (!d_group_table_append(_task->table, key, hash, state))
+                {
+                    return false;
+                }
+            }
+            else if (!_task->job->merge(_task->table->states +
+                                            (group * _task->table->state_size),
+                                        state,
+                                        _task->job->context))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/*
+d_group_task_merge
+  Internal fn_callback for the merge phase: merges one hash partition.
+*/
+static void
+d_group_task_merge
+(
+    void* _task
+)
+{
+    struct d_group_task*           task;
+    struct d_functional_allocator* previous;
+
+    task     = (struct d_group_task*)_task;
+    previous = d_functional_allocator_push(task->job->allocator);
+
+    task->success = d_group_merge_partition(task);
+
+    d_functional_allocator_pop(previous);
+
+    return;
+}
+
+/*
+d_group_run_tasks
+  Internal helper running _entry over _task_count tasks: task 0 on the
+calling thread and the others on worker threads. A task whose thread cannot
+be started runs on the calling thread instead.
+*/
+static bool
+d_group_run_tasks
+(
+    struct d_group_task* _tasks,
+    size_t               _task_count,
+    fn_callback          _entry
+)
+{
+    d_functional_thread threads[D_FUNCTIONAL_MAX_THREADS];
+    bool                started[D_FUNCTIONAL_MAX_THREADS];
+    bool                success;
+    size_t              i;
+
+    for (i = 1; i < _task_count; i++)
+    {
+        started[i] = d_functional_thread_start(&threads[i],
+                                               _entry,
+                                               &_tasks[i]);
+
+        if (!started[i])
+        {
+            _entry(&_tasks[i]);
+        }
+    }
+
+    _entry(&_tasks[0]);
+
+    success = _tasks[0].success;
+
+    for (i = 1; i < _task_count; i++)
+    {
+        if (started[i])
+        {
+            d_functional_thread_join(threads[i]);
+        }
+
+        success = _tasks[i].success && success;
+    }
+
+    return success;
+}
+
+/*
+d_functional_group_fold
+  Groups the elements of an array by key and folds each group into its own
+state. For every element, _key writes the element's key into a key_size
+buffer; the first element of a new key creates a group whose state is a copy
+of _initial; then _step folds the element into the group's state.
+
+Parameter(s):
+  _input:        pointer to the input array.
+  _count:        number of elements in the input array.
+  _element_size: size of each element in bytes.
+  _key:          transformer writing an element's key.
+  _key_size:     size of a key in bytes.
+  _hasher:       hash function for keys; NULL hashes the key bytes.
+  _equal:        key equality; NULL compares the key bytes.
+  _key_context:  context forwarded to _key, _hasher, and _equal; may be NULL.
+  _step:         accumulator folding an element into its group's state.
+  _initial:      initial state of every group.
+  _state_size:   size of a group state in bytes.
+  _context:      context forwarded to _step; may be NULL.
+Return:
+  A pointer to a newly allocated d_group_table holding the groups in order
+of first appearance, or NULL if any parameter was NULL/zero, memory could
+not be allocated, or _key or _step failed. Free the table with
+d_group_table_free.
+*/
+struct d_group_table*
+d_functional_group_fold
+(
+    const void*         _input,
+    size_t              _count,
+    size_t              _element_size,
+    fn_transformer      _key,
+    size_t              _key_size,
+    fn_hasher           _hasher,
+    fn_binary_predicate _equal,
+    void*               _key_context,
+    fn_accumulator      _step,
+    const void*         _initial,
+    size_t              _state_size,
+    void*               _context
+)
+{
+    struct d_group_job    job;
+    struct d_group_table* table;
+
+    // validate parameters
+    if ( (!_input)            ||
+         (!_key)              ||
+         (!_step)             ||
+         (!_initial)          ||
+         (_count == 0)        ||
+         (_element_size == 0) ||
+         (_key_size == 0)     ||
+         (_state_size == 0) )
+    {
+        return NULL;
+    }
+
+    job.element_size = _element_size;
+    job.key          = _key;
+    job.key_size     = _key_size;
+    job.hasher       = _hasher;
+    job.equal        = _equal;
+    job.key_context  = _key_context;
+    job.step         = _step;
+    job.merge        = NULL;
+    job.initial      = _initial;
+    job.state_size   = _state_size;
+    job.context      = _context;
+    job.allocator    = d_functional_allocator_current();
+
+    table = d_group_table_new(_key_size,
+                              _state_size,
+                              _hasher,
+                              _equal,
+                              _key_context);
+
+    if (!table)
+    {
+        return NULL;
+    }
+
+    if (!d_group_fold_into(table,
+                           &job,
+                           (const unsigned char*)_input,
+                           _count))
+    {
+        d_group_table_free(table);
+
+        return NULL;
+    }
+
+    return table;
+}
+
+/*
+d_functional_group_fold_parallel
+  Parallel variant of d_functional_group_fold. Each thread folds a
+contiguous chunk of the input into its own table; the per-thread tables are
+then split into hash partitions, and each thread merges one partition from
+all tables, combining the states of keys seen by several threads with
+_merge. The partitions are finally concatenated into one table.
+  All callbacks are called concurrently from different threads. Groups are
+returned in partition order rather than in order of first appearance, and
+_merge must be associative and commutative. The worker threads allocate
+from the calling thread's current allocator, which must then be shared
+(see d_functional_allocator_init).
+
+Parameter(s):
+  _input:        pointer to the input array.
+  _count:        number of elements in the input array.
+  _element_size: size of each element in bytes.
+  _key:          transformer writing an element's key.
+  _key_size:     size of a key in bytes.
+  _hasher:       hash function for keys; NULL hashes the key bytes.
+  _equal:        key equality; NULL compares the key bytes.
+  _key_context:  context forwarded to _key, _hasher, and _equal; may be NULL.
+  _step:         accumulator folding an element into its group's state.
+  _merge:        combiner merging two partial states of the same group.
+  _initial:      initial state of every group; must be neutral for _merge.
+  _state_size:   size of a group state in bytes.
+  _context:      context forwarded to _step and _merge; may be NULL.
+  _threads:      maximum number of threads to use; 0 uses one per processor.
+Return:
+  A pointer to a newly allocated d_group_table, or NULL if any parameter
+was NULL/zero, memory could not be allocated, or any callback failed.
+*/
+struct d_group_table*
+d_functional_group_fold_parallel
+(
+    const void*         _input,
+    size_t              _count,
+    size_t              _element_size,
+    fn_transformer      _key,
+    size_t              _key_size,
+    fn_hasher           _hasher,
+    fn_binary_predicate _equal,
+    void*               _key_context,
+    fn_accumulator      _step,
+    fn_combiner         _merge,
+    const void*         _initial,
+    size_t              _state_size,
+    void*               _context,
+    size_t              _threads
+)
+{
+    struct d_group_job    job;
+    struct d_group_task   tasks[D_FUNCTIONAL_MAX_THREADS];
+    struct d_group_task   merges[D_FUNCTIONAL_MAX_THREADS];
+    struct d_group_table* locals[D_FUNCTIONAL_MAX_THREADS];
+    struct d_group_table* result;
+    const struct d_group_table* part;
+    size_t                task_count;
+    size_t                base;
+    size_t                remainder;
+    size_t                offset;
+    size_t                i;
+    size_t                g;
+    bool                  success;
+
+    // validate parameters
+    if ( (!_input)            ||
+         (!_key)              ||
+         (!_step)             ||
+         (!_merge)            ||
+         (!_initial)          ||
+         (_count == 0)        ||
+         (_element_size == 0) ||
+         (_key_size == 0)     ||
+         (_state_size == 0) )
+    {
+        return NULL;
+    }
+
+    if (_threads == 0)
+    {
+        _threads = d_functional_cpu_count();
+    }
+
+    if (_threads > D_FUNCTIONAL_MAX_THREADS)
+    {
+        _threads = D_FUNCTIONAL_MAX_THREADS;
+    }
+
+    task_count = (_count + D_FUNCTIONAL_PARALLEL_MIN_CHUNK - 1) /
+                 D_FUNCTIONAL_PARALLEL_MIN_CHUNK;
+
+    if (task_count > _threads)
+    {
+        task_count = _threads;
+    }
+
+    // a single chunk is an ordinary grouped fold
+    if (task_count <= 1)
+    {
+        return d_functional_group_fold(_input,
+                                       _count,
+                                       _element_size,
+                                       _key,
+                                       _key_size,
+                                       _hasher,
+                                       _equal,
+                                       _key_context,
+                                       _step,
+                                       _initial,
+                                       _state_size,
+                                       _context);
+    }
+
+    job.element_size = _element_size;
+    job.key          = _key;
+    job.key_size     = _key_size;
+    job.hasher       = _hasher;
+    job.equal        = _equal;
+    job.key_context  = _key_context;
+    job.step         = _step;
+    job.merge        = _merge;
+    job.initial      = _initial;
+    job.state_size   = _state_size;
+    job.context      = _context;
+    job.allocator    = d_functional_allocator_current();
+
+    // build phase: one table per contiguous chunk
+    base      = _count / task_count;
+    remainder = _count % task_count;
+    offset    = 0;
+
+    for (i = 0; i < task_count; i++)
+    {
+        tasks[i].job     = &job;
+        tasks[i].input   = (const unsigned char*)_input +
+                           (offset * _element_size);
+        tasks[i].count   = base + ((i < remainder) ? 1 : 0);
+        tasks[i].table   = NULL;
+        tasks[i].success = false;
+
+        offset += tasks[i].count;
+    }
+
+    success = d_group_run_tasks(tasks, task_count, d_group_task_build);
+
+    for (i = 0; i < task_count; i++)
+    {
+        locals[i] = tasks[i].table;
+    }
+
+    // merge phase: one hash partition per thread
+    for (i = 0; i < task_count; i++)
+    {
+        merges[i].job             = &job;
+        merges[i].locals          = locals;
+        merges[i].local_count     = task_count;
+        merges[i].partition       = i;
+        merges[i].partition_count = task_count;
+        merges[i].table           = NULL;
+        merges[i].success         = false;
+    }
+
+    if (success)
+    {
+        success = d_group_run_tasks(merges, task_count, d_group_task_merge);
+    }
+
+    // concatenate the disjoint partitions
+    result = (success) ? d_group_table_new(_key_size,
+                                           _state_size,
+                                           _hasher,
+                                           _equal,
+                                           _key_context)
+                       : NULL;
+
+    for (i = 0; (result) && (i < task_count); i++)
+    {
+        part = merges[i].table;
+
+        for (g = 0; g < part->count; g++)
+        {
+            if (!d_group_table_append(result,
+                                      part->keys + (g * _key_size),
+                                      part->hashes[g],
+                                      part->states + (g * _state_size)))
+            {
+                d_group_table_free(result);
+                result = NULL;
+
+                break;
+            }
+        }
+    }
+
+    for (i = 0; i < task_count; i++)
+    {
+        d_group_table_free(locals[i]);
+        d_group_table_free(merges[i].table);
+    }
+
+    return result;
+}
+
+/*
+d_group_table_find
+  Looks up the state of a key in a grouped-fold result.
+
+Parameter(s):
+  _table: the table to search.
+  _key:   the key to look up.
+Return:
+  A pointer to the group's state inside the table, or NULL if _table or _key
+was NULL or the key has no group.
+*/
+void*
+d_group_table_find
+(
+    const struct d_group_table* _table,
+    const void*                 _key
+)
+{
+    size_t group;
+
+    // validate parameters
+    if ( (!_table) ||
+         (!_key) )
+    {
+        return NULL;
+    }
+
+    group = d_group_table_locate(_table,
+                                 _key,
+                                 d_group_hash(_table, _key),
+                                 NULL);
+
+    return (group != D_GROUP_NONE)
+           ? _table->states + (group * _table->state_size)
+           : NULL;
+}
+
+/*
+d_group_table_free
+  Frees a grouped-fold result.
+
+Parameter(s):
+  _table: the table to free; may be NULL.
+Return:
+  none.
+*/
+void
+d_group_table_free
+(
+    struct d_group_table* _table
+)
+{
+    if (!_table)
+    {
+        return;
+    }
+
+    d_functional_free(_table->keys);
+    d_functional_free(_table->states);
+    d_functional_free(_table->hashes);
+    d_functional_free(_table->slots);
+    d_functional_free(_table);
+
+    return;
+}
@@ -0,0 +1,548 @@
+#include "..\..\inc\functional\mapped_io.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             I.    MAPPED INPUT                                          ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_functional_mapped_input
+  Maps a file of fixed-size records for reading, and advises the kernel
+that it will be read sequentially. The mapping is copy-on-write: records
+may be modified in memory (e.g. by in-place pipeline stages), but the
+file is never changed.
+
+Parameter(s):
+  _path:         path of the file.
+  _element_size: size of each record in bytes.
+Return:
+  A pointer to the mapped input, or NULL if a parameter is invalid, the
+file could not be mapped, or its size is not a whole number of records.
+*/
+struct d_mapped_input*
+d_functional_mapped_input
+(
+    const char* _path,
+    size_t      _element_size
+)
+{
+    struct d_mapped_input* input;
+
+    // validate parameters
+    if ( (!_path) ||
+         (_element_size == 0) )
+    {
+        return NULL;
+    }
+
+    input = d_functional_malloc(sizeof(struct d_mapped_input));
+
+    // ensure that memory allocation was successful
+    if (!input)
+    {
+        return NULL;
+    }
+
+    memset(input, 0, sizeof(*input));
+
+    if (!d_functional_map_open(&input->mapping, _path))
+    {
+        d_functional_free(input);
+
+        return NULL;
+    }
+
+    // a partial trailing record means the record size is wrong
+    if ((input->mapping.size % _element_size) != 0)
+    {
+        d_functional_map_close(&input->mapping, 0);
+        d_functional_free(input);
+
+        return NULL;
+    }
+
+    input->element_size = _element_size;
+    input->count        = input->mapping.size / _element_size;
+
+    d_functional_map_advise(&input->mapping,
+                            0,
+                            input->mapping.size,
+                            D_FUNCTIONAL_MAP_SEQUENTIAL);
+
+    return input;
+}
+
+
+/*
+d_mapped_input_data
+  Returns the mapped records.
+
+Parameter(s):
+  _input: the mapped input.
+Return:
+  A pointer to the first record, or NULL if _input is NULL or the file is
+empty.
+*/
+const void*
+d_mapped_input_data
+(
+    const struct d_mapped_input* _input
+)
+{
+    return (_input) ? _input->mapping.data : NULL;
+}
+
+
+/*
+d_mapped_input_count
+  Returns the number of records in a mapped input.
+
+Parameter(s):
+  _input: the mapped input.
+Return:
+  The number of records, or 0 if _input is NULL.
+*/
+size_t
+d_mapped_input_count
+(
+    const struct d_mapped_input* _input
+)
+{
+    return (_input) ? _input->count : 0;
+}
+
+
+/*
+d_mapped_input_next
+  Internal fn_source_next of a mapped input: hands out the next chunk of
+the mapping in place and prefetches the one after it.
+*/
+static bool
+d_mapped_input_next
+(
+    void*        _context,
+    const void** _chunk,
+    size_t*      _count
+)
+{
+    struct d_mapped_input* input;
+    size_t                 n;
+
+    input = (struct d_mapped_input*)_context;
+    n     = input->count - input->position;
+
+    if (n > input->chunk_count)
+    {
+        n = input->chunk_count;
+    }
+
+    *_chunk = (const unsigned char*)input->mapping.data
+              + (input->position * input->element_size);
+    *_count = n;
+
+    input->position += n;
+
+    if (input->position < input->count)
+    {
+        d_functional_map_advise(&input->mapping,
+                                input->position * input->element_size,
+                                input->chunk_count * input->element_size,
+                                D_FUNCTIONAL_MAP_WILLNEED);
+    }
+
+    return true;
+}
+
+
+/*
+d_mapped_input_source
+  Returns a source handing out the mapped records in chunks, from the
+first record. No records are copied. Only one source of an input should
+be in use at a time.
+
+Parameter(s):
+  _input:       the mapped input; must outlive the source.
+  _chunk_count: records per chunk; 0 selects D_MAPPED_IO_CHUNK_BYTES worth.
+Return:
+  The source, whose next_chunk is NULL if _input is NULL.
+*/
+struct d_functional_source
+d_mapped_input_source
+(
+    struct d_mapped_input* _input,
+    size_t                 _chunk_count
+)
+{
+    struct d_functional_source source;
+
+    source.next_chunk   = NULL;
+    source.context      = _input;
+    source.element_size = 0;
+
+    // validate parameters
+    if (!_input)
+    {
+        return source;
+    }
+
+    if (_chunk_count == 0)
+    {
+        _chunk_count = D_MAPPED_IO_CHUNK_BYTES / _input->element_size;
+        _chunk_count = (_chunk_count == 0) ? 1 : _chunk_count;
+    }
+
+    _input->position    = 0;
+    _input->chunk_count = _chunk_count;
+
+    source.next_chunk   = d_mapped_input_next;
+    source.element_size = _input->element_size;
+
+    return source;
+}
+
+
+/*
+d_mapped_input_pipeline
+  Returns a pipeline over the mapped records, begun in place: stages that
+fit write straight into the private copy-on-write pages instead of copying
+the file to the heap, and the file is unchanged.
+
+Parameter(s):
+  _input: the mapped input; must outlive the pipeline.
+Return:
+  A pipeline writing into the mapping (which it never frees), or a
+pipeline with error_code set to -1 if _input is NULL or the file is empty.
+*/
+struct d_functional_pipeline
+d_mapped_input_pipeline
+(
+    struct d_mapped_input* _input
+)
+{
+    if (!_input)
+    {
+        return d_functional_pipeline_begin_in_place(NULL, 0, 0);
+    }
+
+    return d_functional_pipeline_begin_in_place(_input->mapping.data,
+                                                _input->count,
+                                                _input->element_size);
+}
+
+
+/*
+d_mapped_input_free
+  Unmaps a mapped input and closes its file.
+
+Parameter(s):
+  _input: the mapped input to free; may be NULL.
+Return:
+  none.
+*/
+void
+d_mapped_input_free
+(
+    struct d_mapped_input* _input
+)
+{
+    if (!_input)
+    {
+        return;
+    }
+
+    d_functional_map_close(&_input->mapping, 0);
+    d_functional_free(_input);
+
+    return;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             II.   MAPPED OUTPUT                                         ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_functional_mapped_output
+  Creates (or truncates) an output file of fixed-size records and maps it
+for writing.
+
+Parameter(s):
+  _path:          path of the file.
+  _element_size:  size of each record in bytes.
+  _initial_count: records to reserve up front; 0 selects
+                  D_MAPPED_IO_CHUNK_BYTES worth. The mapping doubles as
+                  needed.
+Return:
+  A pointer to the mapped output, or NULL if a parameter is invalid or the
+file could not be created or mapped.
+*/
+struct d_mapped_output*
+d_functional_mapped_output
+(
+    const char* _path,
+    size_t      _element_size,
+    size_t      _initial_count
+)
+{
+    struct d_mapped_output* output;
+
+    // validate parameters
+    if ( (!_path) ||
+         (_element_size == 0) )
+    {
+        return NULL;
+    }
+
+    if (_initial_count == 0)
+    {
+        _initial_count = D_MAPPED_IO_CHUNK_BYTES / _element_size;
+        _initial_count = (_initial_count == 0) ? 1 : _initial_count;
+    }
+
+    output = d_functional_malloc(sizeof(struct d_mapped_output));
+
+    // ensure that memory allocation was successful
+    if (!output)
+    {
+        return NULL;
+    }
+
+    memset(output, 0, sizeof(*output));
+
+    if (!d_functional_map_create(&output->mapping,
+                                 _path,
+                                 _initial_count * _element_size))
+    {
+        d_functional_free(output);
+
+        return NULL;
+    }
+
+    output->element_size = _element_size;
+    output->capacity     = _initial_count;
+
+    return output;
+}
+
+
+/*
+d_mapped_output_reserve
+  Ensures room for _count more records and returns where they go, so that
+they can be produced directly into the file. The records only count as
+written once committed with d_mapped_output_commit.
+
+Parameter(s):
+  _output: the mapped output.
+  _count:  number of records to make room for.
+Return:
+  A pointer to the first free record, valid until the next reserve or
+write (which may move the mapping), or NULL if _output is NULL, in an
+error state, or could not be grown; error_code is then set.
+*/
+void*
+d_mapped_output_reserve
+(
+    struct d_mapped_output* _output,
+    size_t                  _count
+)
+{
+    size_t capacity;
+
+    // validate parameters
+    if ( (!_output) ||
+         (_output->error_code != 0) )
+    {
+        return NULL;
+    }
+
+    if (_output->count + _count > _output->capacity)
+    {
+        capacity = (_output->capacity == 0) ? 1 : _output->capacity;
+
+        while (capacity < _output->count + _count)
+        {
+            capacity *= 2;
+        }
+
+        if (!d_functional_map_resize(&_output->mapping,
+                                     capacity * _output->element_size))
+        {
+            _output->error_code = -1;
+
+            return NULL;
+        }
+
+        _output->capacity = capacity;
+    }
+
+    return (unsigned char*)_output->mapping.data
+           + (_output->count * _output->element_size);
+}
+
+
+/*
+d_mapped_output_commit
+  Marks records produced in reserved space as written.
+
+Parameter(s):
+  _output: the mapped output.
+  _count:  number of records written; at most the reserved room.
+Return:
+  A boolean value corresponding to either:
+  - true, if the records were committed, or
+  - false, if _output is NULL, in an error state, or _count exceeds the
+    capacity.
+*/
+bool
+d_mapped_output_commit
+(
+    struct d_mapped_output* _output,
+    size_t                  _count
+)
+{
+    // validate parameters
+    if ( (!_output)                  ||
+         (_output->error_code != 0)  ||
+         (_count > _output->capacity - _output->count) )
+    {
+        return false;
+    }
+
+    _output->count += _count;
+
+    return true;
+}
+
+
+/*
+d_mapped_output_write
+  Appends records to a mapped output.
+
+Parameter(s):
+  _output:   the mapped output.
+  _elements: the records; may be NULL if _count is 0.
+  _count:    number of records.
+Return:
+  A boolean value corresponding to either:
+  - true, if the records were written, or
+  - false, if a parameter was NULL or the output could not be grown.
+*/
+bool
+d_mapped_output_write
+(
+    struct d_mapped_output* _output,
+    const void*             _elements,
+    size_t                  _count
+)
+{
+    void* slot;
+
+    // validate parameters
+    if ( (!_output) ||
+         ( (!_elements) && (_count != 0) ) )
+    {
+        return false;
+    }
+
+    if (_count == 0)
+    {
+        return (_output->error_code == 0);
+    }
+
+    slot = d_mapped_output_reserve(_output, _count);
+
+    if (!slot)
+    {
+        return false;
+    }
+
+    memcpy(slot, _elements, _count * _output->element_size);
+    _output->count += _count;
+
+    return true;
+}
+
+
+/*
+d_mapped_output_drain
+  Writes every chunk of a source (an array, a mapped input, a stream, or a
+filter stream) to a mapped output.
+
+Parameter(s):
+  _output: the mapped output.
+  _source: the source; its element size must match the output's.
+Return:
+  A boolean value corresponding to either:
+  - true, if the whole source was written, or
+  - false, if a parameter was NULL, the element sizes differ, or the
+    source or a write failed.
+*/
+bool
+d_mapped_output_drain
+(
+    struct d_mapped_output*     _output,
+    struct d_functional_source* _source
+)
+{
+    const void* chunk;
+    size_t      n;
+
+    // validate parameters
+    if ( (!_output) ||
+         (!_source) ||
+         (_source->element_size != _output->element_size) )
+    {
+        return false;
+    }
+
+    while (d_functional_source_next(_source, &chunk, &n))
+    {
+        if (n == 0)
+        {
+            return true;
+        }
+
+        if (!d_mapped_output_write(_output, chunk, n))
+        {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+
+/*
+d_mapped_output_close
+  Unmaps a mapped output, cuts its file to the records written, and frees
+it.
+
+Parameter(s):
+  _output: the mapped output; may be NULL.
+Return:
+  A boolean value corresponding to either:
+  - true, if the file was completed without errors, or
+  - false, if _output was NULL, an earlier write failed, or the file
+    could not be truncated. The output is freed regardless.
+*/
+bool
+d_mapped_output_close
+(
+    struct d_mapped_output* _output
+)
+{
+    bool ok;
+
+    if (!_output)
+    {
+        return false;
+    }
+
+    ok = d_functional_map_close(&_output->mapping,
+                                _output->count * _output->element_size);
+    ok = ok && (_output->error_code == 0);
+
+    d_functional_free(_output);
+
+    return ok;
+}
@@ -0,0 +1,834 @@
+#include "..\..\inc\functional\memoize.h"
+
+
+// slot flag bits
+#define D_MEMOIZE_FLAG_VALID      0x01
+#define D_MEMOIZE_FLAG_REFERENCED 0x02
+
+
+/*
+d_memoize_round_pow2
+  Internal helper returning the smallest power of two >= _value (and >= 1).
+*/
+static size_t
+d_memoize_round_pow2
+(
+    size_t _value
+)
+{
+    size_t result;
+
+    result = 1;
+
+    while (result < _value)
+    {
+        result <<= 1;
+    }
+
+    return result;
+}
+
+/*
+d_memoize_round_up
+  Internal helper rounding an offset up to a multiple of 16 bytes, so that
+every slot array of the shared allocation starts suitably aligned.
+*/
+static size_t
+d_memoize_round_up
+(
+    size_t _offset
+)
+{
+    return (_offset + 15) & ~(size_t)15;
+}
+
+/*
+d_memoize_hash_bytes
+  Internal default hasher: 64-bit FNV-1a over the key bytes.
+*/
+static size_t
+d_memoize_hash_bytes
+(
+    const void* _key,
+    size_t      _key_size
+)
+{
+    const unsigned char* bytes;
+    uint64_t             hash;
+    size_t               i;
+
+    bytes = (const unsigned char*)_key;
+    hash  = 14695981039346656037ULL;
+
+    for (i = 0; i < _key_size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return (size_t)hash;
+}
+
+/*
+d_memoize_mix
+  Internal helper that scrambles a user hash (64-bit finalizer from
+MurmurHash3), so that weak hashers such as the identity on integers still
+spread evenly over shards and sets.
+*/
+static size_t
+d_memoize_mix
+(
+    size_t _hash
+)
+{
+    uint64_t hash;
+
+    hash  = (uint64_t)_hash;
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+
+    return (size_t)hash;
+}
+
+/*
+d_memoize_new
+  Internal constructor shared by the predicate and transformer variants.
+*/
+static struct d_memoize*
+d_memoize_new
+(
+    enum d_memoize_kind _kind,
+    size_t              _key_size,
+    size_t              _value_size,
+    fn_hasher           _hasher,
+    void*               _hasher_context,
+    size_t              _capacity,
+    size_t              _shards
+)
+{
+    struct d_memoize* memo;
+    unsigned char*    block;
+    size_t            total_sets;
+    size_t            total_slots;
+    size_t            keys_offset;
+    size_t            values_offset;
+    size_t            flags_offset;
+    size_t            hands_offset;
+    size_t            block_size;
+    size_t            i;
+
+    memo = d_functional_malloc(sizeof(struct d_memoize));
+
+    // ensure that memory allocation was successful
+    if (!memo)
+    {
+        return NULL;
+    }
+
+    if (_capacity == 0)
+    {
+        _capacity = D_MEMOIZE_DEFAULT_CAPACITY;
+    }
+
+    // 0 shards: single unlocked table; otherwise a power of two of locked
+    // shards
+    memo->locking        = (_shards > 0);
+    memo->shard_count    = d_memoize_round_pow2(_shards);
+    memo->sets_per_shard = d_memoize_round_pow2(
+        (_capacity + (D_MEMOIZE_WAYS * memo->shard_count) - 1) /
+        (D_MEMOIZE_WAYS * memo->shard_count));
+
+    memo->kind           = _kind;
+    memo->predicate      = NULL;
+    memo->transform      = NULL;
+    memo->context        = NULL;
+    memo->hasher         = _hasher;
+    memo->hasher_context = _hasher_context;
+    memo->equal          = NULL;
+    memo->equal_context  = NULL;
+    memo->key_size       = _key_size;
+    memo->value_size     = _value_size;
+
+    total_sets  = memo->sets_per_shard * memo->shard_count;
+    total_slots = total_sets * D_MEMOIZE_WAYS;
+
+    // all slot arrays share one allocation
+    keys_offset   = d_memoize_round_up(total_slots * sizeof(size_t));
+    values_offset = d_memoize_round_up(keys_offset +
+                                       (total_slots * _key_size));
+    flags_offset  = d_memoize_round_up(values_offset +
+                                       (total_slots * _value_size));
+    hands_offset  = flags_offset + total_slots;
+    block_size    = hands_offset + total_sets;
+
+    memo->shards = d_functional_malloc(memo->shard_count *
+                                       sizeof(struct d_memoize_shard));
+    block        = d_functional_malloc(block_size);
+
+    // ensure that memory allocation was successful
+    if ( (!memo->shards) ||
+         (!block) )
+    {
+        d_functional_free(memo->shards);
+        d_functional_free(block);
+        d_functional_free(memo);
+
+        return NULL;
+    }
+
+    memo->hashes = (size_t*)block;
+    memo->keys   = block + keys_offset;
+    memo->values = block + values_offset;
+    memo->flags  = block + flags_offset;
+    memo->hands  = block + hands_offset;
+
+    memset(memo->flags, 0, total_slots);
+    memset(memo->hands, 0, total_sets);
+
+    for (i = 0; i < memo->shard_count; i++)
+    {
+        memo->shards[i].first_set = i * memo->sets_per_shard;
+        memo->shards[i].hits      = 0;
+        memo->shards[i].misses    = 0;
+        memo->shards[i].evictions = 0;
+
+        if ( (memo->locking) &&
+             (!d_functional_mutex_init(&memo->shards[i].lock)) )
+        {
+            // unwind the shards initialized so far
+            while (i > 0)
+            {
+                i--;
+                d_functional_mutex_destroy(&memo->shards[i].lock);
+            }
+
+            d_functional_free(memo->shards);
+            d_functional_free(block);
+            d_functional_free(memo);
+
+            return NULL;
+        }
+    }
+
+    return memo;
+}
+
+/*
+d_functional_memoize_predicate
+  Creates a memoized wrapper around a pure predicate. Evaluate it through
+d_functional_memoized_test, passing the memo as the context.
+
+Parameter(s):
+  _predicate:      the predicate to memoize; must be pure.
+  _context:        context passed to _predicate; may be NULL.
+  _key_size:       size in bytes of the elements tested.
+  _hasher:         hash function for elements; NULL hashes the element's
+                   _key_size bytes.
+  _hasher_context: context passed to _hasher; may be NULL.
+  _capacity:       approximate number of cached results; 0 selects
+                   D_MEMOIZE_DEFAULT_CAPACITY. Rounded up to fill whole
+                   sets and shards.
+  _shards:         0 for a single-threaded memo without locking, or the
+                   number of independently locked shards (rounded up to a
+                   power of two) for concurrent use.
+Return:
+  A pointer to a newly allocated d_memoize, or NULL if _predicate was NULL,
+_key_size was 0, or allocation failed.
+*/
+struct d_memoize*
+d_functional_memoize_predicate
+(
+    fn_predicate _predicate,
+    void*        _context,
+    size_t       _key_size,
+    fn_hasher    _hasher,
+    void*        _hasher_context,
+    size_t       _capacity,
+    size_t       _shards
+)
+{
+    struct d_memoize* memo;
+
+    // validate parameters
+    if ( (!_predicate) ||
+         (_key_size == 0) )
+    {
+        return NULL;
+    }
+
+    memo = d_memoize_new(D_MEMOIZE_PREDICATE,
+                         _key_size,
+                         sizeof(bool),
+                         _hasher,
+                         _hasher_context,
+                         _capacity,
+                         _shards);
+
+    if (memo)
+    {
+        memo->predicate = _predicate;
+        memo->context   = _context;
+    }
+
+    return memo;
+}
+
+/*
+d_functional_memoize_transformer
+  Creates a memoized wrapper around a pure transformer. Evaluate it through
+d_functional_memoized_apply, passing the memo as the context. Failed
+transformations are not cached.
+
+Parameter(s):
+  _transform:      the transformer to memoize; must be pure.
+  _context:        context passed to _transform; may be NULL.
+  _key_size:       size in bytes of the inputs.
+  _output_size:    size in bytes of the outputs.
+  _hasher:         hash function for inputs; NULL hashes the input's
+                   _key_size bytes.
+  _hasher_context: context passed to _hasher; may be NULL.
+  _capacity:       approximate number of cached results; 0 selects
+                   D_MEMOIZE_DEFAULT_CAPACITY.
+  _shards:         0 for a single-threaded memo without locking, or the
+                   number of independently locked shards for concurrent
+                   use.
+Return:
+  A pointer to a newly allocated d_memoize, or NULL if _transform was NULL,
+_key_size or _output_size was 0, or allocation failed.
+*/
+struct d_memoize*
+d_functional_memoize_transformer
+(
+    fn_transformer _transform,
+    void*          _context,
+    size_t         _key_size,
+    size_t         _output_size,
+    fn_hasher      _hasher,
+    void*          _hasher_context,
+    size_t         _capacity,
+    size_t         _shards
+)
+{
+    struct d_memoize* memo;
+
+    // validate parameters
+    if ( (!_transform)     ||
+         (_key_size == 0)  ||
+         (_output_size == 0) )
+    {
+        return NULL;
+    }
+
+    memo = d_memoize_new(D_MEMOIZE_TRANSFORMER,
+                         _key_size,
+                         _output_size,
+                         _hasher,
+                         _hasher_context,
+                         _capacity,
+                         _shards);
+
+    if (memo)
+    {
+        memo->transform = _transform;
+        memo->context   = _context;
+    }
+
+    return memo;
+}
+
+/*
+d_functional_memoize_set_equality
+  Sets the key equality test of a memo. By default keys are compared
+byte-for-byte, which is correct for plain-old-data keys; keys holding
+pointers (e.g. strings) need an equality that matches the hasher. Should be
+set before the memo is first used.
+
+Parameter(s):
+  _memo:    the memo.
+  _equal:   the equality test; NULL restores byte comparison.
+  _context: context passed to _equal; may be NULL.
+Return:
+  A boolean value corresponding to either:
+  - true, if the equality test was set, or
+  - false, if _memo was NULL.
+*/
+bool
+d_functional_memoize_set_equality
+(
+    struct d_memoize*   _memo,
+    fn_binary_predicate _equal,
+    void*               _context
+)
+{
+    if (!_memo)
+    {
+        return false;
+    }
+
+    _memo->equal         = _equal;
+    _memo->equal_context = _context;
+
+    return true;
+}
+
+/*
+d_memoize_key_equal
+  Internal helper comparing a stored key with a lookup key.
+*/
+static bool
+d_memoize_key_equal
+(
+    const struct d_memoize* _memo,
+    const unsigned char*    _stored,
+    const void*             _key
+)
+{
+    if (_memo->equal)
+    {
+        return _memo->equal(_stored, _key, _memo->equal_context);
+    }
+
+    return (memcmp(_stored, _key, _memo->key_size) == 0);
+}
+
+/*
+d_memoize_find
+  Internal helper returning the slot of _key within the set starting at
+_base, or (size_t)-1 if it is not cached. The caller holds the shard lock.
+*/
+static size_t
+d_memoize_find
+(
+    const struct d_memoize* _memo,
+    size_t                  _base,
+    size_t                  _hash,
+    const void*             _key
+)
+{
+    size_t slot;
+    size_t w;
+
+    for (w = 0; w < D_MEMOIZE_WAYS; w++)
+    {
+        slot = _base + w;
+
+        if ( (_memo->flags[slot] & D_MEMOIZE_FLAG_VALID) &&
+             (_memo->hashes[slot] == _hash)              &&
+             (d_memoize_key_equal(_memo,
+                                  _memo->keys + (slot * _memo->key_size),
+                                  _key)) )
+        {
+            return slot;
+        }
+    }
+
+    return (size_t)-1;
+}
+
+/*
+d_memoize_insert
+  Internal helper storing a result. Reuses the key's slot if another thread
+inserted it meanwhile, then a free slot, and otherwise evicts with CLOCK:
+the set's hand skips (and clears) referenced entries and evicts the first
+unreferenced one. The caller holds the shard lock.
+*/
+static void
+d_memoize_insert
+(
+    struct d_memoize*       _memo,
+    struct d_memoize_shard* _shard,
+    size_t                  _set,
+    size_t                  _hash,
+    const void*             _key,
+    const void*             _value
+)
+{
+    size_t base;
+    size_t slot;
+    size_t hand;
+    size_t w;
+
+    base = _set * D_MEMOIZE_WAYS;
+    slot = d_memoize_find(_memo, base, _hash, _key);
+
+    if (slot == (size_t)-1)
+    {
+        for (w = 0; w < D_MEMOIZE_WAYS; w++)
+        {
+            if (!(_memo->flags[base + w] & D_MEMOIZE_FLAG_VALID))
+            {
+                slot = base + w;
+
+                break;
+            }
+        }
+    }
+
+    if (slot == (size_t)-1)
+    {
+        hand = _memo->hands[_set];
+
+        while (_memo->flags[base + hand] & D_MEMOIZE_FLAG_REFERENCED)
+        {
+            _memo->flags[base + hand] &= (unsigned char)
+                                         ~D_MEMOIZE_FLAG_REFERENCED;
+            hand = (hand + 1) % D_MEMOIZE_WAYS;
+        }
+
+        slot               = base + hand;
+        _memo->hands[_set] = (unsigned char)((hand + 1) % D_MEMOIZE_WAYS);
+        _shard->evictions++;
+    }
+
+    memcpy(_memo->keys + (slot * _memo->key_size), _key, _memo->key_size);
+    memcpy(_memo->values + (slot * _memo->value_size),
+           _value,
+           _memo->value_size);
+    _memo->hashes[slot] = _hash;
+    _memo->flags[slot]  = D_MEMOIZE_FLAG_VALID;
+
+    return;
+}
+
+/*
+d_memoize_call
+  Internal helper implementing a memoized call: looks the key up, and on a
+miss calls the wrapped function outside the lock and caches its result.
+
+Return:
+  A boolean value corresponding to either:
+  - true, if _value holds the result, or
+  - false, if the wrapped transformer failed.
+*/
+static bool
+d_memoize_call
+(
+    struct d_memoize* _memo,
+    const void*       _key,
+    void*             _value
+)
+{
+    struct d_memoize_shard* shard;
+    const unsigned char*    key_bytes;
+    unsigned char*          value_bytes;
+    size_t                  hash;
+    size_t                  set;
+    size_t                  slot;
+    bool                    overlap;
+
+    hash = (_memo->hasher)
+           ? _memo->hasher(_key, _memo->hasher_context)
+           : d_memoize_hash_bytes(_key, _memo->key_size);
+    hash = d_memoize_mix(hash);
+
+    // low bits pick the shard, the next bits pick the set within it
+    shard = &_memo->shards[hash & (_memo->shard_count - 1)];
+    set   = shard->first_set +
+            ((hash / _memo->shard_count) & (_memo->sets_per_shard - 1));
+
+    if (_memo->locking)
+    {
+        d_functional_mutex_lock(&shard->lock);
+    }
+
+    slot = d_memoize_find(_memo, set * D_MEMOIZE_WAYS, hash, _key);
+
+    if (slot != (size_t)-1)
+    {
+        memcpy(_value,
+               _memo->values + (slot * _memo->value_size),
+               _memo->value_size);
+        _memo->flags[slot] |= D_MEMOIZE_FLAG_REFERENCED;
+        shard->hits++;
+
+        if (_memo->locking)
+        {
+            d_functional_mutex_unlock(&shard->lock);
+        }
+
+        return true;
+    }
+
+    shard->misses++;
+
+    if (_memo->locking)
+    {
+        d_functional_mutex_unlock(&shard->lock);
+    }
+
+    // compute without holding the lock; the function may be slow
+    if (_memo->kind == D_MEMOIZE_PREDICATE)
+    {
+        *(bool*)_value = _memo->predicate(_key, _memo->context);
+    }
+    else if (!_memo->transform(_key, _value, _memo->context))
+    {
+        return false;
+    }
+
+    // an in-place transformation has overwritten its key; don't cache it
+    key_bytes   = (const unsigned char*)_key;
+    value_bytes = (unsigned char*)_value;
+    overlap     = ( (key_bytes < value_bytes + _memo->value_size) &&
+                    (value_bytes < key_bytes + _memo->key_size) );
+
+    if (overlap)
+    {
+        return true;
+    }
+
+    if (_memo->locking)
+    {
+        d_functional_mutex_lock(&shard->lock);
+    }
+
+    d_memoize_insert(_memo, shard, set, hash, _key, _value);
+
+    if (_memo->locking)
+    {
+        d_functional_mutex_unlock(&shard->lock);
+    }
+
+    return true;
+}
+
+/*
+d_functional_memoized_test
+  fn_predicate adapter for a memoized predicate.
+
+Parameter(s):
+  _element: pointer to the element to test.
+  _context: the d_memoize created by d_functional_memoize_predicate.
+Return:
+  The (possibly cached) result of the wrapped predicate, or false if
+_element or _context was NULL or the memo does not wrap a predicate.
+*/
+bool
+d_functional_memoized_test
+(
+    const void* _element,
+    void*       _context
+)
+{
+    struct d_memoize* memo;
+    bool              value;
+
+    memo = (struct d_memoize*)_context;
+
+    // validate parameters
+    if ( (!_element) ||
+         (!memo)     ||
+         (memo->kind != D_MEMOIZE_PREDICATE) )
+    {
+        return false;
+    }
+
+    value = false;
+
+    d_memoize_call(memo, _element, &value);
+
+    return value;
+}
+
+/*
+d_functional_memoized_apply
+  fn_transformer adapter for a memoized transformer.
+
+Parameter(s):
+  _input:   pointer to the input.
+  _output:  pointer to where the output is written.
+  _context: the d_memoize created by d_functional_memoize_transformer.
+Return:
+  A boolean value corresponding to either:
+  - true, if _output holds the (possibly cached) result, or
+  - false, if a parameter was NULL, the memo does not wrap a transformer,
+    or the wrapped transformer failed.
+*/
+bool
+d_functional_memoized_apply
+(
+    const void* _input,
+    void*       _output,
+    void*       _context
+)
+{
+    struct d_memoize* memo;
+
+    memo = (struct d_memoize*)_context;
+
+    // validate parameters
+    if ( (!_input)  ||
+         (!_output) ||
+         (!memo)    ||
+         (memo->kind != D_MEMOIZE_TRANSFORMER) )
+    {
+        return false;
+    }
+
+    return d_memoize_call(memo, _input, _output);
+}
+
+/*
+d_functional_memoize_stats
+  Reads the cache counters of a memo, summed over all shards. Safe to call
+concurrently with evaluation on a sharded memo.
+
+Parameter(s):
+  _memo:  the memo.
+  _stats: destination for the counters.
+Return:
+  A boolean value corresponding to either:
+  - true, if _stats was filled, or
+  - false, if either parameter was NULL.
+*/
+bool
+d_functional_memoize_stats
+(
+    struct d_memoize*       _memo,
+    struct d_memoize_stats* _stats
+)
+{
+    struct d_memoize_shard* shard;
+    size_t                  first;
+    size_t                  last;
+    size_t                  i;
+    size_t                  slot;
+
+    // validate parameters
+    if ( (!_memo) ||
+         (!_stats) )
+    {
+        return false;
+    }
+
+    _stats->hits      = 0;
+    _stats->misses    = 0;
+    _stats->evictions = 0;
+    _stats->entries   = 0;
+    _stats->capacity  = _memo->shard_count *
+                        _memo->sets_per_shard *
+                        D_MEMOIZE_WAYS;
+
+    for (i = 0; i < _memo->shard_count; i++)
+    {
+        shard = &_memo->shards[i];
+        first = shard->first_set * D_MEMOIZE_WAYS;
+        last  = first + (_memo->sets_per_shard * D_MEMOIZE_WAYS);
+
+        if (_memo->locking)
+        {
+            d_functional_mutex_lock(&shard->lock);
+        }
+
+        _stats->hits      += shard->hits;
+        _stats->misses    += shard->misses;
+        _stats->evictions += shard->evictions;
+
+        for (slot = first; slot < last; slot++)
+        {
+            if (_memo->flags[slot] & D_MEMOIZE_FLAG_VALID)
+            {
+                _stats->entries++;
+            }
+        }
+
+        if (_memo->locking)
+        {
+            d_functional_mutex_unlock(&shard->lock);
+        }
+    }
+
+    return true;
+}
+
+/*
+d_functional_memoize_clear
+  Discards every cached result and resets the counters of a memo.
+
+Parameter(s):
+  _memo: the memo; may be NULL.
+Return:
+  none.
+*/
+void
+d_functional_memoize_clear
+(
+    struct d_memoize* _memo
+)
+{
+    struct d_memoize_shard* shard;
+    size_t                  i;
+
+    if (!_memo)
+    {
+        return;
+    }
+
+    for (i = 0; i < _memo->shard_count; i++)
+    {
+        shard = &_memo->shards[i];
+
+        if (_memo->locking)
+        {
+            d_functional_mutex_lock(&shard->lock);
+        }
+
+        memset(_memo->flags + (shard->first_set * D_MEMOIZE_WAYS),
+               0,
+               _memo->sets_per_shard * D_MEMOIZE_WAYS);
+        memset(_memo->hands + shard->first_set,
+               0,
+               _memo->sets_per_shard);
+        shard->hits      = 0;
+        shard->misses    = 0;
+        shard->evictions = 0;
+
+        if (_memo->locking)
+        {
+            d_functional_mutex_unlock(&shard->lock);
+        }
+    }
+
+    return;
+}
+
+/*
+d_functional_memoize_free
+  Frees a memo and its cache. Does not free the wrapped function's context.
+
+Parameter(s):
+  _memo: the memo to free; may be NULL.
+Return:
+  none.
+*/
+void
+d_functional_memoize_free
+(
+    struct d_memoize* _memo
+)
+{
+    size_t i;
+
+    if (!_memo)
+    {
+        return;
+    }
+
+    if (_memo->locking)
+    {
+        for (i = 0; i < _memo->shard_count; i++)
+        {
+            d_functional_mutex_destroy(&_memo->shards[i].lock);
+        }
+    }
+
+    // every slot array lives in the block starting at hashes
+    d_functional_free(_memo->hashes);
+    d_functional_free(_memo->shards);
+    d_functional_free(_memo);
+
+    return;
+}
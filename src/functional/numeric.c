@@ -0,0 +1,1667 @@
+#include "..\..\inc\functional\numeric.h"
+#include <math.h>
+
+
+// SIMD selection: AVX2 and SSE2 kernels are compiled only when the target
+// guarantees the instruction set, so no runtime dispatch is needed
+#if !defined(D_FUNCTIONAL_NO_SIMD)
+    #if defined(__AVX2__)
+        #define D_NUMERIC_AVX2 1
+    #endif
+
+    #if ( defined(__SSE2__) || defined(_M_X64) ||                          \
+          ( defined(_M_IX86_FP) && (_M_IX86_FP >= 2) ) )
+        #define D_NUMERIC_SSE2 1
+    #endif
+#endif
+
+#if defined(D_NUMERIC_AVX2)
+    #include <immintrin.h>
+#elif defined(D_NUMERIC_SSE2)
+    #include <emmintrin.h>
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             I.    PORTABLE KERNELS                                      ///
+///////////////////////////////////////////////////////////////////////////////
+
+// D_NUMERIC_SUM_KERNEL
+//   internal macro: defines a static sum kernel keeping four independent
+// accumulators of ACC_TYPE.
+#define D_NUMERIC_SUM_KERNEL(name,                                          \
+                             type,                                          \
+                             acc_type)                                      \
+    static acc_type                                                         \
+    name                                                                    \
+    (                                                                       \
+        const type* _values,                                                \
+        size_t      _count                                                  \
+    )                                                                       \
+    {                                                                       \
+        acc_type s0;                                                        \
+        acc_type s1;                                                        \
+        acc_type s2;                                                        \
+        acc_type s3;                                                        \
+        size_t   i;                                                         \
+                                                                            \
+        s0 = s1 = s2 = s3 = 0;                                              \
+                                                                            \
+        for (i = 0; i + 4 <= _count; i += 4)                                \
+        {                                                                   \
+            s0 += (acc_type)_values[i];                                     \
+            s1 += (acc_type)_values[i + 1];                                 \
+            s2 += (acc_type)_values[i + 2];                                 \
+            s3 += (acc_type)_values[i + 3];                                 \
+        }                                                                   \
+                                                                            \
+        for (; i < _count; i++)                                             \
+        {                                                                   \
+            s0 += (acc_type)_values[i];                                     \
+        }                                                                   \
+                                                                            \
+        return (s0 + s1) + (s2 + s3);                                       \
+    }
+
+// D_NUMERIC_EXTREMUM_KERNEL
+//   internal macro: defines a static kernel returning the element e for
+// which no other element x satisfies (x OP e); _count must be non-zero.
+// OP is < for a minimum and > for a maximum.
+#define D_NUMERIC_EXTREMUM_KERNEL(name,                                     \
+                                  type,                                     \
+                                  op)                                       \
+    static type                                                             \
+    name                                                                    \
+    (                                                                       \
+        const type* _values,                                                \
+        size_t      _count                                                  \
+    )                                                                       \
+    {                                                                       \
+        type   b0;                                                          \
+        type   b1;                                                          \
+        type   b2;                                                          \
+        type   b3;                                                          \
+        size_t i;                                                           \
+                                                                            \
+        b0 = b1 = b2 = b3 = _values[0];                                     \
+                                                                            \
+        for (i = 0; i + 4 <= _count; i += 4)                                \
+        {                                                                   \
+            b0 = (_values[i] op b0)     ? _values[i]     : b0;              \
+            b1 = (_values[i + 1] op b1) ? _values[i + 1] : b1;              \
+            b2 = (_values[i + 2] op b2) ? _values[i + 2] : b2;              \
+            b3 = (_values[i + 3] op b3) ? _values[i + 3] : b3;              \
+        }                                                                   \
+                                                                            \
+        for (; i < _count; i++)                                             \
+        {                                                                   \
+            b0 = (_values[i] op b0) ? _values[i] : b0;                      \
+        }                                                                   \
+                                                                            \
+        b0 = (b1 op b0) ? b1 : b0;                                          \
+        b2 = (b3 op b2) ? b3 : b2;                                          \
+                                                                            \
+        return (b2 op b0) ? b2 : b0;                                        \
+    }
+
+// D_NUMERIC_MINMAX_KERNEL
+//   internal macro: defines a static kernel computing minimum and maximum
+// in one pass with two lanes each; _count must be non-zero.
+#define D_NUMERIC_MINMAX_KERNEL(name,                                       \
+                                type)                                       \
+    static void                                                             \
+    name                                                                    \
+    (                                                                       \
+        const type* _values,                                                \
+        size_t      _count,                                                 \
+        type*       _min,                                                   \
+        type*       _max                                                    \
+    )                                                                       \
+    {                                                                       \
+        type   lo0;                                                         \
+        type   lo1;                                                         \
+        type   hi0;                                                         \
+        type   hi1;                                                         \
+        size_t i;                                                           \
+                                                                            \
+        lo0 = lo1 = hi0 = hi1 = _values[0];                                 \
+                                                                            \
+        for (i = 0; i + 2 <= _count; i += 2)                                \
+        {                                                                   \
+            lo0 = (_values[i] < lo0)     ? _values[i]     : lo0;            \
+            hi0 = (_values[i] > hi0)     ? _values[i]     : hi0;            \
+            lo1 = (_values[i + 1] < lo1) ? _values[i + 1] : lo1;            \
+            hi1 = (_values[i + 1] > hi1) ? _values[i + 1] : hi1;            \
+        }                                                                   \
+                                                                            \
+        if (i < _count)                                                     \
+        {                                                                   \
+            lo0 = (_values[i] < lo0) ? _values[i] : lo0;                    \
+            hi0 = (_values[i] > hi0) ? _values[i] : hi0;                    \
+        }                                                                   \
+                                                                            \
+        *_min = (lo1 < lo0) ? lo1 : lo0;                                    \
+        *_max = (hi1 > hi0) ? hi1 : hi0;                                    \
+                                                                            \
+        return;                                                             \
+    }
+
+// D_NUMERIC_ARG_KERNEL
+//   internal macro: defines a static kernel returning the index of the first
+// extremum; _count must be non-zero. Element i is tracked by lane (i % 4),
+// so each lane sees its elements in increasing index order and keeps the
+// first of equal values; lanes are then merged preferring lower indices.
+#define D_NUMERIC_ARG_KERNEL(name,                                          \
+                             type,                                          \
+                             op)                                            \
+    static size_t                                                           \
+    name                                                                    \
+    (                                                                       \
+        const type* _values,                                                \
+        size_t      _count                                                  \
+    )                                                                       \
+    {                                                                       \
+        type   best[4];                                                     \
+        size_t index[4];                                                    \
+        size_t lanes;                                                       \
+        size_t i;                                                           \
+        size_t k;                                                           \
+        size_t result;                                                      \
+                                                                            \
+        lanes = (_count < 4) ? _count : 4;                                  \
+                                                                            \
+        for (k = 0; k < lanes; k++)                                         \
+        {                                                                   \
+            best[k]  = _values[k];                                          \
+            index[k] = k;                                                   \
+        }                                                                   \
+                                                                            \
+        for (i = lanes; i + 4 <= _count; i += 4)                            \
+        {                                                                   \
+            for (k = 0; k < 4; k++)                                         \
+            {                                                               \
+                if (_values[i + k] op best[k])                              \
+                {                                                           \
+                    best[k]  = _values[i + k];                              \
+                    index[k] = i + k;                                       \
+                }                                                           \
+            }                                                               \
+        }                                                                   \
+                                                                            \
+        for (; i < _count; i++)                                             \
+        {                                                                   \
+            k = i & 3;                                                      \
+                                                                            \
+            if (_values[i] op best[k])                                      \
+            {                                                               \
+                best[k]  = _values[i];                                      \
+                index[k] = i;                                               \
+            }                                                               \
+        }                                                                   \
+                                                                            \
+        result = 0;                                                         \
+                                                                            \
+        for (k = 1; k < lanes; k++)                                         \
+        {                                                                   \
+            if ( (best[k] op best[result]) ||                               \
+                 ( (!(best[result] op best[k])) &&                          \
+                   (index[k] < index[result]) ) )                           \
+            {                                                               \
+                result = k;                                                 \
+            }                                                               \
+        }                                                                   \
+                                                                            \
+        return index[result];                                               \
+    }
+
+// D_NUMERIC_DEVIATION_KERNEL
+//   internal macro: defines a static kernel accumulating the sum of
+// (x - _mean) and of (x - _mean)^2 over an array, in double precision with
+// four independent accumulators of each.
+#define D_NUMERIC_DEVIATION_KERNEL(name,                                    \
+                                   type)                                    \
+    static void                                                             \
+    name                                                                    \
+    (                                                                       \
+        const type* _values,                                                \
+        size_t      _count,                                                 \
+        double      _mean,                                                  \
+        double*     _deviations,                                            \
+        double*     _squares                                                \
+    )                                                                       \
+    {                                                                       \
+        double d[4];                                                        \
+        double q[4];                                                        \
+        double x;                                                           \
+        size_t i;                                                           \
+        size_t k;                                                           \
+                                                                            \
+        for (k = 0; k < 4; k++)                                             \
+        {                                                                   \
+            d[k] = 0.0;                                                     \
+            q[k] = 0.0;                                                     \
+        }                                                                   \
+                                                                            \
+        for (i = 0; i + 4 <= _count; i += 4)                                \
+        {                                                                   \
+            for (k = 0; k < 4; k++)                                         \
+            {                                                               \
+                x     = (double)_values[i + k] - _mean;                     \
+                d[k] += x;                                                  \
+                q[k] += x * x;                                              \
+            }                                                               \
+        }                                                                   \
+                                                                            \
+        for (; i < _count; i++)                                             \
+        {                                                                   \
+            x     = (double)_values[i] - _mean;                             \
+            d[0] += x;                                                      \
+            q[0] += x * x;                                                  \
+        }                                                                   \
+                                                                            \
+        *_deviations = (d[0] + d[1]) + (d[2] + d[3]);                       \
+        *_squares    = (q[0] + q[1]) + (q[2] + q[3]);                       \
+                                                                            \
+        return;                                                             \
+    }
+
+
+D_NUMERIC_SUM_KERNEL(d_numeric_sum_i32_scalar, int32_t, int64_t)
+D_NUMERIC_SUM_KERNEL(d_numeric_sum_u64_scalar, uint64_t, uint64_t)
+D_NUMERIC_SUM_KERNEL(d_numeric_sum_i64_f64, int64_t, double)
+D_NUMERIC_SUM_KERNEL(d_numeric_sum_size_scalar, size_t, size_t)
+D_NUMERIC_SUM_KERNEL(d_numeric_sum_f32_scalar, float, double)
+D_NUMERIC_SUM_KERNEL(d_numeric_sum_f64_scalar, double, double)
+
+D_NUMERIC_EXTREMUM_KERNEL(d_numeric_min_i32_scalar, int32_t, <)
+D_NUMERIC_EXTREMUM_KERNEL(d_numeric_max_i32_scalar, int32_t, >)
+D_NUMERIC_EXTREMUM_KERNEL(d_numeric_min_i64_scalar, int64_t, <)
+D_NUMERIC_EXTREMUM_KERNEL(d_numeric_max_i64_scalar, int64_t, >)
+D_NUMERIC_EXTREMUM_KERNEL(d_numeric_min_size_scalar, size_t, <)
+D_NUMERIC_EXTREMUM_KERNEL(d_numeric_max_size_scalar, size_t, >)
+D_NUMERIC_EXTREMUM_KERNEL(d_numeric_min_f64_scalar, double, <)
+D_NUMERIC_EXTREMUM_KERNEL(d_numeric_max_f64_scalar, double, >)
+
+D_NUMERIC_MINMAX_KERNEL(d_numeric_minmax_i32_scalar, int32_t)
+D_NUMERIC_MINMAX_KERNEL(d_numeric_minmax_i64_scalar, int64_t)
+D_NUMERIC_MINMAX_KERNEL(d_numeric_minmax_size_scalar, size_t)
+D_NUMERIC_MINMAX_KERNEL(d_numeric_minmax_f64_scalar, double)
+
+D_NUMERIC_ARG_KERNEL(d_numeric_argmin_i32, int32_t, <)
+D_NUMERIC_ARG_KERNEL(d_numeric_argmax_i32, int32_t, >)
+D_NUMERIC_ARG_KERNEL(d_numeric_argmin_f64, double, <)
+D_NUMERIC_ARG_KERNEL(d_numeric_argmax_f64, double, >)
+
+D_NUMERIC_DEVIATION_KERNEL(d_numeric_deviation_i32, int32_t)
+D_NUMERIC_DEVIATION_KERNEL(d_numeric_deviation_f64, double)
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             II.   SIMD KERNELS                                          ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_numeric_sum_i32_kernel
+  Internal helper summing int32_t values into 64-bit lanes.
+*/
+static int64_t
+d_numeric_sum_i32_kernel
+(
+    const int32_t* _values,
+    size_t         _count
+)
+{
+#if defined(D_NUMERIC_AVX2)
+    __m256i acc0;
+    __m256i acc1;
+    __m256i x;
+    int64_t lanes[4];
+    size_t  i;
+
+    acc0 = _mm256_setzero_si256();
+    acc1 = _mm256_setzero_si256();
+
+    for (i = 0; i + 8 <= _count; i += 8)
+    {
+        x    = _mm256_loadu_si256((const __m256i*)(_values + i));
+        acc0 = _mm256_add_epi64(
+                   acc0,
+                   _mm256_cvtepi32_epi64(_mm256_castsi256_si128(x)));
+        acc1 = _mm256_add_epi64(
+                   acc1,
+                   _mm256_cvtepi32_epi64(_mm256_extracti128_si256(x, 1)));
+    }
+
+    _mm256_storeu_si256((__m256i*)lanes, _mm256_add_epi64(acc0, acc1));
+
+    return ( (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) +
+             d_numeric_sum_i32_scalar(_values + i, _count - i) );
+#elif defined(D_NUMERIC_SSE2)
+    __m128i acc0;
+    __m128i acc1;
+    __m128i x;
+    __m128i sign;
+    int64_t lanes[2];
+    size_t  i;
+
+    acc0 = _mm_setzero_si128();
+    acc1 = _mm_setzero_si128();
+
+    // SSE2 has no 32->64 sign extension; interleave with the sign mask
+    for (i = 0; i + 4 <= _count; i += 4)
+    {
+        x    = _mm_loadu_si128((const __m128i*)(_values + i));
+        sign = _mm_srai_epi32(x, 31);
+        acc0 = _mm_add_epi64(acc0, _mm_unpacklo_epi32(x, sign));
+        acc1 = _mm_add_epi64(acc1, _mm_unpackhi_epi32(x, sign));
+    }
+
+    _mm_storeu_si128((__m128i*)lanes, _mm_add_epi64(acc0, acc1));
+
+    return ( lanes[0] + lanes[1] +
+             d_numeric_sum_i32_scalar(_values + i, _count - i) );
+#else
+    return d_numeric_sum_i32_scalar(_values, _count);
+#endif
+}
+
+/*
+d_numeric_sum_f64_kernel
+  Internal helper summing doubles with four independent vector accumulators.
+*/
+static double
+d_numeric_sum_f64_kernel
+(
+    const double* _values,
+    size_t        _count
+)
+{
+#if defined(D_NUMERIC_AVX2)
+    __m256d acc0;
+    __m256d acc1;
+    __m256d acc2;
+    __m256d acc3;
+    double  lanes[4];
+    size_t  i;
+
+    acc0 = _mm256_setzero_pd();
+    acc1 = _mm256_setzero_pd();
+    acc2 = _mm256_setzero_pd();
+    acc3 = _mm256_setzero_pd();
+
+    for (i = 0; i + 16 <= _count; i += 16)
+    {
+        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(_values + i));
+        acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(_values + i + 4));
+        acc2 = _mm256_add_pd(acc2, _mm256_loadu_pd(_values + i + 8));
+        acc3 = _mm256_add_pd(acc3, _mm256_loadu_pd(_values + i + 12));
+    }
+
+    acc0 = _mm256_add_pd(_mm256_add_pd(acc0, acc1),
+                         _mm256_add_pd(acc2, acc3));
+    _mm256_storeu_pd(lanes, acc0);
+
+    return ( ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) +
+             d_numeric_sum_f64_scalar(_values + i, _count - i) );
+#elif defined(D_NUMERIC_SSE2)
+    __m128d acc0;
+    __m128d acc1;
+    __m128d acc2;
+    __m128d acc3;
+    double  lanes[2];
+    size_t  i;
+
+    acc0 = _mm_setzero_pd();
+    acc1 = _mm_setzero_pd();
+    acc2 = _mm_setzero_pd();
+    acc3 = _mm_setzero_pd();
+
+    for (i = 0; i + 8 <= _count; i += 8)
+    {
+        acc0 = _mm_add_pd(acc0, _mm_loadu_pd(_values + i));
+        acc1 = _mm_add_pd(acc1, _mm_loadu_pd(_values + i + 2));
+        acc2 = _mm_add_pd(acc2, _mm_loadu_pd(_values + i + 4));
+        acc3 = _mm_add_pd(acc3, _mm_loadu_pd(_values + i + 6));
+    }
+
+    acc0 = _mm_add_pd(_mm_add_pd(acc0, acc1),
+                      _mm_add_pd(acc2, acc3));
+    _mm_storeu_pd(lanes, acc0);
+
+    return ( (lanes[0] + lanes[1]) +
+             d_numeric_sum_f64_scalar(_values + i, _count - i) );
+#else
+    return d_numeric_sum_f64_scalar(_values, _count);
+#endif
+}
+
+/*
+d_numeric_extremum_i32_kernel
+  Internal helper returning the minimum (_maximum false) or maximum of a
+non-empty int32_t array.
+*/
+static int32_t
+d_numeric_extremum_i32_kernel
+(
+    const int32_t* _values,
+    size_t         _count,
+    bool           _maximum
+)
+{
+#if defined(D_NUMERIC_AVX2)
+    __m256i best;
+    __m256i x;
+    int32_t lanes[8];
+    int32_t result;
+    size_t  i;
+    size_t  k;
+
+    if (_count < 8)
+    {
+        return (_maximum) ? d_numeric_max_i32_scalar(_values, _count)
+                          : d_numeric_min_i32_scalar(_values, _count);
+    }
+
+    best = _mm256_loadu_si256((const __m256i*)_values);
+
+    for (i = 8; i + 8 <= _count; i += 8)
+    {
+        x    = _mm256_loadu_si256((const __m256i*)(_values + i));
+        best = (_maximum) ? _mm256_max_epi32(best, x)
+                          : _mm256_min_epi32(best, x);
+    }
+
+    _mm256_storeu_si256((__m256i*)lanes, best);
+    result = lanes[0];
+
+    for (k = 1; k < 8; k++)
+    {
+        if ( (_maximum) ? (lanes[k] > result) : (lanes[k] < result) )
+        {
+            result = lanes[k];
+        }
+    }
+
+    for (; i < _count; i++)
+    {
+        if ( (_maximum) ? (_values[i] > result) : (_values[i] < result) )
+        {
+            result = _values[i];
+        }
+    }
+
+    return result;
+#else
+    // SSE2 lacks 32-bit integer min/max; the portable kernel vectorizes
+    return (_maximum) ? d_numeric_max_i32_scalar(_values, _count)
+                      : d_numeric_min_i32_scalar(_values, _count);
+#endif
+}
+
+/*
+d_numeric_minmax_f64_kernel
+  Internal helper computing the minimum and/or maximum of a non-empty double
+array in one pass. Either output may be NULL.
+*/
+static void
+d_numeric_minmax_f64_kernel
+(
+    const double* _values,
+    size_t        _count,
+    double*       _min,
+    double*       _max
+)
+{
+#if defined(D_NUMERIC_SSE2)
+    __m128d lo0;
+    __m128d lo1;
+    __m128d hi0;
+    __m128d hi1;
+    __m128d x;
+    __m128d y;
+    double  lo[2];
+    double  hi[2];
+    double  min;
+    double  max;
+    size_t  i;
+
+    if (_count >= 4)
+    {
+        lo0 = hi0 = _mm_loadu_pd(_values);
+        lo1 = hi1 = _mm_loadu_pd(_values + 2);
+
+        for (i = 4; i + 4 <= _count; i += 4)
+        {
+            x   = _mm_loadu_pd(_values + i);
+            y   = _mm_loadu_pd(_values + i + 2);
+            lo0 = _mm_min_pd(lo0, x);
+            hi0 = _mm_max_pd(hi0, x);
+            lo1 = _mm_min_pd(lo1, y);
+            hi1 = _mm_max_pd(hi1, y);
+        }
+
+        _mm_storeu_pd(lo, _mm_min_pd(lo0, lo1));
+        _mm_storeu_pd(hi, _mm_max_pd(hi0, hi1));
+
+        min = (lo[1] < lo[0]) ? lo[1] : lo[0];
+        max = (hi[1] > hi[0]) ? hi[1] : hi[0];
+
+        for (; i < _count; i++)
+        {
+            min = (_values[i] < min) ? _values[i] : min;
+            max = (_values[i] > max) ? _values[i] : max;
+        }
+
+        if (_min)
+        {
+            *_min = min;
+        }
+
+        if (_max)
+        {
+            *_max = max;
+        }
+
+        return;
+    }
+#endif
+
+    if (!_max)
+    {
+        *_min = d_numeric_min_f64_scalar(_values, _count);
+    }
+    else if (!_min)
+    {
+        *_max = d_numeric_max_f64_scalar(_values, _count);
+    }
+    else
+    {
+        d_numeric_minmax_f64_scalar(_values, _count, _min, _max);
+    }
+
+    return;
+}
+
+/*
+d_numeric_sum_f64_pairwise
+  Internal recursive helper for d_functional_sum_f64_pairwise. Splits on a
+multiple of D_NUMERIC_PAIRWISE_BLOCK so that every leaf block is full except
+possibly the last.
+*/
+static double
+d_numeric_sum_f64_pairwise
+(
+    const double* _values,
+    size_t        _count
+)
+{
+    size_t half;
+
+    if (_count <= D_NUMERIC_PAIRWISE_BLOCK)
+    {
+        return d_numeric_sum_f64_kernel(_values, _count);
+    }
+
+    half = ((_count / D_NUMERIC_PAIRWISE_BLOCK) / 2) *
+           D_NUMERIC_PAIRWISE_BLOCK;
+
+    if (half == 0)
+    {
+        half = D_NUMERIC_PAIRWISE_BLOCK;
+    }
+
+    return ( d_numeric_sum_f64_pairwise(_values, half) +
+             d_numeric_sum_f64_pairwise(_values + half, _count - half) );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             III.  SUMS                                                  ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_functional_sum_i32
+  Sums an int32_t array into a 64-bit result.
+
+Parameter(s):
+  _values: pointer to the array.
+  _count:  number of elements.
+Return:
+  The sum of the elements, or 0 if _values was NULL or _count was 0.
+*/
+int64_t
+d_functional_sum_i32
+(
+    const int32_t* _values,
+    size_t         _count
+)
+{
+    // validate parameters
+    if ( (!_values) ||
+         (_count == 0) )
+    {
+        return 0;
+    }
+
+    return d_numeric_sum_i32_kernel(_values, _count);
+}
+
+
+/*
+d_functional_sum_i64
+  Sums an int64_t array. Overflow wraps as in two's complement.
+
+Parameter(s):
+  _values: pointer to the array.
+  _count:  number of elements.
+Return:
+  The sum of the elements, or 0 if _values was NULL or _count was 0.
+*/
+int64_t
+d_functional_sum_i64
+(
+    const int64_t* _values,
+    size_t         _count
+)
+{
+    // validate parameters
+    if ( (!_values) ||
+         (_count == 0) )
+    {
+        return 0;
+    }
+
+    // accumulate through the unsigned type so that overflow is defined
+    return (int64_t)d_numeric_sum_u64_scalar((const uint64_t*)_values,
+                                             _count);
+}
+
+/*
+d_functional_sum_size
+  Sums a size_t array. Overflow wraps modulo SIZE_MAX + 1.
+
+Parameter(s):
+  _values: pointer to the array.
+  _count:  number of elements.
+Return:
+  The sum of the elements, or 0 if _values was NULL or _count was 0.
+*/
+size_t
+d_functional_sum_size
+(
+    const size_t* _values,
+    size_t        _count
+)
+{
+    // validate parameters
+    if ( (!_values) ||
+         (_count == 0) )
+    {
+        return 0;
+    }
+
+    return d_numeric_sum_size_scalar(_values, _count);
+}
+
+/*
+d_functional_sum_f32
+  Sums a float array, accumulating in double precision.
+
+Parameter(s):
+  _values: pointer to the array.
+  _count:  number of elements.
+Return:
+  The sum of the elements, or 0.0 if _values was NULL or _count was 0.
+*/
+double
+d_functional_sum_f32
+(
+    const float* _values,
+    size_t       _count
+)
+{
+    // validate parameters
+    if ( (!_values) ||
+         (_count == 0) )
+    {
+        return 0.0;
+    }
+
+    return d_numeric_sum_f32_scalar(_values, _count);
+}
+
+/*
+d_functional_sum_f64
+  Sums a double array with several independent accumulators. This is the
+fastest sum; the association order differs from a left-to-right loop, so
+results may differ from it in the last bits.
+
+Parameter(s):
+  _values: pointer to the array.
+  _count:  number of elements.
+Return:
+  The sum of the elements, or 0.0 if _values was NULL or _count was 0.
+*/
+double
+d_functional_sum_f64
+(
+    const double* _values,
+    size_t        _count
+)
+{
+    // validate parameters
+    if ( (!_values) ||
+         (_count == 0) )
+    {
+        return 0.0;
+    }
+
+    return d_numeric_sum_f64_kernel(_values, _count);
+}
+
+/*
+d_functional_sum_f64_pairwise
+  Sums a double array by recursively halving it down to blocks of
+D_NUMERIC_PAIRWISE_BLOCK elements, which are summed with the fast kernel.
+The rounding error grows with O(log n) instead of O(n).
+
+Parameter(s):
+  _values: pointer to the array.
+  _count:  number of elements.
+Return:
+  The sum of the elements, or 0.0 if _values was NULL or _count was 0.
+*/
+double
+d_functional_sum_f64_pairwise
+(
+    const double* _values,
+    size_t        _count
+)
+{
+    // validate parameters
+    if ( (!_values) ||
+         (_count == 0) )
+    {
+        return 0.0;
+    }
+
+    return d_numeric_sum_f64_pairwise(_values, _count);
+}
+
+/*
+d_functional_sum_f64_compensated
+  Sums a double array with Kahan-Babuska (Neumaier) compensation, carrying
+the rounding error of every addition in a separate term. The error is
+independent of n for all practical purposes, at roughly a quarter of the
+speed of d_functional_sum_f64. Two independent compensated accumulators are
+used to shorten the dependency chain.
+
+Parameter(s):
+  _values: pointer to the array.
+  _count:  number of elements.
+Return:
+  The sum of the elements, or 0.0 if _values was NULL or _count was 0.
+*/
+double
+d_functional_sum_f64_compensated
+(
+    const double* _values,
+    size_t        _count
+)
+{
+    double sum[2];
+    double compensation[2];
+    double total;
+    double x;
+    double t;
+    size_t i;
+    size_t k;
+
+    // validate parameters
+    if ( (!_values) ||
+         (_count == 0) )
+    {
+        return 0.0;
+    }
+
+    sum[0]          = 0.0;
+    sum[1]          = 0.0;
+    compensation[0] = 0.0;
+    compensation[1] = 0.0;
+
+    for (i = 0; i < _count; i++)
+    {
+        k = i & 1;
+        x = _values[i];
+        t = sum[k] + x;
+
+        // recover the low-order bits lost by the larger operand
+        if (fabs(sum[k]) >= fabs(x))
+        {
+            compensation[k] += (sum[k] - t) + x;
+        }
+        else
+        {
+            compensation[k] += (x - t) + sum[k];
+        }
+
+        sum[k] = t;
+    }
+
+    // merge the two lanes with one more compensated addition
+    total = sum[0] + sum[1];
+
+    if (fabs(sum[0]) >= fabs(sum[1]))
+    {
+        x = (sum[0] - total) + sum[1];
+    }
+    else
+    {
+        x = (sum[1] - total) + sum[0];
+    }
+
+    return total + ((compensation[0] + compensation[1]) + x);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             IV.   EXTREMA                                               ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_functional_min_i32
+  Finds the smallest element of an int32_t array.
+
+Parameter(s):
+  _values: pointer to the array.
+  _count:  number of elements.
+  _min:    destination for the minimum.
+Return:
+  A boolean value corresponding to either:
+  - true, if the minimum was written to _min, or
+  - false, if any pointer was NULL or _count was 0.
+*/
+bool
+d_functional_min_i32
+(
+    const int32_t* _values,
+    size_t         _count,
+    int32_t*       _min
+)
+{
+    // validate parameters
+    if ( (!_values)     ||
+         (!_min)        ||
+         (_count == 0) )
+    {
+        return false;
+    }
+
+    *_min = d_numeric_extremum_i32_kernel(_values, _count, false);
+
+    return true;
+}
+
+/*
+d_functional_max_i32
+  Finds the largest element of an int32_t array.
+
+Parameter(s):
+  _values: pointer to the array.
+  _count:  number of elements.
+  _max:    destination for the maximum.
+Return:
+  A boolean value corresponding to either:
+  - true, if the maximum was written to _max, or
+  - false, if any pointer was NULL or _count was 0.
+*/
+bool
+d_functional_max_i32
+(
+    const int32_t* _values,
+    size_t         _count,
+    int32_t*       _max
+)
+{
+    // validate parameters
+    if ( (!_values)     ||
+         (!_max)        ||
+         (_count == 0) )
+    {
+        return false;
+    }
+
+    *_max = d_numeric_extremum_i32_kernel(_values, _count, true);
+
+    return true;
+}
+
+/*
+d_functional_minmax_i32
+  Finds the smallest and largest elements of an int32_t array in one pass.
+
+Parameter(s):
+  _values: pointer to the array.
+  _count:  number of elements.
+  _min:    destination for the minimum.
+  _max:    destination for the maximum.
+Return:
+  A boolean value corresponding to either:
+  - true, if both results were written, or
+  - false, if any pointer was NULL or _count was 0.
+*/
+bool
+d_functional_minmax_i32
+(
+    const int32_t* _values,
+    size_t         _count,
+    int32_t*       _min,
+    int32_t*       _max
+)
+{
+    // validate parameters
+    if ( (!_values)     ||
+         (!_min)        ||
+         (!_max)        ||
+         (_count == 0) )
+    {
+        return false;
+    }
+
+    d_numeric_minmax_i32_scalar(_values, _count, _min, _max);
+
+    return true;
+}
+
+/*
+d_functional_min_i64
+  Finds the smallest element of an int64_t array.
+
+Parameter(s):
+  _values: pointer to the array.
+  _count:  number of elements.
+  _min:    destination for the minimum.
+Return:
+  A boolean value corresponding to either:
+  - true, if the minimum was written to _min, or
+  - false, if any pointer was NULL or _count was 0.
+*/
+bool
+d_functional_min_i64
+(
+    const int64_t* _values,
+    size_t         _count,
+    int64_t*       _min
+)
+{
+    // validate parameters
+    if ( (!_values)     ||
+         (!_min)        ||
+         (_count == 0) )
+    {
+        return false;
+    }
+
+    *_min = d_numeric_min_i64_scalar(_values, _count);
+
+    return true;
+}
+
+/*
+d_functional_max_i64
+  Finds the largest element of an int64_t array.
+
+Parameter(s):
+  _values: pointer to the array.
+  _count:  number of elements.
+  _max:    destination for the maximum.
+Return:
+  A boolean value corresponding to either:
+  - true, if the maximum was written to _max, or
+  - false, if any pointer was NULL or _count was 0.
+*/
+bool
+d_functional_max_i64
+(
+    const int64_t* _values,
+    size_t         _count,
+    int64_t*       _max
+)
+{
+    // validate parameters
+    if ( (!_values)     ||
+         (!_max)        ||
+         (_count == 0) )
+    {
+        return false;
+    }
+
+    *_max = d_numeric_max_i64_scalar(_values, _count);
+
+    return true;
+}
+
+/*
+d_functional_minmax_i64
+  Finds the smallest and largest elements of an int64_t array in one pass.
+
+Parameter(s):
+  _values: pointer to the array.
+  _count:  number of elements.
+  _min:    destination for the minimum.
+  _max:    destination for the maximum.
+Return:
+  A boolean value corresponding to either:
+  - true, if both results were written, or
+  - false, if any pointer was NULL or _count was 0.
+*/
+bool
+d_functional_minmax_i64
+(
+    const int64_t* _values,
+    size_t         _count,
+    int64_t*       _min,
+    int64_t*       _max
+)
+{
+    // validate parameters
+    if ( (!_values)     ||
+         (!_min)        ||
+         (!_max)        ||
+         (_count == 0) )
+    {
+        return false;
+    }
+
+    d_numeric_minmax_i64_scalar(_values, _count, _min, _max);
+
+    return true;
+}
+
+/*
+d_functional_min_size
+  Finds the smallest element of a size_t array.
+
+Parameter(s):
+  _values: pointer to the array.
+  _count:  number of elements.
+  _min:    destination for the minimum.
+Return:
+  A boolean value corresponding to either:
+  - true, if the minimum was written to _min, or
+  - false, if any pointer was NULL or _count was 0.
+*/
+bool
+d_functional_min_size
+(
+    const size_t* _values,
+    size_t        _count,
+    size_t*       _min
+)
+{
+    // validate parameters
+    if ( (!_values)     ||
+         (!_min)        ||
+         (_count == 0) )
+    {
+        return false;
+    }
+
+    *_min = d_numeric_min_size_scalar(_values, _count);
+
+    return true;
+}
+
+/*
+d_functional_max_size
+  Finds the largest element of a size_t array.
+
+Parameter(s):
+  _values: pointer to the array.
+  _count:  number of elements.
+  _max:    destination for the maximum.
+Return:
+  A boolean value corresponding to either:
+  - true, if the maximum was written to _max, or
+  - false, if any pointer was NULL or _count was 0.
+*/
+bool
+d_functional_max_size
+(
+    const size_t* _values,
+    size_t        _count,
+    size_t*       _max
+)
+{
+    // validate parameters
+    if ( (!_values)     ||
+         (!_max)        ||
+         (_count == 0) )
+    {
+        return false;
+    }
+
+    *_max = d_numeric_max_size_scalar(_values, _count);
+
+    return true;
+}
+
+/*
+d_functional_minmax_size
+  Finds the smallest and largest elements of a size_t array in one pass.
+
+Parameter(s):
+  _values: pointer to the array.
+  _count:  number of elements.
+  _min:    destination for the minimum.
+  _max:    destination for the maximum.
+Return:
+  A boolean value corresponding to either:
+  - true, if both results were written, or
+  - false, if any pointer was NULL or _count was 0.
+*/
+bool
+d_functional_minmax_size
+(
+    const size_t* _values,
+    size_t        _count,
+    size_t*       _min,
+    size_t*       _max
+)
+{
+    // validate parameters
+    if ( (!_values)     ||
+         (!_min)        ||
+         (!_max)        ||
+         (_count == 0) )
+    {
+        return false;
+    }
+
+    d_numeric_minmax_size_scalar(_values, _count, _min, _max);
+
+    return true;
+}
+
+/*
+d_functional_min_f64
+  Finds the smallest element of a double array.
+
+Parameter(s):
+  _values: pointer to the array.
+  _count:  number of elements.
+  _min:    destination for the minimum.
+Return:
+  A boolean value corresponding to either:
+  - true, if the minimum was written to _min, or
+  - false, if any pointer was NULL or _count was 0.
+*/
+bool
+d_functional_min_f64
+(
+    const double* _values,
+    size_t        _count,
+    double*       _min
+)
+{
+    // validate parameters
+    if ( (!_values)     ||
+         (!_min)        ||
+         (_count == 0) )
+    {
+        return false;
+    }
+
+    d_numeric_minmax_f64_kernel(_values, _count, _min, NULL);
+
+    return true;
+}
+
+/*
+d_functional_max_f64
+  Finds the largest element of a double array.
+
+Parameter(s):
+  _values: pointer to the array.
+  _count:  number of elements.
+  _max:    destination for the maximum.
+Return:
+  A boolean value corresponding to either:
+  - true, if the maximum was written to _max, or
+  - false, if any pointer was NULL or _count was 0.
+*/
+bool
+d_functional_max_f64
+(
+    const double* _values,
+    size_t        _count,
+    double*       _max
+)
+{
+    // validate parameters
+    if ( (!_values)     ||
+         (!_max)        ||
+         (_count == 0) )
+    {
+        return false;
+    }
+
+    d_numeric_minmax_f64_kernel(_values, _count, NULL, _max);
+
+    return true;
+}
+
+/*
+d_functional_minmax_f64
+  Finds the smallest and largest elements of a double array in one pass.
+
+Parameter(s):
+  _values: pointer to the array.
+  _count:  number of elements.
+  _min:    destination for the minimum.
+  _max:    destination for the maximum.
+Return:
+  A boolean value corresponding to either:
+  - true, if both results were written, or
+  - false, if any pointer was NULL or _count was 0.
+*/
+bool
+d_functional_minmax_f64
+(
+    const double* _values,
+    size_t        _count,
+    double*       _min,
+    double*       _max
+)
+{
+    // validate parameters
+    if ( (!_values)     ||
+         (!_min)        ||
+         (!_max)        ||
+         (_count == 0) )
+    {
+        return false;
+    }
+
+    d_numeric_minmax_f64_kernel(_values, _count, _min, _max);
+
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             V.    EXTREMUM POSITIONS                                    ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_functional_argmin_i32
+  Finds the index of the first smallest element of an int32_t array.
+
+Parameter(s):
+  _values: pointer to the array.
+  _count:  number of elements.
+  _index:  destination for the index.
+Return:
+  A boolean value corresponding to either:
+  - true, if the index was written to _index, or
+  - false, if any pointer was NULL or _count was 0.
+*/
+bool
+d_functional_argmin_i32
+(
+    const int32_t* _values,
+    size_t         _count,
+    size_t*        _index
+)
+{
+    // validate parameters
+    if ( (!_values)     ||
+         (!_index)      ||
+         (_count == 0) )
+    {
+        return false;
+    }
+
+    *_index = d_numeric_argmin_i32(_values, _count);
+
+    return true;
+}
+
+/*
+d_functional_argmax_i32
+  Finds the index of the first largest element of an int32_t array.
+
+Parameter(s):
+  _values: pointer to the array.
+  _count:  number of elements.
+  _index:  destination for the index.
+Return:
+  A boolean value corresponding to either:
+  - true, if the index was written to _index, or
+  - false, if any pointer was NULL or _count was 0.
+*/
+bool
+d_functional_argmax_i32
+(
+    const int32_t* _values,
+    size_t         _count,
+    size_t*        _index
+)
+{
+    // validate parameters
+    if ( (!_values)     ||
+         (!_index)      ||
+         (_count == 0) )
+    {
+        return false;
+    }
+
+    *_index = d_numeric_argmax_i32(_values, _count);
+
+    return true;
+}
+
+/*
+d_functional_argmin_f64
+  Finds the index of the first smallest element of a double array.
+
+Parameter(s):
+  _values: pointer to the array.
+  _count:  number of elements.
+  _index:  destination for the index.
+Return:
+  A boolean value corresponding to either:
+  - true, if the index was written to _index, or
+  - false, if any pointer was NULL or _count was 0.
+*/
+bool
+d_functional_argmin_f64
+(
+    const double* _values,
+    size_t        _count,
+    size_t*       _index
+)
+{
+    // validate parameters
+    if ( (!_values)     ||
+         (!_index)      ||
+         (_count == 0) )
+    {
+        return false;
+    }
+
+    *_index = d_numeric_argmin_f64(_values, _count);
+
+    return true;
+}
+
+/*
+d_functional_argmax_f64
+  Finds the index of the first largest element of a double array.
+
+Parameter(s):
+  _values: pointer to the array.
+  _count:  number of elements.
+  _index:  destination for the index.
+Return:
+  A boolean value corresponding to either:
+  - true, if the index was written to _index, or
+  - false, if any pointer was NULL or _count was 0.
+*/
+bool
+d_functional_argmax_f64
+(
+    const double* _values,
+    size_t        _count,
+    size_t*       _index
+)
+{
+    // validate parameters
+    if ( (!_values)     ||
+         (!_index)      ||
+         (_count == 0) )
+    {
+        return false;
+    }
+
+    *_index = d_numeric_argmax_f64(_values, _count);
+
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             VI.   MOMENTS                                               ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_functional_mean_i32
+  Computes the arithmetic mean of an int32_t array. The sum is exact (64-bit)
+before the single division.
+
+Parameter(s):
+  _values: pointer to the array.
+  _count:  number of elements.
+  _mean:   destination for the mean.
+Return:
+  A boolean value corresponding to either:
+  - true, if the mean was written to _mean, or
+  - false, if any pointer was NULL or _count was 0.
+*/
+bool
+d_functional_mean_i32
+(
+    const int32_t* _values,
+    size_t         _count,
+    double*        _mean
+)
+{
+    // validate parameters
+    if ( (!_values)     ||
+         (!_mean)       ||
+         (_count == 0) )
+    {
+        return false;
+    }
+
+    *_mean = (double)d_numeric_sum_i32_kernel(_values, _count) /
+             (double)_count;
+
+    return true;
+}
+
+/*
+d_functional_mean_i64
+  Computes the arithmetic mean of an int64_t array. Values are summed in
+double precision so that large inputs cannot overflow.
+
+Parameter(s):
+  _values: pointer to the array.
+  _count:  number of elements.
+  _mean:   destination for the mean.
+Return:
+  A boolean value corresponding to either:
+  - true, if the mean was written to _mean, or
+  - false, if any pointer was NULL or _count was 0.
+*/
+bool
+d_functional_mean_i64
+(
+    const int64_t* _values,
+    size_t         _count,
+    double*        _mean
+)
+{
+    // validate parameters
+    if ( (!_values)     ||
+         (!_mean)       ||
+         (_count == 0) )
+    {
+        return false;
+    }
+
+    *_mean = d_numeric_sum_i64_f64(_values, _count) / (double)_count;
+
+    return true;
+}
+
+/*
+d_functional_mean_f64
+  Computes the arithmetic mean of a double array using the pairwise sum.
+
+Parameter(s):
+  _values: pointer to the array.
+  _count:  number of elements.
+  _mean:   destination for the mean.
+Return:
+  A boolean value corresponding to either:
+  - true, if the mean was written to _mean, or
+  - false, if any pointer was NULL or _count was 0.
+*/
+bool
+d_functional_mean_f64
+(
+    const double* _values,
+    size_t        _count,
+    double*       _mean
+)
+{
+    // validate parameters
+    if ( (!_values)     ||
+         (!_mean)       ||
+         (_count == 0) )
+    {
+        return false;
+    }
+
+    *_mean = d_numeric_sum_f64_pairwise(_values, _count) / (double)_count;
+
+    return true;
+}
+
+/*
+d_numeric_variance_finish
+  Internal helper turning the deviation sums of the corrected two-pass
+algorithm into a variance. The sum of deviations is zero in exact
+arithmetic; subtracting its square removes most of the rounding error of
+the mean.
+*/
+static double
+d_numeric_variance_finish
+(
+    double _deviations,
+    double _squares,
+    size_t _count,
+    bool   _sample
+)
+{
+    double variance;
+
+    variance = ( _squares - ((_deviations * _deviations) / (double)_count) ) /
+               (double)(_count - ((_sample) ? 1 : 0));
+
+    return (variance > 0.0) ? variance : 0.0;
+}
+
+/*
+d_functional_variance_i32
+  Computes the variance of an int32_t array with the corrected two-pass
+algorithm (mean first, then squared deviations).
+
+Parameter(s):
+  _values:   pointer to the array.
+  _count:    number of elements.
+  _sample:   true for the sample variance (divides by n - 1), false for the
+             population variance (divides by n).
+  _variance: destination for the variance.
+Return:
+  A boolean value corresponding to either:
+  - true, if the variance was written to _variance, or
+  - false, if any pointer was NULL, _count was 0, or _sample was true and
+    _count was 1.
+*/
+bool
+d_functional_variance_i32
+(
+    const int32_t* _values,
+    size_t         _count,
+    bool           _sample,
+    double*        _variance
+)
+{
+    double mean;
+    double deviations;
+    double squares;
+
+    // validate parameters
+    if ( (!_values)                      ||
+         (!_variance)                    ||
+         (_count == 0)                   ||
+         ( (_sample) && (_count < 2) ) )
+    {
+        return false;
+    }
+
+    mean = (double)d_numeric_sum_i32_kernel(_values, _count) /
+           (double)_count;
+
+    d_numeric_deviation_i32(_values, _count, mean, &deviations, &squares);
+
+    *_variance = d_numeric_variance_finish(deviations,
+                                           squares,
+                                           _count,
+                                           _sample);
+
+    return true;
+}
+
+/*
+d_functional_variance_f64
+  Computes the variance of a double array with the corrected two-pass
+algorithm (pairwise mean first, then squared deviations).
+
+Parameter(s):
+  _values:   pointer to the array.
+  _count:    number of elements.
+  _sample:   true for the sample variance (divides by n - 1), false for the
+             population variance (divides by n).
+  _variance: destination for the variance.
+Return:
+  A boolean value corresponding to either:
+  - true, if the variance was written to _variance, or
+  - false, if any pointer was NULL, _count was 0, or _sample was true and
+    _count was 1.
+*/
+bool
+d_functional_variance_f64
+(
+    const double* _values,
+    size_t        _count,
+    bool          _sample,
+    double*       _variance
+)
+{
+    double mean;
+    double deviations;
+    double squares;
+
+    // validate parameters
+    if ( (!_values)                      ||
+         (!_variance)                    ||
+         (_count == 0)                   ||
+         ( (_sample) && (_count < 2) ) )
+    {
+        return false;
+    }
+
+    mean = d_numeric_sum_f64_pairwise(_values, _count) / (double)_count;
+
+    d_numeric_deviation_f64(_values, _count, mean, &deviations, &squares);
+
+    *_variance = d_numeric_variance_finish(deviations,
+                                           squares,
+                                           _count,
+                                           _sample);
+
+    return true;
+}
@@ -1,6 +1,202 @@
 #include "..\..\inc\functional\pipeline.h"
 
 
+// d_functional_pipeline_scratch
+//   union: stack buffer for one element of an in-place map, aligned for
+// any element type.
+union d_functional_pipeline_scratch
+{
+    unsigned char bytes[D_FUNCTIONAL_PIPELINE_SCRATCH_SIZE];
+    long double   align_float;
+    uint64_t      align_integer;
+    void*         align_pointer;
+};
+
+
+/*
+d_functional_pipeline_init
+  Internal helper: sets every field of a pipeline.
+*/
+static void
+d_functional_pipeline_init
+(
+    struct d_functional_pipeline* _pipe,
+    void*                         _data,
+    size_t                        _count,
+    size_t                        _element_size,
+    bool                          _owns_data,
+    int                           _error_code
+)
+{
+    _pipe->data           = _data;
+    _pipe->element_size   = _element_size;
+    _pipe->count          = _count;
+    _pipe->owns_data      = _owns_data;
+    _pipe->error_code     = _error_code;
+    _pipe->buffer         = (_owns_data) ? _data : NULL;
+    _pipe->capacity       = (_owns_data) ? (_count * _element_size) : 0;
+    _pipe->spare          = NULL;
+    _pipe->spare_capacity = 0;
+    _pipe->lent           = NULL;
+
+    return;
+}
+
+/*
+d_functional_pipeline_drop
+  Internal helper: frees a buffer of a pipeline that owns its data, unless
+it is the caller's lent buffer.
+*/
+static void
+d_functional_pipeline_drop
+(
+    struct d_functional_pipeline* _pipe,
+    void*                         _block
+)
+{
+    if (_block != _pipe->lent)
+    {
+        d_functional_free(_block);
+    }
+
+    return;
+}
+
+/*
+d_functional_pipeline_release
+  Internal helper: frees the buffers of a pipeline that owns its data.
+*/
+static void
+d_functional_pipeline_release
+(
+    struct d_functional_pipeline* _pipe
+)
+{
+    if (_pipe->owns_data)
+    {
+        d_functional_pipeline_drop(_pipe, _pipe->buffer);
+        d_functional_pipeline_drop(_pipe, _pipe->spare);
+    }
+
+    _pipe->buffer         = NULL;
+    _pipe->capacity       = 0;
+    _pipe->spare          = NULL;
+    _pipe->spare_capacity = 0;
+    _pipe->lent           = NULL;
+
+    return;
+}
+
+/*
+d_functional_pipeline_acquire
+  Internal helper: returns a buffer of at least _size bytes, distinct from
+the data, for a stage to write its output into. A pipeline that owns its
+data recycles its spare buffer, growing it if needed; otherwise a new
+buffer is allocated. *_allocated receives the bytes newly allocated.
+*/
+static void*
+d_functional_pipeline_acquire
+(
+    struct d_functional_pipeline* _pipe,
+    size_t                        _size,
+    size_t*                       _allocated
+)
+{
+    void* block;
+
+    *_allocated = 0;
+
+    if ( (_pipe->owns_data) &&
+         (_pipe->spare)     &&
+         (_pipe->spare_capacity >= _size) )
+    {
+        return _pipe->spare;
+    }
+
+    block = d_functional_malloc((_size > 0) ? _size : 1);
+
+    // ensure that memory allocation was successful
+    if (!block)
+    {
+        return NULL;
+    }
+
+    *_allocated = _size;
+
+    if (_pipe->owns_data)
+    {
+        d_functional_pipeline_drop(_pipe, _pipe->spare);
+
+        _pipe->spare          = block;
+        _pipe->spare_capacity = _size;
+    }
+
+    return block;
+}
+
+/*
+d_functional_pipeline_commit
+  Internal helper: makes the buffer returned by
+d_functional_pipeline_acquire the pipeline's data. An owned pipeline keeps
+its previous buffer as the spare; a borrowing one takes ownership of the
+new buffer.
+*/
+static void
+d_functional_pipeline_commit
+(
+    struct d_functional_pipeline* _pipe,
+    void*                         _output,
+    size_t                        _size
+)
+{
+    void*  previous;
+    size_t previous_capacity;
+
+    if (_pipe->owns_data)
+    {
+        previous          = _pipe->buffer;
+        previous_capacity = _pipe->capacity;
+
+        _pipe->buffer         = _pipe->spare;
+        _pipe->capacity       = _pipe->spare_capacity;
+        _pipe->spare          = previous;
+        _pipe->spare_capacity = previous_capacity;
+    }
+    else
+    {
+        _pipe->buffer         = _output;
+        _pipe->capacity       = _size;
+        _pipe->spare          = NULL;
+        _pipe->spare_capacity = 0;
+        _pipe->owns_data      = true;
+    }
+
+    _pipe->data = _output;
+
+    return;
+}
+
+/*
+d_functional_pipeline_discard
+  Internal helper: gives back a buffer from d_functional_pipeline_acquire
+after its stage failed. An owned pipeline keeps it as the spare.
+*/
+static void
+d_functional_pipeline_discard
+(
+    struct d_functional_pipeline* _pipe,
+    void*                         _output
+)
+{
+    if (!_pipe->owns_data)
+    {
+        d_functional_free(_output);
+    }
+
+    return;
+}
+
+
 /*
 d_functional_pipeline_begin
   Creates a pipeline wrapping existing mutable data. The pipeline does NOT
@@ -30,20 +226,12 @@ d_functional_pipeline_begin
          (_count == 0)        ||
          (_element_size == 0) )
     {
-        pipe.data         = NULL;
-        pipe.element_size = 0;
-        pipe.count        = 0;
-        pipe.owns_data    = false;
-        pipe.error_code   = -1;
+        d_functional_pipeline_init(&pipe, NULL, 0, 0, false, -1);
 
         return pipe;
     }
 
-    pipe.data         = _data;
-    pipe.element_size = _element_size;
-    pipe.count        = _count;
-    pipe.owns_data    = false;
-    pipe.error_code   = 0;
+    d_functional_pipeline_init(&pipe, _data, _count, _element_size, false, 0);
 
     return pipe;
 }
@@ -73,52 +261,195 @@ d_functional_pipeline_begin_copy
 {
     struct d_functional_pipeline pipe;
     void*                        copy;
+#if defined(D_FUNCTIONAL_PROFILE)
+    uint64_t                     profile_start;
+#endif
 
     // validate parameters
     if ( (!_data)             ||
          (_count == 0)        ||
          (_element_size == 0) )
     {
-        pipe.data         = NULL;
-        pipe.element_size = 0;
-        pipe.count        = 0;
-        pipe.owns_data    = false;
-        pipe.error_code   = -1;
+        d_functional_pipeline_init(&pipe, NULL, 0, 0, false, -1);
 
         return pipe;
     }
 
-    copy = malloc(_count * _element_size);
+    D_PROFILE_START(profile_start);
+
+    copy = d_functional_malloc(_count * _element_size);
 
     // check allocation
     if (!copy)
     {
-        pipe.data         = NULL;
-        pipe.element_size = _element_size;
-        pipe.count        = 0;
-        pipe.owns_data    = false;
-        pipe.error_code   = -1;
+        d_functional_pipeline_init(&pipe, NULL, 0, _element_size, false, -1);
 
         return pipe;
     }
 
     memcpy(copy, _data, _count * _element_size);
 
-    pipe.data         = copy;
-    pipe.element_size = _element_size;
-    pipe.count        = _count;
-    pipe.owns_data    = true;
-    pipe.error_code   = 0;
+    D_PROFILE_STOP(profile_start, "pipeline", "begin_copy",
+                   D_PROFILE_NO_INDEX, _count, _count,
+                   _count * _element_size, 0);
+
+    d_functional_pipeline_init(&pipe, copy, _count, _element_size, true, 0);
+
+    return pipe;
+}
+
+
+/*
+d_functional_pipeline_begin_in_place
+  Creates a pipeline that may overwrite existing mutable data, so that its
+stages work in place as over owned data, without copying it first. The
+pipeline never frees the data; the caller remains responsible for it, and
+must not touch it until the pipeline is ended or freed.
+
+Parameter(s):
+  _data:         pointer to the mutable data array.
+  _count:        number of elements in the array.
+  _element_size: size of each element in bytes.
+Return:
+  A d_functional_pipeline struct writing into the data. If any parameter
+is invalid (NULL data, zero count, or zero element_size), returns a
+pipeline with error_code set to -1.
+*/
+struct d_functional_pipeline
+d_functional_pipeline_begin_in_place
+(
+    void*  _data,
+    size_t _count,
+    size_t _element_size
+)
+{
+    struct d_functional_pipeline pipe;
+
+    // validate parameters
+    if ( (!_data)             ||
+         (_count == 0)        ||
+         (_element_size == 0) )
+    {
+        d_functional_pipeline_init(&pipe, NULL, 0, 0, false, -1);
+
+        return pipe;
+    }
+
+    d_functional_pipeline_init(&pipe, _data, _count, _element_size, true, 0);
+    pipe.lent = _data;
 
     return pipe;
 }
 
 
+/*
+d_functional_pipeline_map_stage
+  Internal helper shared by map and map_to: transforms every element into
+one of _output_size bytes. Over owned data, outputs no larger than their
+inputs and than D_FUNCTIONAL_PIPELINE_SCRATCH_SIZE are written in place,
+one at a time through a stack buffer, each ending before the next input
+begins; other outputs go to the spare buffer, which is then swapped with
+the data. Over borrowed data they go to a new buffer the pipeline owns.
+*/
+static struct d_functional_pipeline
+d_functional_pipeline_map_stage
+(
+    struct d_functional_pipeline _pipe,
+    size_t                       _output_size,
+    fn_transformer               _transform,
+    void*                        _context,
+    const char*                  _operation
+)
+{
+    union d_functional_pipeline_scratch scratch;
+    void*                               output;
+    unsigned char*                      src;
+    unsigned char*                      dst;
+    size_t                              size;
+    size_t                              allocated;
+    size_t                              i;
+#if defined(D_FUNCTIONAL_PROFILE)
+    uint64_t                            profile_start;
+#endif
+
+    // only the profiler reads the operation name
+    (void)_operation;
+
+    D_PROFILE_START(profile_start);
+
+    src       = (unsigned char*)_pipe.data;
+    size      = _pipe.element_size;
+    allocated = 0;
+
+    // owned data, no wider and small enough: transform in place
+    if ( (_pipe.owns_data)                                  &&
+         (_output_size <= size)                             &&
+         (_output_size <= D_FUNCTIONAL_PIPELINE_SCRATCH_SIZE) )
+    {
+        for (i = 0; i < _pipe.count; i++)
+        {
+            if (!_transform(src + (i * size), scratch.bytes, _context))
+            {
+                _pipe.error_code = -1;
+
+                return _pipe;
+            }
+
+            memcpy(src + (i * _output_size), scratch.bytes, _output_size);
+        }
+    }
+    else
+    {
+        output = d_functional_pipeline_acquire(&_pipe,
+                                               _pipe.count * _output_size,
+                                               &allocated);
+
+        // check allocation
+        if (!output)
+        {
+            _pipe.error_code = -1;
+
+            return _pipe;
+        }
+
+        dst = (unsigned char*)output;
+
+        // apply the transformer to each element
+        for (i = 0; i < _pipe.count; i++)
+        {
+            if (!_transform(src + (i * size),
+                            dst + (i * _output_size),
+                            _context))
+            {
+                d_functional_pipeline_discard(&_pipe, output);
+                _pipe.error_code = -1;
+
+                return _pipe;
+            }
+        }
+
+        d_functional_pipeline_commit(&_pipe,
+                                     output,
+                                     _pipe.count * _output_size);
+    }
+
+    _pipe.element_size = _output_size;
+
+    D_PROFILE_STOP(profile_start, "pipeline", _operation,
+                   D_PROFILE_NO_INDEX, _pipe.count, _pipe.count,
+                   allocated, 0);
+
+    return _pipe;
+}
+
+
 /*
 d_functional_pipeline_map
-  Applies a transformer to each element in the pipeline, producing a new
-data buffer with the results. The old buffer is freed if the pipeline
-owned it.
+  Applies a transformer to each element in the pipeline. If the pipeline
+owns its data, elements of up to D_FUNCTIONAL_PIPELINE_SCRATCH_SIZE bytes
+are transformed in place, one at a time through a stack buffer, and larger
+ones into the pipeline's spare buffer, which is then swapped with the data;
+otherwise the results go to a new buffer the pipeline owns.
 
 Parameter(s):
   _pipe:      the current pipeline state.
@@ -127,7 +458,8 @@ Parameter(s):
 Return:
   A new pipeline containing the transformed data. If the pipeline is in
 an error state, _transform is NULL, or allocation fails, returns a
-pipeline with the appropriate error_code.
+pipeline with the appropriate error_code. If _transform fails on owned
+data, the data may be partly transformed.
 */
 struct d_functional_pipeline
 d_functional_pipeline_map
@@ -137,12 +469,6 @@ d_functional_pipeline_map
     void*                        _context
 )
 {
-    struct d_functional_pipeline result;
-    void*                        new_data;
-    const unsigned char*         src;
-    unsigned char*               dst;
-    size_t                       i;
-
     // propagate prior errors
     if (_pipe.error_code != 0)
     {
@@ -157,54 +483,75 @@ d_functional_pipeline_map
         return _pipe;
     }
 
-    new_data = malloc(_pipe.count * _pipe.element_size);
-
-    // check allocation
-    if (!new_data)
-    {
-        _pipe.error_code = -1;
+    return d_functional_pipeline_map_stage(_pipe,
+                                           _pipe.element_size,
+                                           _transform,
+                                           _context,
+                                           "map");
+}
 
-        return _pipe;
-    }
 
-    src = (const unsigned char*)_pipe.data;
-    dst = (unsigned char*)new_data;
+/*
+d_functional_pipeline_map_to
+  Applies a transformer producing elements of a different size, e.g. a
+projection of wide records onto their keys, so that later stages work on
+the new type. If the pipeline owns its data, narrowing maps to elements of
+up to D_FUNCTIONAL_PIPELINE_SCRATCH_SIZE bytes run in place and leave the
+data packed at the front of the buffer; widening maps write into the
+pipeline's spare buffer, which is then swapped with the data. Over
+borrowed data the results go to a new buffer the pipeline owns.
 
-    // apply the transformer to each element
-    for (i = 0; i < _pipe.count; i++)
+Parameter(s):
+  _pipe:        the current pipeline state.
+  _output_size: size of each transformed element in bytes.
+  _transform:   transformer writing an _output_size-byte element for each
+                input element.
+  _context:     context forwarded to _transform; may be NULL.
+Return:
+  A new pipeline containing the transformed data, with element_size set to
+_output_size. If the pipeline is in an error state, _output_size is 0,
+_transform is NULL, or allocation fails, returns a pipeline with the
+appropriate error_code. If _transform fails on owned data, the data may be
+partly transformed.
+*/
+struct d_functional_pipeline
+d_functional_pipeline_map_to
+(
+    struct d_functional_pipeline _pipe,
+    size_t                       _output_size,
+    fn_transformer               _transform,
+    void*                        _context
+)
+{
+    // propagate prior errors
+    if (_pipe.error_code != 0)
     {
-        if (!_transform(src + (i * _pipe.element_size),
-                        dst + (i * _pipe.element_size),
-                        _context))
-        {
-            free(new_data);
-            _pipe.error_code = -1;
-
-            return _pipe;
-        }
+        return _pipe;
     }
 
-    // free old data if we owned it
-    if (_pipe.owns_data && _pipe.data)
+    // validate parameters
+    if ( (_output_size == 0) ||
+         (!_transform) )
     {
-        free(_pipe.data);
-    }
+        _pipe.error_code = -1;
 
-    result.data         = new_data;
-    result.element_size = _pipe.element_size;
-    result.count        = _pipe.count;
-    result.owns_data    = true;
-    result.error_code   = 0;
+        return _pipe;
+    }
 
-    return result;
+    return d_functional_pipeline_map_stage(_pipe,
+                                           _output_size,
+                                           _transform,
+                                           _context,
+                                           "map_to");
 }
 
 
 /*
 d_functional_pipeline_filter
   Filters elements in the pipeline, keeping only those for which the
-predicate returns true. Allocates a new buffer for the results. The old
-buffer is freed if the pipeline owned it.
+predicate returns true. If the pipeline owns its data, the kept elements
+are compacted in place; otherwise they are copied to a new buffer the
+pipeline owns.
 
 Parameter(s):
   _pipe:    the current pipeline state.
@@ -223,12 +570,16 @@ d_functional_pipeline_filter
     void*                        _context
 )
 {
-    struct d_functional_pipeline result;
-    void*                        new_data;
-    const unsigned char*         src;
-    unsigned char*               dst;
-    size_t                       out_count;
-    size_t                       i;
+    void*                output;
+    const unsigned char* src;
+    unsigned char*       dst;
+    size_t               size;
+    size_t               out_count;
+    size_t               allocated;
+    size_t               i;
+#if defined(D_FUNCTIONAL_PROFILE)
+    uint64_t             profile_start;
+#endif
 
     // propagate prior errors
     if (_pipe.error_code != 0)
@@ -244,46 +595,63 @@ d_functional_pipeline_filter
         return _pipe;
     }
 
-    // allocate worst-case buffer (all elements pass)
-    new_data = malloc(_pipe.count * _pipe.element_size);
+    D_PROFILE_START(profile_start);
 
-    // check allocation
-    if (!new_data)
+    size      = _pipe.element_size;
+    allocated = 0;
+
+    // owned data is compacted in place; borrowed data needs a worst-case
+    // buffer (all elements pass)
+    if (_pipe.owns_data)
     {
-        _pipe.error_code = -1;
+        output = _pipe.data;
+    }
+    else
+    {
+        output = d_functional_pipeline_acquire(&_pipe,
+                                               _pipe.count * size,
+                                               &allocated);
 
-        return _pipe;
+        // check allocation
+        if (!output)
+        {
+            _pipe.error_code = -1;
+
+            return _pipe;
+        }
     }
 
     src       = (const unsigned char*)_pipe.data;
-    dst       = (unsigned char*)new_data;
+    dst       = (unsigned char*)output;
     out_count = 0;
 
     // copy elements that pass the predicate
     for (i = 0; i < _pipe.count; i++)
     {
-        if (_test(src + (i * _pipe.element_size), _context))
+        if (_test(src + (i * size), _context))
         {
-            memcpy(dst + (out_count * _pipe.element_size),
-                   src + (i * _pipe.element_size),
-                   _pipe.element_size);
+            if ( (dst != src) ||
+                 (out_count != i) )
+            {
+                memcpy(dst + (out_count * size), src + (i * size), size);
+            }
+
             out_count++;
         }
     }
 
-    // free old data if we owned it
-    if (_pipe.owns_data && _pipe.data)
+    if (output != _pipe.data)
     {
-        free(_pipe.data);
+        d_functional_pipeline_commit(&_pipe, output, _pipe.count * size);
     }
 
-    result.data         = new_data;
-    result.element_size = _pipe.element_size;
-    result.count        = out_count;
-    result.owns_data    = true;
-    result.error_code   = 0;
+    D_PROFILE_STOP(profile_start, "pipeline", "filter",
+                   D_PROFILE_NO_INDEX, _pipe.count, out_count,
+                   allocated, _pipe.count);
 
-    return result;
+    _pipe.count = out_count;
+
+    return _pipe;
 }
 
 
@@ -319,6 +687,9 @@ d_functional_pipeline_fold
     struct d_functional_pipeline result;
     const unsigned char*         src;
     size_t                       i;
+#if defined(D_FUNCTIONAL_PROFILE)
+    uint64_t                     profile_start;
+#endif
 
     // propagate prior errors
     if (_pipe.error_code != 0)
@@ -336,6 +707,8 @@ d_functional_pipeline_fold
         return _pipe;
     }
 
+    D_PROFILE_START(profile_start);
+
     src = (const unsigned char*)_pipe.data;
 
     // accumulate from left to right
@@ -352,44 +725,49 @@ d_functional_pipeline_fold
     }
 
     // free old data if we owned it
-    if (_pipe.owns_data && _pipe.data)
-    {
-        free(_pipe.data);
-    }
+    d_functional_pipeline_release(&_pipe);
+
+    D_PROFILE_STOP(profile_start, "pipeline", "fold",
+                   D_PROFILE_NO_INDEX, _pipe.count, 1, 0, 0);
 
-    result.data         = _initial;
-    result.element_size = _accumulator_size;
-    result.count        = 1;
-    result.owns_data    = false;
-    result.error_code   = 0;
+    d_functional_pipeline_init(&result, _initial, 1, _accumulator_size,
+                               false, 0);
 
     return result;
 }
 
 
 /*
-d_functional_pipeline_for_each
-  Applies a consumer function to each element in the pipeline. The data is
-not modified or reallocated; the pipeline is passed through unchanged.
+d_functional_pipeline_fold_multi
+  Folds all elements in the pipeline into several accumulators in a single
+pass (see d_functional_fold_multi). The pipeline's data is freed if owned,
+and the result pipeline wraps the spec array.
 
 Parameter(s):
-  _pipe:    the current pipeline state.
-  _apply:   consumer function to apply to each element.
-  _context: context forwarded to _apply; may be NULL.
+  _pipe:       the current pipeline state.
+  _specs:      array of aggregates to compute; each accumulator holds its
+               initial value and is modified in-place with its result.
+  _spec_count: number of entries in _specs.
 Return:
-  The same pipeline, unchanged. If the pipeline is in an error state or
-_apply is NULL, returns a pipeline with the appropriate error_code.
+  A new pipeline wrapping _specs with count _spec_count and element_size
+set to sizeof(struct d_fold_spec). The pipeline does NOT own _specs. If the
+pipeline is in an error state, _specs is NULL or empty, any spec lacks an
+accumulator or step function, or accumulation fails, returns a pipeline
+with the appropriate error_code.
 */
 struct d_functional_pipeline
-d_functional_pipeline_for_each
+d_functional_pipeline_fold_multi
 (
     struct d_functional_pipeline _pipe,
-    fn_consumer                   _apply,
-    void*                        _context
+    const struct d_fold_spec*    _specs,
+    size_t                       _spec_count
 )
 {
-    unsigned char* src;
-    size_t         i;
+    struct d_functional_pipeline result;
+    size_t                       s;
+#if defined(D_FUNCTIONAL_PROFILE)
+    uint64_t                     profile_start;
+#endif
 
     // propagate prior errors
     if (_pipe.error_code != 0)
@@ -397,31 +775,117 @@ d_functional_pipeline_for_each
         return _pipe;
     }
 
-    // validate consumer
-    if (!_apply)
+    // validate parameters
+    if ( (!_specs) ||
+         (_spec_count == 0) )
     {
         _pipe.error_code = -1;
 
         return _pipe;
     }
 
-    src = (unsigned char*)_pipe.data;
+    for (s = 0; s < _spec_count; s++)
+    {
+        if ( (!_specs[s].accumulator) ||
+             (!_specs[s].step) )
+        {
+            _pipe.error_code = -1;
 
-    // apply to each element
-    for (i = 0; i < _pipe.count; i++)
+            return _pipe;
+        }
+    }
+
+    D_PROFILE_START(profile_start);
+
+    // an empty pipeline leaves every accumulator at its initial value
+    if ( (_pipe.count > 0) &&
+         (!d_functional_fold_multi(_pipe.data,
+                                   _pipe.count,
+                                   _pipe.element_size,
+                                   _specs,
+                                   _spec_count)) )
     {
-        _apply(src + (i * _pipe.element_size), _context);
+        _pipe.error_code = -1;
+
+        return _pipe;
     }
 
-    return _pipe;
+    // free old data if we owned it
+    d_functional_pipeline_release(&_pipe);
+
+    D_PROFILE_STOP(profile_start, "pipeline", "fold_multi",
+                   D_PROFILE_NO_INDEX, _pipe.count, _spec_count, 0, 0);
+
+    d_functional_pipeline_init(&result, (void*)_specs, _spec_count,
+                               sizeof(struct d_fold_spec), false, 0);
+
+    return result;
 }
 
 
 /*
-d_functional_pipeline_take
-  Reduces the pipeline to at most the first _n elements. No data is copied
-or reallocated; the count is simply clamped.
-
+d_functional_pipeline_for_each
+  Applies a consumer function to each element in the pipeline. The data is
+not modified or reallocated; the pipeline is passed through unchanged.
+
+Parameter(s):
+  _pipe:    the current pipeline state.
+  _apply:   consumer function to apply to each element.
+  _context: context forwarded to _apply; may be NULL.
+Return:
+  The same pipeline, unchanged. If the pipeline is in an error state or
+_apply is NULL, returns a pipeline with the appropriate error_code.
+*/
+struct d_functional_pipeline
+d_functional_pipeline_for_each
+(
+    struct d_functional_pipeline _pipe,
+    fn_consumer                   _apply,
+    void*                        _context
+)
+{
+    unsigned char* src;
+    size_t         i;
+#if defined(D_FUNCTIONAL_PROFILE)
+    uint64_t       profile_start;
+#endif
+
+    // propagate prior errors
+    if (_pipe.error_code != 0)
+    {
+        return _pipe;
+    }
+
+    // validate consumer
+    if (!_apply)
+    {
+        _pipe.error_code = -1;
+
+        return _pipe;
+    }
+
+    D_PROFILE_START(profile_start);
+
+    src = (unsigned char*)_pipe.data;
+
+    // apply to each element
+    for (i = 0; i < _pipe.count; i++)
+    {
+        _apply(src + (i * _pipe.element_size), _context);
+    }
+
+    D_PROFILE_STOP(profile_start, "pipeline", "for_each",
+                   D_PROFILE_NO_INDEX, _pipe.count, _pipe.count, 0, 0);
+
+    return _pipe;
+}
+
+
+/*
+d_functional_pipeline_take
+  Reduces the pipeline to at most the first _n elements. No data is copied
+or reallocated; the count is simply clamped.
+
 Parameter(s):
   _pipe: the current pipeline state.
   _n:    maximum number of elements to keep.
@@ -436,18 +900,32 @@ d_functional_pipeline_take
     size_t                       _n
 )
 {
+#if defined(D_FUNCTIONAL_PROFILE)
+    uint64_t profile_start;
+    size_t   rows_in;
+#endif
+
     // propagate prior errors
     if (_pipe.error_code != 0)
     {
         return _pipe;
     }
 
+#if defined(D_FUNCTIONAL_PROFILE)
+    rows_in = _pipe.count;
+#endif
+
+    D_PROFILE_START(profile_start);
+
     // clamp count
     if (_n < _pipe.count)
     {
         _pipe.count = _n;
     }
 
+    D_PROFILE_STOP(profile_start, "pipeline", "take",
+                   D_PROFILE_NO_INDEX, rows_in, _pipe.count, 0, 0);
+
     return _pipe;
 }
 
@@ -456,7 +934,7 @@ d_functional_pipeline_take
 d_functional_pipeline_skip
   Advances the pipeline past the first _n elements. The data pointer is
 adjusted forward and the count is reduced accordingly. No data is copied
-or reallocated.
+or reallocated; an owned buffer is still freed from its start.
 
 Parameter(s):
   _pipe: the current pipeline state.
@@ -473,24 +951,725 @@ d_functional_pipeline_skip
     size_t                       _n
 )
 {
+#if defined(D_FUNCTIONAL_PROFILE)
+    uint64_t profile_start;
+    size_t   rows_in;
+#endif
+
     // propagate prior errors
     if (_pipe.error_code != 0)
     {
         return _pipe;
     }
 
+#if defined(D_FUNCTIONAL_PROFILE)
+    rows_in = _pipe.count;
+#endif
+
+    D_PROFILE_START(profile_start);
+
     // skip past all elements
     if (_n >= _pipe.count)
     {
         _pipe.count = 0;
+    }
+    else
+    {
+        // advance the data pointer
+        _pipe.data = (unsigned char*)_pipe.data +
+                     (_n * _pipe.element_size);
+        _pipe.count -= _n;
+    }
+
+    D_PROFILE_STOP(profile_start, "pipeline", "skip",
+                   D_PROFILE_NO_INDEX, rows_in, _pipe.count, 0, 0);
+
+    return _pipe;
+}
+
+
+/*
+d_functional_pipeline_flat_map
+  Expands each element into zero to _max_count elements of _output_size
+bytes, e.g. splitting records into their line items. The expander is
+given room for _max_count outputs per element. If the pipeline owns its
+data and an element's outputs fit both in the element itself and in
+D_FUNCTIONAL_PIPELINE_SCRATCH_SIZE bytes, the expansion runs in place
+through a stack buffer; otherwise the outputs go to the pipeline's spare
+buffer, sized for the worst case, which is then swapped with the data.
+
+Parameter(s):
+  _pipe:        the current pipeline state.
+  _output_size: size of each output element in bytes.
+  _max_count:   most outputs any one element may expand into.
+  _expand:      expander writing up to _max_count elements per input.
+  _context:     context forwarded to _expand; may be NULL.
+Return:
+  A new pipeline containing every output in order, with element_size set
+to _output_size. If the pipeline is in an error state, _output_size or
+_max_count is 0, _expand is NULL, the worst-case size overflows,
+allocation fails, or _expand fails or reports more than _max_count
+outputs, returns a pipeline with the appropriate error_code. If _expand
+fails on owned data, the data may be partly expanded.
+*/
+struct d_functional_pipeline
+d_functional_pipeline_flat_map
+(
+    struct d_functional_pipeline _pipe,
+    size_t                       _output_size,
+    size_t                       _max_count,
+    fn_expander                  _expand,
+    void*                        _context
+)
+{
+    union d_functional_pipeline_scratch scratch;
+    void*                               output;
+    unsigned char*                      src;
+    unsigned char*                      dst;
+    size_t                              bound;
+    size_t                              produced;
+    size_t                              out_count;
+    size_t                              allocated;
+    size_t                              i;
+    bool                                in_place;
+#if defined(D_FUNCTIONAL_PROFILE)
+    uint64_t                            profile_start;
+#endif
+
+    // propagate prior errors
+    if (_pipe.error_code != 0)
+    {
+        return _pipe;
+    }
+
+    // validate parameters
+    if ( (_output_size == 0)                         ||
+         (_max_count == 0)                           ||
+         (!_expand)                                  ||
+         (_max_count > SIZE_MAX / _output_size) )
+    {
+        _pipe.error_code = -1;
+
+        return _pipe;
+    }
+
+    bound = _max_count * _output_size;
+
+    // the worst case must be addressable
+    if ( (_pipe.count > 0) &&
+         (bound > SIZE_MAX / _pipe.count) )
+    {
+        _pipe.error_code = -1;
 
         return _pipe;
     }
 
-    // advance the data pointer
-    _pipe.data = (unsigned char*)_pipe.data +
-                 (_n * _pipe.element_size);
-    _pipe.count -= _n;
+    D_PROFILE_START(profile_start);
+
+    src       = (unsigned char*)_pipe.data;
+    allocated = 0;
+    in_place  = ( (_pipe.owns_data)                           &&
+                  (bound <= _pipe.element_size)               &&
+                  (bound <= D_FUNCTIONAL_PIPELINE_SCRATCH_SIZE) );
+
+    if (in_place)
+    {
+        output = _pipe.data;
+    }
+    else
+    {
+        output = d_functional_pipeline_acquire(&_pipe,
+                                               _pipe.count * bound,
+                                               &allocated);
+
+        // check allocation
+        if (!output)
+        {
+            _pipe.error_code = -1;
+
+            return _pipe;
+        }
+    }
+
+    dst       = (unsigned char*)output;
+    out_count = 0;
+
+    // expand each element after the outputs so far
+    for (i = 0; i < _pipe.count; i++)
+    {
+        produced = _max_count;
+
+        if ( (!_expand(src + (i * _pipe.element_size),
+                       (in_place) ? scratch.bytes
+                                  : dst + (out_count * _output_size),
+                       &produced,
+                       _context)) ||
+             (produced > _max_count) )
+        {
+            if (!in_place)
+            {
+                d_functional_pipeline_discard(&_pipe, output);
+            }
+
+            _pipe.error_code = -1;
+
+            return _pipe;
+        }
+
+        if (in_place)
+        {
+            memcpy(dst + (out_count * _output_size),
+                   scratch.bytes,
+                   produced * _output_size);
+        }
+
+        out_count += produced;
+    }
+
+    if (!in_place)
+    {
+        d_functional_pipeline_commit(&_pipe, output, _pipe.count * bound);
+    }
+
+    D_PROFILE_STOP(profile_start, "pipeline", "flat_map",
+                   D_PROFILE_NO_INDEX, _pipe.count, out_count,
+                   allocated, 0);
+
+    _pipe.element_size = _output_size;
+    _pipe.count        = out_count;
+
+    return _pipe;
+}
+
+
+/*
+d_functional_pipeline_zip
+  Combines the pipeline element-wise with a second pipeline, pairing the
+i-th elements of both, and stops at the end of the shorter one. The second
+pipeline is consumed: its data is freed if owned, whether or not the zip
+succeeds. If the first pipeline owns its data and the combined elements
+are no larger than its elements and than
+D_FUNCTIONAL_PIPELINE_SCRATCH_SIZE, they are written in place; otherwise
+they go to its spare buffer, which is then swapped with the data.
+
+Parameter(s):
+  _pipe:        the current pipeline state.
+  _other:       the pipeline to pair with; its data must not overlap the
+                data of _pipe.
+  _output_size: size of each combined element in bytes.
+  _combine:     operation writing the combination of an element of _pipe
+                (first) and one of _other (second).
+  _context:     context forwarded to _combine; may be NULL.
+Return:
+  A new pipeline containing min(_pipe.count, _other.count) combined
+elements, with element_size set to _output_size. If either pipeline is in
+an error state, both own the same buffer, _output_size is 0, _combine is
+NULL, or allocation fails, returns a pipeline with the appropriate
+error_code. If _combine fails on owned data, the data may be partly
+combined.
+*/
+struct d_functional_pipeline
+d_functional_pipeline_zip
+(
+    struct d_functional_pipeline _pipe,
+    struct d_functional_pipeline _other,
+    size_t                       _output_size,
+    fn_binary_operation          _combine,
+    void*                        _context
+)
+{
+    union d_functional_pipeline_scratch scratch;
+    void*                               output;
+    unsigned char*                      src;
+    const unsigned char*                second;
+    unsigned char*                      dst;
+    size_t                              count;
+    size_t                              allocated;
+    size_t                              i;
+    bool                                in_place;
+#if defined(D_FUNCTIONAL_PROFILE)
+    uint64_t                            profile_start;
+#endif
+
+    // the same buffer cannot be released twice
+    if ( (_pipe.owns_data)  &&
+         (_other.owns_data) &&
+         (_pipe.buffer == _other.buffer) )
+    {
+        _pipe.error_code = -1;
+
+        return _pipe;
+    }
+
+    // propagate prior errors
+    if (_pipe.error_code != 0)
+    {
+        d_functional_pipeline_release(&_other);
+
+        return _pipe;
+    }
+
+    if (_other.error_code != 0)
+    {
+        d_functional_pipeline_release(&_other);
+        _pipe.error_code = _other.error_code;
+
+        return _pipe;
+    }
+
+    // validate parameters
+    if ( (_output_size == 0) ||
+         (!_combine) )
+    {
+        d_functional_pipeline_release(&_other);
+        _pipe.error_code = -1;
+
+        return _pipe;
+    }
+
+    D_PROFILE_START(profile_start);
+
+    count     = (_pipe.count < _other.count) ? _pipe.count : _other.count;
+    src       = (unsigned char*)_pipe.data;
+    second    = (const unsigned char*)_other.data;
+    allocated = 0;
+    in_place  = ( (_pipe.owns_data)                                  &&
+                  (_output_size <= _pipe.element_size)               &&
+                  (_output_size <= D_FUNCTIONAL_PIPELINE_SCRATCH_SIZE) );
+
+    if (in_place)
+    {
+        output = _pipe.data;
+    }
+    else
+    {
+        output = d_functional_pipeline_acquire(&_pipe,
+                                               count * _output_size,
+                                               &allocated);
+
+        // check allocation
+        if (!output)
+        {
+            d_functional_pipeline_release(&_other);
+            _pipe.error_code = -1;
+
+            return _pipe;
+        }
+    }
+
+    dst = (unsigned char*)output;
+
+    // combine each pair of elements
+    for (i = 0; i < count; i++)
+    {
+        if (!_combine(src + (i * _pipe.element_size),
+                      second + (i * _other.element_size),
+                      (in_place) ? scratch.bytes
+                                 : dst + (i * _output_size),
+                      _context))
+        {
+            if (!in_place)
+            {
+                d_functional_pipeline_discard(&_pipe, output);
+            }
+
+            d_functional_pipeline_release(&_other);
+            _pipe.error_code = -1;
+
+            return _pipe;
+        }
+
+        if (in_place)
+        {
+            memcpy(dst + (i * _output_size), scratch.bytes, _output_size);
+        }
+    }
+
+    if (!in_place)
+    {
+        d_functional_pipeline_commit(&_pipe, output, count * _output_size);
+    }
+
+    d_functional_pipeline_release(&_other);
+
+    D_PROFILE_STOP(profile_start, "pipeline", "zip",
+                   D_PROFILE_NO_INDEX, _pipe.count, count,
+                   allocated, 0);
+
+    _pipe.element_size = _output_size;
+    _pipe.count        = count;
+
+    return _pipe;
+}
+
+
+/*
+d_functional_pipeline_window_stage
+  Internal helper shared by chunk and window: summarizes each run of
+_size consecutive elements starting every _step elements into one output
+of _output_size bytes. If _partial is true, a trailing run shorter than
+_size is summarized too. Over owned data, outputs no larger than an
+element and than D_FUNCTIONAL_PIPELINE_SCRATCH_SIZE are written in place:
+output i ends before run i + 1 begins, since _step is at least 1.
+*/
+static struct d_functional_pipeline
+d_functional_pipeline_window_stage
+(
+    struct d_functional_pipeline _pipe,
+    size_t                       _size,
+    size_t                       _step,
+    bool                         _partial,
+    size_t                       _output_size,
+    fn_aggregator                _aggregate,
+    void*                        _context,
+    const char*                  _operation
+)
+{
+    union d_functional_pipeline_scratch scratch;
+    void*                               output;
+    unsigned char*                      src;
+    unsigned char*                      dst;
+    size_t                              runs;
+    size_t                              start;
+    size_t                              length;
+    size_t                              allocated;
+    size_t                              i;
+    bool                                in_place;
+#if defined(D_FUNCTIONAL_PROFILE)
+    uint64_t                            profile_start;
+#endif
+
+    // only the profiler reads the operation name
+    (void)_operation;
+
+    D_PROFILE_START(profile_start);
+
+    // count the runs
+    if (_partial)
+    {
+        runs = (_pipe.count / _step) + ((_pipe.count % _step) ? 1 : 0);
+    }
+    else
+    {
+        runs = (_pipe.count >= _size)
+                   ? ((_pipe.count - _size) / _step) + 1
+                   : 0;
+    }
+
+    src       = (unsigned char*)_pipe.data;
+    allocated = 0;
+    in_place  = ( (_pipe.owns_data)                                  &&
+                  (_output_size <= _pipe.element_size)               &&
+                  (_output_size <= D_FUNCTIONAL_PIPELINE_SCRATCH_SIZE) );
+
+    if (in_place)
+    {
+        output = _pipe.data;
+    }
+    else
+    {
+        output = d_functional_pipeline_acquire(&_pipe,
+                                               runs * _output_size,
+                                               &allocated);
+
+        // check allocation
+        if (!output)
+        {
+            _pipe.error_code = -1;
+
+            return _pipe;
+        }
+    }
+
+    dst = (unsigned char*)output;
+
+    // summarize each run
+    for (i = 0; i < runs; i++)
+    {
+        start  = i * _step;
+        length = ((_pipe.count - start) < _size) ? (_pipe.count - start)
+                                                  : _size;
+
+        if (!_aggregate(src + (start * _pipe.element_size),
+                        length,
+                        (in_place) ? scratch.bytes
+                                   : dst + (i * _output_size),
+                        _context))
+        {
+            if (!in_place)
+            {
+                d_functional_pipeline_discard(&_pipe, output);
+            }
+
+            _pipe.error_code = -1;
+
+            return _pipe;
+        }
+
+        if (in_place)
+        {
+            memcpy(dst + (i * _output_size), scratch.bytes, _output_size);
+        }
+    }
+
+    if (!in_place)
+    {
+        d_functional_pipeline_commit(&_pipe, output, runs * _output_size);
+    }
+
+    D_PROFILE_STOP(profile_start, "pipeline", _operation,
+                   D_PROFILE_NO_INDEX, _pipe.count, runs,
+                   allocated, 0);
+
+    _pipe.element_size = _output_size;
+    _pipe.count        = runs;
+
+    return _pipe;
+}
+
+
+/*
+d_functional_pipeline_chunk
+  Splits the pipeline into consecutive batches of _size elements and
+summarizes each batch into one output element; the last batch holds the
+remaining elements and may be shorter. Over owned data, outputs no larger
+than an element and than D_FUNCTIONAL_PIPELINE_SCRATCH_SIZE are written in
+place; others go to the spare buffer, which is then swapped with the data.
+
+Parameter(s):
+  _pipe:        the current pipeline state.
+  _size:        number of elements per batch.
+  _output_size: size of each batch summary in bytes.
+  _aggregate:   aggregator summarizing a batch.
+  _context:     context forwarded to _aggregate; may be NULL.
+Return:
+  A new pipeline containing one summary per batch, with element_size set
+to _output_size. If the pipeline is in an error state, _size or
+_output_size is 0, _aggregate is NULL, allocation fails, or _aggregate
+fails, returns a pipeline with the appropriate error_code.
+*/
+struct d_functional_pipeline
+d_functional_pipeline_chunk
+(
+    struct d_functional_pipeline _pipe,
+    size_t                       _size,
+    size_t                       _output_size,
+    fn_aggregator                _aggregate,
+    void*                        _context
+)
+{
+    // propagate prior errors
+    if (_pipe.error_code != 0)
+    {
+        return _pipe;
+    }
+
+    // validate parameters
+    if ( (_size == 0)        ||
+         (_output_size == 0) ||
+         (!_aggregate) )
+    {
+        _pipe.error_code = -1;
+
+        return _pipe;
+    }
+
+    return d_functional_pipeline_window_stage(_pipe,
+                                              _size,
+                                              _size,
+                                              true,
+                                              _output_size,
+                                              _aggregate,
+                                              _context,
+                                              "chunk");
+}
+
+
+/*
+d_functional_pipeline_window
+  Slides a window of _size elements over the pipeline, advancing _step
+elements at a time, and summarizes each full window into one output
+element (e.g. a moving average). Over owned data, outputs no larger than
+an element and than D_FUNCTIONAL_PIPELINE_SCRATCH_SIZE are written in
+place; others go to the spare buffer, which is then swapped with the data.
+
+Parameter(s):
+  _pipe:        the current pipeline state.
+  _size:        number of elements per window.
+  _step:        number of elements between the starts of two windows.
+  _output_size: size of each window summary in bytes.
+  _aggregate:   aggregator summarizing a window.
+  _context:     context forwarded to _aggregate; may be NULL.
+Return:
+  A new pipeline containing one summary per full window, none if there
+are fewer than _size elements, with element_size set to _output_size. If
+the pipeline is in an error state, _size, _step, or _output_size is 0,
+_aggregate is NULL, allocation fails, or _aggregate fails, returns a
+pipeline with the appropriate error_code.
+*/
+struct d_functional_pipeline
+d_functional_pipeline_window
+(
+    struct d_functional_pipeline _pipe,
+    size_t                       _size,
+    size_t                       _step,
+    size_t                       _output_size,
+    fn_aggregator                _aggregate,
+    void*                        _context
+)
+{
+    // propagate prior errors
+    if (_pipe.error_code != 0)
+    {
+        return _pipe;
+    }
+
+    // validate parameters
+    if ( (_size == 0)        ||
+         (_step == 0)        ||
+         (_output_size == 0) ||
+         (!_aggregate) )
+    {
+        _pipe.error_code = -1;
+
+        return _pipe;
+    }
+
+    return d_functional_pipeline_window_stage(_pipe,
+                                              _size,
+                                              _step,
+                                              false,
+                                              _output_size,
+                                              _aggregate,
+                                              _context,
+                                              "window");
+}
+
+
+/*
+d_functional_pipeline_scan
+  Folds the pipeline from left to right like d_functional_pipeline_fold,
+but keeps every intermediate accumulator: the i-th output is the
+accumulator after the i-th element (e.g. a prefix sum). If the pipeline
+owns its data and the accumulator is no larger than an element, the
+outputs overwrite the data in place; otherwise they go to the spare
+buffer, which is then swapped with the data.
+
+Parameter(s):
+  _pipe:             the current pipeline state.
+  _initial:          pointer to the initial accumulator value; this buffer
+                     is modified in-place and ends holding the final value.
+  _accumulator_size: size in bytes of the accumulator value.
+  _combine:          accumulator function applied at each step.
+  _context:          context forwarded to _combine; may be NULL.
+Return:
+  A new pipeline containing one accumulator per element, with
+element_size set to _accumulator_size. If the pipeline is in an error
+state, _initial is NULL, _combine is NULL, _accumulator_size is 0,
+allocation fails, or accumulation fails, returns a pipeline with the
+appropriate error_code. If accumulation fails on owned data, the data may
+be partly overwritten.
+*/
+struct d_functional_pipeline
+d_functional_pipeline_scan
+(
+    struct d_functional_pipeline _pipe,
+    void*                        _initial,
+    size_t                       _accumulator_size,
+    fn_accumulator               _combine,
+    void*                        _context
+)
+{
+    void*          output;
+    unsigned char* src;
+    unsigned char* dst;
+    size_t         allocated;
+    size_t         i;
+    bool           in_place;
+#if defined(D_FUNCTIONAL_PROFILE)
+    uint64_t       profile_start;
+#endif
+
+    // propagate prior errors
+    if (_pipe.error_code != 0)
+    {
+        return _pipe;
+    }
+
+    // validate parameters
+    if ( (!_initial)              ||
+         (!_combine)              ||
+         (_accumulator_size == 0) )
+    {
+        _pipe.error_code = -1;
+
+        return _pipe;
+    }
+
+    D_PROFILE_START(profile_start);
+
+    src       = (unsigned char*)_pipe.data;
+    allocated = 0;
+    in_place  = ( (_pipe.owns_data) &&
+                  (_accumulator_size <= _pipe.element_size) );
+
+    if (in_place)
+    {
+        output = _pipe.data;
+    }
+    else
+    {
+        output = d_functional_pipeline_acquire(&_pipe,
+                                               _pipe.count *
+                                                   _accumulator_size,
+                                               &allocated);
+
+        // check allocation
+        if (!output)
+        {
+            _pipe.error_code = -1;
+
+            return _pipe;
+        }
+    }
+
+    dst = (unsigned char*)output;
+
+    // accumulate from left to right, recording each step; element i is
+    // read before its slot is overwritten
+    for (i = 0; i < _pipe.count; i++)
+    {
+        if (!_combine(_initial,
+                      src + (i * _pipe.element_size),
+                      _context))
+        {
+            if (!in_place)
+            {
+                d_functional_pipeline_discard(&_pipe, output);
+            }
+
+            _pipe.error_code = -1;
+
+            return _pipe;
+        }
+
+        memcpy(dst + (i * _accumulator_size),
+               _initial,
+               _accumulator_size);
+    }
+
+    if (!in_place)
+    {
+        d_functional_pipeline_commit(&_pipe,
+                                     output,
+                                     _pipe.count * _accumulator_size);
+    }
+
+    D_PROFILE_STOP(profile_start, "pipeline", "scan",
+                   D_PROFILE_NO_INDEX, _pipe.count, _pipe.count,
+                   allocated, 0);
+
+    _pipe.element_size = _accumulator_size;
 
     return _pipe;
 }
@@ -499,7 +1678,10 @@ d_functional_pipeline_skip
 /*
 d_functional_pipeline_end
   Finalizes the pipeline, returning the data pointer and element count.
-The caller takes ownership of the data if the pipeline owned it.
+The caller takes ownership of the data if the pipeline owned it; skipped
+elements are then moved out of the way so that the returned pointer is the
+one to free, and the spare buffer is freed. A returned pointer equal to
+the data given to d_functional_pipeline_begin_in_place is not to be freed.
 
 Parameter(s):
   _pipe:      the pipeline to finalize.
@@ -528,6 +1710,21 @@ d_functional_pipeline_end
         return NULL;
     }
 
+    if (_pipe.owns_data)
+    {
+        // the data may start inside the buffer after a skip
+        if (_pipe.data != _pipe.buffer)
+        {
+            memmove(_pipe.buffer,
+                    _pipe.data,
+                    _pipe.count * _pipe.element_size);
+        }
+
+        d_functional_pipeline_drop(&_pipe, _pipe.spare);
+
+        return _pipe.buffer;
+    }
+
     return _pipe.data;
 }
 
@@ -554,10 +1751,7 @@ d_functional_pipeline_free
     }
 
     // free data if we own it
-    if (_pipe->owns_data && _pipe->data)
-    {
-        free(_pipe->data);
-    }
+    d_functional_pipeline_release(_pipe);
 
     _pipe->data       = NULL;
     _pipe->count      = 0;
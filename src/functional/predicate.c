@@ -25,7 +25,7 @@ d_predicate_and_new
 )
 {
     struct d_predicate_and* new_predicate_and = 
-        malloc(sizeof(struct d_predicate_and));
+        d_functional_malloc(sizeof(struct d_predicate_and));
 
     // ensure that memory allocation was successful
     if (!new_predicate_and)
@@ -65,7 +65,7 @@ d_predicate_or_new
 )
 {
     struct d_predicate_or* new_predicate_or =
-        malloc(sizeof(struct d_predicate_or));
+        d_functional_malloc(sizeof(struct d_predicate_or));
 
     // ensure that memory allocation was successful
     if (!new_predicate_or)
@@ -105,7 +105,7 @@ d_predicate_xor_new
 )
 {
     struct d_predicate_xor* new_predicate_xor =
-        malloc(sizeof(struct d_predicate_xor));
+        d_functional_malloc(sizeof(struct d_predicate_xor));
 
     // ensure that memory allocation was successful
     if (!new_predicate_xor)
@@ -139,7 +139,173 @@ d_predicate_not_new
 )
 {
     struct d_predicate_not* new_predicate_not =
-        malloc(sizeof(struct d_predicate_not));
+        d_functional_malloc(sizeof(struct d_predicate_not));
+
+    // ensure that memory allocation was successful
+    if (!new_predicate_not)
+    {
+        return NULL;
+    }
+
+    new_predicate_not->predicate = _predicate;
+    new_predicate_not->context   = _context;
+
+    return new_predicate_not;
+}
+
+/*
+d_predicate_and_new_in
+  Creates a `d_predicate_and` combinator inside an arena. Identical to
+d_predicate_and_new except for where the combinator lives; it is released
+with the arena and must not be passed to d_functional_free().
+
+Parameter(s):
+  _arena:      the arena to allocate from.
+  _predicate1: the first predicate function.
+  _context1:   context for the first predicate; may be NULL.
+  _predicate2: the second predicate function.
+  _context2:   context for the second predicate; may be NULL.
+Return:
+  A pointer to the new combinator, or NULL if _arena was NULL or the arena
+could not grow.
+*/
+struct d_predicate_and*
+d_predicate_and_new_in
+(
+    struct d_fn_arena* _arena,
+    fn_predicate       _predicate1,
+    void*              _context1,
+    fn_predicate       _predicate2,
+    void*              _context2
+)
+{
+    struct d_predicate_and* new_predicate_and =
+        d_fn_arena_alloc(_arena, sizeof(struct d_predicate_and));
+
+    // ensure that memory allocation was successful
+    if (!new_predicate_and)
+    {
+        return NULL;
+    }
+
+    new_predicate_and->predicate1 = _predicate1;
+    new_predicate_and->predicate2 = _predicate2;
+    new_predicate_and->context1   = _context1;
+    new_predicate_and->context2   = _context2;
+
+    return new_predicate_and;
+}
+
+/*
+d_predicate_or_new_in
+  Creates a `d_predicate_or` combinator inside an arena. Identical to
+d_predicate_or_new except for where the combinator lives; it is released
+with the arena and must not be passed to d_functional_free().
+
+Parameter(s):
+  _arena:      the arena to allocate from.
+  _predicate1: the first predicate function.
+  _context1:   context for the first predicate; may be NULL.
+  _predicate2: the second predicate function.
+  _context2:   context for the second predicate; may be NULL.
+Return:
+  A pointer to the new combinator, or NULL if _arena was NULL or the arena
+could not grow.
+*/
+struct d_predicate_or*
+d_predicate_or_new_in
+(
+    struct d_fn_arena* _arena,
+    fn_predicate       _predicate1,
+    void*              _context1,
+    fn_predicate       _predicate2,
+    void*              _context2
+)
+{
+    struct d_predicate_or* new_predicate_or =
+        d_fn_arena_alloc(_arena, sizeof(struct d_predicate_or));
+
+    // ensure that memory allocation was successful
+    if (!new_predicate_or)
+    {
+        return NULL;
+    }
+
+    new_predicate_or->predicate1 = _predicate1;
+    new_predicate_or->predicate2 = _predicate2;
+    new_predicate_or->context1   = _context1;
+    new_predicate_or->context2   = _context2;
+
+    return new_predicate_or;
+}
+
+/*
+d_predicate_xor_new_in
+  Creates a `d_predicate_xor` combinator inside an arena. Identical to
+d_predicate_xor_new except for where the combinator lives; it is released
+with the arena and must not be passed to d_functional_free().
+
+Parameter(s):
+  _arena:      the arena to allocate from.
+  _predicate1: the first predicate function.
+  _context1:   context for the first predicate; may be NULL.
+  _predicate2: the second predicate function.
+  _context2:   context for the second predicate; may be NULL.
+Return:
+  A pointer to the new combinator, or NULL if _arena was NULL or the arena
+could not grow.
+*/
+struct d_predicate_xor*
+d_predicate_xor_new_in
+(
+    struct d_fn_arena* _arena,
+    fn_predicate       _predicate1,
+    void*              _context1,
+    fn_predicate       _predicate2,
+    void*              _context2
+)
+{
+    struct d_predicate_xor* new_predicate_xor =
+        d_fn_arena_alloc(_arena, sizeof(struct d_predicate_xor));
+
+    // ensure that memory allocation was successful
+    if (!new_predicate_xor)
+    {
+        return NULL;
+    }
+
+    new_predicate_xor->predicate1 = _predicate1;
+    new_predicate_xor->predicate2 = _predicate2;
+    new_predicate_xor->context1   = _context1;
+    new_predicate_xor->context2   = _context2;
+
+    return new_predicate_xor;
+}
+
+/*
+d_predicate_not_new_in
+  Creates a `d_predicate_not` combinator inside an arena. Identical to
+d_predicate_not_new except for where the combinator lives; it is released
+with the arena and must not be passed to d_functional_free().
+
+Parameter(s):
+  _arena:     the arena to allocate from.
+  _predicate: the predicate function to negate.
+  _context:   context for the predicate; may be NULL.
+Return:
+  A pointer to the new combinator, or NULL if _arena was NULL or the arena
+could not grow.
+*/
+struct d_predicate_not*
+d_predicate_not_new_in
+(
+    struct d_fn_arena* _arena,
+    fn_predicate       _predicate,
+    void*              _context
+)
+{
+    struct d_predicate_not* new_predicate_not =
+        d_fn_arena_alloc(_arena, sizeof(struct d_predicate_not));
 
     // ensure that memory allocation was successful
     if (!new_predicate_not)
@@ -312,4 +478,1551 @@ d_predicate_is_not_null
 )
 {
     return (_element != NULL);
-}
\ No newline at end of file
+}
+
+/*
+d_predicate_opcode
+  Internal opcodes of a compiled d_predicate_program. The program keeps a
+single boolean register; PUSH/XOR_POP and COUNT_BEGIN/COUNT_STEP use a small
+value stack for XOR operands and N_OF counters.
+*/
+enum d_predicate_opcode
+{
+    D_PREDICATE_OPCODE_CONST       = 0,  // r = arg
+    D_PREDICATE_OPCODE_LEAF        = 1,  // r = leaves[arg](element)
+    D_PREDICATE_OPCODE_NOT         = 2,  // r = !r
+    D_PREDICATE_OPCODE_AND_SC      = 3,  // if !r, jump to target
+    D_PREDICATE_OPCODE_OR_SC       = 4,  // if r, jump to target
+    D_PREDICATE_OPCODE_PUSH        = 5,  // push r
+    D_PREDICATE_OPCODE_XOR_POP     = 6,  // r = pop ^ r
+    D_PREDICATE_OPCODE_COUNT_BEGIN = 7,  // push a zero counter
+    D_PREDICATE_OPCODE_COUNT_STEP  = 8   // count r, exit once decided
+};
+
+// unpatched jump target; replaced when the enclosing group is complete
+#define D_PREDICATE_TARGET_PENDING UINT32_MAX
+
+/*
+d_predicate_operand
+  Internal pairing of an expression node with the negation that applies to
+it after NOT nodes and De Morgan rewrites have been pushed down.
+*/
+struct d_predicate_operand
+{
+    size_t node;
+    bool   negate;
+};
+
+/*
+d_predicate_emitter
+  Internal state for compiling a d_predicate_expr. When code is NULL the
+emitter only measures the program (instruction count and stack depth).
+*/
+struct d_predicate_emitter
+{
+    const struct d_predicate_expr* expr;
+    struct d_predicate_instr*      code;
+    size_t                         count;
+    size_t                         depth;
+    size_t                         max_depth;
+    struct d_predicate_operand*    operands;      // scratch operand stack
+    size_t                         operand_top;
+    bool                           failed;
+};
+
+/*
+d_predicate_expr_new
+  Creates an empty predicate expression builder.
+
+Parameter(s):
+  (none)
+Return:
+  A pointer to a newly allocated d_predicate_expr, or NULL if allocation
+failed.
+*/
+struct d_predicate_expr*
+d_predicate_expr_new
+(
+    void
+)
+{
+    struct d_predicate_expr* expr;
+
+    expr = d_functional_malloc(sizeof(struct d_predicate_expr));
+
+    // ensure that memory allocation was successful
+    if (!expr)
+    {
+        return NULL;
+    }
+
+    expr->nodes         = NULL;
+    expr->node_count    = 0;
+    expr->node_capacity = 0;
+    expr->leaves        = NULL;
+    expr->leaf_count    = 0;
+    expr->leaf_capacity = 0;
+    expr->pending       = 0;
+    expr->failed        = false;
+
+    return expr;
+}
+
+/*
+d_predicate_expr_push_node
+  Internal helper that appends a node combining the top _arity
+subexpressions of the builder's stack into one.
+
+Parameter(s):
+  _expr:  the builder.
+  _op:    the node kind.
+  _arity: number of subexpressions consumed (0 for leaves).
+  _arg:   leaf index or N_OF threshold.
+Return:
+  A boolean value corresponding to either:
+  - true, if the node was appended, or
+  - false, if the stack held fewer than _arity subexpressions or
+    allocation failed; the builder is then marked as failed.
+*/
+static bool
+d_predicate_expr_push_node
+(
+    struct d_predicate_expr* _expr,
+    enum d_predicate_expr_op _op,
+    size_t                   _arity,
+    size_t                   _arg
+)
+{
+    struct d_predicate_expr_node* new_nodes;
+    size_t                        new_capacity;
+    size_t                        span;
+    size_t                        index;
+    size_t                        i;
+
+    if ( (_expr->failed) ||
+         (_expr->pending < _arity) )
+    {
+        _expr->failed = true;
+
+        return false;
+    }
+
+    // grow if needed
+    if (_expr->node_count == _expr->node_capacity)
+    {
+        new_capacity = (_expr->node_capacity == 0)
+                       ? 8
+                       : (_expr->node_capacity * 2);
+        new_nodes    = d_functional_realloc(
+            _expr->nodes,
+            new_capacity * sizeof(struct d_predicate_expr_node));
+
+        if (!new_nodes)
+        {
+            _expr->failed = true;
+
+            return false;
+        }
+
+        _expr->nodes         = new_nodes;
+        _expr->node_capacity = new_capacity;
+    }
+
+    // the operands are the last _arity complete subtrees
+    span  = 1;
+    index = _expr->node_count;
+
+    for (i = 0; i < _arity; i++)
+    {
+        span  += _expr->nodes[index - 1].span;
+        index -= _expr->nodes[index - 1].span;
+    }
+
+    _expr->nodes[_expr->node_count].op    = _op;
+    _expr->nodes[_expr->node_count].arity = _arity;
+    _expr->nodes[_expr->node_count].arg   = _arg;
+    _expr->nodes[_expr->node_count].span  = span;
+    _expr->node_count++;
+    _expr->pending = _expr->pending - _arity + 1;
+
+    return true;
+}
+
+/*
+d_predicate_expr_leaf
+  Pushes a leaf predicate onto the builder's stack.
+
+Parameter(s):
+  _expr:      the builder.
+  _predicate: the predicate function.
+  _context:   context for the predicate; may be NULL.
+Return:
+  A boolean value corresponding to either:
+  - true, if the leaf was pushed, or
+  - false, if _expr or _predicate was NULL, the builder had already
+    failed, or allocation failed.
+*/
+bool
+d_predicate_expr_leaf
+(
+    struct d_predicate_expr* _expr,
+    fn_predicate             _predicate,
+    void*                    _context
+)
+{
+    struct d_predicate_leaf* new_leaves;
+    size_t                   new_capacity;
+
+    // validate parameters
+    if (!_expr)
+    {
+        return false;
+    }
+
+    if ( (_expr->failed) ||
+         (!_predicate) )
+    {
+        _expr->failed = true;
+
+        return false;
+    }
+
+    // grow if needed
+    if (_expr->leaf_count == _expr->leaf_capacity)
+    {
+        new_capacity = (_expr->leaf_capacity == 0)
+                       ? 8
+                       : (_expr->leaf_capacity * 2);
+        new_leaves   = d_functional_realloc(_expr->leaves,
+                                            new_capacity *
+                                            sizeof(struct d_predicate_leaf));
+
+        if (!new_leaves)
+        {
+            _expr->failed = true;
+
+            return false;
+        }
+
+        _expr->leaves        = new_leaves;
+        _expr->leaf_capacity = new_capacity;
+    }
+
+    if (!d_predicate_expr_push_node(_expr,
+                                    D_PREDICATE_EXPR_LEAF,
+                                    0,
+                                    _expr->leaf_count))
+    {
+        return false;
+    }
+
+    _expr->leaves[_expr->leaf_count].predicate = _predicate;
+    _expr->leaves[_expr->leaf_count].context   = _context;
+    _expr->leaf_count++;
+
+    return true;
+}
+
+/*
+d_predicate_expr_and
+  Replaces the top _arity subexpressions with their conjunction.
+
+Parameter(s):
+  _expr:  the builder.
+  _arity: number of subexpressions to combine; must be at least 1.
+Return:
+  A boolean value corresponding to either:
+  - true, if the conjunction was pushed, or
+  - false, if _expr was NULL, _arity was 0 or exceeded the number of
+    pending subexpressions, or allocation failed.
+*/
+bool
+d_predicate_expr_and
+(
+    struct d_predicate_expr* _expr,
+    size_t                   _arity
+)
+{
+    if (!_expr)
+    {
+        return false;
+    }
+
+    if (_arity == 0)
+    {
+        _expr->failed = true;
+
+        return false;
+    }
+
+    return d_predicate_expr_push_node(_expr,
+                                      D_PREDICATE_EXPR_AND,
+                                      _arity,
+                                      0);
+}
+
+/*
+d_predicate_expr_or
+  Replaces the top _arity subexpressions with their disjunction.
+
+Parameter(s):
+  _expr:  the builder.
+  _arity: number of subexpressions to combine; must be at least 1.
+Return:
+  A boolean value corresponding to either:
+  - true, if the disjunction was pushed, or
+  - false, if _expr was NULL, _arity was 0 or exceeded the number of
+    pending subexpressions, or allocation failed.
+*/
+bool
+d_predicate_expr_or
+(
+    struct d_predicate_expr* _expr,
+    size_t                   _arity
+)
+{
+    if (!_expr)
+    {
+        return false;
+    }
+
+    if (_arity == 0)
+    {
+        _expr->failed = true;
+
+        return false;
+    }
+
+    return d_predicate_expr_push_node(_expr,
+                                      D_PREDICATE_EXPR_OR,
+                                      _arity,
+                                      0);
+}
+
+/*
+d_predicate_expr_xor
+  Replaces the top _arity subexpressions with their exclusive or, which is
+true when an odd number of them are true. Every operand is evaluated.
+
+Parameter(s):
+  _expr:  the builder.
+  _arity: number of subexpressions to combine; must be at least 1.
+Return:
+  A boolean value corresponding to either:
+  - true, if the exclusive or was pushed, or
+  - false, if _expr was NULL, _arity was 0 or exceeded the number of
+    pending subexpressions, or allocation failed.
+*/
+bool
+d_predicate_expr_xor
+(
+    struct d_predicate_expr* _expr,
+    size_t                   _arity
+)
+{
+    if (!_expr)
+    {
+        return false;
+    }
+
+    if (_arity == 0)
+    {
+        _expr->failed = true;
+
+        return false;
+    }
+
+    return d_predicate_expr_push_node(_expr,
+                                      D_PREDICATE_EXPR_XOR,
+                                      _arity,
+                                      0);
+}
+
+/*
+d_predicate_expr_not
+  Replaces the top subexpression with its negation.
+
+Parameter(s):
+  _expr: the builder.
+Return:
+  A boolean value corresponding to either:
+  - true, if the negation was pushed, or
+  - false, if _expr was NULL, the stack was empty, or allocation failed.
+*/
+bool
+d_predicate_expr_not
+(
+    struct d_predicate_expr* _expr
+)
+{
+    if (!_expr)
+    {
+        return false;
+    }
+
+    return d_predicate_expr_push_node(_expr,
+                                      D_PREDICATE_EXPR_NOT,
+                                      1,
+                                      0);
+}
+
+/*
+d_predicate_expr_n_of
+  Replaces the top _arity subexpressions with a threshold test that is true
+when at least _n of them are true. Evaluation stops as soon as the outcome
+is decided.
+
+Parameter(s):
+  _expr:  the builder.
+  _n:     the number of operands that must be true.
+  _arity: number of subexpressions to combine; must be at least 1.
+Return:
+  A boolean value corresponding to either:
+  - true, if the threshold test was pushed, or
+  - false, if _expr was NULL, _arity was 0 or exceeded the number of
+    pending subexpressions, or allocation failed.
+*/
+bool
+d_predicate_expr_n_of
+(
+    struct d_predicate_expr* _expr,
+    size_t                   _n,
+    size_t                   _arity
+)
+{
+    if (!_expr)
+    {
+        return false;
+    }
+
+    if (_arity == 0)
+    {
+        _expr->failed = true;
+
+        return false;
+    }
+
+    return d_predicate_expr_push_node(_expr,
+                                      D_PREDICATE_EXPR_N_OF,
+                                      _arity,
+                                      _n);
+}
+
+/*
+d_predicate_expr_free
+  Frees a predicate expression builder. Does not free any leaf context.
+
+Parameter(s):
+  _expr: the builder to free; may be NULL.
+Return:
+  none.
+*/
+void
+d_predicate_expr_free
+(
+    struct d_predicate_expr* _expr
+)
+{
+    if (!_expr)
+    {
+        return;
+    }
+
+    if (_expr->nodes)
+    {
+        d_functional_free(_expr->nodes);
+    }
+
+    if (_expr->leaves)
+    {
+        d_functional_free(_expr->leaves);
+    }
+
+    d_functional_free(_expr);
+
+    return;
+}
+
+/*
+d_predicate_emit
+  Internal helper that appends one instruction (or only counts it while the
+emitter is measuring).
+
+Return:
+  The index of the instruction.
+*/
+static size_t
+d_predicate_emit
+(
+    struct d_predicate_emitter* _em,
+    enum d_predicate_opcode     _op,
+    bool                        _negate,
+    size_t                      _arg,
+    size_t                      _remain
+)
+{
+    struct d_predicate_instr* instr;
+
+    if (_em->code)
+    {
+        instr         = &_em->code[_em->count];
+        instr->op     = (uint16_t)_op;
+        instr->negate = (uint16_t)(_negate ? 1 : 0);
+        instr->arg    = (uint32_t)_arg;
+        instr->remain = (uint32_t)_remain;
+        instr->target = D_PREDICATE_TARGET_PENDING;
+    }
+
+    return _em->count++;
+}
+
+/*
+d_predicate_emit_patch
+  Internal helper that points every still-pending jump emitted since _start
+at the current end of the program. Jumps of nested groups are patched when
+those groups complete, so only the enclosing group's jumps remain pending.
+*/
+static void
+d_predicate_emit_patch
+(
+    struct d_predicate_emitter* _em,
+    size_t                      _start
+)
+{
+    size_t i;
+
+    if (!_em->code)
+    {
+        return;
+    }
+
+    for (i = _start; i < _em->count; i++)
+    {
+        if (_em->code[i].target == D_PREDICATE_TARGET_PENDING)
+        {
+            _em->code[i].target = (uint32_t)_em->count;
+        }
+    }
+
+    return;
+}
+
+/*
+d_predicate_emit_push_depth
+  Internal helper that tracks one more value on the evaluation stack.
+*/
+static void
+d_predicate_emit_push_depth
+(
+    struct d_predicate_emitter* _em
+)
+{
+    _em->depth++;
+
+    if (_em->depth > _em->max_depth)
+    {
+        _em->max_depth = _em->depth;
+    }
+
+    if (_em->depth > D_PREDICATE_EXPR_MAX_DEPTH)
+    {
+        _em->failed = true;
+    }
+
+    return;
+}
+
+/*
+d_predicate_resolve
+  Internal helper that strips NOT nodes from an operand, folding them into
+the operand's negation flag.
+*/
+static struct d_predicate_operand
+d_predicate_resolve
+(
+    const struct d_predicate_expr* _expr,
+    size_t                         _node,
+    bool                           _negate
+)
+{
+    struct d_predicate_operand operand;
+
+    while (_expr->nodes[_node].op == D_PREDICATE_EXPR_NOT)
+    {
+        _node   = _node - 1;
+        _negate = !_negate;
+    }
+
+    operand.node   = _node;
+    operand.negate = _negate;
+
+    return operand;
+}
+
+/*
+d_predicate_effective_op
+  Internal helper returning the operator a node behaves as once its
+negation has been pushed into its operands (De Morgan).
+*/
+static enum d_predicate_expr_op
+d_predicate_effective_op
+(
+    const struct d_predicate_expr* _expr,
+    struct d_predicate_operand     _operand
+)
+{
+    enum d_predicate_expr_op op;
+
+    op = _expr->nodes[_operand.node].op;
+
+    if (_operand.negate)
+    {
+        if (op == D_PREDICATE_EXPR_AND)
+        {
+            return D_PREDICATE_EXPR_OR;
+        }
+
+        if (op == D_PREDICATE_EXPR_OR)
+        {
+            return D_PREDICATE_EXPR_AND;
+        }
+    }
+
+    return op;
+}
+
+/*
+d_predicate_collect
+  Internal helper that pushes the operands of _parent onto the emitter's
+operand stack, last operand first. Operands that are themselves AND/OR
+nodes behaving as the same operator are flattened into the parent, so
+"a AND (b AND c)" compiles to a single three-way conjunction.
+*/
+static void
+d_predicate_collect
+(
+    struct d_predicate_emitter* _em,
+    struct d_predicate_operand  _parent,
+    bool                        _flatten
+)
+{
+    const struct d_predicate_expr* expr;
+    struct d_predicate_operand     child;
+    enum d_predicate_expr_op       parent_op;
+    size_t                         index;
+    size_t                         i;
+
+    expr      = _em->expr;
+    parent_op = d_predicate_effective_op(expr, _parent);
+    index     = _parent.node;
+
+    for (i = 0; i < expr->nodes[_parent.node].arity; i++)
+    {
+        child = d_predicate_resolve(expr, index - 1, _parent.negate);
+        index = index - expr->nodes[index - 1].span;
+
+        if ( (_flatten) &&
+             (d_predicate_effective_op(expr, child) == parent_op) )
+        {
+            d_predicate_collect(_em, child, true);
+        }
+        else
+        {
+            _em->operands[_em->operand_top++] = child;
+        }
+    }
+
+    return;
+}
+
+/*
+d_predicate_emit_node
+  Internal helper that compiles one (resolved) operand. The result of the
+operand is left in the program's register.
+*/
+static void
+d_predicate_emit_node
+(
+    struct d_predicate_emitter* _em,
+    struct d_predicate_operand  _operand
+)
+{
+    const struct d_predicate_expr_node* node;
+    struct d_predicate_operand          child;
+    enum d_predicate_expr_op            op;
+    size_t                              begin;
+    size_t                              end;
+    size_t                              start;
+    size_t                              i;
+    bool                                first_negate;
+
+    _operand = d_predicate_resolve(_em->expr, _operand.node, _operand.negate);
+    node     = &_em->expr->nodes[_operand.node];
+    op       = d_predicate_effective_op(_em->expr, _operand);
+
+    switch (op)
+    {
+    case D_PREDICATE_EXPR_LEAF:
+        d_predicate_emit(_em,
+                         D_PREDICATE_OPCODE_LEAF,
+                         _operand.negate,
+                         node->arg,
+                         0);
+
+        break;
+
+    case D_PREDICATE_EXPR_AND:
+    case D_PREDICATE_EXPR_OR:
+        begin = _em->operand_top;
+        d_predicate_collect(_em, _operand, true);
+        end   = _em->operand_top;
+        start = _em->count;
+
+        // operands were collected last-first; emit them first-last
+        for (i = end; i > begin; i--)
+        {
+            d_predicate_emit_node(_em, _em->operands[i - 1]);
+
+            if (i - 1 > begin)
+            {
+                d_predicate_emit(_em,
+                                 (op == D_PREDICATE_EXPR_AND)
+                                     ? D_PREDICATE_OPCODE_AND_SC
+                                     : D_PREDICATE_OPCODE_OR_SC,
+                                 false,
+                                 0,
+                                 0);
+            }
+        }
+
+        d_predicate_emit_patch(_em, start);
+        _em->operand_top = begin;
+
+        break;
+
+    case D_PREDICATE_EXPR_XOR:
+        begin = _em->operand_top;
+        child.node   = _operand.node;
+        child.negate = false;
+        d_predicate_collect(_em, child, false);
+        end   = _em->operand_top;
+
+        // !(a ^ b ^ ...) == (!a) ^ b ^ ...
+        first_negate = _operand.negate;
+
+        for (i = end; i > begin; i--)
+        {
+            child = _em->operands[i - 1];
+
+            if (i == end)
+            {
+                child.negate = (child.negate != first_negate);
+                d_predicate_emit_node(_em, child);
+
+                continue;
+            }
+
+            d_predicate_emit(_em, D_PREDICATE_OPCODE_PUSH, false, 0, 0);
+            d_predicate_emit_push_depth(_em);
+            d_predicate_emit_node(_em, child);
+            d_predicate_emit(_em, D_PREDICATE_OPCODE_XOR_POP, false, 0, 0);
+            _em->depth--;
+        }
+
+        _em->operand_top = begin;
+
+        break;
+
+    case D_PREDICATE_EXPR_N_OF:
+        // thresholds that are decided before evaluating anything
+        if ( (node->arg == 0) ||
+             (node->arg > node->arity) )
+        {
+            d_predicate_emit(_em,
+                             D_PREDICATE_OPCODE_CONST,
+                             false,
+                             ((node->arg == 0) != _operand.negate) ? 1 : 0,
+                             0);
+
+            break;
+        }
+
+        begin = _em->operand_top;
+        child.node   = _operand.node;
+        child.negate = false;
+        d_predicate_collect(_em, child, false);
+        end   = _em->operand_top;
+        start = _em->count;
+
+        d_predicate_emit(_em, D_PREDICATE_OPCODE_COUNT_BEGIN, false, 0, 0);
+        d_predicate_emit_push_depth(_em);
+
+        for (i = end; i > begin; i--)
+        {
+            d_predicate_emit_node(_em, _em->operands[i - 1]);
+            d_predicate_emit(_em,
+                             D_PREDICATE_OPCODE_COUNT_STEP,
+                             false,
+                             node->arg,
+                             i - 1 - begin);
+        }
+
+        // the last COUNT_STEP always decides and pops the counter
+        d_predicate_emit_patch(_em, start);
+        _em->depth--;
+        _em->operand_top = begin;
+
+        if (_operand.negate)
+        {
+            d_predicate_emit(_em, D_PREDICATE_OPCODE_NOT, false, 0, 0);
+        }
+
+        break;
+
+    default:
+        _em->failed = true;
+
+        break;
+    }
+
+    return;
+}
+
+/*
+d_predicate_expr_compile
+  Compiles a predicate expression into a flat d_predicate_program. The
+builder must hold exactly one complete subexpression.
+  During compilation NOT nodes are pushed down to the leaves (De Morgan),
+nested conjunctions and disjunctions are flattened, and N_OF thresholds
+that are decided up front become constants. The program, its leaf table
+and its instructions are placed in a single allocation, and the builder may
+be freed or reused afterwards.
+
+Parameter(s):
+  _expr: the builder to compile.
+Return:
+  A pointer to a newly allocated d_predicate_program, or NULL if _expr was
+NULL, any builder call had failed, the builder did not hold exactly one
+subexpression, the expression needed more than D_PREDICATE_EXPR_MAX_DEPTH
+stack slots, or allocation failed.
+*/
+struct d_predicate_program*
+d_predicate_expr_compile
+(
+    const struct d_predicate_expr* _expr
+)
+{
+    struct d_predicate_program* program;
+    struct d_predicate_emitter  em;
+    struct d_predicate_operand  root;
+    struct d_predicate_leaf*    leaves;
+    unsigned char*              block;
+
+    // validate parameters
+    if ( (!_expr)          ||
+         (_expr->failed)   ||
+         (_expr->pending != 1) )
+    {
+        return NULL;
+    }
+
+    em.expr        = _expr;
+    em.code        = NULL;
+    em.count       = 0;
+    em.depth       = 0;
+    em.max_depth   = 0;
+    em.operand_top = 0;
+    em.failed      = false;
+    em.operands    = d_functional_malloc(_expr->node_count *
+                                         sizeof(struct d_predicate_operand));
+
+    if (!em.operands)
+    {
+        return NULL;
+    }
+
+    root.node   = _expr->node_count - 1;
+    root.negate = false;
+
+    // first pass: measure the program
+    d_predicate_emit_node(&em, root);
+
+    if (em.failed)
+    {
+        d_functional_free(em.operands);
+
+        return NULL;
+    }
+
+    block = d_functional_malloc(
+        sizeof(struct d_predicate_program) +
+        (_expr->leaf_count * sizeof(struct d_predicate_leaf)) +
+        (em.count * sizeof(struct d_predicate_instr)));
+
+    // ensure that memory allocation was successful
+    if (!block)
+    {
+        d_functional_free(em.operands);
+
+        return NULL;
+    }
+
+    program = (struct d_predicate_program*)block;
+    leaves  = (struct d_predicate_leaf*)(block +
+                                         sizeof(struct d_predicate_program));
+    em.code = (struct d_predicate_instr*)(leaves + _expr->leaf_count);
+
+    if (_expr->leaf_count > 0)
+    {
+        memcpy(leaves,
+               _expr->leaves,
+               _expr->leaf_count * sizeof(struct d_predicate_leaf));
+    }
+
+    program->leaves     = leaves;
+    program->code       = em.code;
+    program->leaf_count = _expr->leaf_count;
+    program->code_count = em.count;
+    program->max_depth  = em.max_depth;
+
+    // second pass: emit the instructions
+    em.count = 0;
+    d_predicate_emit_node(&em, root);
+
+    d_functional_free(em.operands);
+
+    return program;
+}
+
+/*
+d_predicate_program_eval
+  Evaluates a compiled predicate program against an element. Conjunctions,
+disjunctions and N_OF thresholds stop evaluating leaves as soon as their
+result is decided.
+
+Parameter(s):
+  _program: the compiled program.
+  _element: pointer to the element to test.
+Return:
+  A boolean value corresponding to either:
+  - true, if the expression holds for the element, or
+  - false, if it does not or _program was NULL.
+*/
+bool
+d_predicate_program_eval
+(
+    const struct d_predicate_program* _program,
+    const void*                       _element
+)
+{
+    const struct d_predicate_instr* code;
+    const struct d_predicate_instr* instr;
+    const struct d_predicate_leaf*  leaf;
+    size_t                          stack[D_PREDICATE_EXPR_MAX_DEPTH];
+    size_t                          sp;
+    size_t                          pc;
+    bool                            r;
+
+    if (!_program)
+    {
+        return false;
+    }
+
+    code = _program->code;
+    sp   = 0;
+    pc   = 0;
+    r    = false;
+
+    while (pc < _program->code_count)
+    {
+        instr = &code[pc];
+
+        switch (instr->op)
+        {
+        case D_PREDICATE_OPCODE_CONST:
+            r = (instr->arg != 0);
+            pc++;
+
+            break;
+
+        case D_PREDICATE_OPCODE_LEAF:
+            leaf = &_program->leaves[instr->arg];
+            r    = (leaf->predicate(_element, leaf->context) != instr->negate);
+            pc++;
+
+            break;
+
+        case D_PREDICATE_OPCODE_NOT:
+            r = !r;
+            pc++;
+
+            break;
+
+        case D_PREDICATE_OPCODE_AND_SC:
+            pc = (r) ? (pc + 1) : instr->target;
+
+            break;
+
+        case D_PREDICATE_OPCODE_OR_SC:
+            pc = (r) ? instr->target : (pc + 1);
+
+            break;
+
+        case D_PREDICATE_OPCODE_PUSH:
+            stack[sp++] = (r) ? 1 : 0;
+            pc++;
+
+            break;
+
+        case D_PREDICATE_OPCODE_XOR_POP:
+            r = ((stack[--sp] != 0) != r);
+            pc++;
+
+            break;
+
+        case D_PREDICATE_OPCODE_COUNT_BEGIN:
+            stack[sp++] = 0;
+            pc++;
+
+            break;
+
+        case D_PREDICATE_OPCODE_COUNT_STEP:
+            if (r)
+            {
+                stack[sp - 1]++;
+            }
+
+            if (stack[sp - 1] >= instr->arg)
+            {
+                sp--;
+                r  = true;
+                pc = instr->target;
+            }
+            else if (stack[sp - 1] + instr->remain < instr->arg)
+            {
+                sp--;
+                r  = false;
+                pc = instr->target;
+            }
+            else
+            {
+                pc++;
+            }
+
+            break;
+
+        default:
+            return false;
+        }
+    }
+
+    return r;
+}
+
+/*
+d_predicate_program_test
+  fn_predicate adapter for a compiled predicate program, allowing it to be
+passed anywhere an fn_predicate is accepted.
+
+Parameter(s):
+  _element: pointer to the element to test.
+  _context: pointer to the d_predicate_program to evaluate.
+Return:
+  The result of d_predicate_program_eval(_context, _element).
+*/
+bool
+d_predicate_program_test
+(
+    const void* _element,
+    void*       _context
+)
+{
+    return d_predicate_program_eval(
+               (const struct d_predicate_program*)_context,
+               _element);
+}
+
+/*
+d_predicate_program_eval_array
+  Evaluates a compiled predicate program against every element of an array
+and records the results as a bitmask: bit (i % 64) of word (i / 64) is set
+when element i matches.
+
+Parameter(s):
+  _program:      the compiled program.
+  _input:        pointer to the input array.
+  _count:        number of elements in the input array.
+  _element_size: size of each element in bytes.
+  _bitmask:      destination of at least (_count + 63) / 64 words; every
+                 word covering the input is overwritten.
+Return:
+  The number of matching elements, or 0 if any parameter was NULL/zero.
+*/
+size_t
+d_predicate_program_eval_array
+(
+    const struct d_predicate_program* _program,
+    const void*                       _input,
+    size_t                            _count,
+    size_t                            _element_size,
+    uint64_t*                         _bitmask
+)
+{
+    const unsigned char* src;
+    uint64_t             word;
+    size_t               matches;
+    size_t               base;
+    size_t               n;
+    size_t               i;
+
+    // validate parameters
+    if ( (!_program)          ||
+         (!_input)            ||
+         (!_bitmask)          ||
+         (_count == 0)        ||
+         (_element_size == 0) )
+    {
+        return 0;
+    }
+
+    src     = (const unsigned char*)_input;
+    matches = 0;
+
+    // build one 64-bit word per 64 elements
+    for (base = 0; base < _count; base += 64)
+    {
+        n    = ((_count - base) < 64) ? (_count - base) : 64;
+        word = 0;
+
+        for (i = 0; i < n; i++)
+        {
+            if (d_predicate_program_eval(_program,
+                                         src + ((base + i) * _element_size)))
+            {
+                word |= ((uint64_t)1 << i);
+                matches++;
+            }
+        }
+
+        _bitmask[base / 64] = word;
+    }
+
+    return matches;
+}
+
+/*
+d_predicate_program_free
+  Frees a compiled predicate program. Does not free any leaf context.
+
+Parameter(s):
+  _program: the program to free; may be NULL.
+Return:
+  none.
+*/
+void
+d_predicate_program_free
+(
+    struct d_predicate_program* _program
+)
+{
+    // the header, leaves and code share one allocation
+    if (_program)
+    {
+        d_functional_free(_program);
+    }
+
+    return;
+}
+
+
+/*
+d_predicate_adaptive_new
+  Creates an adaptive AND/OR combinator over a set of leaves. Leaves are
+first evaluated in the given order; every `reorder_interval` evaluations
+they are reordered by observed cost and decisiveness.
+
+Parameter(s):
+  _mode:   D_PREDICATE_ADAPTIVE_AND or D_PREDICATE_ADAPTIVE_OR.
+  _leaves: the leaves to combine; copied into the combinator.
+  _count:  number of leaves; must be at least 1.
+Return:
+  A pointer to a newly allocated d_predicate_adaptive, or NULL if _leaves
+was NULL, _count was 0, any leaf predicate was NULL, _mode was invalid, or
+allocation failed.
+*/
+struct d_predicate_adaptive*
+d_predicate_adaptive_new
+(
+    enum d_predicate_adaptive_mode _mode,
+    const struct d_predicate_leaf* _leaves,
+    size_t                         _count
+)
+{
+    struct d_predicate_adaptive* adaptive;
+    unsigned char*               block;
+    size_t                       i;
+
+    // validate parameters
+    if ( (!_leaves)     ||
+         (_count == 0)  ||
+         ( (_mode != D_PREDICATE_ADAPTIVE_AND) &&
+           (_mode != D_PREDICATE_ADAPTIVE_OR) ) )
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < _count; i++)
+    {
+        if (!_leaves[i].predicate)
+        {
+            return NULL;
+        }
+    }
+
+    // header, leaves and published statistics share one allocation
+    block = d_functional_malloc(
+        sizeof(struct d_predicate_adaptive) +
+        (_count * sizeof(struct d_predicate_adaptive_leaf)) +
+        (_count * sizeof(struct d_predicate_adaptive_stats)));
+
+    // ensure that memory allocation was successful
+    if (!block)
+    {
+        return NULL;
+    }
+
+    adaptive            = (struct d_predicate_adaptive*)block;
+    adaptive->leaves    = (struct d_predicate_adaptive_leaf*)(
+                              block + sizeof(struct d_predicate_adaptive));
+    adaptive->published = (struct d_predicate_adaptive_stats*)(
+                              adaptive->leaves + _count);
+
+    if (!d_functional_mutex_init(&adaptive->lock))
+    {
+        d_functional_free(block);
+
+        return NULL;
+    }
+
+    adaptive->mode                  = _mode;
+    adaptive->count                 = _count;
+    adaptive->evaluations           = 0;
+    adaptive->reorder_interval      = D_PREDICATE_ADAPTIVE_REORDER_INTERVAL;
+    adaptive->next_reorder          = D_PREDICATE_ADAPTIVE_REORDER_INTERVAL;
+    adaptive->reorders              = 0;
+    adaptive->published_evaluations = 0;
+
+    for (i = 0; i < _count; i++)
+    {
+        adaptive->leaves[i].predicate     = _leaves[i].predicate;
+        adaptive->leaves[i].context       = _leaves[i].context;
+        adaptive->leaves[i].index         = i;
+        adaptive->leaves[i].calls         = 0;
+        adaptive->leaves[i].decisive      = 0;
+        adaptive->leaves[i].sampled_calls = 0;
+        adaptive->leaves[i].sampled_ticks = 0;
+
+        adaptive->published[i].index    = i;
+        adaptive->published[i].position = i;
+        adaptive->published[i].calls    = 0;
+        adaptive->published[i].decisive = 0;
+        adaptive->published[i].cost     = 0.0;
+        adaptive->published[i].rank     = 0.0;
+    }
+
+    return adaptive;
+}
+
+/*
+d_predicate_adaptive_rank
+  Internal helper computing a leaf's ordering key: expected cost paid per
+decision, i.e. mean cost divided by the probability that the leaf decides
+the result. The probability is Laplace-smoothed so that rarely evaluated
+leaves are neither starved nor over-trusted.
+*/
+static double
+d_predicate_adaptive_rank
+(
+    const struct d_predicate_adaptive_leaf* _leaf,
+    double*                                 _cost
+)
+{
+    double cost;
+    double rate;
+
+    cost = (_leaf->sampled_calls > 0)
+           ? ((double)_leaf->sampled_ticks / (double)_leaf->sampled_calls)
+           : 0.0;
+    rate = ((double)_leaf->decisive + 1.0) / ((double)_leaf->calls + 2.0);
+
+    if (_cost)
+    {
+        *_cost = cost;
+    }
+
+    return (cost + 1.0) / rate;
+}
+
+/*
+d_predicate_adaptive_reorder
+  Reorders the leaves of an adaptive combinator by ascending rank (cheapest
+per decision first), publishes the statistics for
+d_predicate_adaptive_snapshot, and halves the running counters. Called
+automatically during evaluation; may also be called directly.
+
+Parameter(s):
+  _adaptive: the adaptive combinator.
+Return:
+  none.
+*/
+void
+d_predicate_adaptive_reorder
+(
+    struct d_predicate_adaptive* _adaptive
+)
+{
+    struct d_predicate_adaptive_leaf  key;
+    struct d_predicate_adaptive_leaf* leaves;
+    struct d_predicate_adaptive_stats stats;
+    double                            key_rank;
+    size_t                            i;
+    size_t                            j;
+
+    if (!_adaptive)
+    {
+        return;
+    }
+
+    leaves = _adaptive->leaves;
+
+    // stable insertion sort by rank; leaf counts are small
+    for (i = 1; i < _adaptive->count; i++)
+    {
+        key      = leaves[i];
+        key_rank = d_predicate_adaptive_rank(&key, NULL);
+        j        = i;
+
+        while ( (j > 0) &&
+                (d_predicate_adaptive_rank(&leaves[j - 1], NULL) > key_rank) )
+        {
+            leaves[j] = leaves[j - 1];
+            j--;
+        }
+
+        leaves[j] = key;
+    }
+
+    // publish the statistics, indexed by the leaves' original positions
+    d_functional_mutex_lock(&_adaptive->lock);
+
+    for (i = 0; i < _adaptive->count; i++)
+    {
+        stats.index    = leaves[i].index;
+        stats.position = i;
+        stats.calls    = leaves[i].calls;
+        stats.decisive = leaves[i].decisive;
+        stats.rank     = d_predicate_adaptive_rank(&leaves[i], &stats.cost);
+
+        _adaptive->published[leaves[i].index] = stats;
+    }
+
+    _adaptive->published_evaluations = _adaptive->evaluations;
+
+    d_functional_mutex_unlock(&_adaptive->lock);
+
+    // age the counters so that the ordering tracks changes in the data
+    for (i = 0; i < _adaptive->count; i++)
+    {
+        leaves[i].calls         /= 2;
+        leaves[i].decisive      /= 2;
+        leaves[i].sampled_calls /= 2;
+        leaves[i].sampled_ticks /= 2;
+    }
+
+    _adaptive->reorders++;
+    _adaptive->next_reorder = _adaptive->evaluations +
+                              ( (_adaptive->reorder_interval > 0)
+                                ? _adaptive->reorder_interval
+                                : D_PREDICATE_ADAPTIVE_REORDER_INTERVAL );
+
+    return;
+}
+
+/*
+d_predicate_adaptive_eval
+  Evaluates an adaptive combinator against an element. Leaves run in their
+current order and evaluation stops at the first decisive leaf (false for
+AND, true for OR). Leaf costs are timed on a sample of calls only.
+
+Parameter(s):
+  _adaptive: the adaptive combinator.
+  _element:  pointer to the element to test.
+Return:
+  A boolean value corresponding to either:
+  - true, if the combined predicate holds for the element, or
+  - false, if it does not or _adaptive was NULL.
+*/
+bool
+d_predicate_adaptive_eval
+(
+    struct d_predicate_adaptive* _adaptive,
+    const void*                  _element
+)
+{
+    struct d_predicate_adaptive_leaf* leaf;
+    uint64_t                          start;
+    size_t                            i;
+    bool                              decisive_value;
+    bool                              value;
+    bool                              result;
+
+    if (!_adaptive)
+    {
+        return false;
+    }
+
+    // AND is decided by a false leaf, OR by a true one
+    decisive_value = (_adaptive->mode == D_PREDICATE_ADAPTIVE_OR);
+    result         = !decisive_value;
+
+    for (i = 0; i < _adaptive->count; i++)
+    {
+        leaf = &_adaptive->leaves[i];
+
+        if ((leaf->calls % D_PREDICATE_ADAPTIVE_SAMPLE_INTERVAL) == 0)
+        {
+            start = d_functional_ticks();
+            value = leaf->predicate(_element, leaf->context);
+
+            leaf->sampled_ticks += (d_functional_ticks() - start);
+            leaf->sampled_calls++;
+        }
+        else
+        {
+            value = leaf->predicate(_element, leaf->context);
+        }
+
+        leaf->calls++;
+
+        if (value == decisive_value)
+        {
+            leaf->decisive++;
+            result = decisive_value;
+
+            break;
+        }
+    }
+
+    _adaptive->evaluations++;
+
+    if (_adaptive->evaluations >= _adaptive->next_reorder)
+    {
+        d_predicate_adaptive_reorder(_adaptive);
+    }
+
+    return result;
+}
+
+/*
+d_predicate_adaptive_test
+  fn_predicate adapter for an adaptive combinator, allowing it to be passed
+anywhere an fn_predicate is accepted.
+
+Parameter(s):
+  _element: pointer to the element to test.
+  _context: pointer to the d_predicate_adaptive to evaluate.
+Return:
+  The result of d_predicate_adaptive_eval(_context, _element).
+*/
+bool
+d_predicate_adaptive_test
+(
+    const void* _element,
+    void*       _context
+)
+{
+    return d_predicate_adaptive_eval((struct d_predicate_adaptive*)_context,
+                                     _element);
+}
+
+/*
+d_predicate_adaptive_snapshot
+  Copies the statistics published at the most recent reorder. Safe to call
+from any thread, including while another thread is evaluating.
+
+Parameter(s):
+  _adaptive:    the adaptive combinator.
+  _stats:       destination array, indexed by the leaves' original
+                positions.
+  _capacity:    number of entries _stats can hold.
+  _evaluations: if non-NULL, receives the number of evaluations performed
+                when the statistics were published.
+Return:
+  The number of entries written, or 0 if _adaptive or _stats was NULL.
+*/
+size_t
+d_predicate_adaptive_snapshot
+(
+    struct d_predicate_adaptive*       _adaptive,
+    struct d_predicate_adaptive_stats* _stats,
+    size_t                             _capacity,
+    uint64_t*                          _evaluations
+)
+{
+    size_t count;
+
+    // validate parameters
+    if ( (!_adaptive) ||
+         (!_stats) )
+    {
+        return 0;
+    }
+
+    count = (_capacity < _adaptive->count) ? _capacity : _adaptive->count;
+
+    d_functional_mutex_lock(&_adaptive->lock);
+
+    if (count > 0)
+    {
+        memcpy(_stats,
+               _adaptive->published,
+               count * sizeof(struct d_predicate_adaptive_stats));
+    }
+
+    if (_evaluations)
+    {
+        *_evaluations = _adaptive->published_evaluations;
+    }
+
+    d_functional_mutex_unlock(&_adaptive->lock);
+
+    return count;
+}
+
+/*
+d_predicate_adaptive_free
+  Frees an adaptive combinator. Does not free any leaf context.
+
+Parameter(s):
+  _adaptive: the combinator to free; may be NULL.
+Return:
+  none.
+*/
+void
+d_predicate_adaptive_free
+(
+    struct d_predicate_adaptive* _adaptive
+)
+{
+    if (!_adaptive)
+    {
+        return;
+    }
+
+    d_functional_mutex_destroy(&_adaptive->lock);
+
+    // the header, leaves and statistics share one allocation
+    d_functional_free(_adaptive);
+
+    return;
+}
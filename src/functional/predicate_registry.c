@@ -0,0 +1,1833 @@
+#include "..\..\inc\functional\predicate_registry.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             I.    BUILT-IN FUNCTIONS                                    ///
+///////////////////////////////////////////////////////////////////////////////
+
+// D_REGISTRY_DEFINE_COMPARISONS
+//   macro: emits the built-in predicates (eq, ne, lt, le, gt, ge, between)
+// and comparators (asc, desc) for one element type. The one-parameter
+// predicates read a TYPE context; between reads a TYPE[2] of inclusive
+// bounds.
+#define D_REGISTRY_DEFINE_COMPARISONS(suffix, type)                         \
+    static bool                                                             \
+    d_registry_eq_##suffix(const void* _element, void* _context)            \
+    {                                                                       \
+        return (*(const type*)_element == *(const type*)_context);          \
+    }                                                                       \
+                                                                            \
+    static bool                                                             \
+    d_registry_ne_##suffix(const void* _element, void* _context)            \
+    {                                                                       \
+        return (*(const type*)_element != *(const type*)_context);          \
+    }                                                                       \
+                                                                            \
+    static bool                                                             \
+    d_registry_lt_##suffix(const void* _element, void* _context)            \
+    {                                                                       \
+        return (*(const type*)_element < *(const type*)_context);           \
+    }                                                                       \
+                                                                            \
+    static bool                                                             \
+    d_registry_le_##suffix(const void* _element, void* _context)            \
+    {                                                                       \
+        return (*(const type*)_element <= *(const type*)_context);          \
+    }                                                                       \
+                                                                            \
+    static bool                                                             \
+    d_registry_gt_##suffix(const void* _element, void* _context)            \
+    {                                                                       \
+        return (*(const type*)_element > *(const type*)_context);           \
+    }                                                                       \
+                                                                            \
+    static bool                                                             \
+    d_registry_ge_##suffix(const void* _element, void* _context)            \
+    {                                                                       \
+        return (*(const type*)_element >= *(const type*)_context);          \
+    }                                                                       \
+                                                                            \
+    static bool                                                             \
+    d_registry_between_##suffix(const void* _element, void* _context)       \
+    {                                                                       \
+        const type* bounds;                                                 \
+                                                                            \
+        bounds = (const type*)_context;                                     \
+                                                                            \
+        return (*(const type*)_element >= bounds[0]) &&                     \
+               (*(const type*)_element <= bounds[1]);                       \
+    }                                                                       \
+                                                                            \
+    static int                                                              \
+    d_registry_asc_##suffix(const void* _element1,                          \
+                            const void* _element2,                          \
+                            void*       _context)                           \
+    {                                                                       \
+        type a;                                                             \
+        type b;                                                             \
+                                                                            \
+        (void)_context;                                                     \
+        a = *(const type*)_element1;                                        \
+        b = *(const type*)_element2;                                        \
+                                                                            \
+        return (a > b) - (a < b);                                           \
+    }                                                                       \
+                                                                            \
+    static int                                                              \
+    d_registry_desc_##suffix(const void* _element1,                         \
+                             const void* _element2,                         \
+                             void*       _context)                          \
+    {                                                                       \
+        return d_registry_asc_##suffix(_element2, _element1, _context);     \
+    }
+
+// D_REGISTRY_DEFINE_PARITY
+//   macro: emits the built-in even / odd predicates for an integer type.
+#define D_REGISTRY_DEFINE_PARITY(suffix, type)                              \
+    static bool                                                             \
+    d_registry_even_##suffix(const void* _element, void* _context)          \
+    {                                                                       \
+        (void)_context;                                                     \
+                                                                            \
+        return ((*(const type*)_element % 2) == 0);                         \
+    }                                                                       \
+                                                                            \
+    static bool                                                             \
+    d_registry_odd_##suffix(const void* _element, void* _context)           \
+    {                                                                       \
+        (void)_context;                                                     \
+                                                                            \
+        return ((*(const type*)_element % 2) != 0);                         \
+    }
+
+D_REGISTRY_DEFINE_COMPARISONS(i32, int32_t)
+D_REGISTRY_DEFINE_COMPARISONS(i64, int64_t)
+D_REGISTRY_DEFINE_COMPARISONS(f64, double)
+D_REGISTRY_DEFINE_PARITY(i32, int32_t)
+D_REGISTRY_DEFINE_PARITY(i64, int64_t)
+
+// D_REGISTRY_ADD_COMPARISONS
+//   macro: registers the functions of D_REGISTRY_DEFINE_COMPARISONS for one
+// element type, clearing `ok` if any registration fails.
+#define D_REGISTRY_ADD_COMPARISONS(registry, suffix, param, ok)             \
+    do                                                                      \
+    {                                                                       \
+        enum d_registry_param types[2];                                     \
+                                                                            \
+        types[0] = (param);                                                 \
+        types[1] = (param);                                                 \
+                                                                            \
+        (ok) = d_predicate_registry_add_predicate((registry),               \
+                   "eq_" #suffix,                                           \
+                   d_registry_eq_##suffix, types, 1) && (ok);               \
+        (ok) = d_predicate_registry_add_predicate((registry),               \
+                   "ne_" #suffix,                                           \
+                   d_registry_ne_##suffix, types, 1) && (ok);               \
+        (ok) = d_predicate_registry_add_predicate((registry),               \
+                   "lt_" #suffix,                                           \
+                   d_registry_lt_##suffix, types, 1) && (ok);               \
+        (ok) = d_predicate_registry_add_predicate((registry),               \
+                   "le_" #suffix,                                           \
+                   d_registry_le_##suffix, types, 1) && (ok);               \
+        (ok) = d_predicate_registry_add_predicate((registry),               \
+                   "gt_" #suffix,                                           \
+                   d_registry_gt_##suffix, types, 1) && (ok);               \
+        (ok) = d_predicate_registry_add_predicate((registry),               \
+                   "ge_" #suffix,                                           \
+                   d_registry_ge_##suffix, types, 1) && (ok);               \
+        (ok) = d_predicate_registry_add_predicate((registry),               \
+                   "between_" #suffix,                                      \
+                   d_registry_between_##suffix, types, 2) && (ok);          \
+        (ok) = d_predicate_registry_add_comparator((registry),              \
+                   "asc_" #suffix,                                          \
+                   d_registry_asc_##suffix, NULL, 0) && (ok);               \
+        (ok) = d_predicate_registry_add_comparator((registry),              \
+                   "desc_" #suffix,                                         \
+                   d_registry_desc_##suffix, NULL, 0) && (ok);              \
+    } while (0)
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             II.   INTERNAL HELPERS                                      ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_registry_malloc
+  Internal helper: allocates a block for a registry; the global registry
+outlives any allocator, so it uses the C library directly.
+*/
+static void*
+d_registry_malloc
+(
+    const struct d_predicate_registry* _registry,
+    size_t                             _size
+)
+{
+    return (_registry->global) ? malloc(_size)
+                               : d_functional_malloc(_size);
+}
+
+/*
+d_registry_realloc
+  Internal helper: resizes a block of a registry, as d_registry_malloc.
+*/
+static void*
+d_registry_realloc
+(
+    const struct d_predicate_registry* _registry,
+    void*                              _block,
+    size_t                             _size
+)
+{
+    return (_registry->global) ? realloc(_block, _size)
+                               : d_functional_realloc(_block, _size);
+}
+
+/*
+d_registry_free
+  Internal helper: frees a block of a registry, as d_registry_malloc.
+*/
+static void
+d_registry_free
+(
+    const struct d_predicate_registry* _registry,
+    void*                              _block
+)
+{
+    if (_registry->global)
+    {
+        free(_block);
+    }
+    else
+    {
+        d_functional_free(_block);
+    }
+
+    return;
+}
+
+/*
+d_registry_param_size
+  Internal helper: size in bytes of a parameter type.
+*/
+static size_t
+d_registry_param_size
+(
+    enum d_registry_param _param
+)
+{
+    return (_param == D_REGISTRY_PARAM_I32) ? sizeof(int32_t)
+                                            : sizeof(int64_t);
+}
+
+/*
+d_registry_param_offset
+  Internal helper: offset of parameter _index in an entry's context, laid
+out like a C struct (each parameter aligned to its own size). With
+_index == param_count, gives the context size.
+*/
+static size_t
+d_registry_param_offset
+(
+    const struct d_registry_entry* _entry,
+    size_t                         _index
+)
+{
+    size_t offset;
+    size_t size;
+    size_t i;
+
+    offset = 0;
+
+    for (i = 0; i < _index; i++)
+    {
+        size   = d_registry_param_size(_entry->params[i]);
+        offset = ((offset + size - 1) / size) * size + size;
+    }
+
+    // align to the parameter, or pad the whole context to 8 bytes
+    size   = (_index < _entry->param_count)
+        ? d_registry_param_size(_entry->params[_index])
+        : 8;
+    offset = ((offset + size - 1) / size) * size;
+
+    return offset;
+}
+
+/*
+d_registry_name_is_valid
+  Internal helper: tests that a name is a non-empty identifier
+([A-Za-z_][A-Za-z0-9_]*) that fits in D_REGISTRY_MAX_NAME.
+*/
+static bool
+d_registry_name_is_valid
+(
+    const char* _name
+)
+{
+    size_t i;
+
+    if ( (!_name) ||
+         (_name[0] == '\0') ||
+         ( (_name[0] >= '0') && (_name[0] <= '9') ) )
+    {
+        return false;
+    }
+
+    for (i = 0; _name[i] != '\0'; i++)
+    {
+        if ( (i + 1 >= D_REGISTRY_MAX_NAME) ||
+             ( !( (_name[i] >= 'a' && _name[i] <= 'z') ||
+                  (_name[i] >= 'A' && _name[i] <= 'Z') ||
+                  (_name[i] >= '0' && _name[i] <= '9') ||
+                  (_name[i] == '_') ) ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+d_registry_find_entry
+  Internal helper: index of the entry of the given kind named by the first
+_name_length characters of _name, or (size_t)-1. The caller holds the lock.
+*/
+static size_t
+d_registry_find_entry
+(
+    const struct d_predicate_registry* _registry,
+    enum d_registry_kind               _kind,
+    const char*                        _name,
+    size_t                             _name_length
+)
+{
+    size_t i;
+
+    for (i = 0; i < _registry->entry_count; i++)
+    {
+        if ( (_registry->entries[i].kind == _kind)                      &&
+             (strncmp(_registry->entries[i].name,
+                      _name,
+                      _name_length) == 0)                               &&
+             (_registry->entries[i].name[_name_length] == '\0') )
+        {
+            return i;
+        }
+    }
+
+    return (size_t)-1;
+}
+
+/*
+d_registry_add
+  Internal helper: appends an entry. Names are unique across kinds.
+*/
+static bool
+d_registry_add
+(
+    struct d_predicate_registry* _registry,
+    const char*                  _name,
+    enum d_registry_kind         _kind,
+    fn_predicate                 _test,
+    fn_function_comparator       _compare,
+    const enum d_registry_param* _params,
+    size_t                       _param_count
+)
+{
+    struct d_registry_entry* entry;
+    struct d_registry_entry* grown;
+    size_t                   capacity;
+    size_t                   i;
+    bool                     ok;
+
+    // validate parameters
+    if ( (!_registry)                              ||
+         (!d_registry_name_is_valid(_name))         ||
+         (_param_count > D_REGISTRY_MAX_PARAMS)     ||
+         ( (_param_count > 0) && (!_params) ) )
+    {
+        return false;
+    }
+
+    for (i = 0; i < _param_count; i++)
+    {
+        if ( (_params[i] != D_REGISTRY_PARAM_I32) &&
+             (_params[i] != D_REGISTRY_PARAM_I64) &&
+             (_params[i] != D_REGISTRY_PARAM_F64) )
+        {
+            return false;
+        }
+    }
+
+    ok = false;
+
+    d_functional_mutex_lock(&_registry->lock);
+
+    if ( (d_registry_find_entry(_registry,
+                                D_REGISTRY_PREDICATE,
+                                _name,
+                                strlen(_name)) == (size_t)-1) &&
+         (d_registry_find_entry(_registry,
+                                D_REGISTRY_COMPARATOR,
+                                _name,
+                                strlen(_name)) == (size_t)-1) )
+    {
+        ok = true;
+
+        if (_registry->entry_count == _registry->entry_capacity)
+        {
+            capacity = (_registry->entry_capacity == 0)
+                ? 32
+                : (_registry->entry_capacity * 2);
+            grown    = d_registry_realloc(_registry,
+                               _registry->entries,
+                               capacity * sizeof(struct d_registry_entry));
+
+            // ensure that memory allocation was successful
+            if (!grown)
+            {
+                ok = false;
+            }
+            else
+            {
+                _registry->entries        = grown;
+                _registry->entry_capacity = capacity;
+            }
+        }
+    }
+
+    if (ok)
+    {
+        entry = &_registry->entries[_registry->entry_count];
+
+        memset(entry, 0, sizeof(*entry));
+        memcpy(entry->name, _name, strlen(_name) + 1);
+
+        entry->kind        = _kind;
+        entry->test        = _test;
+        entry->compare     = _compare;
+        entry->param_count = _param_count;
+        entry->id          = (uint32_t)_registry->entry_count;
+
+        for (i = 0; i < _param_count; i++)
+        {
+            entry->params[i] = _params[i];
+        }
+
+        entry->context_size = d_registry_param_offset(entry, _param_count);
+
+        _registry->entry_count++;
+    }
+
+    d_functional_mutex_unlock(&_registry->lock);
+
+    return ok;
+}
+
+/*
+d_registry_bind
+  Internal helper: converts arguments to an entry's parameter types and
+packs them into _context (entry->context_size bytes). Fails if the count
+differs, an integer is out of range for an i32 parameter, or a real is
+given for an integer parameter.
+*/
+static bool
+d_registry_bind
+(
+    const struct d_registry_entry* _entry,
+    const struct d_registry_arg*   _args,
+    size_t                         _arg_count,
+    unsigned char*                 _context
+)
+{
+    int32_t narrow;
+    int64_t wide;
+    double  real;
+    size_t  offset;
+    size_t  i;
+
+    if ( (_arg_count != _entry->param_count) ||
+         ( (_arg_count > 0) && (!_args) ) )
+    {
+        return false;
+    }
+
+    memset(_context, 0, _entry->context_size);
+
+    for (i = 0; i < _arg_count; i++)
+    {
+        offset = d_registry_param_offset(_entry, i);
+
+        switch (_entry->params[i])
+        {
+        case D_REGISTRY_PARAM_I32:
+            if ( (_args[i].is_real)               ||
+                 (_args[i].integer < INT32_MIN)    ||
+                 (_args[i].integer > INT32_MAX) )
+            {
+                return false;
+            }
+
+            narrow = (int32_t)_args[i].integer;
+            memcpy(_context + offset, &narrow, sizeof(narrow));
+
+            break;
+
+        case D_REGISTRY_PARAM_I64:
+            if (_args[i].is_real)
+            {
+                return false;
+            }
+
+            wide = _args[i].integer;
+            memcpy(_context + offset, &wide, sizeof(wide));
+
+            break;
+
+        default:
+            real = (_args[i].is_real) ? _args[i].real
+                                      : (double)_args[i].integer;
+            memcpy(_context + offset, &real, sizeof(real));
+
+            break;
+        }
+    }
+
+    return true;
+}
+
+/*
+d_registry_hash
+  Internal helper: FNV-1a hash of an entry index and its bound parameters.
+*/
+static size_t
+d_registry_hash
+(
+    size_t               _index,
+    const unsigned char* _bound,
+    size_t               _size
+)
+{
+    uint64_t hash;
+    size_t   i;
+
+    hash = 14695981039346656037ULL;
+
+    for (i = 0; i < sizeof(_index); i++)
+    {
+        hash = (hash ^ ((_index >> (i * 8)) & 0xFF)) * 1099511628211ULL;
+    }
+
+    for (i = 0; i < _size; i++)
+    {
+        hash = (hash ^ _bound[i]) * 1099511628211ULL;
+    }
+
+    return (size_t)hash;
+}
+
+/*
+d_registry_address_bucket
+  Internal helper: the bucket of `addresses` for a context address; the
+registry must have buckets.
+*/
+static size_t
+d_registry_address_bucket
+(
+    const struct d_predicate_registry* _registry,
+    const void*                        _context
+)
+{
+    uint64_t address;
+
+    // contexts are 8-byte aligned; mix the remaining bits
+    address = (uint64_t)(uintptr_t)_context >> 3;
+    address = address * 11400714819323198485ULL;
+
+    return (size_t)(address >> 32) & (_registry->bucket_count - 1);
+}
+
+/*
+d_registry_rehash
+  Internal helper: moves every instance into _bucket_count buckets (a
+power of two) of each index. The caller holds the lock.
+*/
+static bool
+d_registry_rehash
+(
+    struct d_predicate_registry* _registry,
+    size_t                       _bucket_count
+)
+{
+    struct d_registry_instance** instances;
+    struct d_registry_instance** addresses;
+    struct d_registry_instance*  instance;
+    struct d_registry_instance*  next;
+    size_t                       bucket;
+    size_t                       i;
+
+    instances = d_registry_malloc(_registry,
+                    _bucket_count * sizeof(struct d_registry_instance*));
+    addresses = d_registry_malloc(_registry,
+                    _bucket_count * sizeof(struct d_registry_instance*));
+
+    // ensure that memory allocation was successful
+    if ( (!instances) ||
+         (!addresses) )
+    {
+        d_registry_free(_registry, instances);
+        d_registry_free(_registry, addresses);
+
+        return false;
+    }
+
+    memset(instances, 0, _bucket_count * sizeof(*instances));
+    memset(addresses, 0, _bucket_count * sizeof(*addresses));
+
+    for (i = 0; i < _registry->bucket_count; i++)
+    {
+        for (instance = _registry->instances[i]; instance; instance = next)
+        {
+            next              = instance->next;
+            bucket            = instance->hash & (_bucket_count - 1);
+            instance->next    = instances[bucket];
+            instances[bucket] = instance;
+        }
+    }
+
+    d_registry_free(_registry, _registry->instances);
+    d_registry_free(_registry, _registry->addresses);
+
+    _registry->instances    = instances;
+    _registry->addresses    = addresses;
+    _registry->bucket_count = _bucket_count;
+
+    // the address index depends on the bucket count; rebuild it
+    for (i = 0; i < _bucket_count; i++)
+    {
+        for (instance = instances[i]; instance; instance = instance->next)
+        {
+            bucket                 = d_registry_address_bucket(_registry,
+                                         instance->context);
+            instance->next_address = addresses[bucket];
+            addresses[bucket]      = instance;
+        }
+    }
+
+    return true;
+}
+
+/*
+d_registry_find_instance
+  Internal helper: the instance whose context is _context, or NULL if the
+registry did not hand it out. The caller holds the lock.
+*/
+static struct d_registry_instance*
+d_registry_find_instance
+(
+    const struct d_predicate_registry* _registry,
+    const void*                        _context
+)
+{
+    struct d_registry_instance* instance;
+
+    if ( (!_context) ||
+         (_registry->bucket_count == 0) )
+    {
+        return NULL;
+    }
+
+    for (instance = _registry->addresses[
+                        d_registry_address_bucket(_registry, _context)];
+         instance;
+         instance = instance->next_address)
+    {
+        if (instance->context == _context)
+        {
+            return instance;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+d_registry_intern
+  Internal helper: binds arguments to the entry at _index and sets the
+interned context (NULL for entries without parameters), adding a reference
+to it. The caller holds the registry lock.
+*/
+static bool
+d_registry_intern
+(
+    struct d_predicate_registry* _registry,
+    size_t                       _index,
+    const struct d_registry_arg* _args,
+    size_t                       _arg_count,
+    void**                       _context
+)
+{
+    struct d_registry_instance*    instance;
+    const struct d_registry_entry* entry;
+    unsigned char                  bound[D_REGISTRY_MAX_PARAMS * 8];
+    size_t                         header;
+    size_t                         hash;
+    size_t                         bucket;
+
+    entry = &_registry->entries[_index];
+
+    if (!d_registry_bind(entry, _args, _arg_count, bound))
+    {
+        return false;
+    }
+
+    *_context = NULL;
+
+    if (entry->param_count == 0)
+    {
+        return true;
+    }
+
+    hash = d_registry_hash(_index, bound, entry->context_size);
+
+    // reuse an instance with the same parameters
+    if (_registry->bucket_count > 0)
+    {
+        for (instance = _registry->instances[
+                            hash & (_registry->bucket_count - 1)];
+             instance;
+             instance = instance->next)
+        {
+            if ( (instance->hash == hash)   &&
+                 (instance->entry == _index) &&
+                 (memcmp(instance->context,
+                         bound,
+                         entry->context_size) == 0) )
+            {
+                instance->references++;
+                *_context = instance->context;
+
+                return true;
+            }
+        }
+    }
+
+    // keep at most one instance per bucket on average
+    if ( (_registry->instance_count >= _registry->bucket_count) &&
+         (!d_registry_rehash(_registry,
+                             (_registry->bucket_count == 0)
+                                 ? 32
+                                 : (_registry->bucket_count * 2))) )
+    {
+        return false;
+    }
+
+    // the context follows the instance, 8-byte aligned
+    header   = (sizeof(struct d_registry_instance) + 7) & ~(size_t)7;
+    instance = d_registry_malloc(_registry, header + entry->context_size);
+
+    // ensure that memory allocation was successful
+    if (!instance)
+    {
+        return false;
+    }
+
+    instance->entry      = _index;
+    instance->hash       = hash;
+    instance->references = 1;
+    instance->context    = (unsigned char*)instance + header;
+    memcpy(instance->context, bound, entry->context_size);
+
+    bucket                       = hash & (_registry->bucket_count - 1);
+    instance->next               = _registry->instances[bucket];
+    _registry->instances[bucket] = instance;
+    bucket                       = d_registry_address_bucket(_registry,
+                                       instance->context);
+    instance->next_address       = _registry->addresses[bucket];
+    _registry->addresses[bucket] = instance;
+
+    _registry->instance_count++;
+    *_context = instance->context;
+
+    return true;
+}
+
+/*
+d_registry_unlink
+  Internal helper: removes an instance from both indexes and frees it. The
+caller holds the lock.
+*/
+static void
+d_registry_unlink
+(
+    struct d_predicate_registry* _registry,
+    struct d_registry_instance*  _instance
+)
+{
+    struct d_registry_instance** link;
+
+    link = &_registry->instances[_instance->hash &
+                                 (_registry->bucket_count - 1)];
+
+    while (*link != _instance)
+    {
+        link = &(*link)->next;
+    }
+
+    *link = _instance->next;
+    link  = &_registry->addresses[d_registry_address_bucket(
+                                      _registry,
+                                      _instance->context)];
+
+    while (*link != _instance)
+    {
+        link = &(*link)->next_address;
+    }
+
+    *link = _instance->next_address;
+
+    _registry->instance_count--;
+    d_registry_free(_registry, _instance);
+
+    return;
+}
+
+/*
+d_registry_resolve
+  Internal helper: binds arguments to the entry of the given kind named
+_name or, if _name is NULL, with the given id; copies the entry to _entry
+and sets the interned context.
+*/
+static bool
+d_registry_resolve
+(
+    struct d_predicate_registry* _registry,
+    enum d_registry_kind         _kind,
+    const char*                  _name,
+    size_t                       _name_length,
+    uint32_t                     _id,
+    const struct d_registry_arg* _args,
+    size_t                       _arg_count,
+    struct d_registry_entry*     _entry,
+    void**                       _context
+)
+{
+    size_t index;
+    bool   ok;
+
+    d_functional_mutex_lock(&_registry->lock);
+
+    if (_name)
+    {
+        index = d_registry_find_entry(_registry, _kind, _name, _name_length);
+    }
+    else
+    {
+        index = ( ((size_t)_id < _registry->entry_count) &&
+                  (_registry->entries[_id].kind == _kind) )
+            ? (size_t)_id
+            : (size_t)-1;
+    }
+
+    ok = (index != (size_t)-1);
+
+    if (ok)
+    {
+        *_entry = _registry->entries[index];
+        ok      = d_registry_intern(_registry,
+                                    index,
+                                    _args,
+                                    _arg_count,
+                                    _context);
+    }
+
+    d_functional_mutex_unlock(&_registry->lock);
+
+    return ok;
+}
+
+/*
+d_registry_lookup
+  Internal helper: finds the entry whose functions are _test and _compare
+(one of them NULL) and, if it has parameters, whose interned context is
+_context. The caller holds the registry lock.
+*/
+static const struct d_registry_entry*
+d_registry_lookup
+(
+    const struct d_predicate_registry* _registry,
+    fn_predicate                       _test,
+    fn_function_comparator             _compare,
+    const void*                        _context
+)
+{
+    const struct d_registry_instance* instance;
+    size_t                            i;
+
+    instance = d_registry_find_instance(_registry, _context);
+
+    for (i = 0; i < _registry->entry_count; i++)
+    {
+        if ( (_registry->entries[i].test != _test) ||
+             (_registry->entries[i].compare != _compare) )
+        {
+            continue;
+        }
+
+        // parameterless functions ignore their context
+        if ( (_registry->entries[i].param_count == 0) ||
+             ( (instance) && (instance->entry == i) ) )
+        {
+            return &_registry->entries[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*
+d_registry_unbind
+  Internal helper: the inverse of d_registry_bind; reads an entry's bound
+parameters from _context into _args (integers for integer parameters,
+reals for f64).
+*/
+static void
+d_registry_unbind
+(
+    const struct d_registry_entry* _entry,
+    const unsigned char*           _context,
+    struct d_registry_arg*         _args
+)
+{
+    int32_t narrow;
+    size_t  offset;
+    size_t  i;
+
+    for (i = 0; i < _entry->param_count; i++)
+    {
+        offset           = d_registry_param_offset(_entry, i);
+        _args[i].is_real = false;
+        _args[i].integer = 0;
+        _args[i].real    = 0.0;
+
+        switch (_entry->params[i])
+        {
+        case D_REGISTRY_PARAM_I32:
+            memcpy(&narrow, _context + offset, sizeof(narrow));
+            _args[i].integer = narrow;
+
+            break;
+
+        case D_REGISTRY_PARAM_I64:
+            memcpy(&_args[i].integer, _context + offset, sizeof(int64_t));
+
+            break;
+
+        default:
+            _args[i].is_real = true;
+            memcpy(&_args[i].real, _context + offset, sizeof(double));
+
+            break;
+        }
+    }
+
+    return;
+}
+
+/*
+d_registry_format
+  Internal helper: writes "name" or "name, arg, ..." for the entry found by
+d_registry_lookup. Returns the length of the full text (which may exceed
+_size - 1), or 0 if the pair was not produced by this registry.
+*/
+static size_t
+d_registry_format
+(
+    struct d_predicate_registry* _registry,
+    fn_predicate                 _test,
+    fn_function_comparator       _compare,
+    const void*                  _context,
+    char*                        _buffer,
+    size_t                       _size
+)
+{
+    const struct d_registry_entry* entry;
+    struct d_registry_arg          args[D_REGISTRY_MAX_PARAMS];
+    size_t                         length;
+    size_t                         i;
+    int                            written;
+
+    d_functional_mutex_lock(&_registry->lock);
+
+    entry = d_registry_lookup(_registry, _test, _compare, _context);
+
+    if (!entry)
+    {
+        d_functional_mutex_unlock(&_registry->lock);
+
+        return 0;
+    }
+
+    d_registry_unbind(entry, (const unsigned char*)_context, args);
+
+    written = snprintf(_buffer, _size, "%s", entry->name);
+    length  = (written > 0) ? (size_t)written : 0;
+
+    for (i = 0; i < entry->param_count; i++)
+    {
+        if (args[i].is_real)
+        {
+            written = snprintf((length < _size) ? _buffer + length : NULL,
+                               (length < _size) ? _size - length : 0,
+                               ", %.17g",
+                               args[i].real);
+        }
+        else
+        {
+            written = snprintf((length < _size) ? _buffer + length : NULL,
+                               (length < _size) ? _size - length : 0,
+                               ", %lld",
+                               (long long)args[i].integer);
+        }
+
+        length += (written > 0) ? (size_t)written : 0;
+    }
+
+    d_functional_mutex_unlock(&_registry->lock);
+
+    return length;
+}
+
+/*
+d_registry_identify
+  Internal helper: copies the entry found by d_registry_lookup to _entry
+and its bound parameters to _args.
+*/
+static bool
+d_registry_identify
+(
+    struct d_predicate_registry* _registry,
+    fn_predicate                 _test,
+    fn_function_comparator       _compare,
+    const void*                  _context,
+    struct d_registry_entry*     _entry,
+    struct d_registry_arg*       _args
+)
+{
+    const struct d_registry_entry* entry;
+
+    d_functional_mutex_lock(&_registry->lock);
+
+    entry = d_registry_lookup(_registry, _test, _compare, _context);
+
+    if (entry)
+    {
+        *_entry = *entry;
+        d_registry_unbind(entry, (const unsigned char*)_context, _args);
+    }
+
+    d_functional_mutex_unlock(&_registry->lock);
+
+    return (entry != NULL);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///             III.  REGISTRY CREATION                                     ///
+///////////////////////////////////////////////////////////////////////////////
+
+// d_registry_global_instance
+//   static: the global registry, created by d_registry_global_initialize.
+static struct d_predicate_registry* d_registry_global_instance = NULL;
+
+// d_registry_global_once
+//   static: guards the creation of the global registry.
+static d_functional_once d_registry_global_once = D_FUNCTIONAL_ONCE_INIT;
+
+/*
+d_registry_create
+  Internal helper: creates an empty registry, allocated with the C library
+if it is to be the global one and from the current allocator otherwise.
+*/
+static struct d_predicate_registry*
+d_registry_create
+(
+    bool _global
+)
+{
+    struct d_predicate_registry* registry;
+
+    registry = (_global) ? malloc(sizeof(struct d_predicate_registry))
+                         : d_functional_malloc(
+                               sizeof(struct d_predicate_registry));
+
+    // ensure that memory allocation was successful
+    if (!registry)
+    {
+        return NULL;
+    }
+
+    memset(registry, 0, sizeof(*registry));
+    registry->global = _global;
+
+    if (!d_functional_mutex_init(&registry->lock))
+    {
+        d_registry_free(registry, registry);
+
+        return NULL;
+    }
+
+    return registry;
+}
+
+/*
+d_predicate_registry_new
+  Creates an empty registry. Its memory comes from the current allocator
+(see allocator.h), under which it must also be freed.
+
+Parameter(s):
+  (none)
+Return:
+  A pointer to the registry, or NULL if allocation failed.
+*/
+struct d_predicate_registry*
+d_predicate_registry_new
+(
+    void
+)
+{
+    return d_registry_create(false);
+}
+
+/*
+d_registry_global_initialize
+  Internal helper: creates the global registry with the built-ins.
+*/
+static void
+d_registry_global_initialize
+(
+    void
+)
+{
+    struct d_predicate_registry* registry;
+
+    registry = d_registry_create(true);
+
+    if ( (registry) &&
+         (!d_predicate_registry_add_builtins(registry)) )
+    {
+        d_predicate_registry_free(registry);
+        registry = NULL;
+    }
+
+    d_registry_global_instance = registry;
+
+    return;
+}
+
+/*
+d_predicate_registry_global
+  Returns the process-wide registry used by the filter serializers, created
+with the built-ins on first use. Register application predicates here so
+that chains using them can be written and read. It lives until the process
+exits and must not be freed.
+
+Parameter(s):
+  (none)
+Return:
+  A pointer to the global registry, or NULL if it could not be created.
+*/
+struct d_predicate_registry*
+d_predicate_registry_global
+(
+    void
+)
+{
+    d_functional_once_run(&d_registry_global_once,
+                          d_registry_global_initialize);
+
+    return d_registry_global_instance;
+}
+
+/*
+d_predicate_registry_add_builtins
+  Registers the built-in functions:
+  - eq / ne / lt / le / gt / ge _i32, _i64, _f64: one parameter of the
+    element type, compared against the element
+  - between_i32, _i64, _f64: inclusive bounds lo, hi
+  - even_i32, odd_i32, even_i64, odd_i64: no parameters
+  - comparators asc_ / desc_ i32, i64, f64: no parameters
+
+Parameter(s):
+  _registry: the registry.
+Return:
+  true if all were registered, false if _registry is NULL, a name is
+already taken, or allocation failed.
+*/
+bool
+d_predicate_registry_add_builtins
+(
+    struct d_predicate_registry* _registry
+)
+{
+    bool ok;
+
+    // validate parameters
+    if (!_registry)
+    {
+        return false;
+    }
+
+    ok = true;
+
+    D_REGISTRY_ADD_COMPARISONS(_registry, i32, D_REGISTRY_PARAM_I32, ok);
+    D_REGISTRY_ADD_COMPARISONS(_registry, i64, D_REGISTRY_PARAM_I64, ok);
+    D_REGISTRY_ADD_COMPARISONS(_registry, f64, D_REGISTRY_PARAM_F64, ok);
+
+    ok = d_predicate_registry_add_predicate(_registry, "even_i32",
+             d_registry_even_i32, NULL, 0) && ok;
+    ok = d_predicate_registry_add_predicate(_registry, "odd_i32",
+             d_registry_odd_i32, NULL, 0) && ok;
+    ok = d_predicate_registry_add_predicate(_registry, "even_i64",
+             d_registry_even_i64, NULL, 0) && ok;
+    ok = d_predicate_registry_add_predicate(_registry, "odd_i64",
+             d_registry_odd_i64, NULL, 0) && ok;
+
+    return ok;
+}
+
+/*
+d_predicate_registry_free
+  Frees a registry and every context it handed out, whether or not it is
+still held. Must not be called on the global registry.
+
+Parameter(s):
+  _registry: the registry; may be NULL.
+Return:
+  none.
+*/
+void
+d_predicate_registry_free
+(
+    struct d_predicate_registry* _registry
+)
+{
+    struct d_registry_instance* instance;
+    struct d_registry_instance* next;
+    size_t                      i;
+
+    if (!_registry)
+    {
+        return;
+    }
+
+    for (i = 0; i < _registry->bucket_count; i++)
+    {
+        for (instance = _registry->instances[i]; instance; instance = next)
+        {
+            next = instance->next;
+            d_registry_free(_registry, instance);
+        }
+    }
+
+    d_registry_free(_registry, _registry->instances);
+    d_registry_free(_registry, _registry->addresses);
+    d_registry_free(_registry, _registry->entries);
+    d_functional_mutex_destroy(&_registry->lock);
+    d_registry_free(_registry, _registry);
+
+    return;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             IV.   REGISTRATION                                          ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_predicate_registry_add_predicate
+  Registers a predicate under a name. The predicate receives its bound
+parameters as its context, laid out like a struct of the parameter types
+(see d_registry_param).
+
+Parameter(s):
+  _registry:    the registry.
+  _name:        an identifier ([A-Za-z_][A-Za-z0-9_]*) shorter than
+                D_REGISTRY_MAX_NAME, not yet registered.
+  _test:        the predicate.
+  _params:      the parameter types; may be NULL when _param_count is 0.
+  _param_count: the number of parameters, at most D_REGISTRY_MAX_PARAMS.
+Return:
+  true if registered, false if a parameter is invalid, the name is taken,
+or allocation failed.
+*/
+bool
+d_predicate_registry_add_predicate
+(
+    struct d_predicate_registry* _registry,
+    const char*                  _name,
+    fn_predicate                 _test,
+    const enum d_registry_param* _params,
+    size_t                       _param_count
+)
+{
+    // validate parameters
+    if (!_test)
+    {
+        return false;
+    }
+
+    return d_registry_add(_registry,
+                          _name,
+                          D_REGISTRY_PREDICATE,
+                          _test,
+                          NULL,
+                          _params,
+                          _param_count);
+}
+
+/*
+d_predicate_registry_add_comparator
+  Registers a comparator under a name; see
+d_predicate_registry_add_predicate.
+
+Parameter(s):
+  _registry:    the registry.
+  _name:        an identifier, not yet registered.
+  _compare:     the comparator.
+  _params:      the parameter types; may be NULL when _param_count is 0.
+  _param_count: the number of parameters, at most D_REGISTRY_MAX_PARAMS.
+Return:
+  true if registered, false if a parameter is invalid, the name is taken,
+or allocation failed.
+*/
+bool
+d_predicate_registry_add_comparator
+(
+    struct d_predicate_registry* _registry,
+    const char*                  _name,
+    fn_function_comparator       _compare,
+    const enum d_registry_param* _params,
+    size_t                       _param_count
+)
+{
+    // validate parameters
+    if (!_compare)
+    {
+        return false;
+    }
+
+    return d_registry_add(_registry,
+                          _name,
+                          D_REGISTRY_COMPARATOR,
+                          NULL,
+                          _compare,
+                          _params,
+                          _param_count);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             V.    RESOLUTION                                            ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_predicate_registry_predicate
+  Resolves a predicate name and arguments. Identical names and arguments
+give the same context for as long as it is held. The caller holds a
+reference to the context and gives it back with
+d_predicate_registry_release; a filter operation built with the context
+takes the reference over.
+
+Parameter(s):
+  _registry:    the registry.
+  _name:        the name; need not be terminated.
+  _name_length: the number of characters of _name to match.
+  _args:        the arguments; may be NULL when _arg_count is 0.
+  _arg_count:   the number of arguments; must equal the parameter count.
+  _test:        receives the predicate.
+  _context:     receives the context (NULL if it has no parameters).
+Return:
+  true if resolved, false if the name is unknown, the arguments do not fit
+the parameters, or allocation failed.
+*/
+bool
+d_predicate_registry_predicate
+(
+    struct d_predicate_registry* _registry,
+    const char*                  _name,
+    size_t                       _name_length,
+    const struct d_registry_arg* _args,
+    size_t                       _arg_count,
+    fn_predicate*                _test,
+    void**                       _context
+)
+{
+    struct d_registry_entry entry;
+
+    // validate parameters
+    if ( (!_registry) ||
+         (!_name)     ||
+         (!_test)     ||
+         (!_context)  ||
+         (_name_length == 0) ||
+         (_name_length >= D_REGISTRY_MAX_NAME) )
+    {
+        return false;
+    }
+
+    if (!d_registry_resolve(_registry,
+                            D_REGISTRY_PREDICATE,
+                            _name,
+                            _name_length,
+                            0,
+                            _args,
+                            _arg_count,
+                            &entry,
+                            _context))
+    {
+        return false;
+    }
+
+    *_test = entry.test;
+
+    return true;
+}
+
+/*
+d_predicate_registry_comparator
+  Resolves a comparator name and arguments; see
+d_predicate_registry_predicate.
+
+Parameter(s):
+  _registry:    the registry.
+  _name:        the name; need not be terminated.
+  _name_length: the number of characters of _name to match.
+  _args:        the arguments; may be NULL when _arg_count is 0.
+  _arg_count:   the number of arguments; must equal the parameter count.
+  _compare:     receives the comparator.
+  _context:     receives the context (NULL if it has no parameters).
+Return:
+  true if resolved, false if the name is unknown, the arguments do not fit
+the parameters, or allocation failed.
+*/
+bool
+d_predicate_registry_comparator
+(
+    struct d_predicate_registry* _registry,
+    const char*                  _name,
+    size_t                       _name_length,
+    const struct d_registry_arg* _args,
+    size_t                       _arg_count,
+    fn_function_comparator*      _compare,
+    void**                       _context
+)
+{
+    struct d_registry_entry entry;
+
+    // validate parameters
+    if ( (!_registry) ||
+         (!_name)     ||
+         (!_compare)  ||
+         (!_context)  ||
+         (_name_length == 0) ||
+         (_name_length >= D_REGISTRY_MAX_NAME) )
+    {
+        return false;
+    }
+
+    if (!d_registry_resolve(_registry,
+                            D_REGISTRY_COMPARATOR,
+                            _name,
+                            _name_length,
+                            0,
+                            _args,
+                            _arg_count,
+                            &entry,
+                            _context))
+    {
+        return false;
+    }
+
+    *_compare = entry.compare;
+
+    return true;
+}
+
+/*
+d_predicate_registry_predicate_by_id
+  Resolves a predicate by its registration id (see
+d_predicate_registry_identify_predicate) rather than its name; used to read
+binary-encoded filter chains. The context is held as with
+d_predicate_registry_predicate.
+
+Parameter(s):
+  _registry:  the registry.
+  _id:        the id of a predicate entry.
+  _args:      the arguments; may be NULL when _arg_count is 0.
+  _arg_count: the number of arguments; must equal the parameter count.
+  _test:      receives the predicate.
+  _context:   receives the context (NULL if it has no parameters).
+Return:
+  true if resolved, false if no predicate has the id, the arguments do not
+fit the parameters, or allocation failed.
+*/
+bool
+d_predicate_registry_predicate_by_id
+(
+    struct d_predicate_registry* _registry,
+    uint32_t                     _id,
+    const struct d_registry_arg* _args,
+    size_t                       _arg_count,
+    fn_predicate*                _test,
+    void**                       _context
+)
+{
+    struct d_registry_entry entry;
+
+    // validate parameters
+    if ( (!_registry) ||
+         (!_test)     ||
+         (!_context) )
+    {
+        return false;
+    }
+
+    if (!d_registry_resolve(_registry,
+                            D_REGISTRY_PREDICATE,
+                            NULL,
+                            0,
+                            _id,
+                            _args,
+                            _arg_count,
+                            &entry,
+                            _context))
+    {
+        return false;
+    }
+
+    *_test = entry.test;
+
+    return true;
+}
+
+/*
+d_predicate_registry_comparator_by_id
+  Resolves a comparator by its registration id; see
+d_predicate_registry_predicate_by_id.
+
+Parameter(s):
+  _registry:  the registry.
+  _id:        the id of a comparator entry.
+  _args:      the arguments; may be NULL when _arg_count is 0.
+  _arg_count: the number of arguments; must equal the parameter count.
+  _compare:   receives the comparator.
+  _context:   receives the context (NULL if it has no parameters).
+Return:
+  true if resolved, false if no comparator has the id, the arguments do not
+fit the parameters, or allocation failed.
+*/
+bool
+d_predicate_registry_comparator_by_id
+(
+    struct d_predicate_registry* _registry,
+    uint32_t                     _id,
+    const struct d_registry_arg* _args,
+    size_t                       _arg_count,
+    fn_function_comparator*      _compare,
+    void**                       _context
+)
+{
+    struct d_registry_entry entry;
+
+    // validate parameters
+    if ( (!_registry) ||
+         (!_compare)  ||
+         (!_context) )
+    {
+        return false;
+    }
+
+    if (!d_registry_resolve(_registry,
+                            D_REGISTRY_COMPARATOR,
+                            NULL,
+                            0,
+                            _id,
+                            _args,
+                            _arg_count,
+                            &entry,
+                            _context))
+    {
+        return false;
+    }
+
+    *_compare = entry.compare;
+
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             VI.   FORMATTING                                            ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_predicate_registry_format_predicate
+  Writes the name and arguments of a predicate and context obtained from
+d_predicate_registry_predicate, as "name" or "name, arg, ...". Output is
+truncated to _size - 1 characters and always terminated.
+
+Parameter(s):
+  _registry: the registry.
+  _test:     the predicate.
+  _context:  its context.
+  _buffer:   the output; may be NULL when _size is 0.
+  _size:     the size of _buffer in bytes.
+Return:
+  The length of the full text, or 0 if the pair is not registered (for a
+predicate with parameters, if _context was not handed out by _registry).
+*/
+size_t
+d_predicate_registry_format_predicate
+(
+    struct d_predicate_registry* _registry,
+    fn_predicate                 _test,
+    const void*                  _context,
+    char*                        _buffer,
+    size_t                       _size
+)
+{
+    // validate parameters
+    if ( (!_registry) ||
+         (!_test)     ||
+         ( (!_buffer) && (_size > 0) ) )
+    {
+        return 0;
+    }
+
+    return d_registry_format(_registry,
+                             _test,
+                             NULL,
+                             _context,
+                             _buffer,
+                             _size);
+}
+
+/*
+d_predicate_registry_format_comparator
+  Writes the name and arguments of a comparator and context; see
+d_predicate_registry_format_predicate.
+
+Parameter(s):
+  _registry: the registry.
+  _compare:  the comparator.
+  _context:  its context.
+  _buffer:   the output; may be NULL when _size is 0.
+  _size:     the size of _buffer in bytes.
+Return:
+  The length of the full text, or 0 if the pair is not registered.
+*/
+size_t
+d_predicate_registry_format_comparator
+(
+    struct d_predicate_registry* _registry,
+    fn_function_comparator       _compare,
+    const void*                  _context,
+    char*                        _buffer,
+    size_t                       _size
+)
+{
+    // validate parameters
+    if ( (!_registry) ||
+         (!_compare)  ||
+         ( (!_buffer) && (_size > 0) ) )
+    {
+        return 0;
+    }
+
+    return d_registry_format(_registry,
+                             NULL,
+                             _compare,
+                             _context,
+                             _buffer,
+                             _size);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             VII.  IDENTIFICATION                                        ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_predicate_registry_identify_predicate
+  The structured counterpart of d_predicate_registry_format_predicate:
+copies the entry (name, id, parameter types) of a predicate and context
+obtained from the registry, and its bound arguments.
+
+Parameter(s):
+  _registry: the registry.
+  _test:     the predicate.
+  _context:  its context.
+  _entry:    receives a copy of the entry.
+  _args:     receives the arguments; room for D_REGISTRY_MAX_PARAMS.
+Return:
+  true if identified, false if the pair is not registered.
+*/
+bool
+d_predicate_registry_identify_predicate
+(
+    struct d_predicate_registry* _registry,
+    fn_predicate                 _test,
+    const void*                  _context,
+    struct d_registry_entry*     _entry,
+    struct d_registry_arg*       _args
+)
+{
+    // validate parameters
+    if ( (!_registry) ||
+         (!_test)     ||
+         (!_entry)    ||
+         (!_args) )
+    {
+        return false;
+    }
+
+    return d_registry_identify(_registry,
+                               _test,
+                               NULL,
+                               _context,
+                               _entry,
+                               _args);
+}
+
+/*
+d_predicate_registry_identify_comparator
+  Copies the entry and bound arguments of a comparator and context; see
+d_predicate_registry_identify_predicate.
+
+Parameter(s):
+  _registry: the registry.
+  _compare:  the comparator.
+  _context:  its context.
+  _entry:    receives a copy of the entry.
+  _args:     receives the arguments; room for D_REGISTRY_MAX_PARAMS.
+Return:
+  true if identified, false if the pair is not registered.
+*/
+bool
+d_predicate_registry_identify_comparator
+(
+    struct d_predicate_registry* _registry,
+    fn_function_comparator       _compare,
+    const void*                  _context,
+    struct d_registry_entry*     _entry,
+    struct d_registry_arg*       _args
+)
+{
+    // validate parameters
+    if ( (!_registry) ||
+         (!_compare)  ||
+         (!_entry)    ||
+         (!_args) )
+    {
+        return false;
+    }
+
+    return d_registry_identify(_registry,
+                               NULL,
+                               _compare,
+                               _context,
+                               _entry,
+                               _args);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             VIII. REFERENCES                                            ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_predicate_registry_retain
+  Adds a reference to a context handed out by the registry, for a second
+holder (e.g. a copied filter chain).
+
+Parameter(s):
+  _registry: the registry.
+  _context:  the context; may be NULL or not from _registry.
+Return:
+  true if a reference was added, false if _context was not handed out by
+_registry (there is then nothing to hold).
+*/
+bool
+d_predicate_registry_retain
+(
+    struct d_predicate_registry* _registry,
+    const void*                  _context
+)
+{
+    struct d_registry_instance* instance;
+
+    // validate parameters
+    if ( (!_registry) ||
+         (!_context) )
+    {
+        return false;
+    }
+
+    d_functional_mutex_lock(&_registry->lock);
+
+    instance = d_registry_find_instance(_registry, _context);
+
+    if (instance)
+    {
+        instance->references++;
+    }
+
+    d_functional_mutex_unlock(&_registry->lock);
+
+    return (instance != NULL);
+}
+
+/*
+d_predicate_registry_release
+  Gives back a reference to a context handed out by the registry; the
+context is freed with its last reference, and the same arguments then
+resolve to a new one. Contexts the registry did not hand out are ignored.
+
+Parameter(s):
+  _registry: the registry.
+  _context:  the context; may be NULL or not from _registry.
+Return:
+  none.
+*/
+void
+d_predicate_registry_release
+(
+    struct d_predicate_registry* _registry,
+    const void*                  _context
+)
+{
+    struct d_registry_instance* instance;
+
+    // validate parameters
+    if ( (!_registry) ||
+         (!_context) )
+    {
+        return;
+    }
+
+    d_functional_mutex_lock(&_registry->lock);
+
+    instance = d_registry_find_instance(_registry, _context);
+
+    if ( (instance) &&
+         (--instance->references == 0) )
+    {
+        d_registry_unlink(_registry, instance);
+    }
+
+    d_functional_mutex_unlock(&_registry->lock);
+
+    return;
+}
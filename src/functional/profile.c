@@ -0,0 +1,375 @@
+#include "..\..\inc\functional\profile.h"
+
+
+// d_profile_current
+//   static: the calling thread's innermost open session, or NULL.
+static D_FUNCTIONAL_THREAD_LOCAL struct d_profile* d_profile_current = NULL;
+
+// d_profile_hook, d_profile_hook_context
+//   static: the process-wide hook and its context.
+static fn_profile_hook d_profile_hook         = NULL;
+static void*           d_profile_hook_context = NULL;
+
+
+/*
+d_profile_begin
+  Opens a profiling session on the calling thread. Until the matching
+d_profile_end, the thread's instrumented operators append their records to
+_records; records beyond _capacity are counted as dropped. A session
+opened while another is open interrupts it until it ends.
+
+Parameter(s):
+  _profile:  the session to open.
+  _records:  storage for the records; may be NULL if _capacity is 0.
+  _capacity: number of records _records holds.
+Return:
+  none.
+*/
+void
+d_profile_begin
+(
+    struct d_profile*        _profile,
+    struct d_profile_record* _records,
+    size_t                   _capacity
+)
+{
+    // validate parameters
+    if (!_profile)
+    {
+        return;
+    }
+
+    _profile->records  = _records;
+    _profile->capacity = (_records) ? _capacity : 0;
+    _profile->count    = 0;
+    _profile->dropped  = 0;
+    _profile->outer    = d_profile_current;
+
+    d_profile_current = _profile;
+
+    return;
+}
+
+/*
+d_profile_end
+  Closes a session opened on the calling thread, resuming the one it
+interrupted. Its records stay readable. Sessions opened after _profile
+and still open are closed with it.
+
+Parameter(s):
+  _profile: the session to close.
+Return:
+  none.
+*/
+void
+d_profile_end
+(
+    struct d_profile* _profile
+)
+{
+    struct d_profile* session;
+
+    // validate parameters
+    if (!_profile)
+    {
+        return;
+    }
+
+    // only close a session that is open on this thread
+    for (session = d_profile_current; session; session = session->outer)
+    {
+        if (session == _profile)
+        {
+            d_profile_current = _profile->outer;
+
+            break;
+        }
+    }
+
+    _profile->outer = NULL;
+
+    return;
+}
+
+/*
+d_profile_set_hook
+  Sets the process-wide hook every record is passed to, on the thread that
+produced it. Set it before profiled operators run on other threads, and
+clear it once they are done; it is not synchronized.
+
+Parameter(s):
+  _hook:    the hook, or NULL to remove it.
+  _context: passed to _hook.
+Return:
+  none.
+*/
+void
+d_profile_set_hook
+(
+    fn_profile_hook _hook,
+    void*           _context
+)
+{
+    d_profile_hook         = _hook;
+    d_profile_hook_context = (_hook) ? _context : NULL;
+
+    return;
+}
+
+/*
+d_profile_start
+  Starts timing an operator.
+
+Parameter(s):
+  (none)
+Return:
+  The current d_functional_ticks, or 0 if the calling thread has no open
+session and no hook is set, in which case the operator need not be
+reported.
+*/
+uint64_t
+d_profile_start
+(
+    void
+)
+{
+    uint64_t ticks;
+
+    if ( (!d_profile_current) &&
+         (!d_profile_hook) )
+    {
+        return 0;
+    }
+
+    ticks = d_functional_ticks();
+
+    // 0 is reserved for "not profiling"
+    return (ticks) ? ticks : 1;
+}
+
+/*
+d_profile_stop
+  Finishes timing an operator started with d_profile_start and reports
+it. Does nothing if _start is 0.
+
+Parameter(s):
+  _start:           the value d_profile_start returned.
+  _source:          the module running the operator; a static string.
+  _operation:       the operator's name; a static string.
+  _index:           its position in its chain, or D_PROFILE_NO_INDEX.
+  _rows_in:         elements it received.
+  _rows_out:        elements it produced.
+  _bytes_allocated: bytes allocated for its result.
+  _predicate_calls: calls made to its predicate.
+Return:
+  none.
+*/
+void
+d_profile_stop
+(
+    uint64_t    _start,
+    const char* _source,
+    const char* _operation,
+    size_t      _index,
+    size_t      _rows_in,
+    size_t      _rows_out,
+    size_t      _bytes_allocated,
+    size_t      _predicate_calls
+)
+{
+    struct d_profile_record record;
+
+    if (_start == 0)
+    {
+        return;
+    }
+
+    record.elapsed_ticks   = d_functional_ticks() - _start;
+    record.source          = _source;
+    record.operation       = _operation;
+    record.index           = _index;
+    record.rows_in         = _rows_in;
+    record.rows_out        = _rows_out;
+    record.bytes_allocated = _bytes_allocated;
+    record.predicate_calls = _predicate_calls;
+
+    d_profile_emit(&record);
+
+    return;
+}
+
+/*
+d_profile_emit
+  Reports a complete record: appends it to the calling thread's innermost
+session, if any, and passes it to the hook, if set.
+
+Parameter(s):
+  _record: the record.
+Return:
+  none.
+*/
+void
+d_profile_emit
+(
+    const struct d_profile_record* _record
+)
+{
+    struct d_profile* session;
+
+    // validate parameters
+    if (!_record)
+    {
+        return;
+    }
+
+    session = d_profile_current;
+
+    if (session)
+    {
+        if (session->count < session->capacity)
+        {
+            session->records[session->count] = *_record;
+            session->count++;
+        }
+        else
+        {
+            session->dropped++;
+        }
+    }
+
+    if (d_profile_hook)
+    {
+        d_profile_hook(_record, d_profile_hook_context);
+    }
+
+    return;
+}
+
+/*
+d_profile_format_row
+  Writes one record as a report row:
+    <label> rows <in> -> <out>, ticks <t>, bytes <b>, predicate calls <c>
+the label padded to 32 characters.
+
+Parameter(s):
+  _buffer:   receives the row; may be NULL if _capacity is 0.
+  _capacity: size of _buffer in bytes.
+  _label:    the row's label; NULL for the record's source and operation.
+  _record:   the record.
+Return:
+  The length of the full row, as snprintf; negative if _record is NULL.
+*/
+int
+d_profile_format_row
+(
+    char*                          _buffer,
+    size_t                         _capacity,
+    const char*                    _label,
+    const struct d_profile_record* _record
+)
+{
+    char label[80];
+
+    // validate parameters
+    if (!_record)
+    {
+        return -1;
+    }
+
+    if (!_label)
+    {
+        if (_record->index == D_PROFILE_NO_INDEX)
+        {
+            snprintf(label, sizeof(label), "%s.%s",
+                     (_record->source) ? _record->source : "?",
+                     (_record->operation) ? _record->operation : "?");
+        }
+        else
+        {
+            snprintf(label, sizeof(label), "%s.%s #%lu",
+                     (_record->source) ? _record->source : "?",
+                     (_record->operation) ? _record->operation : "?",
+                     (unsigned long)_record->index);
+        }
+
+        _label = label;
+    }
+
+    return snprintf(_buffer, _capacity,
+                    "%-32s rows %lu -> %lu, ticks %llu, bytes %lu, "
+                    "predicate calls %lu",
+                    _label,
+                    (unsigned long)_record->rows_in,
+                    (unsigned long)_record->rows_out,
+                    (unsigned long long)_record->elapsed_ticks,
+                    (unsigned long)_record->bytes_allocated,
+                    (unsigned long)_record->predicate_calls);
+}
+
+/*
+d_profile_to_string
+  Formats a session's records, one row per line (see
+d_profile_format_row), after a line with the record count and the number
+dropped.
+
+Parameter(s):
+  _profile: the session.
+Return:
+  A newly allocated string the caller must free, or NULL if _profile is
+NULL or allocation failed.
+*/
+char*
+d_profile_to_string
+(
+    const struct d_profile* _profile
+)
+{
+    char*  text;
+    size_t capacity;
+    size_t length;
+    size_t i;
+    int    written;
+
+    // validate parameters
+    if (!_profile)
+    {
+        return NULL;
+    }
+
+    capacity = (_profile->count + 1) * D_PROFILE_ROW_MAX;
+    text     = d_functional_malloc(capacity);
+
+    // ensure that memory allocation was successful
+    if (!text)
+    {
+        return NULL;
+    }
+
+    written = snprintf(text, capacity, "profile: %lu records, %lu dropped\n",
+                       (unsigned long)_profile->count,
+                       (unsigned long)_profile->dropped);
+    length  = (written > 0) ? (size_t)written : 0;
+
+    for (i = 0; (i < _profile->count) && (length < capacity); i++)
+    {
+        written = d_profile_format_row(text + length,
+                                       capacity - length,
+                                       NULL,
+                                       &_profile->records[i]);
+
+        if (written < 0)
+        {
+            break;
+        }
+
+        length += (size_t)written;
+
+        if (length + 1 < capacity)
+        {
+            text[length++] = '\n';
+            text[length]   = '\0';
+        }
+    }
+
+    return text;
+}
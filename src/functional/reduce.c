@@ -0,0 +1,621 @@
+#include "..\..\inc\functional\reduce.h"
+
+
+// maximum depth of the binary-counter stack used by the serial tree
+// reduction; enough for any count representable in a size_t
+#define D_REDUCE_TREE_LEVELS (sizeof(size_t) * 8)
+
+
+/*
+d_reduce_task
+  Internal description of one chunk of a parallel reduction. Exactly one of
+step (fold) or reducer (tree reduction) is set.
+*/
+struct d_reduce_task
+{
+    const unsigned char*           input;
+    size_t                         count;
+    size_t                         element_size;
+    void*                          state;
+    fn_accumulator                 step;
+    fn_reducer                     reducer;
+    void*                          context;
+    struct d_functional_allocator* allocator;  // the caller's current one
+    bool                           success;
+};
+
+
+/*
+d_reduce_tree_serial
+  Internal helper reducing _count elements in a balanced tree on the calling
+thread. Elements are pushed onto a binary-counter stack: level k holds the
+reduction of 2^k adjacent elements, and pushing into an occupied level
+combines the two and carries upward. Higher levels always hold earlier
+elements, so the final fold from the lowest level upward keeps the original
+left-to-right order.
+*/
+static bool
+d_reduce_tree_serial
+(
+    const unsigned char* _input,
+    size_t               _count,
+    size_t               _element_size,
+    void*                _result,
+    fn_reducer           _reducer,
+    void*                _context
+)
+{
+    unsigned char* scratch;
+    unsigned char* levels;
+    unsigned char* carry;
+    unsigned char* temp;
+    bool           occupied[D_REDUCE_TREE_LEVELS];
+    bool           have_result;
+    size_t         i;
+    size_t         level;
+
+    if (_count == 1)
+    {
+        memcpy(_result, _input, _element_size);
+
+        return true;
+    }
+
+    scratch = d_functional_malloc((D_REDUCE_TREE_LEVELS + 2) * _element_size);
+
+    // ensure that memory allocation was successful
+    if (!scratch)
+    {
+        return false;
+    }
+
+    levels = scratch;
+    carry  = scratch + (D_REDUCE_TREE_LEVELS * _element_size);
+    temp   = carry + _element_size;
+
+    memset(occupied, 0, sizeof(occupied));
+
+    for (i = 0; i < _count; i++)
+    {
+        memcpy(carry, _input + (i * _element_size), _element_size);
+        level = 0;
+
+        // carry upward while the level already holds an earlier subtree
+        while (occupied[level])
+        {
+            if (!_reducer(levels + (level * _element_size),
+                          carry,
+                          temp,
+                          _context))
+            {
+                d_functional_free(scratch);
+
+                return false;
+            }
+
+            memcpy(carry, temp, _element_size);
+            occupied[level] = false;
+            level++;
+        }
+
+        memcpy(levels + (level * _element_size), carry, _element_size);
+        occupied[level] = true;
+    }
+
+    // fold the remaining subtrees, latest (lowest level) first
+    have_result = false;
+
+    for (level = 0; level < D_REDUCE_TREE_LEVELS; level++)
+    {
+        if (!occupied[level])
+        {
+            continue;
+        }
+
+        if (!have_result)
+        {
+            memcpy(carry, levels + (level * _element_size), _element_size);
+            have_result = true;
+
+            continue;
+        }
+
+        if (!_reducer(levels + (level * _element_size),
+                      carry,
+                      temp,
+                      _context))
+        {
+            d_functional_free(scratch);
+
+            return false;
+        }
+
+        memcpy(carry, temp, _element_size);
+    }
+
+    memcpy(_result, carry, _element_size);
+    d_functional_free(scratch);
+
+    return true;
+}
+
+/*
+d_reduce_task_run
+  Internal fn_callback running one d_reduce_task; used as a thread entry
+point and for chunks processed on the calling thread. The task allocates
+from the caller's allocator on whichever thread it runs.
+*/
+static void
+d_reduce_task_run
+(
+    void* _task
+)
+{
+    struct d_reduce_task*          task;
+    struct d_functional_allocator* previous;
+
+    task     = (struct d_reduce_task*)_task;
+    previous = d_functional_allocator_push(task->allocator);
+
+    if (task->step)
+    {
+        task->success = d_functional_fold_left(task->input,
+                                               task->count,
+                                               task->element_size,
+                                               task->state,
+                                               task->step,
+                                               task->context);
+    }
+    else
+    {
+        task->success = d_reduce_tree_serial(task->input,
+                                             task->count,
+                                             task->element_size,
+                                             task->state,
+                                             task->reducer,
+                                             task->context);
+    }
+
+    d_functional_allocator_pop(previous);
+
+    return;
+}
+
+/*
+d_reduce_task_count
+  Internal helper choosing how many chunks to split _count elements into.
+*/
+static size_t
+d_reduce_task_count
+(
+    size_t _count,
+    size_t _threads
+)
+{
+    size_t by_size;
+
+    if (_threads == 0)
+    {
+        _threads = d_functional_cpu_count();
+    }
+
+    if (_threads > D_FUNCTIONAL_MAX_THREADS)
+    {
+        _threads = D_FUNCTIONAL_MAX_THREADS;
+    }
+
+    by_size = (_count + D_FUNCTIONAL_PARALLEL_MIN_CHUNK - 1) /
+              D_FUNCTIONAL_PARALLEL_MIN_CHUNK;
+
+    if (by_size < _threads)
+    {
+        _threads = by_size;
+    }
+
+    return (_threads > 0) ? _threads : 1;
+}
+
+/*
+d_reduce_run_tasks
+  Internal helper running _task_count tasks: task 0 on the calling thread and
+the others on worker threads. A task whose thread cannot be started runs on
+the calling thread instead.
+*/
+static bool
+d_reduce_run_tasks
+(
+    struct d_reduce_task* _tasks,
+    size_t                _task_count
+)
+{
+    d_functional_thread threads[D_FUNCTIONAL_MAX_THREADS];
+    bool                started[D_FUNCTIONAL_MAX_THREADS];
+    bool                success;
+    size_t              i;
+
+    for (i = 1; i < _task_count; i++)
+    {
+        started[i] = d_functional_thread_start(&threads[i],
+                                               d_reduce_task_run,
+                                               &_tasks[i]);
+
+        if (!started[i])
+        {
+            d_reduce_task_run(&_tasks[i]);
+        }
+    }
+
+    d_reduce_task_run(&_tasks[0]);
+
+    success = _tasks[0].success;
+
+    for (i = 1; i < _task_count; i++)
+    {
+        if (started[i])
+        {
+            d_functional_thread_join(threads[i]);
+        }
+
+        success = _tasks[i].success && success;
+    }
+
+    return success;
+}
+
+/*
+d_reduce_split
+  Internal helper dividing _count elements into _task_count contiguous
+chunks whose sizes differ by at most one. Every chunk records the calling
+thread's current allocator.
+*/
+static void
+d_reduce_split
+(
+    struct d_reduce_task* _tasks,
+    size_t                _task_count,
+    const unsigned char*  _input,
+    size_t                _count,
+    size_t                _element_size
+)
+{
+    struct d_functional_allocator* allocator;
+    size_t                         base;
+    size_t                         remainder;
+    size_t                         offset;
+    size_t                         i;
+
+    allocator = d_functional_allocator_current();
+    base      = _count / _task_count;
+    remainder = _count % _task_count;
+    offset    = 0;
+
+    for (i = 0; i < _task_count; i++)
+    {
+        _tasks[i].input        = _input + (offset * _element_size);
+        _tasks[i].count        = base + ((i < remainder) ? 1 : 0);
+        _tasks[i].element_size = _element_size;
+        _tasks[i].allocator    = allocator;
+        _tasks[i].success      = false;
+
+        offset += _tasks[i].count;
+    }
+
+    return;
+}
+
+/*
+d_functional_fold_parallel
+  Folds an array across several threads. The input is split into contiguous
+chunks; each chunk is folded with _step into its own partial state, which
+starts as a copy of _identity. The partial states are then combined in a
+balanced pairwise tree with _merge (partial i absorbs partial i + width for
+width = 1, 2, 4, ...), and the combined state is finally merged into
+_accumulator.
+  _step and _merge are called concurrently from different threads and must
+only touch the state they are given and data that is not shared mutably
+through _context. _merge must be associative; partial states are always
+combined in input order, so it need not be commutative.
+
+Parameter(s):
+  _input:        pointer to the input array.
+  _count:        number of elements in the input array.
+  _element_size: size of each element in bytes.
+  _accumulator:  accumulated state; serves as both the initial value and the
+                 destination for the result.
+  _state_size:   size of the accumulated state in bytes.
+  _identity:     state each partial fold starts from (e.g. 0 for a sum); it
+                 must be neutral for _merge.
+  _step:         accumulator folding one element into a state.
+  _merge:        combiner merging a second partial state into the first.
+  _context:      context forwarded to _step and _merge; may be NULL.
+  _threads:      maximum number of threads to use; 0 uses one per processor.
+Return:
+  A boolean value corresponding to either:
+  - true, if all parameters were valid and every step and merge succeeded,
+    or
+  - false, if any parameter was NULL/zero, memory could not be allocated, or
+    any step or merge failed; _accumulator is left unchanged in that case.
+*/
+bool
+d_functional_fold_parallel
+(
+    const void*    _input,
+    size_t         _count,
+    size_t         _element_size,
+    void*          _accumulator,
+    size_t         _state_size,
+    const void*    _identity,
+    fn_accumulator _step,
+    fn_combiner    _merge,
+    void*          _context,
+    size_t         _threads
+)
+{
+    struct d_reduce_task  tasks[D_FUNCTIONAL_MAX_THREADS];
+    unsigned char*        partials;
+    size_t                task_count;
+    size_t                width;
+    size_t                i;
+    bool                  success;
+
+    // validate parameters
+    if ( (!_input)            ||
+         (!_accumulator)      ||
+         (!_identity)         ||
+         (!_step)             ||
+         (!_merge)            ||
+         (_count == 0)        ||
+         (_element_size == 0) ||
+         (_state_size == 0) )
+    {
+        return false;
+    }
+
+    task_count = d_reduce_task_count(_count, _threads);
+    partials   = d_functional_malloc(task_count * _state_size);
+
+    // ensure that memory allocation was successful
+    if (!partials)
+    {
+        return false;
+    }
+
+    d_reduce_split(tasks,
+                   task_count,
+                   (const unsigned char*)_input,
+                   _count,
+                   _element_size);
+
+    for (i = 0; i < task_count; i++)
+    {
+        memcpy(partials + (i * _state_size), _identity, _state_size);
+
+        tasks[i].state   = partials + (i * _state_size);
+        tasks[i].step    = _step;
+        tasks[i].reducer = NULL;
+        tasks[i].context = _context;
+    }
+
+    success = d_reduce_run_tasks(tasks, task_count);
+
+    // balanced pairwise combination of the partial states
+    for (width = 1; (success) && (width < task_count); width *= 2)
+    {
+        for (i = 0; (success) && (i + width < task_count); i += 2 * width)
+        {
+            success = _merge(partials + (i * _state_size),
+                             partials + ((i + width) * _state_size),
+                             _context);
+        }
+    }
+
+    if (success)
+    {
+        success = _merge(_accumulator, partials, _context);
+    }
+
+    d_functional_free(partials);
+
+    return success;
+}
+
+/*
+d_functional_reduce_tree
+  Reduces an array to a single element by combining elements pairwise in a
+balanced tree. Each thread reduces a contiguous chunk, and the per-thread
+results are combined in a second balanced tree. Element order is preserved:
+_reducer is always called with the earlier value as _element1.
+  The worker threads allocate from the calling thread's current allocator,
+which must then be shared (see d_functional_allocator_init).
+
+Parameter(s):
+  _input:        pointer to the input array.
+  _count:        number of elements in the input array.
+  _element_size: size of each element (and of the result) in bytes.
+  _result:       destination for the reduced element.
+  _reducer:      associative reducer combining two elements.
+  _context:      context forwarded to _reducer; may be NULL.
+  _threads:      maximum number of threads to use; 0 uses one per processor.
+Return:
+  A boolean value corresponding to either:
+  - true, if all parameters were valid and every reduction succeeded, or
+  - false, if any parameter was NULL/zero, memory could not be allocated, or
+    any reduction failed.
+*/
+bool
+d_functional_reduce_tree
+(
+    const void* _input,
+    size_t      _count,
+    size_t      _element_size,
+    void*       _result,
+    fn_reducer  _reducer,
+    void*       _context,
+    size_t      _threads
+)
+{
+    struct d_reduce_task  tasks[D_FUNCTIONAL_MAX_THREADS];
+    unsigned char*        partials;
+    size_t                task_count;
+    size_t                i;
+    bool                  success;
+
+    // validate parameters
+    if ( (!_input)            ||
+         (!_result)           ||
+         (!_reducer)          ||
+         (_count == 0)        ||
+         (_element_size == 0) )
+    {
+        return false;
+    }
+
+    task_count = d_reduce_task_count(_count, _threads);
+
+    // a single chunk needs no partial buffer
+    if (task_count == 1)
+    {
+        return d_reduce_tree_serial((const unsigned char*)_input,
+                                    _count,
+                                    _element_size,
+                                    _result,
+                                    _reducer,
+                                    _context);
+    }
+
+    partials = d_functional_malloc(task_count * _element_size);
+
+    // ensure that memory allocation was successful
+    if (!partials)
+    {
+        return false;
+    }
+
+    d_reduce_split(tasks,
+                   task_count,
+                   (const unsigned char*)_input,
+                   _count,
+                   _element_size);
+
+    for (i = 0; i < task_count; i++)
+    {
+        tasks[i].state   = partials + (i * _element_size);
+        tasks[i].step    = NULL;
+        tasks[i].reducer = _reducer;
+        tasks[i].context = _context;
+    }
+
+    success = d_reduce_run_tasks(tasks, task_count);
+
+    // the per-thread results form a second, small tree
+    if (success)
+    {
+        success = d_reduce_tree_serial(partials,
+                                       task_count,
+                                       _element_size,
+                                       _result,
+                                       _reducer,
+                                       _context);
+    }
+
+    d_functional_free(partials);
+
+    return success;
+}
+
+/*
+d_functional_fold_multi
+  Folds an array into several accumulators in a single pass over memory. The
+input is processed in blocks of about D_FUNCTIONAL_FOLD_MULTI_BLOCK_BYTES;
+each accumulator consumes a whole block before the next one starts, so the
+block is read from main memory once and then served from cache. Every
+accumulator sees every element exactly once, in input order, so the result
+of each spec equals that of a separate d_functional_fold_left.
+
+Parameter(s):
+  _input:        pointer to the input array.
+  _count:        number of elements in the input array.
+  _element_size: size of each element in bytes.
+  _specs:        array of aggregates to compute; each accumulator holds its
+                 initial value and receives its result.
+  _spec_count:   number of entries in _specs.
+Return:
+  A boolean value corresponding to either:
+  - true, if all parameters were valid and every accumulation succeeded, or
+  - false, if any parameter was NULL/zero, any spec lacked an accumulator or
+    step function, or any accumulation failed; accumulators may then hold
+    partial results.
+*/
+bool
+d_functional_fold_multi
+(
+    const void*               _input,
+    size_t                    _count,
+    size_t                    _element_size,
+    const struct d_fold_spec* _specs,
+    size_t                    _spec_count
+)
+{
+    const unsigned char* src;
+    const unsigned char* block;
+    size_t               block_count;
+    size_t               length;
+    size_t               start;
+    size_t               s;
+    size_t               i;
+
+    // validate parameters
+    if ( (!_input)            ||
+         (!_specs)            ||
+         (_count == 0)        ||
+         (_element_size == 0) ||
+         (_spec_count == 0) )
+    {
+        return false;
+    }
+
+    for (s = 0; s < _spec_count; s++)
+    {
+        if ( (!_specs[s].accumulator) ||
+             (!_specs[s].step) )
+        {
+            return false;
+        }
+    }
+
+    src         = (const unsigned char*)_input;
+    block_count = D_FUNCTIONAL_FOLD_MULTI_BLOCK_BYTES / _element_size;
+
+    if (block_count == 0)
+    {
+        block_count = 1;
+    }
+
+    for (start = 0; start < _count; start += block_count)
+    {
+        length = _count - start;
+
+        if (length > block_count)
+        {
+            length = block_count;
+        }
+
+        block = src + (start * _element_size);
+
+        // each accumulator sweeps the cached block in turn
+        for (s = 0; s < _spec_count; s++)
+        {
+            for (i = 0; i < length; i++)
+            {
+                if (!_specs[s].step(_specs[s].accumulator,
+                                    block + (i * _element_size),
+                                    _specs[s].context))
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,707 @@
+#include "..\..\inc\functional\scan.h"
+
+
+// SIMD selection: the SSE2 value kernels are compiled only when the target
+// guarantees the instruction set, so no runtime dispatch is needed
+#if !defined(D_FUNCTIONAL_NO_SIMD)
+    #if ( defined(__SSE2__) || defined(_M_X64) ||                          \
+          ( defined(_M_IX86_FP) && (_M_IX86_FP >= 2) ) )
+        #define D_SCAN_SSE2 1
+    #endif
+#endif
+
+#if defined(D_SCAN_SSE2)
+    #include <emmintrin.h>
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             I.    BIT HELPERS                                           ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_scan_lowest_bit
+  Internal helper returning the index of the lowest set bit of a non-zero
+word.
+*/
+static size_t
+d_scan_lowest_bit
+(
+    uint64_t _word
+)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_ctzll(_word);
+#else
+    size_t bit;
+
+    bit = 0;
+
+    while (!(_word & 1))
+    {
+        _word >>= 1;
+        bit++;
+    }
+
+    return bit;
+#endif
+}
+
+/*
+d_scan_highest_bit
+  Internal helper returning the index of the highest set bit of a non-zero
+word.
+*/
+static size_t
+d_scan_highest_bit
+(
+    uint64_t _word
+)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)(63 - __builtin_clzll(_word));
+#else
+    size_t bit;
+
+    bit = 63;
+
+    while (!(_word & ((uint64_t)1 << 63)))
+    {
+        _word <<= 1;
+        bit--;
+    }
+
+    return bit;
+#endif
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             II.   PREDICATE PROGRAM BATCHES                             ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_scan_program
+  Internal search for a compiled predicate program, evaluating 64 elements
+per d_predicate_program_eval_array call, from the front or the back.
+Returns the index of the first (or last) match, or (size_t)-1.
+*/
+static size_t
+d_scan_program
+(
+    const struct d_predicate_program* _program,
+    const unsigned char*              _input,
+    size_t                            _count,
+    size_t                            _element_size,
+    bool                              _reverse
+)
+{
+    uint64_t word;
+    size_t   blocks;
+    size_t   block;
+    size_t   base;
+    size_t   n;
+    size_t   i;
+
+    blocks = (_count + 63) / 64;
+
+    for (i = 0; i < blocks; i++)
+    {
+        block = (_reverse) ? (blocks - 1 - i) : i;
+        base  = block * 64;
+        n     = ((_count - base) < 64) ? (_count - base) : 64;
+        word  = 0;
+
+        if (d_predicate_program_eval_array(_program,
+                                           _input + (base * _element_size),
+                                           n,
+                                           _element_size,
+                                           &word) == 0)
+        {
+            continue;
+        }
+
+        return base + ( (_reverse) ? d_scan_highest_bit(word)
+                                   : d_scan_lowest_bit(word) );
+    }
+
+    return (size_t)-1;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             III.  VALUE KERNELS                                         ///
+///////////////////////////////////////////////////////////////////////////////
+
+// D_SCAN_VALUE_KERNEL
+//   internal macro: defines a static scalar search over elements
+// [_first, _last) of TYPE for a value, front to back or back to front.
+// Elements are loaded with memcpy, so the input need not be aligned.
+#define D_SCAN_VALUE_KERNEL(name,                                           \
+                            type)                                           \
+    static size_t                                                           \
+    name                                                                    \
+    (                                                                       \
+        const unsigned char* _input,                                        \
+        size_t               _first,                                        \
+        size_t               _last,                                         \
+        const void*          _value,                                        \
+        bool                 _reverse                                       \
+    )                                                                       \
+    {                                                                       \
+        type   needle;                                                      \
+        type   element;                                                     \
+        size_t i;                                                           \
+                                                                            \
+        memcpy(&needle, _value, sizeof(type));                              \
+                                                                            \
+        if (_reverse)                                                       \
+        {                                                                   \
+            for (i = _last; i > _first; i--)                                \
+            {                                                               \
+                memcpy(&element,                                            \
+                       _input + ((i - 1) * sizeof(type)),                   \
+                       sizeof(type));                                       \
+                                                                            \
+                if (element == needle)                                      \
+                {                                                           \
+                    return i - 1;                                           \
+                }                                                           \
+            }                                                               \
+        }                                                                   \
+        else                                                                \
+        {                                                                   \
+            for (i = _first; i < _last; i++)                                \
+            {                                                               \
+                memcpy(&element,                                            \
+                       _input + (i * sizeof(type)),                         \
+                       sizeof(type));                                       \
+                                                                            \
+                if (element == needle)                                      \
+                {                                                           \
+                    return i;                                               \
+                }                                                           \
+            }                                                               \
+        }                                                                   \
+                                                                            \
+        return (size_t)-1;                                                  \
+    }
+
+D_SCAN_VALUE_KERNEL(d_scan_value_u8,  uint8_t)
+D_SCAN_VALUE_KERNEL(d_scan_value_u16, uint16_t)
+D_SCAN_VALUE_KERNEL(d_scan_value_u32, uint32_t)
+D_SCAN_VALUE_KERNEL(d_scan_value_u64, uint64_t)
+
+/*
+d_scan_value_scalar
+  Internal helper dispatching a scalar search over elements [_first, _last)
+to the typed kernel for the element size, or to a memcmp loop for other
+sizes.
+*/
+static size_t
+d_scan_value_scalar
+(
+    const unsigned char* _input,
+    size_t               _first,
+    size_t               _last,
+    size_t               _element_size,
+    const void*          _value,
+    bool                 _reverse
+)
+{
+    size_t i;
+
+    switch (_element_size)
+    {
+        case 1:
+            return d_scan_value_u8(_input, _first, _last, _value, _reverse);
+        case 2:
+            return d_scan_value_u16(_input, _first, _last, _value, _reverse);
+        case 4:
+            return d_scan_value_u32(_input, _first, _last, _value, _reverse);
+        case 8:
+            return d_scan_value_u64(_input, _first, _last, _value, _reverse);
+        default:
+            break;
+    }
+
+    for (i = 0; i < (_last - _first); i++)
+    {
+        size_t index;
+
+        index = (_reverse) ? (_last - 1 - i) : (_first + i);
+
+        if (memcmp(_input + (index * _element_size),
+                   _value,
+                   _element_size) == 0)
+        {
+            return index;
+        }
+    }
+
+    return (size_t)-1;
+}
+
+#if defined(D_SCAN_SSE2)
+
+/*
+d_scan_sse2_mask
+  Internal helper comparing 16 bytes at _at against the broadcast needle.
+Returns a byte mask in which all bytes of every equal element are set.
+SSE2 has no 64-bit compare, so 8-byte lanes require both 32-bit halves to
+be equal.
+*/
+static uint64_t
+d_scan_sse2_mask
+(
+    const unsigned char* _at,
+    __m128i              _needle,
+    size_t               _element_size
+)
+{
+    __m128i block;
+    __m128i equal;
+
+    block = _mm_loadu_si128((const __m128i*)_at);
+
+    switch (_element_size)
+    {
+        case 1:
+            equal = _mm_cmpeq_epi8(block, _needle);
+            break;
+        case 2:
+            equal = _mm_cmpeq_epi16(block, _needle);
+            break;
+        case 4:
+            equal = _mm_cmpeq_epi32(block, _needle);
+            break;
+        default:
+            equal = _mm_cmpeq_epi32(block, _needle);
+            equal = _mm_and_si128(equal,
+                                  _mm_shuffle_epi32(equal,
+                                                    _MM_SHUFFLE(2, 3, 0, 1)));
+            break;
+    }
+
+    return (uint64_t)(unsigned int)_mm_movemask_epi8(equal);
+}
+
+/*
+d_scan_sse2_chunk
+  Internal helper building the 64-bit byte mask of the 64-byte chunk at
+_at.
+*/
+static uint64_t
+d_scan_sse2_chunk
+(
+    const unsigned char* _at,
+    __m128i              _needle,
+    size_t               _element_size
+)
+{
+    return d_scan_sse2_mask(_at,      _needle, _element_size)         |
+           (d_scan_sse2_mask(_at + 16, _needle, _element_size) << 16) |
+           (d_scan_sse2_mask(_at + 32, _needle, _element_size) << 32) |
+           (d_scan_sse2_mask(_at + 48, _needle, _element_size) << 48);
+}
+
+/*
+d_scan_value_sse2
+  Internal SSE2 search for 1-, 2-, 4-, or 8-byte elements. The vector
+region (a whole number of 16-byte blocks, so element boundaries line up
+with block boundaries) is compared a 64-byte chunk at a time, then a block
+at a time; the remaining elements go to the scalar kernel.
+*/
+static size_t
+d_scan_value_sse2
+(
+    const unsigned char* _input,
+    size_t               _count,
+    size_t               _element_size,
+    const void*          _value,
+    bool                 _reverse
+)
+{
+    unsigned char pattern[16];
+    __m128i       needle;
+    uint64_t      mask;
+    size_t        vector_bytes;
+    size_t        offset;
+    size_t        i;
+
+    for (i = 0; i < 16; i += _element_size)
+    {
+        memcpy(pattern + i, _value, _element_size);
+    }
+
+    needle       = _mm_loadu_si128((const __m128i*)pattern);
+    vector_bytes = (_count * _element_size) & ~(size_t)15;
+
+    if (!_reverse)
+    {
+        for (offset = 0; offset + 64 <= vector_bytes; offset += 64)
+        {
+            mask = d_scan_sse2_chunk(_input + offset, needle, _element_size);
+
+            if (mask)
+            {
+                return (offset + d_scan_lowest_bit(mask)) / _element_size;
+            }
+        }
+
+        for (; offset < vector_bytes; offset += 16)
+        {
+            mask = d_scan_sse2_mask(_input + offset, needle, _element_size);
+
+            if (mask)
+            {
+                return (offset + d_scan_lowest_bit(mask)) / _element_size;
+            }
+        }
+
+        return d_scan_value_scalar(_input,
+                                   vector_bytes / _element_size,
+                                   _count,
+                                   _element_size,
+                                   _value,
+                                   false);
+    }
+
+    // the elements past the vector region are the last ones
+    i = d_scan_value_scalar(_input,
+                            vector_bytes / _element_size,
+                            _count,
+                            _element_size,
+                            _value,
+                            true);
+
+    if (i != (size_t)-1)
+    {
+        return i;
+    }
+
+    for (offset = vector_bytes; offset >= 64; offset -= 64)
+    {
+        mask = d_scan_sse2_chunk(_input + offset - 64, needle, _element_size);
+
+        if (mask)
+        {
+            return (offset - 64 + d_scan_highest_bit(mask)) / _element_size;
+        }
+    }
+
+    for (; offset > 0; offset -= 16)
+    {
+        mask = d_scan_sse2_mask(_input + offset - 16, needle, _element_size);
+
+        if (mask)
+        {
+            return (offset - 16 + d_scan_highest_bit(mask)) / _element_size;
+        }
+    }
+
+    return (size_t)-1;
+}
+
+#endif  // D_SCAN_SSE2
+
+/*
+d_scan_value
+  Internal helper dispatching a value search to the SSE2 kernel when it
+applies, and to the scalar kernels otherwise.
+*/
+static size_t
+d_scan_value
+(
+    const void* _input,
+    size_t      _count,
+    size_t      _element_size,
+    const void* _value,
+    bool        _reverse
+)
+{
+    const unsigned char* src;
+
+    src = (const unsigned char*)_input;
+
+    // memchr is usually already vectorized by the C library
+    if ( (_element_size == 1) &&
+         (!_reverse) )
+    {
+        const unsigned char* found;
+
+        found = (const unsigned char*)memchr(src,
+                                             *(const unsigned char*)_value,
+                                             _count);
+
+        return (found) ? (size_t)(found - src) : (size_t)-1;
+    }
+
+#if defined(D_SCAN_SSE2)
+    if ( (_element_size == 1) ||
+         (_element_size == 2) ||
+         (_element_size == 4) ||
+         (_element_size == 8) )
+    {
+        return d_scan_value_sse2(src,
+                                 _count,
+                                 _element_size,
+                                 _value,
+                                 _reverse);
+    }
+#endif
+
+    return d_scan_value_scalar(src,
+                               0,
+                               _count,
+                               _element_size,
+                               _value,
+                               _reverse);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             IV.   PREDICATE SEARCHES                                    ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_functional_index_of_context
+  Finds the first element of an array satisfying a predicate called with a
+context.
+
+Parameter(s):
+  _input:        pointer to the array.
+  _count:        number of elements in the array.
+  _element_size: size of each element in bytes.
+  _test:         the predicate to satisfy.
+  _context:      context forwarded to _test; may be NULL.
+Return:
+  The index of the first matching element, or (size_t)-1 if there is none
+or a parameter was NULL/zero.
+*/
+size_t
+d_functional_index_of_context
+(
+    const void*  _input,
+    size_t       _count,
+    size_t       _element_size,
+    fn_predicate _test,
+    void*        _context
+)
+{
+    const unsigned char* src;
+    const unsigned char* end;
+
+    // validate parameters
+    if ( (!_input)     ||
+         (!_test)      ||
+         (_count == 0) ||
+         (_element_size == 0) )
+    {
+        return (size_t)-1;
+    }
+
+    src = (const unsigned char*)_input;
+
+    if ( (_test == d_predicate_program_test) &&
+         (_context) )
+    {
+        return d_scan_program((const struct d_predicate_program*)_context,
+                              src,
+                              _count,
+                              _element_size,
+                              false);
+    }
+
+    end = src + (_count * _element_size);
+
+    for (; src != end; src += _element_size)
+    {
+        if (_test(src, _context))
+        {
+            return (size_t)(src - (const unsigned char*)_input) /
+                   _element_size;
+        }
+    }
+
+    return (size_t)-1;
+}
+
+/*
+d_functional_find_last_context
+  Finds the last element of an array satisfying a predicate called with a
+context, scanning from the end.
+
+Parameter(s):
+  _input:        pointer to the array.
+  _count:        number of elements in the array.
+  _element_size: size of each element in bytes.
+  _test:         the predicate to satisfy.
+  _context:      context forwarded to _test; may be NULL.
+Return:
+  A pointer to the last matching element, or NULL if there is none or a
+parameter was NULL/zero.
+*/
+void*
+d_functional_find_last_context
+(
+    const void*  _input,
+    size_t       _count,
+    size_t       _element_size,
+    fn_predicate _test,
+    void*        _context
+)
+{
+    size_t index;
+
+    index = d_functional_last_index_of_context(_input,
+                                               _count,
+                                               _element_size,
+                                               _test,
+                                               _context);
+
+    if (index == (size_t)-1)
+    {
+        return NULL;
+    }
+
+    return (void*)((const unsigned char*)_input + (index * _element_size));
+}
+
+/*
+d_functional_last_index_of_context
+  Finds the index of the last element of an array satisfying a predicate
+called with a context, scanning from the end.
+
+Parameter(s):
+  _input:        pointer to the array.
+  _count:        number of elements in the array.
+  _element_size: size of each element in bytes.
+  _test:         the predicate to satisfy.
+  _context:      context forwarded to _test; may be NULL.
+Return:
+  The index of the last matching element, or (size_t)-1 if there is none
+or a parameter was NULL/zero.
+*/
+size_t
+d_functional_last_index_of_context
+(
+    const void*  _input,
+    size_t       _count,
+    size_t       _element_size,
+    fn_predicate _test,
+    void*        _context
+)
+{
+    const unsigned char* src;
+    const unsigned char* at;
+
+    // validate parameters
+    if ( (!_input)     ||
+         (!_test)      ||
+         (_count == 0) ||
+         (_element_size == 0) )
+    {
+        return (size_t)-1;
+    }
+
+    src = (const unsigned char*)_input;
+
+    if ( (_test == d_predicate_program_test) &&
+         (_context) )
+    {
+        return d_scan_program((const struct d_predicate_program*)_context,
+                              src,
+                              _count,
+                              _element_size,
+                              true);
+    }
+
+    at = src + (_count * _element_size);
+
+    while (at != src)
+    {
+        at -= _element_size;
+
+        if (_test(at, _context))
+        {
+            return (size_t)(at - src) / _element_size;
+        }
+    }
+
+    return (size_t)-1;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             V.    VALUE SEARCHES                                        ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_functional_index_of_value
+  Finds the first element of an array bytewise equal to a value.
+
+Parameter(s):
+  _input:        pointer to the array.
+  _count:        number of elements in the array.
+  _element_size: size of each element (and of *_value) in bytes.
+  _value:        pointer to the value to find.
+Return:
+  The index of the first equal element, or (size_t)-1 if there is none or
+a parameter was NULL/zero.
+*/
+size_t
+d_functional_index_of_value
+(
+    const void* _input,
+    size_t      _count,
+    size_t      _element_size,
+    const void* _value
+)
+{
+    // validate parameters
+    if ( (!_input)     ||
+         (!_value)     ||
+         (_count == 0) ||
+         (_element_size == 0) )
+    {
+        return (size_t)-1;
+    }
+
+    return d_scan_value(_input, _count, _element_size, _value, false);
+}
+
+/*
+d_functional_last_index_of_value
+  Finds the last element of an array bytewise equal to a value, scanning
+from the end.
+
+Parameter(s):
+  _input:        pointer to the array.
+  _count:        number of elements in the array.
+  _element_size: size of each element (and of *_value) in bytes.
+  _value:        pointer to the value to find.
+Return:
+  The index of the last equal element, or (size_t)-1 if there is none or a
+parameter was NULL/zero.
+*/
+size_t
+d_functional_last_index_of_value
+(
+    const void* _input,
+    size_t      _count,
+    size_t      _element_size,
+    const void* _value
+)
+{
+    // validate parameters
+    if ( (!_input)     ||
+         (!_value)     ||
+         (_count == 0) ||
+         (_element_size == 0) )
+    {
+        return (size_t)-1;
+    }
+
+    return d_scan_value(_input, _count, _element_size, _value, true);
+}
@@ -0,0 +1,1275 @@
+#include "..\..\inc\functional\sort.h"
+
+
+/*
+d_sort_state
+  Internal bundle of the array being sorted and how to order it.
+*/
+struct d_sort_state
+{
+    unsigned char*         base;
+    size_t                 size;
+    fn_function_comparator comparator;
+    void*                  context;
+    unsigned char*         scratch;  // one element, for insertion sort
+};
+
+// D_SORT_AT
+//   internal macro: address of element I of sort state S.
+#define D_SORT_AT(s, i) ((s)->base + ((i) * (s)->size))
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             I.    ELEMENT AND HEAP HELPERS                              ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_sort_swap
+  Internal helper swapping two elements of _size bytes.
+*/
+static void
+d_sort_swap
+(
+    unsigned char* _a,
+    unsigned char* _b,
+    size_t         _size
+)
+{
+    unsigned char buffer[64];
+    size_t        chunk;
+
+    if (_a == _b)
+    {
+        return;
+    }
+
+    while (_size > 0)
+    {
+        chunk = (_size < sizeof(buffer)) ? _size : sizeof(buffer);
+
+        memcpy(buffer, _a, chunk);
+        memcpy(_a, _b, chunk);
+        memcpy(_b, buffer, chunk);
+
+        _a    += chunk;
+        _b    += chunk;
+        _size -= chunk;
+    }
+
+    return;
+}
+
+/*
+d_sort_sift_down
+  Internal helper restoring the heap property below _root in a heap of
+_count elements at _base. A max-heap keeps the greatest element at the root;
+a min-heap (_min_heap) keeps the least.
+*/
+static void
+d_sort_sift_down
+(
+    unsigned char*         _base,
+    size_t                 _size,
+    size_t                 _root,
+    size_t                 _count,
+    fn_function_comparator _comparator,
+    void*                  _context,
+    bool                   _min_heap
+)
+{
+    size_t child;
+    int    order;
+
+    while ((child = (2 * _root) + 1) < _count)
+    {
+        // pick the child that belongs higher in the heap
+        if (child + 1 < _count)
+        {
+            order = _comparator(_base + ((child + 1) * _size),
+                                _base + (child * _size),
+                                _context);
+
+            if ( (_min_heap) ? (order < 0) : (order > 0) )
+            {
+                child++;
+            }
+        }
+
+        order = _comparator(_base + (child * _size),
+                            _base + (_root * _size),
+                            _context);
+
+        if ( (_min_heap) ? (order >= 0) : (order <= 0) )
+        {
+            return;
+        }
+
+        d_sort_swap(_base + (child * _size),
+                    _base + (_root * _size),
+                    _size);
+
+        _root = child;
+    }
+
+    return;
+}
+
+/*
+d_sort_heapify
+  Internal helper arranging _count elements at _base into a heap.
+*/
+static void
+d_sort_heapify
+(
+    unsigned char*         _base,
+    size_t                 _size,
+    size_t                 _count,
+    fn_function_comparator _comparator,
+    void*                  _context,
+    bool                   _min_heap
+)
+{
+    size_t i;
+
+    for (i = _count / 2; i > 0; i--)
+    {
+        d_sort_sift_down(_base,
+                         _size,
+                         i - 1,
+                         _count,
+                         _comparator,
+                         _context,
+                         _min_heap);
+    }
+
+    return;
+}
+
+/*
+d_sort_heap_drain
+  Internal helper repeatedly moving the root of a heap of _count elements
+to the end. A max-heap is left in ascending order, a min-heap in descending
+order.
+*/
+static void
+d_sort_heap_drain
+(
+    unsigned char*         _base,
+    size_t                 _size,
+    size_t                 _count,
+    fn_function_comparator _comparator,
+    void*                  _context,
+    bool                   _min_heap
+)
+{
+    size_t end;
+
+    for (end = _count; end > 1; end--)
+    {
+        d_sort_swap(_base, _base + ((end - 1) * _size), _size);
+        d_sort_sift_down(_base,
+                         _size,
+                         0,
+                         end - 1,
+                         _comparator,
+                         _context,
+                         _min_heap);
+    }
+
+    return;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             II.   INTROSORT                                             ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_sort_insertion
+  Internal helper insertion-sorting [_lo, _hi). Each element is moved with
+a single memmove once its position is known.
+*/
+static void
+d_sort_insertion
+(
+    struct d_sort_state* _state,
+    size_t               _lo,
+    size_t               _hi
+)
+{
+    size_t i;
+    size_t j;
+
+    for (i = _lo + 1; i < _hi; i++)
+    {
+        if (_state->comparator(D_SORT_AT(_state, i),
+                               D_SORT_AT(_state, i - 1),
+                               _state->context) >= 0)
+        {
+            continue;
+        }
+
+        memcpy(_state->scratch, D_SORT_AT(_state, i), _state->size);
+
+        j = i - 1;
+
+        while ( (j > _lo) &&
+                (_state->comparator(_state->scratch,
+                                    D_SORT_AT(_state, j - 1),
+                                    _state->context) < 0) )
+        {
+            j--;
+        }
+
+        memmove(D_SORT_AT(_state, j + 1),
+                D_SORT_AT(_state, j),
+                (i - j) * _state->size);
+        memcpy(D_SORT_AT(_state, j), _state->scratch, _state->size);
+    }
+
+    return;
+}
+
+/*
+d_sort_partition
+  Internal helper partitioning [_lo, _hi) around the median of its first,
+middle, and last elements. Elements equal to the pivot may end up on either
+side, which keeps runs of duplicates balanced. Returns the pivot's final
+index; everything before it compares <= and everything after >= the pivot.
+*/
+static size_t
+d_sort_partition
+(
+    struct d_sort_state* _state,
+    size_t               _lo,
+    size_t               _hi
+)
+{
+    size_t mid;
+    size_t last;
+    size_t i;
+    size_t j;
+
+    mid  = _lo + ((_hi - _lo) / 2);
+    last = _hi - 1;
+
+    // order lo, mid, last, then park the median at lo
+    if (_state->comparator(D_SORT_AT(_state, mid),
+                           D_SORT_AT(_state, _lo),
+                           _state->context) < 0)
+    {
+        d_sort_swap(D_SORT_AT(_state, mid),
+                    D_SORT_AT(_state, _lo),
+                    _state->size);
+    }
+
+    if (_state->comparator(D_SORT_AT(_state, last),
+                           D_SORT_AT(_state, mid),
+                           _state->context) < 0)
+    {
+        d_sort_swap(D_SORT_AT(_state, last),
+                    D_SORT_AT(_state, mid),
+                    _state->size);
+
+        if (_state->comparator(D_SORT_AT(_state, mid),
+                               D_SORT_AT(_state, _lo),
+                               _state->context) < 0)
+        {
+            d_sort_swap(D_SORT_AT(_state, mid),
+                        D_SORT_AT(_state, _lo),
+                        _state->size);
+        }
+    }
+
+    d_sort_swap(D_SORT_AT(_state, mid),
+                D_SORT_AT(_state, _lo),
+                _state->size);
+
+    i = _lo + 1;
+    j = last;
+
+    for (;;)
+    {
+        while ( (i <= j) &&
+                (_state->comparator(D_SORT_AT(_state, i),
+                                    D_SORT_AT(_state, _lo),
+                                    _state->context) < 0) )
+        {
+            i++;
+        }
+
+        while ( (i <= j) &&
+                (_state->comparator(D_SORT_AT(_state, j),
+                                    D_SORT_AT(_state, _lo),
+                                    _state->context) > 0) )
+        {
+            j--;
+        }
+
+        if (i >= j)
+        {
+            break;
+        }
+
+        d_sort_swap(D_SORT_AT(_state, i),
+                    D_SORT_AT(_state, j),
+                    _state->size);
+
+        i++;
+        j--;
+    }
+
+    d_sort_swap(D_SORT_AT(_state, _lo),
+                D_SORT_AT(_state, j),
+                _state->size);
+
+    return j;
+}
+
+/*
+d_sort_intro
+  Internal introsort of [_lo, _hi). Recurses into the smaller side and
+loops on the larger, so the stack depth is O(log n); falls back to
+heapsort once _depth partitions have been spent.
+*/
+static void
+d_sort_intro
+(
+    struct d_sort_state* _state,
+    size_t               _lo,
+    size_t               _hi,
+    size_t               _depth
+)
+{
+    size_t pivot;
+
+    while ((_hi - _lo) > D_SORT_INSERTION_THRESHOLD)
+    {
+        if (_depth == 0)
+        {
+            d_sort_heapify(D_SORT_AT(_state, _lo),
+                           _state->size,
+                           _hi - _lo,
+                           _state->comparator,
+                           _state->context,
+                           false);
+            d_sort_heap_drain(D_SORT_AT(_state, _lo),
+                              _state->size,
+                              _hi - _lo,
+                              _state->comparator,
+                              _state->context,
+                              false);
+
+            return;
+        }
+
+        _depth--;
+        pivot = d_sort_partition(_state, _lo, _hi);
+
+        if ((pivot - _lo) < (_hi - pivot))
+        {
+            d_sort_intro(_state, _lo, pivot, _depth);
+            _lo = pivot + 1;
+        }
+        else
+        {
+            d_sort_intro(_state, pivot + 1, _hi, _depth);
+            _hi = pivot;
+        }
+    }
+
+    d_sort_insertion(_state, _lo, _hi);
+
+    return;
+}
+
+/*
+d_sort_depth_limit
+  Internal helper returning the introsort partition budget, 2 * log2(n).
+*/
+static size_t
+d_sort_depth_limit
+(
+    size_t _count
+)
+{
+    size_t depth;
+
+    depth = 0;
+
+    while (_count > 1)
+    {
+        _count >>= 1;
+        depth   += 2;
+    }
+
+    return depth;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             III.  BUILT-IN COMPARATOR FAST PATHS                        ///
+///////////////////////////////////////////////////////////////////////////////
+
+// d_sort_builtin
+//   enum: built-in comparators with typed radix sort and search paths.
+enum d_sort_builtin
+{
+    D_SORT_BUILTIN_NONE = 0,
+    D_SORT_BUILTIN_INT,
+    D_SORT_BUILTIN_SIZE_T,
+    D_SORT_BUILTIN_DOUBLE
+};
+
+/*
+d_sort_builtin_of
+  Internal helper recognizing a built-in comparator whose element size
+matches its type.
+*/
+static enum d_sort_builtin
+d_sort_builtin_of
+(
+    fn_function_comparator _comparator,
+    size_t                 _element_size
+)
+{
+    if ( (_comparator == d_functional_compare_int) &&
+         (_element_size == sizeof(int)) )
+    {
+        return D_SORT_BUILTIN_INT;
+    }
+
+    if ( (_comparator == d_functional_compare_size_t) &&
+         (_element_size == sizeof(size_t)) )
+    {
+        return D_SORT_BUILTIN_SIZE_T;
+    }
+
+    if ( (_comparator == d_functional_compare_double) &&
+         (_element_size == sizeof(double)) &&
+         (sizeof(double) == sizeof(uint64_t)) )
+    {
+        return D_SORT_BUILTIN_DOUBLE;
+    }
+
+    return D_SORT_BUILTIN_NONE;
+}
+
+/*
+d_sort_radix
+  Internal LSD radix sort for the built-in comparators. Elements are
+converted to unsigned keys whose byte order matches the comparator (sign
+bit flipped for ints; all bits flipped for negative doubles, sign bit
+otherwise), sorted a byte at a time, and converted back. Passes in which
+every key has the same byte are skipped. Returns false, leaving the input
+untouched, if the comparator has no fast path or memory could not be
+allocated.
+*/
+static bool
+d_sort_radix
+(
+    void*                  _input,
+    size_t                 _count,
+    size_t                 _element_size,
+    fn_function_comparator _comparator
+)
+{
+    enum d_sort_builtin    kind;
+    size_t                 counts[8][256];
+    uint64_t*              keys;
+    uint64_t*              buffer;
+    uint64_t*              source;
+    uint64_t*              target;
+    uint64_t               key;
+    uint64_t               top;
+    size_t                 passes;
+    size_t                 offset;
+    size_t                 total;
+    size_t                 pass;
+    size_t                 i;
+    unsigned int           ivalue;
+    double                 dvalue;
+
+    kind = d_sort_builtin_of(_comparator, _element_size);
+
+    if (kind == D_SORT_BUILTIN_NONE)
+    {
+        return false;
+    }
+
+    keys   = d_functional_malloc(_count * sizeof(uint64_t));
+    buffer = d_functional_malloc(_count * sizeof(uint64_t));
+
+    // ensure that memory allocation was successful
+    if ( (!keys) ||
+         (!buffer) )
+    {
+        d_functional_free(keys);
+        d_functional_free(buffer);
+
+        return false;
+    }
+
+    passes = _element_size;
+    top    = (uint64_t)1 << ((passes * 8) - 1);
+
+    // convert to keys
+    for (i = 0; i < _count; i++)
+    {
+        switch (kind)
+        {
+        case D_SORT_BUILTIN_INT:
+            keys[i] = (uint64_t)(unsigned int)((const int*)_input)[i] ^ top;
+
+            break;
+
+        case D_SORT_BUILTIN_SIZE_T:
+            keys[i] = (uint64_t)((const size_t*)_input)[i];
+
+            break;
+
+        default:
+            memcpy(&key, (const double*)_input + i, sizeof(key));
+            keys[i] = (key & top) ? ~key : (key | top);
+
+            break;
+        }
+    }
+
+    memset(counts, 0, sizeof(counts));
+
+    for (i = 0; i < _count; i++)
+    {
+        for (pass = 0; pass < passes; pass++)
+        {
+            counts[pass][(keys[i] >> (pass * 8)) & 0xFF]++;
+        }
+    }
+
+    source = keys;
+    target = buffer;
+
+    for (pass = 0; pass < passes; pass++)
+    {
+        // every key shares this byte
+        if (counts[pass][(source[0] >> (pass * 8)) & 0xFF] == _count)
+        {
+            continue;
+        }
+
+        total = 0;
+
+        for (i = 0; i < 256; i++)
+        {
+            offset          = counts[pass][i];
+            counts[pass][i] = total;
+            total          += offset;
+        }
+
+        for (i = 0; i < _count; i++)
+        {
+            target[counts[pass][(source[i] >> (pass * 8)) & 0xFF]++] =
+                source[i];
+        }
+
+        source = target;
+        target = (source == keys) ? buffer : keys;
+    }
+
+    // convert back
+    for (i = 0; i < _count; i++)
+    {
+        switch (kind)
+        {
+        case D_SORT_BUILTIN_INT:
+            ivalue = (unsigned int)(source[i] ^ top);
+            memcpy((int*)_input + i, &ivalue, sizeof(int));
+
+            break;
+
+        case D_SORT_BUILTIN_SIZE_T:
+            ((size_t*)_input)[i] = (size_t)source[i];
+
+            break;
+
+        default:
+            key = (source[i] & top) ? (source[i] & ~top) : ~source[i];
+            memcpy(&dvalue, &key, sizeof(dvalue));
+            ((double*)_input)[i] = dvalue;
+
+            break;
+        }
+    }
+
+    d_functional_free(keys);
+    d_functional_free(buffer);
+
+    return true;
+}
+
+
+// D_SORT_BOUND_KERNEL
+//   internal macro: defines a static lower / upper bound search over an
+// array of TYPE using the built-in comparison operators, matching the
+// corresponding d_functional_compare_* comparator.
+#define D_SORT_BOUND_KERNEL(name,                                           \
+                            type)                                           \
+    static size_t                                                           \
+    name                                                                    \
+    (                                                                       \
+        const type* _values,                                                \
+        size_t      _count,                                                 \
+        type        _value,                                                 \
+        bool        _upper                                                  \
+    )                                                                       \
+    {                                                                       \
+        size_t lo;                                                          \
+        size_t half;                                                        \
+                                                                            \
+        lo = 0;                                                             \
+                                                                            \
+        while (_count > 0)                                                  \
+        {                                                                   \
+            half = _count / 2;                                              \
+                                                                            \
+            if ( (_upper) ? !(_values[lo + half] > _value)                  \
+                          : (_values[lo + half] < _value) )                 \
+            {                                                               \
+                lo     += half + 1;                                         \
+                _count -= half + 1;                                         \
+            }                                                               \
+            else                                                            \
+            {                                                               \
+                _count = half;                                              \
+            }                                                               \
+        }                                                                   \
+                                                                            \
+        return lo;                                                          \
+    }
+
+D_SORT_BOUND_KERNEL(d_sort_bound_int, int)
+D_SORT_BOUND_KERNEL(d_sort_bound_size_t, size_t)
+D_SORT_BOUND_KERNEL(d_sort_bound_double, double)
+
+/*
+d_sort_bound
+  Internal binary search returning the first index whose element compares
+> _value (_upper) or >= _value (otherwise). Built-in comparators are
+dispatched to the typed kernels.
+*/
+static size_t
+d_sort_bound
+(
+    const void*            _input,
+    size_t                 _count,
+    size_t                 _element_size,
+    const void*            _value,
+    fn_function_comparator _comparator,
+    void*                  _context,
+    bool                   _upper
+)
+{
+    const unsigned char* base;
+    size_t               lo;
+    size_t               half;
+    int                  order;
+
+    switch (d_sort_builtin_of(_comparator, _element_size))
+    {
+    case D_SORT_BUILTIN_INT:
+        return d_sort_bound_int((const int*)_input,
+                                _count,
+                                *(const int*)_value,
+                                _upper);
+
+    case D_SORT_BUILTIN_SIZE_T:
+        return d_sort_bound_size_t((const size_t*)_input,
+                                   _count,
+                                   *(const size_t*)_value,
+                                   _upper);
+
+    case D_SORT_BUILTIN_DOUBLE:
+        return d_sort_bound_double((const double*)_input,
+                                   _count,
+                                   *(const double*)_value,
+                                   _upper);
+
+    default:
+        break;
+    }
+
+    base = (const unsigned char*)_input;
+    lo   = 0;
+
+    while (_count > 0)
+    {
+        half  = _count / 2;
+        order = _comparator(base + ((lo + half) * _element_size),
+                            _value,
+                            _context);
+
+        if ( (_upper) ? (order <= 0) : (order < 0) )
+        {
+            lo     += half + 1;
+            _count -= half + 1;
+        }
+        else
+        {
+            _count = half;
+        }
+    }
+
+    return lo;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             IV.   PUBLIC API                                            ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_functional_sort
+  Sorts an array in place into ascending order under a comparator. Uses
+introsort, or a radix sort for large arrays ordered by one of the built-in
+int, size_t, or double comparators. The sort is not stable.
+
+Parameter(s):
+  _input:        pointer to the array to sort.
+  _count:        number of elements in the array.
+  _element_size: size of each element in bytes.
+  _comparator:   three-way comparator defining the order.
+  _context:      context forwarded to _comparator; may be NULL.
+Return:
+  A boolean value corresponding to either:
+  - true, if the array was sorted, or
+  - false, if _input or _comparator was NULL, _element_size was zero, or
+    memory could not be allocated.
+*/
+bool
+d_functional_sort
+(
+    void*                  _input,
+    size_t                 _count,
+    size_t                 _element_size,
+    fn_function_comparator _comparator,
+    void*                  _context
+)
+{
+    struct d_sort_state state;
+
+    // validate parameters
+    if ( (!_input)      ||
+         (!_comparator) ||
+         (_element_size == 0) )
+    {
+        return false;
+    }
+
+    if (_count < 2)
+    {
+        return true;
+    }
+
+    if ( (_count >= D_SORT_RADIX_THRESHOLD) &&
+         (d_sort_radix(_input, _count, _element_size, _comparator)) )
+    {
+        return true;
+    }
+
+    state.base       = (unsigned char*)_input;
+    state.size       = _element_size;
+    state.comparator = _comparator;
+    state.context    = _context;
+    state.scratch    = d_functional_malloc(_element_size);
+
+    // ensure that memory allocation was successful
+    if (!state.scratch)
+    {
+        return false;
+    }
+
+    d_sort_intro(&state, 0, _count, d_sort_depth_limit(_count));
+
+    d_functional_free(state.scratch);
+
+    return true;
+}
+
+/*
+d_functional_partial_sort
+  Rearranges an array so that its first _k elements are the _k least
+elements in ascending order. The order of the remaining elements is
+unspecified. Runs in O(n log k).
+
+Parameter(s):
+  _input:        pointer to the array.
+  _count:        number of elements in the array.
+  _element_size: size of each element in bytes.
+  _k:            number of leading elements to sort; values >= _count sort
+                 the whole array.
+  _comparator:   three-way comparator defining the order.
+  _context:      context forwarded to _comparator; may be NULL.
+Return:
+  A boolean value corresponding to either:
+  - true, if the array was rearranged, or
+  - false, if _input or _comparator was NULL, _element_size was zero, or
+    memory could not be allocated.
+*/
+bool
+d_functional_partial_sort
+(
+    void*                  _input,
+    size_t                 _count,
+    size_t                 _element_size,
+    size_t                 _k,
+    fn_function_comparator _comparator,
+    void*                  _context
+)
+{
+    unsigned char* base;
+    size_t         i;
+
+    // validate parameters
+    if ( (!_input)      ||
+         (!_comparator) ||
+         (_element_size == 0) )
+    {
+        return false;
+    }
+
+    if (_k >= _count)
+    {
+        return d_functional_sort(_input,
+                                 _count,
+                                 _element_size,
+                                 _comparator,
+                                 _context);
+    }
+
+    if (_k == 0)
+    {
+        return true;
+    }
+
+    base = (unsigned char*)_input;
+
+    // keep the k least elements seen so far in a max-heap
+    d_sort_heapify(base, _element_size, _k, _comparator, _context, false);
+
+    for (i = _k; i < _count; i++)
+    {
+        if (_comparator(base + (i * _element_size), base, _context) < 0)
+        {
+            d_sort_swap(base + (i * _element_size), base, _element_size);
+            d_sort_sift_down(base,
+                             _element_size,
+                             0,
+                             _k,
+                             _comparator,
+                             _context,
+                             false);
+        }
+    }
+
+    d_sort_heap_drain(base, _element_size, _k, _comparator, _context, false);
+
+    return true;
+}
+
+/*
+d_functional_nth_element
+  Rearranges an array so that the element at index _n is the one that
+would be there if the array were sorted, every element before it compares
+<= it, and every element after it compares >= it. Runs in O(n) on average
+(introselect, with a heapsort fallback bounding the worst case).
+
+Parameter(s):
+  _input:        pointer to the array.
+  _count:        number of elements in the array.
+  _element_size: size of each element in bytes.
+  _n:            index of the element to place.
+  _comparator:   three-way comparator defining the order.
+  _context:      context forwarded to _comparator; may be NULL.
+Return:
+  A boolean value corresponding to either:
+  - true, if the array was rearranged, or
+  - false, if _input or _comparator was NULL, _element_size was zero,
+    _n >= _count, or memory could not be allocated.
+*/
+bool
+d_functional_nth_element
+(
+    void*                  _input,
+    size_t                 _count,
+    size_t                 _element_size,
+    size_t                 _n,
+    fn_function_comparator _comparator,
+    void*                  _context
+)
+{
+    struct d_sort_state state;
+    size_t              lo;
+    size_t              hi;
+    size_t              pivot;
+    size_t              depth;
+
+    // validate parameters
+    if ( (!_input)      ||
+         (!_comparator) ||
+         (_element_size == 0) ||
+         (_n >= _count) )
+    {
+        return false;
+    }
+
+    state.base       = (unsigned char*)_input;
+    state.size       = _element_size;
+    state.comparator = _comparator;
+    state.context    = _context;
+    state.scratch    = d_functional_malloc(_element_size);
+
+    // ensure that memory allocation was successful
+    if (!state.scratch)
+    {
+        return false;
+    }
+
+    lo    = 0;
+    hi    = _count;
+    depth = d_sort_depth_limit(_count);
+
+    while ((hi - lo) > D_SORT_INSERTION_THRESHOLD)
+    {
+        if (depth == 0)
+        {
+            d_sort_intro(&state, lo, hi, 0);
+
+            d_functional_free(state.scratch);
+
+            return true;
+        }
+
+        depth--;
+        pivot = d_sort_partition(&state, lo, hi);
+
+        if (pivot == _n)
+        {
+            d_functional_free(state.scratch);
+
+            return true;
+        }
+
+        if (_n < pivot)
+        {
+            hi = pivot;
+        }
+        else
+        {
+            lo = pivot + 1;
+        }
+    }
+
+    d_sort_insertion(&state, lo, hi);
+
+    d_functional_free(state.scratch);
+
+    return true;
+}
+
+/*
+d_functional_top_k
+  Copies the _k greatest elements of an array into _output, greatest first,
+without modifying the input. Keeps the best _k elements seen so far in a
+bounded min-heap, so it runs in O(n log k) time and needs no memory beyond
+_output. Pass a reversed comparator for the _k least elements.
+
+Parameter(s):
+  _input:        pointer to the input array.
+  _count:        number of elements in the input array.
+  _element_size: size of each element in bytes.
+  _k:            maximum number of elements to select.
+  _output:       buffer with room for min(_k, _count) elements.
+  _comparator:   three-way comparator defining the order.
+  _context:      context forwarded to _comparator; may be NULL.
+Return:
+  The number of elements written to _output, min(_k, _count), or 0 if
+_input, _output, or _comparator was NULL or _element_size was zero.
+*/
+size_t
+d_functional_top_k
+(
+    const void*            _input,
+    size_t                 _count,
+    size_t                 _element_size,
+    size_t                 _k,
+    void*                  _output,
+    fn_function_comparator _comparator,
+    void*                  _context
+)
+{
+    const unsigned char* in;
+    unsigned char*       heap;
+    size_t               kept;
+    size_t               i;
+
+    // validate parameters
+    if ( (!_input)      ||
+         (!_output)     ||
+         (!_comparator) ||
+         (_element_size == 0) )
+    {
+        return 0;
+    }
+
+    kept = (_k < _count) ? _k : _count;
+
+    if (kept == 0)
+    {
+        return 0;
+    }
+
+    in   = (const unsigned char*)_input;
+    heap = (unsigned char*)_output;
+
+    memcpy(heap, in, kept * _element_size);
+    d_sort_heapify(heap, _element_size, kept, _comparator, _context, true);
+
+    // the heap root is the least of the best k so far
+    for (i = kept; i < _count; i++)
+    {
+        if (_comparator(in + (i * _element_size), heap, _context) > 0)
+        {
+            memcpy(heap, in + (i * _element_size), _element_size);
+            d_sort_sift_down(heap,
+                             _element_size,
+                             0,
+                             kept,
+                             _comparator,
+                             _context,
+                             true);
+        }
+    }
+
+    d_sort_heap_drain(heap, _element_size, kept, _comparator, _context, true);
+
+    return kept;
+}
+
+/*
+d_functional_lower_bound
+  Finds the first element of a sorted array that does not compare less than
+_value, in O(log n) comparisons.
+
+Parameter(s):
+  _input:        pointer to an array sorted ascending under _comparator.
+  _count:        number of elements in the array.
+  _element_size: size of each element in bytes.
+  _value:        the value to search for.
+  _comparator:   the comparator the array is sorted by.
+  _context:      context forwarded to _comparator; may be NULL.
+Return:
+  The index of the first element >= _value, or _count if there is none.
+Returns (size_t)-1 if _input, _value, or _comparator was NULL or
+_element_size was zero.
+*/
+size_t
+d_functional_lower_bound
+(
+    const void*            _input,
+    size_t                 _count,
+    size_t                 _element_size,
+    const void*            _value,
+    fn_function_comparator _comparator,
+    void*                  _context
+)
+{
+    // validate parameters
+    if ( (!_input)      ||
+         (!_value)      ||
+         (!_comparator) ||
+         (_element_size == 0) )
+    {
+        return (size_t)-1;
+    }
+
+    return d_sort_bound(_input,
+                        _count,
+                        _element_size,
+                        _value,
+                        _comparator,
+                        _context,
+                        false);
+}
+
+/*
+d_functional_upper_bound
+  Finds the first element of a sorted array that compares greater than
+_value, in O(log n) comparisons.
+
+Parameter(s):
+  _input:        pointer to an array sorted ascending under _comparator.
+  _count:        number of elements in the array.
+  _element_size: size of each element in bytes.
+  _value:        the value to search for.
+  _comparator:   the comparator the array is sorted by.
+  _context:      context forwarded to _comparator; may be NULL.
+Return:
+  The index of the first element > _value, or _count if there is none.
+Returns (size_t)-1 if _input, _value, or _comparator was NULL or
+_element_size was zero.
+*/
+size_t
+d_functional_upper_bound
+(
+    const void*            _input,
+    size_t                 _count,
+    size_t                 _element_size,
+    const void*            _value,
+    fn_function_comparator _comparator,
+    void*                  _context
+)
+{
+    // validate parameters
+    if ( (!_input)      ||
+         (!_value)      ||
+         (!_comparator) ||
+         (_element_size == 0) )
+    {
+        return (size_t)-1;
+    }
+
+    return d_sort_bound(_input,
+                        _count,
+                        _element_size,
+                        _value,
+                        _comparator,
+                        _context,
+                        true);
+}
+
+/*
+d_functional_equal_range
+  Finds the run of elements of a sorted array that compare equal to _value.
+The upper bound is searched only within [lower bound, _count).
+
+Parameter(s):
+  _input:        pointer to an array sorted ascending under _comparator.
+  _count:        number of elements in the array.
+  _element_size: size of each element in bytes.
+  _value:        the value to search for.
+  _comparator:   the comparator the array is sorted by.
+  _context:      context forwarded to _comparator; may be NULL.
+  _first:        receives the index of the first equal element.
+  _last:         receives one past the index of the last equal element.
+Return:
+  A boolean value corresponding to either:
+  - true, if the range was computed (it is empty, *_first == *_last, when
+    no element equals _value), or
+  - false, if any pointer was NULL or _element_size was zero.
+*/
+bool
+d_functional_equal_range
+(
+    const void*            _input,
+    size_t                 _count,
+    size_t                 _element_size,
+    const void*            _value,
+    fn_function_comparator _comparator,
+    void*                  _context,
+    size_t*                _first,
+    size_t*                _last
+)
+{
+    size_t first;
+
+    // validate parameters
+    if ( (!_input)      ||
+         (!_value)      ||
+         (!_comparator) ||
+         (!_first)      ||
+         (!_last)       ||
+         (_element_size == 0) )
+    {
+        return false;
+    }
+
+    first = d_sort_bound(_input,
+                         _count,
+                         _element_size,
+                         _value,
+                         _comparator,
+                         _context,
+                         false);
+
+    *_first = first;
+    *_last  = first + d_sort_bound((const unsigned char*)_input +
+                                       (first * _element_size),
+                                   _count - first,
+                                   _element_size,
+                                   _value,
+                                   _comparator,
+                                   _context,
+                                   true);
+
+    return true;
+}
+
+/*
+d_functional_partition_point
+  Finds where a predicate that holds on a prefix of an array stops holding,
+in O(log n) predicate calls. The array must be partitioned: every element
+satisfying _test precedes every element that does not.
+
+Parameter(s):
+  _input:        pointer to the partitioned array.
+  _count:        number of elements in the array.
+  _element_size: size of each element in bytes.
+  _test:         the predicate the array is partitioned by.
+  _context:      context forwarded to _test; may be NULL.
+Return:
+  The index of the first element not satisfying _test, or _count if all
+do. Returns (size_t)-1 if _input or _test was NULL or _element_size was
+zero.
+*/
+size_t
+d_functional_partition_point
+(
+    const void*  _input,
+    size_t       _count,
+    size_t       _element_size,
+    fn_predicate _test,
+    void*        _context
+)
+{
+    const unsigned char* base;
+    size_t               lo;
+    size_t               half;
+
+    // validate parameters
+    if ( (!_input) ||
+         (!_test)  ||
+         (_element_size == 0) )
+    {
+        return (size_t)-1;
+    }
+
+    base = (const unsigned char*)_input;
+    lo   = 0;
+
+    while (_count > 0)
+    {
+        half = _count / 2;
+
+        if (_test(base + ((lo + half) * _element_size), _context))
+        {
+            lo     += half + 1;
+            _count -= half + 1;
+        }
+        else
+        {
+            _count = half;
+        }
+    }
+
+    return lo;
+}
@@ -0,0 +1,943 @@
+#include "..\..\inc\functional\stream.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             I.    SOURCES                                               ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_stream_array_next
+  Internal fn_source_next of an array source.
+*/
+static bool
+d_stream_array_next
+(
+    void*        _context,
+    const void** _chunk,
+    size_t*      _count
+)
+{
+    struct d_functional_array_source* state;
+    size_t                            n;
+
+    state = (struct d_functional_array_source*)_context;
+    n     = state->count - state->position;
+
+    if (n > state->chunk_count)
+    {
+        n = state->chunk_count;
+    }
+
+    *_chunk          = state->data + (state->position * state->element_size);
+    *_count          = n;
+    state->position += n;
+
+    return true;
+}
+
+
+/*
+d_functional_source_array
+  Creates a source handing out an in-memory array in chunks of a fixed
+number of elements. Mainly useful to run streaming code over data that is
+already in memory, and in tests.
+
+Parameter(s):
+  _state:        caller-owned state of the source; must outlive it.
+  _data:         the array; must outlive the source.
+  _count:        number of elements in the array.
+  _element_size: size of each element in bytes.
+  _chunk_count:  elements per chunk; 0 means the whole array at once.
+Return:
+  The source. If _state is NULL, or _data is NULL with a non-zero _count,
+or _element_size is zero, the source's next_chunk is NULL.
+*/
+struct d_functional_source
+d_functional_source_array
+(
+    struct d_functional_array_source* _state,
+    const void*                       _data,
+    size_t                            _count,
+    size_t                            _element_size,
+    size_t                            _chunk_count
+)
+{
+    struct d_functional_source source;
+
+    source.next_chunk   = NULL;
+    source.context      = NULL;
+    source.element_size = _element_size;
+
+    // validate parameters
+    if ( (!_state)                      ||
+         ( (!_data) && (_count != 0) )  ||
+         (_element_size == 0) )
+    {
+        return source;
+    }
+
+    _state->data         = (const unsigned char*)_data;
+    _state->count        = _count;
+    _state->position     = 0;
+    _state->chunk_count  = (_chunk_count == 0) ? _count : _chunk_count;
+    _state->element_size = _element_size;
+
+    source.next_chunk = d_stream_array_next;
+    source.context    = _state;
+
+    return source;
+}
+
+
+/*
+d_functional_source_next
+  Pulls the next chunk from a source.
+
+Parameter(s):
+  _source: the source.
+  _chunk:  receives the chunk; valid until the next pull.
+  _count:  receives the number of elements in the chunk; 0 at the end.
+Return:
+  A boolean value corresponding to either:
+  - true, if a chunk (or the end of the input) was returned, or
+  - false, if a parameter was NULL or the source failed.
+*/
+bool
+d_functional_source_next
+(
+    struct d_functional_source* _source,
+    const void**                _chunk,
+    size_t*                     _count
+)
+{
+    // validate parameters
+    if ( (!_source)             ||
+         (!_source->next_chunk) ||
+         (!_chunk)              ||
+         (!_count) )
+    {
+        return false;
+    }
+
+    *_chunk = NULL;
+    *_count = 0;
+
+    if (!_source->next_chunk(_source->context, _chunk, _count))
+    {
+        return false;
+    }
+
+    // an empty chunk needs no data pointer
+    return ( (*_count == 0) || (*_chunk != NULL) );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             II.   STREAM CONSTRUCTION                                   ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_functional_stream_new
+  Creates a stream over a source, with no stages.
+
+Parameter(s):
+  _source: the source to pull from; must outlive the stream.
+Return:
+  A pointer to the new stream, or NULL if the source has no next_chunk or
+element size, or allocation failed.
+*/
+struct d_functional_stream*
+d_functional_stream_new
+(
+    struct d_functional_source _source
+)
+{
+    struct d_functional_stream* stream;
+
+    // validate parameters
+    if ( (!_source.next_chunk) ||
+         (_source.element_size == 0) )
+    {
+        return NULL;
+    }
+
+    stream = d_functional_malloc(sizeof(struct d_functional_stream));
+
+    // ensure that memory allocation was successful
+    if (!stream)
+    {
+        return NULL;
+    }
+
+    memset(stream, 0, sizeof(*stream));
+    stream->source = _source;
+
+    return stream;
+}
+
+
+/*
+d_stream_add_stage
+  Internal helper appending a stage to a stream, setting error_code on
+failure.
+*/
+static struct d_functional_stream*
+d_stream_add_stage
+(
+    struct d_functional_stream*  _stream,
+    const struct d_stream_stage* _stage
+)
+{
+    struct d_stream_stage* grown;
+    size_t                 capacity;
+
+    if ( (!_stream) ||
+         (_stream->error_code != 0) )
+    {
+        return _stream;
+    }
+
+    if (_stream->stage_count == _stream->stage_capacity)
+    {
+        capacity = (_stream->stage_capacity == 0)
+                   ? 4
+                   : (_stream->stage_capacity * 2);
+        grown    = d_functional_realloc(_stream->stages,
+                                        capacity *
+                                        sizeof(struct d_stream_stage));
+
+        // ensure that memory allocation was successful
+        if (!grown)
+        {
+            _stream->error_code = -1;
+
+            return _stream;
+        }
+
+        _stream->stages         = grown;
+        _stream->stage_capacity = capacity;
+    }
+
+    _stream->stages[_stream->stage_count++] = *_stage;
+
+    return _stream;
+}
+
+
+/*
+d_functional_stream_map
+  Adds a map stage, applying a transformer to every element. The output
+elements have the same size as the input elements.
+
+Parameter(s):
+  _stream:    the stream.
+  _transform: transformer applied to each element.
+  _context:   context forwarded to _transform; may be NULL.
+Return:
+  _stream, for chaining. error_code is set if _transform is NULL or the
+stage could not be added.
+*/
+struct d_functional_stream*
+d_functional_stream_map
+(
+    struct d_functional_stream* _stream,
+    fn_transformer              _transform,
+    void*                       _context
+)
+{
+    struct d_stream_stage stage;
+
+    memset(&stage, 0, sizeof(stage));
+    stage.kind      = D_STREAM_STAGE_MAP;
+    stage.transform = _transform;
+    stage.context   = _context;
+
+    if ( (_stream) &&
+         (!_transform) )
+    {
+        _stream->error_code = -1;
+    }
+
+    return d_stream_add_stage(_stream, &stage);
+}
+
+
+/*
+d_functional_stream_filter
+  Adds a filter stage, keeping the elements satisfying a predicate.
+
+Parameter(s):
+  _stream:  the stream.
+  _test:    predicate each kept element satisfies.
+  _context: context forwarded to _test; may be NULL.
+Return:
+  _stream, for chaining. error_code is set if _test is NULL or the stage
+could not be added.
+*/
+struct d_functional_stream*
+d_functional_stream_filter
+(
+    struct d_functional_stream* _stream,
+    fn_predicate                _test,
+    void*                       _context
+)
+{
+    struct d_stream_stage stage;
+
+    memset(&stage, 0, sizeof(stage));
+    stage.kind    = D_STREAM_STAGE_FILTER;
+    stage.test    = _test;
+    stage.context = _context;
+
+    if ( (_stream) &&
+         (!_test) )
+    {
+        _stream->error_code = -1;
+    }
+
+    return d_stream_add_stage(_stream, &stage);
+}
+
+
+/*
+d_functional_stream_for_each
+  Adds a stage calling a consumer on every element reaching it. The
+consumer may modify the element.
+
+Parameter(s):
+  _stream:  the stream.
+  _apply:   consumer called on each element.
+  _context: context forwarded to _apply; may be NULL.
+Return:
+  _stream, for chaining. error_code is set if _apply is NULL or the stage
+could not be added.
+*/
+struct d_functional_stream*
+d_functional_stream_for_each
+(
+    struct d_functional_stream* _stream,
+    fn_consumer                 _apply,
+    void*                       _context
+)
+{
+    struct d_stream_stage stage;
+
+    memset(&stage, 0, sizeof(stage));
+    stage.kind    = D_STREAM_STAGE_FOR_EACH;
+    stage.apply   = _apply;
+    stage.context = _context;
+
+    if ( (_stream) &&
+         (!_apply) )
+    {
+        _stream->error_code = -1;
+    }
+
+    return d_stream_add_stage(_stream, &stage);
+}
+
+
+/*
+d_functional_stream_take
+  Adds a stage passing on only the first _n elements reaching it. Once
+they have passed, no further chunks are pulled from the source; stages
+before the take have then seen only the chunks that were pulled.
+
+Parameter(s):
+  _stream: the stream.
+  _n:      number of elements to pass on.
+Return:
+  _stream, for chaining.
+*/
+struct d_functional_stream*
+d_functional_stream_take
+(
+    struct d_functional_stream* _stream,
+    size_t                      _n
+)
+{
+    struct d_stream_stage stage;
+
+    memset(&stage, 0, sizeof(stage));
+    stage.kind      = D_STREAM_STAGE_TAKE;
+    stage.remaining = _n;
+
+    return d_stream_add_stage(_stream, &stage);
+}
+
+
+/*
+d_functional_stream_skip
+  Adds a stage dropping the first _n elements reaching it.
+
+Parameter(s):
+  _stream: the stream.
+  _n:      number of elements to drop.
+Return:
+  _stream, for chaining.
+*/
+struct d_functional_stream*
+d_functional_stream_skip
+(
+    struct d_functional_stream* _stream,
+    size_t                      _n
+)
+{
+    struct d_stream_stage stage;
+
+    memset(&stage, 0, sizeof(stage));
+    stage.kind      = D_STREAM_STAGE_SKIP;
+    stage.remaining = _n;
+
+    return d_stream_add_stage(_stream, &stage);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             III.  CHUNK PROCESSING                                      ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_stream_reserve
+  Internal helper growing both working buffers to hold _count elements.
+*/
+static bool
+d_stream_reserve
+(
+    struct d_functional_stream* _stream,
+    size_t                      _count
+)
+{
+    unsigned char* grown;
+    size_t         i;
+
+    if (_count <= _stream->buffer_capacity)
+    {
+        return true;
+    }
+
+    for (i = 0; i < 2; i++)
+    {
+        grown = d_functional_realloc(_stream->buffers[i],
+                                     _count * _stream->source.element_size);
+
+        // ensure that memory allocation was successful
+        if (!grown)
+        {
+            return false;
+        }
+
+        _stream->buffers[i] = grown;
+    }
+
+    _stream->buffer_capacity = _count;
+
+    return true;
+}
+
+
+/*
+d_stream_run_stages
+  Internal helper running every stage over one chunk. The chunk stays in
+the source's memory until a stage has to write; map then fills the other
+working buffer, and filter compacts in place. *_data and *_count are
+updated to the stage output.
+*/
+static bool
+d_stream_run_stages
+(
+    struct d_functional_stream* _stream,
+    const unsigned char**       _data,
+    size_t*                     _count
+)
+{
+    struct d_stream_stage* stage;
+    const unsigned char*   in;
+    unsigned char*         out;
+    size_t                 size;
+    size_t                 kept;
+    size_t                 n;
+    size_t                 s;
+    size_t                 i;
+    int                    owner;  // buffer holding the data, or -1
+
+    size  = _stream->source.element_size;
+    in    = *_data;
+    n     = *_count;
+    owner = -1;
+
+    for (s = 0; (s < _stream->stage_count) && (n > 0); s++)
+    {
+        stage = &_stream->stages[s];
+
+        switch (stage->kind)
+        {
+        case D_STREAM_STAGE_MAP:
+            out = _stream->buffers[(owner == 0) ? 1 : 0];
+
+            for (i = 0; i < n; i++)
+            {
+                if (!stage->transform(in + (i * size),
+                                      out + (i * size),
+                                      stage->context))
+                {
+                    return false;
+                }
+            }
+
+            owner = (owner == 0) ? 1 : 0;
+            in    = out;
+
+            break;
+
+        case D_STREAM_STAGE_FILTER:
+            out  = _stream->buffers[(owner < 0) ? 0 : owner];
+            kept = 0;
+
+            for (i = 0; i < n; i++)
+            {
+                if (stage->test(in + (i * size), stage->context))
+                {
+                    if (out + (kept * size) != in + (i * size))
+                    {
+                        memcpy(out + (kept * size), in + (i * size), size);
+                    }
+
+                    kept++;
+                }
+            }
+
+            owner = (owner < 0) ? 0 : owner;
+            in    = out;
+            n     = kept;
+
+            break;
+
+        case D_STREAM_STAGE_FOR_EACH:
+            // consumers may modify elements, so they get a copy
+            if (owner < 0)
+            {
+                memcpy(_stream->buffers[0], in, n * size);
+                owner = 0;
+                in    = _stream->buffers[0];
+            }
+
+            for (i = 0; i < n; i++)
+            {
+                stage->apply((unsigned char*)in + (i * size),
+                             stage->context);
+            }
+
+            break;
+
+        case D_STREAM_STAGE_TAKE:
+            if (n >= stage->remaining)
+            {
+                n                 = stage->remaining;
+                _stream->finished = true;
+            }
+
+            stage->remaining -= n;
+
+            break;
+
+        case D_STREAM_STAGE_SKIP:
+            kept              = (n < stage->remaining) ? n : stage->remaining;
+            stage->remaining -= kept;
+            in               += kept * size;
+            n                -= kept;
+
+            break;
+
+        default:
+            return false;
+        }
+    }
+
+    *_data  = in;
+    *_count = n;
+
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             IV.   CONSUMPTION                                           ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_functional_stream_next
+  Pulls chunks from the source through the stages until one produces
+output, and returns that output. Chunks the stages reduce to nothing are
+skipped.
+
+Parameter(s):
+  _stream: the stream.
+  _chunk:  receives the output chunk; valid until the next call or until
+           the stream is freed.
+  _count:  receives the number of elements in the chunk; 0 at the end.
+Return:
+  A boolean value corresponding to either:
+  - true, if a chunk (or the end of the stream) was returned, or
+  - false, if a parameter was NULL, the stream was in an error state, or
+    the source or a stage failed; error_code is then set.
+*/
+bool
+d_functional_stream_next
+(
+    struct d_functional_stream* _stream,
+    const void**                _chunk,
+    size_t*                     _count
+)
+{
+    const void*          pulled;
+    const unsigned char* data;
+    size_t               n;
+
+    // validate parameters
+    if ( (!_stream)                  ||
+         (_stream->error_code != 0)  ||
+         (!_chunk)                   ||
+         (!_count) )
+    {
+        return false;
+    }
+
+    *_chunk = NULL;
+    *_count = 0;
+
+    // a take(0) is satisfied before anything is pulled
+    for (n = 0; n < _stream->stage_count; n++)
+    {
+        if ( (_stream->stages[n].kind == D_STREAM_STAGE_TAKE) &&
+             (_stream->stages[n].remaining == 0) )
+        {
+            _stream->finished = true;
+        }
+    }
+
+    while (!_stream->finished)
+    {
+        if (!d_functional_source_next(&_stream->source, &pulled, &n))
+        {
+            _stream->error_code = -1;
+
+            return false;
+        }
+
+        if (n == 0)
+        {
+            _stream->finished = true;
+
+            break;
+        }
+
+        if (!d_stream_reserve(_stream, n))
+        {
+            _stream->error_code = -1;
+
+            return false;
+        }
+
+        data = (const unsigned char*)pulled;
+
+        if (!d_stream_run_stages(_stream, &data, &n))
+        {
+            _stream->error_code = -1;
+
+            return false;
+        }
+
+        if (n > 0)
+        {
+            *_chunk = data;
+            *_count = n;
+
+            return true;
+        }
+    }
+
+    return true;
+}
+
+
+/*
+d_stream_source_next
+  Internal fn_source_next adapting a stream to a source.
+*/
+static bool
+d_stream_source_next
+(
+    void*        _context,
+    const void** _chunk,
+    size_t*      _count
+)
+{
+    return d_functional_stream_next((struct d_functional_stream*)_context,
+                                    _chunk,
+                                    _count);
+}
+
+
+/*
+d_functional_stream_source
+  Returns a source yielding a stream's output, so that a stream can feed
+another stream or a d_filter_stream.
+
+Parameter(s):
+  _stream: the stream; must outlive the source.
+Return:
+  The source, whose next_chunk is NULL if _stream is NULL.
+*/
+struct d_functional_source
+d_functional_stream_source
+(
+    struct d_functional_stream* _stream
+)
+{
+    struct d_functional_source source;
+
+    source.next_chunk   = (_stream) ? d_stream_source_next : NULL;
+    source.context      = _stream;
+    source.element_size = (_stream) ? _stream->source.element_size : 0;
+
+    return source;
+}
+
+
+/*
+d_functional_stream_fold
+  Drains a stream into a left fold. The accumulator carries across chunks.
+
+Parameter(s):
+  _stream:      the stream.
+  _accumulator: initial value and result of the fold.
+  _combine:     accumulator function.
+  _context:     context forwarded to _combine; may be NULL.
+Return:
+  A boolean value corresponding to either:
+  - true, if the whole stream was folded, or
+  - false, if a parameter was NULL or the stream or an accumulation
+    failed.
+*/
+bool
+d_functional_stream_fold
+(
+    struct d_functional_stream* _stream,
+    void*                       _accumulator,
+    fn_accumulator              _combine,
+    void*                       _context
+)
+{
+    const void* chunk;
+    size_t      n;
+
+    // validate parameters
+    if ( (!_stream)      ||
+         (!_accumulator) ||
+         (!_combine) )
+    {
+        return false;
+    }
+
+    while (d_functional_stream_next(_stream, &chunk, &n))
+    {
+        if (n == 0)
+        {
+            return true;
+        }
+
+        if (!d_functional_fold_left(chunk,
+                                    n,
+                                    _stream->source.element_size,
+                                    _accumulator,
+                                    _combine,
+                                    _context))
+        {
+            _stream->error_code = -1;
+
+            return false;
+        }
+    }
+
+    return false;
+}
+
+
+/*
+d_functional_stream_fold_multi
+  Drains a stream into several accumulators at once (see
+d_functional_fold_multi). Every accumulator carries across chunks.
+
+Parameter(s):
+  _stream:     the stream.
+  _specs:      the aggregates.
+  _spec_count: number of aggregates.
+Return:
+  A boolean value corresponding to either:
+  - true, if the whole stream was folded, or
+  - false, if a parameter was NULL/zero or the stream or an accumulation
+    failed.
+*/
+bool
+d_functional_stream_fold_multi
+(
+    struct d_functional_stream* _stream,
+    const struct d_fold_spec*   _specs,
+    size_t                      _spec_count
+)
+{
+    const void* chunk;
+    size_t      n;
+
+    // validate parameters
+    if ( (!_stream) ||
+         (!_specs)  ||
+         (_spec_count == 0) )
+    {
+        return false;
+    }
+
+    while (d_functional_stream_next(_stream, &chunk, &n))
+    {
+        if (n == 0)
+        {
+            return true;
+        }
+
+        if (!d_functional_fold_multi(chunk,
+                                     n,
+                                     _stream->source.element_size,
+                                     _specs,
+                                     _spec_count))
+        {
+            _stream->error_code = -1;
+
+            return false;
+        }
+    }
+
+    return false;
+}
+
+
+/*
+d_functional_stream_collect
+  Drains a stream into one newly allocated array. Memory use is bounded by
+the size of the output, not of the input.
+
+Parameter(s):
+  _stream:    the stream.
+  _out_count: receives the number of elements; may be NULL.
+Return:
+  A pointer to the array, which the caller must free, or NULL on failure.
+An empty output is returned as a non-NULL allocation with a count of 0.
+*/
+void*
+d_functional_stream_collect
+(
+    struct d_functional_stream* _stream,
+    size_t*                     _out_count
+)
+{
+    unsigned char* result;
+    unsigned char* grown;
+    const void*    chunk;
+    size_t         count;
+    size_t         capacity;
+    size_t         size;
+    size_t         n;
+
+    if (_out_count)
+    {
+        *_out_count = 0;
+    }
+
+    if (!_stream)
+    {
+        return NULL;
+    }
+
+    size     = _stream->source.element_size;
+    count    = 0;
+    capacity = 16;
+    result   = d_functional_malloc(capacity * size);
+
+    // ensure that memory allocation was successful
+    if (!result)
+    {
+        return NULL;
+    }
+
+    while (d_functional_stream_next(_stream, &chunk, &n))
+    {
+        if (n == 0)
+        {
+            if (_out_count)
+            {
+                *_out_count = count;
+            }
+
+            return result;
+        }
+
+        if (count + n > capacity)
+        {
+            while (count + n > capacity)
+            {
+                capacity *= 2;
+            }
+
+            grown = d_functional_realloc(result, capacity * size);
+
+            // ensure that memory allocation was successful
+            if (!grown)
+            {
+                break;
+            }
+
+            result = grown;
+        }
+
+        memcpy(result + (count * size), chunk, n * size);
+        count += n;
+    }
+
+    d_functional_free(result);
+
+    return NULL;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///             V.    CLEANUP                                               ///
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+d_functional_stream_free
+  Frees a stream, its stages, and its working buffers. Does not touch the
+source.
+
+Parameter(s):
+  _stream: the stream to free; may be NULL.
+Return:
+  none.
+*/
+void
+d_functional_stream_free
+(
+    struct d_functional_stream* _stream
+)
+{
+    if (!_stream)
+    {
+        return;
+    }
+
+    d_functional_free(_stream->stages);
+    d_functional_free(_stream->buffers[0]);
+    d_functional_free(_stream->buffers[1]);
+    d_functional_free(_stream);
+
+    return;
+}
@@ -0,0 +1,27 @@
+#include ".\allocator_tests_sa.h"
+
+
+/*
+d_tests_sa_allocator_run_all
+  Module-level aggregation function that runs all allocator tests.
+  Executes tests for all categories:
+  - Installation: initialization, the global allocator, scopes, and
+    releasing blocks
+  - Accounting: counters, callbacks, arenas, and the routing of the library
+*/
+bool
+d_tests_sa_allocator_run_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    // run all test categories
+    result = d_tests_sa_allocator_install_all(_counter)    && result;
+    result = d_tests_sa_allocator_accounting_all(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,62 @@
+/******************************************************************************
+* djinterp [test]                                        allocator_tests_sa.h
+*
+*   Unit test declarations for `allocator.h` module.
+*   Provides testing of allocator installation (initialization, the global
+* allocator, per-thread scopes, releasing blocks after a scope ends) and of
+* allocation accounting (counters, emulated reallocation, arenas, and the
+* routing of filter chains, pipelines, fn_builders, and parallel grouped
+* folds through the current allocator).
+*
+*
+* path:      \tests\functional\allocator_tests_sa.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_TESTS_ALLOCATOR_SA_
+#define DJINTERP_TESTS_ALLOCATOR_SA_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "..\..\inc\djinterp.h"
+#include "..\..\inc\test\test_standalone.h"
+#include "..\..\inc\functional\functional.h"
+#include "..\..\inc\functional\filter.h"
+#include "..\..\inc\functional\allocator.h"
+
+
+/******************************************************************************
+ * I. INSTALLATION TESTS
+ *****************************************************************************/
+bool d_tests_sa_allocator_install_init(struct d_test_counter* _counter);
+bool d_tests_sa_allocator_install_scope(struct d_test_counter* _counter);
+bool d_tests_sa_allocator_install_release(struct d_test_counter* _counter);
+bool d_tests_sa_allocator_install_cross_scope(struct d_test_counter* _counter);
+
+// I.   aggregation function
+bool d_tests_sa_allocator_install_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * II. ACCOUNTING TESTS
+ *****************************************************************************/
+bool d_tests_sa_allocator_accounting_counters(struct d_test_counter* _counter);
+bool d_tests_sa_allocator_accounting_callbacks(struct d_test_counter* _counter);
+bool d_tests_sa_allocator_accounting_arena(struct d_test_counter* _counter);
+bool d_tests_sa_allocator_accounting_library(struct d_test_counter* _counter);
+bool d_tests_sa_allocator_accounting_shared(struct d_test_counter* _counter);
+
+// II.  aggregation function
+bool d_tests_sa_allocator_accounting_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * MODULE-LEVEL AGGREGATION
+ *****************************************************************************/
+bool d_tests_sa_allocator_run_all(struct d_test_counter* _counter);
+
+
+#endif  // DJINTERP_TESTS_ALLOCATOR_SA_
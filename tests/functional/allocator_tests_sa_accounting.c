@@ -0,0 +1,617 @@
+#include ".\allocator_tests_sa.h"
+
+
+// allocator_test_state
+//   helper: what the test callbacks have seen, and whether to fail.
+struct allocator_test_state
+{
+    size_t allocate_calls;
+    size_t deallocate_calls;
+    bool   fail;
+};
+
+// allocator_test_allocate
+//   helper: fn_allocate over malloc, counting calls.
+static void*
+allocator_test_allocate
+(
+    size_t _size,
+    void*  _context
+)
+{
+    struct allocator_test_state* state;
+
+    state = (struct allocator_test_state*)_context;
+    state->allocate_calls++;
+
+    return (state->fail) ? NULL : malloc(_size);
+}
+
+// allocator_test_deallocate
+//   helper: fn_deallocate over free, counting calls.
+static void
+allocator_test_deallocate
+(
+    void* _block,
+    void* _context
+)
+{
+    struct allocator_test_state* state;
+
+    state = (struct allocator_test_state*)_context;
+    state->deallocate_calls++;
+
+    free(_block);
+
+    return;
+}
+
+// allocator_is_even
+//   helper: predicate for even ints.
+static bool
+allocator_is_even
+(
+    const void* _element,
+    void*       _context
+)
+{
+    (void)_context;
+
+    return ((*(const int*)_element) % 2) == 0;
+}
+
+// allocator_double
+//   helper: transformer doubling an int.
+static bool
+allocator_double
+(
+    const void* _input,
+    void*       _output,
+    void*       _context
+)
+{
+    (void)_context;
+
+    *(int*)_output = (*(const int*)_input) * 2;
+
+    return true;
+}
+
+// allocator_key_mod
+//   helper: key transformer writing an int modulo 7.
+static bool
+allocator_key_mod
+(
+    const void* _input,
+    void*       _output,
+    void*       _context
+)
+{
+    (void)_context;
+
+    *(int*)_output = (*(const int*)_input) % 7;
+
+    return true;
+}
+
+// allocator_sum
+//   helper: accumulator and combiner summing ints.
+static bool
+allocator_sum
+(
+    void*       _accumulated,
+    const void* _element,
+    void*       _context
+)
+{
+    (void)_context;
+
+    *(int*)_accumulated += *(const int*)_element;
+
+    return true;
+}
+
+// allocator_chain
+//   helper: where(is_even) -> take_first(3), built under the current
+// allocator.
+static struct d_filter_chain*
+allocator_chain
+(
+    void
+)
+{
+    struct d_filter_chain*     chain;
+    struct d_filter_operation* op;
+
+    chain = d_filter_chain_new();
+
+    if (!chain)
+    {
+        return NULL;
+    }
+
+    op = d_filter_where(allocator_is_even);
+    d_filter_chain_add(chain, op);
+    d_functional_free(op);
+
+    op = d_filter_take_first(3);
+    d_filter_chain_add(chain, op);
+    d_functional_free(op);
+
+    return chain;
+}
+
+
+/*
+d_tests_sa_allocator_accounting_counters
+  Tests the counters of an allocator over the C library.
+  Tests the following:
+  - allocations, reallocations, and frees are counted
+  - bytes allocated, live bytes, and the high-water mark
+  - calloc zeroes, and rejects overflowing sizes
+  - realloc keeps the contents
+*/
+bool
+d_tests_sa_allocator_accounting_counters
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_functional_allocator       allocator;
+    struct d_functional_allocator*      previous;
+    struct d_functional_allocator_stats stats;
+    unsigned char*                      a;
+    unsigned char*                      b;
+    unsigned char*                      grown;
+    bool                                result;
+
+    result = true;
+
+    d_functional_allocator_init(&allocator, NULL, NULL, NULL, NULL, false);
+    previous = d_functional_allocator_push(&allocator);
+
+    a = d_functional_malloc(100);
+    b = d_functional_calloc(10, 4);
+
+    // test 1: calloc
+    result = d_assert_standalone(
+        (a != NULL) && (b != NULL) &&
+        (b[0] == 0) && (b[39] == 0) &&
+        (d_functional_calloc((size_t)-1, 2) == NULL),
+        "allocator_counters_calloc",
+        "calloc should zero its block and reject overflowing sizes",
+        _counter) && result;
+
+    // test 2: realloc
+    if (a)
+    {
+        memset(a, 0x5a, 100);
+    }
+
+    grown = d_functional_realloc(a, 200);
+
+    result = d_assert_standalone(
+        (grown != NULL) &&
+        (grown[0] == 0x5a) && (grown[99] == 0x5a),
+        "allocator_counters_realloc",
+        "realloc should keep the contents",
+        _counter) && result;
+
+    d_functional_allocator_get_stats(&allocator, &stats);
+
+    // test 3: while live
+    result = d_assert_standalone(
+        (stats.allocations == 2) &&
+        (stats.reallocations == 1) &&
+        (stats.frees == 0) &&
+        (stats.bytes_allocated == 340) &&
+        (stats.bytes_live == 240) &&
+        (stats.high_water == 240),
+        "allocator_counters_live",
+        "the counters should follow allocations and resizes",
+        _counter) && result;
+
+    d_functional_free(grown);
+    d_functional_free(b);
+    d_functional_allocator_get_stats(&allocator, &stats);
+
+    // test 4: released
+    result = d_assert_standalone(
+        (stats.frees == 2) &&
+        (stats.bytes_live == 0) &&
+        (stats.high_water == 240) &&
+        (stats.failures == 0),
+        "allocator_counters_released",
+        "releasing should clear the live bytes but keep the high-water mark",
+        _counter) && result;
+
+    // test 5: reset
+    d_functional_allocator_reset_stats(&allocator);
+
+    result = d_assert_standalone(
+        (allocator.stats.allocations == 0) &&
+        (allocator.stats.high_water == 0),
+        "allocator_counters_reset",
+        "resetting should zero every counter",
+        _counter) && result;
+
+    d_functional_allocator_pop(previous);
+    d_functional_allocator_destroy(&allocator);
+
+    return result;
+}
+
+/*
+d_tests_sa_allocator_accounting_callbacks
+  Tests an allocator over custom callbacks.
+  Tests the following:
+  - every request reaches the callbacks with their context
+  - without a reallocate callback, realloc moves the block
+  - failures are counted and leave the block intact
+*/
+bool
+d_tests_sa_allocator_accounting_callbacks
+(
+    struct d_test_counter* _counter
+)
+{
+    struct allocator_test_state    state;
+    struct d_functional_allocator  allocator;
+    struct d_functional_allocator* previous;
+    unsigned char*                 block;
+    unsigned char*                 moved;
+    bool                           result;
+
+    result = true;
+
+    memset(&state, 0, sizeof(state));
+    d_functional_allocator_init(&allocator,
+                                allocator_test_allocate,
+                                NULL,
+                                allocator_test_deallocate,
+                                &state,
+                                false);
+    previous = d_functional_allocator_push(&allocator);
+
+    block = d_functional_malloc(16);
+
+    if (block)
+    {
+        memset(block, 0x33, 16);
+    }
+
+    moved = d_functional_realloc(block, 64);
+
+    // test 1: emulated realloc
+    result = d_assert_standalone(
+        (moved != NULL) &&
+        (moved[0] == 0x33) && (moved[15] == 0x33) &&
+        (state.allocate_calls == 2) &&
+        (state.deallocate_calls == 1) &&
+        (allocator.stats.allocations == 2) &&
+        (allocator.stats.frees == 1) &&
+        (allocator.stats.bytes_live == 64),
+        "allocator_callbacks_realloc",
+        "realloc should move the block through the callbacks",
+        _counter) && result;
+
+    // test 2: failure
+    state.fail = true;
+
+    result = d_assert_standalone(
+        (d_functional_malloc(8) == NULL) &&
+        (d_functional_realloc(moved, 128) == NULL) &&
+        (allocator.stats.failures == 2) &&
+        (moved != NULL) && (moved[15] == 0x33) &&
+        (allocator.stats.bytes_live == 64),
+        "allocator_callbacks_failure",
+        "failures should be counted and leave the block intact",
+        _counter) && result;
+
+    state.fail = false;
+    d_functional_free(moved);
+
+    result = d_assert_standalone(
+        (state.deallocate_calls == 2) &&
+        (allocator.stats.bytes_live == 0),
+        "allocator_callbacks_free",
+        "free should reach the deallocate callback",
+        _counter) && result;
+
+    d_functional_allocator_pop(previous);
+    d_functional_allocator_destroy(&allocator);
+
+    return result;
+}
+
+/*
+d_tests_sa_allocator_accounting_arena
+  Tests running a filter chain entirely out of an arena.
+  Tests the following:
+  - every allocation of the chain comes from the arena
+  - the result is unchanged
+  - releasing is free, and the arena reclaims everything on reset
+*/
+bool
+d_tests_sa_allocator_accounting_arena
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_fn_arena*             arena;
+    struct d_functional_allocator  allocator;
+    struct d_functional_allocator* previous;
+    struct d_filter_chain*         chain;
+    struct d_filter_result*        filtered;
+    int                            input[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    bool                           result;
+
+    result = true;
+    arena  = d_fn_arena_new(0);
+
+    d_functional_allocator_init_arena(&allocator, arena);
+    previous = d_functional_allocator_push(&allocator);
+
+    chain    = allocator_chain();
+    filtered = d_filter_apply_chain(chain, input, 10, sizeof(int));
+
+    // test 1: result
+    result = d_assert_standalone(
+        (filtered != NULL) && (filtered->count == 3) &&
+        (((int*)filtered->elements)[2] == 4),
+        "allocator_arena_result",
+        "a chain run from an arena should give the same result",
+        _counter) && result;
+
+    // test 2: all from the arena
+    result = d_assert_standalone(
+        (arena != NULL) &&
+        (allocator.stats.allocations > 0) &&
+        (arena->allocations == allocator.stats.allocations) &&
+        (allocator.stats.failures == 0),
+        "allocator_arena_routed",
+        "every allocation of the chain should come from the arena",
+        _counter) && result;
+
+    d_filter_result_free(filtered);
+    d_functional_free(filtered);
+    d_filter_chain_free(chain);
+
+    // test 3: released
+    result = d_assert_standalone(
+        (allocator.stats.frees == allocator.stats.allocations) &&
+        (allocator.stats.bytes_live == 0) &&
+        (allocator.stats.high_water > 0),
+        "allocator_arena_released",
+        "every block should be released back to the arena",
+        _counter) && result;
+
+    d_functional_allocator_pop(previous);
+
+    // test 4: recycled
+    d_fn_arena_reset(arena);
+    d_functional_allocator_reset_stats(&allocator);
+
+    result = d_assert_standalone(
+        (arena->allocations == 0) &&
+        (allocator.stats.allocations == 0),
+        "allocator_arena_recycled",
+        "the arena and its allocator should be reusable after a reset",
+        _counter) && result;
+
+    d_functional_allocator_destroy(&allocator);
+    d_fn_arena_free(arena);
+
+    return result;
+}
+
+/*
+d_tests_sa_allocator_accounting_library
+  Tests that pipelines, fn_builders, and predicate registries allocate
+through the current allocator.
+  Tests the following:
+  - their allocations are counted
+  - everything they allocate is released through it
+  - the global predicate registry stays outside it
+*/
+bool
+d_tests_sa_allocator_accounting_library
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_functional_allocator  allocator;
+    struct d_functional_allocator* previous;
+    struct d_functional_pipeline   pipe;
+    struct d_fn_builder*           builder;
+    struct d_predicate_registry*   registry;
+    struct d_registry_arg          arg;
+    fn_predicate                   test;
+    void*                          context;
+    int                            input[6] = { 1, 2, 3, 4, 5, 6 };
+    int                            output[6];
+    size_t                         count;
+    size_t                         after_pipeline;
+    size_t                         after_builder;
+    bool                           ok;
+    bool                           result;
+
+    result = true;
+
+    d_functional_allocator_init(&allocator, NULL, NULL, NULL, NULL, false);
+    previous = d_functional_allocator_push(&allocator);
+
+    // test 1: pipeline
+    pipe = d_functional_pipeline_begin_copy(input, 6, sizeof(int));
+    pipe = d_functional_pipeline_map(pipe, allocator_double, NULL);
+    pipe = d_functional_pipeline_filter(pipe, allocator_is_even, NULL);
+    d_functional_pipeline_free(&pipe);
+
+    after_pipeline = allocator.stats.allocations;
+
+    result = d_assert_standalone(
+        (after_pipeline >= 1) &&
+        (allocator.stats.frees == after_pipeline) &&
+        (allocator.stats.bytes_live == 0),
+        "allocator_library_pipeline",
+        "a pipeline should allocate and release through the allocator",
+        _counter) && result;
+
+    // test 2: fn_builder
+    builder = d_fn_builder_new();
+    d_funtional_builder_map(builder, allocator_double);
+    d_funtional_builder_filter(builder, allocator_is_even);
+    ok = d_fn_builder_execute(builder, input, 6, sizeof(int), output, &count);
+    d_fn_builder_free(builder);
+
+    result = d_assert_standalone(
+        (ok) && (count == 6) && (output[5] == 12) &&
+        (allocator.stats.allocations > after_pipeline) &&
+        (allocator.stats.frees == allocator.stats.allocations) &&
+        (allocator.stats.bytes_live == 0),
+        "allocator_library_fn_builder",
+        "an fn_builder should allocate and release through the allocator",
+        _counter) && result;
+
+    // test 3: predicate registry
+    after_builder = allocator.stats.allocations;
+    arg.is_real   = false;
+    arg.integer   = 3;
+    arg.real      = 0.0;
+    registry      = d_predicate_registry_new();
+    ok            = (registry)                                            &&
+                    (d_predicate_registry_add_builtins(registry))         &&
+                    (d_predicate_registry_predicate(registry, "gt_i32", 6,
+                                                    &arg, 1,
+                                                    &test, &context))     &&
+                    (test(&input[3], context));
+    d_predicate_registry_free(registry);
+
+    result = d_assert_standalone(
+        (ok) &&
+        (allocator.stats.allocations > after_builder) &&
+        (allocator.stats.frees == allocator.stats.allocations) &&
+        (allocator.stats.bytes_live == 0),
+        "allocator_library_predicate_registry",
+        "a registry should allocate and release through the allocator",
+        _counter) && result;
+
+    // test 4: the global registry outlives the scope, so bypasses it
+    after_builder = allocator.stats.allocations;
+    registry      = d_predicate_registry_global();
+    ok            = (registry) &&
+                    (d_predicate_registry_predicate(registry, "lt_i32", 6,
+                                                    &arg, 1,
+                                                    &test, &context));
+
+    result = d_assert_standalone(
+        (ok) &&
+        (allocator.stats.allocations == after_builder),
+        "allocator_library_global_registry",
+        "the global registry should not allocate through the allocator",
+        _counter) && result;
+
+    d_functional_allocator_pop(previous);
+    d_functional_allocator_destroy(&allocator);
+
+    return result;
+}
+
+/*
+d_tests_sa_allocator_accounting_shared
+  Tests a shared allocator under d_functional_group_fold_parallel.
+  Tests the following:
+  - the worker threads allocate from the caller's allocator
+  - every block is released through it
+*/
+bool
+d_tests_sa_allocator_accounting_shared
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_functional_allocator  allocator;
+    struct d_functional_allocator* previous;
+    struct d_group_table*          table;
+    int                            input[1000];
+    int                            zero;
+    int                            i;
+    size_t                         allocations;
+    bool                           result;
+
+    result = true;
+    zero   = 0;
+
+    for (i = 0; i < 1000; i++)
+    {
+        input[i] = i;
+    }
+
+    // test 1: initialization
+    result = d_assert_standalone(
+        d_functional_allocator_init(&allocator, NULL, NULL, NULL, NULL, true) &&
+        (allocator.shared),
+        "allocator_shared_init",
+        "a shared allocator should be initialized with its mutex",
+        _counter) && result;
+
+    previous = d_functional_allocator_push(&allocator);
+
+    table = d_functional_group_fold_parallel(input, 1000, sizeof(int),
+                                             allocator_key_mod, sizeof(int),
+                                             NULL, NULL, NULL,
+                                             allocator_sum, allocator_sum,
+                                             &zero, sizeof(int), NULL, 4);
+    allocations = allocator.stats.allocations;
+
+    // test 2: routed
+    result = d_assert_standalone(
+        (table != NULL) && (table->count == 7) &&
+        (allocations > 0) &&
+        (allocator.stats.failures == 0),
+        "allocator_shared_routed",
+        "the grouped fold should allocate from the caller's allocator",
+        _counter) && result;
+
+    d_group_table_free(table);
+
+    // test 3: released
+    result = d_assert_standalone(
+        (allocator.stats.frees == allocator.stats.allocations) &&
+        (allocator.stats.bytes_live == 0),
+        "allocator_shared_released",
+        "every block of every thread should be released through it",
+        _counter) && result;
+
+    d_functional_allocator_pop(previous);
+    d_functional_allocator_destroy(&allocator);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_allocator_accounting_all
+  Aggregation function that runs all accounting tests.
+*/
+bool
+d_tests_sa_allocator_accounting_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Accounting\n");
+    printf("  --------------------\n");
+
+    result = d_tests_sa_allocator_accounting_counters(_counter)  && result;
+    result = d_tests_sa_allocator_accounting_callbacks(_counter) && result;
+    result = d_tests_sa_allocator_accounting_arena(_counter)     && result;
+    result = d_tests_sa_allocator_accounting_library(_counter)   && result;
+    result = d_tests_sa_allocator_accounting_shared(_counter)    && result;
+
+    return result;
+}
@@ -0,0 +1,333 @@
+#include ".\allocator_tests_sa.h"
+
+
+/*
+d_tests_sa_allocator_install_init
+  Tests d_functional_allocator_init and d_functional_allocator_init_arena.
+  Tests the following:
+  - NULL allocators and arenas are rejected
+  - a NULL allocate callback selects the C library
+  - counters start at zero
+*/
+bool
+d_tests_sa_allocator_install_init
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_functional_allocator allocator;
+    struct d_fn_arena*            arena;
+    bool                          result;
+
+    result = true;
+
+    // test 1: NULL
+    result = d_assert_standalone(
+        (!d_functional_allocator_init(NULL, NULL, NULL, NULL, NULL, false)) &&
+        (!d_functional_allocator_init_arena(&allocator, NULL)),
+        "allocator_init_null",
+        "NULL allocators and arenas should be rejected",
+        _counter) && result;
+
+    // test 2: C library
+    result = d_assert_standalone(
+        d_functional_allocator_init(&allocator, NULL, NULL, NULL, NULL,
+                                    false) &&
+        (allocator.allocate != NULL) &&
+        (allocator.reallocate != NULL) &&
+        (allocator.deallocate != NULL) &&
+        (allocator.stats.allocations == 0) &&
+        (allocator.stats.high_water == 0),
+        "allocator_init_system",
+        "a NULL allocate callback should select the C library",
+        _counter) && result;
+
+    d_functional_allocator_destroy(&allocator);
+
+    // test 3: arena
+    arena = d_fn_arena_new(0);
+
+    result = d_assert_standalone(
+        d_functional_allocator_init_arena(&allocator, arena) &&
+        (allocator.context == arena) &&
+        (allocator.reallocate == NULL) &&
+        (allocator.deallocate == NULL) &&
+        (!allocator.shared),
+        "allocator_init_arena",
+        "an arena allocator should allocate only, from the arena",
+        _counter) && result;
+
+    d_functional_allocator_destroy(&allocator);
+    d_fn_arena_free(arena);
+
+    return result;
+}
+
+/*
+d_tests_sa_allocator_install_scope
+  Tests d_functional_allocator_set_global, d_functional_allocator_push,
+d_functional_allocator_pop, and d_functional_allocator_current.
+  Tests the following:
+  - no allocator is current by default
+  - the global allocator is current without a scope
+  - a pushed allocator overrides it until popped
+  - pushing NULL falls back to the global allocator
+*/
+bool
+d_tests_sa_allocator_install_scope
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_functional_allocator  global;
+    struct d_functional_allocator  scoped;
+    struct d_functional_allocator* outer;
+    struct d_functional_allocator* inner;
+    bool                           result;
+
+    result = true;
+
+    d_functional_allocator_init(&global, NULL, NULL, NULL, NULL, false);
+    d_functional_allocator_init(&scoped, NULL, NULL, NULL, NULL, false);
+
+    // test 1: default
+    result = d_assert_standalone(
+        d_functional_allocator_current() == NULL,
+        "allocator_scope_default",
+        "no allocator should be current by default",
+        _counter) && result;
+
+    // test 2: global
+    result = d_assert_standalone(
+        (d_functional_allocator_set_global(&global) == NULL) &&
+        (d_functional_allocator_current() == &global),
+        "allocator_scope_global",
+        "the global allocator should be current without a scope",
+        _counter) && result;
+
+    // test 3: scopes
+    outer = d_functional_allocator_push(&scoped);
+
+    result = d_assert_standalone(
+        (outer == NULL) &&
+        (d_functional_allocator_current() == &scoped),
+        "allocator_scope_push",
+        "a pushed allocator should override the global one",
+        _counter) && result;
+
+    inner = d_functional_allocator_push(NULL);
+
+    result = d_assert_standalone(
+        (inner == &scoped) &&
+        (d_functional_allocator_current() == &global),
+        "allocator_scope_push_null",
+        "pushing NULL should fall back to the global allocator",
+        _counter) && result;
+
+    d_functional_allocator_pop(inner);
+
+    result = d_assert_standalone(
+        d_functional_allocator_current() == &scoped,
+        "allocator_scope_pop_inner",
+        "popping should restore the enclosing scope",
+        _counter) && result;
+
+    d_functional_allocator_pop(outer);
+
+    // test 4: removed
+    result = d_assert_standalone(
+        (d_functional_allocator_current() == &global) &&
+        (d_functional_allocator_set_global(NULL) == &global) &&
+        (d_functional_allocator_current() == NULL),
+        "allocator_scope_removed",
+        "removing the global allocator should restore the C library",
+        _counter) && result;
+
+    d_functional_allocator_destroy(&scoped);
+    d_functional_allocator_destroy(&global);
+
+    return result;
+}
+
+/*
+d_tests_sa_allocator_install_release
+  Tests d_functional_free and d_functional_allocator_release.
+  Tests the following:
+  - blocks without an allocator come from the C library, uncounted
+  - a block kept after its scope is released to its allocator
+  - NULL blocks are ignored
+*/
+bool
+d_tests_sa_allocator_install_release
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_functional_allocator  allocator;
+    struct d_functional_allocator* previous;
+    char*                          plain;
+    char*                          kept;
+    bool                           result;
+
+    result = true;
+
+    d_functional_allocator_init(&allocator, NULL, NULL, NULL, NULL, false);
+
+    // test 1: no allocator
+    plain = d_functional_malloc(8);
+
+    result = d_assert_standalone(
+        (plain != NULL) &&
+        (allocator.stats.allocations == 0),
+        "allocator_release_plain",
+        "without an allocator, blocks should come from the C library",
+        _counter) && result;
+
+    d_functional_free(plain);
+
+    // test 2: kept after the scope
+    previous = d_functional_allocator_push(&allocator);
+    kept     = d_functional_malloc(32);
+    d_functional_allocator_pop(previous);
+
+    if (kept)
+    {
+        memset(kept, 'k', 32);
+    }
+
+    d_functional_allocator_release(&allocator, kept);
+
+    result = d_assert_standalone(
+        (kept != NULL) &&
+        (allocator.stats.allocations == 1) &&
+        (allocator.stats.frees == 1) &&
+        (allocator.stats.bytes_live == 0) &&
+        (allocator.stats.high_water == 32),
+        "allocator_release_kept",
+        "a block kept after its scope should go back to its allocator",
+        _counter) && result;
+
+    // test 3: NULL
+    d_functional_free(NULL);
+    d_functional_allocator_release(&allocator, NULL);
+
+    result = d_assert_standalone(
+        allocator.stats.frees == 1,
+        "allocator_release_null",
+        "NULL blocks should be ignored",
+        _counter) && result;
+
+    d_functional_allocator_destroy(&allocator);
+
+    return result;
+}
+
+/*
+d_tests_sa_allocator_install_cross_scope
+  Tests objects used across allocator scopes.
+  Tests the following:
+  - a chain built without an allocator grows in a scope and stays with the
+    C library
+  - a result built in a scope is freed after it, back to its allocator
+*/
+bool
+d_tests_sa_allocator_install_cross_scope
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_functional_allocator  allocator;
+    struct d_functional_allocator* previous;
+    struct d_filter_chain*         chain;
+    struct d_filter_operation*     op;
+    struct d_filter_result*        filtered;
+    int                            input[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    size_t                         i;
+    bool                           ok;
+    bool                           result;
+
+    result = true;
+
+    d_functional_allocator_init(&allocator, NULL, NULL, NULL, NULL, false);
+
+    // test 1: a chain from the C library grown inside a scope
+    chain    = d_filter_chain_new();
+    op       = d_filter_take_first(8);
+    ok       = (chain) && (op) && (d_filter_chain_add(chain, op));
+    previous = d_functional_allocator_push(&allocator);
+
+    for (i = 1; (ok) && (i < 64); i++)
+    {
+        ok = d_filter_chain_add(chain, op);
+    }
+
+    d_functional_allocator_pop(previous);
+    d_functional_free(op);
+
+    result = d_assert_standalone(
+        (ok) &&
+        (chain->count == 64) &&
+        (allocator.stats.allocations == 0) &&
+        (allocator.stats.reallocations == 0),
+        "allocator_cross_scope_grow",
+        "a chain should grow with the allocator it came from",
+        _counter) && result;
+
+    d_filter_chain_free(chain);
+
+    // test 2: a result from a scope freed after it
+    chain    = d_filter_chain_new();
+    op       = d_filter_take_first(3);
+    ok       = (chain) && (op) && (d_filter_chain_add(chain, op));
+    previous = d_functional_allocator_push(&allocator);
+    filtered = (ok) ? d_filter_apply_chain(chain, input, 8, sizeof(int))
+                    : NULL;
+    d_functional_allocator_pop(previous);
+
+    ok = (filtered) &&
+         (filtered->count == 3) &&
+         (allocator.stats.allocations > 0);
+
+    d_filter_result_free(filtered);
+    d_functional_free(filtered);
+    d_functional_free(op);
+    d_filter_chain_free(chain);
+
+    result = d_assert_standalone(
+        (ok) &&
+        (allocator.stats.frees == allocator.stats.allocations) &&
+        (allocator.stats.bytes_live == 0),
+        "allocator_cross_scope_free",
+        "a result freed after its scope should go back to its allocator",
+        _counter) && result;
+
+    d_functional_allocator_destroy(&allocator);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_allocator_install_all
+  Aggregation function that runs all installation tests.
+*/
+bool
+d_tests_sa_allocator_install_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Installation\n");
+    printf("  ----------------------\n");
+
+    result = d_tests_sa_allocator_install_init(_counter)        && result;
+    result = d_tests_sa_allocator_install_scope(_counter)       && result;
+    result = d_tests_sa_allocator_install_release(_counter)     && result;
+    result = d_tests_sa_allocator_install_cross_scope(_counter) && result;
+
+    return result;
+}
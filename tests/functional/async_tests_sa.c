@@ -0,0 +1,27 @@
+#include ".\async_tests_sa.h"
+
+
+/*
+d_tests_sa_async_run_all
+  Module-level aggregation function that runs all async tests.
+  Executes tests for all categories:
+  - Construction: sources, stages, stage groups, and errors before start
+  - Execution: fold, collect, for_each, backpressure, and errors while
+    running
+*/
+bool
+d_tests_sa_async_run_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    // run all test categories
+    result = d_tests_sa_async_construction_all(_counter) && result;
+    result = d_tests_sa_async_execution_all(_counter)    && result;
+
+    return result;
+}
@@ -0,0 +1,61 @@
+/******************************************************************************
+* djinterp [test]                                            async_tests_sa.h
+*
+*   Unit test declarations for `async.h` module.
+*   Provides testing of asynchronous pipeline construction (sources, stage
+* validation, stage groups and fusion, error propagation before start) and
+* of execution (fold and collect in source order across parallel workers,
+* for_each side effects, backpressure through small queues, errors raised
+* by callbacks or the source while running, and completion polling).
+*
+*
+* path:      \tests\functional\async_tests_sa.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_TESTS_ASYNC_SA_
+#define DJINTERP_TESTS_ASYNC_SA_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "..\..\inc\djinterp.h"
+#include "..\..\inc\test\test_standalone.h"
+#include "..\..\inc\functional\async.h"
+#include "..\..\inc\functional\functional_platform.h"
+#include "..\..\inc\functional\stream.h"
+
+
+/******************************************************************************
+ * I. CONSTRUCTION TESTS
+ *****************************************************************************/
+bool d_tests_sa_async_construction_new(struct d_test_counter* _counter);
+bool d_tests_sa_async_construction_stages(struct d_test_counter* _counter);
+bool d_tests_sa_async_construction_errors(struct d_test_counter* _counter);
+
+// I.   aggregation function
+bool d_tests_sa_async_construction_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * II. EXECUTION TESTS
+ *****************************************************************************/
+bool d_tests_sa_async_execution_fold(struct d_test_counter* _counter);
+bool d_tests_sa_async_execution_collect(struct d_test_counter* _counter);
+bool d_tests_sa_async_execution_for_each(struct d_test_counter* _counter);
+bool d_tests_sa_async_execution_backpressure(struct d_test_counter* _counter);
+bool d_tests_sa_async_execution_failure(struct d_test_counter* _counter);
+
+// II.  aggregation function
+bool d_tests_sa_async_execution_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * MODULE-LEVEL AGGREGATION
+ *****************************************************************************/
+bool d_tests_sa_async_run_all(struct d_test_counter* _counter);
+
+
+#endif  // DJINTERP_TESTS_ASYNC_SA_
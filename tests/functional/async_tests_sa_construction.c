@@ -0,0 +1,363 @@
+#include ".\async_tests_sa.h"
+
+
+// async_construction_negate
+//   helper: transformer negating an int.
+static bool
+async_construction_negate
+(
+    const void* _input,
+    void*       _output,
+    void*       _context
+)
+{
+    (void)_context;
+
+    *(int*)_output = -(*(const int*)_input);
+
+    return true;
+}
+
+// async_construction_positive
+//   helper: predicate for positive ints.
+static bool
+async_construction_positive
+(
+    const void* _element,
+    void*       _context
+)
+{
+    (void)_context;
+
+    return (*(const int*)_element) > 0;
+}
+
+// async_construction_touch
+//   helper: consumer doing nothing.
+static void
+async_construction_touch
+(
+    void* _element,
+    void* _context
+)
+{
+    (void)_element;
+    (void)_context;
+
+    return;
+}
+
+// async_construction_sum
+//   helper: accumulator adding ints.
+static bool
+async_construction_sum
+(
+    void*       _accumulated,
+    const void* _element,
+    void*       _context
+)
+{
+    (void)_context;
+
+    *(int*)_accumulated += *(const int*)_element;
+
+    return true;
+}
+
+
+/*
+d_tests_sa_async_construction_new
+  Tests d_functional_async_new and d_functional_async_free.
+  Tests the following:
+  - sources without a next_chunk callback are rejected
+  - a queue depth of 0 selects D_FUNCTIONAL_ASYNC_QUEUE_DEPTH
+  - a new pipeline has no stages, is not running, and has no error
+  - freeing NULL is a no-op
+*/
+bool
+d_tests_sa_async_construction_new
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_functional_array_source state;
+    struct d_functional_source       source;
+    struct d_functional_source       empty;
+    struct d_functional_async*       async;
+    int                              data[] = { 1, 2, 3 };
+    bool                             result;
+
+    result = true;
+
+    // test 1: invalid source
+    memset(&empty, 0, sizeof(empty));
+    empty.element_size = sizeof(int);
+
+    result = d_assert_standalone(
+        d_functional_async_new(empty, 0) == NULL,
+        "async_new_invalid_source",
+        "a source without next_chunk should be rejected",
+        _counter) && result;
+
+    // test 2: default depth
+    source = d_functional_source_array(&state, data, 3, sizeof(int), 2);
+    async  = d_functional_async_new(source, 0);
+
+    result = d_assert_standalone(
+        (async != NULL) &&
+        (async->queue_depth == D_FUNCTIONAL_ASYNC_QUEUE_DEPTH) &&
+        (async->group_count == 0) &&
+        (async->error_code == 0) &&
+        (!async->launched) &&
+        d_functional_async_ready(async),
+        "async_new_default",
+        "a new pipeline should be empty, idle, and use the default depth",
+        _counter) && result;
+
+    d_functional_async_free(async);
+
+    // test 3: explicit depth
+    async = d_functional_async_new(source, 1);
+
+    result = d_assert_standalone(
+        (async != NULL) &&
+        (async->queue_depth == 1),
+        "async_new_depth",
+        "an explicit queue depth should be kept",
+        _counter) && result;
+
+    d_functional_async_free(async);
+
+    // test 4: NULL
+    d_functional_async_free(NULL);
+
+    result = d_assert_standalone(
+        (d_functional_async_map(NULL, async_construction_negate, NULL,
+                                1) == NULL) &&
+        (!d_functional_async_start(NULL)) &&
+        (!d_functional_async_ready(NULL)) &&
+        (d_functional_async_wait(NULL) == -1),
+        "async_new_null",
+        "NULL pipelines should be ignored or rejected",
+        _counter) && result;
+
+    return result;
+}
+
+/*
+d_tests_sa_async_construction_stages
+  Tests d_functional_async_map, d_functional_async_filter, and
+d_functional_async_for_each.
+  Tests the following:
+  - a stage with workers starts a new group of that many workers
+  - a stage with 0 workers is fused into the previous group
+  - a first stage with 0 workers starts a group of one worker
+  - worker counts are capped at D_FUNCTIONAL_MAX_THREADS
+*/
+bool
+d_tests_sa_async_construction_stages
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_functional_array_source state;
+    struct d_functional_source       source;
+    struct d_functional_async*       async;
+    int                              data[] = { 1, 2, 3 };
+    bool                             result;
+
+    result = true;
+    source = d_functional_source_array(&state, data, 3, sizeof(int), 2);
+
+    // test 1: groups and fusion
+    async = d_functional_async_new(source, 0);
+    async = d_functional_async_map(async, async_construction_negate, NULL, 3);
+    async = d_functional_async_filter(async, async_construction_positive,
+                                      NULL, 0);
+    async = d_functional_async_for_each(async, async_construction_touch,
+                                        NULL, 1);
+
+    result = d_assert_standalone(
+        (async != NULL) &&
+        (async->error_code == 0) &&
+        (async->group_count == 2) &&
+        (async->groups[0].workers == 3) &&
+        (async->groups[0].stage_count == 2) &&
+        (async->groups[0].stages[1].kind == D_STREAM_STAGE_FILTER) &&
+        (async->groups[1].workers == 1) &&
+        (async->groups[1].stage_count == 1),
+        "async_stages_groups",
+        "stages with workers should start groups; others should fuse",
+        _counter) && result;
+
+    d_functional_async_free(async);
+
+    // test 2: first stage without workers
+    async = d_functional_async_new(source, 0);
+    async = d_functional_async_filter(async, async_construction_positive,
+                                      NULL, 0);
+
+    result = d_assert_standalone(
+        (async->group_count == 1) &&
+        (async->groups[0].workers == 1),
+        "async_stages_first_fused",
+        "a first stage without workers should get one worker",
+        _counter) && result;
+
+    d_functional_async_free(async);
+
+    // test 3: capped
+    async = d_functional_async_new(source, 0);
+    async = d_functional_async_map(async, async_construction_negate, NULL,
+                                   D_FUNCTIONAL_MAX_THREADS + 10);
+
+    result = d_assert_standalone(
+        async->groups[0].workers == D_FUNCTIONAL_MAX_THREADS,
+        "async_stages_capped",
+        "worker counts should be capped",
+        _counter) && result;
+
+    d_functional_async_free(async);
+
+    return result;
+}
+
+/*
+d_tests_sa_async_construction_errors
+  Tests error propagation before and at start.
+  Tests the following:
+  - a NULL callback sets error_code and later stages are no-ops
+  - an errored pipeline refuses to start and its wait reports the error
+  - invalid fold and collect arguments set error_code
+  - a pipeline starts at most once
+  - adding a stage to a started pipeline fails it
+*/
+bool
+d_tests_sa_async_construction_errors
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_functional_array_source state;
+    struct d_functional_source       source;
+    struct d_functional_async*       async;
+    int                              data[] = { 1, 2, 3 };
+    int                              sum;
+    bool                             result;
+
+    result = true;
+    source = d_functional_source_array(&state, data, 3, sizeof(int), 2);
+
+    // test 1: NULL callback
+    async = d_functional_async_new(source, 0);
+    async = d_functional_async_map(async, NULL, NULL, 1);
+    async = d_functional_async_filter(async, async_construction_positive,
+                                      NULL, 1);
+
+    result = d_assert_standalone(
+        (async->error_code == -1) &&
+        (async->group_count == 0),
+        "async_errors_null_callback",
+        "a NULL callback should set error_code and stop later stages",
+        _counter) && result;
+
+    // test 2: errored start
+    sum = 0;
+
+    result = d_assert_standalone(
+        (!d_functional_async_start_fold(async, &sum, async_construction_sum,
+                                        NULL)) &&
+        d_functional_async_ready(async) &&
+        (d_functional_async_wait(async) == -1) &&
+        (sum == 0),
+        "async_errors_start",
+        "an errored pipeline should not start and should report its error",
+        _counter) && result;
+
+    d_functional_async_free(async);
+
+    // test 3: invalid terminal arguments
+    async = d_functional_async_new(source, 0);
+
+    result = d_assert_standalone(
+        (!d_functional_async_start_fold(async, NULL, async_construction_sum,
+                                        NULL)) &&
+        (async->error_code == -1),
+        "async_errors_fold_arguments",
+        "a NULL accumulator should set error_code",
+        _counter) && result;
+
+    d_functional_async_free(async);
+
+    async = d_functional_async_new(source, 0);
+
+    result = d_assert_standalone(
+        (!d_functional_async_start_collect(async, NULL, NULL)) &&
+        (async->error_code == -1),
+        "async_errors_collect_arguments",
+        "a NULL output pointer should set error_code",
+        _counter) && result;
+
+    d_functional_async_free(async);
+
+    // test 4: started once
+    source = d_functional_source_array(&state, data, 3, sizeof(int), 2);
+    async  = d_functional_async_new(source, 0);
+    async  = d_functional_async_map(async, async_construction_negate, NULL,
+                                    1);
+    sum    = 0;
+
+    result = d_assert_standalone(
+        d_functional_async_start_fold(async, &sum, async_construction_sum,
+                                      NULL) &&
+        (!d_functional_async_start(async)) &&
+        (d_functional_async_wait(async) == 0) &&
+        (sum == -6),
+        "async_errors_started_once",
+        "a second start should be refused without disturbing the first",
+        _counter) && result;
+
+    d_functional_async_free(async);
+
+    // test 5: stage after start
+    source = d_functional_source_array(&state, data, 3, sizeof(int), 2);
+    async  = d_functional_async_new(source, 0);
+
+    d_functional_async_start(async);
+    d_functional_async_for_each(async, async_construction_touch, NULL, 1);
+
+    result = d_assert_standalone(
+        d_functional_async_wait(async) == -1,
+        "async_errors_stage_after_start",
+        "adding a stage to a started pipeline should fail it",
+        _counter) && result;
+
+    d_functional_async_free(async);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_async_construction_all
+  Aggregation function that runs all construction tests.
+*/
+bool
+d_tests_sa_async_construction_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Construction\n");
+    printf("  ----------------------\n");
+
+    result = d_tests_sa_async_construction_new(_counter)    && result;
+    result = d_tests_sa_async_construction_stages(_counter) && result;
+    result = d_tests_sa_async_construction_errors(_counter) && result;
+
+    return result;
+}
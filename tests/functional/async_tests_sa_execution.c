@@ -0,0 +1,695 @@
+#include ".\async_tests_sa.h"
+
+
+// ASYNC_EXECUTION_COUNT
+//   constant: number of ints the execution tests run through pipelines.
+#define ASYNC_EXECUTION_COUNT 2000
+
+// async_execution_order
+//   helper: fold state checking that elements arrive in increasing order.
+struct async_execution_order
+{
+    long long sum;
+    int       last;
+    bool      ordered;
+};
+
+// async_execution_counter
+//   helper: element counter shared by the workers of a for_each stage.
+struct async_execution_counter
+{
+    d_functional_mutex mutex;
+    size_t             count;
+};
+
+// async_execution_failing_source
+//   helper: source state failing after a number of chunks.
+struct async_execution_failing_source
+{
+    int    values[4];
+    size_t chunks_left;
+};
+
+// async_execution_slow_double
+//   helper: transformer doubling an int, spinning on every other run of 64
+// values so that parallel workers finish their chunks out of order.
+static bool
+async_execution_slow_double
+(
+    const void* _input,
+    void*       _output,
+    void*       _context
+)
+{
+    volatile int spin;
+    int          value;
+
+    (void)_context;
+
+    value = *(const int*)_input;
+
+    if (((value / 64) % 2) == 0)
+    {
+        for (spin = 0; spin < 2000; spin++)
+        {
+        }
+    }
+
+    *(int*)_output = value * 2;
+
+    return true;
+}
+
+// async_execution_add_one
+//   helper: transformer adding 1 to an int.
+static bool
+async_execution_add_one
+(
+    const void* _input,
+    void*       _output,
+    void*       _context
+)
+{
+    (void)_context;
+
+    *(int*)_output = (*(const int*)_input) + 1;
+
+    return true;
+}
+
+// async_execution_fail_at
+//   helper: transformer failing on the int pointed to by _context.
+static bool
+async_execution_fail_at
+(
+    const void* _input,
+    void*       _output,
+    void*       _context
+)
+{
+    if (*(const int*)_input == *(const int*)_context)
+    {
+        return false;
+    }
+
+    *(int*)_output = *(const int*)_input;
+
+    return true;
+}
+
+// async_execution_multiple_of_three
+//   helper: predicate for multiples of 3.
+static bool
+async_execution_multiple_of_three
+(
+    const void* _element,
+    void*       _context
+)
+{
+    (void)_context;
+
+    return ((*(const int*)_element) % 3) == 0;
+}
+
+// async_execution_none
+//   helper: predicate rejecting everything.
+static bool
+async_execution_none
+(
+    const void* _element,
+    void*       _context
+)
+{
+    (void)_element;
+    (void)_context;
+
+    return false;
+}
+
+// async_execution_count
+//   helper: consumer counting elements under a mutex.
+static void
+async_execution_count
+(
+    void* _element,
+    void* _context
+)
+{
+    struct async_execution_counter* counter;
+
+    (void)_element;
+
+    counter = (struct async_execution_counter*)_context;
+
+    d_functional_mutex_lock(&counter->mutex);
+    counter->count++;
+    d_functional_mutex_unlock(&counter->mutex);
+
+    return;
+}
+
+// async_execution_ordered_sum
+//   helper: accumulator summing ints and checking that they increase.
+static bool
+async_execution_ordered_sum
+(
+    void*       _accumulated,
+    const void* _element,
+    void*       _context
+)
+{
+    struct async_execution_order* order;
+    int                           value;
+
+    (void)_context;
+
+    order = (struct async_execution_order*)_accumulated;
+    value = *(const int*)_element;
+
+    if (value <= order->last)
+    {
+        order->ordered = false;
+    }
+
+    order->last  = value;
+    order->sum  += value;
+
+    return true;
+}
+
+// async_execution_sum
+//   helper: accumulator adding ints into a long long.
+static bool
+async_execution_sum
+(
+    void*       _accumulated,
+    const void* _element,
+    void*       _context
+)
+{
+    (void)_context;
+
+    *(long long*)_accumulated += *(const int*)_element;
+
+    return true;
+}
+
+// async_execution_refuse
+//   helper: accumulator that always fails.
+static bool
+async_execution_refuse
+(
+    void*       _accumulated,
+    const void* _element,
+    void*       _context
+)
+{
+    (void)_accumulated;
+    (void)_element;
+    (void)_context;
+
+    return false;
+}
+
+// async_execution_failing_next
+//   helper: fn_source_next handing out the same chunk until chunks_left
+// reaches 0, then failing.
+static bool
+async_execution_failing_next
+(
+    void*        _context,
+    const void** _chunk,
+    size_t*      _count
+)
+{
+    struct async_execution_failing_source* state;
+
+    state = (struct async_execution_failing_source*)_context;
+
+    if (state->chunks_left == 0)
+    {
+        return false;
+    }
+
+    state->chunks_left--;
+    *_chunk = state->values;
+    *_count = 4;
+
+    return true;
+}
+
+// async_execution_fill
+//   helper: fills _data with 0 .. ASYNC_EXECUTION_COUNT - 1.
+static void
+async_execution_fill
+(
+    int* _data
+)
+{
+    int i;
+
+    for (i = 0; i < ASYNC_EXECUTION_COUNT; i++)
+    {
+        _data[i] = i;
+    }
+
+    return;
+}
+
+
+/*
+d_tests_sa_async_execution_fold
+  Tests d_functional_async_start_fold.
+  Tests the following:
+  - a fold with no stages sees every element in order
+  - a fold after a parallel stage still sees the elements in source order
+  - fused and parallel stages give the same result as a serial loop
+*/
+bool
+d_tests_sa_async_execution_fold
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_functional_array_source state;
+    struct d_functional_source       source;
+    struct d_functional_async*       async;
+    struct async_execution_order     order;
+    int                              data[ASYNC_EXECUTION_COUNT];
+    long long                        sum;
+    long long                        expected;
+    int                              i;
+    bool                             result;
+
+    result = true;
+
+    async_execution_fill(data);
+
+    // test 1: no stages
+    memset(&order, 0, sizeof(order));
+    order.last    = -1;
+    order.ordered = true;
+
+    source = d_functional_source_array(&state, data, ASYNC_EXECUTION_COUNT,
+                                       sizeof(int), 100);
+    async  = d_functional_async_new(source, 0);
+
+    result = d_assert_standalone(
+        d_functional_async_start_fold(async, &order,
+                                      async_execution_ordered_sum, NULL) &&
+        (d_functional_async_wait(async) == 0) &&
+        order.ordered &&
+        (order.sum == (long long)ASYNC_EXECUTION_COUNT *
+                      (ASYNC_EXECUTION_COUNT - 1) / 2),
+        "async_fold_no_stages",
+        "a fold with no stages should see every element in order",
+        _counter) && result;
+
+    d_functional_async_free(async);
+
+    // test 2: parallel stage, source order
+    memset(&order, 0, sizeof(order));
+    order.last    = -1;
+    order.ordered = true;
+
+    source = d_functional_source_array(&state, data, ASYNC_EXECUTION_COUNT,
+                                       sizeof(int), 64);
+    async  = d_functional_async_new(source, 0);
+    async  = d_functional_async_map(async, async_execution_slow_double,
+                                    NULL, 4);
+
+    result = d_assert_standalone(
+        d_functional_async_start_fold(async, &order,
+                                      async_execution_ordered_sum, NULL) &&
+        (d_functional_async_wait(async) == 0) &&
+        order.ordered &&
+        (order.sum == (long long)ASYNC_EXECUTION_COUNT *
+                      (ASYNC_EXECUTION_COUNT - 1)),
+        "async_fold_source_order",
+        "parallel workers should not change the order the fold sees",
+        _counter) && result;
+
+    d_functional_async_free(async);
+
+    // test 3: groups against a serial loop
+    expected = 0;
+
+    for (i = 0; i < ASYNC_EXECUTION_COUNT; i++)
+    {
+        if ((((i * 2) + 1) % 3) == 0)
+        {
+            expected += (i * 2) + 1;
+        }
+    }
+
+    sum    = 0;
+    source = d_functional_source_array(&state, data, ASYNC_EXECUTION_COUNT,
+                                       sizeof(int), 37);
+    async  = d_functional_async_new(source, 2);
+    async  = d_functional_async_map(async, async_execution_slow_double,
+                                    NULL, 3);
+    async  = d_functional_async_map(async, async_execution_add_one, NULL, 0);
+    async  = d_functional_async_filter(async,
+                                       async_execution_multiple_of_three,
+                                       NULL, 2);
+
+    result = d_assert_standalone(
+        d_functional_async_start_fold(async, &sum, async_execution_sum,
+                                      NULL) &&
+        (d_functional_async_wait(async) == 0) &&
+        (sum == expected),
+        "async_fold_groups",
+        "fused and parallel groups should match a serial loop",
+        _counter) && result;
+
+    d_functional_async_free(async);
+
+    return result;
+}
+
+/*
+d_tests_sa_async_execution_collect
+  Tests d_functional_async_start_collect.
+  Tests the following:
+  - the output of parallel stages is collected complete and in order
+  - the caller's data is not modified
+  - an empty output is a non-NULL allocation with a count of 0
+*/
+bool
+d_tests_sa_async_execution_collect
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_functional_array_source state;
+    struct d_functional_source       source;
+    struct d_functional_async*       async;
+    int                              data[ASYNC_EXECUTION_COUNT];
+    void*                            collected;
+    size_t                           count;
+    int                              i;
+    bool                             in_order;
+    bool                             result;
+
+    result = true;
+
+    async_execution_fill(data);
+
+    // test 1: parallel map, in order
+    source = d_functional_source_array(&state, data, ASYNC_EXECUTION_COUNT,
+                                       sizeof(int), 50);
+    async  = d_functional_async_new(source, 0);
+    async  = d_functional_async_map(async, async_execution_slow_double,
+                                    NULL, 4);
+    async  = d_functional_async_map(async, async_execution_add_one, NULL, 2);
+
+    result = d_assert_standalone(
+        d_functional_async_start_collect(async, &collected, &count) &&
+        (d_functional_async_wait(async) == 0) &&
+        (collected != NULL) &&
+        (count == ASYNC_EXECUTION_COUNT),
+        "async_collect_complete",
+        "every element should be collected",
+        _counter) && result;
+
+    in_order = (collected != NULL);
+
+    for (i = 0; (in_order) && (i < (int)count); i++)
+    {
+        in_order = (((int*)collected)[i] == (i * 2) + 1);
+    }
+
+    result = d_assert_standalone(
+        in_order &&
+        (data[ASYNC_EXECUTION_COUNT - 1] == ASYNC_EXECUTION_COUNT - 1),
+        "async_collect_order",
+        "the output should be in source order and the input untouched",
+        _counter) && result;
+
+    d_functional_free(collected);
+    d_functional_async_free(async);
+
+    // test 2: empty output
+    source = d_functional_source_array(&state, data, ASYNC_EXECUTION_COUNT,
+                                       sizeof(int), 50);
+    async  = d_functional_async_new(source, 0);
+    async  = d_functional_async_filter(async, async_execution_none, NULL, 2);
+
+    result = d_assert_standalone(
+        d_functional_async_start_collect(async, &collected, &count) &&
+        (d_functional_async_wait(async) == 0) &&
+        (collected != NULL) &&
+        (count == 0),
+        "async_collect_empty",
+        "an empty output should be a non-NULL allocation",
+        _counter) && result;
+
+    d_functional_free(collected);
+    d_functional_async_free(async);
+
+    return result;
+}
+
+/*
+d_tests_sa_async_execution_for_each
+  Tests d_functional_async_start with for_each stages.
+  Tests the following:
+  - a pipeline without a terminal operation runs for its side effects
+  - a consumer on several workers sees every element exactly once
+  - d_functional_async_ready reports completion
+*/
+bool
+d_tests_sa_async_execution_for_each
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_functional_array_source state;
+    struct d_functional_source       source;
+    struct d_functional_async*       async;
+    struct async_execution_counter   counter;
+    int                              data[ASYNC_EXECUTION_COUNT];
+    int                              code;
+    bool                             result;
+
+    result = true;
+
+    async_execution_fill(data);
+    d_functional_mutex_init(&counter.mutex);
+    counter.count = 0;
+
+    source = d_functional_source_array(&state, data, ASYNC_EXECUTION_COUNT,
+                                       sizeof(int), 25);
+    async  = d_functional_async_new(source, 0);
+    async  = d_functional_async_filter(async,
+                                       async_execution_multiple_of_three,
+                                       NULL, 1);
+    async  = d_functional_async_for_each(async, async_execution_count,
+                                         &counter, 3);
+
+    code = (d_functional_async_start(async)) ? d_functional_async_wait(async)
+                                             : -1;
+
+    result = d_assert_standalone(
+        (code == 0) &&
+        (counter.count == (ASYNC_EXECUTION_COUNT + 2) / 3),
+        "async_for_each_count",
+        "every kept element should be consumed exactly once",
+        _counter) && result;
+
+    result = d_assert_standalone(
+        d_functional_async_ready(async),
+        "async_for_each_ready",
+        "a waited-for pipeline should be ready",
+        _counter) && result;
+
+    d_functional_async_free(async);
+    d_functional_mutex_destroy(&counter.mutex);
+
+    return result;
+}
+
+/*
+d_tests_sa_async_execution_backpressure
+  Tests the bounded queues.
+  Tests the following:
+  - queues of depth 1 with one-element chunks still deliver everything
+  - the memory held at once stays bounded by the chunks in flight, not by
+    the input size
+*/
+bool
+d_tests_sa_async_execution_backpressure
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_functional_array_source state;
+    struct d_functional_source       source;
+    struct d_functional_async*       async;
+    struct d_functional_allocator    counting;
+    struct d_functional_allocator*   previous;
+    int                              data[ASYNC_EXECUTION_COUNT];
+    long long                        sum;
+    bool                             result;
+
+    result = true;
+
+    async_execution_fill(data);
+    d_functional_allocator_init(&counting, NULL, NULL, NULL, NULL, true);
+    previous = d_functional_allocator_push(&counting);
+
+    sum    = 0;
+    source = d_functional_source_array(&state, data, ASYNC_EXECUTION_COUNT,
+                                       sizeof(int), 1);
+    async  = d_functional_async_new(source, 1);
+    async  = d_functional_async_map(async, async_execution_add_one, NULL, 1);
+    async  = d_functional_async_map(async, async_execution_slow_double,
+                                    NULL, 1);
+    async  = d_functional_async_map(async, async_execution_add_one, NULL, 2);
+
+    result = d_assert_standalone(
+        d_functional_async_start_fold(async, &sum, async_execution_sum,
+                                      NULL) &&
+        (d_functional_async_wait(async) == 0) &&
+        (sum == (long long)ASYNC_EXECUTION_COUNT * ASYNC_EXECUTION_COUNT +
+                (2 * ASYNC_EXECUTION_COUNT)),
+        "async_backpressure_complete",
+        "depth-1 queues should still deliver every chunk",
+        _counter) && result;
+
+    d_functional_async_free(async);
+    d_functional_allocator_pop(previous);
+
+    // every chunk costs more than an int, so an unbounded pipeline would
+    // hold well over the input size at once
+    result = d_assert_standalone(
+        (counting.stats.allocations > ASYNC_EXECUTION_COUNT) &&
+        (counting.stats.bytes_live == 0) &&
+        (counting.stats.high_water < ASYNC_EXECUTION_COUNT * sizeof(int)),
+        "async_backpressure_bounded",
+        "memory in use should stay bounded by the chunks in flight",
+        _counter) && result;
+
+    d_functional_allocator_destroy(&counting);
+
+    return result;
+}
+
+/*
+d_tests_sa_async_execution_failure
+  Tests errors raised while a pipeline runs.
+  Tests the following:
+  - a failing transformer stops the pipeline and is reported by wait
+  - a failed collect returns NULL
+  - a failing source is reported by wait
+  - a failing fold is reported by wait
+*/
+bool
+d_tests_sa_async_execution_failure
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_functional_array_source      state;
+    struct d_functional_source            source;
+    struct d_functional_async*            async;
+    struct async_execution_failing_source failing;
+    int                                   data[ASYNC_EXECUTION_COUNT];
+    int                                   poison;
+    void*                                 collected;
+    size_t                                count;
+    long long                             sum;
+    bool                                  result;
+
+    result = true;
+
+    async_execution_fill(data);
+
+    // test 1: failing transformer
+    poison = ASYNC_EXECUTION_COUNT / 2;
+    source = d_functional_source_array(&state, data, ASYNC_EXECUTION_COUNT,
+                                       sizeof(int), 16);
+    async  = d_functional_async_new(source, 2);
+    async  = d_functional_async_map(async, async_execution_add_one, NULL, 2);
+    async  = d_functional_async_map(async, async_execution_fail_at, &poison,
+                                    2);
+
+    result = d_assert_standalone(
+        d_functional_async_start_collect(async, &collected, &count) &&
+        (d_functional_async_wait(async) == -1) &&
+        (collected == NULL) &&
+        (count == 0),
+        "async_failure_transformer",
+        "a failing transformer should stop the pipeline with an error",
+        _counter) && result;
+
+    d_functional_async_free(async);
+
+    // test 2: failing source
+    memset(&failing, 0, sizeof(failing));
+    failing.chunks_left = 3;
+
+    source.next_chunk   = async_execution_failing_next;
+    source.context      = &failing;
+    source.element_size = sizeof(int);
+
+    sum   = 0;
+    async = d_functional_async_new(source, 0);
+    async = d_functional_async_map(async, async_execution_add_one, NULL, 1);
+
+    result = d_assert_standalone(
+        d_functional_async_start_fold(async, &sum, async_execution_sum,
+                                      NULL) &&
+        (d_functional_async_wait(async) == -1),
+        "async_failure_source",
+        "a failing source should be reported",
+        _counter) && result;
+
+    d_functional_async_free(async);
+
+    // test 3: failing fold
+    source = d_functional_source_array(&state, data, ASYNC_EXECUTION_COUNT,
+                                       sizeof(int), 16);
+    async  = d_functional_async_new(source, 0);
+    async  = d_functional_async_map(async, async_execution_add_one, NULL, 2);
+
+    result = d_assert_standalone(
+        d_functional_async_start_fold(async, &sum, async_execution_refuse,
+                                      NULL) &&
+        (d_functional_async_wait(async) == -1) &&
+        d_functional_async_ready(async),
+        "async_failure_fold",
+        "a failing fold should be reported",
+        _counter) && result;
+
+    d_functional_async_free(async);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_async_execution_all
+  Aggregation function that runs all execution tests.
+*/
+bool
+d_tests_sa_async_execution_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Execution\n");
+    printf("  -------------------\n");
+
+    result = d_tests_sa_async_execution_fold(_counter)         && result;
+    result = d_tests_sa_async_execution_collect(_counter)      && result;
+    result = d_tests_sa_async_execution_for_each(_counter)     && result;
+    result = d_tests_sa_async_execution_backpressure(_counter) && result;
+    result = d_tests_sa_async_execution_failure(_counter)      && result;
+
+    return result;
+}
@@ -8,6 +8,7 @@ d_tests_sa_compose_run_all
   - Transformer composition functions
   - Partial application functions
   - Convenience and template macros
+  - N-ary composition functions
 */
 bool
 d_tests_sa_compose_run_all
@@ -23,6 +24,7 @@ d_tests_sa_compose_run_all
     result = d_tests_sa_compose_transformer_all(_counter) && result;
     result = d_tests_sa_compose_partial_all(_counter)     && result;
     result = d_tests_sa_compose_macro_all(_counter)       && result;
+    result = d_tests_sa_compose_many_all(_counter)        && result;
 
     return result;
 }
@@ -58,6 +58,19 @@ bool d_tests_sa_compose_macro_make_predicate_from(struct d_test_counter* _counte
 bool d_tests_sa_compose_macro_all(struct d_test_counter* _counter);
 
 
+/******************************************************************************
+ * IV. N-ARY COMPOSITION FUNCTION TESTS
+ *****************************************************************************/
+bool d_tests_sa_compose_many(struct d_test_counter* _counter);
+bool d_tests_sa_compose_many_apply(struct d_test_counter* _counter);
+bool d_tests_sa_compose_apply_array(struct d_test_counter* _counter);
+bool d_tests_sa_compose_many_apply_with(struct d_test_counter* _counter);
+bool d_tests_sa_compose_many_free(struct d_test_counter* _counter);
+
+// IV.  aggregation function
+bool d_tests_sa_compose_many_all(struct d_test_counter* _counter);
+
+
 /******************************************************************************
  * MODULE-LEVEL AGGREGATION
  *****************************************************************************/
@@ -250,6 +250,56 @@ transform_square
 }
 
 
+// transform_int_to_double
+//   helper: widens an integer to a double and halves it, producing an output
+// of a different size than the input. Returns false if _input or _output is
+// NULL.
+static inline bool
+transform_int_to_double
+(
+    const void* _input,
+    void*       _output,
+    void*       _context
+)
+{
+    (void)_context;
+
+    if ( (!_input) ||
+         (!_output) )
+    {
+        return false;
+    }
+
+    *(double*)_output = (double)(*(const int*)_input) / 2.0;
+
+    return true;
+}
+
+// transform_fail_on_negative
+//   helper: copies an integer, failing when the input is negative.
+static inline bool
+transform_fail_on_negative
+(
+    const void* _input,
+    void*       _output,
+    void*       _context
+)
+{
+    (void)_context;
+
+    if ( (!_input)  ||
+         (!_output) ||
+         (*(const int*)_input < 0) )
+    {
+        return false;
+    }
+
+    *(int*)_output = *(const int*)_input;
+
+    return true;
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////
 ///             CONSUMER HELPERS                                             ///
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,708 @@
+#include ".\compose_tests_sa.h"
+#include ".\compose_tests_sa_helpers.h"
+
+
+/*
+d_tests_sa_compose_many
+  Tests the d_functional_compose_many constructor function.
+  Tests the following:
+  - NULL stages rejection
+  - zero count rejection
+  - NULL stage transformer rejection
+  - zero stage output_size rejection
+  - single-stage creation (no scratch buffers)
+  - multi-stage creation copies stages and sizes scratch for the largest
+    intermediate
+  - scratch slots and blocks stay aligned after an odd-sized intermediate
+*/
+bool
+d_tests_sa_compose_many
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                     result;
+    struct d_composed_chain* chain;
+    struct d_compose_stage   stages[3];
+
+    result = true;
+
+    stages[0].transform   = transform_double;
+    stages[0].context     = NULL;
+    stages[0].output_size = sizeof(int);
+    stages[1].transform   = transform_int_to_double;
+    stages[1].context     = NULL;
+    stages[1].output_size = sizeof(double);
+    stages[2].transform   = transform_add_10;
+    stages[2].context     = NULL;
+    stages[2].output_size = sizeof(int);
+
+    // test 1: NULL stages should return NULL
+    chain  = d_functional_compose_many(NULL, 3);
+    result = d_assert_standalone(
+        chain == NULL,
+        "compose_many_null_stages",
+        "NULL stages should return NULL",
+        _counter) && result;
+
+    // test 2: zero count should return NULL
+    chain  = d_functional_compose_many(stages, 0);
+    result = d_assert_standalone(
+        chain == NULL,
+        "compose_many_zero_count",
+        "Zero count should return NULL",
+        _counter) && result;
+
+    // test 3: NULL transformer in any stage should return NULL
+    stages[1].transform = NULL;
+    chain  = d_functional_compose_many(stages, 3);
+    result = d_assert_standalone(
+        chain == NULL,
+        "compose_many_null_transform",
+        "A stage with a NULL transformer should return NULL",
+        _counter) && result;
+    stages[1].transform = transform_int_to_double;
+
+    // test 4: zero output_size in any stage should return NULL
+    stages[2].output_size = 0;
+    chain  = d_functional_compose_many(stages, 3);
+    result = d_assert_standalone(
+        chain == NULL,
+        "compose_many_zero_output_size",
+        "A stage with a zero output_size should return NULL",
+        _counter) && result;
+    stages[2].output_size = sizeof(int);
+
+    // test 5: single stage needs no scratch
+    chain  = d_functional_compose_many(stages, 1);
+    result = d_assert_standalone(
+        chain != NULL,
+        "compose_many_single_stage",
+        "A single stage composition should be created",
+        _counter) && result;
+
+    if (chain)
+    {
+        result = d_assert_standalone(
+            ( (chain->count == 1)        &&
+              (chain->scratch_size == 0) &&
+              (chain->scratch[0] == NULL) ),
+            "compose_many_single_stage_no_scratch",
+            "A single stage composition should not allocate scratch",
+            _counter) && result;
+
+        d_functional_compose_many_free(chain);
+    }
+
+    // test 6: multi-stage creation
+    chain  = d_functional_compose_many(stages, 3);
+    result = d_assert_standalone(
+        chain != NULL,
+        "compose_many_success",
+        "A three stage composition should be created",
+        _counter) && result;
+
+    if (chain)
+    {
+        // the caller's array must not be aliased
+        result = d_assert_standalone(
+            ( (chain->stages != stages)                          &&
+              (chain->stages[1].transform == transform_int_to_double) &&
+              (chain->count == 3) ),
+            "compose_many_stages_copied",
+            "Stages should be copied into the composition",
+            _counter) && result;
+
+        result = d_assert_standalone(
+            chain->scratch_size == sizeof(double),
+            "compose_many_scratch_size",
+            "Scratch should be sized for the largest intermediate",
+            _counter) && result;
+
+        result = d_assert_standalone(
+            ( (chain->scratch[0]   != NULL) &&
+              (chain->scratch[1]   != NULL) &&
+              (chain->block_buf[0] != NULL) &&
+              (chain->block_buf[1] != NULL) ),
+            "compose_many_buffers_allocated",
+            "Scratch slots and block buffers should be allocated",
+            _counter) && result;
+
+        result = d_assert_standalone(
+            d_functional_compose_many_output_size(chain) == sizeof(int),
+            "compose_many_output_size",
+            "Output size should be the last stage's output size",
+            _counter) && result;
+
+        d_functional_compose_many_free(chain);
+    }
+
+    // test 7: a 12-byte intermediate keeps later slots aligned
+    stages[0].output_size = 12;
+    chain                 = d_functional_compose_many(stages, 3);
+    stages[0].output_size = sizeof(int);
+
+    result = d_assert_standalone(
+        (chain)                                                    &&
+        (chain->scratch_size == 12)                                &&
+        (((uintptr_t)chain->scratch[1] -
+          (uintptr_t)chain->scratch[0]) %
+             D_FUNCTIONAL_COMPOSE_ALIGNMENT == 0)                  &&
+        (((uintptr_t)chain->block_buf[0] -
+          (uintptr_t)chain->scratch[0]) %
+             D_FUNCTIONAL_COMPOSE_ALIGNMENT == 0)                  &&
+        (((uintptr_t)chain->block_buf[1] -
+          (uintptr_t)chain->scratch[0]) %
+             D_FUNCTIONAL_COMPOSE_ALIGNMENT == 0),
+        "compose_many_buffers_aligned",
+        "Scratch slots and blocks should start at aligned offsets",
+        _counter) && result;
+
+    d_functional_compose_many_free(chain);
+
+    return result;
+}
+
+/*
+d_tests_sa_compose_many_apply
+  Tests the d_functional_compose_many_apply function.
+  Tests the following:
+  - NULL chain, input, and output rejection
+  - application order across three stages
+  - contexts forwarded to the matching stage
+  - type-changing intermediate stage
+  - failure in a middle stage is reported
+*/
+bool
+d_tests_sa_compose_many_apply
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                     result;
+    struct d_composed_chain* chain;
+    struct d_compose_stage   stages[4];
+    int                      factor;
+    int                      addend;
+    int                      input;
+    int                      output;
+    double                   output_double;
+
+    result = true;
+    factor = 3;
+    addend = 7;
+
+    // (x * 3) + 7, then doubled, then + 10
+    stages[0].transform   = transform_multiply_by_context;
+    stages[0].context     = &factor;
+    stages[0].output_size = sizeof(int);
+    stages[1].transform   = transform_add_context;
+    stages[1].context     = &addend;
+    stages[1].output_size = sizeof(int);
+    stages[2].transform   = transform_double;
+    stages[2].context     = NULL;
+    stages[2].output_size = sizeof(int);
+    stages[3].transform   = transform_add_10;
+    stages[3].context     = NULL;
+    stages[3].output_size = sizeof(int);
+
+    chain = d_functional_compose_many(stages, 4);
+
+    if (!chain)
+    {
+        return d_assert_standalone(
+            false,
+            "compose_many_apply_setup",
+            "Failed to create composition",
+            _counter);
+    }
+
+    input  = 2;
+    output = 0;
+
+    // test 1: NULL parameters
+    result = d_assert_standalone(
+        ( (!d_functional_compose_many_apply(NULL, &input, &output)) &&
+          (!d_functional_compose_many_apply(chain, NULL, &output))  &&
+          (!d_functional_compose_many_apply(chain, &input, NULL)) ),
+        "compose_many_apply_null_params",
+        "NULL chain, input, or output should return false",
+        _counter) && result;
+
+    // test 2: stages applied in order with their contexts
+    result = d_assert_standalone(
+        ( d_functional_compose_many_apply(chain, &input, &output) &&
+          (output == ((((2 * 3) + 7) * 2) + 10)) ),
+        "compose_many_apply_order",
+        "((2 * 3) + 7) * 2 + 10 should equal 36",
+        _counter) && result;
+
+    // test 3: reuse of the scratch slots across calls
+    input  = -1;
+    result = d_assert_standalone(
+        ( d_functional_compose_many_apply(chain, &input, &output) &&
+          (output == ((((-1 * 3) + 7) * 2) + 10)) ),
+        "compose_many_apply_reuse",
+        "A second application should not see stale intermediates",
+        _counter) && result;
+
+    d_functional_compose_many_free(chain);
+
+    // test 4: type-changing final stage
+    stages[0].transform   = transform_double;
+    stages[0].context     = NULL;
+    stages[0].output_size = sizeof(int);
+    stages[1].transform   = transform_int_to_double;
+    stages[1].context     = NULL;
+    stages[1].output_size = sizeof(double);
+
+    chain = d_functional_compose_many(stages, 2);
+
+    if (chain)
+    {
+        input         = 5;
+        output_double = 0.0;
+
+        result = d_assert_standalone(
+            ( d_functional_compose_many_apply(chain, &input, &output_double) &&
+              (output_double == 5.0) ),
+            "compose_many_apply_type_change",
+            "(5 * 2) / 2.0 should equal 5.0",
+            _counter) && result;
+
+        d_functional_compose_many_free(chain);
+    }
+
+    // test 5: failure in a middle stage
+    stages[0].transform   = transform_add_10;
+    stages[0].output_size = sizeof(int);
+    stages[1].transform   = transform_always_fails;
+    stages[1].output_size = sizeof(int);
+    stages[2].transform   = transform_double;
+    stages[2].output_size = sizeof(int);
+
+    chain = d_functional_compose_many(stages, 3);
+
+    if (chain)
+    {
+        input = 1;
+
+        result = d_assert_standalone(
+            !d_functional_compose_many_apply(chain, &input, &output),
+            "compose_many_apply_stage_failure",
+            "A failing middle stage should return false",
+            _counter) && result;
+
+        d_functional_compose_many_free(chain);
+    }
+
+    return result;
+}
+
+/*
+d_tests_sa_compose_apply_array
+  Tests the d_functional_compose_apply_array function.
+  Tests the following:
+  - NULL and zero parameter rejection
+  - arrays spanning several blocks, including a partial final block
+  - type-changing stages with different input and output strides
+  - single-stage composition writes directly to output
+  - failure partway through an array is reported
+*/
+bool
+d_tests_sa_compose_apply_array
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                     result;
+    struct d_composed_chain* chain;
+    struct d_compose_stage   stages[3];
+    int                      input[150];
+    int                      output[150];
+    double                   output_double[150];
+    bool                     all_match;
+    size_t                   i;
+
+    result = true;
+
+    for (i = 0; i < 150; i++)
+    {
+        input[i] = (int)i;
+    }
+
+    stages[0].transform   = transform_double;
+    stages[0].context     = NULL;
+    stages[0].output_size = sizeof(int);
+    stages[1].transform   = transform_add_10;
+    stages[1].context     = NULL;
+    stages[1].output_size = sizeof(int);
+    stages[2].transform   = transform_int_to_double;
+    stages[2].context     = NULL;
+    stages[2].output_size = sizeof(double);
+
+    chain = d_functional_compose_many(stages, 3);
+
+    if (!chain)
+    {
+        return d_assert_standalone(
+            false,
+            "compose_apply_array_setup",
+            "Failed to create composition",
+            _counter);
+    }
+
+    // test 1: invalid parameters
+    result = d_assert_standalone(
+        ( (!d_functional_compose_apply_array(NULL, input, 150, sizeof(int), output_double))  &&
+          (!d_functional_compose_apply_array(chain, NULL, 150, sizeof(int), output_double))  &&
+          (!d_functional_compose_apply_array(chain, input, 150, sizeof(int), NULL))          &&
+          (!d_functional_compose_apply_array(chain, input, 0, sizeof(int), output_double))   &&
+          (!d_functional_compose_apply_array(chain, input, 150, 0, output_double)) ),
+        "compose_apply_array_invalid",
+        "NULL or zero parameters should return false",
+        _counter) && result;
+
+    // test 2: several blocks plus a partial block, type-changing output
+    all_match = d_functional_compose_apply_array(chain,
+                                                 input,
+                                                 150,
+                                                 sizeof(int),
+                                                 output_double);
+
+    for (i = 0; (all_match) && (i < 150); i++)
+    {
+        all_match = (output_double[i] == ((double)((input[i] * 2) + 10) / 2.0));
+    }
+
+    result = d_assert_standalone(
+        all_match,
+        "compose_apply_array_blocks",
+        "Every element should equal ((x * 2) + 10) / 2.0",
+        _counter) && result;
+
+    d_functional_compose_many_free(chain);
+
+    // test 3: single stage writes straight to output
+    chain = d_functional_compose_many(stages, 1);
+
+    if (chain)
+    {
+        all_match = d_functional_compose_apply_array(chain,
+                                                     input,
+                                                     150,
+                                                     sizeof(int),
+                                                     output);
+
+        for (i = 0; (all_match) && (i < 150); i++)
+        {
+            all_match = (output[i] == input[i] * 2);
+        }
+
+        result = d_assert_standalone(
+            all_match,
+            "compose_apply_array_single_stage",
+            "A single stage should map every element",
+            _counter) && result;
+
+        d_functional_compose_many_free(chain);
+    }
+
+    // test 4: failure in a later block
+    stages[0].transform   = transform_fail_on_negative;
+    stages[0].output_size = sizeof(int);
+    stages[1].transform   = transform_add_10;
+    stages[1].output_size = sizeof(int);
+    input[100]            = -1;
+
+    chain = d_functional_compose_many(stages, 2);
+
+    if (chain)
+    {
+        result = d_assert_standalone(
+            !d_functional_compose_apply_array(chain,
+                                              input,
+                                              150,
+                                              sizeof(int),
+                                              output),
+            "compose_apply_array_failure",
+            "A failing element should make the call return false",
+            _counter) && result;
+
+        result = d_assert_standalone(
+            ( (output[0] == 10) &&
+              (output[63] == 73) ),
+            "compose_apply_array_failure_prefix",
+            "Blocks before the failure should already be written",
+            _counter) && result;
+
+        d_functional_compose_many_free(chain);
+    }
+
+    return result;
+}
+
+/*
+d_tests_sa_compose_many_apply_with
+  Tests the d_functional_compose_many_scratch_size,
+d_functional_compose_many_apply_with, and
+d_functional_compose_apply_array_with functions.
+  Tests the following:
+  - a single stage needs no scratch, and accepts a NULL buffer
+  - a missing buffer is rejected when scratch is needed
+  - results match the composition's own buffers
+  - the composition's own buffers are left untouched
+  - a composition with no stages is rejected
+*/
+bool
+d_tests_sa_compose_many_apply_with
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                     result;
+    struct d_composed_chain* chain;
+    struct d_composed_chain  empty;
+    struct d_compose_stage   stages[3];
+    unsigned char*           own;
+    void*                    scratch;
+    int                      input[100];
+    double                   expected[100];
+    double                   output[100];
+    double                   single;
+    int                      single_int;
+    size_t                   size;
+    bool                     all_match;
+    size_t                   i;
+
+    result = true;
+
+    for (i = 0; i < 100; i++)
+    {
+        input[i] = (int)i - 50;
+    }
+
+    stages[0].transform   = transform_double;
+    stages[0].context     = NULL;
+    stages[0].output_size = sizeof(int);
+    stages[1].transform   = transform_add_10;
+    stages[1].context     = NULL;
+    stages[1].output_size = sizeof(int);
+    stages[2].transform   = transform_int_to_double;
+    stages[2].context     = NULL;
+    stages[2].output_size = sizeof(double);
+
+    // test 1: single stage
+    chain = d_functional_compose_many(stages, 1);
+
+    if (chain)
+    {
+        single_int = 0;
+
+        result = d_assert_standalone(
+            (d_functional_compose_many_scratch_size(chain) == 0) &&
+            (d_functional_compose_many_scratch_size(NULL) == 0) &&
+            d_functional_compose_many_apply_with(chain,
+                                                 NULL,
+                                                 &input[60],
+                                                 &single_int) &&
+            (single_int == 20),
+            "compose_many_apply_with_single",
+            "A single stage should need no scratch buffer",
+            _counter) && result;
+
+        d_functional_compose_many_free(chain);
+    }
+
+    chain = d_functional_compose_many(stages, 3);
+
+    if (!chain)
+    {
+        return d_assert_standalone(
+            false,
+            "compose_many_apply_with_setup",
+            "Failed to create composition",
+            _counter);
+    }
+
+    size    = d_functional_compose_many_scratch_size(chain);
+    scratch = d_functional_malloc(size);
+
+    // test 2: missing buffer
+    result = d_assert_standalone(
+        (size >= 2 * D_FUNCTIONAL_COMPOSE_BLOCK_SIZE * sizeof(int)) &&
+        (scratch != NULL) &&
+        (!d_functional_compose_many_apply_with(chain, NULL, input, output)) &&
+        (!d_functional_compose_apply_array_with(chain, NULL, input, 100,
+                                                sizeof(int), output)),
+        "compose_many_apply_with_null_scratch",
+        "A NULL buffer should be rejected when scratch is needed",
+        _counter) && result;
+
+    if (!scratch)
+    {
+        d_functional_compose_many_free(chain);
+
+        return result;
+    }
+
+    // test 3: same results as the composition's own buffers
+    all_match = d_functional_compose_apply_array(chain,
+                                                 input,
+                                                 100,
+                                                 sizeof(int),
+                                                 expected);
+
+    // mark the composition's own buffers, which hold the same layout
+    own = (unsigned char*)chain->scratch[0];
+
+    for (i = 0; i < size; i++)
+    {
+        own[i] = 0xA5;
+    }
+
+    all_match = all_match &&
+                d_functional_compose_apply_array_with(chain,
+                                                      scratch,
+                                                      input,
+                                                      100,
+                                                      sizeof(int),
+                                                      output);
+
+    for (i = 0; (all_match) && (i < 100); i++)
+    {
+        all_match = (output[i] == expected[i]) &&
+                    d_functional_compose_many_apply_with(chain,
+                                                         scratch,
+                                                         &input[i],
+                                                         &single) &&
+                    (single == expected[i]);
+    }
+
+    result = d_assert_standalone(
+        all_match,
+        "compose_many_apply_with_matches",
+        "A caller's buffer should give the same results",
+        _counter) && result;
+
+    // test 4: own buffers untouched
+    all_match = true;
+
+    for (i = 0; (all_match) && (i < size); i++)
+    {
+        all_match = (own[i] == 0xA5);
+    }
+
+    result = d_assert_standalone(
+        all_match,
+        "compose_many_apply_with_own_untouched",
+        "The composition's own buffers should not be written",
+        _counter) && result;
+
+    // test 5: no stages
+    empty       = *chain;
+    empty.count = 0;
+
+    result = d_assert_standalone(
+        (!d_functional_compose_many_apply(&empty, input, output)) &&
+        (!d_functional_compose_many_apply_with(&empty, scratch, input,
+                                               output)) &&
+        (!d_functional_compose_apply_array(&empty, input, 100, sizeof(int),
+                                           output)) &&
+        (!d_functional_compose_apply_array_with(&empty, scratch, input, 100,
+                                                sizeof(int), output)) &&
+        (d_functional_compose_many_output_size(&empty) == 0),
+        "compose_many_apply_with_empty",
+        "A composition with no stages should be rejected",
+        _counter) && result;
+
+    d_functional_free(scratch);
+    d_functional_compose_many_free(chain);
+
+    return result;
+}
+
+/*
+d_tests_sa_compose_many_free
+  Tests the d_functional_compose_many_free function.
+  Tests the following:
+  - NULL composition is handled safely
+  - single and multi-stage compositions are freed
+  - stage contexts are not freed
+*/
+bool
+d_tests_sa_compose_many_free
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                     result;
+    struct d_composed_chain* chain;
+    struct d_compose_stage   stages[2];
+    int                      factor;
+
+    result = true;
+    factor = 4;
+
+    // test 1: NULL should not crash
+    d_functional_compose_many_free(NULL);
+    result = d_assert_standalone(
+        true,
+        "compose_many_free_null",
+        "Freeing NULL should not crash",
+        _counter) && result;
+
+    stages[0].transform   = transform_multiply_by_context;
+    stages[0].context     = &factor;
+    stages[0].output_size = sizeof(int);
+    stages[1].transform   = transform_negate;
+    stages[1].context     = NULL;
+    stages[1].output_size = sizeof(int);
+
+    // test 2: single stage
+    chain = d_functional_compose_many(stages, 1);
+    d_functional_compose_many_free(chain);
+    result = d_assert_standalone(
+        true,
+        "compose_many_free_single",
+        "Freeing a single stage composition should not crash",
+        _counter) && result;
+
+    // test 3: multi-stage, context untouched
+    chain = d_functional_compose_many(stages, 2);
+    d_functional_compose_many_free(chain);
+    result = d_assert_standalone(
+        factor == 4,
+        "compose_many_free_context_intact",
+        "Stage contexts should remain valid after free",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_compose_many_all
+  Aggregation function that runs all n-ary composition tests.
+*/
+bool
+d_tests_sa_compose_many_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] N-ary Composition Functions\n");
+    printf("  --------------------------------------\n");
+
+    result = d_tests_sa_compose_many(_counter)             && result;
+    result = d_tests_sa_compose_many_apply(_counter)       && result;
+    result = d_tests_sa_compose_apply_array(_counter)      && result;
+    result = d_tests_sa_compose_many_apply_with(_counter)  && result;
+    result = d_tests_sa_compose_many_free(_counter)        && result;
+
+    return result;
+}
@@ -33,6 +33,7 @@ bool d_tests_sa_filter_op_range_slice(struct d_test_counter* _counter);
 bool d_tests_sa_filter_op_where(struct d_test_counter* _counter);
 bool d_tests_sa_filter_op_indices(struct d_test_counter* _counter);
 bool d_tests_sa_filter_op_distinct_reverse(struct d_test_counter* _counter);
+bool d_tests_sa_filter_op_top_k(struct d_test_counter* _counter);
 bool d_tests_sa_filter_op_free(struct d_test_counter* _counter);
 
 // I.   aggregation function
@@ -75,6 +76,7 @@ bool d_tests_sa_filter_get_indices(struct d_test_counter* _counter);
 bool d_tests_sa_filter_in_place(struct d_test_counter* _counter);
 bool d_tests_sa_filter_result_free(struct d_test_counter* _counter);
 bool d_tests_sa_filter_matches_element(struct d_test_counter* _counter);
+bool d_tests_sa_filter_apply_sorted(struct d_test_counter* _counter);
 
 // IV.  aggregation function
 bool d_tests_sa_filter_execution_all(struct d_test_counter* _counter);
@@ -86,6 +88,13 @@ bool d_tests_sa_filter_execution_all(struct d_test_counter* _counter);
 bool d_tests_sa_filter_validation(struct d_test_counter* _counter);
 bool d_tests_sa_filter_to_string(struct d_test_counter* _counter);
 bool d_tests_sa_filter_from_string(struct d_test_counter* _counter);
+bool d_tests_sa_filter_round_trip(struct d_test_counter* _counter);
+bool d_tests_sa_filter_canonical(struct d_test_counter* _counter);
+bool d_tests_sa_filter_parse(struct d_test_counter* _counter);
+bool d_tests_sa_filter_parse_in(struct d_test_counter* _counter);
+bool d_tests_sa_filter_parse_release(struct d_test_counter* _counter);
+bool d_tests_sa_filter_encode(struct d_test_counter* _counter);
+bool d_tests_sa_filter_decode(struct d_test_counter* _counter);
 bool d_tests_sa_filter_optimize(struct d_test_counter* _counter);
 bool d_tests_sa_filter_estimate(struct d_test_counter* _counter);
 
@@ -100,6 +109,7 @@ bool d_tests_sa_filter_iterator_create(struct d_test_counter* _counter);
 bool d_tests_sa_filter_iterator_traverse(struct d_test_counter* _counter);
 bool d_tests_sa_filter_iterator_reset(struct d_test_counter* _counter);
 bool d_tests_sa_filter_iterator_edge(struct d_test_counter* _counter);
+bool d_tests_sa_filter_iterator_stream(struct d_test_counter* _counter);
 
 // VI.  aggregation function
 bool d_tests_sa_filter_iterator_all(struct d_test_counter* _counter);
@@ -505,7 +505,7 @@ d_tests_sa_filter_builder_finalize
         }
 
         d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
         d_filter_builder_free(builder);
     }
 
@@ -553,7 +553,7 @@ d_tests_sa_filter_builder_finalize
             _counter) && result;
 
         d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
         d_filter_builder_free(builder);
     }
 
@@ -579,7 +579,7 @@ d_tests_sa_filter_builder_finalize
         _counter) && result;
 
     d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
 
     return result;
 }
@@ -54,6 +54,27 @@ static bool pred_greater_than_context(const void* _element, void* _context)
     return (*value > *threshold);
 }
 
+// the context is { threshold, calls }; calls counts predicate invocations
+static bool pred_greater_than_counted(const void* _element, void* _context)
+{
+    int* bound;
+
+    bound = (int*)_context;
+    bound[1]++;
+
+    return (*(const int*)_element > bound[0]);
+}
+
+static bool pred_less_than_counted(const void* _element, void* _context)
+{
+    int* bound;
+
+    bound = (int*)_context;
+    bound[1]++;
+
+    return (*(const int*)_element < bound[0]);
+}
+
 static int cmp_int(const void* _a, const void* _b, void* _context)
 {
     const int* a;
@@ -131,7 +152,7 @@ d_tests_sa_filter_apply_operation
     }
 
     d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
 
     // test 2: take_last(2) returns last 2 elements
     op  = d_filter_take_last(2);
@@ -159,7 +180,7 @@ d_tests_sa_filter_apply_operation
     }
 
     d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
 
     // test 3: skip_first(2) returns last 3 elements
     op  = d_filter_skip_first(2);
@@ -188,7 +209,7 @@ d_tests_sa_filter_apply_operation
     }
 
     d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
 
     // test 4: where predicate filters even elements
     // all of {10,20,30,40,50} are even, so all should pass
@@ -226,7 +247,7 @@ d_tests_sa_filter_apply_operation
     }
 
     d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
 
     // test 5: range [1, 4) selects elements at indices 1, 2, 3
     op  = d_filter_range(1, 4);
@@ -255,7 +276,7 @@ d_tests_sa_filter_apply_operation
     }
 
     d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
 
     // test 6: reverse reverses order
     op  = d_filter_reverse();
@@ -286,7 +307,7 @@ d_tests_sa_filter_apply_operation
     }
 
     d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
 
     // test 7: NULL operation returns error
     res = d_filter_apply_operation(NULL,
@@ -308,7 +329,7 @@ d_tests_sa_filter_apply_operation
         _counter) && result;
 
     d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
 
     // test 8: NULL input returns error
     res = d_filter_apply_operation(op,
@@ -324,7 +345,7 @@ d_tests_sa_filter_apply_operation
         _counter) && result;
 
     d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
 
     // test 9: zero count returns empty result
     op  = d_filter_take_first(3);
@@ -340,7 +361,7 @@ d_tests_sa_filter_apply_operation
         _counter) && result;
 
     d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
 
     // test 10: zero element_size returns error
     res = d_filter_apply_operation(op,
@@ -356,7 +377,7 @@ d_tests_sa_filter_apply_operation
         _counter) && result;
 
     d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
 
     return result;
 }
@@ -412,7 +433,7 @@ d_tests_sa_filter_apply_chain
             _counter) && result;
 
         d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
         d_filter_chain_free(chain);
     }
 
@@ -448,7 +469,7 @@ d_tests_sa_filter_apply_chain
         }
 
         d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
         d_filter_chain_free(chain);
     }
 
@@ -486,7 +507,7 @@ d_tests_sa_filter_apply_chain
         }
 
         d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
         d_filter_chain_free(chain);
     }
 
@@ -523,7 +544,7 @@ d_tests_sa_filter_apply_chain
         }
 
         d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
         d_filter_chain_free(chain);
     }
 
@@ -562,7 +583,7 @@ d_tests_sa_filter_apply_chain
         }
 
         d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
         d_filter_chain_free(chain);
     }
 
@@ -580,7 +601,7 @@ d_tests_sa_filter_apply_chain
         _counter) && result;
 
     d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
 
     // test 7: NULL input returns error
     chain = d_filter_chain_new();
@@ -602,7 +623,7 @@ d_tests_sa_filter_apply_chain
             _counter) && result;
 
         d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
         d_filter_chain_free(chain);
     }
 
@@ -625,7 +646,7 @@ d_tests_sa_filter_apply_chain
             _counter) && result;
 
         d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
         d_filter_chain_free(chain);
     }
 
@@ -729,7 +750,7 @@ d_tests_sa_filter_apply_combinators
         }
 
         d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
         d_filter_union_free(u);
     }
 
@@ -771,7 +792,7 @@ d_tests_sa_filter_apply_combinators
         }
 
         d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
         d_filter_intersection_free(inter);
     }
 
@@ -811,7 +832,7 @@ d_tests_sa_filter_apply_combinators
         }
 
         d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
         d_filter_difference_free(diff);
     }
 
@@ -829,7 +850,7 @@ d_tests_sa_filter_apply_combinators
         _counter) && result;
 
     d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
 
     // test 5: NULL intersection returns error
     res = d_filter_apply_intersection(NULL,
@@ -845,7 +866,7 @@ d_tests_sa_filter_apply_combinators
         _counter) && result;
 
     d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
 
     // test 6: NULL difference returns error
     res = d_filter_apply_difference(NULL,
@@ -861,7 +882,7 @@ d_tests_sa_filter_apply_combinators
         _counter) && result;
 
     d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
 
     // cleanup shared chains
     d_filter_chain_free(chain_even);
@@ -1114,7 +1135,7 @@ d_tests_sa_filter_get_indices
             _counter) && result;
     }
 
-    free(indices);
+    d_functional_free(indices);
 
     d_filter_chain_free(chain);
 
@@ -1436,7 +1457,7 @@ d_tests_sa_filter_result_free
     // test 2: free empty/zeroed result does not crash
     d_memset(&res, 0, sizeof(res));
     d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
 
     result = d_assert_standalone(
         true,
@@ -1717,6 +1738,199 @@ d_tests_sa_filter_matches_element
 }
 
 
+/*
+d_tests_sa_filter_apply_sorted
+  Tests monotone WHERE operations over chains with a sorted hint.
+  Tests the following:
+  - where_monotone stores its shape; set_sorted and clone keep the hint
+  - rising and falling predicates select the same elements as a scan, with
+    O(log n) predicate calls
+  - a BETWEEN range as a rising then a falling operation
+  - WHERE_NOT flips the shape
+  - an operation after REVERSE is scanned, not searched
+*/
+bool
+d_tests_sa_filter_apply_sorted
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_filter_chain*     chain;
+    struct d_filter_chain*     copy;
+    struct d_filter_operation* op;
+    struct d_filter_result*    res;
+    int                        input[1000];
+    int                        low[2];
+    int                        high[2];
+    bool                       result;
+    bool                       ok;
+    size_t                     i;
+
+    result = true;
+
+    for (i = 0; i < 1000; i++)
+    {
+        input[i] = (int)i;
+    }
+
+    low[0]  = 899;
+    low[1]  = 0;
+    high[0] = 100;
+    high[1] = 0;
+
+    // test 1: constructor, hint, and clone
+    op = d_filter_where_monotone(pred_greater_than_counted,
+                                 low,
+                                 D_FILTER_MONOTONE_RISING);
+
+    result = d_assert_standalone(
+        (op != NULL)                                         &&
+        (op->type == D_FILTER_OP_WHERE)                      &&
+        (op->params.monotone == D_FILTER_MONOTONE_RISING)    &&
+        (op->params.context == low),
+        "sorted_monotone_params",
+        "where_monotone should store the predicate and its shape",
+        _counter) && result;
+
+    chain = d_filter_chain_new();
+    d_filter_chain_add(chain, op);
+    d_functional_free(op);
+    copy  = d_filter_chain_clone(chain);
+
+    result = d_assert_standalone(
+        (!d_filter_chain_set_sorted(NULL, cmp_int, NULL))    &&
+        (d_filter_chain_set_sorted(chain, cmp_int, NULL))    &&
+        (chain->sorted_by == cmp_int)                        &&
+        (copy->sorted_by == NULL),
+        "sorted_hint_set",
+        "set_sorted should record the comparator",
+        _counter) && result;
+
+    d_filter_chain_free(copy);
+    copy = d_filter_chain_clone(chain);
+
+    result = d_assert_standalone(
+        (copy != NULL)                                       &&
+        (copy->sorted_by == cmp_int)                         &&
+        (copy->operations[0].params.monotone ==
+             D_FILTER_MONOTONE_RISING),
+        "sorted_hint_clone",
+        "clone should keep the hint and the shape",
+        _counter) && result;
+
+    d_filter_chain_free(copy);
+
+    // test 2: rising predicate, searched
+    res = d_filter_apply_chain(chain, input, 1000, sizeof(int));
+
+    result = d_assert_standalone(
+        (res->count == 100)                                  &&
+        (((int*)res->elements)[0] == 900)                    &&
+        (((int*)res->elements)[99] == 999)                   &&
+        (low[1] <= 12),
+        "sorted_rising",
+        "x > 899 should keep 900..999 in O(log n) calls",
+        _counter) && result;
+
+    d_filter_result_free(res);
+    d_functional_free(res);
+
+    // test 3: BETWEEN as rising then falling, matches an unhinted scan
+    low[0]  = 249;
+    high[0] = 500;
+    op      = d_filter_where_monotone(pred_less_than_counted,
+                                      high,
+                                      D_FILTER_MONOTONE_FALLING);
+    d_filter_chain_add(chain, op);
+    d_functional_free(op);
+    copy = d_filter_chain_clone(chain);
+    d_filter_chain_set_sorted(copy, NULL, NULL);
+
+    low[1]  = 0;
+    high[1] = 0;
+    res     = d_filter_apply_chain(chain, input, 1000, sizeof(int));
+    ok      = (res->count == 250)                        &&
+              (low[1] + high[1] <= 24);
+
+    d_filter_result_free(res);
+    d_functional_free(res);
+
+    low[1]  = 0;
+    high[1] = 0;
+    res     = d_filter_apply_chain(copy, input, 1000, sizeof(int));
+    ok      = ok                                         &&
+              (res->count == 250)                        &&
+              (((int*)res->elements)[0] == 250)          &&
+              (((int*)res->elements)[249] == 499)        &&
+              (low[1] == 1000);
+
+    result = d_assert_standalone(
+        ok,
+        "sorted_between",
+        "249 < x < 500 should match the scan with far fewer calls",
+        _counter) && result;
+
+    d_filter_result_free(res);
+    d_functional_free(res);
+    d_filter_chain_free(copy);
+    d_filter_chain_free(chain);
+
+    // test 4: WHERE_NOT flips the shape
+    chain       = d_filter_chain_new();
+    op          = d_filter_where_monotone(pred_less_than_counted,
+                                          high,
+                                          D_FILTER_MONOTONE_FALLING);
+    op->type    = D_FILTER_OP_WHERE_NOT;
+    high[0]     = 990;
+    d_filter_chain_add(chain, op);
+    d_functional_free(op);
+    d_filter_chain_set_sorted(chain, cmp_int, NULL);
+
+    res = d_filter_apply_chain(chain, input, 1000, sizeof(int));
+
+    result = d_assert_standalone(
+        (res->count == 10)                                   &&
+        (((int*)res->elements)[0] == 990),
+        "sorted_where_not",
+        "NOT(x < 990) should keep 990..999",
+        _counter) && result;
+
+    d_filter_result_free(res);
+    d_functional_free(res);
+    d_filter_chain_free(chain);
+
+    // test 5: reverse drops the hint for later operations
+    chain   = d_filter_chain_new();
+    high[0] = 10;
+    high[1] = 0;
+    op      = d_filter_reverse();
+    d_filter_chain_add(chain, op);
+    d_functional_free(op);
+    op      = d_filter_where_monotone(pred_less_than_counted,
+                                      high,
+                                      D_FILTER_MONOTONE_FALLING);
+    d_filter_chain_add(chain, op);
+    d_functional_free(op);
+    d_filter_chain_set_sorted(chain, cmp_int, NULL);
+
+    res = d_filter_apply_chain(chain, input, 1000, sizeof(int));
+
+    result = d_assert_standalone(
+        (res->count == 10)                                   &&
+        (((int*)res->elements)[0] == 9)                      &&
+        (high[1] == 1000),
+        "sorted_after_reverse",
+        "an operation after reverse should be scanned",
+        _counter) && result;
+
+    d_filter_result_free(res);
+    d_functional_free(res);
+    d_filter_chain_free(chain);
+
+    return result;
+}
+
+
 /*
 d_tests_sa_filter_execution_all
   Aggregation function that runs all execution and application tests.
@@ -1742,6 +1956,7 @@ d_tests_sa_filter_execution_all
     result = d_tests_sa_filter_in_place(_counter)          && result;
     result = d_tests_sa_filter_result_free(_counter)       && result;
     result = d_tests_sa_filter_matches_element(_counter)   && result;
+    result = d_tests_sa_filter_apply_sorted(_counter)      && result;
 
     return result;
 }
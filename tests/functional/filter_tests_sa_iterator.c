@@ -37,6 +37,65 @@ static bool pred_is_positive(const void* _element, void* _context)
     return (*value > 0);
 }
 
+// cmp_int_asc
+//   helper: ascending int comparator.
+static int
+cmp_int_asc
+(
+    const void* _a,
+    const void* _b,
+    void*       _context
+)
+{
+    (void)_context;
+
+    return (*(const int*)_a > *(const int*)_b) -
+           (*(const int*)_a < *(const int*)_b);
+}
+
+// stream_add
+//   helper: adds an operation to a chain and frees the operation struct
+// (the chain takes over its indices).
+static void
+stream_add
+(
+    struct d_filter_chain*     _chain,
+    struct d_filter_operation* _op
+)
+{
+    d_filter_chain_add(_chain, _op);
+    d_functional_free(_op);
+
+    return;
+}
+
+// stream_counting_next
+//   helper: fn_source_next forwarding to an array source (state[0]) and
+// counting the pulls that returned elements.
+static bool
+stream_counting_next
+(
+    void*        _context,
+    const void** _chunk,
+    size_t*      _count
+)
+{
+    void** state;
+    bool   ok;
+
+    state = (void**)_context;
+    ok    = d_functional_source_next(
+                (struct d_functional_source*)state[0], _chunk, _count);
+
+    if ( (ok) &&
+         (*_count > 0) )
+    {
+        (*(size_t*)state[1])++;
+    }
+
+    return ok;
+}
+
 
 /*
 d_tests_sa_filter_iterator_create
@@ -834,6 +893,231 @@ d_tests_sa_filter_iterator_edge
 }
 
 
+/*
+d_tests_sa_filter_iterator_stream
+  Tests d_filter_stream and d_filter_apply_chain_source.
+  Tests the following:
+  - chains of positional, predicate, distinct, take-last, skip-last, top-k,
+    and index operations give the same result as d_filter_apply_chain for
+    chunk sizes from 1 element to the whole input, including a take_last
+    that nothing reaches
+  - a satisfied take_first stops pulling from the source
+  - REVERSE and unordered at_indices are rejected
+  - a filter stream is itself a source
+*/
+bool
+d_tests_sa_filter_iterator_stream
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                             result;
+    bool                             ok;
+    struct d_filter_chain*           chains[7];
+    struct d_filter_chain*           chain;
+    struct d_filter_result*          eager;
+    struct d_filter_result*          streamed;
+    struct d_filter_stream*          stream;
+    struct d_functional_stream*      pipeline;
+    struct d_functional_array_source state;
+    struct d_functional_source       inner;
+    struct d_functional_source       counted;
+    void*                            counter_state[2];
+    size_t                           pulls;
+    size_t                           chunk_sizes[5];
+    size_t                           indices[4];
+    size_t                           unordered[2];
+    int                              values[100];
+    int*                             collected;
+    size_t                           n;
+    size_t                           c;
+    size_t                           s;
+    size_t                           i;
+
+    result = true;
+
+    // every value appears twice, out of order
+    for (i = 0; i < 100; i++)
+    {
+        values[i] = (int)((i * 13) % 50) - 10;
+    }
+
+    chunk_sizes[0] = 1;
+    chunk_sizes[1] = 3;
+    chunk_sizes[2] = 7;
+    chunk_sizes[3] = 64;
+    chunk_sizes[4] = 0;
+    indices[0]     = 2;
+    indices[1]     = 5;
+    indices[2]     = 40;
+    indices[3]     = 99;
+
+    for (c = 0; c < 7; c++)
+    {
+        chains[c] = d_filter_chain_new();
+    }
+
+    stream_add(chains[0], d_filter_skip_first(5));
+    stream_add(chains[0], d_filter_where(pred_is_even));
+    stream_add(chains[0], d_filter_take_first(10));
+
+    stream_add(chains[1], d_filter_range(10, 80));
+    stream_add(chains[1], d_filter_take_nth(3));
+    stream_add(chains[1], d_filter_skip_last(4));
+
+    stream_add(chains[2], d_filter_distinct(cmp_int_asc));
+    stream_add(chains[2], d_filter_take_last(7));
+
+    stream_add(chains[3], d_filter_slice(3, 90, 4));
+    stream_add(chains[3], d_filter_top_k(5, cmp_int_asc, NULL));
+    stream_add(chains[3], d_filter_skip_first(1));
+
+    stream_add(chains[4], d_filter_where(pred_is_positive));
+    stream_add(chains[4], d_filter_init());
+    stream_add(chains[4], d_filter_distinct(cmp_int_asc));
+    stream_add(chains[4], d_filter_tail());
+
+    stream_add(chains[5], d_filter_at_indices(indices, 4));
+    stream_add(chains[5], d_filter_at(2));
+
+    // nothing reaches take_last, so it holds nothing at the end
+    stream_add(chains[6], d_filter_skip_first(200));
+    stream_add(chains[6], d_filter_take_last(3));
+
+    // test 1: streamed results equal eager results for every chunk size
+    ok = true;
+
+    for (c = 0; c < 7; c++)
+    {
+        eager = d_filter_apply_chain(chains[c], values, 100, sizeof(int));
+
+        for (s = 0; s < 5; s++)
+        {
+            streamed = d_filter_apply_chain_source(
+                           chains[c],
+                           d_functional_source_array(&state,
+                                                     values,
+                                                     100,
+                                                     sizeof(int),
+                                                     chunk_sizes[s]));
+
+            ok = ok                                                   &&
+                 (eager)                                              &&
+                 (streamed)                                           &&
+                 (streamed->status == eager->status)                  &&
+                 (streamed->count == eager->count)                    &&
+                 ( (eager->count == 0) ||
+                   (memcmp(streamed->elements,
+                           eager->elements,
+                           eager->count * sizeof(int)) == 0) );
+
+            d_filter_result_free(streamed);
+        }
+
+        d_filter_result_free(eager);
+    }
+
+    result = d_assert_standalone(
+        ok,
+        "stream_matches_eager",
+        "streamed chains should equal d_filter_apply_chain",
+        _counter) && result;
+
+    // test 2: a satisfied take stops pulling
+    pulls            = 0;
+    inner            = d_functional_source_array(&state, values, 100,
+                                                 sizeof(int), 2);
+    counter_state[0] = &inner;
+    counter_state[1] = &pulls;
+    counted.next_chunk   = stream_counting_next;
+    counted.context      = counter_state;
+    counted.element_size = sizeof(int);
+
+    chain = d_filter_chain_new();
+    stream_add(chain, d_filter_take_first(5));
+    streamed = d_filter_apply_chain_source(chain, counted);
+
+    result = d_assert_standalone(
+        (streamed)                 &&
+        (streamed->count == 5)     &&
+        (pulls == 3),
+        "stream_take_stops",
+        "take_first(5) over 2-element chunks should pull 3 chunks",
+        _counter) && result;
+
+    d_filter_result_free(streamed);
+    d_filter_chain_free(chain);
+
+    // test 3: operations that need the whole input are rejected
+    unordered[0] = 7;
+    unordered[1] = 3;
+    chain        = d_filter_chain_new();
+    stream_add(chain, d_filter_reverse());
+    streamed = d_filter_apply_chain_source(
+                   chain,
+                   d_functional_source_array(&state, values, 100,
+                                             sizeof(int), 8));
+
+    result = d_assert_standalone(
+        (d_filter_stream_new(chain,
+                             d_functional_source_array(&state, values, 100,
+                                                       sizeof(int), 8))
+             == NULL)                                                    &&
+        (streamed)                                                       &&
+        (streamed->status == D_FILTER_RESULT_INVALID),
+        "stream_reverse_rejected",
+        "a chain containing reverse should not be streamable",
+        _counter) && result;
+
+    d_filter_result_free(streamed);
+    d_filter_chain_free(chain);
+
+    chain = d_filter_chain_new();
+    stream_add(chain, d_filter_at_indices(unordered, 2));
+
+    result = d_assert_standalone(
+        (d_filter_stream_new(chain,
+                             d_functional_source_array(&state, values, 100,
+                                                       sizeof(int), 8))
+             == NULL),
+        "stream_indices_rejected",
+        "unordered at_indices should not be streamable",
+        _counter) && result;
+
+    d_filter_chain_free(chain);
+
+    // test 4: a filter stream feeding a functional stream
+    stream    = d_filter_stream_new(
+                    chains[0],
+                    d_functional_source_array(&state, values, 100,
+                                              sizeof(int), 6));
+    pipeline  = d_functional_stream_new(d_filter_stream_source(stream));
+    collected = d_functional_stream_collect(pipeline, &n);
+    eager     = d_filter_apply_chain(chains[0], values, 100, sizeof(int));
+
+    result = d_assert_standalone(
+        (collected)                                               &&
+        (eager)                                                   &&
+        (n == eager->count)                                       &&
+        (memcmp(collected, eager->elements, n * sizeof(int)) == 0),
+        "stream_as_source",
+        "a filter stream should act as a source",
+        _counter) && result;
+
+    d_functional_free(collected);
+    d_filter_result_free(eager);
+    d_functional_stream_free(pipeline);
+    d_filter_stream_free(stream);
+
+    for (c = 0; c < 7; c++)
+    {
+        d_filter_chain_free(chains[c]);
+    }
+
+    return result;
+}
+
+
 /*
 d_tests_sa_filter_iterator_all
   Aggregation function that runs all iterator interface tests.
@@ -855,6 +1139,7 @@ d_tests_sa_filter_iterator_all
     result = d_tests_sa_filter_iterator_traverse(_counter)  && result;
     result = d_tests_sa_filter_iterator_reset(_counter)     && result;
     result = d_tests_sa_filter_iterator_edge(_counter)      && result;
+    result = d_tests_sa_filter_iterator_stream(_counter)    && result;
 
     return result;
 }
@@ -116,7 +116,7 @@ d_tests_sa_filter_macros_single
     }
 
     d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
 
     // test 2: D_FILTER_FIRST_N returns first N
     res = D_FILTER_FIRST_N(input, 6, sizeof(int), 2);
@@ -140,7 +140,7 @@ d_tests_sa_filter_macros_single
     }
 
     d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
 
     // test 3: D_FILTER_FIRST_N with N > count
     res = D_FILTER_FIRST_N(input, 6, sizeof(int), 100);
@@ -152,7 +152,7 @@ d_tests_sa_filter_macros_single
         _counter) && result;
 
     d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
 
     // test 4: D_FILTER_LAST_N returns last N
     res = D_FILTER_LAST_N(input, 6, sizeof(int), 2);
@@ -176,7 +176,7 @@ d_tests_sa_filter_macros_single
     }
 
     d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
 
     // test 5: D_FILTER_LAST_N with N > count
     res = D_FILTER_LAST_N(input, 6, sizeof(int), 100);
@@ -188,7 +188,7 @@ d_tests_sa_filter_macros_single
         _counter) && result;
 
     d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
 
     // test 6: D_FILTER_WHERE filters correctly
     // all values {10,20,30,40,50,60} are even, so all pass
@@ -201,7 +201,7 @@ d_tests_sa_filter_macros_single
         _counter) && result;
 
     d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
 
     // test 7: D_FILTER_WHERE with no matches
     // none are negative, so is_positive passes all;
@@ -225,7 +225,7 @@ d_tests_sa_filter_macros_single
             _counter) && result;
 
         d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
     }
 
     // test 8: D_FILTER_CHAIN_BEGIN / ADD / END
@@ -280,7 +280,7 @@ d_tests_sa_filter_macros_single
         }
 
         d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
         d_filter_chain_free(chain);
     }
 
@@ -386,7 +386,7 @@ d_tests_sa_filter_macros_fluent
         }
 
         d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
         d_filter_builder_free(builder);
     }
 
@@ -422,7 +422,7 @@ d_tests_sa_filter_macros_fluent
         }
 
         d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
         d_filter_builder_free(builder);
     }
 
@@ -457,7 +457,7 @@ d_tests_sa_filter_macros_fluent
         }
 
         d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
         d_filter_builder_free(builder);
     }
 
@@ -495,7 +495,7 @@ d_tests_sa_filter_macros_fluent
         }
 
         d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
         d_filter_builder_free(builder);
     }
 
@@ -532,7 +532,7 @@ d_tests_sa_filter_macros_fluent
         }
 
         d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
         d_filter_builder_free(builder);
     }
 
@@ -571,7 +571,7 @@ d_tests_sa_filter_macros_fluent
         }
 
         d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
         d_filter_builder_free(builder);
     }
 
@@ -619,7 +619,7 @@ d_tests_sa_filter_macros_fluent
             }
 
             d_filter_result_free(res);
-    free(res);
+    d_functional_free(res);
             d_filter_builder_free(builder);
         }
     }
@@ -683,9 +683,9 @@ d_tests_sa_filter_macros_fluent
             }
 
             d_filter_result_free(res_a);
-            free(res_a);
+            d_functional_free(res_a);
             d_filter_result_free(res_b);
-            free(res_b);
+            d_functional_free(res_b);
         }
 
         d_filter_builder_free(builder_a);
@@ -593,6 +593,97 @@ d_tests_sa_filter_op_distinct_reverse
 }
 
 
+/*
+d_tests_sa_filter_op_top_k
+  Tests the top-k operation constructor and application.
+  Tests the following:
+  - top_k stores k, comparator, and context
+  - applying it yields the k greatest elements, greatest first
+  - k larger than the input keeps every element
+  - a top-k operation without comparator is invalid
+*/
+bool
+d_tests_sa_filter_op_top_k
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_filter_operation* op;
+    struct d_filter_result*    res;
+    int                        data[7];
+    int                        context;
+    const int*                 out;
+    bool                       result;
+
+    result  = true;
+    data[0] = 40;
+    data[1] = 10;
+    data[2] = 70;
+    data[3] = 30;
+    data[4] = 60;
+    data[5] = 20;
+    data[6] = 50;
+    context = 0;
+
+    // test 1: top_k stores parameters
+    op     = d_filter_top_k(3, cmp_int, &context);
+    result = d_assert_standalone(
+        (op->type == D_FILTER_OP_TOP_K)        &&
+        (op->params.count == 3)                &&
+        (op->params.comparator == cmp_int)     &&
+        (op->params.context == &context),
+        "top_k_params",
+        "top_k should store k, comparator, and context",
+        _counter) && result;
+
+    // test 2: apply selects the greatest elements
+    res = d_filter_apply_operation(op, data, 7, sizeof(int));
+    out = (const int*)res->elements;
+
+    result = d_assert_standalone(
+        (res->count == 3) &&
+        (out[0] == 70)    &&
+        (out[1] == 60)    &&
+        (out[2] == 50),
+        "top_k_apply",
+        "top_k(3) should return {70, 60, 50}",
+        _counter) && result;
+
+    d_filter_result_free(res);
+    d_functional_free(res);
+    d_functional_free(op);
+
+    // test 3: k larger than input
+    op  = d_filter_top_k(10, cmp_int, NULL);
+    res = d_filter_apply_operation(op, data, 7, sizeof(int));
+    out = (const int*)res->elements;
+
+    result = d_assert_standalone(
+        (res->count == 7) &&
+        (out[0] == 70)    &&
+        (out[6] == 10),
+        "top_k_all",
+        "top_k larger than the input should keep all elements, sorted",
+        _counter) && result;
+
+    d_filter_result_free(res);
+    d_functional_free(res);
+
+    // test 4: comparator required
+    op->params.comparator = NULL;
+
+    result = d_assert_standalone(
+        !d_filter_operation_is_valid(op),
+        "top_k_requires_comparator",
+        "top_k without comparator should be invalid",
+        _counter) && result;
+
+    d_functional_free(op);
+
+    return result;
+}
+
+
 /*
 d_tests_sa_filter_op_free
   Tests d_filter_operation_free.
@@ -694,6 +785,7 @@ d_tests_sa_filter_operations_all
     result = d_tests_sa_filter_op_where(_counter)            && result;
     result = d_tests_sa_filter_op_indices(_counter)          && result;
     result = d_tests_sa_filter_op_distinct_reverse(_counter) && result;
+    result = d_tests_sa_filter_op_top_k(_counter)            && result;
     result = d_tests_sa_filter_op_free(_counter)             && result;
 
     return result;
@@ -294,7 +294,7 @@ d_tests_sa_filter_to_string
             "to_string(take_first) should return non-empty",
             _counter) && result;
 
-        free(str);
+        d_functional_free(str);
     }
 
     // test 2: where to_string returns non-NULL
@@ -309,7 +309,7 @@ d_tests_sa_filter_to_string
 
     if (str)
     {
-        free(str);
+        d_functional_free(str);
     }
 
     // test 3: range to_string returns non-NULL
@@ -324,7 +324,7 @@ d_tests_sa_filter_to_string
 
     if (str)
     {
-        free(str);
+        d_functional_free(str);
     }
 
     // test 4: reverse to_string returns non-NULL
@@ -339,7 +339,7 @@ d_tests_sa_filter_to_string
 
     if (str)
     {
-        free(str);
+        d_functional_free(str);
     }
 
     // test 5: slice to_string returns non-NULL
@@ -354,7 +354,7 @@ d_tests_sa_filter_to_string
 
     if (str)
     {
-        free(str);
+        d_functional_free(str);
     }
 
     // test 6: NULL operation returns NULL
@@ -390,7 +390,7 @@ d_tests_sa_filter_to_string
                 "chain to_string should be non-empty",
                 _counter) && result;
 
-            free(str);
+            d_functional_free(str);
         }
 
         d_filter_chain_free(chain);
@@ -411,7 +411,7 @@ d_tests_sa_filter_to_string
 
         if (str)
         {
-            free(str);
+            d_functional_free(str);
         }
 
         d_filter_chain_free(chain);
@@ -485,10 +485,10 @@ d_tests_sa_filter_from_string
                 _counter) && result;
 
             d_filter_operation_free(parsed_op);
-            free(parsed_op);
+            d_functional_free(parsed_op);
         }
 
-        free(str);
+        d_functional_free(str);
     }
 
     // test 2: round-trip for range operation
@@ -521,10 +521,10 @@ d_tests_sa_filter_from_string
                 _counter) && result;
 
             d_filter_operation_free(parsed_op);
-            free(parsed_op);
+            d_functional_free(parsed_op);
         }
 
-        free(str);
+        d_functional_free(str);
     }
 
     // test 3: round-trip for chain
@@ -561,7 +561,7 @@ d_tests_sa_filter_from_string
                 d_filter_chain_free(parsed_chain);
             }
 
-            free(str);
+            d_functional_free(str);
         }
 
         d_filter_chain_free(original_chain);
@@ -643,6 +643,930 @@ d_tests_sa_filter_from_string
 }
 
 
+/*
+d_tests_sa_filter_round_trip
+  Tests serialization of chains with registered predicates and comparators.
+  Tests the following:
+  - a chain with where, distinct, top-k, and index operations prints back
+    to the text it was parsed from, and runs as described
+  - the same name and arguments resolve to the same predicate and context
+  - real and multi-argument parameters, and shaped where, round-trip
+  - unknown names, missing or ill-typed arguments, and out-of-range values
+    are rejected
+  - an unregistered predicate prints, but does not parse back
+*/
+bool
+d_tests_sa_filter_round_trip
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                       result;
+    struct d_filter_chain*     chain;
+    struct d_filter_result*    res;
+    struct d_filter_operation* op1;
+    struct d_filter_operation* op2;
+    char*                      str;
+    const char*                text;
+    int32_t                    data[8] = { 1, 20, 15, 20, 30, 5, 40, 12 };
+    const int32_t*             out;
+
+    result = true;
+    text   = "skip_first(2) -> where(gt_i32, 10) -> distinct(asc_i32)"
+             " -> top_k(3, asc_i32) -> at_indices(0, 2)";
+
+    // test 1: chain text round-trips and runs
+    chain = d_filter_chain_from_string(text);
+    str   = (chain) ? d_filter_chain_to_string(chain) : NULL;
+    res   = (chain) ? d_filter_apply_chain(chain, data, 8, sizeof(int32_t))
+                    : NULL;
+    out   = (res) ? (const int32_t*)res->elements : NULL;
+
+    result = d_assert_standalone(
+        (chain != NULL) && (chain->count == 5) &&
+        (str != NULL) && (strcmp(str, text) == 0),
+        "round_trip_chain_text",
+        "a parsed chain should print back to the same text",
+        _counter) && result;
+
+    // skip 2, > 10, distinct: 15 20 30 40 12; top 3: 40 30 20; [0, 2]
+    result = d_assert_standalone(
+        (out != NULL) && (res->count == 2) &&
+        (out[0] == 40) && (out[1] == 20),
+        "round_trip_chain_runs",
+        "the parsed chain should filter as written",
+        _counter) && result;
+
+    d_functional_free(str);
+    d_filter_result_free(res);
+    d_filter_chain_free(chain);
+
+    // test 2: interned predicates
+    op1 = d_filter_operation_from_string("where(between_i64, -5, 5)");
+    op2 = d_filter_operation_from_string("where(between_i64,-5,5)");
+
+    result = d_assert_standalone(
+        (op1 != NULL) && (op2 != NULL) &&
+        (op1->params.test == op2->params.test) &&
+        (op1->params.context == op2->params.context),
+        "round_trip_interned",
+        "equal names and arguments should give the same context",
+        _counter) && result;
+
+    d_filter_operation_free(op1);
+    d_filter_operation_free(op2);
+
+    // test 3: reals and shapes
+    op1 = d_filter_operation_from_string("where_rising(ge_f64, 0.5)");
+    str = (op1) ? d_filter_operation_to_string(op1) : NULL;
+
+    result = d_assert_standalone(
+        (op1 != NULL) &&
+        (op1->params.monotone == D_FILTER_MONOTONE_RISING) &&
+        (str != NULL) && (strcmp(str, "where_rising(ge_f64, 0.5)") == 0),
+        "round_trip_real_shape",
+        "a shaped where with a real argument should round-trip",
+        _counter) && result;
+
+    d_functional_free(str);
+    d_filter_operation_free(op1);
+
+    op1 = d_filter_operation_from_string("where_not(even_i32)");
+    str = (op1) ? d_filter_operation_to_string(op1) : NULL;
+
+    result = d_assert_standalone(
+        (op1 != NULL) && (op1->type == D_FILTER_OP_WHERE_NOT) &&
+        (str != NULL) && (strcmp(str, "where_not(even_i32)") == 0),
+        "round_trip_no_params",
+        "a predicate without parameters should round-trip",
+        _counter) && result;
+
+    d_functional_free(str);
+    d_filter_operation_free(op1);
+
+    // test 4: rejection
+    result = d_assert_standalone(
+        (d_filter_operation_from_string("where(no_such_i32, 1)") == NULL) &&
+        (d_filter_operation_from_string("where(gt_i32)") == NULL)         &&
+        (d_filter_operation_from_string("where(gt_i32, 1.5)") == NULL)    &&
+        (d_filter_operation_from_string(
+             "where(gt_i32, 5000000000)") == NULL)                         &&
+        (d_filter_operation_from_string("where(gt_i32, 1) x") == NULL)    &&
+        (d_filter_operation_from_string("distinct(gt_i32, 1)") == NULL)   &&
+        (d_filter_operation_from_string("top_k(3)") == NULL)              &&
+        (d_filter_operation_from_string("at_indices()") == NULL),
+        "round_trip_rejection",
+        "malformed or unregistered calls should not parse",
+        _counter) && result;
+
+    // test 5: unregistered predicates print as addresses
+    op1 = d_filter_where(pred_is_even);
+    str = (op1) ? d_filter_operation_to_string(op1) : NULL;
+    op2 = (str) ? d_filter_operation_from_string(str) : NULL;
+
+    result = d_assert_standalone(
+        (str != NULL) && (strncmp(str, "where(", 6) == 0) && (op2 == NULL),
+        "round_trip_unregistered",
+        "an unregistered predicate should print but not parse back",
+        _counter) && result;
+
+    d_functional_free(str);
+    d_filter_operation_free(op1);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_filter_canonical
+  Tests d_filter_chain_canonical.
+  Tests the following:
+  - aliases and their general forms, and different spacing and
+    separators, give the same canonical text
+  - the sorted hint is part of the text and parses back
+  - unregistered predicates give NULL
+  - an empty chain gives "", NULL gives NULL
+*/
+bool
+d_tests_sa_filter_canonical
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                       result;
+    struct d_filter_chain*     chain1;
+    struct d_filter_chain*     chain2;
+    struct d_filter_operation* op;
+    char*                      text1;
+    char*                      text2;
+
+    result = true;
+
+    // test 1: equivalent spellings
+    chain1 = d_filter_chain_from_string(
+                 "head -> rest -> init -> where(gt_i32, 10)");
+    chain2 = d_filter_chain_from_string(
+                 "take_first(1)|skip_first(1)|skip_last(1)"
+                 "|where( gt_i32 ,10 )");
+    text1  = (chain1) ? d_filter_chain_canonical(chain1) : NULL;
+    text2  = (chain2) ? d_filter_chain_canonical(chain2) : NULL;
+
+    result = d_assert_standalone(
+        (text1 != NULL) && (text2 != NULL) &&
+        (strcmp(text1, text2) == 0) &&
+        (strcmp(text1, "take_first(1)|skip_first(1)|skip_last(1)"
+                       "|where(gt_i32, 10)") == 0),
+        "canonical_equivalent",
+        "equivalent chains should have the same canonical text",
+        _counter) && result;
+
+    d_functional_free(text1);
+    d_functional_free(text2);
+    d_filter_chain_free(chain1);
+    d_filter_chain_free(chain2);
+
+    // test 2: the sorted hint
+    chain1 = d_filter_chain_from_string(
+                 "sorted(asc_i32) -> where_rising(ge_i32, 3)");
+    text1  = (chain1) ? d_filter_chain_canonical(chain1) : NULL;
+    chain2 = (text1) ? d_filter_chain_from_string(text1) : NULL;
+    text2  = (chain2) ? d_filter_chain_canonical(chain2) : NULL;
+
+    result = d_assert_standalone(
+        (chain1 != NULL) && (chain1->sorted_by != NULL) &&
+        (text1 != NULL) &&
+        (strcmp(text1, "sorted(asc_i32)|where_rising(ge_i32, 3)") == 0) &&
+        (text2 != NULL) && (strcmp(text1, text2) == 0),
+        "canonical_sorted",
+        "the sorted hint should be written and parsed back",
+        _counter) && result;
+
+    d_functional_free(text1);
+    d_functional_free(text2);
+    d_filter_chain_free(chain1);
+    d_filter_chain_free(chain2);
+
+    // test 3: unregistered predicate
+    chain1 = d_filter_chain_new();
+    op     = d_filter_where(pred_is_positive);
+
+    if ( (chain1) && (op) )
+    {
+        d_filter_chain_add(chain1, op);
+    }
+
+    d_functional_free(op);
+    text1 = (chain1) ? d_filter_chain_canonical(chain1) : NULL;
+
+    result = d_assert_standalone(
+        (chain1 != NULL) && (text1 == NULL),
+        "canonical_unregistered",
+        "an unregistered predicate should have no canonical text",
+        _counter) && result;
+
+    d_functional_free(text1);
+    d_filter_chain_free(chain1);
+
+    // test 4: empty and NULL chains
+    chain1 = d_filter_chain_new();
+    text1  = (chain1) ? d_filter_chain_canonical(chain1) : NULL;
+
+    result = d_assert_standalone(
+        (text1 != NULL) && (text1[0] == '\0') &&
+        (d_filter_chain_canonical(NULL) == NULL),
+        "canonical_empty",
+        "an empty chain should give \"\" and NULL should give NULL",
+        _counter) && result;
+
+    d_functional_free(text1);
+    d_filter_chain_free(chain1);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_filter_parse
+  Tests d_filter_chain_parse.
+  Tests the following:
+  - a chain with enough capacity is filled in place
+  - both separators, whitespace, "(empty)", and at(I) are accepted
+  - errors report the offset of the offending text
+  - a failed parse leaves the chain as it was
+  - operation from_string rejects more than one operation
+*/
+bool
+d_tests_sa_filter_parse
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                        result;
+    struct d_filter_chain*      chain;
+    struct d_filter_operation*  operations;
+    struct d_filter_operation*  op;
+    struct d_filter_parse_error error;
+    char*                       str;
+    bool                        ok;
+
+    result = true;
+    chain  = d_filter_chain_new_with_capacity(8);
+
+    if (!chain)
+    {
+        return d_assert_standalone(false,
+                                   "parse_chain_new",
+                                   "the chain should be created",
+                                   _counter);
+    }
+
+    // test 1: in place
+    operations = chain->operations;
+    ok         = d_filter_chain_parse(chain,
+                                      " skip_first(1)|take_nth( 2 ) ->\t"
+                                      "where(ge_i32, 0) -> at(3) ",
+                                      &error);
+
+    result = d_assert_standalone(
+        (ok) && (error.message == NULL) &&
+        (chain->count == 4) && (chain->operations == operations) &&
+        (chain->operations[1].params.step == 2) &&
+        (chain->operations[3].params.start == 3),
+        "parse_in_place",
+        "a chain with capacity should be filled in place",
+        _counter) && result;
+
+    str = d_filter_chain_to_string(chain);
+
+    result = d_assert_standalone(
+        (str != NULL) &&
+        (strcmp(str, "skip_first(1) -> take_nth(2) -> where(ge_i32, 0)"
+                     " -> at(3)") == 0),
+        "parse_to_string",
+        "the parsed chain should print in its written form",
+        _counter) && result;
+
+    d_functional_free(str);
+
+    // test 2: error positions (the chain keeps its 4 operations)
+    ok = d_filter_chain_parse(chain, "take_first(3) | bogus(1)", &error);
+
+    result = d_assert_standalone(
+        (!ok) && (error.position == 16) && (error.message != NULL) &&
+        (chain->count == 4),
+        "parse_error_unknown",
+        "an unknown operation should be reported at its name",
+        _counter) && result;
+
+    ok = d_filter_chain_parse(chain, "take_first(x)", &error);
+
+    result = d_assert_standalone(
+        (!ok) && (error.position == 11),
+        "parse_error_count",
+        "a malformed count should be reported at its start",
+        _counter) && result;
+
+    ok = d_filter_chain_parse(chain, "range(1 2)", &error);
+
+    result = d_assert_standalone(
+        (!ok) && (error.position == 8),
+        "parse_error_separator",
+        "a missing ',' should be reported where it was expected",
+        _counter) && result;
+
+    ok = d_filter_chain_parse(chain, "where(nope_i32, 1)", &error);
+
+    result = d_assert_standalone(
+        (!ok) && (error.position == 6),
+        "parse_error_unregistered",
+        "an unregistered predicate should be reported at its name",
+        _counter) && result;
+
+    ok = d_filter_chain_parse(chain, "head tail", &error);
+
+    result = d_assert_standalone(
+        (!ok) && (error.position == 5),
+        "parse_error_junk",
+        "text between operations should be reported",
+        _counter) && result;
+
+    ok = d_filter_chain_parse(chain, "head ->", &error);
+
+    result = d_assert_standalone(
+        (!ok) && (error.position == 7) && (chain->count == 4),
+        "parse_error_trailing",
+        "a trailing separator should be reported at the end",
+        _counter) && result;
+
+    // test 3: rollback, including the sorted hint and index lists
+    ok = d_filter_chain_parse(chain,
+                              "sorted(asc_i32) | at_indices(1, 2) | oops",
+                              &error);
+
+    result = d_assert_standalone(
+        (!ok) && (error.position == 37) &&
+        (chain->count == 4) && (chain->sorted_by == NULL),
+        "parse_rollback",
+        "a failed parse should leave the chain unchanged",
+        _counter) && result;
+
+    // test 4: empty forms and NULL
+    result = d_assert_standalone(
+        (d_filter_chain_parse(chain, "(empty)", NULL))      &&
+        (d_filter_chain_parse(chain, "  ", NULL))           &&
+        (!d_filter_chain_parse(NULL, "head", &error))       &&
+        (error.message != NULL)                             &&
+        (!d_filter_chain_parse(chain, NULL, NULL))          &&
+        (chain->count == 4),
+        "parse_empty",
+        "empty texts should add nothing and NULLs should fail",
+        _counter) && result;
+
+    d_filter_chain_free(chain);
+
+    // test 5: one operation only
+    op = d_filter_operation_from_string("head | tail");
+
+    result = d_assert_standalone(
+        (op == NULL),
+        "parse_operation_single",
+        "operation from_string should reject two operations",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_filter_parse_in
+  Tests d_filter_chain_parse_in.
+  Tests the following:
+  - a chain and its index lists are built in the arena and run correctly
+  - more than D_FILTER_MAX_CHAIN_LENGTH operations are rejected
+  - NULL parameters and malformed text give NULL
+*/
+bool
+d_tests_sa_filter_parse_in
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                        result;
+    struct d_fn_arena*          arena;
+    struct d_filter_chain*      chain;
+    struct d_filter_result*     res;
+    struct d_filter_parse_error error;
+    char                        text[(D_FILTER_MAX_CHAIN_LENGTH + 1) * 5];
+    int32_t                     data[6] = { 5, 1, 4, 1, 3, 9 };
+    const int32_t*              out;
+    size_t                      allocations;
+    size_t                      i;
+
+    result = true;
+    arena  = d_fn_arena_new(0);
+
+    if (!arena)
+    {
+        return d_assert_standalone(false,
+                                   "parse_in_arena",
+                                   "the arena should be created",
+                                   _counter);
+    }
+
+    // test 1: built in the arena
+    chain       = d_filter_chain_parse_in(arena,
+                                          "where(odd_i32)|at_indices(0, 2)",
+                                          &error);
+    allocations = arena->allocations;
+    res         = (chain) ? d_filter_apply_chain(chain, data, 6,
+                                                 sizeof(int32_t))
+                          : NULL;
+    out         = (res) ? (const int32_t*)res->elements : NULL;
+
+    result = d_assert_standalone(
+        (chain != NULL) && (chain->count == 2) &&
+        (allocations == 3) &&
+        (out != NULL) && (res->count == 2) &&
+        (out[0] == 5) && (out[1] == 1),
+        "parse_in_chain",
+        "an arena chain should parse and run",
+        _counter) && result;
+
+    d_filter_result_free(res);
+
+    // test 2: too many operations
+    text[0] = '\0';
+
+    for (i = 0; i <= D_FILTER_MAX_CHAIN_LENGTH; i++)
+    {
+        strcat(text, (i == 0) ? "head" : "|head");
+    }
+
+    chain = d_filter_chain_parse_in(arena, text, &error);
+
+    result = d_assert_standalone(
+        (chain == NULL) && (error.message != NULL) &&
+        (error.position == (D_FILTER_MAX_CHAIN_LENGTH * 5)),
+        "parse_in_too_long",
+        "a chain longer than the maximum should be rejected",
+        _counter) && result;
+
+    // test 3: failures
+    result = d_assert_standalone(
+        (d_filter_chain_parse_in(NULL, "head", &error) == NULL)  &&
+        (d_filter_chain_parse_in(arena, NULL, NULL) == NULL)     &&
+        (d_filter_chain_parse_in(arena, "head(", &error) == NULL) &&
+        (error.position == 4),
+        "parse_in_failures",
+        "NULL parameters and malformed text should give NULL",
+        _counter) && result;
+
+    d_fn_arena_free(arena);
+
+    return result;
+}
+
+/*
+d_tests_sa_filter_parse_release
+  Tests that chains give back the registry contexts they are built with.
+  Tests the following:
+  - a parsed chain holds its contexts until it is freed
+  - parsing, copying, decoding, and freeing chains in a loop does not grow
+    the global registry
+  - arena and buffer chains give theirs back with d_filter_chain_release
+*/
+bool
+d_tests_sa_filter_parse_release
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                         result;
+    struct d_predicate_registry* registry;
+    struct d_fn_arena*           arena;
+    struct d_filter_chain*       chain;
+    struct d_filter_chain*       clone;
+    struct d_filter_chain*       optimized;
+    struct d_filter_chain*       decoded;
+    size_t                       block[64];
+    unsigned char                bytes[128];
+    char                         text[96];
+    size_t                       instances;
+    size_t                       held;
+    size_t                       size;
+    int                          i;
+    bool                         ok;
+
+    result   = true;
+    registry = d_predicate_registry_global();
+    arena    = d_fn_arena_new(0);
+
+    if ( (!registry) ||
+         (!arena) )
+    {
+        d_fn_arena_free(arena);
+
+        return d_assert_standalone(false,
+                                   "parse_release_setup",
+                                   "the registry and arena should exist",
+                                   _counter);
+    }
+
+    instances = registry->instance_count;
+
+    // test 1: held until freed
+    chain = d_filter_chain_from_string("where(gt_i32, 987654) -> "
+                                       "where(between_i64, -3, 3)");
+    held  = registry->instance_count;
+    d_filter_chain_free(chain);
+
+    result = d_assert_standalone(
+        (chain != NULL) &&
+        (held == instances + 2) &&
+        (registry->instance_count == instances),
+        "parse_release_free",
+        "a freed chain should give its contexts back",
+        _counter) && result;
+
+    // test 2: many distinct chains, copied and decoded
+    ok = true;
+
+    for (i = 0; (ok) && (i < 500); i++)
+    {
+        snprintf(text, sizeof(text),
+                 "where(gt_i32, %d) | take_first(4) | take_first(2) | "
+                 "where(between_f64, 0.5, %d)",
+                 i, i + 1);
+
+        chain     = d_filter_chain_from_string(text);
+        clone     = d_filter_chain_clone(chain);
+        optimized = d_filter_chain_optimize(chain);
+        size      = (chain) ? d_filter_chain_encode(chain,
+                                                    bytes,
+                                                    sizeof(bytes))
+                            : 0;
+        decoded   = d_filter_chain_decode(bytes, size, NULL);
+        ok        = (chain != NULL) && (chain->count == 4) &&
+                    (clone != NULL) && (optimized != NULL) &&
+                    (decoded != NULL);
+
+        d_filter_chain_free(chain);
+        d_filter_chain_free(clone);
+        d_filter_chain_free(decoded);
+
+        // the last holder keeps the contexts alive
+        ok = ok && (registry->instance_count == instances + 2);
+
+        d_filter_chain_free(optimized);
+    }
+
+    result = d_assert_standalone(
+        (ok) && (registry->instance_count == instances),
+        "parse_release_loop",
+        "parsing and freeing chains should not grow the registry",
+        _counter) && result;
+
+    // test 3: arena and buffer chains
+    chain = d_filter_chain_parse_in(arena, "where(lt_i64, 424242)", NULL);
+    held  = registry->instance_count;
+    d_filter_chain_release(chain);
+    ok    = (chain != NULL) && (held == instances + 1) &&
+            (registry->instance_count == instances);
+
+    chain   = d_filter_chain_from_string("where(ne_i32, 515151)");
+    size    = (chain) ? d_filter_chain_encode(chain, bytes, sizeof(bytes))
+                      : 0;
+    d_filter_chain_free(chain);
+    decoded = d_filter_chain_decode_into(block, sizeof(block),
+                                         bytes, size, NULL);
+    held    = registry->instance_count;
+    d_filter_chain_release(decoded);
+    ok      = (ok) && (decoded != NULL) && (held == instances + 1) &&
+              (registry->instance_count == instances);
+
+    result = d_assert_standalone(
+        ok,
+        "parse_release_borrowed",
+        "arena and buffer chains should give their contexts back",
+        _counter) && result;
+
+    d_fn_arena_free(arena);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_filter_encode
+  Tests d_filter_chain_encode.
+  Tests the following:
+  - sizing with a NULL buffer, and the header and size of a small chain
+  - a chain with every parameter kind round-trips through decode, with the
+    same registered contexts, and runs the same
+  - a short buffer is not overrun and still gives the full size
+  - unregistered predicates and NULL chains give 0
+*/
+bool
+d_tests_sa_filter_encode
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                        result;
+    struct d_filter_chain*      chain1;
+    struct d_filter_chain*      chain2;
+    struct d_filter_operation*  op;
+    struct d_filter_parse_error error;
+    struct d_filter_result*     res1;
+    struct d_filter_result*     res2;
+    unsigned char               bytes[256];
+    char*                       text1;
+    char*                       text2;
+    int32_t                     data[12] = { 7, -3, 12, 5, 0, 9,
+                                             4, 11, -8, 6, 2, 10 };
+    size_t                      size;
+    size_t                      i;
+    bool                        same;
+
+    result = true;
+
+    // test 1: a small chain
+    chain1 = d_filter_chain_from_string("take_first(5)");
+    size   = (chain1) ? d_filter_chain_encode(chain1, NULL, 0) : 0;
+
+    result = d_assert_standalone(
+        (size == 8) &&
+        (d_filter_chain_encode(chain1, bytes, sizeof(bytes)) == 8) &&
+        (memcmp(bytes, "DFC", 3) == 0) &&
+        (bytes[3] == D_FILTER_ENCODING_VERSION) &&
+        (bytes[6] == D_FILTER_OP_TAKE_FIRST) && (bytes[7] == 5),
+        "encode_small",
+        "take_first(5) should encode to an 8-byte header and operation",
+        _counter) && result;
+
+    d_filter_chain_free(chain1);
+
+    // test 2: every parameter kind
+    chain1 = d_filter_chain_from_string(
+                 "sorted(asc_i32) -> skip_first(300) -> take_nth(2) -> "
+                 "where_rising(gt_i32, -5) -> where_not(between_f64, 0.5, 2)"
+                 " -> range(0, 1000) -> slice(1, 11, 1) -> "
+                 "distinct(asc_i32) -> at_indices(0, 2, 200) -> at(1) -> "
+                 "head -> init -> top_k(3, desc_i64) -> reverse");
+    size   = (chain1) ? d_filter_chain_encode(chain1, bytes, sizeof(bytes))
+                      : 0;
+    chain2 = ( (size > 0) && (size <= sizeof(bytes)) )
+        ? d_filter_chain_decode(bytes, size, &error)
+        : NULL;
+    text1  = (chain1) ? d_filter_chain_to_string(chain1) : NULL;
+    text2  = (chain2) ? d_filter_chain_to_string(chain2) : NULL;
+    same   = (chain2 != NULL) && (chain1->count == chain2->count) &&
+             (chain1->sorted_by == chain2->sorted_by);
+
+    for (i = 0; (same) && (i < chain1->count); i++)
+    {
+        same = (chain1->operations[i].type ==
+                chain2->operations[i].type)                              &&
+               (chain1->operations[i].params.test ==
+                chain2->operations[i].params.test)                       &&
+               (chain1->operations[i].params.context ==
+                chain2->operations[i].params.context);
+    }
+
+    result = d_assert_standalone(
+        (chain1 != NULL) && (chain1->count == 13) &&
+        (same) && (text1 != NULL) && (text2 != NULL) &&
+        (strcmp(text1, text2) == 0),
+        "encode_round_trip",
+        "a chain should decode to the same operations and contexts",
+        _counter) && result;
+
+    d_functional_free(text1);
+    d_functional_free(text2);
+    d_filter_chain_free(chain2);
+    d_filter_chain_free(chain1);
+
+    // test 3: the decoded chain runs the same
+    chain1 = d_filter_chain_from_string(
+                 "where(odd_i32) -> at_indices(3, 0, 1) -> reverse");
+    size   = (chain1) ? d_filter_chain_encode(chain1, bytes, sizeof(bytes))
+                      : 0;
+    chain2 = (size > 0) ? d_filter_chain_decode(bytes, size, NULL) : NULL;
+    res1   = (chain1) ? d_filter_apply_chain(chain1, data, 12,
+                                             sizeof(int32_t))
+                      : NULL;
+    res2   = (chain2) ? d_filter_apply_chain(chain2, data, 12,
+                                             sizeof(int32_t))
+                      : NULL;
+
+    result = d_assert_standalone(
+        (res1 != NULL) && (res2 != NULL) && (res1->count == 3) &&
+        (res1->count == res2->count) &&
+        (memcmp(res1->elements, res2->elements,
+                res1->count * sizeof(int32_t)) == 0),
+        "encode_apply",
+        "a decoded chain should give the same results",
+        _counter) && result;
+
+    d_filter_result_free(res1);
+    d_filter_result_free(res2);
+    d_filter_chain_free(chain2);
+
+    // test 4: a short buffer
+    memset(bytes, 0xEE, sizeof(bytes));
+
+    result = d_assert_standalone(
+        (chain1 != NULL) &&
+        (d_filter_chain_encode(chain1, bytes, 4) == size) &&
+        (bytes[3] == D_FILTER_ENCODING_VERSION) && (bytes[4] == 0xEE),
+        "encode_short_buffer",
+        "a short buffer should not be overrun",
+        _counter) && result;
+
+    d_filter_chain_free(chain1);
+
+    // test 5: unregistered predicate and NULL
+    chain1 = d_filter_chain_new();
+    op     = d_filter_where(pred_is_positive);
+
+    if ( (chain1) && (op) )
+    {
+        d_filter_chain_add(chain1, op);
+    }
+
+    d_functional_free(op);
+
+    result = d_assert_standalone(
+        (chain1 != NULL) &&
+        (d_filter_chain_encode(chain1, bytes, sizeof(bytes)) == 0) &&
+        (d_filter_chain_encode(NULL, bytes, sizeof(bytes)) == 0),
+        "encode_unregistered",
+        "an unregistered predicate or NULL chain should give 0",
+        _counter) && result;
+
+    d_filter_chain_free(chain1);
+
+    return result;
+}
+
+
+// filter_decode_fails
+//   helper: true if decoding _data fails at _position.
+static bool
+filter_decode_fails
+(
+    const unsigned char* _data,
+    size_t               _size,
+    size_t               _position
+)
+{
+    struct d_filter_parse_error error;
+    struct d_filter_chain*      chain;
+
+    chain = d_filter_chain_decode(_data, _size, &error);
+
+    if (chain)
+    {
+        d_filter_chain_free(chain);
+
+        return false;
+    }
+
+    return (error.message != NULL) && (error.position == _position) &&
+           (d_filter_chain_decoded_size(_data, _size, NULL) == 0);
+}
+
+/*
+d_tests_sa_filter_decode
+  Tests d_filter_chain_decode_into and the decoders' validation.
+  Tests the following:
+  - decoding into a caller buffer of d_filter_chain_decoded_size bytes
+    keeps the chain and its index lists in that buffer
+  - a short buffer is rejected
+  - a decoded chain cannot grow
+  - bad magic, version, and flags, truncation, unknown operations,
+    varint overflow, bad shapes, unknown registry ids, counts beyond the
+    input, and trailing bytes are rejected at their byte offset
+*/
+bool
+d_tests_sa_filter_decode
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                        result;
+    struct d_filter_chain*      source;
+    struct d_filter_chain*      chain;
+    struct d_filter_operation*  op;
+    struct d_filter_parse_error error;
+    struct d_filter_result*     res;
+    size_t                      block[64];
+    unsigned char               bytes[64];
+    const unsigned char*        start;
+    const unsigned char*        end;
+    const int32_t*              out;
+    int32_t                     data[4] = { 10, 20, 30, 40 };
+    size_t                      size;
+    size_t                      needed;
+
+    result = true;
+
+    // test 1: into a caller buffer
+    source = d_filter_chain_from_string("at_indices(3, 1) -> reverse");
+    size   = (source) ? d_filter_chain_encode(source, bytes, sizeof(bytes))
+                      : 0;
+    needed = d_filter_chain_decoded_size(bytes, size, &error);
+    chain  = d_filter_chain_decode_into(block, sizeof(block),
+                                        bytes, size, &error);
+    start  = (const unsigned char*)block;
+    end    = start + needed;
+    res    = (chain) ? d_filter_apply_chain(chain, data, 4, sizeof(int32_t))
+                     : NULL;
+    out    = (res) ? (const int32_t*)res->elements : NULL;
+
+    result = d_assert_standalone(
+        (needed > 0) && (needed <= sizeof(block)) &&
+        (chain == (struct d_filter_chain*)block) &&
+        (!chain->owns_operations) &&
+        ((const unsigned char*)chain->operations[0].params.indices > start) &&
+        ((const unsigned char*)chain->operations[0].params.indices < end) &&
+        (out != NULL) && (res->count == 2) &&
+        (out[0] == 20) && (out[1] == 40),
+        "decode_into_buffer",
+        "a chain should decode into and run from a caller buffer",
+        _counter) && result;
+
+    d_filter_result_free(res);
+
+    // test 2: a short buffer, and no growth
+    op = d_filter_head();
+
+    result = d_assert_standalone(
+        (d_filter_chain_decode_into(block, needed - 1,
+                                    bytes, size, &error) == NULL) &&
+        (error.message != NULL) &&
+        (chain != NULL) && (op != NULL) &&
+        (!d_filter_chain_add(chain, op)),
+        "decode_into_limits",
+        "a short buffer should be rejected and a decoded chain not grow",
+        _counter) && result;
+
+    d_functional_free(op);
+    d_filter_chain_free(source);
+
+    // test 3: header errors ("take_first(5)" is D F C 1 0 1 1 5)
+    memcpy(bytes, "DFC\x01\x00\x01\x01\x05", 8);
+
+    result = d_assert_standalone(
+        (!filter_decode_fails(bytes, 8, 0)) &&
+        (filter_decode_fails((const unsigned char*)"DFX\x01\x00\x00",
+                             6, 0)) &&
+        (filter_decode_fails((const unsigned char*)"DFC\x02\x00\x00",
+                             6, 3)) &&
+        (filter_decode_fails((const unsigned char*)"DFC\x01\x80\x00",
+                             6, 4)) &&
+        (filter_decode_fails(bytes, 7, 7)) &&
+        (filter_decode_fails(bytes, 2, 2)),
+        "decode_header",
+        "bad magic, version, flags, and truncation should be located",
+        _counter) && result;
+
+    // test 4: body errors
+    result = d_assert_standalone(
+        (filter_decode_fails((const unsigned char*)"DFC\x01\x00\x01\x40",
+                             7, 6)) &&
+        (filter_decode_fails((const unsigned char*)
+                             "DFC\x01\x00\xFF\xFF\xFF\xFF\xFF\xFF\xFF"
+                             "\xFF\xFF\x02", 15, 5)) &&
+        (filter_decode_fails((const unsigned char*)"DFC\x01\x00\x20\x0B",
+                             7, 5)) &&
+        (filter_decode_fails((const unsigned char*)
+                             "DFC\x01\x00\x01\x07\x03\x00\x00", 10, 7)) &&
+        (filter_decode_fails((const unsigned char*)
+                             "DFC\x01\x00\x01\x07\x00\xFF\x7F\x00",
+                             11, 8)) &&
+        (filter_decode_fails((const unsigned char*)
+                             "DFC\x01\x00\x01\x09\x09\x01", 9, 7)),
+        "decode_body",
+        "unknown types, overflow, bad shapes and ids should be located",
+        _counter) && result;
+
+    // test 5: trailing bytes and NULL
+    bytes[8] = 0;
+
+    result = d_assert_standalone(
+        (filter_decode_fails(bytes, 9, 8)) &&
+        (d_filter_chain_decode(NULL, 8, &error) == NULL) &&
+        (error.message != NULL) &&
+        (d_filter_chain_decode_into(NULL, 64, bytes, 8, NULL) == NULL),
+        "decode_trailing",
+        "trailing bytes and NULL parameters should be rejected",
+        _counter) && result;
+
+    return result;
+}
+
+
 /*
 d_tests_sa_filter_optimize
   Tests d_filter_chain_optimize for chain optimization.
@@ -748,9 +1672,9 @@ d_tests_sa_filter_optimize
         }
 
         d_filter_result_free(res_orig);
-        free(res_orig);
+        d_functional_free(res_orig);
         d_filter_result_free(res_opt);
-        free(res_opt);
+        d_functional_free(res_opt);
 
         // verify original chain not modified
         result = d_assert_standalone(
@@ -795,9 +1719,9 @@ d_tests_sa_filter_optimize
                 _counter) && result;
 
             d_filter_result_free(res_orig);
-        free(res_orig);
+        d_functional_free(res_orig);
             d_filter_result_free(res_opt);
-        free(res_opt);
+        d_functional_free(res_opt);
             d_filter_chain_free(optimized);
         }
 
@@ -1076,6 +2000,13 @@ d_tests_sa_filter_utility_all
     result = d_tests_sa_filter_validation(_counter)  && result;
     result = d_tests_sa_filter_to_string(_counter)   && result;
     result = d_tests_sa_filter_from_string(_counter)  && result;
+    result = d_tests_sa_filter_round_trip(_counter)   && result;
+    result = d_tests_sa_filter_canonical(_counter)    && result;
+    result = d_tests_sa_filter_parse(_counter)        && result;
+    result = d_tests_sa_filter_parse_in(_counter)     && result;
+    result = d_tests_sa_filter_parse_release(_counter) && result;
+    result = d_tests_sa_filter_encode(_counter)       && result;
+    result = d_tests_sa_filter_decode(_counter)       && result;
     result = d_tests_sa_filter_optimize(_counter)    && result;
     result = d_tests_sa_filter_estimate(_counter)    && result;
 
@@ -0,0 +1,26 @@
+#include ".\fn_arena_tests_sa.h"
+
+
+/*
+d_tests_sa_fn_arena_run_all
+  Module-level aggregation function that runs all fn_arena tests.
+  Executes tests for all categories:
+  - Arena creation, allocation, reset, and release
+  - Arena-backed predicate and compose constructors
+*/
+bool
+d_tests_sa_fn_arena_run_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    // run all test categories
+    result = d_tests_sa_fn_arena_alloc_all(_counter)       && result;
+    result = d_tests_sa_fn_arena_constructor_all(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,57 @@
+/******************************************************************************
+* djinterp [test]                                           fn_arena_tests_sa.h
+*
+*   Unit test declarations for `fn_arena.h` module.
+*   Provides testing of the bump-pointer arena (creation, aligned allocation,
+* chunk growth, oversized requests, reset, and release) and of the
+* arena-backed `_new_in` constructors of the predicate and compose modules.
+*
+*
+* path:      \tests\functional\fn_arena_tests_sa.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_TESTS_FN_ARENA_SA_
+#define DJINTERP_TESTS_FN_ARENA_SA_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "..\..\inc\djinterp.h"
+#include "..\..\inc\test\test_standalone.h"
+#include "..\..\inc\functional\fn_arena.h"
+#include "..\..\inc\functional\predicate.h"
+#include "..\..\inc\functional\compose.h"
+
+
+/******************************************************************************
+ * I. ARENA TESTS
+ *****************************************************************************/
+bool d_tests_sa_fn_arena_new(struct d_test_counter* _counter);
+bool d_tests_sa_fn_arena_alloc(struct d_test_counter* _counter);
+bool d_tests_sa_fn_arena_reset(struct d_test_counter* _counter);
+bool d_tests_sa_fn_arena_free(struct d_test_counter* _counter);
+
+// I.   aggregation function
+bool d_tests_sa_fn_arena_alloc_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * II. ARENA-BACKED CONSTRUCTOR TESTS
+ *****************************************************************************/
+bool d_tests_sa_fn_arena_predicate_new_in(struct d_test_counter* _counter);
+bool d_tests_sa_fn_arena_compose_new_in(struct d_test_counter* _counter);
+bool d_tests_sa_fn_arena_partial_consumer_new_in(struct d_test_counter* _counter);
+
+// II.  aggregation function
+bool d_tests_sa_fn_arena_constructor_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * MODULE-LEVEL AGGREGATION
+ *****************************************************************************/
+bool d_tests_sa_fn_arena_run_all(struct d_test_counter* _counter);
+
+
+#endif  // DJINTERP_TESTS_FN_ARENA_SA_
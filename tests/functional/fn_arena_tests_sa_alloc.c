@@ -0,0 +1,316 @@
+#include ".\fn_arena_tests_sa.h"
+
+
+/*
+d_tests_sa_fn_arena_new
+  Tests the d_fn_arena_new function.
+  Tests the following:
+  - chunk size 0 selects the default
+  - explicit chunk size is recorded
+  - new arena starts with one empty chunk
+*/
+bool
+d_tests_sa_fn_arena_new
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    struct d_fn_arena* arena;
+
+    result = true;
+
+    // test 1: default chunk size
+    arena = d_fn_arena_new(0);
+
+    result = d_assert_standalone(
+        (arena != NULL)                                      &&
+        (arena->chunk_size == D_FN_ARENA_DEFAULT_CHUNK_SIZE) &&
+        (arena->head != NULL)                                &&
+        (arena->head->next == NULL)                          &&
+        (arena->head->used == 0)                             &&
+        (arena->allocations == 0),
+        "fn_arena_new_default",
+        "chunk size 0 should select the default",
+        _counter) && result;
+
+    d_fn_arena_free(arena);
+
+    // test 2: explicit chunk size
+    arena = d_fn_arena_new(256);
+
+    result = d_assert_standalone(
+        (arena != NULL)            &&
+        (arena->chunk_size == 256) &&
+        (arena->head->capacity == 256),
+        "fn_arena_new_explicit",
+        "explicit chunk size should be recorded",
+        _counter) && result;
+
+    d_fn_arena_free(arena);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_fn_arena_alloc
+  Tests the d_fn_arena_alloc function.
+  Tests the following:
+  - NULL arena / zero size rejection
+  - allocations are aligned and do not overlap
+  - consecutive small allocations are adjacent (same chunk)
+  - a full chunk is followed by a new head chunk
+  - oversized requests get a dedicated chunk behind the head
+  - allocation counters
+*/
+bool
+d_tests_sa_fn_arena_alloc
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                     result;
+    struct d_fn_arena*       arena;
+    struct d_fn_arena_chunk* head;
+    unsigned char*           a;
+    unsigned char*           b;
+    unsigned char*           big;
+    size_t                   i;
+    bool                     ok;
+
+    result = true;
+    arena  = d_fn_arena_new(128);
+
+    // test 1: parameter rejection
+    result = d_assert_standalone(
+        (d_fn_arena_alloc(NULL, 8) == NULL) &&
+        (d_fn_arena_alloc(arena, 0) == NULL),
+        "fn_arena_alloc_rejection",
+        "NULL arena or zero size should return NULL",
+        _counter) && result;
+
+    if (!arena)
+    {
+        return result;
+    }
+
+    // test 2: alignment and adjacency
+    a = d_fn_arena_alloc(arena, 3);
+    b = d_fn_arena_alloc(arena, 20);
+
+    result = d_assert_standalone(
+        (a != NULL)                                          &&
+        (b != NULL)                                          &&
+        (((uintptr_t)a % D_FN_ARENA_ALIGNMENT) == 0)         &&
+        (((uintptr_t)b % D_FN_ARENA_ALIGNMENT) == 0)         &&
+        (b == a + D_FN_ARENA_ALIGNMENT),
+        "fn_arena_alloc_aligned_adjacent",
+        "small allocations should be aligned and adjacent",
+        _counter) && result;
+
+    // test 3: memory is writable without overlap
+    if ( (a) &&
+         (b) )
+    {
+        memset(a, 0xAA, 3);
+        memset(b, 0x55, 20);
+    }
+
+    result = d_assert_standalone(
+        (a) && (b) && (a[2] == 0xAA) && (b[0] == 0x55) && (b[19] == 0x55),
+        "fn_arena_alloc_no_overlap",
+        "allocations should not overlap",
+        _counter) && result;
+
+    // test 4: filling the chunk starts a new head chunk
+    head = arena->head;
+    ok   = true;
+
+    for (i = 0; i < 8; i++)
+    {
+        ok = (d_fn_arena_alloc(arena, 16) != NULL) && ok;
+    }
+
+    result = d_assert_standalone(
+        ok                          &&
+        (arena->head != head)       &&
+        (arena->head->next == head),
+        "fn_arena_alloc_new_chunk",
+        "a full chunk should be replaced by a new head chunk",
+        _counter) && result;
+
+    // test 5: oversized request
+    head = arena->head;
+    big  = d_fn_arena_alloc(arena, 1000);
+
+    result = d_assert_standalone(
+        (big != NULL)                          &&
+        (arena->head == head)                  &&
+        (arena->head->next != NULL)            &&
+        (arena->head->next->capacity >= 1000),
+        "fn_arena_alloc_oversized",
+        "oversized requests should get a dedicated chunk behind the head",
+        _counter) && result;
+
+    // test 6: counters
+    result = d_assert_standalone(
+        (arena->allocations == 11) &&
+        (arena->bytes_allocated == 3 + 20 + (8 * 16) + 1000),
+        "fn_arena_alloc_counters",
+        "allocation counters should track requests",
+        _counter) && result;
+
+    d_fn_arena_free(arena);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_fn_arena_reset
+  Tests the d_fn_arena_reset function.
+  Tests the following:
+  - NULL arena is a no-op
+  - all chunks but the head are released and counters reset
+  - memory is reused from the start of the head chunk
+*/
+bool
+d_tests_sa_fn_arena_reset
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    struct d_fn_arena* arena;
+    void*              first;
+    void*              again;
+    size_t             i;
+
+    result = true;
+
+    // test 1: NULL
+    d_fn_arena_reset(NULL);
+
+    result = d_assert_standalone(
+        true,
+        "fn_arena_reset_null",
+        "resetting NULL should not crash",
+        _counter) && result;
+
+    arena = d_fn_arena_new(64);
+
+    if (!arena)
+    {
+        return result;
+    }
+
+    for (i = 0; i < 20; i++)
+    {
+        d_fn_arena_alloc(arena, 16);
+    }
+
+    d_fn_arena_alloc(arena, 500);
+    d_fn_arena_reset(arena);
+
+    // test 2: released
+    result = d_assert_standalone(
+        (arena->head->next == NULL) &&
+        (arena->head->used == 0)    &&
+        (arena->allocations == 0)   &&
+        (arena->bytes_allocated == 0),
+        "fn_arena_reset_released",
+        "reset should keep only an empty head chunk",
+        _counter) && result;
+
+    // test 3: reuse
+    first = d_fn_arena_alloc(arena, 8);
+    d_fn_arena_reset(arena);
+    again = d_fn_arena_alloc(arena, 8);
+
+    result = d_assert_standalone(
+        (first != NULL) &&
+        (first == again),
+        "fn_arena_reset_reuse",
+        "memory should be reused after reset",
+        _counter) && result;
+
+    d_fn_arena_free(arena);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_fn_arena_free
+  Tests the d_fn_arena_free function.
+  Tests the following:
+  - NULL arena is a no-op
+  - an arena with several chunks frees without error
+*/
+bool
+d_tests_sa_fn_arena_free
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    struct d_fn_arena* arena;
+    size_t             i;
+
+    result = true;
+
+    // test 1: NULL
+    d_fn_arena_free(NULL);
+
+    result = d_assert_standalone(
+        true,
+        "fn_arena_free_null",
+        "freeing NULL should not crash",
+        _counter) && result;
+
+    // test 2: several chunks
+    arena = d_fn_arena_new(32);
+
+    for (i = 0; i < 10; i++)
+    {
+        d_fn_arena_alloc(arena, 24);
+    }
+
+    d_fn_arena_alloc(arena, 4096);
+    d_fn_arena_free(arena);
+
+    result = d_assert_standalone(
+        true,
+        "fn_arena_free_chunks",
+        "an arena with several chunks should free without error",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_fn_arena_alloc_all
+  Aggregation function that runs all arena tests.
+*/
+bool
+d_tests_sa_fn_arena_alloc_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Arena Allocation\n");
+    printf("  --------------------------\n");
+
+    result = d_tests_sa_fn_arena_new(_counter) && result;
+    result = d_tests_sa_fn_arena_alloc(_counter) && result;
+    result = d_tests_sa_fn_arena_reset(_counter) && result;
+    result = d_tests_sa_fn_arena_free(_counter) && result;
+
+    return result;
+}
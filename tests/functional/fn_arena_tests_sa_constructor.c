@@ -0,0 +1,308 @@
+#include ".\fn_arena_tests_sa.h"
+
+
+// arena_consumer_add
+//   helper: consumer adding the int bound as context to the int element.
+static void
+arena_consumer_add
+(
+    void* _element,
+    void* _context
+)
+{
+    *(int*)_element += *(int*)_context;
+
+    return;
+}
+
+// arena_transform_increment
+//   helper: transformer writing input + 1 for ints.
+static bool
+arena_transform_increment
+(
+    const void* _input,
+    void*       _output,
+    void*       _context
+)
+{
+    (void)_context;
+
+    *(int*)_output = *(const int*)_input + 1;
+
+    return true;
+}
+
+
+/*
+d_tests_sa_fn_arena_predicate_new_in
+  Tests the d_predicate_*_new_in arena constructors.
+  Tests the following:
+  - NULL arena rejection
+  - fields match the heap constructors
+  - combinators evaluate like heap combinators
+  - a combinator graph occupies adjacent arena memory
+*/
+bool
+d_tests_sa_fn_arena_predicate_new_in
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                    result;
+    struct d_fn_arena*      arena;
+    struct d_predicate_and* and_combo;
+    struct d_predicate_or*  or_combo;
+    struct d_predicate_xor* xor_combo;
+    struct d_predicate_not* not_combo;
+    int                     ctx;
+    int                     value;
+
+    result = true;
+    ctx    = 1;
+    value  = 0;
+
+    // test 1: NULL arena
+    result = d_assert_standalone(
+        (d_predicate_and_new_in(NULL, d_functional_constant_true, NULL,
+                                d_functional_constant_true, NULL) == NULL) &&
+        (d_predicate_or_new_in(NULL, d_functional_constant_true, NULL,
+                               d_functional_constant_true, NULL) == NULL)  &&
+        (d_predicate_xor_new_in(NULL, d_functional_constant_true, NULL,
+                                d_functional_constant_true, NULL) == NULL) &&
+        (d_predicate_not_new_in(NULL, d_functional_constant_true,
+                                NULL) == NULL),
+        "arena_predicate_new_in_null_arena",
+        "NULL arena should return NULL",
+        _counter) && result;
+
+    arena = d_fn_arena_new(0);
+
+    if (!arena)
+    {
+        return result;
+    }
+
+    and_combo = d_predicate_and_new_in(arena,
+                                       d_functional_constant_true,
+                                       &ctx,
+                                       d_functional_constant_false,
+                                       NULL);
+    or_combo  = d_predicate_or_new_in(arena,
+                                      d_functional_constant_true,
+                                      NULL,
+                                      d_functional_constant_false,
+                                      &ctx);
+    xor_combo = d_predicate_xor_new_in(arena,
+                                       d_functional_constant_true,
+                                       NULL,
+                                       d_functional_constant_false,
+                                       NULL);
+    not_combo = d_predicate_not_new_in(arena,
+                                       d_functional_constant_true,
+                                       &ctx);
+
+    // test 2: fields
+    result = d_assert_standalone(
+        (and_combo) && (or_combo) && (xor_combo) && (not_combo)      &&
+        (and_combo->predicate1 == d_functional_constant_true)        &&
+        (and_combo->predicate2 == d_functional_constant_false)       &&
+        (and_combo->context1 == &ctx)                                &&
+        (or_combo->context2 == &ctx)                                 &&
+        (xor_combo->context1 == NULL)                                &&
+        (not_combo->predicate == d_functional_constant_true)         &&
+        (not_combo->context == &ctx),
+        "arena_predicate_new_in_fields",
+        "arena combinators should hold the given predicates and contexts",
+        _counter) && result;
+
+    // test 3: evaluation
+    result = d_assert_standalone(
+        (and_combo) && (or_combo) && (xor_combo) && (not_combo) &&
+        (!d_predicate_and_eval(and_combo, &value))              &&
+        (d_predicate_or_eval(or_combo, &value))                 &&
+        (d_predicate_xor_eval(xor_combo, &value))               &&
+        (!d_predicate_not_eval(not_combo, &value)),
+        "arena_predicate_new_in_eval",
+        "arena combinators should evaluate like heap combinators",
+        _counter) && result;
+
+    // test 4: locality
+    result = d_assert_standalone(
+        (arena->allocations == 4)    &&
+        (arena->head->next == NULL)  &&
+        ((unsigned char*)or_combo -
+         (unsigned char*)and_combo ==
+             (ptrdiff_t)( (sizeof(struct d_predicate_and) +
+                           D_FN_ARENA_ALIGNMENT - 1) &
+                          ~(size_t)(D_FN_ARENA_ALIGNMENT - 1) )),
+        "arena_predicate_new_in_adjacent",
+        "a combinator graph should be packed into one chunk",
+        _counter) && result;
+
+    d_fn_arena_free(arena);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_fn_arena_compose_new_in
+  Tests the d_functional_compose_new_in arena constructor.
+  Tests the following:
+  - NULL arena / transformer and zero temp size rejection
+  - composed transformer applies f(g(x))
+  - temporary buffer is taken from the arena
+*/
+bool
+d_tests_sa_fn_arena_compose_new_in
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                           result;
+    struct d_fn_arena*             arena;
+    struct d_composed_transformer* composed;
+    int                            input;
+    int                            output;
+
+    result = true;
+    arena  = d_fn_arena_new(0);
+
+    // test 1: rejection
+    result = d_assert_standalone(
+        (d_functional_compose_new_in(NULL, arena_transform_increment, NULL,
+                                     arena_transform_increment, NULL,
+                                     sizeof(int)) == NULL)                  &&
+        (d_functional_compose_new_in(arena, NULL, NULL,
+                                     arena_transform_increment, NULL,
+                                     sizeof(int)) == NULL)                  &&
+        (d_functional_compose_new_in(arena, arena_transform_increment, NULL,
+                                     NULL, NULL, sizeof(int)) == NULL)      &&
+        (d_functional_compose_new_in(arena, arena_transform_increment, NULL,
+                                     arena_transform_increment, NULL,
+                                     0) == NULL),
+        "arena_compose_new_in_rejection",
+        "invalid parameters should return NULL",
+        _counter) && result;
+
+    if (!arena)
+    {
+        return result;
+    }
+
+    // test 2: application
+    composed = d_functional_compose_new_in(arena,
+                                           arena_transform_increment,
+                                           NULL,
+                                           arena_transform_increment,
+                                           NULL,
+                                           sizeof(int));
+    input    = 5;
+    output   = 0;
+
+    result = d_assert_standalone(
+        (composed != NULL)                                       &&
+        (d_functional_compose_apply(composed, &input, &output))  &&
+        (output == 7),
+        "arena_compose_new_in_apply",
+        "arena composed transformer should apply f(g(x))",
+        _counter) && result;
+
+    // test 3: temp buffer in the arena
+    result = d_assert_standalone(
+        (composed != NULL)          &&
+        (arena->allocations == 2)   &&
+        (composed->temp_size == sizeof(int)),
+        "arena_compose_new_in_temp_buffer",
+        "the temporary buffer should come from the arena",
+        _counter) && result;
+
+    d_fn_arena_free(arena);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_fn_arena_partial_consumer_new_in
+  Tests the d_functional_partial_consumer_new_in arena constructor.
+  Tests the following:
+  - NULL arena / consumer rejection
+  - partial consumer applies with the bound context
+*/
+bool
+d_tests_sa_fn_arena_partial_consumer_new_in
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                       result;
+    struct d_fn_arena*         arena;
+    struct d_partial_consumer* partial;
+    int                        amount;
+    int                        value;
+
+    result = true;
+    amount = 3;
+    value  = 10;
+    arena  = d_fn_arena_new(0);
+
+    // test 1: rejection
+    result = d_assert_standalone(
+        (d_functional_partial_consumer_new_in(NULL,
+                                              arena_consumer_add,
+                                              &amount) == NULL) &&
+        (d_functional_partial_consumer_new_in(arena,
+                                              NULL,
+                                              &amount) == NULL),
+        "arena_partial_consumer_new_in_rejection",
+        "NULL arena or consumer should return NULL",
+        _counter) && result;
+
+    // test 2: application
+    partial = d_functional_partial_consumer_new_in(arena,
+                                                   arena_consumer_add,
+                                                   &amount);
+
+    if (partial)
+    {
+        d_functional_partial_consumer_apply(partial, &value);
+    }
+
+    result = d_assert_standalone(
+        (partial != NULL)             &&
+        (partial->context == &amount) &&
+        (value == 13),
+        "arena_partial_consumer_new_in_apply",
+        "arena partial consumer should apply the bound context",
+        _counter) && result;
+
+    d_fn_arena_free(arena);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_fn_arena_constructor_all
+  Aggregation function that runs all arena-backed constructor tests.
+*/
+bool
+d_tests_sa_fn_arena_constructor_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Arena-Backed Constructors\n");
+    printf("  -----------------------------------\n");
+
+    result = d_tests_sa_fn_arena_predicate_new_in(_counter) && result;
+    result = d_tests_sa_fn_arena_compose_new_in(_counter) && result;
+    result = d_tests_sa_fn_arena_partial_consumer_new_in(_counter) && result;
+
+    return result;
+}
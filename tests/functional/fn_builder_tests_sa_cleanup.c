@@ -51,7 +51,7 @@ d_tests_sa_fn_builder_free
   - free on a builder with registered transforms succeeds
   - free on a builder with registered predicates succeeds
   - free on a builder with both transforms and predicates succeeds
-  - free(NULL) is a safe no-op
+  - d_functional_free(NULL) is a safe no-op
   - free on a builder that was used for execute succeeds
 */
 bool
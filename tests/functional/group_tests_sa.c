@@ -0,0 +1,26 @@
+#include ".\group_tests_sa.h"
+
+
+/*
+d_tests_sa_group_run_all
+  Module-level aggregation function that runs all group tests.
+  Executes tests for all categories:
+  - Serial grouped folds and table lookup
+  - Parallel grouped folds
+*/
+bool
+d_tests_sa_group_run_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    // run all test categories
+    result = d_tests_sa_group_fold_all(_counter)     && result;
+    result = d_tests_sa_group_parallel_all(_counter) && result;
+
+    return result;
+}
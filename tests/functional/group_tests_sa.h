@@ -0,0 +1,56 @@
+/******************************************************************************
+* djinterp [test]                                              group_tests_sa.h
+*
+*   Unit test declarations for `group.h` module.
+*   Provides testing of keyed aggregation: parameter validation, per-key
+* folds, first-appearance ordering, custom hashers and key equality, table
+* growth, lookup, and the parallel partitioned variant against the serial
+* fold.
+*
+*
+* path:      \tests\functional\group_tests_sa.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_TESTS_GROUP_SA_
+#define DJINTERP_TESTS_GROUP_SA_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "..\..\inc\djinterp.h"
+#include "..\..\inc\test\test_standalone.h"
+#include "..\..\inc\functional\group.h"
+
+
+/******************************************************************************
+ * I. GROUPED FOLD TESTS
+ *****************************************************************************/
+bool d_tests_sa_group_fold_validation(struct d_test_counter* _counter);
+bool d_tests_sa_group_fold_sum_by_key(struct d_test_counter* _counter);
+bool d_tests_sa_group_fold_custom_key(struct d_test_counter* _counter);
+bool d_tests_sa_group_fold_growth(struct d_test_counter* _counter);
+
+// I.   aggregation function
+bool d_tests_sa_group_fold_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * II. PARALLEL GROUPED FOLD TESTS
+ *****************************************************************************/
+bool d_tests_sa_group_fold_parallel_validation(struct d_test_counter* _counter);
+bool d_tests_sa_group_fold_parallel_matches_serial(struct d_test_counter* _counter);
+bool d_tests_sa_group_fold_parallel_failure(struct d_test_counter* _counter);
+
+// II.  aggregation function
+bool d_tests_sa_group_parallel_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * MODULE-LEVEL AGGREGATION
+ *****************************************************************************/
+bool d_tests_sa_group_run_all(struct d_test_counter* _counter);
+
+
+#endif  // DJINTERP_TESTS_GROUP_SA_
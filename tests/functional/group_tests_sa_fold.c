@@ -0,0 +1,504 @@
+#include ".\group_tests_sa.h"
+
+
+// group_key_mod
+//   helper: transformer writing the int element modulo the int context.
+static bool
+group_key_mod
+(
+    const void* _input,
+    void*       _output,
+    void*       _context
+)
+{
+    *(int*)_output = *(const int*)_input % *(const int*)_context;
+
+    return true;
+}
+
+// group_key_identity
+//   helper: transformer writing the int element itself.
+static bool
+group_key_identity
+(
+    const void* _input,
+    void*       _output,
+    void*       _context
+)
+{
+    (void)_context;
+
+    *(int*)_output = *(const int*)_input;
+
+    return true;
+}
+
+// group_key_string
+//   helper: transformer writing the string pointer itself.
+static bool
+group_key_string
+(
+    const void* _input,
+    void*       _output,
+    void*       _context
+)
+{
+    (void)_context;
+
+    *(const char**)_output = *(const char* const*)_input;
+
+    return true;
+}
+
+// group_lower
+//   helper: lower-cases an ASCII character.
+static int
+group_lower
+(
+    int _c
+)
+{
+    return ( (_c >= 'A') && (_c <= 'Z') ) ? (_c - 'A' + 'a') : _c;
+}
+
+// group_hash_string_nocase
+//   helper: case-insensitive string hasher; counts its calls in the context.
+static size_t
+group_hash_string_nocase
+(
+    const void* _element,
+    void*       _context
+)
+{
+    const char* s;
+    size_t      hash;
+
+    s    = *(const char* const*)_element;
+    hash = 0;
+
+    while (*s)
+    {
+        hash = (hash * 31) + (size_t)group_lower((unsigned char)*s);
+        s++;
+    }
+
+    if (_context)
+    {
+        (*(size_t*)_context)++;
+    }
+
+    return hash;
+}
+
+// group_equal_string_nocase
+//   helper: case-insensitive string equality.
+static bool
+group_equal_string_nocase
+(
+    const void* _element1,
+    const void* _element2,
+    void*       _context
+)
+{
+    const char* a;
+    const char* b;
+
+    (void)_context;
+
+    a = *(const char* const*)_element1;
+    b = *(const char* const*)_element2;
+
+    while ( (*a) &&
+            (group_lower((unsigned char)*a) == group_lower((unsigned char)*b)) )
+    {
+        a++;
+        b++;
+    }
+
+    return group_lower((unsigned char)*a) == group_lower((unsigned char)*b);
+}
+
+// group_acc_sum
+//   helper: accumulator adding the int element to an int state.
+static bool
+group_acc_sum
+(
+    void*       _accumulated,
+    const void* _element,
+    void*       _context
+)
+{
+    (void)_context;
+
+    *(int*)_accumulated += *(const int*)_element;
+
+    return true;
+}
+
+// group_acc_count
+//   helper: accumulator counting elements into a size_t state.
+static bool
+group_acc_count
+(
+    void*       _accumulated,
+    const void* _element,
+    void*       _context
+)
+{
+    (void)_element;
+    (void)_context;
+
+    (*(size_t*)_accumulated)++;
+
+    return true;
+}
+
+// group_acc_fail_negative
+//   helper: accumulator adding the int element; fails on negative elements.
+static bool
+group_acc_fail_negative
+(
+    void*       _accumulated,
+    const void* _element,
+    void*       _context
+)
+{
+    (void)_context;
+
+    if (*(const int*)_element < 0)
+    {
+        return false;
+    }
+
+    *(int*)_accumulated += *(const int*)_element;
+
+    return true;
+}
+
+
+/*
+d_tests_sa_group_fold_validation
+  Tests parameter validation of d_functional_group_fold.
+  Tests the following:
+  - NULL input / key / step / initial rejection
+  - zero count / element size / key size / state size rejection
+  - a failing accumulator fails the fold
+  - d_group_table_find and d_group_table_free accept NULL
+*/
+bool
+d_tests_sa_group_fold_validation
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                  result;
+    int                   values[3];
+    int                   modulus;
+    int                   zero;
+    struct d_group_table* table;
+
+    result    = true;
+    values[0] = 1;
+    values[1] = -2;
+    values[2] = 3;
+    modulus   = 2;
+    zero      = 0;
+
+    // test 1: NULL / zero
+    result = d_assert_standalone(
+        (!d_functional_group_fold(NULL, 3, sizeof(int), group_key_mod,
+                                  sizeof(int), NULL, NULL, &modulus,
+                                  group_acc_sum, &zero, sizeof(int), NULL)) &&
+        (!d_functional_group_fold(values, 3, sizeof(int), NULL,
+                                  sizeof(int), NULL, NULL, &modulus,
+                                  group_acc_sum, &zero, sizeof(int), NULL)) &&
+        (!d_functional_group_fold(values, 3, sizeof(int), group_key_mod,
+                                  sizeof(int), NULL, NULL, &modulus,
+                                  NULL, &zero, sizeof(int), NULL))          &&
+        (!d_functional_group_fold(values, 3, sizeof(int), group_key_mod,
+                                  sizeof(int), NULL, NULL, &modulus,
+                                  group_acc_sum, NULL, sizeof(int), NULL))  &&
+        (!d_functional_group_fold(values, 0, sizeof(int), group_key_mod,
+                                  sizeof(int), NULL, NULL, &modulus,
+                                  group_acc_sum, &zero, sizeof(int), NULL)) &&
+        (!d_functional_group_fold(values, 3, 0, group_key_mod,
+                                  sizeof(int), NULL, NULL, &modulus,
+                                  group_acc_sum, &zero, sizeof(int), NULL)) &&
+        (!d_functional_group_fold(values, 3, sizeof(int), group_key_mod,
+                                  0, NULL, NULL, &modulus,
+                                  group_acc_sum, &zero, sizeof(int), NULL)) &&
+        (!d_functional_group_fold(values, 3, sizeof(int), group_key_mod,
+                                  sizeof(int), NULL, NULL, &modulus,
+                                  group_acc_sum, &zero, 0, NULL)),
+        "group_fold_null_zero",
+        "NULL pointers or zero sizes should be rejected",
+        _counter) && result;
+
+    // test 2: failing accumulator
+    table = d_functional_group_fold(values, 3, sizeof(int), group_key_mod,
+                                    sizeof(int), NULL, NULL, &modulus,
+                                    group_acc_fail_negative, &zero,
+                                    sizeof(int), NULL);
+
+    result = d_assert_standalone(
+        (table == NULL),
+        "group_fold_failure",
+        "a failing accumulator should fail the fold",
+        _counter) && result;
+
+    // test 3: NULL table
+    d_group_table_free(NULL);
+
+    result = d_assert_standalone(
+        (d_group_table_find(NULL, &zero) == NULL),
+        "group_table_null",
+        "find should reject a NULL table and free should accept it",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_group_fold_sum_by_key
+  Tests d_functional_group_fold summing integers by key.
+  Tests the following:
+  - one group per distinct key
+  - groups are in order of first appearance
+  - states start from the initial value
+  - d_group_table_find returns the state of present keys and NULL otherwise
+*/
+bool
+d_tests_sa_group_fold_sum_by_key
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                  result;
+    int                   values[6];
+    int                   modulus;
+    int                   initial;
+    int                   key;
+    int*                  state;
+    const int*            keys;
+    const int*            states;
+    struct d_group_table* table;
+
+    result    = true;
+    values[0] = 7;
+    values[1] = 2;
+    values[2] = 17;
+    values[3] = 9;
+    values[4] = 12;
+    values[5] = 2;
+    modulus   = 10;
+    initial   = 100;
+
+    table = d_functional_group_fold(values, 6, sizeof(int), group_key_mod,
+                                    sizeof(int), NULL, NULL, &modulus,
+                                    group_acc_sum, &initial, sizeof(int),
+                                    NULL);
+
+    if (!table)
+    {
+        return d_assert_standalone(false,
+                                   "group_fold_sum_by_key",
+                                   "grouped fold should succeed",
+                                   _counter);
+    }
+
+    keys   = (const int*)table->keys;
+    states = (const int*)table->states;
+
+    // test 1: groups in first-appearance order
+    result = d_assert_standalone(
+        (table->count == 3)                      &&
+        (keys[0] == 7) && (states[0] == 124)     &&
+        (keys[1] == 2) && (states[1] == 116)     &&
+        (keys[2] == 9) && (states[2] == 109),
+        "group_fold_sum_by_key",
+        "each key should hold its sum, in first-appearance order",
+        _counter) && result;
+
+    // test 2: find
+    key   = 2;
+    state = (int*)d_group_table_find(table, &key);
+    key   = 5;
+
+    result = d_assert_standalone(
+        (state != NULL) && (*state == 116) &&
+        (d_group_table_find(table, &key) == NULL),
+        "group_table_find",
+        "find should return present states and NULL for absent keys",
+        _counter) && result;
+
+    d_group_table_free(table);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_group_fold_custom_key
+  Tests d_functional_group_fold with a custom hasher and key equality.
+  Tests the following:
+  - keys equal under the custom equality share a group
+  - the hasher receives the key context
+*/
+bool
+d_tests_sa_group_fold_custom_key
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                  result;
+    const char*           words[6];
+    const char*           probe;
+    size_t                zero;
+    size_t                hashes;
+    size_t*               state;
+    struct d_group_table* table;
+
+    result   = true;
+    words[0] = "Apple";
+    words[1] = "banana";
+    words[2] = "apple";
+    words[3] = "BANANA";
+    words[4] = "Cherry";
+    words[5] = "APPLE";
+    zero     = 0;
+    hashes   = 0;
+
+    table = d_functional_group_fold(words, 6, sizeof(const char*),
+                                    group_key_string, sizeof(const char*),
+                                    group_hash_string_nocase,
+                                    group_equal_string_nocase, &hashes,
+                                    group_acc_count, &zero, sizeof(size_t),
+                                    NULL);
+
+    if (!table)
+    {
+        return d_assert_standalone(false,
+                                   "group_fold_custom_key",
+                                   "grouped fold should succeed",
+                                   _counter);
+    }
+
+    // test 1: case-insensitive groups
+    probe = "aPPle";
+    state = (size_t*)d_group_table_find(table, &probe);
+
+    result = d_assert_standalone(
+        (table->count == 3)  &&
+        (state != NULL)      &&
+        (*state == 3)        &&
+        (((size_t*)table->states)[1] == 2),
+        "group_fold_custom_key",
+        "keys equal under the custom equality should share a group",
+        _counter) && result;
+
+    // test 2: hasher context
+    result = d_assert_standalone(
+        (hashes == 7),
+        "group_fold_key_context",
+        "the hasher should receive the key context",
+        _counter) && result;
+
+    d_group_table_free(table);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_group_fold_growth
+  Tests d_functional_group_fold growing past its initial capacity.
+  Tests the following:
+  - many distinct keys are all kept
+  - every key is still found after the table has grown
+*/
+bool
+d_tests_sa_group_fold_growth
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                  result;
+    int*                  values;
+    size_t                count;
+    size_t                i;
+    int                   zero;
+    int*                  state;
+    bool                  found;
+    struct d_group_table* table;
+
+    result = true;
+    count  = D_GROUP_INITIAL_CAPACITY * 64;
+    values = malloc(2 * count * sizeof(int));
+    zero   = 0;
+
+    if (!values)
+    {
+        return result;
+    }
+
+    // every key appears twice, the second time in reverse order
+    for (i = 0; i < count; i++)
+    {
+        values[i]                   = (int)(i * 1024);
+        values[(2 * count) - 1 - i] = (int)(i * 1024);
+    }
+
+    table = d_functional_group_fold(values, 2 * count, sizeof(int),
+                                    group_key_identity, sizeof(int),
+                                    NULL, NULL, NULL,
+                                    group_acc_sum, &zero, sizeof(int), NULL);
+
+    found = (table != NULL) &&
+            (table->count == count);
+
+    for (i = 0; (found) && (i < count); i++)
+    {
+        state = (int*)d_group_table_find(table, &values[i]);
+        found = (state != NULL) &&
+                (*state == 2 * values[i]);
+    }
+
+    // test 1: growth
+    result = d_assert_standalone(
+        found,
+        "group_fold_growth",
+        "every key should survive table growth",
+        _counter) && result;
+
+    d_group_table_free(table);
+    free(values);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_group_fold_all
+  Aggregation function that runs all grouped fold tests.
+*/
+bool
+d_tests_sa_group_fold_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Grouped Fold\n");
+    printf("  ----------------------\n");
+
+    result = d_tests_sa_group_fold_validation(_counter) && result;
+    result = d_tests_sa_group_fold_sum_by_key(_counter) && result;
+    result = d_tests_sa_group_fold_custom_key(_counter) && result;
+    result = d_tests_sa_group_fold_growth(_counter) && result;
+
+    return result;
+}
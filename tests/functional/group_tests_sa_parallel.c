@@ -0,0 +1,325 @@
+#include ".\group_tests_sa.h"
+
+
+// group_par_key_mod
+//   helper: transformer writing the int element modulo the int context.
+static bool
+group_par_key_mod
+(
+    const void* _input,
+    void*       _output,
+    void*       _context
+)
+{
+    *(int*)_output = *(const int*)_input % *(const int*)_context;
+
+    return true;
+}
+
+// group_par_acc_sum
+//   helper: accumulator adding the int element to a long long state.
+static bool
+group_par_acc_sum
+(
+    void*       _accumulated,
+    const void* _element,
+    void*       _context
+)
+{
+    (void)_context;
+
+    *(long long*)_accumulated += *(const int*)_element;
+
+    return true;
+}
+
+// group_par_merge_sum
+//   helper: combiner adding two long long states.
+static bool
+group_par_merge_sum
+(
+    void*       _accumulated,
+    const void* _partial,
+    void*       _context
+)
+{
+    (void)_context;
+
+    *(long long*)_accumulated += *(const long long*)_partial;
+
+    return true;
+}
+
+// group_par_merge_fail
+//   helper: combiner that always fails.
+static bool
+group_par_merge_fail
+(
+    void*       _accumulated,
+    const void* _partial,
+    void*       _context
+)
+{
+    (void)_accumulated;
+    (void)_partial;
+    (void)_context;
+
+    return false;
+}
+
+
+/*
+d_tests_sa_group_fold_parallel_validation
+  Tests parameter validation of d_functional_group_fold_parallel.
+  Tests the following:
+  - NULL input / key / step / merge / initial rejection
+  - zero count / sizes rejection
+*/
+bool
+d_tests_sa_group_fold_parallel_validation
+(
+    struct d_test_counter* _counter
+)
+{
+    bool      result;
+    int       values[3];
+    int       modulus;
+    long long zero;
+
+    result    = true;
+    values[0] = 1;
+    values[1] = 2;
+    values[2] = 3;
+    modulus   = 2;
+    zero      = 0;
+
+    // test 1: NULL / zero
+    result = d_assert_standalone(
+        (!d_functional_group_fold_parallel(NULL, 3, sizeof(int),
+              group_par_key_mod, sizeof(int), NULL, NULL, &modulus,
+              group_par_acc_sum, group_par_merge_sum, &zero,
+              sizeof(long long), NULL, 2))                              &&
+        (!d_functional_group_fold_parallel(values, 3, sizeof(int),
+              NULL, sizeof(int), NULL, NULL, &modulus,
+              group_par_acc_sum, group_par_merge_sum, &zero,
+              sizeof(long long), NULL, 2))                              &&
+        (!d_functional_group_fold_parallel(values, 3, sizeof(int),
+              group_par_key_mod, sizeof(int), NULL, NULL, &modulus,
+              NULL, group_par_merge_sum, &zero,
+              sizeof(long long), NULL, 2))                              &&
+        (!d_functional_group_fold_parallel(values, 3, sizeof(int),
+              group_par_key_mod, sizeof(int), NULL, NULL, &modulus,
+              group_par_acc_sum, NULL, &zero,
+              sizeof(long long), NULL, 2))                              &&
+        (!d_functional_group_fold_parallel(values, 3, sizeof(int),
+              group_par_key_mod, sizeof(int), NULL, NULL, &modulus,
+              group_par_acc_sum, group_par_merge_sum, NULL,
+              sizeof(long long), NULL, 2))                              &&
+        (!d_functional_group_fold_parallel(values, 0, sizeof(int),
+              group_par_key_mod, sizeof(int), NULL, NULL, &modulus,
+              group_par_acc_sum, group_par_merge_sum, &zero,
+              sizeof(long long), NULL, 2))                              &&
+        (!d_functional_group_fold_parallel(values, 3, sizeof(int),
+              group_par_key_mod, 0, NULL, NULL, &modulus,
+              group_par_acc_sum, group_par_merge_sum, &zero,
+              sizeof(long long), NULL, 2)),
+        "group_fold_parallel_null_zero",
+        "NULL pointers or zero sizes should be rejected",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_group_fold_parallel_matches_serial
+  Tests d_functional_group_fold_parallel against the serial fold.
+  Tests the following:
+  - same group count and per-key states for several thread counts
+  - small inputs fall back to the serial fold
+*/
+bool
+d_tests_sa_group_fold_parallel_matches_serial
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                  result;
+    int*                  values;
+    size_t                count;
+    size_t                i;
+    size_t                t;
+    size_t                threads[3];
+    int                   modulus;
+    long long             zero;
+    long long*            state;
+    bool                  matches;
+    struct d_group_table* serial;
+    struct d_group_table* parallel;
+
+    result     = true;
+    count      = D_FUNCTIONAL_PARALLEL_MIN_CHUNK * 5 + 13;
+    values     = malloc(count * sizeof(int));
+    modulus    = 997;
+    zero       = 0;
+    threads[0] = 2;
+    threads[1] = 4;
+    threads[2] = 0;
+
+    if (!values)
+    {
+        return result;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        values[i] = (int)((i * 7919) % 100003);
+    }
+
+    serial = d_functional_group_fold(values, count, sizeof(int),
+                                     group_par_key_mod, sizeof(int),
+                                     NULL, NULL, &modulus,
+                                     group_par_acc_sum, &zero,
+                                     sizeof(long long), NULL);
+
+    // test 1: several thread counts
+    for (t = 0; t < 3; t++)
+    {
+        parallel = d_functional_group_fold_parallel(values, count, sizeof(int),
+                                                    group_par_key_mod,
+                                                    sizeof(int), NULL, NULL,
+                                                    &modulus,
+                                                    group_par_acc_sum,
+                                                    group_par_merge_sum,
+                                                    &zero, sizeof(long long),
+                                                    NULL, threads[t]);
+
+        matches = (serial != NULL)   &&
+                  (parallel != NULL) &&
+                  (parallel->count == serial->count);
+
+        for (i = 0; (matches) && (i < serial->count); i++)
+        {
+            state   = (long long*)d_group_table_find(
+                          parallel,
+                          serial->keys + (i * serial->key_size));
+            matches = (state != NULL) &&
+                      (*state == ((long long*)serial->states)[i]);
+        }
+
+        result = d_assert_standalone(
+            matches,
+            "group_fold_parallel_matches_serial",
+            "parallel groups should match the serial fold",
+            _counter) && result;
+
+        d_group_table_free(parallel);
+    }
+
+    // test 2: small input
+    parallel = d_functional_group_fold_parallel(values, 10, sizeof(int),
+                                                group_par_key_mod,
+                                                sizeof(int), NULL, NULL,
+                                                &modulus,
+                                                group_par_acc_sum,
+                                                group_par_merge_sum,
+                                                &zero, sizeof(long long),
+                                                NULL, 4);
+
+    result = d_assert_standalone(
+        (parallel != NULL) &&
+        (parallel->count == 10),
+        "group_fold_parallel_small",
+        "small inputs should be folded serially",
+        _counter) && result;
+
+    d_group_table_free(parallel);
+    d_group_table_free(serial);
+    free(values);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_group_fold_parallel_failure
+  Tests failure propagation in d_functional_group_fold_parallel.
+  Tests the following:
+  - a failing combiner fails the whole fold
+*/
+bool
+d_tests_sa_group_fold_parallel_failure
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                  result;
+    int*                  values;
+    size_t                count;
+    size_t                i;
+    int                   modulus;
+    long long             zero;
+    struct d_group_table* table;
+
+    result  = true;
+    count   = D_FUNCTIONAL_PARALLEL_MIN_CHUNK * 4;
+    values  = malloc(count * sizeof(int));
+    modulus = 3;
+    zero    = 0;
+
+    if (!values)
+    {
+        return result;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        values[i] = (int)i;
+    }
+
+    // every chunk sees every key, so merging is unavoidable
+    table = d_functional_group_fold_parallel(values, count, sizeof(int),
+                                             group_par_key_mod, sizeof(int),
+                                             NULL, NULL, &modulus,
+                                             group_par_acc_sum,
+                                             group_par_merge_fail,
+                                             &zero, sizeof(long long),
+                                             NULL, 4);
+
+    // test 1: failing merge
+    result = d_assert_standalone(
+        (table == NULL),
+        "group_fold_parallel_failure",
+        "a failing combiner should fail the fold",
+        _counter) && result;
+
+    d_group_table_free(table);
+    free(values);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_group_parallel_all
+  Aggregation function that runs all parallel grouped fold tests.
+*/
+bool
+d_tests_sa_group_parallel_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Parallel Grouped Fold\n");
+    printf("  -------------------------------\n");
+
+    result = d_tests_sa_group_fold_parallel_validation(_counter) && result;
+    result = d_tests_sa_group_fold_parallel_matches_serial(_counter) && result;
+    result = d_tests_sa_group_fold_parallel_failure(_counter) && result;
+
+    return result;
+}
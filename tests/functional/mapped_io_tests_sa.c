@@ -0,0 +1,26 @@
+#include ".\mapped_io_tests_sa.h"
+
+
+/*
+d_tests_sa_mapped_io_run_all
+  Module-level aggregation function that runs all mapped I/O tests.
+  Executes tests for all categories:
+  - Mapped record inputs: opening, sources, and pipelines
+  - Mapped record outputs: writes, draining, and errors
+*/
+bool
+d_tests_sa_mapped_io_run_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    // run all test categories
+    result = d_tests_sa_mapped_io_input_all(_counter)  && result;
+    result = d_tests_sa_mapped_io_output_all(_counter) && result;
+
+    return result;
+}
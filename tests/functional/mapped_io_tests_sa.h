@@ -0,0 +1,59 @@
+/******************************************************************************
+* djinterp [test]                                          mapped_io_tests_sa.h
+*
+*   Unit test declarations for `mapped_io.h` module.
+*   Provides testing of mapped record inputs (record counts, rejection of
+* partial records, zero-copy chunked sources, and copy-on-write pipelines
+* that leave the file unchanged) and of growing mapped outputs (writes,
+* reserve / commit, growth, draining streams and filter streams, and the
+* final file size).
+*
+*
+* path:      \tests\functional\mapped_io_tests_sa.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_TESTS_MAPPED_IO_SA_
+#define DJINTERP_TESTS_MAPPED_IO_SA_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "..\..\inc\djinterp.h"
+#include "..\..\inc\test\test_standalone.h"
+#include "..\..\inc\functional\functional.h"
+#include "..\..\inc\functional\filter.h"
+#include "..\..\inc\functional\mapped_io.h"
+
+
+/******************************************************************************
+ * I. MAPPED INPUT TESTS
+ *****************************************************************************/
+bool d_tests_sa_mapped_io_input_open(struct d_test_counter* _counter);
+bool d_tests_sa_mapped_io_input_source(struct d_test_counter* _counter);
+bool d_tests_sa_mapped_io_input_pipeline(struct d_test_counter* _counter);
+
+// I.   aggregation function
+bool d_tests_sa_mapped_io_input_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * II. MAPPED OUTPUT TESTS
+ *****************************************************************************/
+bool d_tests_sa_mapped_io_output_write(struct d_test_counter* _counter);
+bool d_tests_sa_mapped_io_output_drain(struct d_test_counter* _counter);
+bool d_tests_sa_mapped_io_output_errors(struct d_test_counter* _counter);
+
+// II.  aggregation function
+bool d_tests_sa_mapped_io_output_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * MODULE-LEVEL AGGREGATION
+ *****************************************************************************/
+bool d_tests_sa_mapped_io_run_all(struct d_test_counter* _counter);
+
+
+#endif  // DJINTERP_TESTS_MAPPED_IO_SA_
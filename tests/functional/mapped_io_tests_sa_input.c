@@ -0,0 +1,384 @@
+#include ".\mapped_io_tests_sa.h"
+
+
+// MAPPED_INPUT_PATH
+//   helper: scratch file used by the input tests.
+#define MAPPED_INPUT_PATH "d_tests_mapped_input.bin"
+
+
+// mapped_write_ints
+//   helper: writes _count ints (value i * 3) to a file with stdio.
+static bool
+mapped_write_ints
+(
+    const char* _path,
+    size_t      _count
+)
+{
+    FILE*  file;
+    int    value;
+    size_t i;
+
+    file = fopen(_path, "wb");
+
+    if (!file)
+    {
+        return false;
+    }
+
+    for (i = 0; i < _count; i++)
+    {
+        value = (int)(i * 3);
+        fwrite(&value, sizeof(int), 1, file);
+    }
+
+    fclose(file);
+
+    return true;
+}
+
+// mapped_is_even
+//   helper: predicate true for even ints.
+static bool
+mapped_is_even
+(
+    const void* _element,
+    void*       _context
+)
+{
+    (void)_context;
+
+    return ((*(const int*)_element % 2) == 0);
+}
+
+// mapped_increment
+//   helper: consumer adding one to an int.
+static void
+mapped_increment
+(
+    void* _element,
+    void* _context
+)
+{
+    (void)_context;
+
+    (*(int*)_element)++;
+
+    return;
+}
+
+// mapped_double
+//   helper: transformer doubling an int.
+static bool
+mapped_double
+(
+    const void* _input,
+    void*       _output,
+    void*       _context
+)
+{
+    (void)_context;
+
+    *(int*)_output = *(const int*)_input * 2;
+
+    return true;
+}
+
+
+/*
+d_tests_sa_mapped_io_input_open
+  Tests d_functional_mapped_input.
+  Tests the following:
+  - the record count and contents of a mapped file
+  - a size that is not a whole number of records is rejected
+  - a missing file and invalid parameters are rejected
+  - an empty file maps to no records
+*/
+bool
+d_tests_sa_mapped_io_input_open
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                   result;
+    bool                   ok;
+    struct d_mapped_input* input;
+    const int*             data;
+    size_t                 i;
+
+    result = true;
+
+    // test 1: contents
+    ok    = mapped_write_ints(MAPPED_INPUT_PATH, 1000);
+    input = d_functional_mapped_input(MAPPED_INPUT_PATH, sizeof(int));
+    ok    = ok && (input) && (d_mapped_input_count(input) == 1000);
+    data  = (ok) ? (const int*)d_mapped_input_data(input) : NULL;
+
+    for (i = 0; (ok) && (i < 1000); i++)
+    {
+        ok = (data[i] == (int)(i * 3));
+    }
+
+    result = d_assert_standalone(
+        ok,
+        "mapped_input_contents",
+        "a mapped file should expose its records",
+        _counter) && result;
+
+    d_mapped_input_free(input);
+
+    // test 2: rejection
+    result = d_assert_standalone(
+        (d_functional_mapped_input(MAPPED_INPUT_PATH, 3) == NULL)          &&
+        (d_functional_mapped_input(MAPPED_INPUT_PATH, 0) == NULL)          &&
+        (d_functional_mapped_input(NULL, sizeof(int)) == NULL)             &&
+        (d_functional_mapped_input("d_tests_missing.bin",
+                                   sizeof(int)) == NULL),
+        "mapped_input_rejection",
+        "partial records, missing files, and bad parameters should fail",
+        _counter) && result;
+
+    // test 3: empty file
+    ok    = mapped_write_ints(MAPPED_INPUT_PATH, 0);
+    input = d_functional_mapped_input(MAPPED_INPUT_PATH, sizeof(int));
+
+    result = d_assert_standalone(
+        (ok)                                 &&
+        (input)                              &&
+        (d_mapped_input_count(input) == 0)   &&
+        (d_mapped_input_data(input) == NULL) &&
+        (d_mapped_input_pipeline(input).error_code != 0),
+        "mapped_input_empty",
+        "an empty file should map to no records",
+        _counter) && result;
+
+    d_mapped_input_free(input);
+    remove(MAPPED_INPUT_PATH);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_mapped_io_input_source
+  Tests d_mapped_input_source.
+  Tests the following:
+  - chunks point into the mapping, with a short final chunk
+  - a streamed fold over the source matches a fold over the mapping
+  - a filter stream over the source matches d_filter_apply_chain
+*/
+bool
+d_tests_sa_mapped_io_input_source
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                        result;
+    bool                        ok;
+    struct d_mapped_input*      input;
+    struct d_functional_source  source;
+    struct d_functional_stream* stream;
+    struct d_filter_chain*      chain;
+    struct d_filter_operation*  op;
+    struct d_filter_result*     eager;
+    struct d_filter_result*     streamed;
+    const void*                 chunk;
+    const unsigned char*        expected;
+    long long                   sum;
+    size_t                      total;
+    size_t                      n;
+
+    result = true;
+    ok     = mapped_write_ints(MAPPED_INPUT_PATH, 1000);
+    input  = d_functional_mapped_input(MAPPED_INPUT_PATH, sizeof(int));
+
+    if ( (!ok) || (!input) )
+    {
+        remove(MAPPED_INPUT_PATH);
+
+        return d_assert_standalone(false,
+                                   "mapped_source_setup",
+                                   "the scratch file should map",
+                                   _counter);
+    }
+
+    // test 1: zero-copy chunks of 64
+    source   = d_mapped_input_source(input, 64);
+    expected = (const unsigned char*)d_mapped_input_data(input);
+    total    = 0;
+
+    while ( (ok) &&
+            (d_functional_source_next(&source, &chunk, &n)) &&
+            (n > 0) )
+    {
+        ok        = (chunk == expected) && (n == ((total < 960) ? 64 : 40));
+        expected += n * sizeof(int);
+        total    += n;
+    }
+
+    result = d_assert_standalone(
+        (ok) && (total == 1000),
+        "mapped_source_chunks",
+        "the source should hand out the mapping in place, 64 at a time",
+        _counter) && result;
+
+    // test 2: streamed sum (of i * 3 for i < 1000)
+    sum    = 0;
+    stream = d_functional_stream_new(d_mapped_input_source(input, 100));
+
+    while ( (d_functional_stream_next(stream, &chunk, &n)) &&
+            (n > 0) )
+    {
+        for (total = 0; total < n; total++)
+        {
+            sum += ((const int*)chunk)[total];
+        }
+    }
+
+    result = d_assert_standalone(
+        (sum == 3LL * 999 * 1000 / 2),
+        "mapped_source_stream",
+        "a stream over the mapped source should see every record",
+        _counter) && result;
+
+    d_functional_stream_free(stream);
+
+    // test 3: filter chain over the source
+    chain = d_filter_chain_new();
+    op    = d_filter_where(mapped_is_even);
+    d_filter_chain_add(chain, op);
+    d_functional_free(op);
+    op = d_filter_take_last(30);
+    d_filter_chain_add(chain, op);
+    d_functional_free(op);
+
+    eager    = d_filter_apply_chain(chain,
+                                    d_mapped_input_data(input),
+                                    d_mapped_input_count(input),
+                                    sizeof(int));
+    streamed = d_filter_apply_chain_source(chain,
+                                           d_mapped_input_source(input, 0));
+
+    result = d_assert_standalone(
+        (eager)                                       &&
+        (streamed)                                    &&
+        (streamed->count == 30)                       &&
+        (eager->count == 30)                          &&
+        (memcmp(streamed->elements, eager->elements,
+                30 * sizeof(int)) == 0),
+        "mapped_source_filter",
+        "a filter stream over the mapping should match the eager chain",
+        _counter) && result;
+
+    d_filter_result_free(eager);
+    d_filter_result_free(streamed);
+    d_filter_chain_free(chain);
+    d_mapped_input_free(input);
+    remove(MAPPED_INPUT_PATH);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_mapped_io_input_pipeline
+  Tests d_mapped_input_pipeline.
+  Tests the following:
+  - in-place pipeline stages modify the mapped records in memory
+  - a map writes into the mapping instead of copying it to the heap
+  - the file itself is unchanged (copy-on-write)
+*/
+bool
+d_tests_sa_mapped_io_input_pipeline
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                         result;
+    bool                         ok;
+    struct d_mapped_input*       input;
+    struct d_mapped_input*       again;
+    struct d_functional_pipeline pipe;
+    const int*                   data;
+
+    result = true;
+    ok     = mapped_write_ints(MAPPED_INPUT_PATH, 500);
+    input  = d_functional_mapped_input(MAPPED_INPUT_PATH, sizeof(int));
+
+    // test 1: in-place for_each
+    pipe = d_functional_pipeline_for_each(d_mapped_input_pipeline(input),
+                                          mapped_increment,
+                                          NULL);
+    data = (const int*)d_mapped_input_data(input);
+
+    result = d_assert_standalone(
+        (ok)                     &&
+        (pipe.error_code == 0)   &&
+        (pipe.data == data)      &&
+        (data[0] == 1)           &&
+        (data[499] == 1498),
+        "mapped_pipeline_in_place",
+        "an in-place stage should modify the mapped records",
+        _counter) && result;
+
+    d_functional_pipeline_free(&pipe);
+
+    // test 2: in-place map
+    pipe = d_functional_pipeline_map(d_mapped_input_pipeline(input),
+                                     mapped_double,
+                                     NULL);
+
+    result = d_assert_standalone(
+        (pipe.error_code == 0)   &&
+        (pipe.data == data)      &&
+        (data[0] == 2)           &&
+        (data[499] == 2996),
+        "mapped_pipeline_map_in_place",
+        "a map should write into the mapping, not a heap copy",
+        _counter) && result;
+
+    d_functional_pipeline_free(&pipe);
+
+    // test 3: the file is unchanged
+    again = d_functional_mapped_input(MAPPED_INPUT_PATH, sizeof(int));
+    data  = (again) ? (const int*)d_mapped_input_data(again) : NULL;
+
+    result = d_assert_standalone(
+        (data)              &&
+        (data[0] == 0)      &&
+        (data[499] == 1497),
+        "mapped_pipeline_copy_on_write",
+        "modifying the mapping should not change the file",
+        _counter) && result;
+
+    d_mapped_input_free(again);
+    d_mapped_input_free(input);
+    remove(MAPPED_INPUT_PATH);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_mapped_io_input_all
+  Aggregation function that runs all mapped input tests.
+*/
+bool
+d_tests_sa_mapped_io_input_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Mapped Input\n");
+    printf("  ----------------------\n");
+
+    result = d_tests_sa_mapped_io_input_open(_counter)     && result;
+    result = d_tests_sa_mapped_io_input_source(_counter)   && result;
+    result = d_tests_sa_mapped_io_input_pipeline(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,307 @@
+#include ".\mapped_io_tests_sa.h"
+
+
+// MAPPED_OUTPUT_PATH
+//   helper: scratch file used by the output tests.
+#define MAPPED_OUTPUT_PATH "d_tests_mapped_output.bin"
+
+// MAPPED_SOURCE_PATH
+//   helper: scratch input file used by the drain test.
+#define MAPPED_SOURCE_PATH "d_tests_mapped_source.bin"
+
+
+// mapped_file_size
+//   helper: returns the size of a file in bytes, or (size_t)-1.
+static size_t
+mapped_file_size
+(
+    const char* _path
+)
+{
+    FILE* file;
+    long  size;
+
+    file = fopen(_path, "rb");
+
+    if (!file)
+    {
+        return (size_t)-1;
+    }
+
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    fclose(file);
+
+    return (size < 0) ? (size_t)-1 : (size_t)size;
+}
+
+// mapped_is_multiple_of_3
+//   helper: predicate true for ints divisible by 3.
+static bool
+mapped_is_multiple_of_3
+(
+    const void* _element,
+    void*       _context
+)
+{
+    (void)_context;
+
+    return ((*(const int*)_element % 3) == 0);
+}
+
+
+/*
+d_tests_sa_mapped_io_output_write
+  Tests writing to a mapped output.
+  Tests the following:
+  - write and reserve / commit append records in order
+  - the mapping grows from a capacity of one record
+  - close cuts the file to the records written
+*/
+bool
+d_tests_sa_mapped_io_output_write
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                    result;
+    bool                    ok;
+    struct d_mapped_output* output;
+    struct d_mapped_input*  input;
+    const int*              data;
+    int*                    slot;
+    int                     value;
+    size_t                  i;
+
+    result = true;
+    output = d_functional_mapped_output(MAPPED_OUTPUT_PATH, sizeof(int), 1);
+    ok     = (output != NULL);
+
+    // 0..4999 one at a time, then 5000..9999 produced in place
+    for (i = 0; (ok) && (i < 5000); i++)
+    {
+        value = (int)i;
+        ok    = d_mapped_output_write(output, &value, 1);
+    }
+
+    slot = (ok) ? (int*)d_mapped_output_reserve(output, 5000) : NULL;
+    ok   = (slot != NULL);
+
+    for (i = 0; (ok) && (i < 5000); i++)
+    {
+        slot[i] = (int)(5000 + i);
+    }
+
+    ok = ok                                        &&
+         (d_mapped_output_commit(output, 5000))    &&
+         (output->count == 10000)                  &&
+         (output->capacity >= 10000);
+
+    // test 1: writes and growth
+    result = d_assert_standalone(
+        ok,
+        "mapped_output_write",
+        "writes and committed reservations should grow the output",
+        _counter) && result;
+
+    // test 2: final file
+    ok    = d_mapped_output_close(output);
+    input = d_functional_mapped_input(MAPPED_OUTPUT_PATH, sizeof(int));
+    data  = (input) ? (const int*)d_mapped_input_data(input) : NULL;
+    ok    = ok                                                  &&
+            (mapped_file_size(MAPPED_OUTPUT_PATH) ==
+             10000 * sizeof(int))                               &&
+            (data != NULL);
+
+    for (i = 0; (ok) && (i < 10000); i++)
+    {
+        ok = (data[i] == (int)i);
+    }
+
+    result = d_assert_standalone(
+        ok,
+        "mapped_output_file",
+        "the closed file should hold exactly the records written",
+        _counter) && result;
+
+    d_mapped_input_free(input);
+    remove(MAPPED_OUTPUT_PATH);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_mapped_io_output_drain
+  Tests d_mapped_output_drain.
+  Tests the following:
+  - a filter stream over a mapped input drains into a mapped output that
+    matches d_filter_apply_chain over the same records
+  - an element size mismatch is rejected
+*/
+bool
+d_tests_sa_mapped_io_output_drain
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                       result;
+    bool                       ok;
+    struct d_mapped_output*    output;
+    struct d_mapped_input*     input;
+    struct d_mapped_input*     written;
+    struct d_filter_chain*     chain;
+    struct d_filter_operation* op;
+    struct d_filter_stream*    stream;
+    struct d_filter_result*    eager;
+    struct d_functional_source source;
+    int                        values[3000];
+    size_t                     i;
+
+    result = true;
+
+    for (i = 0; i < 3000; i++)
+    {
+        values[i] = (int)((i * 7) % 1001);
+    }
+
+    // write the input through a mapped output as well
+    output = d_functional_mapped_output(MAPPED_SOURCE_PATH, sizeof(int), 0);
+    ok     = (d_mapped_output_write(output, values, 3000)) &&
+             (d_mapped_output_close(output));
+
+    chain = d_filter_chain_new();
+    op    = d_filter_where(mapped_is_multiple_of_3);
+    d_filter_chain_add(chain, op);
+    d_functional_free(op);
+    op = d_filter_skip_first(10);
+    d_filter_chain_add(chain, op);
+    d_functional_free(op);
+
+    input  = d_functional_mapped_input(MAPPED_SOURCE_PATH, sizeof(int));
+    stream = d_filter_stream_new(chain, d_mapped_input_source(input, 128));
+    source = d_filter_stream_source(stream);
+    output = d_functional_mapped_output(MAPPED_OUTPUT_PATH, sizeof(int), 16);
+    ok     = ok                                    &&
+             (d_mapped_output_drain(output, &source)) &&
+             (d_mapped_output_close(output));
+
+    eager   = d_filter_apply_chain(chain, values, 3000, sizeof(int));
+    written = d_functional_mapped_input(MAPPED_OUTPUT_PATH, sizeof(int));
+
+    // test 1: drained output matches the eager chain
+    result = d_assert_standalone(
+        (ok)                                                   &&
+        (eager)                                                &&
+        (written)                                              &&
+        (d_mapped_input_count(written) == eager->count)        &&
+        (memcmp(d_mapped_input_data(written), eager->elements,
+                eager->count * sizeof(int)) == 0),
+        "mapped_output_drain",
+        "a drained filter stream should match the eager chain",
+        _counter) && result;
+
+    // test 2: element size mismatch
+    output = d_functional_mapped_output(MAPPED_OUTPUT_PATH, sizeof(short), 0);
+    source = d_mapped_input_source(input, 0);
+
+    result = d_assert_standalone(
+        (!d_mapped_output_drain(output, &source)),
+        "mapped_output_drain_mismatch",
+        "draining a source of another element size should fail",
+        _counter) && result;
+
+    d_mapped_output_close(output);
+    d_mapped_input_free(written);
+    d_filter_result_free(eager);
+    d_filter_stream_free(stream);
+    d_mapped_input_free(input);
+    d_filter_chain_free(chain);
+    remove(MAPPED_SOURCE_PATH);
+    remove(MAPPED_OUTPUT_PATH);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_mapped_io_output_errors
+  Tests parameter validation of mapped outputs.
+  Tests the following:
+  - invalid parameters to open, write, reserve, and commit
+  - committing more than was reserved fails
+  - closing NULL fails safely
+*/
+bool
+d_tests_sa_mapped_io_output_errors
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                    result;
+    struct d_mapped_output* output;
+
+    result = true;
+
+    // test 1: open rejection
+    result = d_assert_standalone(
+        (d_functional_mapped_output(NULL, sizeof(int), 4) == NULL)         &&
+        (d_functional_mapped_output(MAPPED_OUTPUT_PATH, 0, 4) == NULL),
+        "mapped_output_rejection",
+        "a NULL path or zero element size should be rejected",
+        _counter) && result;
+
+    // test 2: write / reserve / commit validation
+    output = d_functional_mapped_output(MAPPED_OUTPUT_PATH, sizeof(int), 4);
+
+    result = d_assert_standalone(
+        (output)                                              &&
+        (!d_mapped_output_write(output, NULL, 3))             &&
+        (d_mapped_output_write(output, NULL, 0))              &&
+        (!d_mapped_output_write(NULL, &result, 1))            &&
+        (d_mapped_output_reserve(NULL, 1) == NULL)            &&
+        (!d_mapped_output_commit(output, 5))                  &&
+        (d_mapped_output_commit(output, 4))                   &&
+        (output->count == 4),
+        "mapped_output_validation",
+        "writes and commits beyond the capacity should be rejected",
+        _counter) && result;
+
+    // test 3: close
+    result = d_assert_standalone(
+        (d_mapped_output_close(output))                       &&
+        (mapped_file_size(MAPPED_OUTPUT_PATH) == 4 * sizeof(int)) &&
+        (!d_mapped_output_close(NULL)),
+        "mapped_output_close",
+        "close should keep the committed records and reject NULL",
+        _counter) && result;
+
+    remove(MAPPED_OUTPUT_PATH);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_mapped_io_output_all
+  Aggregation function that runs all mapped output tests.
+*/
+bool
+d_tests_sa_mapped_io_output_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Mapped Output\n");
+    printf("  -----------------------\n");
+
+    result = d_tests_sa_mapped_io_output_write(_counter)  && result;
+    result = d_tests_sa_mapped_io_output_drain(_counter)  && result;
+    result = d_tests_sa_mapped_io_output_errors(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,28 @@
+#include ".\memoize_tests_sa.h"
+
+
+/*
+d_tests_sa_memoize_run_all
+  Module-level aggregation function that runs all memoize tests.
+  Executes tests for all categories:
+  - Construction functions
+  - Memoized evaluation through the predicate/transformer adapters
+  - Statistics, clearing, and cleanup
+*/
+bool
+d_tests_sa_memoize_run_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    // run all test categories
+    result = d_tests_sa_memoize_creation_all(_counter) && result;
+    result = d_tests_sa_memoize_eval_all(_counter)     && result;
+    result = d_tests_sa_memoize_stats_all(_counter)    && result;
+
+    return result;
+}
@@ -0,0 +1,68 @@
+/******************************************************************************
+* djinterp [test]                                            memoize_tests_sa.h
+*
+*   Unit test declarations for `memoize.h` module.
+*   Provides testing of memoized predicates and transformers including
+* construction and parameter validation, cache hits and misses through the
+* fn_predicate / fn_transformer adapters, CLOCK eviction within a set,
+* custom hashers and key equality, sharded memos, statistics, and clearing.
+*
+*
+* path:      \tests\functional\memoize_tests_sa.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_TESTS_MEMOIZE_SA_
+#define DJINTERP_TESTS_MEMOIZE_SA_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "..\..\inc\djinterp.h"
+#include "..\..\inc\test\test_standalone.h"
+#include "..\..\inc\functional\memoize.h"
+
+
+/******************************************************************************
+ * I. CONSTRUCTION TESTS
+ *****************************************************************************/
+bool d_tests_sa_memoize_predicate_new(struct d_test_counter* _counter);
+bool d_tests_sa_memoize_transformer_new(struct d_test_counter* _counter);
+bool d_tests_sa_memoize_set_equality(struct d_test_counter* _counter);
+
+// I.   aggregation function
+bool d_tests_sa_memoize_creation_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * II. EVALUATION TESTS
+ *****************************************************************************/
+bool d_tests_sa_memoized_test(struct d_test_counter* _counter);
+bool d_tests_sa_memoized_apply(struct d_test_counter* _counter);
+bool d_tests_sa_memoize_eviction(struct d_test_counter* _counter);
+bool d_tests_sa_memoize_custom_key(struct d_test_counter* _counter);
+bool d_tests_sa_memoize_sharded(struct d_test_counter* _counter);
+
+// II.  aggregation function
+bool d_tests_sa_memoize_eval_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * III. STATISTICS AND CLEANUP TESTS
+ *****************************************************************************/
+bool d_tests_sa_memoize_stats(struct d_test_counter* _counter);
+bool d_tests_sa_memoize_clear(struct d_test_counter* _counter);
+bool d_tests_sa_memoize_free(struct d_test_counter* _counter);
+
+// III. aggregation function
+bool d_tests_sa_memoize_stats_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * MODULE-LEVEL AGGREGATION
+ *****************************************************************************/
+bool d_tests_sa_memoize_run_all(struct d_test_counter* _counter);
+
+
+#endif  // DJINTERP_TESTS_MEMOIZE_SA_
@@ -0,0 +1,283 @@
+#include ".\memoize_tests_sa.h"
+#include ".\memoize_tests_sa_helpers.h"
+
+
+/*
+d_tests_sa_memoize_predicate_new
+  Tests the d_functional_memoize_predicate constructor function.
+  Tests the following:
+  - NULL predicate rejection
+  - zero key size rejection
+  - default capacity when 0 is requested
+  - capacity rounded up to whole sets
+  - unsharded memo takes no locks
+  - sharded memo rounds the shard count up to a power of two
+*/
+bool
+d_tests_sa_memoize_predicate_new
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                   result;
+    struct d_memoize*      memo;
+    struct d_memoize_stats stats;
+    int                    calls;
+
+    result = true;
+    calls  = 0;
+
+    // test 1: NULL predicate
+    result = d_assert_standalone(
+        d_functional_memoize_predicate(NULL, NULL, sizeof(int),
+                                       NULL, NULL, 16, 0) == NULL,
+        "memoize_predicate_new_null_predicate",
+        "NULL predicate should return NULL",
+        _counter) && result;
+
+    // test 2: zero key size
+    result = d_assert_standalone(
+        d_functional_memoize_predicate(memo_counted_is_even, &calls, 0,
+                                       NULL, NULL, 16, 0) == NULL,
+        "memoize_predicate_new_zero_key_size",
+        "zero key size should return NULL",
+        _counter) && result;
+
+    // test 3: default capacity
+    memo = d_functional_memoize_predicate(memo_counted_is_even,
+                                          &calls,
+                                          sizeof(int),
+                                          NULL,
+                                          NULL,
+                                          0,
+                                          0);
+
+    result = d_assert_standalone(
+        (memo != NULL)                                    &&
+        (d_functional_memoize_stats(memo, &stats))        &&
+        (stats.capacity == D_MEMOIZE_DEFAULT_CAPACITY)    &&
+        (stats.entries == 0)                              &&
+        (memo->kind == D_MEMOIZE_PREDICATE)               &&
+        (memo->value_size == sizeof(bool))                &&
+        (!memo->locking)                                  &&
+        (memo->shard_count == 1),
+        "memoize_predicate_new_default",
+        "capacity 0 should select the default, unsharded",
+        _counter) && result;
+
+    d_functional_memoize_free(memo);
+
+    // test 4: capacity rounding
+    memo = d_functional_memoize_predicate(memo_counted_is_even,
+                                          &calls,
+                                          sizeof(int),
+                                          NULL,
+                                          NULL,
+                                          10,
+                                          0);
+
+    result = d_assert_standalone(
+        (memo != NULL)                             &&
+        (d_functional_memoize_stats(memo, &stats)) &&
+        (stats.capacity == 4 * D_MEMOIZE_WAYS),
+        "memoize_predicate_new_rounding",
+        "capacity should round up to a power-of-two number of sets",
+        _counter) && result;
+
+    d_functional_memoize_free(memo);
+
+    // test 5: sharded
+    memo = d_functional_memoize_predicate(memo_counted_is_even,
+                                          &calls,
+                                          sizeof(int),
+                                          NULL,
+                                          NULL,
+                                          64,
+                                          3);
+
+    result = d_assert_standalone(
+        (memo != NULL)                             &&
+        (memo->locking)                            &&
+        (memo->shard_count == 4)                   &&
+        (memo->shards[3].first_set ==
+             3 * memo->sets_per_shard)             &&
+        (d_functional_memoize_stats(memo, &stats)) &&
+        (stats.capacity >= 64),
+        "memoize_predicate_new_sharded",
+        "shard count should round up to a power of two",
+        _counter) && result;
+
+    d_functional_memoize_free(memo);
+
+    result = d_assert_standalone(
+        calls == 0,
+        "memoize_predicate_new_no_calls",
+        "construction should not call the predicate",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_memoize_transformer_new
+  Tests the d_functional_memoize_transformer constructor function.
+  Tests the following:
+  - NULL transformer rejection
+  - zero key size rejection
+  - zero output size rejection
+  - valid construction records sizes and kind
+*/
+bool
+d_tests_sa_memoize_transformer_new
+(
+    struct d_test_counter* _counter
+)
+{
+    bool              result;
+    struct d_memoize* memo;
+    int               calls;
+
+    result = true;
+    calls  = 0;
+
+    // test 1: NULL transformer
+    result = d_assert_standalone(
+        d_functional_memoize_transformer(NULL, NULL, sizeof(int),
+                                         sizeof(long long),
+                                         NULL, NULL, 16, 0) == NULL,
+        "memoize_transformer_new_null_transform",
+        "NULL transformer should return NULL",
+        _counter) && result;
+
+    // test 2: zero key size
+    result = d_assert_standalone(
+        d_functional_memoize_transformer(memo_counted_square, &calls, 0,
+                                         sizeof(long long),
+                                         NULL, NULL, 16, 0) == NULL,
+        "memoize_transformer_new_zero_key_size",
+        "zero key size should return NULL",
+        _counter) && result;
+
+    // test 3: zero output size
+    result = d_assert_standalone(
+        d_functional_memoize_transformer(memo_counted_square, &calls,
+                                         sizeof(int), 0,
+                                         NULL, NULL, 16, 0) == NULL,
+        "memoize_transformer_new_zero_output_size",
+        "zero output size should return NULL",
+        _counter) && result;
+
+    // test 4: valid construction
+    memo = d_functional_memoize_transformer(memo_counted_square,
+                                            &calls,
+                                            sizeof(int),
+                                            sizeof(long long),
+                                            NULL,
+                                            NULL,
+                                            16,
+                                            0);
+
+    result = d_assert_standalone(
+        (memo != NULL)                              &&
+        (memo->kind == D_MEMOIZE_TRANSFORMER)       &&
+        (memo->transform == memo_counted_square)    &&
+        (memo->context == &calls)                   &&
+        (memo->key_size == sizeof(int))             &&
+        (memo->value_size == sizeof(long long)),
+        "memoize_transformer_new_valid",
+        "valid parameters should create a transformer memo",
+        _counter) && result;
+
+    d_functional_memoize_free(memo);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_memoize_set_equality
+  Tests the d_functional_memoize_set_equality function.
+  Tests the following:
+  - NULL memo rejection
+  - equality and context are recorded
+  - NULL equality restores byte comparison
+*/
+bool
+d_tests_sa_memoize_set_equality
+(
+    struct d_test_counter* _counter
+)
+{
+    bool              result;
+    struct d_memoize* memo;
+    int               dummy;
+
+    result = true;
+
+    // test 1: NULL memo
+    result = d_assert_standalone(
+        !d_functional_memoize_set_equality(NULL, memo_equal_string, NULL),
+        "memoize_set_equality_null",
+        "NULL memo should return false",
+        _counter) && result;
+
+    memo = d_functional_memoize_predicate(memo_counted_has_vowel,
+                                          NULL,
+                                          sizeof(const char*),
+                                          memo_hash_string,
+                                          NULL,
+                                          16,
+                                          0);
+
+    if (memo)
+    {
+        // test 2: recorded
+        result = d_assert_standalone(
+            (d_functional_memoize_set_equality(memo,
+                                               memo_equal_string,
+                                               &dummy)) &&
+            (memo->equal == memo_equal_string)          &&
+            (memo->equal_context == &dummy),
+            "memoize_set_equality_recorded",
+            "equality and context should be stored",
+            _counter) && result;
+
+        // test 3: reset
+        result = d_assert_standalone(
+            (d_functional_memoize_set_equality(memo, NULL, NULL)) &&
+            (memo->equal == NULL),
+            "memoize_set_equality_reset",
+            "NULL equality should restore byte comparison",
+            _counter) && result;
+
+        d_functional_memoize_free(memo);
+    }
+
+    return result;
+}
+
+
+/*
+d_tests_sa_memoize_creation_all
+  Aggregation function that runs all construction tests.
+*/
+bool
+d_tests_sa_memoize_creation_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Construction\n");
+    printf("  ----------------------\n");
+
+    result = d_tests_sa_memoize_predicate_new(_counter) && result;
+    result = d_tests_sa_memoize_transformer_new(_counter) && result;
+    result = d_tests_sa_memoize_set_equality(_counter) && result;
+
+    return result;
+}
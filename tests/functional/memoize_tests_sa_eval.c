@@ -0,0 +1,548 @@
+#include ".\memoize_tests_sa.h"
+#include ".\memoize_tests_sa_helpers.h"
+
+
+/*
+d_tests_sa_memoized_test
+  Tests the d_functional_memoized_test predicate adapter.
+  Tests the following:
+  - NULL element / context rejection
+  - transformer memo rejected as a predicate
+  - first evaluation calls the predicate, repeats are served from cache
+  - cached results are correct for both true and false
+*/
+bool
+d_tests_sa_memoized_test
+(
+    struct d_test_counter* _counter
+)
+{
+    bool              result;
+    struct d_memoize* memo;
+    struct d_memoize* other;
+    int               calls;
+    int               value;
+    int               i;
+    bool              ok;
+
+    result = true;
+    calls  = 0;
+    value  = 4;
+
+    memo  = d_functional_memoize_predicate(memo_counted_is_even,
+                                           &calls,
+                                           sizeof(int),
+                                           NULL,
+                                           NULL,
+                                           64,
+                                           0);
+    other = d_functional_memoize_transformer(memo_counted_square,
+                                             &calls,
+                                             sizeof(int),
+                                             sizeof(long long),
+                                             NULL,
+                                             NULL,
+                                             64,
+                                             0);
+
+    // test 1: parameter rejection
+    result = d_assert_standalone(
+        (!d_functional_memoized_test(NULL, memo))   &&
+        (!d_functional_memoized_test(&value, NULL)) &&
+        (!d_functional_memoized_test(&value, other)) &&
+        (calls == 0),
+        "memoized_test_rejection",
+        "NULL parameters and non-predicate memos should return false",
+        _counter) && result;
+
+    if (memo)
+    {
+        // test 2: first call is a miss
+        result = d_assert_standalone(
+            (d_functional_memoized_test(&value, memo)) &&
+            (calls == 1),
+            "memoized_test_miss",
+            "first evaluation should call the predicate",
+            _counter) && result;
+
+        // test 3: repeats are hits
+        ok = true;
+
+        for (i = 0; i < 10; i++)
+        {
+            ok = d_functional_memoized_test(&value, memo) && ok;
+        }
+
+        result = d_assert_standalone(
+            ok && (calls == 1),
+            "memoized_test_hit",
+            "repeated evaluation should be served from the cache",
+            _counter) && result;
+
+        // test 4: low-cardinality keys, both results
+        ok    = true;
+        calls = 0;
+
+        for (i = 0; i < 100; i++)
+        {
+            value = i % 8;
+            ok    = ( d_functional_memoized_test(&value, memo) ==
+                      ((value % 2) == 0) ) && ok;
+        }
+
+        result = d_assert_standalone(
+            ok && (calls == 7),
+            "memoized_test_low_cardinality",
+            "8 distinct keys should call the predicate once each",
+            _counter) && result;
+    }
+
+    d_functional_memoize_free(memo);
+    d_functional_memoize_free(other);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_memoized_apply
+  Tests the d_functional_memoized_apply transformer adapter.
+  Tests the following:
+  - NULL input / output / context rejection
+  - predicate memo rejected as a transformer
+  - results are cached and copied to the output
+  - failed transformations are not cached
+  - in-place transformation is computed but not cached
+*/
+bool
+d_tests_sa_memoized_apply
+(
+    struct d_test_counter* _counter
+)
+{
+    bool              result;
+    struct d_memoize* memo;
+    struct d_memoize* other;
+    int               calls;
+    int               value;
+    int               out_int;
+    long long         out;
+
+    result = true;
+    calls  = 0;
+    value  = 7;
+    out    = 0;
+
+    memo  = d_functional_memoize_transformer(memo_counted_square,
+                                             &calls,
+                                             sizeof(int),
+                                             sizeof(long long),
+                                             NULL,
+                                             NULL,
+                                             64,
+                                             0);
+    other = d_functional_memoize_predicate(memo_counted_is_even,
+                                           &calls,
+                                           sizeof(int),
+                                           NULL,
+                                           NULL,
+                                           64,
+                                           0);
+
+    // test 1: parameter rejection
+    result = d_assert_standalone(
+        (!d_functional_memoized_apply(NULL, &out, memo))   &&
+        (!d_functional_memoized_apply(&value, NULL, memo)) &&
+        (!d_functional_memoized_apply(&value, &out, NULL)) &&
+        (!d_functional_memoized_apply(&value, &out, other)) &&
+        (calls == 0),
+        "memoized_apply_rejection",
+        "NULL parameters and non-transformer memos should return false",
+        _counter) && result;
+
+    if (memo)
+    {
+        // test 2: miss then hit
+        result = d_assert_standalone(
+            (d_functional_memoized_apply(&value, &out, memo)) &&
+            (out == 49)                                       &&
+            (calls == 1),
+            "memoized_apply_miss",
+            "first application should call the transformer",
+            _counter) && result;
+
+        out = 0;
+
+        result = d_assert_standalone(
+            (d_functional_memoized_apply(&value, &out, memo)) &&
+            (out == 49)                                       &&
+            (calls == 1),
+            "memoized_apply_hit",
+            "repeated application should copy the cached output",
+            _counter) && result;
+    }
+
+    d_functional_memoize_free(memo);
+    d_functional_memoize_free(other);
+
+    // test 3: failures are not cached
+    calls = 0;
+    memo  = d_functional_memoize_transformer(memo_counted_fail_negative,
+                                             &calls,
+                                             sizeof(int),
+                                             sizeof(int),
+                                             NULL,
+                                             NULL,
+                                             64,
+                                             0);
+
+    if (memo)
+    {
+        value = -3;
+
+        result = d_assert_standalone(
+            (!d_functional_memoized_apply(&value, &out_int, memo)) &&
+            (!d_functional_memoized_apply(&value, &out_int, memo)) &&
+            (calls == 2),
+            "memoized_apply_failure_not_cached",
+            "failed transformations should be retried, not cached",
+            _counter) && result;
+
+        // test 4: in-place application computes but does not cache
+        calls = 0;
+        value = 5;
+
+        result = d_assert_standalone(
+            (d_functional_memoized_apply(&value, &value, memo)) &&
+            (value == 10)                                       &&
+            (calls == 1),
+            "memoized_apply_in_place",
+            "in-place application should compute the result",
+            _counter) && result;
+
+        value = 5;
+
+        result = d_assert_standalone(
+            (d_functional_memoized_apply(&value, &out_int, memo)) &&
+            (out_int == 10)                                       &&
+            (calls == 2),
+            "memoized_apply_in_place_not_cached",
+            "an in-place result should not have been cached",
+            _counter) && result;
+
+        d_functional_memoize_free(memo);
+    }
+
+    return result;
+}
+
+
+/*
+d_tests_sa_memoize_eviction
+  Tests CLOCK eviction within a set. A hasher mapping every key to the same
+value forces all keys into one D_MEMOIZE_WAYS-entry set.
+  Tests the following:
+  - a set holds D_MEMOIZE_WAYS keys without eviction
+  - inserting one more key evicts an entry
+  - a recently hit entry survives eviction (second chance)
+  - results stay correct under eviction
+*/
+bool
+d_tests_sa_memoize_eviction
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                   result;
+    struct d_memoize*      memo;
+    struct d_memoize_stats stats;
+    int                    calls;
+    int                    value;
+    int                    i;
+    bool                   ok;
+
+    result = true;
+    calls  = 0;
+
+    memo = d_functional_memoize_predicate(memo_counted_is_even,
+                                          &calls,
+                                          sizeof(int),
+                                          memo_hash_zero,
+                                          NULL,
+                                          16,
+                                          0);
+
+    if (!memo)
+    {
+        return d_assert_standalone(false,
+                                   "memoize_eviction_alloc",
+                                   "memo allocation failed",
+                                   _counter);
+    }
+
+    // test 1: fill one set
+    for (i = 0; i < D_MEMOIZE_WAYS; i++)
+    {
+        value = i;
+        d_functional_memoized_test(&value, memo);
+    }
+
+    d_functional_memoize_stats(memo, &stats);
+
+    result = d_assert_standalone(
+        (stats.entries == D_MEMOIZE_WAYS) &&
+        (stats.evictions == 0)            &&
+        (calls == D_MEMOIZE_WAYS),
+        "memoize_eviction_fill",
+        "a set should hold D_MEMOIZE_WAYS keys without eviction",
+        _counter) && result;
+
+    // reference key 0 so it gets a second chance
+    value = 0;
+    d_functional_memoized_test(&value, memo);
+
+    // test 2: one more key evicts exactly one entry
+    value = 100;
+    d_functional_memoized_test(&value, memo);
+    d_functional_memoize_stats(memo, &stats);
+
+    result = d_assert_standalone(
+        (stats.entries == D_MEMOIZE_WAYS) &&
+        (stats.evictions == 1)            &&
+        (calls == D_MEMOIZE_WAYS + 1),
+        "memoize_eviction_evicts",
+        "inserting into a full set should evict one entry",
+        _counter) && result;
+
+    // test 3: the referenced key survived
+    value = 0;
+    d_functional_memoized_test(&value, memo);
+
+    result = d_assert_standalone(
+        calls == D_MEMOIZE_WAYS + 1,
+        "memoize_eviction_second_chance",
+        "a recently hit entry should survive eviction",
+        _counter) && result;
+
+    // test 4: results stay correct while thrashing one set
+    ok = true;
+
+    for (i = 0; i < 200; i++)
+    {
+        value = (i * 7) % 23;
+        ok    = ( d_functional_memoized_test(&value, memo) ==
+                  ((value % 2) == 0) ) && ok;
+    }
+
+    d_functional_memoize_stats(memo, &stats);
+
+    result = d_assert_standalone(
+        ok && (stats.entries == D_MEMOIZE_WAYS),
+        "memoize_eviction_correct",
+        "results should stay correct under eviction",
+        _counter) && result;
+
+    d_functional_memoize_free(memo);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_memoize_custom_key
+  Tests custom hashers and key equality with pointer keys.
+  Tests the following:
+  - byte comparison treats equal strings at different addresses as
+    different keys
+  - a string equality makes them share one cache entry
+*/
+bool
+d_tests_sa_memoize_custom_key
+(
+    struct d_test_counter* _counter
+)
+{
+    bool              result;
+    struct d_memoize* memo;
+    char              first[8];
+    char              second[8];
+    const char*       key;
+    int               calls;
+
+    result = true;
+    calls  = 0;
+
+    memcpy(first, "banana", 7);
+    memcpy(second, "banana", 7);
+
+    memo = d_functional_memoize_predicate(memo_counted_has_vowel,
+                                          &calls,
+                                          sizeof(const char*),
+                                          memo_hash_string,
+                                          NULL,
+                                          16,
+                                          0);
+
+    if (!memo)
+    {
+        return d_assert_standalone(false,
+                                   "memoize_custom_key_alloc",
+                                   "memo allocation failed",
+                                   _counter);
+    }
+
+    // test 1: byte comparison of the pointers
+    key = first;
+    d_functional_memoized_test(&key, memo);
+    key = second;
+    d_functional_memoized_test(&key, memo);
+
+    result = d_assert_standalone(
+        calls == 2,
+        "memoize_custom_key_bytes",
+        "distinct pointers should be distinct keys by default",
+        _counter) && result;
+
+    // test 2: string equality
+    d_functional_memoize_clear(memo);
+    d_functional_memoize_set_equality(memo, memo_equal_string, NULL);
+    calls = 0;
+
+    key = first;
+    d_functional_memoized_test(&key, memo);
+    key = second;
+
+    result = d_assert_standalone(
+        (d_functional_memoized_test(&key, memo)) &&
+        (calls == 1),
+        "memoize_custom_key_equality",
+        "equal strings should share one cache entry",
+        _counter) && result;
+
+    d_functional_memoize_free(memo);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_memoize_sharded
+  Tests a sharded memo.
+  Tests the following:
+  - results are correct and cached across shards
+  - entries spread over more than one shard
+*/
+bool
+d_tests_sa_memoize_sharded
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                   result;
+    struct d_memoize*      memo;
+    struct d_memoize_stats stats;
+    size_t                 used_shards;
+    size_t                 shard;
+    size_t                 slot;
+    size_t                 first;
+    size_t                 last;
+    int                    calls;
+    int                    value;
+    int                    i;
+    bool                   ok;
+    bool                   used;
+
+    result = true;
+    calls  = 0;
+
+    memo = d_functional_memoize_predicate(memo_counted_is_even,
+                                          &calls,
+                                          sizeof(int),
+                                          NULL,
+                                          NULL,
+                                          256,
+                                          4);
+
+    if (!memo)
+    {
+        return d_assert_standalone(false,
+                                   "memoize_sharded_alloc",
+                                   "memo allocation failed",
+                                   _counter);
+    }
+
+    // test 1: correct and cached
+    ok = true;
+
+    for (i = 0; i < 64; i++)
+    {
+        value = i % 32;
+        ok    = ( d_functional_memoized_test(&value, memo) ==
+                  ((value % 2) == 0) ) && ok;
+    }
+
+    d_functional_memoize_stats(memo, &stats);
+
+    result = d_assert_standalone(
+        ok                   &&
+        (calls == 32)        &&
+        (stats.misses == 32) &&
+        (stats.hits == 32),
+        "memoize_sharded_cached",
+        "sharded memo should cache each key once",
+        _counter) && result;
+
+    // test 2: entries spread over shards
+    used_shards = 0;
+
+    for (shard = 0; shard < memo->shard_count; shard++)
+    {
+        first = memo->shards[shard].first_set * D_MEMOIZE_WAYS;
+        last  = first + (memo->sets_per_shard * D_MEMOIZE_WAYS);
+        used  = false;
+
+        for (slot = first; slot < last; slot++)
+        {
+            used = used || (memo->flags[slot] != 0);
+        }
+
+        used_shards += (used) ? 1 : 0;
+    }
+
+    result = d_assert_standalone(
+        used_shards > 1,
+        "memoize_sharded_spread",
+        "keys should spread over more than one shard",
+        _counter) && result;
+
+    d_functional_memoize_free(memo);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_memoize_eval_all
+  Aggregation function that runs all evaluation tests.
+*/
+bool
+d_tests_sa_memoize_eval_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Memoized Evaluation\n");
+    printf("  -----------------------------\n");
+
+    result = d_tests_sa_memoized_test(_counter) && result;
+    result = d_tests_sa_memoized_apply(_counter) && result;
+    result = d_tests_sa_memoize_eviction(_counter) && result;
+    result = d_tests_sa_memoize_custom_key(_counter) && result;
+    result = d_tests_sa_memoize_sharded(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,166 @@
+/******************************************************************************
+* djinterp [test]                                    memoize_tests_sa_helpers.h
+*
+*   Shared helper functions used across memoize test files. The wrapped
+* functions count their calls through their context so that tests can tell
+* cache hits from misses. All helpers are declared static inline so each
+* translation unit gets its own copy without linker conflicts.
+*
+*
+* path:      \tests\functional\memoize_tests_sa_helpers.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_TESTS_MEMOIZE_SA_HELPERS_
+#define DJINTERP_TESTS_MEMOIZE_SA_HELPERS_ 1
+
+#include <string.h>
+
+
+// memo_counted_is_even
+//   helper: predicate returning true for even ints; increments the int
+// call counter provided through _context.
+static inline bool
+memo_counted_is_even
+(
+    const void* _element,
+    void*       _context
+)
+{
+    if (_context)
+    {
+        (*(int*)_context)++;
+    }
+
+    return ((*(const int*)_element % 2) == 0);
+}
+
+// memo_counted_square
+//   helper: transformer squaring an int into a long long; increments the
+// int call counter provided through _context.
+static inline bool
+memo_counted_square
+(
+    const void* _input,
+    void*       _output,
+    void*       _context
+)
+{
+    long long value;
+
+    if (_context)
+    {
+        (*(int*)_context)++;
+    }
+
+    value                = (long long)*(const int*)_input;
+    *(long long*)_output = value * value;
+
+    return true;
+}
+
+// memo_counted_fail_negative
+//   helper: transformer doubling an int, failing for negative inputs;
+// increments the int call counter provided through _context.
+static inline bool
+memo_counted_fail_negative
+(
+    const void* _input,
+    void*       _output,
+    void*       _context
+)
+{
+    if (_context)
+    {
+        (*(int*)_context)++;
+    }
+
+    if (*(const int*)_input < 0)
+    {
+        return false;
+    }
+
+    *(int*)_output = *(const int*)_input * 2;
+
+    return true;
+}
+
+// memo_hash_zero
+//   helper: degenerate hasher mapping every key to 0, forcing all keys
+// into the same set.
+static inline size_t
+memo_hash_zero
+(
+    const void* _element,
+    void*       _context
+)
+{
+    (void)_element;
+    (void)_context;
+
+    return 0;
+}
+
+// memo_hash_string
+//   helper: djb2 hash of the string a `const char*` key points to.
+static inline size_t
+memo_hash_string
+(
+    const void* _element,
+    void*       _context
+)
+{
+    const char* str;
+    size_t      hash;
+
+    (void)_context;
+
+    str  = *(const char* const*)_element;
+    hash = 5381;
+
+    while (*str)
+    {
+        hash = (hash * 33) + (unsigned char)*str++;
+    }
+
+    return hash;
+}
+
+// memo_equal_string
+//   helper: equality of the strings two `const char*` keys point to.
+static inline bool
+memo_equal_string
+(
+    const void* _element1,
+    const void* _element2,
+    void*       _context
+)
+{
+    (void)_context;
+
+    return (strcmp(*(const char* const*)_element1,
+                   *(const char* const*)_element2) == 0);
+}
+
+// memo_counted_has_vowel
+//   helper: predicate returning true if the string a `const char*` key
+// points to contains a vowel; increments the int call counter provided
+// through _context.
+static inline bool
+memo_counted_has_vowel
+(
+    const void* _element,
+    void*       _context
+)
+{
+    if (_context)
+    {
+        (*(int*)_context)++;
+    }
+
+    return (strpbrk(*(const char* const*)_element, "aeiou") != NULL);
+}
+
+
+#endif  // DJINTERP_TESTS_MEMOIZE_SA_HELPERS_
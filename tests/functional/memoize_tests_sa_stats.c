@@ -0,0 +1,227 @@
+#include ".\memoize_tests_sa.h"
+#include ".\memoize_tests_sa_helpers.h"
+
+
+/*
+d_tests_sa_memoize_stats
+  Tests the d_functional_memoize_stats function.
+  Tests the following:
+  - NULL parameter rejection
+  - hits, misses, and entries after a known access sequence
+*/
+bool
+d_tests_sa_memoize_stats
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                   result;
+    struct d_memoize*      memo;
+    struct d_memoize_stats stats;
+    int                    calls;
+    int                    value;
+    int                    i;
+
+    result = true;
+    calls  = 0;
+
+    memo = d_functional_memoize_predicate(memo_counted_is_even,
+                                          &calls,
+                                          sizeof(int),
+                                          NULL,
+                                          NULL,
+                                          64,
+                                          0);
+
+    // test 1: NULL parameters
+    result = d_assert_standalone(
+        (!d_functional_memoize_stats(NULL, &stats)) &&
+        (!d_functional_memoize_stats(memo, NULL)),
+        "memoize_stats_null_params",
+        "NULL parameters should return false",
+        _counter) && result;
+
+    if (!memo)
+    {
+        return result;
+    }
+
+    // 5 distinct keys, each looked up 3 times
+    for (i = 0; i < 15; i++)
+    {
+        value = i % 5;
+        d_functional_memoized_test(&value, memo);
+    }
+
+    // test 2: counters
+    result = d_assert_standalone(
+        (d_functional_memoize_stats(memo, &stats)) &&
+        (stats.misses == 5)                        &&
+        (stats.hits == 10)                         &&
+        (stats.entries == 5)                       &&
+        (stats.evictions == 0)                     &&
+        (calls == 5),
+        "memoize_stats_counters",
+        "5 keys looked up 3 times should give 5 misses and 10 hits",
+        _counter) && result;
+
+    d_functional_memoize_free(memo);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_memoize_clear
+  Tests the d_functional_memoize_clear function.
+  Tests the following:
+  - NULL memo is a no-op
+  - entries and counters are reset
+  - keys are recomputed after clearing
+*/
+bool
+d_tests_sa_memoize_clear
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                   result;
+    struct d_memoize*      memo;
+    struct d_memoize_stats stats;
+    int                    calls;
+    int                    value;
+
+    result = true;
+    calls  = 0;
+    value  = 2;
+
+    // test 1: NULL memo
+    d_functional_memoize_clear(NULL);
+
+    result = d_assert_standalone(
+        true,
+        "memoize_clear_null",
+        "clearing NULL should not crash",
+        _counter) && result;
+
+    memo = d_functional_memoize_predicate(memo_counted_is_even,
+                                          &calls,
+                                          sizeof(int),
+                                          NULL,
+                                          NULL,
+                                          64,
+                                          2);
+
+    if (!memo)
+    {
+        return result;
+    }
+
+    d_functional_memoized_test(&value, memo);
+    d_functional_memoized_test(&value, memo);
+    d_functional_memoize_clear(memo);
+
+    // test 2: reset
+    result = d_assert_standalone(
+        (d_functional_memoize_stats(memo, &stats)) &&
+        (stats.entries == 0)                       &&
+        (stats.hits == 0)                          &&
+        (stats.misses == 0),
+        "memoize_clear_reset",
+        "clearing should drop entries and reset counters",
+        _counter) && result;
+
+    // test 3: recomputed
+    result = d_assert_standalone(
+        (d_functional_memoized_test(&value, memo)) &&
+        (calls == 2),
+        "memoize_clear_recompute",
+        "keys should be recomputed after clearing",
+        _counter) && result;
+
+    d_functional_memoize_free(memo);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_memoize_free
+  Tests the d_functional_memoize_free function.
+  Tests the following:
+  - NULL memo is a no-op
+  - unsharded and sharded memos free without error
+*/
+bool
+d_tests_sa_memoize_free
+(
+    struct d_test_counter* _counter
+)
+{
+    bool              result;
+    struct d_memoize* memo;
+
+    result = true;
+
+    // test 1: NULL
+    d_functional_memoize_free(NULL);
+
+    result = d_assert_standalone(
+        true,
+        "memoize_free_null",
+        "freeing NULL should not crash",
+        _counter) && result;
+
+    // test 2: unsharded and sharded
+    memo = d_functional_memoize_predicate(memo_counted_is_even,
+                                          NULL,
+                                          sizeof(int),
+                                          NULL,
+                                          NULL,
+                                          8,
+                                          0);
+    d_functional_memoize_free(memo);
+
+    memo = d_functional_memoize_transformer(memo_counted_square,
+                                            NULL,
+                                            sizeof(int),
+                                            sizeof(long long),
+                                            NULL,
+                                            NULL,
+                                            8,
+                                            8);
+    d_functional_memoize_free(memo);
+
+    result = d_assert_standalone(
+        true,
+        "memoize_free_valid",
+        "valid memos should free without error",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_memoize_stats_all
+  Aggregation function that runs all statistics and cleanup tests.
+*/
+bool
+d_tests_sa_memoize_stats_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Statistics and Cleanup\n");
+    printf("  --------------------------------\n");
+
+    result = d_tests_sa_memoize_stats(_counter) && result;
+    result = d_tests_sa_memoize_clear(_counter) && result;
+    result = d_tests_sa_memoize_free(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,28 @@
+#include ".\numeric_tests_sa.h"
+
+
+/*
+d_tests_sa_numeric_run_all
+  Module-level aggregation function that runs all numeric tests.
+  Executes tests for all categories:
+  - Integer and floating-point sums
+  - Minimum, maximum, and extremum positions
+  - Mean and variance
+*/
+bool
+d_tests_sa_numeric_run_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    // run all test categories
+    result = d_tests_sa_numeric_sum_all(_counter)     && result;
+    result = d_tests_sa_numeric_extrema_all(_counter) && result;
+    result = d_tests_sa_numeric_moments_all(_counter) && result;
+
+    return result;
+}
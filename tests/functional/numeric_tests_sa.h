@@ -0,0 +1,67 @@
+/******************************************************************************
+* djinterp [test]                                            numeric_tests_sa.h
+*
+*   Unit test declarations for `numeric.h` module.
+*   Provides testing of the typed numeric reductions: integer and
+* floating-point sums (fast, pairwise, and compensated), minimum / maximum,
+* extremum positions, mean, and variance. Array lengths are chosen to cover
+* the vector body as well as the scalar tails of every kernel.
+*
+*
+* path:      \tests\functional\numeric_tests_sa.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_TESTS_NUMERIC_SA_
+#define DJINTERP_TESTS_NUMERIC_SA_ 1
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "..\..\inc\djinterp.h"
+#include "..\..\inc\test\test_standalone.h"
+#include "..\..\inc\functional\numeric.h"
+
+
+/******************************************************************************
+ * I. SUM TESTS
+ *****************************************************************************/
+bool d_tests_sa_numeric_sum_integer(struct d_test_counter* _counter);
+bool d_tests_sa_numeric_sum_float(struct d_test_counter* _counter);
+bool d_tests_sa_numeric_sum_accuracy(struct d_test_counter* _counter);
+
+// I.   aggregation function
+bool d_tests_sa_numeric_sum_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * II. EXTREMA TESTS
+ *****************************************************************************/
+bool d_tests_sa_numeric_minmax_i32(struct d_test_counter* _counter);
+bool d_tests_sa_numeric_minmax_wide(struct d_test_counter* _counter);
+bool d_tests_sa_numeric_minmax_f64(struct d_test_counter* _counter);
+bool d_tests_sa_numeric_argminmax(struct d_test_counter* _counter);
+
+// II.  aggregation function
+bool d_tests_sa_numeric_extrema_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * III. MOMENT TESTS
+ *****************************************************************************/
+bool d_tests_sa_numeric_mean(struct d_test_counter* _counter);
+bool d_tests_sa_numeric_variance(struct d_test_counter* _counter);
+
+// III. aggregation function
+bool d_tests_sa_numeric_moments_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * MODULE-LEVEL AGGREGATION
+ *****************************************************************************/
+bool d_tests_sa_numeric_run_all(struct d_test_counter* _counter);
+
+
+#endif  // DJINTERP_TESTS_NUMERIC_SA_
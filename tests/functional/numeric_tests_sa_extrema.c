@@ -0,0 +1,316 @@
+#include ".\numeric_tests_sa.h"
+
+
+/*
+d_tests_sa_numeric_minmax_i32
+  Tests the int32_t extrema.
+  Tests the following:
+  - NULL pointers / empty input are rejected
+  - min, max, and minmax match a naive scan for every length up to 40 and
+    every position of the extremum
+*/
+bool
+d_tests_sa_numeric_minmax_i32
+(
+    struct d_test_counter* _counter
+)
+{
+    bool    result;
+    int32_t values[40];
+    int32_t min;
+    int32_t max;
+    int32_t mm_min;
+    int32_t mm_max;
+    size_t  n;
+    size_t  p;
+    size_t  i;
+    bool    ok;
+
+    result = true;
+    min    = 0;
+    max    = 0;
+
+    // test 1: rejection
+    result = d_assert_standalone(
+        (!d_functional_min_i32(NULL, 3, &min))             &&
+        (!d_functional_min_i32(values, 0, &min))           &&
+        (!d_functional_max_i32(values, 3, NULL))           &&
+        (!d_functional_minmax_i32(values, 3, &min, NULL)),
+        "numeric_minmax_i32_rejection",
+        "NULL pointers or empty input should be rejected",
+        _counter) && result;
+
+    // test 2: every length and extremum position
+    ok = true;
+
+    for (n = 1; n <= 40; n++)
+    {
+        for (p = 0; p < n; p++)
+        {
+            for (i = 0; i < n; i++)
+            {
+                values[i] = (int32_t)((i * 37) % 11) - 5;
+            }
+
+            values[p]           = -1000;
+            values[(p + 1) % n] = (n > 1) ? 1000 : -1000;
+
+            ok = (d_functional_min_i32(values, n, &min))                &&
+                 (d_functional_max_i32(values, n, &max))                &&
+                 (d_functional_minmax_i32(values, n, &mm_min, &mm_max)) &&
+                 (min == -1000)                                         &&
+                 (max == ((n > 1) ? 1000 : -1000))                      &&
+                 (mm_min == min)                                        &&
+                 (mm_max == max)                                        &&
+                 ok;
+        }
+    }
+
+    result = d_assert_standalone(
+        ok,
+        "numeric_minmax_i32_positions",
+        "extrema should be found at every position and length",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_numeric_minmax_wide
+  Tests the int64_t and size_t extrema.
+  Tests the following:
+  - values beyond 32 bits
+  - size_t extremes
+*/
+bool
+d_tests_sa_numeric_minmax_wide
+(
+    struct d_test_counter* _counter
+)
+{
+    bool    result;
+    int64_t wide[7];
+    size_t  sizes[5];
+    int64_t min64;
+    int64_t max64;
+    size_t  min_size;
+    size_t  max_size;
+
+    result   = true;
+    wide[0]  = 3;
+    wide[1]  = INT64_C(-9000000000);
+    wide[2]  = 17;
+    wide[3]  = INT64_C(9000000000);
+    wide[4]  = 0;
+    wide[5]  = -1;
+    wide[6]  = 2;
+    sizes[0] = 10;
+    sizes[1] = SIZE_MAX;
+    sizes[2] = 0;
+    sizes[3] = 7;
+    sizes[4] = 3;
+
+    // test 1: int64
+    result = d_assert_standalone(
+        (d_functional_min_i64(wide, 7, &min64))             &&
+        (min64 == INT64_C(-9000000000))                     &&
+        (d_functional_max_i64(wide, 7, &max64))             &&
+        (max64 == INT64_C(9000000000))                      &&
+        (d_functional_minmax_i64(wide, 3, &min64, &max64))  &&
+        (min64 == INT64_C(-9000000000))                     &&
+        (max64 == 17),
+        "numeric_minmax_i64",
+        "int64 extrema should handle values beyond 32 bits",
+        _counter) && result;
+
+    // test 2: size_t
+    result = d_assert_standalone(
+        (d_functional_min_size(sizes, 5, &min_size))                &&
+        (min_size == 0)                                             &&
+        (d_functional_max_size(sizes, 5, &max_size))                &&
+        (max_size == SIZE_MAX)                                      &&
+        (d_functional_minmax_size(sizes, 1, &min_size, &max_size))  &&
+        (min_size == 10)                                            &&
+        (max_size == 10),
+        "numeric_minmax_size",
+        "size_t extrema should handle the full range",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_numeric_minmax_f64
+  Tests the double extrema.
+  Tests the following:
+  - NULL pointers / empty input are rejected
+  - min, max, and minmax for every length up to 20, including negative
+    values and the vector tail
+*/
+bool
+d_tests_sa_numeric_minmax_f64
+(
+    struct d_test_counter* _counter
+)
+{
+    bool   result;
+    double values[20];
+    double min;
+    double max;
+    double mm_min;
+    double mm_max;
+    double expected_min;
+    double expected_max;
+    size_t n;
+    size_t i;
+    bool   ok;
+
+    result = true;
+
+    for (i = 0; i < 20; i++)
+    {
+        values[i] = (double)((i * 7) % 13) - 6.5;
+    }
+
+    // test 1: rejection
+    result = d_assert_standalone(
+        (!d_functional_min_f64(NULL, 3, &min))              &&
+        (!d_functional_max_f64(values, 0, &max))            &&
+        (!d_functional_minmax_f64(values, 3, NULL, &max)),
+        "numeric_minmax_f64_rejection",
+        "NULL pointers or empty input should be rejected",
+        _counter) && result;
+
+    // test 2: every length
+    ok = true;
+
+    for (n = 1; n <= 20; n++)
+    {
+        expected_min = values[0];
+        expected_max = values[0];
+
+        for (i = 1; i < n; i++)
+        {
+            expected_min = (values[i] < expected_min) ? values[i]
+                                                      : expected_min;
+            expected_max = (values[i] > expected_max) ? values[i]
+                                                      : expected_max;
+        }
+
+        ok = (d_functional_min_f64(values, n, &min))                  &&
+             (d_functional_max_f64(values, n, &max))                  &&
+             (d_functional_minmax_f64(values, n, &mm_min, &mm_max))   &&
+             (min == expected_min)                                    &&
+             (max == expected_max)                                    &&
+             (mm_min == expected_min)                                 &&
+             (mm_max == expected_max)                                 &&
+             ok;
+    }
+
+    result = d_assert_standalone(
+        ok,
+        "numeric_minmax_f64_lengths",
+        "double extrema should match a naive scan for every length",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_numeric_argminmax
+  Tests the extremum position functions.
+  Tests the following:
+  - NULL pointers / empty input are rejected
+  - the first of several equal extrema is reported
+  - extremum in the scalar tail
+*/
+bool
+d_tests_sa_numeric_argminmax
+(
+    struct d_test_counter* _counter
+)
+{
+    bool    result;
+    int32_t ints[11];
+    double  doubles[9];
+    size_t  index;
+    size_t  i;
+
+    result = true;
+    index  = 99;
+
+    for (i = 0; i < 11; i++)
+    {
+        ints[i] = 5;
+    }
+
+    for (i = 0; i < 9; i++)
+    {
+        doubles[i] = 1.5;
+    }
+
+    // test 1: rejection
+    result = d_assert_standalone(
+        (!d_functional_argmin_i32(NULL, 3, &index))   &&
+        (!d_functional_argmax_i32(ints, 0, &index))   &&
+        (!d_functional_argmin_f64(doubles, 3, NULL))  &&
+        (!d_functional_argmax_f64(NULL, 3, &index)),
+        "numeric_argminmax_rejection",
+        "NULL pointers or empty input should be rejected",
+        _counter) && result;
+
+    // test 2: first of equal extrema
+    ints[6] = -2;
+    ints[3] = -2;
+    ints[9] = 8;
+    ints[2] = 8;
+
+    result = d_assert_standalone(
+        (d_functional_argmin_i32(ints, 11, &index)) && (index == 3) &&
+        (d_functional_argmax_i32(ints, 11, &index)) && (index == 2),
+        "numeric_argminmax_i32_first",
+        "the first of equal extrema should be reported",
+        _counter) && result;
+
+    // test 3: tail and all-equal input
+    doubles[8] = -4.0;
+
+    result = d_assert_standalone(
+        (d_functional_argmin_f64(doubles, 9, &index)) && (index == 8) &&
+        (d_functional_argmax_f64(doubles, 9, &index)) && (index == 0) &&
+        (d_functional_argmin_f64(doubles, 3, &index)) && (index == 0),
+        "numeric_argminmax_f64_tail",
+        "extrema in the tail and equal inputs should be handled",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_numeric_extrema_all
+  Aggregation function that runs all extrema tests.
+*/
+bool
+d_tests_sa_numeric_extrema_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Extrema\n");
+    printf("  -----------------\n");
+
+    result = d_tests_sa_numeric_minmax_i32(_counter) && result;
+    result = d_tests_sa_numeric_minmax_wide(_counter) && result;
+    result = d_tests_sa_numeric_minmax_f64(_counter) && result;
+    result = d_tests_sa_numeric_argminmax(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,177 @@
+#include ".\numeric_tests_sa.h"
+
+
+/*
+d_tests_sa_numeric_mean
+  Tests the mean functions.
+  Tests the following:
+  - NULL pointers / empty input are rejected
+  - int32 / int64 / double means
+  - int64 mean does not overflow on large values
+*/
+bool
+d_tests_sa_numeric_mean
+(
+    struct d_test_counter* _counter
+)
+{
+    bool    result;
+    int32_t ints[5];
+    int64_t wide[4];
+    double  doubles[6];
+    double  mean;
+
+    result     = true;
+    ints[0]    = 1;
+    ints[1]    = 2;
+    ints[2]    = 3;
+    ints[3]    = 4;
+    ints[4]    = 10;
+    wide[0]    = INT64_MAX;
+    wide[1]    = INT64_MAX;
+    wide[2]    = INT64_MAX;
+    wide[3]    = INT64_MAX;
+    doubles[0] = 0.5;
+    doubles[1] = 1.5;
+    doubles[2] = 2.5;
+    doubles[3] = 3.5;
+    doubles[4] = 4.5;
+    doubles[5] = 5.5;
+
+    // test 1: rejection
+    result = d_assert_standalone(
+        (!d_functional_mean_i32(NULL, 5, &mean))    &&
+        (!d_functional_mean_i32(ints, 0, &mean))    &&
+        (!d_functional_mean_i64(wide, 4, NULL))     &&
+        (!d_functional_mean_f64(NULL, 6, &mean)),
+        "numeric_mean_rejection",
+        "NULL pointers or empty input should be rejected",
+        _counter) && result;
+
+    // test 2: values
+    result = d_assert_standalone(
+        (d_functional_mean_i32(ints, 5, &mean))     && (mean == 4.0) &&
+        (d_functional_mean_f64(doubles, 6, &mean))  && (mean == 3.0),
+        "numeric_mean_values",
+        "means should match the expected values",
+        _counter) && result;
+
+    // test 3: int64 overflow
+    result = d_assert_standalone(
+        (d_functional_mean_i64(wide, 4, &mean)) &&
+        (fabs(mean - (double)INT64_MAX) < 1.0e4),
+        "numeric_mean_i64_overflow",
+        "int64 mean should not overflow",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_numeric_variance
+  Tests the variance functions.
+  Tests the following:
+  - NULL pointers / empty input / sample variance of one element rejected
+  - population and sample variance of a known data set
+  - a large common offset does not destroy precision
+  - constant input has zero variance
+*/
+bool
+d_tests_sa_numeric_variance
+(
+    struct d_test_counter* _counter
+)
+{
+    bool    result;
+    int32_t ints[8];
+    double  doubles[8];
+    double  offset[8];
+    double  constant[5];
+    double  variance;
+    size_t  i;
+
+    result  = true;
+    ints[0] = 2;
+    ints[1] = 4;
+    ints[2] = 4;
+    ints[3] = 4;
+    ints[4] = 5;
+    ints[5] = 5;
+    ints[6] = 7;
+    ints[7] = 9;
+
+    for (i = 0; i < 8; i++)
+    {
+        doubles[i] = (double)ints[i];
+        offset[i]  = 1.0e9 + (double)ints[i];
+    }
+
+    for (i = 0; i < 5; i++)
+    {
+        constant[i] = 0.1;
+    }
+
+    // test 1: rejection
+    result = d_assert_standalone(
+        (!d_functional_variance_i32(NULL, 8, false, &variance))    &&
+        (!d_functional_variance_i32(ints, 0, false, &variance))    &&
+        (!d_functional_variance_i32(ints, 1, true, &variance))     &&
+        (!d_functional_variance_f64(doubles, 8, false, NULL)),
+        "numeric_variance_rejection",
+        "invalid parameters should be rejected",
+        _counter) && result;
+
+    // test 2: known values (mean 5, squared deviations 32)
+    result = d_assert_standalone(
+        (d_functional_variance_i32(ints, 8, false, &variance))    &&
+        (variance == 4.0)                                         &&
+        (d_functional_variance_f64(doubles, 8, true, &variance))  &&
+        (fabs(variance - (32.0 / 7.0)) < 1.0e-12),
+        "numeric_variance_values",
+        "population and sample variance should match",
+        _counter) && result;
+
+    // test 3: large offset
+    result = d_assert_standalone(
+        (d_functional_variance_f64(offset, 8, false, &variance)) &&
+        (fabs(variance - 4.0) < 1.0e-6),
+        "numeric_variance_offset",
+        "a large common offset should not destroy precision",
+        _counter) && result;
+
+    // test 4: constant
+    result = d_assert_standalone(
+        (d_functional_variance_f64(constant, 5, false, &variance)) &&
+        (variance >= 0.0)                                          &&
+        (variance < 1.0e-30),
+        "numeric_variance_constant",
+        "constant input should have zero variance",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_numeric_moments_all
+  Aggregation function that runs all moment tests.
+*/
+bool
+d_tests_sa_numeric_moments_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Moments\n");
+    printf("  -----------------\n");
+
+    result = d_tests_sa_numeric_mean(_counter) && result;
+    result = d_tests_sa_numeric_variance(_counter) && result;
+
+    return result;
+}
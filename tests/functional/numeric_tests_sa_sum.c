@@ -0,0 +1,283 @@
+#include ".\numeric_tests_sa.h"
+
+
+/*
+d_tests_sa_numeric_sum_integer
+  Tests the integer sums.
+  Tests the following:
+  - NULL / empty input returns 0
+  - d_functional_sum_i32 matches a naive loop for every length up to 40,
+    including negative values
+  - d_functional_sum_i32 widens instead of overflowing 32 bits
+  - d_functional_sum_i64 and d_functional_sum_size
+*/
+bool
+d_tests_sa_numeric_sum_integer
+(
+    struct d_test_counter* _counter
+)
+{
+    bool    result;
+    int32_t values[40];
+    int32_t large[8];
+    int64_t wide[5];
+    size_t  sizes[6];
+    int64_t expected;
+    size_t  n;
+    size_t  i;
+    bool    ok;
+
+    result = true;
+
+    for (i = 0; i < 40; i++)
+    {
+        values[i] = (int32_t)((i % 3 == 0) ? -(int32_t)(i * 7) : (int32_t)i);
+    }
+
+    // test 1: NULL / empty
+    result = d_assert_standalone(
+        (d_functional_sum_i32(NULL, 4) == 0)    &&
+        (d_functional_sum_i32(values, 0) == 0)  &&
+        (d_functional_sum_i64(NULL, 4) == 0)    &&
+        (d_functional_sum_size(NULL, 4) == 0),
+        "numeric_sum_integer_empty",
+        "NULL or empty input should sum to 0",
+        _counter) && result;
+
+    // test 2: every length (vector body and scalar tail)
+    ok = true;
+
+    for (n = 1; n <= 40; n++)
+    {
+        expected = 0;
+
+        for (i = 0; i < n; i++)
+        {
+            expected += values[i];
+        }
+
+        ok = (d_functional_sum_i32(values, n) == expected) && ok;
+    }
+
+    result = d_assert_standalone(
+        ok,
+        "numeric_sum_i32_lengths",
+        "sum_i32 should match a naive loop for every length",
+        _counter) && result;
+
+    // test 3: widening
+    for (i = 0; i < 8; i++)
+    {
+        large[i] = INT32_MAX;
+    }
+
+    result = d_assert_standalone(
+        (d_functional_sum_i32(large, 8) == (int64_t)INT32_MAX * 8),
+        "numeric_sum_i32_widening",
+        "sum_i32 should accumulate in 64 bits",
+        _counter) && result;
+
+    // test 4: int64 and size_t
+    wide[0]  = INT64_C(5000000000);
+    wide[1]  = -3;
+    wide[2]  = 7;
+    wide[3]  = INT64_C(-1000000000);
+    wide[4]  = 1;
+    sizes[0] = 1;
+    sizes[1] = 2;
+    sizes[2] = 3;
+    sizes[3] = 4;
+    sizes[4] = 5;
+    sizes[5] = 6;
+
+    result = d_assert_standalone(
+        (d_functional_sum_i64(wide, 5) == INT64_C(4000000005)) &&
+        (d_functional_sum_size(sizes, 6) == 21),
+        "numeric_sum_i64_size",
+        "sum_i64 and sum_size should match the expected totals",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_numeric_sum_float
+  Tests the floating-point sums.
+  Tests the following:
+  - NULL / empty input returns 0.0
+  - d_functional_sum_f32 accumulates in double
+  - fast, pairwise, and compensated double sums agree on exactly
+    representable data for every length up to 300
+*/
+bool
+d_tests_sa_numeric_sum_float
+(
+    struct d_test_counter* _counter
+)
+{
+    bool   result;
+    float  floats[5];
+    double values[300];
+    double expected;
+    size_t n;
+    size_t i;
+    bool   ok;
+
+    result = true;
+
+    for (i = 0; i < 300; i++)
+    {
+        values[i] = (double)i * 0.5;
+    }
+
+    // test 1: NULL / empty
+    result = d_assert_standalone(
+        (d_functional_sum_f32(NULL, 3) == 0.0)               &&
+        (d_functional_sum_f64(NULL, 3) == 0.0)               &&
+        (d_functional_sum_f64(values, 0) == 0.0)             &&
+        (d_functional_sum_f64_pairwise(NULL, 3) == 0.0)      &&
+        (d_functional_sum_f64_compensated(NULL, 3) == 0.0),
+        "numeric_sum_float_empty",
+        "NULL or empty input should sum to 0.0",
+        _counter) && result;
+
+    // test 2: float accumulates in double
+    floats[0] = 16777216.0f;
+    floats[1] = 1.0f;
+    floats[2] = 1.0f;
+    floats[3] = 1.0f;
+    floats[4] = 1.0f;
+
+    result = d_assert_standalone(
+        (d_functional_sum_f32(floats, 5) == 16777220.0),
+        "numeric_sum_f32_double",
+        "sum_f32 should not lose increments below float precision",
+        _counter) && result;
+
+    // test 3: all double sums on exact data
+    ok = true;
+
+    for (n = 1; n <= 300; n++)
+    {
+        expected = 0.25 * (double)n * (double)(n - 1);
+
+        ok = (d_functional_sum_f64(values, n) == expected)              &&
+             (d_functional_sum_f64_pairwise(values, n) == expected)     &&
+             (d_functional_sum_f64_compensated(values, n) == expected)  &&
+             ok;
+    }
+
+    result = d_assert_standalone(
+        ok,
+        "numeric_sum_f64_lengths",
+        "all double sums should be exact on representable data",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_numeric_sum_accuracy
+  Tests the accuracy of the compensated and pairwise sums.
+  Tests the following:
+  - compensated sum recovers small terms absorbed by a large one
+  - pairwise sum of many equal inexact terms is closer than a naive loop
+*/
+bool
+d_tests_sa_numeric_sum_accuracy
+(
+    struct d_test_counter* _counter
+)
+{
+    bool    result;
+    double  cancel[4];
+    double* tenths;
+    size_t  count;
+    size_t  i;
+    double  naive;
+    double  pairwise;
+    double  exact;
+
+    result = true;
+
+    // test 1: catastrophic cancellation
+    cancel[0] = 1.0;
+    cancel[1] = 1.0e100;
+    cancel[2] = 1.0;
+    cancel[3] = -1.0e100;
+
+    result = d_assert_standalone(
+        (d_functional_sum_f64_compensated(cancel, 4) == 2.0),
+        "numeric_sum_compensated_cancellation",
+        "compensated sum should keep terms absorbed by a large value",
+        _counter) && result;
+
+    // test 2: pairwise error growth
+    count  = 1000000;
+    tenths = malloc(count * sizeof(double));
+
+    if (!tenths)
+    {
+        return result;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        tenths[i] = 0.1;
+    }
+
+    naive = 0.0;
+
+    for (i = 0; i < count; i++)
+    {
+        naive += tenths[i];
+    }
+
+    exact    = 100000.0;
+    pairwise = d_functional_sum_f64_pairwise(tenths, count);
+
+    result = d_assert_standalone(
+        (fabs(pairwise - exact) < fabs(naive - exact)) &&
+        (fabs(pairwise - exact) < 1.0e-6),
+        "numeric_sum_pairwise_accuracy",
+        "pairwise sum should be more accurate than a naive loop",
+        _counter) && result;
+
+    result = d_assert_standalone(
+        (fabs(d_functional_sum_f64_compensated(tenths, count) - exact) <
+             1.0e-9),
+        "numeric_sum_compensated_accuracy",
+        "compensated sum should be accurate to the last bits",
+        _counter) && result;
+
+    free(tenths);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_numeric_sum_all
+  Aggregation function that runs all sum tests.
+*/
+bool
+d_tests_sa_numeric_sum_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Sums\n");
+    printf("  --------------\n");
+
+    result = d_tests_sa_numeric_sum_integer(_counter) && result;
+    result = d_tests_sa_numeric_sum_float(_counter) && result;
+    result = d_tests_sa_numeric_sum_accuracy(_counter) && result;
+
+    return result;
+}
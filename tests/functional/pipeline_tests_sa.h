@@ -28,16 +28,25 @@
 // i.    pipeline creation tests
 bool d_tests_sa_pipeline_begin(struct d_test_counter* _test_info);
 bool d_tests_sa_pipeline_begin_copy(struct d_test_counter* _test_info);
+bool d_tests_sa_pipeline_begin_in_place(struct d_test_counter* _test_info);
 bool d_tests_sa_pipeline_creation_all(struct d_test_counter* _test_info);
 
 // ii.   pipeline operation tests (chainable)
 bool d_tests_sa_pipeline_map(struct d_test_counter* _test_info);
+bool d_tests_sa_pipeline_map_to(struct d_test_counter* _test_info);
 bool d_tests_sa_pipeline_filter(struct d_test_counter* _test_info);
 bool d_tests_sa_pipeline_fold(struct d_test_counter* _test_info);
+bool d_tests_sa_pipeline_fold_multi(struct d_test_counter* _test_info);
 bool d_tests_sa_pipeline_for_each(struct d_test_counter* _test_info);
 bool d_tests_sa_pipeline_take(struct d_test_counter* _test_info);
 bool d_tests_sa_pipeline_skip(struct d_test_counter* _test_info);
+bool d_tests_sa_pipeline_flat_map(struct d_test_counter* _test_info);
+bool d_tests_sa_pipeline_zip(struct d_test_counter* _test_info);
+bool d_tests_sa_pipeline_chunk(struct d_test_counter* _test_info);
+bool d_tests_sa_pipeline_window(struct d_test_counter* _test_info);
+bool d_tests_sa_pipeline_scan(struct d_test_counter* _test_info);
 bool d_tests_sa_pipeline_chaining(struct d_test_counter* _test_info);
+bool d_tests_sa_pipeline_in_place(struct d_test_counter* _test_info);
 bool d_tests_sa_pipeline_operations_all(struct d_test_counter* _test_info);
 
 // iii.  pipeline finalization tests
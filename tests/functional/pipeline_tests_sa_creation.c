@@ -26,6 +26,25 @@ test_helper_double_int
 }
 
 
+/******************************************************************************
+ * TEST HELPER: widening transformer (int to double)
+ *****************************************************************************/
+static bool
+test_helper_int_to_double
+(
+    const void* _input,
+    void*       _output,
+    void*       _context
+)
+{
+    (void)_context;
+
+    *(double*)_output = (double)(*(const int*)_input);
+
+    return true;
+}
+
+
 /*
 d_tests_sa_pipeline_begin
   Tests d_functional_pipeline_begin for wrapping mutable data.
@@ -352,12 +371,111 @@ d_tests_sa_pipeline_begin_copy
 }
 
 
+/*
+d_tests_sa_pipeline_begin_in_place
+  Tests d_functional_pipeline_begin_in_place for writing into caller data.
+  Tests the following:
+  - valid parameters produce a pipeline that owns, but has lent, the data
+  - a map writes straight into the caller's array
+  - end returns the caller's array, and freeing the pipeline leaves it
+  - a widening map_to moves the data to a heap buffer the caller then owns
+  - NULL data returns error pipeline
+*/
+bool
+d_tests_sa_pipeline_begin_in_place
+(
+    struct d_test_counter* _test_info
+)
+{
+    struct d_functional_pipeline pipe;
+    int                          data[] = { 1, 2, 3, 4 };
+    int*                         ended;
+    double*                      widened;
+    size_t                       count;
+    bool                         all_passed;
+
+    all_passed = true;
+
+    // ---- valid parameters ----
+    pipe = d_functional_pipeline_begin_in_place(data, 4, sizeof(int));
+
+    all_passed &= d_assert_standalone(
+        (pipe.error_code == 0)     &&
+        (pipe.owns_data == true)   &&
+        (pipe.data == (void*)data) &&
+        (pipe.lent == (void*)data) &&
+        (pipe.count == 4),
+        "begin_in_place: valid params wrap the lent data",
+        "pipeline should own, but not free, the caller's data",
+        _test_info);
+
+    // ---- map writes into the caller's array ----
+    pipe  = d_functional_pipeline_map(pipe, test_helper_double_int, NULL);
+    ended = (int*)d_functional_pipeline_end(pipe, &count);
+
+    all_passed &= d_assert_standalone(
+        (ended == data)  &&
+        (count == 4)     &&
+        (data[0] == 2)   &&
+        (data[3] == 8),
+        "begin_in_place: map writes into the caller's array",
+        "end should return the caller's array, doubled in place",
+        _test_info);
+
+    // ---- free leaves the caller's array alone ----
+    pipe = d_functional_pipeline_begin_in_place(data, 4, sizeof(int));
+    pipe = d_functional_pipeline_map(pipe, test_helper_double_int, NULL);
+    d_functional_pipeline_free(&pipe);
+
+    all_passed &= d_assert_standalone(
+        (pipe.data == NULL) &&
+        (data[1] == 8),
+        "begin_in_place: free does not free the caller's array",
+        "the caller's array should still hold the mapped values",
+        _test_info);
+
+    // ---- widening map_to moves to the heap ----
+    pipe    = d_functional_pipeline_begin_in_place(data, 4, sizeof(int));
+    pipe    = d_functional_pipeline_map_to(pipe,
+                                           sizeof(double),
+                                           test_helper_int_to_double,
+                                           NULL);
+    widened = (double*)d_functional_pipeline_end(pipe, &count);
+
+    all_passed &= d_assert_standalone(
+        (widened)                       &&
+        ((void*)widened != (void*)data) &&
+        (count == 4)                    &&
+        (widened[0] == 4.0)             &&
+        (widened[3] == 16.0),
+        "begin_in_place: widening map_to moves to a heap buffer",
+        "end should return a new buffer the caller owns",
+        _test_info);
+
+    d_functional_free(widened);
+
+    // ---- NULL data ----
+    pipe = d_functional_pipeline_begin_in_place(NULL, 4, sizeof(int));
+
+    all_passed &= d_assert_standalone(
+        (pipe.error_code == -1) &&
+        (pipe.data == NULL)     &&
+        (pipe.owns_data == false),
+        "begin_in_place: NULL data returns error",
+        "error_code should be -1 for NULL data",
+        _test_info);
+
+    return all_passed;
+}
+
+
 /*
 d_tests_sa_pipeline_creation_all
   Runs all pipeline creation tests.
   Tests the following:
   - d_functional_pipeline_begin
   - d_functional_pipeline_begin_copy
+  - d_functional_pipeline_begin_in_place
 */
 bool
 d_tests_sa_pipeline_creation_all
@@ -371,6 +489,7 @@ d_tests_sa_pipeline_creation_all
 
     all_passed &= d_tests_sa_pipeline_begin(_test_info);
     all_passed &= d_tests_sa_pipeline_begin_copy(_test_info);
+    all_passed &= d_tests_sa_pipeline_begin_in_place(_test_info);
 
     return all_passed;
 }
@@ -127,7 +127,7 @@ d_tests_sa_pipeline_end
             _test_info);
 
         // caller is responsible for freeing
-        free(mapped_data);
+        d_functional_free(mapped_data);
     }
 
     // ---- end with begin_copy: caller owns the copy ----
@@ -154,7 +154,7 @@ d_tests_sa_pipeline_end
             "copied data should match source",
             _test_info);
 
-        free(copy_data);
+        d_functional_free(copy_data);
     }
 
     // ---- end after take: reduced count ----
@@ -281,7 +281,7 @@ d_tests_sa_pipeline_free
     all_passed &= d_assert_standalone(
         true,
         "free: NULL pointer is safe no-op",
-        "calling free(NULL) should not crash",
+        "calling d_functional_free(NULL) should not crash",
         _test_info);
 
     // ---- double-free safety ----
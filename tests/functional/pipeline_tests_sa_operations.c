@@ -281,6 +281,292 @@ test_helper_negate_consumer
 }
 
 
+/*
+test_helper_wide
+  Element larger than D_FUNCTIONAL_PIPELINE_SCRATCH_SIZE.
+*/
+struct test_helper_wide
+{
+    int values[20];
+};
+
+
+/*
+test_helper_bump_wide
+  Transformer: adds 1 to every value of a test_helper_wide.
+*/
+static bool
+test_helper_bump_wide
+(
+    const void* _input,
+    void*       _output,
+    void*       _context
+)
+{
+    const struct test_helper_wide* in;
+    struct test_helper_wide*       out;
+    size_t                         i;
+
+    (void)_context;
+
+    in  = (const struct test_helper_wide*)_input;
+    out = (struct test_helper_wide*)_output;
+
+    for (i = 0; i < 20; i++)
+    {
+        out->values[i] = in->values[i] + 1;
+    }
+
+    return true;
+}
+
+
+/*
+test_helper_wide_key
+  Transformer: projects a test_helper_wide onto its last value.
+*/
+static bool
+test_helper_wide_key
+(
+    const void* _input,
+    void*       _output,
+    void*       _context
+)
+{
+    (void)_context;
+
+    *(int*)_output = ((const struct test_helper_wide*)_input)->values[19];
+
+    return true;
+}
+
+
+/*
+test_helper_int_to_wide
+  Transformer: widens an int into a test_helper_wide filled with it.
+*/
+static bool
+test_helper_int_to_wide
+(
+    const void* _input,
+    void*       _output,
+    void*       _context
+)
+{
+    struct test_helper_wide* out;
+    size_t                   i;
+
+    (void)_context;
+
+    out = (struct test_helper_wide*)_output;
+
+    for (i = 0; i < 20; i++)
+    {
+        out->values[i] = *(const int*)_input;
+    }
+
+    return true;
+}
+
+
+/*
+test_helper_repeat_int
+  Expander: writes each int n times, where n is its value (capped at the
+room given).
+*/
+static bool
+test_helper_repeat_int
+(
+    const void* _input,
+    void*       _output,
+    size_t*     _count,
+    void*       _context
+)
+{
+    size_t n;
+    size_t i;
+
+    (void)_context;
+
+    n = (size_t)*(const int*)_input;
+
+    if (n > *_count)
+    {
+        n = *_count;
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        ((int*)_output)[i] = *(const int*)_input;
+    }
+
+    *_count = n;
+
+    return true;
+}
+
+
+/*
+test_helper_overclaim_expander
+  Expander: reports one more output than it was given room for.
+*/
+static bool
+test_helper_overclaim_expander
+(
+    const void* _input,
+    void*       _output,
+    size_t*     _count,
+    void*       _context
+)
+{
+    (void)_input;
+    (void)_output;
+    (void)_context;
+
+    *_count += 1;
+
+    return true;
+}
+
+
+/*
+test_helper_add_pair
+  Binary operation: adds two ints.
+*/
+static bool
+test_helper_add_pair
+(
+    const void* _input1,
+    const void* _input2,
+    void*       _output,
+    void*       _context
+)
+{
+    (void)_context;
+
+    *(int*)_output = *(const int*)_input1 + *(const int*)_input2;
+
+    return true;
+}
+
+
+/*
+test_helper_pair
+  struct: two ints, the output of test_helper_make_pair.
+*/
+struct test_helper_pair
+{
+    int first;
+    int second;
+};
+
+
+/*
+test_helper_make_pair
+  Binary operation: pairs two ints into a test_helper_pair.
+*/
+static bool
+test_helper_make_pair
+(
+    const void* _input1,
+    const void* _input2,
+    void*       _output,
+    void*       _context
+)
+{
+    (void)_context;
+
+    ((struct test_helper_pair*)_output)->first  = *(const int*)_input1;
+    ((struct test_helper_pair*)_output)->second = *(const int*)_input2;
+
+    return true;
+}
+
+
+/*
+test_helper_sum_run
+  Aggregator: sums a run of ints into an int.
+*/
+static bool
+test_helper_sum_run
+(
+    const void* _elements,
+    size_t      _count,
+    void*       _output,
+    void*       _context
+)
+{
+    size_t i;
+    int    sum;
+
+    (void)_context;
+
+    sum = 0;
+
+    for (i = 0; i < _count; i++)
+    {
+        sum += ((const int*)_elements)[i];
+    }
+
+    *(int*)_output = sum;
+
+    return true;
+}
+
+
+/*
+test_helper_average_run
+  Aggregator: averages a run of ints into a double.
+*/
+static bool
+test_helper_average_run
+(
+    const void* _elements,
+    size_t      _count,
+    void*       _output,
+    void*       _context
+)
+{
+    size_t i;
+    double sum;
+
+    (void)_context;
+
+    sum = 0.0;
+
+    for (i = 0; i < _count; i++)
+    {
+        sum += (double)((const int*)_elements)[i];
+    }
+
+    *(double*)_output = sum / (double)_count;
+
+    return true;
+}
+
+
+/*
+test_helper_fail_aggregator
+  Aggregator: always fails.
+*/
+static bool
+test_helper_fail_aggregator
+(
+    const void* _elements,
+    size_t      _count,
+    void*       _output,
+    void*       _context
+)
+{
+    (void)_elements;
+    (void)_count;
+    (void)_output;
+    (void)_context;
+
+    return false;
+}
+
+
 /*
 d_tests_sa_pipeline_map
   Tests d_functional_pipeline_map.
@@ -461,6 +747,137 @@ d_tests_sa_pipeline_map
 }
 
 
+/*
+d_tests_sa_pipeline_map_to
+  Tests d_functional_pipeline_map_to.
+  Tests the following:
+  - zero output size, NULL transformer, and prior errors
+  - a narrowing map over owned data runs in place
+  - later stages work on the new element size
+  - a widening map moves to a buffer of the new size
+  - a map over borrowed data leaves the caller's data untouched
+*/
+bool
+d_tests_sa_pipeline_map_to
+(
+    struct d_test_counter* _test_info
+)
+{
+    struct d_functional_pipeline pipe;
+    struct test_helper_wide      wide[5];
+    int                          data[] = { 1, 2, 3 };
+    void*                        first;
+    int*                         keys;
+    int                          sum;
+    size_t                       count;
+    size_t                       i;
+    bool                         all_passed;
+
+    all_passed = true;
+
+    for (i = 0; i < 5; i++)
+    {
+        memset(&wide[i], 0, sizeof(wide[i]));
+        wide[i].values[19] = (int)(i + 1);
+    }
+
+    // ---- validation ----
+    pipe = d_functional_pipeline_begin(data, 3, sizeof(int));
+
+    all_passed &= d_assert_standalone(
+        d_functional_pipeline_map_to(pipe, 0, test_helper_int_to_wide,
+                                     NULL).error_code == -1 &&
+        d_functional_pipeline_map_to(pipe, sizeof(int), NULL,
+                                     NULL).error_code == -1,
+        "map_to: zero size or NULL transformer returns error",
+        "error_code should be -1",
+        _test_info);
+
+    pipe.error_code = -1;
+
+    all_passed &= d_assert_standalone(
+        d_functional_pipeline_map_to(pipe, sizeof(int), test_helper_wide_key,
+                                     NULL).error_code == -1,
+        "map_to: propagates prior error",
+        "error should pass through",
+        _test_info);
+
+    // ---- narrowing, owned: in place ----
+    pipe  = d_functional_pipeline_begin_copy(wide, 5,
+                                             sizeof(struct test_helper_wide));
+    first = pipe.data;
+    pipe  = d_functional_pipeline_map_to(pipe, sizeof(int),
+                                         test_helper_wide_key, NULL);
+
+    all_passed &= d_assert_standalone(
+        pipe.error_code == 0 && pipe.data == first &&
+        pipe.element_size == sizeof(int) && pipe.count == 5 &&
+        ((int*)pipe.data)[0] == 1 && ((int*)pipe.data)[4] == 5 &&
+        pipe.spare == NULL,
+        "map_to: narrowing owned data runs in place",
+        "keys should be packed at the front of the same buffer",
+        _test_info);
+
+    pipe = d_functional_pipeline_filter(pipe, test_helper_is_even, NULL);
+    keys = (int*)d_functional_pipeline_end(pipe, &count);
+
+    all_passed &= d_assert_standalone(
+        keys == first && count == 2 && keys[0] == 2 && keys[1] == 4,
+        "map_to: later stages use the new element size",
+        "filtering the keys should keep 2 and 4",
+        _test_info);
+
+    d_functional_free(keys);
+
+    // ---- widening ----
+    pipe  = d_functional_pipeline_begin_copy(data, 3, sizeof(int));
+    first = pipe.data;
+    pipe  = d_functional_pipeline_map_to(pipe,
+                                         sizeof(struct test_helper_wide),
+                                         test_helper_int_to_wide, NULL);
+
+    all_passed &= d_assert_standalone(
+        pipe.error_code == 0 && pipe.data != first &&
+        pipe.element_size == sizeof(struct test_helper_wide) &&
+        ((struct test_helper_wide*)pipe.data)[2].values[0] == 3 &&
+        ((struct test_helper_wide*)pipe.data)[2].values[19] == 3,
+        "map_to: widening moves to a buffer of the new size",
+        "each int should fill a wide record",
+        _test_info);
+
+    sum  = 0;
+    pipe = d_functional_pipeline_map_to(pipe, sizeof(int),
+                                        test_helper_wide_key, NULL);
+    pipe = d_functional_pipeline_fold(pipe, &sum, sizeof(int),
+                                      test_helper_sum_accumulator, NULL);
+
+    all_passed &= d_assert_standalone(
+        pipe.error_code == 0 && sum == 6,
+        "map_to: widen, narrow, then fold",
+        "the keys should sum to 6",
+        _test_info);
+
+    // ---- borrowed ----
+    pipe = d_functional_pipeline_begin(wide, 5,
+                                       sizeof(struct test_helper_wide));
+    pipe = d_functional_pipeline_map_to(pipe, sizeof(int),
+                                        test_helper_wide_key, NULL);
+
+    all_passed &= d_assert_standalone(
+        pipe.error_code == 0 && pipe.owns_data &&
+        pipe.data != (void*)wide &&
+        ((int*)pipe.data)[4] == 5 &&
+        wide[0].values[19] == 1 && wide[0].values[0] == 0,
+        "map_to: borrowed data is left untouched",
+        "the keys should go to a new owned buffer",
+        _test_info);
+
+    d_functional_pipeline_free(&pipe);
+
+    return all_passed;
+}
+
+
 /*
 d_tests_sa_pipeline_filter
   Tests d_functional_pipeline_filter.
@@ -874,18 +1291,169 @@ d_tests_sa_pipeline_fold
 
 
 /*
-d_tests_sa_pipeline_for_each
-  Tests d_functional_pipeline_for_each.
+d_tests_sa_pipeline_fold_multi
+  Tests d_functional_pipeline_fold_multi.
   Tests the following:
-  - consumer is called for each element
-  - context is forwarded to consumer
-  - pipeline is returned unchanged (data, count, owns_data)
-  - consumer can modify elements in-place
-  - NULL consumer returns error
+  - sum and product computed in one pass
+  - result pipeline wraps _specs, has count _spec_count
+  - result pipeline does NOT own _specs
+  - fold_multi frees old data if owned
+  - NULL _specs / zero _spec_count returns error
+  - spec without step returns error
   - propagates prior error
+  - accumulator failure returns error
+  - empty pipeline leaves accumulators unchanged
 */
 bool
-d_tests_sa_pipeline_for_each
+d_tests_sa_pipeline_fold_multi
+(
+    struct d_test_counter* _test_info
+)
+{
+    struct d_functional_pipeline pipe;
+    struct d_functional_pipeline folded;
+    struct d_fold_spec           specs[2];
+    int                          data[] = { 1, 2, 3, 4, 5 };
+    int                          sum;
+    int                          product;
+    bool                         all_passed;
+
+    all_passed = true;
+
+    specs[0].accumulator = &sum;
+    specs[0].step        = test_helper_sum_accumulator;
+    specs[0].context     = NULL;
+    specs[1].accumulator = &product;
+    specs[1].step        = test_helper_product_accumulator;
+    specs[1].context     = NULL;
+
+    // ---- sum and product in one pass ----
+    sum     = 0;
+    product = 1;
+    pipe    = d_functional_pipeline_begin(data, 5, sizeof(int));
+    folded  = d_functional_pipeline_fold_multi(pipe, specs, 2);
+
+    all_passed &= d_assert_standalone(
+        folded.error_code == 0 && sum == 15 && product == 120,
+        "fold_multi: sum 15 and product 120 in one pass",
+        "both accumulators should receive every element",
+        _test_info);
+
+    all_passed &= d_assert_standalone(
+        folded.data == (void*)specs              &&
+        folded.count == 2                        &&
+        folded.element_size == sizeof(struct d_fold_spec),
+        "fold_multi: result wraps _specs",
+        "data should point to the spec array with count 2",
+        _test_info);
+
+    all_passed &= d_assert_standalone(
+        folded.owns_data == false,
+        "fold_multi: result does NOT own _specs",
+        "pipeline should not own caller-provided specs",
+        _test_info);
+
+    // ---- frees owned data ----
+    {
+        struct d_functional_pipeline copy_pipe;
+        int                          src[] = { 10, 20, 30 };
+
+        sum       = 0;
+        product   = 1;
+        copy_pipe = d_functional_pipeline_begin_copy(src, 3, sizeof(int));
+        folded    = d_functional_pipeline_fold_multi(copy_pipe, specs, 2);
+
+        all_passed &= d_assert_standalone(
+            folded.error_code == 0 && sum == 60 && product == 6000,
+            "fold_multi: owned data freed, results correct",
+            "10+20+30 = 60 and 10*20*30 = 6000",
+            _test_info);
+    }
+
+    // ---- NULL _specs / zero _spec_count ----
+    pipe   = d_functional_pipeline_begin(data, 5, sizeof(int));
+    folded = d_functional_pipeline_fold_multi(pipe, NULL, 2);
+
+    all_passed &= d_assert_standalone(
+        folded.error_code == -1,
+        "fold_multi: NULL specs returns error",
+        "error_code should be -1",
+        _test_info);
+
+    pipe   = d_functional_pipeline_begin(data, 5, sizeof(int));
+    folded = d_functional_pipeline_fold_multi(pipe, specs, 0);
+
+    all_passed &= d_assert_standalone(
+        folded.error_code == -1,
+        "fold_multi: zero spec count returns error",
+        "error_code should be -1",
+        _test_info);
+
+    // ---- spec without step ----
+    specs[1].step = NULL;
+    pipe          = d_functional_pipeline_begin(data, 5, sizeof(int));
+    folded        = d_functional_pipeline_fold_multi(pipe, specs, 2);
+    specs[1].step = test_helper_product_accumulator;
+
+    all_passed &= d_assert_standalone(
+        folded.error_code == -1,
+        "fold_multi: spec without step returns error",
+        "error_code should be -1",
+        _test_info);
+
+    // ---- propagates prior error ----
+    pipe            = d_functional_pipeline_begin(data, 5, sizeof(int));
+    pipe.error_code = -7;
+    folded          = d_functional_pipeline_fold_multi(pipe, specs, 2);
+
+    all_passed &= d_assert_standalone(
+        folded.error_code == -7,
+        "fold_multi: propagates prior error",
+        "error_code should stay -7",
+        _test_info);
+
+    // ---- accumulator failure ----
+    specs[1].step = test_helper_fail_accumulator;
+    pipe          = d_functional_pipeline_begin(data, 5, sizeof(int));
+    folded        = d_functional_pipeline_fold_multi(pipe, specs, 2);
+    specs[1].step = test_helper_product_accumulator;
+
+    all_passed &= d_assert_standalone(
+        folded.error_code == -1,
+        "fold_multi: accumulator failure returns error",
+        "error_code should be -1",
+        _test_info);
+
+    // ---- empty pipeline ----
+    sum     = 3;
+    product = 4;
+    pipe    = d_functional_pipeline_begin(data, 5, sizeof(int));
+    pipe    = d_functional_pipeline_take(pipe, 0);
+    folded  = d_functional_pipeline_fold_multi(pipe, specs, 2);
+
+    all_passed &= d_assert_standalone(
+        folded.error_code == 0 && sum == 3 && product == 4,
+        "fold_multi: empty pipeline keeps initial values",
+        "accumulators should be unchanged",
+        _test_info);
+
+    return all_passed;
+}
+
+
+/*
+d_tests_sa_pipeline_for_each
+  Tests d_functional_pipeline_for_each.
+  Tests the following:
+  - consumer is called for each element
+  - context is forwarded to consumer
+  - pipeline is returned unchanged (data, count, owns_data)
+  - consumer can modify elements in-place
+  - NULL consumer returns error
+  - propagates prior error
+*/
+bool
+d_tests_sa_pipeline_for_each
 (
     struct d_test_counter* _test_info
 )
@@ -1267,6 +1835,553 @@ d_tests_sa_pipeline_skip
 }
 
 
+/*
+d_tests_sa_pipeline_flat_map
+  Tests d_functional_pipeline_flat_map.
+  Tests the following:
+  - zero sizes, NULL expander, overflowing bounds, and prior errors
+  - elements expand to zero or more outputs, in order
+  - small bounded expansions over owned data run in place
+  - expansions larger than an element move to a new buffer
+  - an expander reporting too many outputs is an error
+*/
+bool
+d_tests_sa_pipeline_flat_map
+(
+    struct d_test_counter* _test_info
+)
+{
+    struct d_functional_pipeline pipe;
+    int                          data[] = { 2, 0, 1, 3 };
+    int                          pairs[] = { 1, 0, 1 };
+    void*                        first;
+    int*                         out;
+    size_t                       count;
+    bool                         all_passed;
+
+    all_passed = true;
+
+    // ---- validation ----
+    pipe = d_functional_pipeline_begin(data, 4, sizeof(int));
+
+    all_passed &= d_assert_standalone(
+        d_functional_pipeline_flat_map(pipe, 0, 3, test_helper_repeat_int,
+                                       NULL).error_code == -1 &&
+        d_functional_pipeline_flat_map(pipe, sizeof(int), 0,
+                                       test_helper_repeat_int,
+                                       NULL).error_code == -1 &&
+        d_functional_pipeline_flat_map(pipe, sizeof(int), 3, NULL,
+                                       NULL).error_code == -1 &&
+        d_functional_pipeline_flat_map(pipe, sizeof(int), SIZE_MAX,
+                                       test_helper_repeat_int,
+                                       NULL).error_code == -1,
+        "flat_map: invalid parameters return error",
+        "error_code should be -1",
+        _test_info);
+
+    pipe.error_code = -1;
+
+    all_passed &= d_assert_standalone(
+        d_functional_pipeline_flat_map(pipe, sizeof(int), 3,
+                                       test_helper_repeat_int,
+                                       NULL).error_code == -1,
+        "flat_map: propagates prior error",
+        "error should pass through",
+        _test_info);
+
+    // ---- borrowed, widening bound ----
+    pipe = d_functional_pipeline_begin(data, 4, sizeof(int));
+    pipe = d_functional_pipeline_flat_map(pipe, sizeof(int), 3,
+                                          test_helper_repeat_int, NULL);
+    out  = (int*)d_functional_pipeline_end(pipe, &count);
+
+    all_passed &= d_assert_standalone(
+        out != NULL && out != data && count == 6 &&
+        out[0] == 2 && out[1] == 2 && out[2] == 1 &&
+        out[3] == 3 && out[5] == 3 && data[0] == 2,
+        "flat_map: expands each element in order",
+        "2,0,1,3 should expand to 2,2,1,3,3,3",
+        _test_info);
+
+    d_functional_free(out);
+
+    // ---- owned, bound of one: in place ----
+    pipe  = d_functional_pipeline_begin_copy(pairs, 3, sizeof(int));
+    first = pipe.data;
+    pipe  = d_functional_pipeline_flat_map(pipe, sizeof(int), 1,
+                                           test_helper_repeat_int, NULL);
+
+    all_passed &= d_assert_standalone(
+        pipe.error_code == 0 && pipe.data == first && pipe.count == 2 &&
+        ((int*)pipe.data)[0] == 1 && ((int*)pipe.data)[1] == 1 &&
+        pipe.spare == NULL,
+        "flat_map: a bound that fits an element runs in place",
+        "zero-output elements should be dropped without a new buffer",
+        _test_info);
+
+    d_functional_pipeline_free(&pipe);
+
+    // ---- owned, larger bound: spare buffer ----
+    pipe  = d_functional_pipeline_begin_copy(data, 4, sizeof(int));
+    first = pipe.data;
+    pipe  = d_functional_pipeline_flat_map(pipe, sizeof(int), 3,
+                                           test_helper_repeat_int, NULL);
+
+    all_passed &= d_assert_standalone(
+        pipe.error_code == 0 && pipe.data != first &&
+        pipe.spare == first && pipe.count == 6,
+        "flat_map: a larger bound uses the spare buffer",
+        "the old data should become the spare",
+        _test_info);
+
+    d_functional_pipeline_free(&pipe);
+
+    // ---- expander reporting too many outputs ----
+    pipe = d_functional_pipeline_begin(data, 4, sizeof(int));
+    pipe = d_functional_pipeline_flat_map(pipe, sizeof(int), 2,
+                                          test_helper_overclaim_expander,
+                                          NULL);
+
+    all_passed &= d_assert_standalone(
+        pipe.error_code == -1 && !pipe.owns_data,
+        "flat_map: too many outputs is an error",
+        "the output buffer should be discarded",
+        _test_info);
+
+    return all_passed;
+}
+
+
+/*
+d_tests_sa_pipeline_zip
+  Tests d_functional_pipeline_zip.
+  Tests the following:
+  - NULL operation, zero size, and errors in either pipeline
+  - pairs stop at the end of the shorter pipeline
+  - combining into an element-sized output over owned data runs in place
+  - widening combinations move to a new buffer
+  - the second pipeline's owned data is released
+*/
+bool
+d_tests_sa_pipeline_zip
+(
+    struct d_test_counter* _test_info
+)
+{
+    struct d_functional_pipeline pipe;
+    struct d_functional_pipeline other;
+    struct test_helper_pair*     pairs;
+    int                          left[] = { 1, 2, 3, 4 };
+    int                          right[] = { 10, 20, 30 };
+    void*                        first;
+    bool                         all_passed;
+
+    all_passed = true;
+
+    // ---- validation ----
+    pipe  = d_functional_pipeline_begin(left, 4, sizeof(int));
+    other = d_functional_pipeline_begin(right, 3, sizeof(int));
+
+    all_passed &= d_assert_standalone(
+        d_functional_pipeline_zip(pipe, other, sizeof(int), NULL,
+                                  NULL).error_code == -1 &&
+        d_functional_pipeline_zip(pipe, other, 0, test_helper_add_pair,
+                                  NULL).error_code == -1,
+        "zip: NULL operation or zero size returns error",
+        "error_code should be -1",
+        _test_info);
+
+    // an erroring second pipeline still has its owned data released
+    other            = d_functional_pipeline_begin_copy(right, 3,
+                                                        sizeof(int));
+    other.error_code = -1;
+
+    all_passed &= d_assert_standalone(
+        d_functional_pipeline_zip(pipe, other, sizeof(int),
+                                  test_helper_add_pair,
+                                  NULL).error_code == -1,
+        "zip: propagates an error from the second pipeline",
+        "error should pass through",
+        _test_info);
+
+    // ---- owned, same size: in place ----
+    pipe  = d_functional_pipeline_begin_copy(left, 4, sizeof(int));
+    first = pipe.data;
+    other = d_functional_pipeline_begin_copy(right, 3, sizeof(int));
+    pipe  = d_functional_pipeline_zip(pipe, other, sizeof(int),
+                                      test_helper_add_pair, NULL);
+
+    all_passed &= d_assert_standalone(
+        pipe.error_code == 0 && pipe.data == first && pipe.count == 3 &&
+        ((int*)pipe.data)[0] == 11 && ((int*)pipe.data)[2] == 33,
+        "zip: element-sized sums over owned data run in place",
+        "the shorter pipeline should bound the result",
+        _test_info);
+
+    d_functional_pipeline_free(&pipe);
+
+    // ---- widening into pairs ----
+    pipe  = d_functional_pipeline_begin(right, 3, sizeof(int));
+    other = d_functional_pipeline_begin(left, 4, sizeof(int));
+    pipe  = d_functional_pipeline_zip(pipe, other,
+                                      sizeof(struct test_helper_pair),
+                                      test_helper_make_pair, NULL);
+    pairs = (struct test_helper_pair*)pipe.data;
+
+    all_passed &= d_assert_standalone(
+        pipe.error_code == 0 && pipe.owns_data && pipe.count == 3 &&
+        pipe.element_size == sizeof(struct test_helper_pair) &&
+        pairs[0].first == 10 && pairs[0].second == 1 &&
+        pairs[2].first == 30 && pairs[2].second == 3,
+        "zip: pairs two pipelines into a new type",
+        "each pair should hold the i-th elements of both",
+        _test_info);
+
+    d_functional_pipeline_free(&pipe);
+
+    // ---- the same owned buffer twice ----
+    pipe = d_functional_pipeline_begin_copy(left, 4, sizeof(int));
+
+    all_passed &= d_assert_standalone(
+        d_functional_pipeline_zip(pipe, pipe, sizeof(int),
+                                  test_helper_add_pair,
+                                  NULL).error_code == -1,
+        "zip: a pipeline cannot be zipped with itself",
+        "its buffer would be released twice",
+        _test_info);
+
+    d_functional_pipeline_free(&pipe);
+
+    return all_passed;
+}
+
+
+/*
+d_tests_sa_pipeline_chunk
+  Tests d_functional_pipeline_chunk.
+  Tests the following:
+  - zero sizes, NULL aggregator, and prior errors
+  - batches are summarized in place over owned data
+  - the last batch may be shorter
+  - a failing aggregator is an error
+*/
+bool
+d_tests_sa_pipeline_chunk
+(
+    struct d_test_counter* _test_info
+)
+{
+    struct d_functional_pipeline pipe;
+    int                          data[] = { 1, 2, 3, 4, 5, 6, 7 };
+    void*                        first;
+    bool                         all_passed;
+
+    all_passed = true;
+
+    // ---- validation ----
+    pipe = d_functional_pipeline_begin(data, 7, sizeof(int));
+
+    all_passed &= d_assert_standalone(
+        d_functional_pipeline_chunk(pipe, 0, sizeof(int),
+                                    test_helper_sum_run,
+                                    NULL).error_code == -1 &&
+        d_functional_pipeline_chunk(pipe, 3, 0, test_helper_sum_run,
+                                    NULL).error_code == -1 &&
+        d_functional_pipeline_chunk(pipe, 3, sizeof(int), NULL,
+                                    NULL).error_code == -1,
+        "chunk: invalid parameters return error",
+        "error_code should be -1",
+        _test_info);
+
+    pipe.error_code = -1;
+
+    all_passed &= d_assert_standalone(
+        d_functional_pipeline_chunk(pipe, 3, sizeof(int),
+                                    test_helper_sum_run,
+                                    NULL).error_code == -1,
+        "chunk: propagates prior error",
+        "error should pass through",
+        _test_info);
+
+    // ---- owned: in place, short last batch ----
+    pipe  = d_functional_pipeline_begin_copy(data, 7, sizeof(int));
+    first = pipe.data;
+    pipe  = d_functional_pipeline_chunk(pipe, 3, sizeof(int),
+                                        test_helper_sum_run, NULL);
+
+    all_passed &= d_assert_standalone(
+        pipe.error_code == 0 && pipe.data == first && pipe.count == 3 &&
+        ((int*)pipe.data)[0] == 6 && ((int*)pipe.data)[1] == 15 &&
+        ((int*)pipe.data)[2] == 7,
+        "chunk: batches of 3 summed in place",
+        "1..7 should give 6, 15, 7",
+        _test_info);
+
+    d_functional_pipeline_free(&pipe);
+
+    // ---- empty pipeline ----
+    pipe = d_functional_pipeline_begin(data, 7, sizeof(int));
+    pipe = d_functional_pipeline_filter(pipe, test_helper_always_false, NULL);
+    pipe = d_functional_pipeline_chunk(pipe, 3, sizeof(int),
+                                       test_helper_sum_run, NULL);
+
+    all_passed &= d_assert_standalone(
+        pipe.error_code == 0 && pipe.count == 0,
+        "chunk: an empty pipeline has no batches",
+        "count should be 0",
+        _test_info);
+
+    d_functional_pipeline_free(&pipe);
+
+    // ---- failing aggregator ----
+    pipe = d_functional_pipeline_begin(data, 7, sizeof(int));
+    pipe = d_functional_pipeline_chunk(pipe, 2, sizeof(int),
+                                       test_helper_fail_aggregator, NULL);
+
+    all_passed &= d_assert_standalone(
+        pipe.error_code == -1 && !pipe.owns_data,
+        "chunk: a failing aggregator is an error",
+        "the output buffer should be discarded",
+        _test_info);
+
+    return all_passed;
+}
+
+
+/*
+d_tests_sa_pipeline_window
+  Tests d_functional_pipeline_window.
+  Tests the following:
+  - zero sizes or step, NULL aggregator, and prior errors
+  - only full windows are summarized
+  - steps larger than one skip windows
+  - widening summaries (averages) move to a new buffer
+  - fewer elements than a window gives an empty pipeline
+*/
+bool
+d_tests_sa_pipeline_window
+(
+    struct d_test_counter* _test_info
+)
+{
+    struct d_functional_pipeline pipe;
+    int                          data[] = { 1, 2, 3, 4, 5, 6 };
+    double*                      averages;
+    void*                        first;
+    bool                         all_passed;
+
+    all_passed = true;
+
+    // ---- validation ----
+    pipe = d_functional_pipeline_begin(data, 6, sizeof(int));
+
+    all_passed &= d_assert_standalone(
+        d_functional_pipeline_window(pipe, 0, 1, sizeof(int),
+                                     test_helper_sum_run,
+                                     NULL).error_code == -1 &&
+        d_functional_pipeline_window(pipe, 3, 0, sizeof(int),
+                                     test_helper_sum_run,
+                                     NULL).error_code == -1 &&
+        d_functional_pipeline_window(pipe, 3, 1, 0, test_helper_sum_run,
+                                     NULL).error_code == -1 &&
+        d_functional_pipeline_window(pipe, 3, 1, sizeof(int), NULL,
+                                     NULL).error_code == -1,
+        "window: invalid parameters return error",
+        "error_code should be -1",
+        _test_info);
+
+    pipe.error_code = -1;
+
+    all_passed &= d_assert_standalone(
+        d_functional_pipeline_window(pipe, 3, 1, sizeof(int),
+                                     test_helper_sum_run,
+                                     NULL).error_code == -1,
+        "window: propagates prior error",
+        "error should pass through",
+        _test_info);
+
+    // ---- owned: sliding sums in place ----
+    pipe  = d_functional_pipeline_begin_copy(data, 6, sizeof(int));
+    first = pipe.data;
+    pipe  = d_functional_pipeline_window(pipe, 3, 1, sizeof(int),
+                                         test_helper_sum_run, NULL);
+
+    all_passed &= d_assert_standalone(
+        pipe.error_code == 0 && pipe.data == first && pipe.count == 4 &&
+        ((int*)pipe.data)[0] == 6 && ((int*)pipe.data)[1] == 9 &&
+        ((int*)pipe.data)[3] == 15,
+        "window: sliding sums of 3 in place",
+        "1..6 should give 6, 9, 12, 15",
+        _test_info);
+
+    d_functional_pipeline_free(&pipe);
+
+    // ---- step of two ----
+    pipe = d_functional_pipeline_begin(data, 6, sizeof(int));
+    pipe = d_functional_pipeline_window(pipe, 2, 2, sizeof(int),
+                                        test_helper_sum_run, NULL);
+
+    all_passed &= d_assert_standalone(
+        pipe.error_code == 0 && pipe.count == 3 &&
+        ((int*)pipe.data)[0] == 3 && ((int*)pipe.data)[2] == 11,
+        "window: a step of 2 skips windows",
+        "1..6 should give 3, 7, 11",
+        _test_info);
+
+    d_functional_pipeline_free(&pipe);
+
+    // ---- moving average into doubles ----
+    pipe     = d_functional_pipeline_begin_copy(data, 6, sizeof(int));
+    first    = pipe.data;
+    pipe     = d_functional_pipeline_window(pipe, 4, 1, sizeof(double),
+                                            test_helper_average_run, NULL);
+    averages = (double*)pipe.data;
+
+    all_passed &= d_assert_standalone(
+        pipe.error_code == 0 && pipe.data != first && pipe.count == 3 &&
+        pipe.element_size == sizeof(double) &&
+        averages[0] == 2.5 && averages[2] == 4.5,
+        "window: a moving average widens into a new buffer",
+        "1..6 should give 2.5, 3.5, 4.5",
+        _test_info);
+
+    d_functional_pipeline_free(&pipe);
+
+    // ---- shorter than a window ----
+    pipe = d_functional_pipeline_begin(data, 2, sizeof(int));
+    pipe = d_functional_pipeline_window(pipe, 3, 1, sizeof(int),
+                                        test_helper_sum_run, NULL);
+
+    all_passed &= d_assert_standalone(
+        pipe.error_code == 0 && pipe.count == 0,
+        "window: fewer elements than a window gives no windows",
+        "count should be 0",
+        _test_info);
+
+    d_functional_pipeline_free(&pipe);
+
+    return all_passed;
+}
+
+
+/*
+d_tests_sa_pipeline_scan
+  Tests d_functional_pipeline_scan.
+  Tests the following:
+  - NULL initial value or accumulator, zero size, and prior errors
+  - prefix sums over owned data run in place
+  - the initial value ends holding the final accumulator
+  - widening accumulators move to a new buffer
+  - a failing accumulator is an error
+*/
+bool
+d_tests_sa_pipeline_scan
+(
+    struct d_test_counter* _test_info
+)
+{
+    struct d_functional_pipeline pipe;
+    struct test_helper_wide      total;
+    int                          data[] = { 1, 2, 3, 4 };
+    int                          sum;
+    void*                        first;
+    bool                         all_passed;
+
+    all_passed = true;
+
+    // ---- validation ----
+    pipe = d_functional_pipeline_begin(data, 4, sizeof(int));
+    sum  = 0;
+
+    all_passed &= d_assert_standalone(
+        d_functional_pipeline_scan(pipe, NULL, sizeof(int),
+                                   test_helper_sum_accumulator,
+                                   NULL).error_code == -1 &&
+        d_functional_pipeline_scan(pipe, &sum, sizeof(int), NULL,
+                                   NULL).error_code == -1 &&
+        d_functional_pipeline_scan(pipe, &sum, 0,
+                                   test_helper_sum_accumulator,
+                                   NULL).error_code == -1,
+        "scan: invalid parameters return error",
+        "error_code should be -1",
+        _test_info);
+
+    pipe.error_code = -1;
+
+    all_passed &= d_assert_standalone(
+        d_functional_pipeline_scan(pipe, &sum, sizeof(int),
+                                   test_helper_sum_accumulator,
+                                   NULL).error_code == -1,
+        "scan: propagates prior error",
+        "error should pass through",
+        _test_info);
+
+    // ---- owned: prefix sums in place ----
+    pipe  = d_functional_pipeline_begin_copy(data, 4, sizeof(int));
+    first = pipe.data;
+    sum   = 0;
+    pipe  = d_functional_pipeline_scan(pipe, &sum, sizeof(int),
+                                       test_helper_sum_accumulator, NULL);
+
+    all_passed &= d_assert_standalone(
+        pipe.error_code == 0 && pipe.data == first && pipe.count == 4 &&
+        ((int*)pipe.data)[0] == 1 && ((int*)pipe.data)[1] == 3 &&
+        ((int*)pipe.data)[3] == 10 && sum == 10,
+        "scan: prefix sums over owned data run in place",
+        "1..4 should give 1, 3, 6, 10",
+        _test_info);
+
+    d_functional_pipeline_free(&pipe);
+
+    // ---- borrowed: caller data untouched ----
+    pipe = d_functional_pipeline_begin(data, 4, sizeof(int));
+    sum  = 1;
+    pipe = d_functional_pipeline_scan(pipe, &sum, sizeof(int),
+                                      test_helper_product_accumulator,
+                                      NULL);
+
+    all_passed &= d_assert_standalone(
+        pipe.error_code == 0 && pipe.owns_data &&
+        ((int*)pipe.data)[3] == 24 && data[3] == 4,
+        "scan: running products over borrowed data",
+        "1..4 should give 1, 2, 6, 24",
+        _test_info);
+
+    d_functional_pipeline_free(&pipe);
+
+    // ---- widening accumulator ----
+    memset(&total, 0, sizeof(total));
+
+    pipe  = d_functional_pipeline_begin_copy(data, 4, sizeof(int));
+    first = pipe.data;
+    pipe  = d_functional_pipeline_scan(pipe, &total, sizeof(total),
+                                       test_helper_sum_accumulator, NULL);
+
+    all_passed &= d_assert_standalone(
+        pipe.error_code == 0 && pipe.data != first &&
+        pipe.element_size == sizeof(total) &&
+        ((struct test_helper_wide*)pipe.data)[2].values[0] == 6,
+        "scan: a wider accumulator moves to a new buffer",
+        "the running sums should be kept in each accumulator",
+        _test_info);
+
+    d_functional_pipeline_free(&pipe);
+
+    // ---- failing accumulator ----
+    pipe = d_functional_pipeline_begin(data, 4, sizeof(int));
+    pipe = d_functional_pipeline_scan(pipe, &sum, sizeof(int),
+                                      test_helper_fail_accumulator, NULL);
+
+    all_passed &= d_assert_standalone(
+        pipe.error_code == -1 && !pipe.owns_data,
+        "scan: a failing accumulator is an error",
+        "the output buffer should be discarded",
+        _test_info);
+
+    return all_passed;
+}
+
+
 /*
 d_tests_sa_pipeline_chaining
   Tests chaining multiple pipeline operations together.
@@ -1321,7 +2436,7 @@ d_tests_sa_pipeline_chaining
         _test_info);
 
     // clean up (map+filter allocated buffers; the last one is owned)
-    free(result);
+    d_functional_free(result);
 
     // ---- filter then fold: keep evens, sum them ----
     sum  = 0;
@@ -1464,17 +2579,173 @@ d_tests_sa_pipeline_chaining
 }
 
 
+/*
+d_tests_sa_pipeline_in_place
+  Tests the buffer reuse of pipelines that own their data.
+  Tests the following:
+  - map and filter over owned data keep the same buffer
+  - map over borrowed data allocates a buffer the pipeline then owns
+  - maps of large elements alternate between exactly two buffers
+  - peak memory of a long pipeline stays within twice the data size
+  - end and free after skip handle the advanced data pointer
+*/
+bool
+d_tests_sa_pipeline_in_place
+(
+    struct d_test_counter* _test_info
+)
+{
+    struct d_functional_pipeline   pipe;
+    struct d_functional_allocator  counting;
+    struct d_functional_allocator* previous;
+    struct test_helper_wide        wide[4];
+    int                            data[] = { 1, 2, 3, 4, 5, 6 };
+    void*                          first;
+    void*                          second;
+    int*                           ended;
+    int                            threshold;
+    size_t                         count;
+    size_t                         i;
+    bool                           all_passed;
+
+    all_passed = true;
+
+    // ---- owned: map and filter in place ----
+    pipe  = d_functional_pipeline_begin_copy(data, 6, sizeof(int));
+    first = pipe.data;
+    pipe  = d_functional_pipeline_map(pipe, test_helper_double_int, NULL);
+
+    all_passed &= d_assert_standalone(
+        pipe.error_code == 0 && pipe.data == first &&
+        ((int*)pipe.data)[0] == 2 && ((int*)pipe.data)[5] == 12,
+        "in_place: map over owned data reuses its buffer",
+        "data pointer should be unchanged and values doubled",
+        _test_info);
+
+    threshold = 6;
+    pipe      = d_functional_pipeline_filter(pipe,
+                                             test_helper_greater_than_context,
+                                             &threshold);
+
+    all_passed &= d_assert_standalone(
+        pipe.error_code == 0 && pipe.data == first && pipe.count == 3 &&
+        ((int*)pipe.data)[0] == 8 && ((int*)pipe.data)[2] == 12 &&
+        pipe.spare == NULL,
+        "in_place: filter over owned data compacts its buffer",
+        "kept elements should be compacted to the front",
+        _test_info);
+
+    d_functional_pipeline_free(&pipe);
+
+    // ---- borrowed: first stage takes ownership ----
+    pipe = d_functional_pipeline_begin(data, 6, sizeof(int));
+    pipe = d_functional_pipeline_map(pipe, test_helper_double_int, NULL);
+
+    all_passed &= d_assert_standalone(
+        pipe.error_code == 0 && pipe.owns_data &&
+        pipe.data != (void*)data && pipe.buffer == pipe.data &&
+        data[0] == 1 && data[5] == 6,
+        "in_place: map over borrowed data allocates an owned buffer",
+        "the caller's data should be untouched",
+        _test_info);
+
+    d_functional_pipeline_free(&pipe);
+
+    // ---- large elements: two recycled buffers ----
+    memset(wide, 0, sizeof(wide));
+
+    pipe   = d_functional_pipeline_begin_copy(wide, 4, sizeof(wide[0]));
+    first  = pipe.data;
+    pipe   = d_functional_pipeline_map(pipe, test_helper_bump_wide, NULL);
+    second = pipe.data;
+    pipe   = d_functional_pipeline_map(pipe, test_helper_bump_wide, NULL);
+
+    all_passed &= d_assert_standalone(
+        pipe.error_code == 0 && second != first &&
+        pipe.data == first && pipe.spare == second &&
+        ((struct test_helper_wide*)pipe.data)[3].values[19] == 2,
+        "in_place: large-element maps alternate between two buffers",
+        "the second map should write back into the first buffer",
+        _test_info);
+
+    d_functional_pipeline_free(&pipe);
+
+    // ---- peak memory ----
+    d_functional_allocator_init(&counting, NULL, NULL, NULL, NULL, false);
+    previous = d_functional_allocator_push(&counting);
+
+    pipe = d_functional_pipeline_begin_copy(wide, 4, sizeof(wide[0]));
+
+    for (i = 0; i < 8; i++)
+    {
+        pipe = d_functional_pipeline_map(pipe, test_helper_bump_wide, NULL);
+    }
+
+    d_functional_pipeline_free(&pipe);
+
+    pipe = d_functional_pipeline_begin_copy(data, 6, sizeof(int));
+    pipe = d_functional_pipeline_map(pipe, test_helper_double_int, NULL);
+    pipe = d_functional_pipeline_filter(pipe, test_helper_is_even, NULL);
+    d_functional_pipeline_free(&pipe);
+
+    all_passed &= d_assert_standalone(
+        counting.stats.allocations == 3 &&
+        counting.stats.high_water == 2 * sizeof(wide) &&
+        counting.stats.bytes_live == 0,
+        "in_place: eight maps allocate two buffers in total",
+        "peak memory should stay within twice the data size",
+        _test_info);
+
+    d_functional_allocator_pop(previous);
+    d_functional_allocator_destroy(&counting);
+
+    // ---- skip, then end ----
+    pipe  = d_functional_pipeline_begin_copy(data, 6, sizeof(int));
+    pipe  = d_functional_pipeline_skip(pipe, 2);
+    ended = (int*)d_functional_pipeline_end(pipe, &count);
+
+    all_passed &= d_assert_standalone(
+        ended != NULL && count == 4 && ended[0] == 3 && ended[3] == 6,
+        "in_place: end after skip returns the buffer's start",
+        "the caller should receive a pointer it can free",
+        _test_info);
+
+    d_functional_free(ended);
+
+    // ---- skip, then free ----
+    pipe = d_functional_pipeline_begin_copy(data, 6, sizeof(int));
+    pipe = d_functional_pipeline_skip(pipe, 3);
+    d_functional_pipeline_free(&pipe);
+
+    all_passed &= d_assert_standalone(
+        pipe.data == NULL && pipe.buffer == NULL,
+        "in_place: free after skip releases the whole buffer",
+        "the buffer should be freed from its start",
+        _test_info);
+
+    return all_passed;
+}
+
+
 /*
 d_tests_sa_pipeline_operations_all
   Runs all pipeline operation tests.
   Tests the following:
   - d_functional_pipeline_map
+  - d_functional_pipeline_map_to
   - d_functional_pipeline_filter
   - d_functional_pipeline_fold
+  - d_functional_pipeline_fold_multi
   - d_functional_pipeline_for_each
   - d_functional_pipeline_take
   - d_functional_pipeline_skip
+  - d_functional_pipeline_flat_map
+  - d_functional_pipeline_zip
+  - d_functional_pipeline_chunk
+  - d_functional_pipeline_window
+  - d_functional_pipeline_scan
   - chaining multiple operations
+  - in-place execution over owned data
 */
 bool
 d_tests_sa_pipeline_operations_all
@@ -1487,12 +2758,20 @@ d_tests_sa_pipeline_operations_all
     all_passed = true;
 
     all_passed &= d_tests_sa_pipeline_map(_test_info);
+    all_passed &= d_tests_sa_pipeline_map_to(_test_info);
     all_passed &= d_tests_sa_pipeline_filter(_test_info);
     all_passed &= d_tests_sa_pipeline_fold(_test_info);
+    all_passed &= d_tests_sa_pipeline_fold_multi(_test_info);
     all_passed &= d_tests_sa_pipeline_for_each(_test_info);
     all_passed &= d_tests_sa_pipeline_take(_test_info);
     all_passed &= d_tests_sa_pipeline_skip(_test_info);
+    all_passed &= d_tests_sa_pipeline_flat_map(_test_info);
+    all_passed &= d_tests_sa_pipeline_zip(_test_info);
+    all_passed &= d_tests_sa_pipeline_chunk(_test_info);
+    all_passed &= d_tests_sa_pipeline_window(_test_info);
+    all_passed &= d_tests_sa_pipeline_scan(_test_info);
     all_passed &= d_tests_sa_pipeline_chaining(_test_info);
+    all_passed &= d_tests_sa_pipeline_in_place(_test_info);
 
     return all_passed;
 }
@@ -0,0 +1,27 @@
+#include ".\predicate_registry_tests_sa.h"
+
+
+/*
+d_tests_sa_predicate_registry_run_all
+  Module-level aggregation function that runs all predicate registry
+tests.
+  Executes tests for all categories:
+  - Registration: validation and context layout
+  - Resolution: built-ins, arguments, interning, and formatting
+*/
+bool
+d_tests_sa_predicate_registry_run_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    // run all test categories
+    result = d_tests_sa_predicate_registry_register_all(_counter) && result;
+    result = d_tests_sa_predicate_registry_resolve_all(_counter)  && result;
+
+    return result;
+}
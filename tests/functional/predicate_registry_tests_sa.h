@@ -0,0 +1,58 @@
+/******************************************************************************
+* djinterp [test]                                 predicate_registry_tests_sa.h
+*
+*   Unit test declarations for `predicate_registry.h` module.
+*   Provides testing of registration (name and parameter validation,
+* duplicate names, context layout), of resolution (argument conversion and
+* range checks, interning, the built-ins), of formatting functions back
+* to their names and arguments, of identification and resolution by id, and
+* of holding and releasing interned contexts.
+*
+*
+* path:      \tests\functional\predicate_registry_tests_sa.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_TESTS_PREDICATE_REGISTRY_SA_
+#define DJINTERP_TESTS_PREDICATE_REGISTRY_SA_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "..\..\inc\djinterp.h"
+#include "..\..\inc\test\test_standalone.h"
+#include "..\..\inc\functional\functional.h"
+#include "..\..\inc\functional\predicate_registry.h"
+
+
+/******************************************************************************
+ * I. REGISTRATION TESTS
+ *****************************************************************************/
+bool d_tests_sa_predicate_registry_register_validation(struct d_test_counter* _counter);
+bool d_tests_sa_predicate_registry_register_layout(struct d_test_counter* _counter);
+
+// I.   aggregation function
+bool d_tests_sa_predicate_registry_register_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * II. RESOLUTION TESTS
+ *****************************************************************************/
+bool d_tests_sa_predicate_registry_resolve_builtins(struct d_test_counter* _counter);
+bool d_tests_sa_predicate_registry_resolve_arguments(struct d_test_counter* _counter);
+bool d_tests_sa_predicate_registry_resolve_format(struct d_test_counter* _counter);
+bool d_tests_sa_predicate_registry_resolve_identify(struct d_test_counter* _counter);
+bool d_tests_sa_predicate_registry_resolve_release(struct d_test_counter* _counter);
+
+// II.  aggregation function
+bool d_tests_sa_predicate_registry_resolve_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * MODULE-LEVEL AGGREGATION
+ *****************************************************************************/
+bool d_tests_sa_predicate_registry_run_all(struct d_test_counter* _counter);
+
+
+#endif  // DJINTERP_TESTS_PREDICATE_REGISTRY_SA_
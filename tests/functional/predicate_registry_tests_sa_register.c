@@ -0,0 +1,293 @@
+#include ".\predicate_registry_tests_sa.h"
+
+
+// registry_window
+//   helper: the context of registry_in_window, matching the parameters
+// (i32, f64, i32).
+struct registry_window
+{
+    int32_t low;
+    double  scale;
+    int32_t high;
+};
+
+// registry_in_window
+//   helper: predicate true when low <= element * scale <= high.
+static bool
+registry_in_window
+(
+    const void* _element,
+    void*       _context
+)
+{
+    const struct registry_window* window;
+    double                        value;
+
+    window = (const struct registry_window*)_context;
+    value  = (double)*(const int32_t*)_element * window->scale;
+
+    return (value >= (double)window->low) &&
+           (value <= (double)window->high);
+}
+
+// registry_always
+//   helper: predicate true for every element.
+static bool
+registry_always
+(
+    const void* _element,
+    void*       _context
+)
+{
+    (void)_element;
+    (void)_context;
+
+    return true;
+}
+
+// registry_by_bytes
+//   helper: comparator ordering elements bytewise.
+static int
+registry_by_bytes
+(
+    const void* _element1,
+    const void* _element2,
+    void*       _context
+)
+{
+    (void)_context;
+
+    return memcmp(_element1, _element2, sizeof(int32_t));
+}
+
+
+/*
+d_tests_sa_predicate_registry_register_validation
+  Tests parameter validation of registration.
+  Tests the following:
+  - a new registry is empty; freeing NULL is a no-op
+  - NULL registry / function, and invalid names are rejected
+  - too many parameters, missing parameter types, and unknown types are
+    rejected
+  - a name is registered once, across predicates and comparators
+*/
+bool
+d_tests_sa_predicate_registry_register_validation
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_predicate_registry* registry;
+    enum d_registry_param        params[D_REGISTRY_MAX_PARAMS + 1];
+    char                         long_name[D_REGISTRY_MAX_NAME + 1];
+    bool                         result;
+    size_t                       i;
+
+    result   = true;
+    registry = d_predicate_registry_new();
+
+    for (i = 0; i <= D_REGISTRY_MAX_PARAMS; i++)
+    {
+        params[i] = D_REGISTRY_PARAM_I32;
+    }
+
+    memset(long_name, 'a', D_REGISTRY_MAX_NAME);
+    long_name[D_REGISTRY_MAX_NAME] = '\0';
+
+    // test 1: creation
+    result = d_assert_standalone(
+        (registry != NULL) &&
+        (registry->entry_count == 0) &&
+        (registry->instance_count == 0),
+        "registry_new",
+        "a new registry should be empty",
+        _counter) && result;
+
+    if (!registry)
+    {
+        return result;
+    }
+
+    d_predicate_registry_free(NULL);
+
+    // test 2: names and functions
+    result = d_assert_standalone(
+        (!d_predicate_registry_add_predicate(NULL, "always",
+                                             registry_always, NULL, 0)) &&
+        (!d_predicate_registry_add_predicate(registry, NULL,
+                                             registry_always, NULL, 0)) &&
+        (!d_predicate_registry_add_predicate(registry, "",
+                                             registry_always, NULL, 0)) &&
+        (!d_predicate_registry_add_predicate(registry, "9lives",
+                                             registry_always, NULL, 0)) &&
+        (!d_predicate_registry_add_predicate(registry, "bad-name",
+                                             registry_always, NULL, 0)) &&
+        (!d_predicate_registry_add_predicate(registry, long_name,
+                                             registry_always, NULL, 0)) &&
+        (!d_predicate_registry_add_predicate(registry, "always",
+                                             NULL, NULL, 0))            &&
+        (!d_predicate_registry_add_comparator(registry, "bytes",
+                                              NULL, NULL, 0)),
+        "registry_register_names",
+        "invalid names and NULL functions should be rejected",
+        _counter) && result;
+
+    // test 3: parameters
+    params[1] = (enum d_registry_param)7;
+
+    result = d_assert_standalone(
+        (!d_predicate_registry_add_predicate(registry, "many",
+              registry_always, params, D_REGISTRY_MAX_PARAMS + 1))      &&
+        (!d_predicate_registry_add_predicate(registry, "missing",
+              registry_always, NULL, 1))                                &&
+        (!d_predicate_registry_add_predicate(registry, "unknown",
+              registry_always, params, 2))                              &&
+        (registry->entry_count == 0),
+        "registry_register_params",
+        "invalid parameter lists should be rejected",
+        _counter) && result;
+
+    // test 4: duplicates
+    result = d_assert_standalone(
+        (d_predicate_registry_add_predicate(registry, "always",
+                                            registry_always, NULL, 0))  &&
+        (!d_predicate_registry_add_predicate(registry, "always",
+                                             registry_always, NULL, 0)) &&
+        (!d_predicate_registry_add_comparator(registry, "always",
+                                              registry_by_bytes,
+                                              NULL, 0))                 &&
+        (d_predicate_registry_add_comparator(registry, "bytes",
+                                             registry_by_bytes,
+                                             NULL, 0))                  &&
+        (registry->entry_count == 2)                                    &&
+        (registry->entries[1].id == 1),
+        "registry_register_duplicates",
+        "a name should be registered only once",
+        _counter) && result;
+
+    d_predicate_registry_free(registry);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_predicate_registry_register_layout
+  Tests the context layout of registered parameters.
+  Tests the following:
+  - (i32, f64, i32) is laid out like the matching struct
+  - the predicate receives the bound values
+  - builtins register once per registry
+*/
+bool
+d_tests_sa_predicate_registry_register_layout
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_predicate_registry*  registry;
+    const struct registry_window* window;
+    enum d_registry_param         params[3];
+    struct d_registry_arg         args[3];
+    fn_predicate                  test;
+    void*                         context;
+    int32_t                       value;
+    bool                          result;
+    bool                          ok;
+
+    result   = true;
+    registry = d_predicate_registry_new();
+
+    if (!registry)
+    {
+        return d_assert_standalone(false,
+                                   "registry_layout_new",
+                                   "the registry should be created",
+                                   _counter);
+    }
+
+    params[0] = D_REGISTRY_PARAM_I32;
+    params[1] = D_REGISTRY_PARAM_F64;
+    params[2] = D_REGISTRY_PARAM_I32;
+
+    memset(args, 0, sizeof(args));
+    args[0].integer = 3;
+    args[1].is_real = true;
+    args[1].real    = 2.5;
+    args[2].integer = -7;
+
+    ok = d_predicate_registry_add_predicate(registry, "in_window",
+                                            registry_in_window, params, 3);
+
+    // test 1: layout
+    result = d_assert_standalone(
+        (ok) &&
+        (registry->entries[0].context_size ==
+         sizeof(struct registry_window)),
+        "registry_layout_size",
+        "the context should be the size of the matching struct",
+        _counter) && result;
+
+    // test 2: bound values
+    context = NULL;
+    test    = NULL;
+    ok      = d_predicate_registry_predicate(registry, "in_window", 9,
+                                             args, 3, &test, &context);
+    window  = (const struct registry_window*)context;
+
+    result = d_assert_standalone(
+        (ok) && (test == registry_in_window) && (window != NULL) &&
+        (window->low == 3) && (window->scale == 2.5) &&
+        (window->high == -7),
+        "registry_layout_values",
+        "the predicate should receive the bound values",
+        _counter) && result;
+
+    // 2 * 2.5 = 5 is outside [3, -7]
+    value = 2;
+
+    result = d_assert_standalone(
+        (ok) && (!test(&value, context)),
+        "registry_layout_call",
+        "the resolved predicate should use its bound values",
+        _counter) && result;
+
+    // test 3: builtins
+    result = d_assert_standalone(
+        (d_predicate_registry_add_builtins(registry)) &&
+        (!d_predicate_registry_add_builtins(registry)) &&
+        (!d_predicate_registry_add_builtins(NULL)),
+        "registry_layout_builtins",
+        "builtins should register once",
+        _counter) && result;
+
+    d_predicate_registry_free(registry);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_predicate_registry_register_all
+  Aggregation function that runs all registration tests.
+*/
+bool
+d_tests_sa_predicate_registry_register_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Registration\n");
+    printf("  ----------------------\n");
+
+    result = d_tests_sa_predicate_registry_register_validation(_counter) &&
+             result;
+    result = d_tests_sa_predicate_registry_register_layout(_counter) &&
+             result;
+
+    return result;
+}
@@ -0,0 +1,642 @@
+#include ".\predicate_registry_tests_sa.h"
+
+
+// registry_arg_int
+//   helper: an integer argument.
+static struct d_registry_arg
+registry_arg_int
+(
+    int64_t _value
+)
+{
+    struct d_registry_arg arg;
+
+    arg.is_real = false;
+    arg.integer = _value;
+    arg.real    = 0.0;
+
+    return arg;
+}
+
+// registry_arg_real
+//   helper: a real argument.
+static struct d_registry_arg
+registry_arg_real
+(
+    double _value
+)
+{
+    struct d_registry_arg arg;
+
+    arg.is_real = true;
+    arg.integer = 0;
+    arg.real    = _value;
+
+    return arg;
+}
+
+// registry_never
+//   helper: an unregistered predicate.
+static bool
+registry_never
+(
+    const void* _element,
+    void*       _context
+)
+{
+    (void)_element;
+    (void)_context;
+
+    return false;
+}
+
+
+/*
+d_tests_sa_predicate_registry_resolve_builtins
+  Tests the built-ins of the global registry.
+  Tests the following:
+  - the global registry is created once
+  - comparisons, between, and parity for each type
+  - asc and desc comparators
+*/
+bool
+d_tests_sa_predicate_registry_resolve_builtins
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_predicate_registry* registry;
+    struct d_registry_arg        args[2];
+    fn_predicate                 test;
+    fn_function_comparator       compare;
+    void*                        context;
+    int32_t                      narrow[2];
+    int64_t                      wide[2];
+    double                       real[2];
+    bool                         result;
+    bool                         ok;
+
+    result   = true;
+    registry = d_predicate_registry_global();
+
+    // test 1: one global registry
+    result = d_assert_standalone(
+        (registry != NULL) &&
+        (registry == d_predicate_registry_global()),
+        "registry_global",
+        "the global registry should be created once",
+        _counter) && result;
+
+    if (!registry)
+    {
+        return result;
+    }
+
+    // test 2: i32 comparison
+    args[0]   = registry_arg_int(100);
+    narrow[0] = 150;
+    narrow[1] = 50;
+    ok        = d_predicate_registry_predicate(registry, "gt_i32", 6,
+                                               args, 1, &test, &context);
+
+    result = d_assert_standalone(
+        (ok) && (test(&narrow[0], context)) && (!test(&narrow[1], context)),
+        "registry_builtin_gt_i32",
+        "gt_i32 100 should hold for 150 and not for 50",
+        _counter) && result;
+
+    // test 3: i64 comparison beyond 32 bits
+    args[0] = registry_arg_int((int64_t)1 << 40);
+    wide[0] = ((int64_t)1 << 40) - 1;
+    wide[1] = (int64_t)1 << 40;
+    ok      = d_predicate_registry_predicate(registry, "lt_i64", 6,
+                                             args, 1, &test, &context);
+
+    result = d_assert_standalone(
+        (ok) && (test(&wide[0], context)) && (!test(&wide[1], context)),
+        "registry_builtin_lt_i64",
+        "lt_i64 should compare 64-bit values",
+        _counter) && result;
+
+    // test 4: f64 between (inclusive)
+    args[0] = registry_arg_real(0.5);
+    args[1] = registry_arg_int(2);
+    real[0] = 2.0;
+    real[1] = 2.25;
+    ok      = d_predicate_registry_predicate(registry, "between_f64", 11,
+                                             args, 2, &test, &context);
+
+    result = d_assert_standalone(
+        (ok) && (test(&real[0], context)) && (!test(&real[1], context)),
+        "registry_builtin_between_f64",
+        "between_f64 should include its bounds",
+        _counter) && result;
+
+    // test 5: parity
+    wide[0] = -4;
+    wide[1] = 7;
+    ok      = d_predicate_registry_predicate(registry, "odd_i64", 7,
+                                             NULL, 0, &test, &context);
+
+    result = d_assert_standalone(
+        (ok) && (context == NULL) &&
+        (!test(&wide[0], context)) && (test(&wide[1], context)),
+        "registry_builtin_odd_i64",
+        "odd_i64 should have no context and test parity",
+        _counter) && result;
+
+    // test 6: comparators
+    real[0] = 1.5;
+    real[1] = -3.0;
+    ok      = d_predicate_registry_comparator(registry, "desc_f64", 8,
+                                              NULL, 0, &compare, &context);
+
+    result = d_assert_standalone(
+        (ok) &&
+        (compare(&real[0], &real[1], context) < 0) &&
+        (compare(&real[1], &real[0], context) > 0) &&
+        (compare(&real[0], &real[0], context) == 0),
+        "registry_builtin_desc_f64",
+        "desc_f64 should order greater values first",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_predicate_registry_resolve_arguments
+  Tests argument conversion and interning.
+  Tests the following:
+  - equal arguments give the same context, different ones a new context
+  - an integer and an equal real give the same f64 context
+  - out-of-range, ill-typed, and miscounted arguments are rejected
+  - names match by length, and by kind
+*/
+bool
+d_tests_sa_predicate_registry_resolve_arguments
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_predicate_registry* registry;
+    struct d_registry_arg        args[2];
+    fn_predicate                 test;
+    fn_function_comparator       compare;
+    void*                        context1;
+    void*                        context2;
+    void*                        context3;
+    size_t                       instances;
+    bool                         result;
+
+    result   = true;
+    registry = d_predicate_registry_new();
+
+    if ( (!registry) ||
+         (!d_predicate_registry_add_builtins(registry)) )
+    {
+        d_predicate_registry_free(registry);
+
+        return d_assert_standalone(false,
+                                   "registry_arguments_new",
+                                   "the registry should be created",
+                                   _counter);
+    }
+
+    // test 1: interning
+    args[0] = registry_arg_int(7);
+    d_predicate_registry_predicate(registry, "eq_i32", 6, args, 1,
+                                   &test, &context1);
+    d_predicate_registry_predicate(registry, "eq_i32", 6, args, 1,
+                                   &test, &context2);
+    args[0] = registry_arg_int(8);
+    d_predicate_registry_predicate(registry, "eq_i32", 6, args, 1,
+                                   &test, &context3);
+
+    result = d_assert_standalone(
+        (context1 != NULL) && (context1 == context2) &&
+        (context3 != NULL) && (context3 != context1) &&
+        (registry->instance_count == 2),
+        "registry_arguments_interned",
+        "equal arguments should share a context",
+        _counter) && result;
+
+    // test 2: integer and real agree for f64
+    args[0] = registry_arg_int(2);
+    d_predicate_registry_predicate(registry, "ge_f64", 6, args, 1,
+                                   &test, &context1);
+    args[0] = registry_arg_real(2.0);
+    d_predicate_registry_predicate(registry, "ge_f64", 6, args, 1,
+                                   &test, &context2);
+
+    result = d_assert_standalone(
+        (context1 != NULL) && (context1 == context2),
+        "registry_arguments_f64",
+        "2 and 2.0 should bind the same f64 parameter",
+        _counter) && result;
+
+    // test 3: rejection
+    instances = registry->instance_count;
+    args[0]   = registry_arg_int((int64_t)INT32_MAX + 1);
+    args[1]   = registry_arg_real(1.5);
+
+    result = d_assert_standalone(
+        (!d_predicate_registry_predicate(registry, "eq_i32", 6, args, 1,
+                                         &test, &context1))             &&
+        (!d_predicate_registry_predicate(registry, "eq_i64", 6, &args[1],
+                                         1, &test, &context1))          &&
+        (!d_predicate_registry_predicate(registry, "eq_i64", 6, args, 2,
+                                         &test, &context1))             &&
+        (!d_predicate_registry_predicate(registry, "eq_i64", 6, NULL, 0,
+                                         &test, &context1))             &&
+        (!d_predicate_registry_predicate(registry, "eq_u8", 5, args, 1,
+                                         &test, &context1))             &&
+        (!d_predicate_registry_predicate(NULL, "eq_i64", 6, args, 1,
+                                         &test, &context1))             &&
+        (registry->instance_count == instances),
+        "registry_arguments_rejected",
+        "ill-fitting arguments should be rejected without interning",
+        _counter) && result;
+
+    // test 4: names
+    result = d_assert_standalone(
+        (d_predicate_registry_comparator(registry, "asc_i32)", 7, NULL, 0,
+                                         &compare, &context1))          &&
+        (!d_predicate_registry_comparator(registry, "asc_i32", 3, NULL, 0,
+                                          &compare, &context1))         &&
+        (!d_predicate_registry_predicate(registry, "asc_i32", 7, NULL, 0,
+                                         &test, &context1)),
+        "registry_arguments_names",
+        "names should match exactly, and only their own kind",
+        _counter) && result;
+
+    d_predicate_registry_free(registry);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_predicate_registry_resolve_format
+  Tests formatting functions back to their names.
+  Tests the following:
+  - predicates with integer, real, and no arguments; comparators
+  - truncation reports the full length
+  - unregistered functions and foreign contexts give 0
+*/
+bool
+d_tests_sa_predicate_registry_resolve_format
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_predicate_registry* registry;
+    struct d_registry_arg        args[2];
+    fn_predicate                 test;
+    fn_function_comparator       compare;
+    void*                        context;
+    char                         text[64];
+    char                         small[8];
+    int32_t                      foreign;
+    size_t                       length;
+    bool                         result;
+
+    result   = true;
+    registry = d_predicate_registry_global();
+
+    if (!registry)
+    {
+        return d_assert_standalone(false,
+                                   "registry_format_global",
+                                   "the global registry should exist",
+                                   _counter);
+    }
+
+    // test 1: integer arguments
+    args[0] = registry_arg_int(-100);
+    d_predicate_registry_predicate(registry, "le_i32", 6, args, 1,
+                                   &test, &context);
+    length = d_predicate_registry_format_predicate(registry, test, context,
+                                                   text, sizeof(text));
+
+    result = d_assert_standalone(
+        (length == strlen("le_i32, -100")) &&
+        (strcmp(text, "le_i32, -100") == 0),
+        "registry_format_integer",
+        "le_i32 -100 should format as \"le_i32, -100\"",
+        _counter) && result;
+
+    // test 2: truncation
+    length = d_predicate_registry_format_predicate(registry, test, context,
+                                                   small, sizeof(small));
+
+    result = d_assert_standalone(
+        (length == strlen("le_i32, -100")) &&
+        (strlen(small) == sizeof(small) - 1),
+        "registry_format_truncated",
+        "truncated output should report the full length",
+        _counter) && result;
+
+    // test 3: real arguments
+    args[0] = registry_arg_real(0.25);
+    args[1] = registry_arg_real(-1e9);
+    d_predicate_registry_predicate(registry, "between_f64", 11, args, 2,
+                                   &test, &context);
+    d_predicate_registry_format_predicate(registry, test, context,
+                                          text, sizeof(text));
+
+    result = d_assert_standalone(
+        (strcmp(text, "between_f64, 0.25, -1000000000") == 0),
+        "registry_format_real",
+        "reals should format exactly",
+        _counter) && result;
+
+    // test 4: no arguments and comparators
+    d_predicate_registry_comparator(registry, "asc_i64", 7, NULL, 0,
+                                    &compare, &context);
+    d_predicate_registry_format_comparator(registry, compare, context,
+                                           text, sizeof(text));
+
+    result = d_assert_standalone(
+        (strcmp(text, "asc_i64") == 0),
+        "registry_format_comparator",
+        "a comparator should format as its name",
+        _counter) && result;
+
+    // test 5: unregistered pairs
+    args[0] = registry_arg_int(1);
+    foreign = 1;
+    d_predicate_registry_predicate(registry, "gt_i32", 6, args, 1,
+                                   &test, &context);
+
+    result = d_assert_standalone(
+        (d_predicate_registry_format_predicate(registry, registry_never,
+                                               NULL, text,
+                                               sizeof(text)) == 0)      &&
+        (d_predicate_registry_format_predicate(registry, test, &foreign,
+                                               text,
+                                               sizeof(text)) == 0)      &&
+        (d_predicate_registry_format_predicate(registry, test, context,
+                                               NULL, 4) == 0),
+        "registry_format_unregistered",
+        "unregistered functions and foreign contexts should give 0",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_predicate_registry_resolve_identify
+  Tests identification and resolution by id.
+  Tests the following:
+  - identify gives the entry and the bound arguments
+  - resolving the id and arguments gives the same function and context
+  - ids of the other kind, unknown ids, and unregistered pairs fail
+*/
+bool
+d_tests_sa_predicate_registry_resolve_identify
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_predicate_registry* registry;
+    struct d_registry_entry      entry;
+    struct d_registry_arg        args[D_REGISTRY_MAX_PARAMS];
+    fn_predicate                 test;
+    fn_predicate                 test2;
+    fn_function_comparator       compare;
+    fn_function_comparator       compare2;
+    void*                        context;
+    void*                        context2;
+    bool                         ok;
+    bool                         result;
+
+    result   = true;
+    registry = d_predicate_registry_global();
+
+    if (!registry)
+    {
+        return d_assert_standalone(false,
+                                   "registry_identify_global",
+                                   "the global registry should exist",
+                                   _counter);
+    }
+
+    // test 1: a predicate with real arguments
+    args[0] = registry_arg_real(-2.5);
+    args[1] = registry_arg_int(7);
+    d_predicate_registry_predicate(registry, "between_f64", 11, args, 2,
+                                   &test, &context);
+    memset(args, 0, sizeof(args));
+    ok = d_predicate_registry_identify_predicate(registry, test, context,
+                                                 &entry, args);
+
+    result = d_assert_standalone(
+        (ok) && (strcmp(entry.name, "between_f64") == 0) &&
+        (entry.param_count == 2) &&
+        (args[0].is_real) && (args[0].real == -2.5) &&
+        (args[1].is_real) && (args[1].real == 7.0),
+        "registry_identify_predicate",
+        "identify should give the entry and real arguments",
+        _counter) && result;
+
+    // test 2: resolving by id gives the same instance
+    test2    = NULL;
+    context2 = NULL;
+    ok       = d_predicate_registry_predicate_by_id(registry, entry.id,
+                                                    args, 2,
+                                                    &test2, &context2);
+
+    result = d_assert_standalone(
+        (ok) && (test2 == test) && (context2 == context),
+        "registry_identify_by_id",
+        "resolving the id should give the interned instance",
+        _counter) && result;
+
+    // test 3: comparators with integer arguments
+    d_predicate_registry_comparator(registry, "desc_i32", 8, NULL, 0,
+                                    &compare, &context);
+    ok = d_predicate_registry_identify_comparator(registry, compare, context,
+                                                  &entry, args)          &&
+         d_predicate_registry_comparator_by_id(registry, entry.id, NULL, 0,
+                                               &compare2, &context2);
+
+    result = d_assert_standalone(
+        (ok) && (entry.kind == D_REGISTRY_COMPARATOR) &&
+        (entry.param_count == 0) && (compare2 == compare),
+        "registry_identify_comparator",
+        "a comparator should identify and resolve by id",
+        _counter) && result;
+
+    // test 4: wrong kind, unknown id, unregistered
+    result = d_assert_standalone(
+        (!d_predicate_registry_predicate_by_id(registry, entry.id, NULL, 0,
+                                               &test2, &context2))       &&
+        (!d_predicate_registry_comparator_by_id(registry, 0xFFFFFF, NULL, 0,
+                                                &compare2, &context2))   &&
+        (!d_predicate_registry_identify_predicate(registry, registry_never,
+                                                  NULL, &entry, args)),
+        "registry_identify_failures",
+        "wrong kinds, unknown ids, and unregistered pairs should fail",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_predicate_registry_resolve_release
+  Tests d_predicate_registry_retain and d_predicate_registry_release.
+  Tests the following:
+  - a context stays interned until its last reference is given back
+  - the same arguments then resolve to a new instance
+  - many distinct arguments resolved and released leave no instances
+  - NULL and foreign contexts are ignored
+*/
+bool
+d_tests_sa_predicate_registry_resolve_release
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_predicate_registry* registry;
+    struct d_registry_arg        args[1];
+    fn_predicate                 test;
+    void*                        context1;
+    void*                        context2;
+    int32_t                      foreign;
+    char                         text[32];
+    int64_t                      i;
+    bool                         ok;
+    bool                         result;
+
+    result   = true;
+    registry = d_predicate_registry_new();
+
+    if ( (!registry) ||
+         (!d_predicate_registry_add_builtins(registry)) )
+    {
+        d_predicate_registry_free(registry);
+
+        return d_assert_standalone(false,
+                                   "registry_release_new",
+                                   "the registry should be created",
+                                   _counter);
+    }
+
+    // test 1: held by two, then by one
+    args[0] = registry_arg_int(42);
+    d_predicate_registry_predicate(registry, "gt_i32", 6, args, 1,
+                                   &test, &context1);
+    ok = d_predicate_registry_retain(registry, context1);
+    d_predicate_registry_release(registry, context1);
+
+    result = d_assert_standalone(
+        (ok) &&
+        (registry->instance_count == 1) &&
+        (d_predicate_registry_format_predicate(registry, test, context1,
+                                               text, sizeof(text)) > 0),
+        "registry_release_held",
+        "a context should stay interned while it is held",
+        _counter) && result;
+
+    // test 2: the last reference frees it
+    d_predicate_registry_release(registry, context1);
+
+    result = d_assert_standalone(
+        registry->instance_count == 0,
+        "registry_release_last",
+        "the last reference should free the instance",
+        _counter) && result;
+
+    // test 3: many distinct arguments
+    ok = true;
+
+    for (i = 0; (ok) && (i < 1000); i++)
+    {
+        args[0] = registry_arg_int(i);
+        ok      = d_predicate_registry_predicate(registry, "lt_i64", 6,
+                                                 args, 1,
+                                                 &test, &context1) &&
+                  d_predicate_registry_predicate(registry, "lt_i64", 6,
+                                                 args, 1,
+                                                 &test, &context2) &&
+                  (context1 == context2);
+    }
+
+    result = d_assert_standalone(
+        (ok) && (registry->instance_count == 1000),
+        "registry_release_many_held",
+        "distinct arguments should intern distinct instances",
+        _counter) && result;
+
+    for (i = 0; i < 1000; i++)
+    {
+        args[0] = registry_arg_int(i);
+        d_predicate_registry_predicate(registry, "lt_i64", 6, args, 1,
+                                       &test, &context1);
+
+        // the two references above, and this one
+        d_predicate_registry_release(registry, context1);
+        d_predicate_registry_release(registry, context1);
+        d_predicate_registry_release(registry, context1);
+    }
+
+    result = d_assert_standalone(
+        registry->instance_count == 0,
+        "registry_release_many",
+        "releasing every reference should leave no instances",
+        _counter) && result;
+
+    // test 4: NULL and foreign contexts
+    foreign = 42;
+    d_predicate_registry_release(registry, &foreign);
+    d_predicate_registry_release(registry, NULL);
+    d_predicate_registry_release(NULL, &foreign);
+
+    result = d_assert_standalone(
+        (!d_predicate_registry_retain(registry, &foreign)) &&
+        (!d_predicate_registry_retain(registry, NULL))     &&
+        (!d_predicate_registry_retain(NULL, &foreign))     &&
+        (registry->instance_count == 0),
+        "registry_release_foreign",
+        "NULL and foreign contexts should be ignored",
+        _counter) && result;
+
+    d_predicate_registry_free(registry);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_predicate_registry_resolve_all
+  Aggregation function that runs all resolution tests.
+*/
+bool
+d_tests_sa_predicate_registry_resolve_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Resolution\n");
+    printf("  --------------------\n");
+
+    result = d_tests_sa_predicate_registry_resolve_builtins(_counter) &&
+             result;
+    result = d_tests_sa_predicate_registry_resolve_arguments(_counter) &&
+             result;
+    result = d_tests_sa_predicate_registry_resolve_format(_counter) &&
+             result;
+    result = d_tests_sa_predicate_registry_resolve_identify(_counter) &&
+             result;
+    result = d_tests_sa_predicate_registry_resolve_release(_counter) &&
+             result;
+
+    return result;
+}
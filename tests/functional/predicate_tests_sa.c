@@ -9,6 +9,8 @@ d_tests_sa_predicate_run_all
   - Evaluation functions (_eval variants)
   - Utility predicates (is_null, is_not_null)
   - Compound literal macros (D_PREDICATE_* variants)
+  - Compiled expression programs (d_predicate_expr / d_predicate_program)
+  - Adaptive combinators (d_predicate_adaptive)
 */
 bool
 d_tests_sa_predicate_run_all
@@ -24,6 +26,8 @@ d_tests_sa_predicate_run_all
     result = d_tests_sa_predicate_constructor_all(_counter) && result;
     result = d_tests_sa_predicate_eval_all(_counter)        && result;
     result = d_tests_sa_predicate_macro_all(_counter)       && result;
+    result = d_tests_sa_predicate_expr_all(_counter)        && result;
+    result = d_tests_sa_predicate_adaptive_all(_counter)    && result;
 
     return result;
 }
@@ -4,8 +4,9 @@
 *   Unit test declarations for `predicate.h` module.
 *   Provides comprehensive testing of all d_predicate combinator functions
 * including constructor functions (_new variants), evaluation functions (_eval
-* variants), utility predicates, and compound literal macros. Tests cover AND,
-* OR, XOR, and NOT combinators with both context and non-context variants.
+* variants), utility predicates, compound literal macros, compiled predicate
+* expression programs, and adaptive combinators. Tests cover AND, OR, XOR, and
+* NOT combinators with both context and non-context variants.
 *
 *
 * path:      \tests\functional\predicate_tests_sa.h
@@ -50,6 +51,21 @@ bool d_tests_sa_predicate_macro_xor_simple(struct d_test_counter* _counter);
 bool d_tests_sa_predicate_macro_not_simple(struct d_test_counter* _counter);
 bool d_tests_sa_predicate_macro_all(struct d_test_counter* _counter);
 
+// expression program tests
+bool d_tests_sa_predicate_expr_build(struct d_test_counter* _counter);
+bool d_tests_sa_predicate_expr_compile(struct d_test_counter* _counter);
+bool d_tests_sa_predicate_program_eval(struct d_test_counter* _counter);
+bool d_tests_sa_predicate_program_short_circuit(struct d_test_counter* _counter);
+bool d_tests_sa_predicate_program_eval_array(struct d_test_counter* _counter);
+bool d_tests_sa_predicate_expr_all(struct d_test_counter* _counter);
+
+// adaptive combinator tests
+bool d_tests_sa_predicate_adaptive_new(struct d_test_counter* _counter);
+bool d_tests_sa_predicate_adaptive_eval(struct d_test_counter* _counter);
+bool d_tests_sa_predicate_adaptive_reorder(struct d_test_counter* _counter);
+bool d_tests_sa_predicate_adaptive_snapshot(struct d_test_counter* _counter);
+bool d_tests_sa_predicate_adaptive_all(struct d_test_counter* _counter);
+
 // module-level aggregation
 bool d_tests_sa_predicate_run_all(struct d_test_counter* _counter);
 
@@ -0,0 +1,494 @@
+#include ".\predicate_tests_sa.h"
+#include ".\predicate_tests_sa_helpers.h"
+
+
+/*
+d_tests_sa_predicate_adaptive_new
+  Tests the d_predicate_adaptive_new constructor function.
+  Tests the following:
+  - NULL leaves rejection
+  - zero count rejection
+  - NULL leaf predicate rejection
+  - invalid mode rejection
+  - leaves are copied in the given order with zeroed statistics
+  - initial published statistics
+*/
+bool
+d_tests_sa_predicate_adaptive_new
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                              result;
+    struct d_predicate_adaptive*      adaptive;
+    struct d_predicate_leaf           leaves[3];
+    struct d_predicate_adaptive_stats stats[3];
+    uint64_t                          evaluations;
+    int                               threshold;
+
+    result    = true;
+    threshold = 5;
+
+    leaves[0].predicate = pred_is_even;
+    leaves[0].context   = NULL;
+    leaves[1].predicate = pred_greater_than_threshold;
+    leaves[1].context   = &threshold;
+    leaves[2].predicate = pred_is_positive;
+    leaves[2].context   = NULL;
+
+    // test 1: NULL leaves
+    result = d_assert_standalone(
+        d_predicate_adaptive_new(D_PREDICATE_ADAPTIVE_AND, NULL, 3) == NULL,
+        "adaptive_new_null_leaves",
+        "NULL leaves should return NULL",
+        _counter) && result;
+
+    // test 2: zero count
+    result = d_assert_standalone(
+        d_predicate_adaptive_new(D_PREDICATE_ADAPTIVE_AND, leaves, 0) == NULL,
+        "adaptive_new_zero_count",
+        "zero count should return NULL",
+        _counter) && result;
+
+    // test 3: NULL leaf predicate
+    leaves[1].predicate = NULL;
+
+    result = d_assert_standalone(
+        d_predicate_adaptive_new(D_PREDICATE_ADAPTIVE_OR, leaves, 3) == NULL,
+        "adaptive_new_null_predicate",
+        "NULL leaf predicate should return NULL",
+        _counter) && result;
+
+    leaves[1].predicate = pred_greater_than_threshold;
+
+    // test 4: invalid mode
+    result = d_assert_standalone(
+        d_predicate_adaptive_new((enum d_predicate_adaptive_mode)7,
+                                 leaves,
+                                 3) == NULL,
+        "adaptive_new_invalid_mode",
+        "invalid mode should return NULL",
+        _counter) && result;
+
+    // test 5: valid construction
+    adaptive = d_predicate_adaptive_new(D_PREDICATE_ADAPTIVE_AND, leaves, 3);
+
+    result = d_assert_standalone(
+        adaptive != NULL,
+        "adaptive_new_valid",
+        "valid leaves should create a combinator",
+        _counter) && result;
+
+    if (adaptive)
+    {
+        result = d_assert_standalone(
+            (adaptive->count == 3)                             &&
+            (adaptive->mode == D_PREDICATE_ADAPTIVE_AND)       &&
+            (adaptive->leaves[0].predicate == pred_is_even)    &&
+            (adaptive->leaves[1].context == &threshold)        &&
+            (adaptive->leaves[2].index == 2)                   &&
+            (adaptive->leaves[2].calls == 0)                   &&
+            (adaptive->evaluations == 0)                       &&
+            (adaptive->reorder_interval ==
+                 D_PREDICATE_ADAPTIVE_REORDER_INTERVAL),
+            "adaptive_new_copies_leaves",
+            "leaves should be copied in order with zeroed statistics",
+            _counter) && result;
+
+        // test 6: initial snapshot
+        evaluations = 99;
+
+        result = d_assert_standalone(
+            (d_predicate_adaptive_snapshot(adaptive,
+                                           stats,
+                                           3,
+                                           &evaluations) == 3) &&
+            (evaluations == 0)                                   &&
+            (stats[1].index == 1)                                &&
+            (stats[1].position == 1)                             &&
+            (stats[1].calls == 0),
+            "adaptive_new_initial_snapshot",
+            "initial snapshot should reflect the given order",
+            _counter) && result;
+
+        d_predicate_adaptive_free(adaptive);
+    }
+
+    // test 7: free NULL is a no-op
+    d_predicate_adaptive_free(NULL);
+
+    result = d_assert_standalone(
+        true,
+        "adaptive_free_null",
+        "freeing NULL should not crash",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_predicate_adaptive_eval
+  Tests the d_predicate_adaptive_eval and d_predicate_adaptive_test
+functions.
+  Tests the following:
+  - NULL combinator returns false
+  - AND mode matches direct evaluation, including across reorders
+  - OR mode matches direct evaluation, including across reorders
+  - AND stops at the first false leaf
+  - fn_predicate adapter
+*/
+bool
+d_tests_sa_predicate_adaptive_eval
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                         result;
+    struct d_predicate_adaptive* adaptive;
+    struct d_predicate_leaf      leaves[3];
+    int                          threshold;
+    int                          calls;
+    int                          value;
+    bool                         ok;
+
+    result    = true;
+    threshold = 5;
+
+    // test 1: NULL combinator
+    value  = 2;
+    result = d_assert_standalone(
+        !d_predicate_adaptive_eval(NULL, &value),
+        "adaptive_eval_null",
+        "NULL combinator should evaluate to false",
+        _counter) && result;
+
+    leaves[0].predicate = pred_is_even;
+    leaves[0].context   = NULL;
+    leaves[1].predicate = pred_greater_than_threshold;
+    leaves[1].context   = &threshold;
+    leaves[2].predicate = pred_is_positive;
+    leaves[2].context   = NULL;
+
+    // test 2: AND mode, with frequent reorders
+    adaptive = d_predicate_adaptive_new(D_PREDICATE_ADAPTIVE_AND, leaves, 3);
+
+    if (adaptive)
+    {
+        adaptive->reorder_interval = 7;
+        adaptive->next_reorder     = 7;
+        ok                         = true;
+
+        for (value = -50; (ok) && (value <= 50); value++)
+        {
+            ok = ( d_predicate_adaptive_eval(adaptive, &value) ==
+                   ( ((value % 2) == 0) &&
+                     (value > threshold) &&
+                     (value > 0) ) );
+        }
+
+        result = d_assert_standalone(
+            ok && (adaptive->reorders > 0),
+            "adaptive_eval_and",
+            "AND mode should match direct evaluation across reorders",
+            _counter) && result;
+
+        d_predicate_adaptive_free(adaptive);
+    }
+
+    // test 3: OR mode, with frequent reorders
+    adaptive = d_predicate_adaptive_new(D_PREDICATE_ADAPTIVE_OR, leaves, 3);
+
+    if (adaptive)
+    {
+        adaptive->reorder_interval = 7;
+        adaptive->next_reorder     = 7;
+        ok                         = true;
+
+        for (value = -50; (ok) && (value <= 50); value++)
+        {
+            ok = ( d_predicate_adaptive_eval(adaptive, &value) ==
+                   ( ((value % 2) == 0) ||
+                     (value > threshold) ||
+                     (value > 0) ) );
+        }
+
+        result = d_assert_standalone(
+            ok && (adaptive->reorders > 0),
+            "adaptive_eval_or",
+            "OR mode should match direct evaluation across reorders",
+            _counter) && result;
+
+        d_predicate_adaptive_free(adaptive);
+    }
+
+    // test 4: AND stops at the first false leaf
+    calls               = 0;
+    leaves[0].predicate = pred_always_false;
+    leaves[0].context   = NULL;
+    leaves[1].predicate = pred_counted_is_even;
+    leaves[1].context   = &calls;
+
+    adaptive = d_predicate_adaptive_new(D_PREDICATE_ADAPTIVE_AND, leaves, 2);
+
+    if (adaptive)
+    {
+        value = 4;
+
+        result = d_assert_standalone(
+            (!d_predicate_adaptive_eval(adaptive, &value)) &&
+            (calls == 0)                                   &&
+            (adaptive->leaves[0].decisive == 1),
+            "adaptive_eval_short_circuit",
+            "AND should stop at the first false leaf",
+            _counter) && result;
+
+        // test 5: fn_predicate adapter
+        result = d_assert_standalone(
+            (!d_predicate_adaptive_test(&value, adaptive)) &&
+            (adaptive->evaluations == 2),
+            "adaptive_test_adapter",
+            "fn_predicate adapter should evaluate the combinator",
+            _counter) && result;
+
+        d_predicate_adaptive_free(adaptive);
+    }
+
+    return result;
+}
+
+
+/*
+d_tests_sa_predicate_adaptive_reorder
+  Tests leaf reordering of d_predicate_adaptive.
+  Tests the following:
+  - NULL combinator is a no-op
+  - AND moves a frequently false leaf ahead of a never-false leaf
+  - OR moves a frequently true leaf ahead of a never-true leaf
+  - reordering skips the non-decisive leaf on later evaluations
+  - counters are aged after a reorder
+*/
+bool
+d_tests_sa_predicate_adaptive_reorder
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                         result;
+    struct d_predicate_adaptive* adaptive;
+    struct d_predicate_leaf      leaves[2];
+    int                          calls;
+    int                          value;
+    int                          i;
+
+    result = true;
+
+    // test 1: NULL combinator
+    d_predicate_adaptive_reorder(NULL);
+
+    result = d_assert_standalone(
+        true,
+        "adaptive_reorder_null",
+        "reordering NULL should not crash",
+        _counter) && result;
+
+    // test 2: AND over odd values; is_even decides every time
+    calls               = 0;
+    leaves[0].predicate = pred_always_true;
+    leaves[0].context   = NULL;
+    leaves[1].predicate = pred_counted_is_even;
+    leaves[1].context   = &calls;
+
+    adaptive = d_predicate_adaptive_new(D_PREDICATE_ADAPTIVE_AND, leaves, 2);
+
+    if (adaptive)
+    {
+        adaptive->reorder_interval = 64;
+        adaptive->next_reorder     = 64;
+
+        for (i = 0; i < 64; i++)
+        {
+            value = (2 * i) + 1;
+            d_predicate_adaptive_eval(adaptive, &value);
+        }
+
+        result = d_assert_standalone(
+            (adaptive->reorders == 1)         &&
+            (adaptive->leaves[0].index == 1)  &&
+            (adaptive->leaves[1].index == 0),
+            "adaptive_reorder_and",
+            "AND should move the decisive leaf first",
+            _counter) && result;
+
+        // test 3: counters were halved by the reorder
+        result = d_assert_standalone(
+            (adaptive->leaves[0].calls == 32) &&
+            (adaptive->leaves[0].decisive == 32),
+            "adaptive_reorder_aging",
+            "counters should be halved after a reorder",
+            _counter) && result;
+
+        // test 4: the non-decisive leaf is no longer evaluated
+        value = 3;
+        d_predicate_adaptive_eval(adaptive, &value);
+
+        result = d_assert_standalone(
+            (calls == 65) &&
+            (adaptive->leaves[1].calls == 32),
+            "adaptive_reorder_skips_leaf",
+            "after reordering the non-decisive leaf should be skipped",
+            _counter) && result;
+
+        d_predicate_adaptive_free(adaptive);
+    }
+
+    // test 5: OR over even values; is_even decides every time
+    calls               = 0;
+    leaves[0].predicate = pred_always_false;
+    leaves[0].context   = NULL;
+
+    adaptive = d_predicate_adaptive_new(D_PREDICATE_ADAPTIVE_OR, leaves, 2);
+
+    if (adaptive)
+    {
+        adaptive->reorder_interval = 64;
+        adaptive->next_reorder     = 64;
+
+        for (i = 0; i < 64; i++)
+        {
+            value = 2 * i;
+            d_predicate_adaptive_eval(adaptive, &value);
+        }
+
+        result = d_assert_standalone(
+            (adaptive->reorders == 1)        &&
+            (adaptive->leaves[0].index == 1) &&
+            (adaptive->leaves[1].index == 0),
+            "adaptive_reorder_or",
+            "OR should move the decisive leaf first",
+            _counter) && result;
+
+        d_predicate_adaptive_free(adaptive);
+    }
+
+    return result;
+}
+
+
+/*
+d_tests_sa_predicate_adaptive_snapshot
+  Tests the d_predicate_adaptive_snapshot function.
+  Tests the following:
+  - NULL parameter rejection
+  - snapshot reflects the most recent reorder, by original index
+  - evaluations published at the reorder
+  - capacity smaller than the leaf count truncates the copy
+*/
+bool
+d_tests_sa_predicate_adaptive_snapshot
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                              result;
+    struct d_predicate_adaptive*      adaptive;
+    struct d_predicate_leaf           leaves[2];
+    struct d_predicate_adaptive_stats stats[2];
+    uint64_t                          evaluations;
+    int                               value;
+    int                               i;
+
+    result = true;
+
+    leaves[0].predicate = pred_always_true;
+    leaves[0].context   = NULL;
+    leaves[1].predicate = pred_is_even;
+    leaves[1].context   = NULL;
+
+    adaptive = d_predicate_adaptive_new(D_PREDICATE_ADAPTIVE_AND, leaves, 2);
+
+    // test 1: NULL parameters
+    result = d_assert_standalone(
+        (d_predicate_adaptive_snapshot(NULL, stats, 2, NULL) == 0) &&
+        (d_predicate_adaptive_snapshot(adaptive, NULL, 2, NULL) == 0),
+        "adaptive_snapshot_null_params",
+        "NULL parameters should return 0",
+        _counter) && result;
+
+    if (!adaptive)
+    {
+        return result;
+    }
+
+    adaptive->reorder_interval = 16;
+    adaptive->next_reorder     = 16;
+
+    // 20 odd values: one reorder at 16, 4 evaluations unpublished
+    for (i = 0; i < 20; i++)
+    {
+        value = (2 * i) + 1;
+        d_predicate_adaptive_eval(adaptive, &value);
+    }
+
+    // test 2: published statistics
+    evaluations = 0;
+
+    result = d_assert_standalone(
+        (d_predicate_adaptive_snapshot(adaptive,
+                                       stats,
+                                       2,
+                                       &evaluations) == 2) &&
+        (evaluations == 16)                                  &&
+        (stats[0].index == 0)                                &&
+        (stats[0].position == 1)                             &&
+        (stats[0].calls == 16)                               &&
+        (stats[0].decisive == 0)                             &&
+        (stats[1].index == 1)                                &&
+        (stats[1].position == 0)                             &&
+        (stats[1].decisive == 16)                            &&
+        (stats[1].rank < stats[0].rank),
+        "adaptive_snapshot_published",
+        "snapshot should hold the statistics of the last reorder",
+        _counter) && result;
+
+    // test 3: truncated copy
+    stats[1].calls = 12345;
+
+    result = d_assert_standalone(
+        (d_predicate_adaptive_snapshot(adaptive, stats, 1, NULL) == 1) &&
+        (stats[0].index == 0)                                        &&
+        (stats[1].calls == 12345),
+        "adaptive_snapshot_capacity",
+        "snapshot should copy at most _capacity entries",
+        _counter) && result;
+
+    d_predicate_adaptive_free(adaptive);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_predicate_adaptive_all
+  Aggregation function that runs all adaptive combinator tests.
+*/
+bool
+d_tests_sa_predicate_adaptive_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Adaptive Combinators\n");
+    printf("  -------------------------------\n");
+
+    result = d_tests_sa_predicate_adaptive_new(_counter) && result;
+    result = d_tests_sa_predicate_adaptive_eval(_counter) && result;
+    result = d_tests_sa_predicate_adaptive_reorder(_counter) && result;
+    result = d_tests_sa_predicate_adaptive_snapshot(_counter) && result;
+
+    return result;
+}
@@ -56,7 +56,7 @@ d_tests_sa_predicate_and_new
             "contexts should be NULL",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 2: successful creation with contexts
@@ -90,7 +90,7 @@ d_tests_sa_predicate_and_new
             "context2 should be NULL",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 3: creation with NULL predicates (allowed, fails in eval)
@@ -109,7 +109,7 @@ d_tests_sa_predicate_and_new
             "NULL predicates should be stored",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     return result;
@@ -160,7 +160,7 @@ d_tests_sa_predicate_or_new
             "predicate2 should be set correctly",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 2: successful creation with context
@@ -188,7 +188,7 @@ d_tests_sa_predicate_or_new
             "context2 should be NULL",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     return result;
@@ -245,7 +245,7 @@ d_tests_sa_predicate_xor_new
             "contexts should be NULL",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 2: creation with mixed predicates
@@ -273,7 +273,7 @@ d_tests_sa_predicate_xor_new
             "predicate2 should be always_false",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     return result;
@@ -324,7 +324,7 @@ d_tests_sa_predicate_not_new
             "context should be NULL",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 2: successful creation with context
@@ -349,7 +349,7 @@ d_tests_sa_predicate_not_new
             "context should point to context_val",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 3: creation with always_false predicate
@@ -368,7 +368,7 @@ d_tests_sa_predicate_not_new
             "predicate should be always_false",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     return result;
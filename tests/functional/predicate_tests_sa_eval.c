@@ -52,7 +52,7 @@ d_tests_sa_predicate_and_eval
             "NULL predicate1 should return false",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 3: NULL predicate2 should return false
@@ -66,7 +66,7 @@ d_tests_sa_predicate_and_eval
             "NULL predicate2 should return false",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 4: both NULL predicates should return false
@@ -80,7 +80,7 @@ d_tests_sa_predicate_and_eval
             "both NULL predicates should return false",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 5: true AND true = true
@@ -98,7 +98,7 @@ d_tests_sa_predicate_and_eval
             "true AND true should return true",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 6: true AND false = false
@@ -116,7 +116,7 @@ d_tests_sa_predicate_and_eval
             "true AND false should return false",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 7: false AND true = false (short-circuit test)
@@ -134,7 +134,7 @@ d_tests_sa_predicate_and_eval
             "false AND true should return false (short-circuit)",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 8: false AND false = false
@@ -152,7 +152,7 @@ d_tests_sa_predicate_and_eval
             "false AND false should return false",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 9: even AND positive (both true)
@@ -184,7 +184,7 @@ d_tests_sa_predicate_and_eval
             "-4 is negative, so even AND positive = false",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 10: context usage
@@ -219,7 +219,7 @@ d_tests_sa_predicate_and_eval
             "2 is even but 2 <= 5 = false",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 11: NULL element handling
@@ -233,7 +233,7 @@ d_tests_sa_predicate_and_eval
             "NULL element should return false (predicates check for NULL)",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 12: zero boundary value (0 is even but not positive)
@@ -248,7 +248,7 @@ d_tests_sa_predicate_and_eval
             "0 is even but not positive, so AND = false",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     return result;
@@ -305,7 +305,7 @@ d_tests_sa_predicate_or_eval
             "NULL predicate1 should return false",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 3: NULL predicate2 should return false
@@ -319,7 +319,7 @@ d_tests_sa_predicate_or_eval
             "NULL predicate2 should return false",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 4: both NULL predicates should return false
@@ -333,7 +333,7 @@ d_tests_sa_predicate_or_eval
             "both NULL predicates should return false",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 5: true OR true = true
@@ -348,7 +348,7 @@ d_tests_sa_predicate_or_eval
             "true OR true should return true",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 6: true OR false = true (short-circuit test)
@@ -366,7 +366,7 @@ d_tests_sa_predicate_or_eval
             "true OR false should return true (short-circuit)",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 7: false OR true = true
@@ -384,7 +384,7 @@ d_tests_sa_predicate_or_eval
             "false OR true should return true",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 8: false OR false = false
@@ -402,7 +402,7 @@ d_tests_sa_predicate_or_eval
             "false OR false should return false",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 9: even OR positive
@@ -442,7 +442,7 @@ d_tests_sa_predicate_or_eval
             "-3 is odd and negative, so even OR positive = false",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 10: context usage
@@ -477,7 +477,7 @@ d_tests_sa_predicate_or_eval
             "3 <= 5 and not negative = false",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 11: NULL element handling
@@ -491,7 +491,7 @@ d_tests_sa_predicate_or_eval
             "NULL element should return false (both predicates return false)",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 12: zero boundary value (0 is even but not positive)
@@ -506,7 +506,7 @@ d_tests_sa_predicate_or_eval
             "0 is even, so even OR positive = true",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     return result;
@@ -563,7 +563,7 @@ d_tests_sa_predicate_xor_eval
             "NULL predicate1 should return false",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 3: NULL predicate2 should return false
@@ -577,7 +577,7 @@ d_tests_sa_predicate_xor_eval
             "NULL predicate2 should return false",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 4: both NULL predicates should return false
@@ -591,7 +591,7 @@ d_tests_sa_predicate_xor_eval
             "both NULL predicates should return false",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 5: true XOR true = false
@@ -609,7 +609,7 @@ d_tests_sa_predicate_xor_eval
             "true XOR true should return false",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 6: true XOR false = true
@@ -627,7 +627,7 @@ d_tests_sa_predicate_xor_eval
             "true XOR false should return true",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 7: false XOR true = true
@@ -645,7 +645,7 @@ d_tests_sa_predicate_xor_eval
             "false XOR true should return true",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 8: false XOR false = false
@@ -663,7 +663,7 @@ d_tests_sa_predicate_xor_eval
             "false XOR false should return false",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 9: even XOR odd (mutually exclusive)
@@ -687,7 +687,7 @@ d_tests_sa_predicate_xor_eval
             "5 is even XOR odd = true",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 10: even XOR positive (can both be true)
@@ -727,7 +727,7 @@ d_tests_sa_predicate_xor_eval
             "-3 is neither even nor positive, XOR = false",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 11: context usage (greater_than_threshold XOR is_even)
@@ -770,7 +770,7 @@ d_tests_sa_predicate_xor_eval
             "3 <= 5 and odd, XOR = false",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 12: NULL element handling
@@ -784,7 +784,7 @@ d_tests_sa_predicate_xor_eval
             "NULL element: both return false, XOR = false",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     return result;
@@ -836,7 +836,7 @@ d_tests_sa_predicate_not_eval
             "NULL predicate should return false",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 3: NOT true = false
@@ -851,7 +851,7 @@ d_tests_sa_predicate_not_eval
             "NOT true should return false",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 4: NOT false = true
@@ -866,7 +866,7 @@ d_tests_sa_predicate_not_eval
             "NOT false should return true",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 5: NOT is_even
@@ -890,7 +890,7 @@ d_tests_sa_predicate_not_eval
             "NOT even(5) should return true",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 6: NOT is_positive
@@ -922,7 +922,7 @@ d_tests_sa_predicate_not_eval
             "NOT positive(0) should return true",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 7: context usage
@@ -954,7 +954,7 @@ d_tests_sa_predicate_not_eval
             "NOT (5 > 5) should return true",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     // test 8: NULL element handling
@@ -968,7 +968,7 @@ d_tests_sa_predicate_not_eval
             "NOT (pred returns false for NULL) should return true",
             _counter) && result;
 
-        free(combo);
+        d_functional_free(combo);
     }
 
     return result;
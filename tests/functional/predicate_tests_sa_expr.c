@@ -0,0 +1,797 @@
+#include ".\predicate_tests_sa.h"
+#include ".\predicate_tests_sa_helpers.h"
+
+
+/*
+d_tests_sa_predicate_expr_build
+  Tests the d_predicate_expr builder functions.
+  Tests the following:
+  - NULL builder rejection for every builder function
+  - empty builder initialization
+  - NULL leaf predicate rejection marks the builder as failed
+  - combinator with more operands than pending subexpressions fails
+  - zero-arity combinator fails
+  - node spans and pending count after combining
+*/
+bool
+d_tests_sa_predicate_expr_build
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                     result;
+    struct d_predicate_expr* expr;
+
+    result = true;
+
+    // test 1: NULL builder rejection
+    result = d_assert_standalone(
+        (!d_predicate_expr_leaf(NULL, pred_always_true, NULL)) &&
+        (!d_predicate_expr_and(NULL, 2))                       &&
+        (!d_predicate_expr_or(NULL, 2))                        &&
+        (!d_predicate_expr_xor(NULL, 2))                       &&
+        (!d_predicate_expr_not(NULL))                          &&
+        (!d_predicate_expr_n_of(NULL, 1, 2))                   &&
+        (d_predicate_expr_compile(NULL) == NULL),
+        "expr_build_null_builder",
+        "builder functions should reject a NULL builder",
+        _counter) && result;
+
+    // test 2: empty builder initialization
+    expr = d_predicate_expr_new();
+
+    result = d_assert_standalone(
+        expr != NULL,
+        "expr_build_new",
+        "d_predicate_expr_new should return a builder",
+        _counter) && result;
+
+    if (expr)
+    {
+        result = d_assert_standalone(
+            (expr->node_count == 0) &&
+            (expr->leaf_count == 0) &&
+            (expr->pending == 0)    &&
+            (!expr->failed),
+            "expr_build_new_empty",
+            "new builder should be empty",
+            _counter) && result;
+
+        // test 3: an empty builder cannot be compiled
+        result = d_assert_standalone(
+            d_predicate_expr_compile(expr) == NULL,
+            "expr_build_compile_empty",
+            "empty builder should not compile",
+            _counter) && result;
+
+        d_predicate_expr_free(expr);
+    }
+
+    // test 4: NULL leaf predicate marks the builder as failed
+    expr = d_predicate_expr_new();
+
+    if (expr)
+    {
+        result = d_assert_standalone(
+            (!d_predicate_expr_leaf(expr, NULL, NULL)) &&
+            (expr->failed),
+            "expr_build_null_leaf",
+            "NULL leaf predicate should fail the builder",
+            _counter) && result;
+
+        d_predicate_expr_leaf(expr, pred_always_true, NULL);
+
+        result = d_assert_standalone(
+            d_predicate_expr_compile(expr) == NULL,
+            "expr_build_failed_no_compile",
+            "failed builder should not compile",
+            _counter) && result;
+
+        d_predicate_expr_free(expr);
+    }
+
+    // test 5: too few pending operands
+    expr = d_predicate_expr_new();
+
+    if (expr)
+    {
+        d_predicate_expr_leaf(expr, pred_always_true, NULL);
+
+        result = d_assert_standalone(
+            (!d_predicate_expr_and(expr, 2)) &&
+            (expr->failed),
+            "expr_build_arity_underflow",
+            "combining more operands than pending should fail",
+            _counter) && result;
+
+        d_predicate_expr_free(expr);
+    }
+
+    // test 6: zero arity
+    expr = d_predicate_expr_new();
+
+    if (expr)
+    {
+        d_predicate_expr_leaf(expr, pred_always_true, NULL);
+
+        result = d_assert_standalone(
+            (!d_predicate_expr_or(expr, 0)) &&
+            (expr->failed),
+            "expr_build_zero_arity",
+            "zero-arity combinator should fail",
+            _counter) && result;
+
+        d_predicate_expr_free(expr);
+    }
+
+    // test 7: spans and pending count for (a AND b) OR NOT c
+    expr = d_predicate_expr_new();
+
+    if (expr)
+    {
+        d_predicate_expr_leaf(expr, pred_is_even, NULL);
+        d_predicate_expr_leaf(expr, pred_is_positive, NULL);
+        d_predicate_expr_and(expr, 2);
+        d_predicate_expr_leaf(expr, pred_is_negative, NULL);
+        d_predicate_expr_not(expr);
+        d_predicate_expr_or(expr, 2);
+
+        result = d_assert_standalone(
+            (expr->node_count == 6)     &&
+            (expr->leaf_count == 3)     &&
+            (expr->pending == 1)        &&
+            (expr->nodes[2].span == 3)  &&
+            (expr->nodes[4].span == 2)  &&
+            (expr->nodes[5].span == 6),
+            "expr_build_spans",
+            "node spans should cover each subtree",
+            _counter) && result;
+
+        d_predicate_expr_free(expr);
+    }
+
+    return result;
+}
+
+
+/*
+d_tests_sa_predicate_expr_compile
+  Tests the d_predicate_expr_compile function.
+  Tests the following:
+  - more than one pending subexpression is rejected
+  - leaves are copied into the program
+  - nested AND/AND is flattened into one conjunction
+  - NOT(NOT x) compiles to x
+  - NOT(a OR b) is rewritten to !a AND !b without a NOT instruction
+  - N_OF thresholds of 0 and > arity compile to a single constant
+  - the program outlives its builder
+*/
+bool
+d_tests_sa_predicate_expr_compile
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                        result;
+    struct d_predicate_expr*    expr;
+    struct d_predicate_expr*    flat;
+    struct d_predicate_program* program;
+    struct d_predicate_program* flat_program;
+    int                         value;
+
+    result = true;
+
+    // test 1: two pending subexpressions are rejected
+    expr = d_predicate_expr_new();
+
+    if (expr)
+    {
+        d_predicate_expr_leaf(expr, pred_always_true, NULL);
+        d_predicate_expr_leaf(expr, pred_always_false, NULL);
+
+        result = d_assert_standalone(
+            d_predicate_expr_compile(expr) == NULL,
+            "expr_compile_two_pending",
+            "builder with two pending subexpressions should not compile",
+            _counter) && result;
+
+        d_predicate_expr_free(expr);
+    }
+
+    // test 2: a AND (b AND c) flattens to the same code as AND(a, b, c)
+    expr = d_predicate_expr_new();
+    flat = d_predicate_expr_new();
+
+    if ( (expr) &&
+         (flat) )
+    {
+        d_predicate_expr_leaf(expr, pred_is_even, NULL);
+        d_predicate_expr_leaf(expr, pred_is_positive, NULL);
+        d_predicate_expr_leaf(expr, pred_always_true, NULL);
+        d_predicate_expr_and(expr, 2);
+        d_predicate_expr_and(expr, 2);
+
+        d_predicate_expr_leaf(flat, pred_is_even, NULL);
+        d_predicate_expr_leaf(flat, pred_is_positive, NULL);
+        d_predicate_expr_leaf(flat, pred_always_true, NULL);
+        d_predicate_expr_and(flat, 3);
+
+        program      = d_predicate_expr_compile(expr);
+        flat_program = d_predicate_expr_compile(flat);
+
+        result = d_assert_standalone(
+            (program != NULL)                                 &&
+            (flat_program != NULL)                            &&
+            (program->leaf_count == 3)                        &&
+            (program->code_count == flat_program->code_count) &&
+            (program->code_count == 5)                        &&
+            (program->max_depth == 0),
+            "expr_compile_flatten_and",
+            "nested AND should flatten into one 3-way conjunction",
+            _counter) && result;
+
+        d_predicate_program_free(program);
+        d_predicate_program_free(flat_program);
+    }
+
+    d_predicate_expr_free(expr);
+    d_predicate_expr_free(flat);
+
+    // test 3: NOT(NOT x) compiles to a single leaf
+    expr = d_predicate_expr_new();
+
+    if (expr)
+    {
+        d_predicate_expr_leaf(expr, pred_is_even, NULL);
+        d_predicate_expr_not(expr);
+        d_predicate_expr_not(expr);
+
+        program = d_predicate_expr_compile(expr);
+        value   = 4;
+
+        result = d_assert_standalone(
+            (program != NULL)                          &&
+            (program->code_count == 1)                 &&
+            (program->code[0].negate == 0)             &&
+            (d_predicate_program_eval(program, &value)),
+            "expr_compile_double_not",
+            "NOT(NOT x) should compile to x",
+            _counter) && result;
+
+        d_predicate_program_free(program);
+        d_predicate_expr_free(expr);
+    }
+
+    // test 4: NOT(a OR b) becomes !a AND !b
+    expr = d_predicate_expr_new();
+
+    if (expr)
+    {
+        d_predicate_expr_leaf(expr, pred_is_even, NULL);
+        d_predicate_expr_leaf(expr, pred_is_negative, NULL);
+        d_predicate_expr_or(expr, 2);
+        d_predicate_expr_not(expr);
+
+        program = d_predicate_expr_compile(expr);
+
+        result = d_assert_standalone(
+            (program != NULL)              &&
+            (program->code_count == 3)     &&
+            (program->code[0].negate == 1) &&
+            (program->code[2].negate == 1),
+            "expr_compile_de_morgan",
+            "NOT(a OR b) should push negation into the leaves",
+            _counter) && result;
+
+        d_predicate_program_free(program);
+        d_predicate_expr_free(expr);
+    }
+
+    // test 5: decided N_OF thresholds become constants
+    expr = d_predicate_expr_new();
+
+    if (expr)
+    {
+        d_predicate_expr_leaf(expr, pred_always_false, NULL);
+        d_predicate_expr_leaf(expr, pred_always_false, NULL);
+        d_predicate_expr_n_of(expr, 0, 2);
+
+        program = d_predicate_expr_compile(expr);
+        value   = 1;
+
+        result = d_assert_standalone(
+            (program != NULL)          &&
+            (program->code_count == 1) &&
+            (d_predicate_program_eval(program, &value)),
+            "expr_compile_n_of_zero",
+            "0-of-n should compile to constant true",
+            _counter) && result;
+
+        d_predicate_program_free(program);
+        d_predicate_expr_free(expr);
+    }
+
+    expr = d_predicate_expr_new();
+
+    if (expr)
+    {
+        d_predicate_expr_leaf(expr, pred_always_true, NULL);
+        d_predicate_expr_leaf(expr, pred_always_true, NULL);
+        d_predicate_expr_n_of(expr, 3, 2);
+
+        program = d_predicate_expr_compile(expr);
+        value   = 1;
+
+        result = d_assert_standalone(
+            (program != NULL)          &&
+            (program->code_count == 1) &&
+            (!d_predicate_program_eval(program, &value)),
+            "expr_compile_n_of_unreachable",
+            "3-of-2 should compile to constant false",
+            _counter) && result;
+
+        d_predicate_program_free(program);
+        d_predicate_expr_free(expr);
+    }
+
+    // test 6: program is independent of its builder
+    expr = d_predicate_expr_new();
+
+    if (expr)
+    {
+        d_predicate_expr_leaf(expr, pred_is_even, NULL);
+        program = d_predicate_expr_compile(expr);
+        d_predicate_expr_free(expr);
+        value   = 6;
+
+        result = d_assert_standalone(
+            (program != NULL) &&
+            (d_predicate_program_eval(program, &value)),
+            "expr_compile_outlives_builder",
+            "program should remain valid after freeing the builder",
+            _counter) && result;
+
+        d_predicate_program_free(program);
+    }
+
+    return result;
+}
+
+
+/*
+d_tests_sa_predicate_program_eval
+  Tests the d_predicate_program_eval and d_predicate_program_test functions.
+  Tests the following:
+  - NULL program returns false
+  - AND / OR / XOR / NOT truth on real predicates
+  - leaf context passing
+  - N_OF threshold semantics
+  - XOR of three operands and negated XOR
+  - fn_predicate adapter matches direct evaluation
+*/
+bool
+d_tests_sa_predicate_program_eval
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                        result;
+    struct d_predicate_expr*    expr;
+    struct d_predicate_program* program;
+    int                         values[6] = { -4, -3, 0, 3, 4, 10 };
+    int                         threshold;
+    int                         value;
+    size_t                      i;
+    bool                        ok;
+
+    result    = true;
+    threshold = 3;
+
+    // test 1: NULL program
+    value  = 2;
+    result = d_assert_standalone(
+        !d_predicate_program_eval(NULL, &value),
+        "program_eval_null_program",
+        "NULL program should evaluate to false",
+        _counter) && result;
+
+    // test 2: (even AND > threshold) OR NOT positive
+    expr = d_predicate_expr_new();
+
+    if (expr)
+    {
+        d_predicate_expr_leaf(expr, pred_is_even, NULL);
+        d_predicate_expr_leaf(expr, pred_greater_than_threshold, &threshold);
+        d_predicate_expr_and(expr, 2);
+        d_predicate_expr_leaf(expr, pred_is_positive, NULL);
+        d_predicate_expr_not(expr);
+        d_predicate_expr_or(expr, 2);
+
+        program = d_predicate_expr_compile(expr);
+        ok      = (program != NULL);
+
+        for (i = 0; (ok) && (i < 6); i++)
+        {
+            ok = ( d_predicate_program_eval(program, &values[i]) ==
+                   ( ( ((values[i] % 2) == 0) && (values[i] > threshold) ) ||
+                     (!(values[i] > 0)) ) );
+        }
+
+        result = d_assert_standalone(
+            ok,
+            "program_eval_and_or_not",
+            "(even AND > 3) OR NOT positive should match direct evaluation",
+            _counter) && result;
+
+        d_predicate_program_free(program);
+        d_predicate_expr_free(expr);
+    }
+
+    // test 3: 2-of-3 (even, positive, > threshold)
+    expr = d_predicate_expr_new();
+
+    if (expr)
+    {
+        d_predicate_expr_leaf(expr, pred_is_even, NULL);
+        d_predicate_expr_leaf(expr, pred_is_positive, NULL);
+        d_predicate_expr_leaf(expr, pred_greater_than_threshold, &threshold);
+        d_predicate_expr_n_of(expr, 2, 3);
+
+        program = d_predicate_expr_compile(expr);
+        ok      = (program != NULL);
+
+        for (i = 0; (ok) && (i < 6); i++)
+        {
+            ok = ( d_predicate_program_eval(program, &values[i]) ==
+                   ( ( (((values[i] % 2) == 0) ? 1 : 0) +
+                       ((values[i] > 0) ? 1 : 0)         +
+                       ((values[i] > threshold) ? 1 : 0) ) >= 2 ) );
+        }
+
+        result = d_assert_standalone(
+            ok,
+            "program_eval_n_of",
+            "2-of-3 should match direct evaluation",
+            _counter) && result;
+
+        d_predicate_program_free(program);
+        d_predicate_expr_free(expr);
+    }
+
+    // test 4: XOR of three operands and its negation
+    expr = d_predicate_expr_new();
+
+    if (expr)
+    {
+        d_predicate_expr_leaf(expr, pred_is_even, NULL);
+        d_predicate_expr_leaf(expr, pred_is_positive, NULL);
+        d_predicate_expr_leaf(expr, pred_is_negative, NULL);
+        d_predicate_expr_xor(expr, 3);
+
+        program = d_predicate_expr_compile(expr);
+        ok      = ( (program != NULL) &&
+                    (program->max_depth == 1) );
+
+        for (i = 0; (ok) && (i < 6); i++)
+        {
+            ok = ( d_predicate_program_eval(program, &values[i]) ==
+                   ( ( ((values[i] % 2) == 0) !=
+                       (values[i] > 0) ) !=
+                     (values[i] < 0) ) );
+        }
+
+        result = d_assert_standalone(
+            ok,
+            "program_eval_xor3",
+            "3-way XOR should be true for an odd number of true operands",
+            _counter) && result;
+
+        d_predicate_program_free(program);
+
+        d_predicate_expr_not(expr);
+        program = d_predicate_expr_compile(expr);
+        ok      = (program != NULL);
+
+        for (i = 0; (ok) && (i < 6); i++)
+        {
+            ok = ( d_predicate_program_eval(program, &values[i]) ==
+                   !( ( ((values[i] % 2) == 0) !=
+                        (values[i] > 0) ) !=
+                      (values[i] < 0) ) );
+        }
+
+        result = d_assert_standalone(
+            ok,
+            "program_eval_not_xor3",
+            "NOT XOR should invert the 3-way XOR",
+            _counter) && result;
+
+        d_predicate_program_free(program);
+        d_predicate_expr_free(expr);
+    }
+
+    // test 5: fn_predicate adapter
+    expr = d_predicate_expr_new();
+
+    if (expr)
+    {
+        d_predicate_expr_leaf(expr, pred_is_even, NULL);
+        d_predicate_expr_leaf(expr, pred_is_negative, NULL);
+        d_predicate_expr_or(expr, 2);
+
+        program = d_predicate_expr_compile(expr);
+        ok      = (program != NULL);
+
+        for (i = 0; (ok) && (i < 6); i++)
+        {
+            ok = ( d_predicate_program_test(&values[i], program) ==
+                   d_predicate_program_eval(program, &values[i]) );
+        }
+
+        result = d_assert_standalone(
+            ok,
+            "program_test_adapter",
+            "fn_predicate adapter should match direct evaluation",
+            _counter) && result;
+
+        d_predicate_program_free(program);
+        d_predicate_expr_free(expr);
+    }
+
+    return result;
+}
+
+
+/*
+d_tests_sa_predicate_program_short_circuit
+  Tests that compiled programs stop evaluating leaves once decided.
+  Tests the following:
+  - AND stops at the first false operand
+  - OR stops at the first true operand
+  - N_OF stops once the threshold is reached
+  - N_OF stops once the threshold becomes unreachable
+*/
+bool
+d_tests_sa_predicate_program_short_circuit
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                        result;
+    struct d_predicate_expr*    expr;
+    struct d_predicate_program* program;
+    int                         calls;
+    int                         value;
+
+    result = true;
+
+    // test 1: AND(false, counted, counted) evaluates no counted leaf
+    expr = d_predicate_expr_new();
+
+    if (expr)
+    {
+        calls = 0;
+        value = 2;
+
+        d_predicate_expr_leaf(expr, pred_always_false, NULL);
+        d_predicate_expr_leaf(expr, pred_counted_is_even, &calls);
+        d_predicate_expr_leaf(expr, pred_counted_is_even, &calls);
+        d_predicate_expr_and(expr, 3);
+
+        program = d_predicate_expr_compile(expr);
+
+        result = d_assert_standalone(
+            (program != NULL)                          &&
+            (!d_predicate_program_eval(program, &value)) &&
+            (calls == 0),
+            "program_short_circuit_and",
+            "AND should stop at the first false operand",
+            _counter) && result;
+
+        d_predicate_program_free(program);
+        d_predicate_expr_free(expr);
+    }
+
+    // test 2: OR(counted, counted, counted) on an even value calls once
+    expr = d_predicate_expr_new();
+
+    if (expr)
+    {
+        calls = 0;
+        value = 2;
+
+        d_predicate_expr_leaf(expr, pred_counted_is_even, &calls);
+        d_predicate_expr_leaf(expr, pred_counted_is_even, &calls);
+        d_predicate_expr_leaf(expr, pred_counted_is_even, &calls);
+        d_predicate_expr_or(expr, 3);
+
+        program = d_predicate_expr_compile(expr);
+
+        result = d_assert_standalone(
+            (program != NULL)                         &&
+            (d_predicate_program_eval(program, &value)) &&
+            (calls == 1),
+            "program_short_circuit_or",
+            "OR should stop at the first true operand",
+            _counter) && result;
+
+        d_predicate_program_free(program);
+        d_predicate_expr_free(expr);
+    }
+
+    // test 3: 2-of-4 stops after two true operands
+    expr = d_predicate_expr_new();
+
+    if (expr)
+    {
+        calls = 0;
+        value = 2;
+
+        d_predicate_expr_leaf(expr, pred_counted_is_even, &calls);
+        d_predicate_expr_leaf(expr, pred_counted_is_even, &calls);
+        d_predicate_expr_leaf(expr, pred_counted_is_even, &calls);
+        d_predicate_expr_leaf(expr, pred_counted_is_even, &calls);
+        d_predicate_expr_n_of(expr, 2, 4);
+
+        program = d_predicate_expr_compile(expr);
+
+        result = d_assert_standalone(
+            (program != NULL)                         &&
+            (d_predicate_program_eval(program, &value)) &&
+            (calls == 2),
+            "program_short_circuit_n_of_reached",
+            "N_OF should stop once the threshold is reached",
+            _counter) && result;
+
+        // test 4: on an odd value, 2-of-4 is unreachable after 3 misses
+        calls = 0;
+        value = 3;
+
+        result = d_assert_standalone(
+            (program != NULL)                          &&
+            (!d_predicate_program_eval(program, &value)) &&
+            (calls == 3),
+            "program_short_circuit_n_of_unreachable",
+            "N_OF should stop once the threshold is unreachable",
+            _counter) && result;
+
+        d_predicate_program_free(program);
+        d_predicate_expr_free(expr);
+    }
+
+    return result;
+}
+
+
+/*
+d_tests_sa_predicate_program_eval_array
+  Tests the d_predicate_program_eval_array function.
+  Tests the following:
+  - NULL / zero parameter rejection
+  - match count and bitmask for a partial word
+  - bitmask across multiple 64-bit words
+  - stale bits in the destination are overwritten
+*/
+bool
+d_tests_sa_predicate_program_eval_array
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                        result;
+    struct d_predicate_expr*    expr;
+    struct d_predicate_program* program;
+    int                         values[130];
+    uint64_t                    mask[3];
+    size_t                      matches;
+    size_t                      i;
+    bool                        ok;
+
+    result  = true;
+    program = NULL;
+
+    for (i = 0; i < 130; i++)
+    {
+        values[i] = (int)i;
+    }
+
+    expr = d_predicate_expr_new();
+
+    if (expr)
+    {
+        d_predicate_expr_leaf(expr, pred_is_even, NULL);
+        program = d_predicate_expr_compile(expr);
+        d_predicate_expr_free(expr);
+    }
+
+    // test 1: parameter rejection
+    result = d_assert_standalone(
+        (d_predicate_program_eval_array(NULL, values, 4, sizeof(int), mask)
+             == 0) &&
+        (d_predicate_program_eval_array(program, NULL, 4, sizeof(int), mask)
+             == 0) &&
+        (d_predicate_program_eval_array(program, values, 4, sizeof(int), NULL)
+             == 0) &&
+        (d_predicate_program_eval_array(program, values, 0, sizeof(int), mask)
+             == 0) &&
+        (d_predicate_program_eval_array(program, values, 4, 0, mask)
+             == 0),
+        "program_eval_array_null_params",
+        "NULL or zero parameters should return 0",
+        _counter) && result;
+
+    if (!program)
+    {
+        return result;
+    }
+
+    // test 2: partial word
+    mask[0] = ~(uint64_t)0;
+    matches = d_predicate_program_eval_array(program,
+                                             values,
+                                             5,
+                                             sizeof(int),
+                                             mask);
+
+    result = d_assert_standalone(
+        (matches == 3) &&
+        (mask[0] == (uint64_t)0x15),
+        "program_eval_array_partial_word",
+        "evens of 0..4 should set bits 0, 2 and 4 and clear the rest",
+        _counter) && result;
+
+    // test 3: multiple words
+    mask[0] = 0;
+    mask[1] = 0;
+    mask[2] = ~(uint64_t)0;
+    matches = d_predicate_program_eval_array(program,
+                                             values,
+                                             130,
+                                             sizeof(int),
+                                             mask);
+    ok      = (matches == 65);
+
+    for (i = 0; (ok) && (i < 130); i++)
+    {
+        ok = ( (((mask[i / 64] >> (i % 64)) & 1) != 0) ==
+               ((i % 2) == 0) );
+    }
+
+    result = d_assert_standalone(
+        ok &&
+        (mask[2] == (uint64_t)0x1),
+        "program_eval_array_multi_word",
+        "bitmask should span words and overwrite stale bits",
+        _counter) && result;
+
+    d_predicate_program_free(program);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_predicate_expr_all
+  Aggregation function that runs all expression program tests.
+*/
+bool
+d_tests_sa_predicate_expr_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Expression Programs\n");
+    printf("  ------------------------------\n");
+
+    result = d_tests_sa_predicate_expr_build(_counter) && result;
+    result = d_tests_sa_predicate_expr_compile(_counter) && result;
+    result = d_tests_sa_predicate_program_eval(_counter) && result;
+    result = d_tests_sa_predicate_program_short_circuit(_counter) && result;
+    result = d_tests_sa_predicate_program_eval_array(_counter) && result;
+
+    return result;
+}
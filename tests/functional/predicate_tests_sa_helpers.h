@@ -168,5 +168,29 @@ pred_greater_than_threshold
     return (*value > *threshold);
 }
 
+// pred_counted_is_even
+//   helper: predicate that returns true if the int element is even and
+// increments the int call counter provided through _context. Used to
+// observe short-circuit evaluation.
+static inline bool
+pred_counted_is_even
+(
+    const void* _element,
+    void*       _context
+)
+{
+    if (_context)
+    {
+        (*(int*)_context)++;
+    }
+
+    if (!_element)
+    {
+        return false;
+    }
+
+    return ((*(const int*)_element % 2) == 0);
+}
+
 
 #endif  // DJINTERP_TESTS_PREDICATE_SA_HELPERS_
@@ -0,0 +1,27 @@
+#include ".\profile_tests_sa.h"
+
+
+/*
+d_tests_sa_profile_run_all
+  Module-level aggregation function that runs all profile tests.
+  Executes tests for all categories:
+  - Sessions: nesting, capacity, the hook, and formatting
+  - Instrumentation: filter chains, pipelines, fn_builders, and EXPLAIN
+    ANALYZE
+*/
+bool
+d_tests_sa_profile_run_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    // run all test categories
+    result = d_tests_sa_profile_session_all(_counter)    && result;
+    result = d_tests_sa_profile_instrument_all(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,60 @@
+/******************************************************************************
+* djinterp [test]                                          profile_tests_sa.h
+*
+*   Unit test declarations for `profile.h` module.
+*   Provides testing of profiling sessions (nesting, capacity, the hook,
+* report formatting) and of the instrumentation of filter chains,
+* pipelines, and fn_builders, including EXPLAIN ANALYZE. The
+* instrumentation tests check records only when the module is built with
+* D_FUNCTIONAL_PROFILE, and that there are none otherwise.
+*
+*
+* path:      \tests\functional\profile_tests_sa.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_TESTS_PROFILE_SA_
+#define DJINTERP_TESTS_PROFILE_SA_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "..\..\inc\djinterp.h"
+#include "..\..\inc\test\test_standalone.h"
+#include "..\..\inc\functional\functional.h"
+#include "..\..\inc\functional\filter.h"
+#include "..\..\inc\functional\profile.h"
+
+
+/******************************************************************************
+ * I. SESSION TESTS
+ *****************************************************************************/
+bool d_tests_sa_profile_session_nesting(struct d_test_counter* _counter);
+bool d_tests_sa_profile_session_hook(struct d_test_counter* _counter);
+bool d_tests_sa_profile_session_format(struct d_test_counter* _counter);
+
+// I.   aggregation function
+bool d_tests_sa_profile_session_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * II. INSTRUMENTATION TESTS
+ *****************************************************************************/
+bool d_tests_sa_profile_instrument_filter(struct d_test_counter* _counter);
+bool d_tests_sa_profile_instrument_pipeline(struct d_test_counter* _counter);
+bool d_tests_sa_profile_instrument_fn_builder(struct d_test_counter* _counter);
+bool d_tests_sa_profile_instrument_explain(struct d_test_counter* _counter);
+
+// II.  aggregation function
+bool d_tests_sa_profile_instrument_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * MODULE-LEVEL AGGREGATION
+ *****************************************************************************/
+bool d_tests_sa_profile_run_all(struct d_test_counter* _counter);
+
+
+#endif  // DJINTERP_TESTS_PROFILE_SA_
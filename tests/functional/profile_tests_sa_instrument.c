@@ -0,0 +1,425 @@
+#include ".\profile_tests_sa.h"
+
+
+// profile_is_even
+//   helper: predicate for even ints.
+static bool
+profile_is_even
+(
+    const void* _element,
+    void*       _context
+)
+{
+    (void)_context;
+
+    return ((*(const int*)_element) % 2) == 0;
+}
+
+// profile_above_five
+//   helper: predicate for ints greater than 5.
+static bool
+profile_above_five
+(
+    const void* _element,
+    void*       _context
+)
+{
+    (void)_context;
+
+    return (*(const int*)_element) > 5;
+}
+
+// profile_double
+//   helper: transformer doubling an int.
+static bool
+profile_double
+(
+    const void* _input,
+    void*       _output,
+    void*       _context
+)
+{
+    (void)_context;
+
+    *(int*)_output = (*(const int*)_input) * 2;
+
+    return true;
+}
+
+// profile_sum
+//   helper: accumulator summing ints.
+static bool
+profile_sum
+(
+    void*       _accumulated,
+    const void* _element,
+    void*       _context
+)
+{
+    (void)_context;
+
+    *(int*)_accumulated += *(const int*)_element;
+
+    return true;
+}
+
+// profile_chain
+//   helper: where(is_even) -> take_first(3).
+static struct d_filter_chain*
+profile_chain
+(
+    void
+)
+{
+    struct d_filter_chain*     chain;
+    struct d_filter_operation* op;
+
+    chain = d_filter_chain_new();
+
+    if (!chain)
+    {
+        return NULL;
+    }
+
+    op = d_filter_where(profile_is_even);
+    d_filter_chain_add(chain, op);
+    d_functional_free(op);
+
+    op = d_filter_take_first(3);
+    d_filter_chain_add(chain, op);
+    d_functional_free(op);
+
+    return chain;
+}
+
+
+/*
+d_tests_sa_profile_instrument_filter
+  Tests the instrumentation of d_filter_apply_chain.
+  Tests the following:
+  - one record per operation, in order, with its index
+  - rows in and out, bytes, and predicate calls of each
+  - the result is unchanged by profiling
+*/
+bool
+d_tests_sa_profile_instrument_filter
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_filter_chain*  chain;
+    struct d_filter_result* filtered;
+    struct d_profile        profile;
+    struct d_profile_record records[4];
+    int                     input[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    bool                    result;
+
+    result = true;
+    chain  = profile_chain();
+
+    d_profile_begin(&profile, records, 4);
+    filtered = d_filter_apply_chain(chain, input, 10, sizeof(int));
+    d_profile_end(&profile);
+
+    // test 1: result
+    result = d_assert_standalone(
+        (filtered != NULL) && (filtered->count == 3) &&
+        (((int*)filtered->elements)[0] == 0) &&
+        (((int*)filtered->elements)[2] == 4),
+        "profile_filter_result",
+        "profiling should not change the chain's result",
+        _counter) && result;
+
+#if defined(D_FUNCTIONAL_PROFILE)
+    // test 2: records
+    result = d_assert_standalone(
+        (profile.count == 2) &&
+        (strcmp(records[0].source, "filter") == 0) &&
+        (strcmp(records[0].operation, "where") == 0) &&
+        (records[0].index == 0) &&
+        (records[0].rows_in == 10) && (records[0].rows_out == 5) &&
+        (records[0].predicate_calls == 10) &&
+        (records[0].bytes_allocated == 10 * sizeof(int)),
+        "profile_filter_where",
+        "the where record should give its rows, calls, and bytes",
+        _counter) && result;
+
+    result = d_assert_standalone(
+        (strcmp(records[1].operation, "take_first") == 0) &&
+        (records[1].index == 1) &&
+        (records[1].rows_in == 5) && (records[1].rows_out == 3) &&
+        (records[1].predicate_calls == 0),
+        "profile_filter_take",
+        "the take_first record should follow with its rows",
+        _counter) && result;
+#else
+    // test 2: not compiled in
+    result = d_assert_standalone(
+        profile.count == 0,
+        "profile_filter_disabled",
+        "nothing should be recorded without D_FUNCTIONAL_PROFILE",
+        _counter) && result;
+#endif
+
+    d_filter_result_free(filtered);
+    d_functional_free(filtered);
+    d_filter_chain_free(chain);
+
+    return result;
+}
+
+/*
+d_tests_sa_profile_instrument_pipeline
+  Tests the instrumentation of the pipeline stages.
+  Tests the following:
+  - begin_copy, map, filter, and fold each give a record, in order
+  - rows in and out, bytes, and predicate calls of each
+  - only begin_copy allocates; map and filter work in place
+*/
+bool
+d_tests_sa_profile_instrument_pipeline
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_functional_pipeline pipe;
+    struct d_profile             profile;
+    struct d_profile_record      records[8];
+    int                          input[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    int                          sum;
+    bool                         result;
+
+    result = true;
+    sum    = 0;
+
+    d_profile_begin(&profile, records, 8);
+    pipe = d_functional_pipeline_begin_copy(input, 10, sizeof(int));
+    pipe = d_functional_pipeline_map(pipe, profile_double, NULL);
+    pipe = d_functional_pipeline_filter(pipe, profile_above_five, NULL);
+    pipe = d_functional_pipeline_fold(pipe, &sum, sizeof(int),
+                                      profile_sum, NULL);
+    d_profile_end(&profile);
+
+    // test 1: result
+    result = d_assert_standalone(
+        (pipe.error_code == 0) && (sum == 84),
+        "profile_pipeline_result",
+        "profiling should not change the pipeline's result",
+        _counter) && result;
+
+#if defined(D_FUNCTIONAL_PROFILE)
+    // test 2: records
+    result = d_assert_standalone(
+        (profile.count == 4) &&
+        (strcmp(records[0].operation, "begin_copy") == 0) &&
+        (strcmp(records[1].operation, "map") == 0) &&
+        (strcmp(records[2].operation, "filter") == 0) &&
+        (strcmp(records[3].operation, "fold") == 0) &&
+        (strcmp(records[2].source, "pipeline") == 0) &&
+        (records[2].index == D_PROFILE_NO_INDEX),
+        "profile_pipeline_stages",
+        "each stage should give one record, in order",
+        _counter) && result;
+
+    result = d_assert_standalone(
+        (records[1].rows_in == 10) && (records[1].rows_out == 10) &&
+        (records[0].bytes_allocated == 10 * sizeof(int)) &&
+        (records[1].bytes_allocated == 0) &&
+        (records[2].rows_in == 10) && (records[2].rows_out == 7) &&
+        (records[2].predicate_calls == 10) &&
+        (records[2].bytes_allocated == 0) &&
+        (records[3].rows_in == 7) && (records[3].rows_out == 1) &&
+        (records[3].bytes_allocated == 0),
+        "profile_pipeline_measures",
+        "the stages should give their rows, bytes, and calls",
+        _counter) && result;
+#else
+    // test 2: not compiled in
+    result = d_assert_standalone(
+        profile.count == 0,
+        "profile_pipeline_disabled",
+        "nothing should be recorded without D_FUNCTIONAL_PROFILE",
+        _counter) && result;
+#endif
+
+    d_functional_pipeline_free(&pipe);
+
+    return result;
+}
+
+/*
+d_tests_sa_profile_instrument_fn_builder
+  Tests the instrumentation of d_fn_builder_execute.
+  Tests the following:
+  - one record per transformer, then per predicate
+  - rows reaching and passing each predicate, and its calls
+  - the output is the same as without a session
+*/
+bool
+d_tests_sa_profile_instrument_fn_builder
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_fn_builder*    builder;
+    struct d_profile        profile;
+    struct d_profile_record records[4];
+    int                     input[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    int                     plain[10];
+    int                     profiled[10];
+    size_t                  plain_count;
+    size_t                  profiled_count;
+    bool                    ok;
+    bool                    result;
+
+    result  = true;
+    builder = d_fn_builder_new();
+
+    d_funtional_builder_map(builder, profile_double);
+    d_funtional_builder_filter(builder, profile_above_five);
+    d_funtional_builder_filter(builder, profile_is_even);
+
+    d_fn_builder_execute(builder, input, 10, sizeof(int), plain,
+                         &plain_count);
+
+    d_profile_begin(&profile, records, 4);
+    ok = d_fn_builder_execute(builder, input, 10, sizeof(int), profiled,
+                              &profiled_count);
+    d_profile_end(&profile);
+
+    // test 1: same output
+    result = d_assert_standalone(
+        (ok) && (profiled_count == 7) && (plain_count == 7) &&
+        (memcmp(plain, profiled, 7 * sizeof(int)) == 0) &&
+        (profiled[0] == 6) && (profiled[6] == 18),
+        "profile_fn_builder_result",
+        "profiling should not change the builder's output",
+        _counter) && result;
+
+#if defined(D_FUNCTIONAL_PROFILE)
+    // test 2: records
+    result = d_assert_standalone(
+        (profile.count == 3) &&
+        (strcmp(records[0].source, "fn_builder") == 0) &&
+        (strcmp(records[0].operation, "map") == 0) &&
+        (records[0].index == 0) &&
+        (records[0].rows_in == 10) && (records[0].rows_out == 10) &&
+        (strcmp(records[1].operation, "filter") == 0) &&
+        (records[1].rows_in == 10) && (records[1].rows_out == 7) &&
+        (records[1].predicate_calls == 10) &&
+        (records[2].index == 2) &&
+        (records[2].rows_in == 7) && (records[2].rows_out == 7),
+        "profile_fn_builder_stages",
+        "each stage should give its rows and calls",
+        _counter) && result;
+#else
+    // test 2: not compiled in
+    result = d_assert_standalone(
+        profile.count == 0,
+        "profile_fn_builder_disabled",
+        "nothing should be recorded without D_FUNCTIONAL_PROFILE",
+        _counter) && result;
+#endif
+
+    d_fn_builder_free(builder);
+
+    return result;
+}
+
+/*
+d_tests_sa_profile_instrument_explain
+  Tests d_filter_chain_explain_analyze.
+  Tests the following:
+  - the report starts with the chain's text
+  - one row per operation and a total, when profiled
+  - the total rows in and out
+  - a NULL chain is rejected
+*/
+bool
+d_tests_sa_profile_instrument_explain
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_filter_chain* chain;
+    char*                  plan;
+    char*                  text;
+    int                    input[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    bool                   result;
+
+    result = true;
+    chain  = profile_chain();
+    plan   = d_filter_chain_to_string(chain);
+    text   = d_filter_chain_explain_analyze(chain, input, 10, sizeof(int));
+
+    // test 1: header
+    result = d_assert_standalone(
+        (text != NULL) && (plan != NULL) &&
+        (strncmp(text, "EXPLAIN ANALYZE ", 16) == 0) &&
+        (strncmp(text + 16, plan, strlen(plan)) == 0),
+        "profile_explain_header",
+        "the report should start with the chain's text",
+        _counter) && result;
+
+#if defined(D_FUNCTIONAL_PROFILE)
+    // test 2: rows
+    result = d_assert_standalone(
+        (text != NULL) &&
+        (strstr(text, "\n  #0 where") != NULL) &&
+        (strstr(text, "\n  #1 take_first(3)") != NULL) &&
+        (strstr(text, "predicate calls 10") != NULL) &&
+        (strstr(text, "\n  total") != NULL) &&
+        (strstr(text, "rows 10 -> 3,") != NULL),
+        "profile_explain_rows",
+        "the report should give each operation and the total",
+        _counter) && result;
+#else
+    // test 2: not measured
+    result = d_assert_standalone(
+        (text != NULL) &&
+        (strstr(text, "not measured") != NULL) &&
+        (strstr(text, "total rows 10 -> 3") != NULL),
+        "profile_explain_unmeasured",
+        "the report should say the operations were not measured",
+        _counter) && result;
+#endif
+
+    // test 3: NULL chain
+    result = d_assert_standalone(
+        d_filter_chain_explain_analyze(NULL, input, 10, sizeof(int)) == NULL,
+        "profile_explain_null",
+        "a NULL chain should be rejected",
+        _counter) && result;
+
+    d_functional_free(text);
+    d_functional_free(plan);
+    d_filter_chain_free(chain);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_profile_instrument_all
+  Aggregation function that runs all instrumentation tests.
+*/
+bool
+d_tests_sa_profile_instrument_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Instrumentation\n");
+    printf("  -------------------------\n");
+
+    result = d_tests_sa_profile_instrument_filter(_counter)     && result;
+    result = d_tests_sa_profile_instrument_pipeline(_counter)   && result;
+    result = d_tests_sa_profile_instrument_fn_builder(_counter) && result;
+    result = d_tests_sa_profile_instrument_explain(_counter)    && result;
+
+    return result;
+}
@@ -0,0 +1,296 @@
+#include ".\profile_tests_sa.h"
+
+
+// profile_hook_state
+//   helper: what the test hook has seen.
+struct profile_hook_state
+{
+    size_t      calls;
+    const char* last_operation;
+    size_t      last_rows_out;
+};
+
+// profile_hook
+//   helper: a hook counting the records it receives.
+static void
+profile_hook
+(
+    const struct d_profile_record* _record,
+    void*                          _context
+)
+{
+    struct profile_hook_state* state;
+
+    state = (struct profile_hook_state*)_context;
+
+    state->calls++;
+    state->last_operation = _record->operation;
+    state->last_rows_out  = _record->rows_out;
+
+    return;
+}
+
+// profile_emit
+//   helper: reports a record with the given operation name and rows.
+static void
+profile_emit
+(
+    const char* _operation,
+    size_t      _rows_in,
+    size_t      _rows_out
+)
+{
+    d_profile_stop(d_profile_start(), "test", _operation, D_PROFILE_NO_INDEX,
+                   _rows_in, _rows_out, 0, 0);
+
+    return;
+}
+
+
+/*
+d_tests_sa_profile_session_nesting
+  Tests d_profile_begin and d_profile_end.
+  Tests the following:
+  - nothing is listening without a session or hook
+  - records go to the innermost session, in order
+  - records beyond the capacity are dropped and counted
+  - ending a session resumes the one it interrupted
+*/
+bool
+d_tests_sa_profile_session_nesting
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_profile        outer;
+    struct d_profile        inner;
+    struct d_profile_record outer_records[4];
+    struct d_profile_record inner_records[1];
+    bool                    result;
+
+    result = true;
+
+    // test 1: nothing listening
+    result = d_assert_standalone(
+        d_profile_start() == 0,
+        "profile_nesting_idle",
+        "d_profile_start should be 0 without a session or hook",
+        _counter) && result;
+
+    // test 2: records go to the innermost session
+    d_profile_begin(&outer, outer_records, 4);
+    profile_emit("a", 1, 1);
+
+    d_profile_begin(&inner, inner_records, 1);
+    profile_emit("b", 2, 2);
+    profile_emit("c", 3, 3);
+    d_profile_end(&inner);
+
+    profile_emit("d", 4, 4);
+    d_profile_end(&outer);
+
+    result = d_assert_standalone(
+        (outer.count == 2) &&
+        (strcmp(outer_records[0].operation, "a") == 0) &&
+        (strcmp(outer_records[1].operation, "d") == 0) &&
+        (outer_records[1].rows_in == 4) &&
+        (outer.dropped == 0),
+        "profile_nesting_outer",
+        "the outer session should hold only its own records",
+        _counter) && result;
+
+    // test 3: capacity
+    result = d_assert_standalone(
+        (inner.count == 1) &&
+        (strcmp(inner_records[0].operation, "b") == 0) &&
+        (inner.dropped == 1),
+        "profile_nesting_capacity",
+        "records beyond the capacity should be dropped and counted",
+        _counter) && result;
+
+    // test 4: closed again
+    result = d_assert_standalone(
+        d_profile_start() == 0,
+        "profile_nesting_closed",
+        "no session should be open after both ended",
+        _counter) && result;
+
+    return result;
+}
+
+/*
+d_tests_sa_profile_session_hook
+  Tests d_profile_set_hook.
+  Tests the following:
+  - the hook receives every record, with or without a session
+  - a session still collects while the hook is set
+  - clearing the hook stops it
+*/
+bool
+d_tests_sa_profile_session_hook
+(
+    struct d_test_counter* _counter
+)
+{
+    struct profile_hook_state state;
+    struct d_profile          profile;
+    struct d_profile_record   records[2];
+    bool                      result;
+
+    result = true;
+
+    memset(&state, 0, sizeof(state));
+    d_profile_set_hook(profile_hook, &state);
+
+    // test 1: no session
+    profile_emit("alone", 5, 3);
+
+    result = d_assert_standalone(
+        (state.calls == 1) &&
+        (strcmp(state.last_operation, "alone") == 0) &&
+        (state.last_rows_out == 3),
+        "profile_hook_alone",
+        "the hook should receive records without a session",
+        _counter) && result;
+
+    // test 2: with a session
+    d_profile_begin(&profile, records, 2);
+    profile_emit("both", 7, 6);
+    d_profile_end(&profile);
+
+    result = d_assert_standalone(
+        (state.calls == 2) &&
+        (profile.count == 1) &&
+        (strcmp(records[0].operation, "both") == 0),
+        "profile_hook_session",
+        "the hook and the session should both receive the record",
+        _counter) && result;
+
+    // test 3: cleared
+    d_profile_set_hook(NULL, NULL);
+    profile_emit("none", 1, 1);
+
+    result = d_assert_standalone(
+        (state.calls == 2) &&
+        (d_profile_start() == 0),
+        "profile_hook_cleared",
+        "a cleared hook should receive nothing",
+        _counter) && result;
+
+    return result;
+}
+
+/*
+d_tests_sa_profile_session_format
+  Tests d_profile_format_row and d_profile_to_string.
+  Tests the following:
+  - a row gives the label, rows, ticks, bytes, and predicate calls
+  - the default label is source.operation, with the index if any
+  - the report counts the records and lists one per line
+*/
+bool
+d_tests_sa_profile_session_format
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_profile_record record;
+    struct d_profile        profile;
+    char                    row[D_PROFILE_ROW_MAX];
+    char*                   text;
+    int                     written;
+    bool                    result;
+
+    result = true;
+
+    record.source          = "filter";
+    record.operation       = "where";
+    record.index           = 2;
+    record.rows_in         = 100;
+    record.rows_out        = 40;
+    record.elapsed_ticks   = 1234;
+    record.bytes_allocated = 400;
+    record.predicate_calls = 100;
+
+    // test 1: explicit label
+    written = d_profile_format_row(row, sizeof(row), "step", &record);
+
+    result = d_assert_standalone(
+        (written > 0) &&
+        (strncmp(row, "step ", 5) == 0) &&
+        (strstr(row, "rows 100 -> 40, ticks 1234, bytes 400, "
+                     "predicate calls 100") != NULL),
+        "profile_format_row",
+        "a row should give its label and every measurement",
+        _counter) && result;
+
+    // test 2: default labels
+    d_profile_format_row(row, sizeof(row), NULL, &record);
+    result = d_assert_standalone(
+        strncmp(row, "filter.where #2 ", 16) == 0,
+        "profile_format_indexed",
+        "the default label should be source.operation #index",
+        _counter) && result;
+
+    record.index = D_PROFILE_NO_INDEX;
+    d_profile_format_row(row, sizeof(row), NULL, &record);
+    result = d_assert_standalone(
+        strncmp(row, "filter.where ", 13) == 0,
+        "profile_format_unindexed",
+        "a record without an index should have no #",
+        _counter) && result;
+
+    // test 3: report
+    profile.records  = &record;
+    profile.capacity = 1;
+    profile.count    = 1;
+    profile.dropped  = 3;
+    profile.outer    = NULL;
+    text             = d_profile_to_string(&profile);
+
+    result = d_assert_standalone(
+        (text != NULL) &&
+        (strncmp(text, "profile: 1 records, 3 dropped\n", 30) == 0) &&
+        (strstr(text, "filter.where ") != NULL) &&
+        (text[strlen(text) - 1] == '\n'),
+        "profile_format_report",
+        "the report should count the records and list them",
+        _counter) && result;
+
+    d_functional_free(text);
+
+    // test 4: NULL
+    result = d_assert_standalone(
+        (d_profile_to_string(NULL) == NULL) &&
+        (d_profile_format_row(row, sizeof(row), NULL, NULL) < 0),
+        "profile_format_null",
+        "NULL sessions and records should be rejected",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_profile_session_all
+  Aggregation function that runs all session tests.
+*/
+bool
+d_tests_sa_profile_session_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Sessions\n");
+    printf("  ------------------\n");
+
+    result = d_tests_sa_profile_session_nesting(_counter) && result;
+    result = d_tests_sa_profile_session_hook(_counter)    && result;
+    result = d_tests_sa_profile_session_format(_counter)  && result;
+
+    return result;
+}
@@ -0,0 +1,28 @@
+#include ".\reduce_tests_sa.h"
+
+
+/*
+d_tests_sa_reduce_run_all
+  Module-level aggregation function that runs all reduce tests.
+  Executes tests for all categories:
+  - Accumulator merges and parallel folds
+  - Balanced tree reductions
+  - Single-pass multi-accumulator folds
+*/
+bool
+d_tests_sa_reduce_run_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    // run all test categories
+    result = d_tests_sa_reduce_fold_all(_counter)  && result;
+    result = d_tests_sa_reduce_tree_all(_counter)  && result;
+    result = d_tests_sa_reduce_multi_all(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,71 @@
+/******************************************************************************
+* djinterp [test]                                             reduce_tests_sa.h
+*
+*   Unit test declarations for `reduce.h` module.
+*   Provides testing of the parallel fold (chunking, identity handling, tree
+* combination of partial states, failure propagation), of the NAME##_merge
+* combiners emitted by the D_DEFINE_ACC_* generators, of the balanced tree
+* reduction (including the allocator its worker threads use), and of the
+* single-pass multi-accumulator fold.
+*
+*
+* path:      \tests\functional\reduce_tests_sa.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_TESTS_REDUCE_SA_
+#define DJINTERP_TESTS_REDUCE_SA_ 1
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "..\..\inc\djinterp.h"
+#include "..\..\inc\test\test_standalone.h"
+#include "..\..\inc\functional\functional.h"
+#include "..\..\inc\functional\reduce.h"
+
+
+/******************************************************************************
+ * I. PARALLEL FOLD TESTS
+ *****************************************************************************/
+bool d_tests_sa_reduce_acc_merge(struct d_test_counter* _counter);
+bool d_tests_sa_reduce_fold_parallel_validation(struct d_test_counter* _counter);
+bool d_tests_sa_reduce_fold_parallel_sum(struct d_test_counter* _counter);
+bool d_tests_sa_reduce_fold_parallel_mean(struct d_test_counter* _counter);
+bool d_tests_sa_reduce_fold_parallel_failure(struct d_test_counter* _counter);
+
+// I.   aggregation function
+bool d_tests_sa_reduce_fold_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * II. TREE REDUCTION TESTS
+ *****************************************************************************/
+bool d_tests_sa_reduce_tree_validation(struct d_test_counter* _counter);
+bool d_tests_sa_reduce_tree_values(struct d_test_counter* _counter);
+bool d_tests_sa_reduce_tree_order(struct d_test_counter* _counter);
+bool d_tests_sa_reduce_tree_allocator(struct d_test_counter* _counter);
+
+// II.  aggregation function
+bool d_tests_sa_reduce_tree_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * III. MULTI-ACCUMULATOR FOLD TESTS
+ *****************************************************************************/
+bool d_tests_sa_reduce_fold_multi_validation(struct d_test_counter* _counter);
+bool d_tests_sa_reduce_fold_multi_aggregates(struct d_test_counter* _counter);
+bool d_tests_sa_reduce_fold_multi_order(struct d_test_counter* _counter);
+
+// III. aggregation function
+bool d_tests_sa_reduce_multi_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * MODULE-LEVEL AGGREGATION
+ *****************************************************************************/
+bool d_tests_sa_reduce_run_all(struct d_test_counter* _counter);
+
+
+#endif  // DJINTERP_TESTS_REDUCE_SA_
@@ -0,0 +1,487 @@
+#include ".\reduce_tests_sa.h"
+
+
+D_DEFINE_ACC_SUM(reduce_acc_sum_ll, long long)
+D_DEFINE_ACC_PRODUCT(reduce_acc_product_int, int)
+D_DEFINE_ACC_MIN(reduce_acc_min_int, int)
+D_DEFINE_ACC_MAX(reduce_acc_max_int, int)
+D_DEFINE_ACC_BITWISE_OR(reduce_acc_or_uint, unsigned int)
+D_DEFINE_ACC_BITWISE_AND(reduce_acc_and_uint, unsigned int)
+D_DEFINE_ACC_COUNT(reduce_acc_count)
+D_DEFINE_ACC_MEAN(reduce_acc_mean_int, int)
+
+
+// reduce_step_sum_int
+//   helper: accumulator adding an int element to a long long state; fails on
+// the element value stored in the optional context.
+static bool
+reduce_step_sum_int
+(
+    void*       _accumulated,
+    const void* _element,
+    void*       _context
+)
+{
+    if ( (_context) &&
+         (*(const int*)_element == *(const int*)_context) )
+    {
+        return false;
+    }
+
+    *(long long*)_accumulated += *(const int*)_element;
+
+    return true;
+}
+
+// reduce_fill_sequence
+//   helper: allocates an int array holding 1, 2, ..., _count.
+static int*
+reduce_fill_sequence
+(
+    size_t _count
+)
+{
+    int*   values;
+    size_t i;
+
+    values = malloc(_count * sizeof(int));
+
+    if (!values)
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < _count; i++)
+    {
+        values[i] = (int)(i + 1);
+    }
+
+    return values;
+}
+
+
+/*
+d_tests_sa_reduce_acc_merge
+  Tests the NAME##_merge combiners emitted by the D_DEFINE_ACC_* macros.
+  Tests the following:
+  - NULL arguments are rejected
+  - sum, product, min, max, or, and, count, and mean merges
+*/
+bool
+d_tests_sa_reduce_acc_merge
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                    result;
+    long long               sum_a;
+    long long               sum_b;
+    int                     int_a;
+    int                     int_b;
+    unsigned int            bits_a;
+    unsigned int            bits_b;
+    size_t                  count_a;
+    size_t                  count_b;
+    struct d_acc_mean_state mean_a;
+    struct d_acc_mean_state mean_b;
+
+    result = true;
+    sum_a  = 10;
+    sum_b  = 32;
+
+    // test 1: NULL rejection
+    result = d_assert_standalone(
+        (!reduce_acc_sum_ll_merge(NULL, &sum_b, NULL)) &&
+        (!reduce_acc_sum_ll_merge(&sum_a, NULL, NULL)),
+        "acc_merge_null",
+        "merges should reject NULL states",
+        _counter) && result;
+
+    // test 2: sum
+    result = d_assert_standalone(
+        (reduce_acc_sum_ll_merge(&sum_a, &sum_b, NULL)) &&
+        (sum_a == 42),
+        "acc_merge_sum",
+        "sum merge should add partial sums",
+        _counter) && result;
+
+    // test 3: product
+    int_a = 6;
+    int_b = 7;
+
+    result = d_assert_standalone(
+        (reduce_acc_product_int_merge(&int_a, &int_b, NULL)) &&
+        (int_a == 42),
+        "acc_merge_product",
+        "product merge should multiply partial products",
+        _counter) && result;
+
+    // test 4: min / max
+    int_a = 5;
+    int_b = -3;
+    reduce_acc_min_int_merge(&int_a, &int_b, NULL);
+
+    result = d_assert_standalone(
+        (int_a == -3),
+        "acc_merge_min",
+        "min merge should keep the smaller partial minimum",
+        _counter) && result;
+
+    int_b = 9;
+    reduce_acc_max_int_merge(&int_a, &int_b, NULL);
+
+    result = d_assert_standalone(
+        (int_a == 9),
+        "acc_merge_max",
+        "max merge should keep the larger partial maximum",
+        _counter) && result;
+
+    // test 5: bitwise or / and
+    bits_a = 0x0Fu;
+    bits_b = 0xF0u;
+    reduce_acc_or_uint_merge(&bits_a, &bits_b, NULL);
+
+    result = d_assert_standalone(
+        (bits_a == 0xFFu),
+        "acc_merge_bitwise_or",
+        "or merge should combine partial bits",
+        _counter) && result;
+
+    bits_b = 0x3Cu;
+    reduce_acc_and_uint_merge(&bits_a, &bits_b, NULL);
+
+    result = d_assert_standalone(
+        (bits_a == 0x3Cu),
+        "acc_merge_bitwise_and",
+        "and merge should intersect partial bits",
+        _counter) && result;
+
+    // test 6: count
+    count_a = 4;
+    count_b = 5;
+
+    result = d_assert_standalone(
+        (reduce_acc_count_merge(&count_a, &count_b, NULL)) &&
+        (count_a == 9),
+        "acc_merge_count",
+        "count merge should add partial counts",
+        _counter) && result;
+
+    // test 7: mean
+    mean_a.sum   = 6.0;
+    mean_a.count = 3;
+    mean_b.sum   = 14.0;
+    mean_b.count = 2;
+
+    result = d_assert_standalone(
+        (reduce_acc_mean_int_merge(&mean_a, &mean_b, NULL)) &&
+        (mean_a.sum == 20.0)                                &&
+        (mean_a.count == 5),
+        "acc_merge_mean",
+        "mean merge should add sums and counts",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_reduce_fold_parallel_validation
+  Tests parameter validation of d_functional_fold_parallel.
+  Tests the following:
+  - NULL input / accumulator / identity / step / merge rejection
+  - zero count / element size / state size rejection
+*/
+bool
+d_tests_sa_reduce_fold_parallel_validation
+(
+    struct d_test_counter* _counter
+)
+{
+    bool      result;
+    int       values[4];
+    long long acc;
+    long long identity;
+
+    result   = true;
+    acc      = 0;
+    identity = 0;
+    memset(values, 0, sizeof(values));
+
+    // test 1: NULL pointers
+    result = d_assert_standalone(
+        (!d_functional_fold_parallel(NULL, 4, sizeof(int), &acc,
+                                     sizeof(acc), &identity,
+                                     reduce_step_sum_int,
+                                     reduce_acc_sum_ll_merge, NULL, 0)) &&
+        (!d_functional_fold_parallel(values, 4, sizeof(int), NULL,
+                                     sizeof(acc), &identity,
+                                     reduce_step_sum_int,
+                                     reduce_acc_sum_ll_merge, NULL, 0)) &&
+        (!d_functional_fold_parallel(values, 4, sizeof(int), &acc,
+                                     sizeof(acc), NULL,
+                                     reduce_step_sum_int,
+                                     reduce_acc_sum_ll_merge, NULL, 0)) &&
+        (!d_functional_fold_parallel(values, 4, sizeof(int), &acc,
+                                     sizeof(acc), &identity, NULL,
+                                     reduce_acc_sum_ll_merge, NULL, 0)) &&
+        (!d_functional_fold_parallel(values, 4, sizeof(int), &acc,
+                                     sizeof(acc), &identity,
+                                     reduce_step_sum_int, NULL, NULL, 0)),
+        "fold_parallel_null",
+        "NULL pointers should be rejected",
+        _counter) && result;
+
+    // test 2: zero sizes
+    result = d_assert_standalone(
+        (!d_functional_fold_parallel(values, 0, sizeof(int), &acc,
+                                     sizeof(acc), &identity,
+                                     reduce_step_sum_int,
+                                     reduce_acc_sum_ll_merge, NULL, 0)) &&
+        (!d_functional_fold_parallel(values, 4, 0, &acc,
+                                     sizeof(acc), &identity,
+                                     reduce_step_sum_int,
+                                     reduce_acc_sum_ll_merge, NULL, 0)) &&
+        (!d_functional_fold_parallel(values, 4, sizeof(int), &acc,
+                                     0, &identity,
+                                     reduce_step_sum_int,
+                                     reduce_acc_sum_ll_merge, NULL, 0)),
+        "fold_parallel_zero",
+        "zero count or sizes should be rejected",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_reduce_fold_parallel_sum
+  Tests d_functional_fold_parallel with a sum.
+  Tests the following:
+  - small input folded on the calling thread
+  - large input split across several threads
+  - thread count 0 (auto) and counts above the maximum
+  - initial accumulator value is preserved
+*/
+bool
+d_tests_sa_reduce_fold_parallel_sum
+(
+    struct d_test_counter* _counter
+)
+{
+    bool      result;
+    int*      values;
+    size_t    count;
+    long long acc;
+    long long identity;
+    long long expected;
+
+    result   = true;
+    identity = 0;
+    count    = (D_FUNCTIONAL_PARALLEL_MIN_CHUNK * 5) + 123;
+    values   = reduce_fill_sequence(count);
+    expected = ((long long)count * (long long)(count + 1)) / 2;
+
+    if (!values)
+    {
+        return result;
+    }
+
+    // test 1: small input
+    acc = 0;
+
+    result = d_assert_standalone(
+        (d_functional_fold_parallel(values, 10, sizeof(int), &acc,
+                                    sizeof(acc), &identity,
+                                    reduce_step_sum_int,
+                                    reduce_acc_sum_ll_merge, NULL, 4)) &&
+        (acc == 55),
+        "fold_parallel_sum_small",
+        "small inputs should be folded correctly",
+        _counter) && result;
+
+    // test 2: several threads
+    acc = 0;
+
+    result = d_assert_standalone(
+        (d_functional_fold_parallel(values, count, sizeof(int), &acc,
+                                    sizeof(acc), &identity,
+                                    reduce_step_sum_int,
+                                    reduce_acc_sum_ll_merge, NULL, 4)) &&
+        (acc == expected),
+        "fold_parallel_sum_threads",
+        "a fold split across threads should match the serial sum",
+        _counter) && result;
+
+    // test 3: automatic and excessive thread counts
+    acc = 0;
+
+    result = d_assert_standalone(
+        (d_functional_fold_parallel(values, count, sizeof(int), &acc,
+                                    sizeof(acc), &identity,
+                                    reduce_step_sum_int,
+                                    reduce_acc_sum_ll_merge, NULL, 0)) &&
+        (acc == expected),
+        "fold_parallel_sum_auto",
+        "thread count 0 should use the processor count",
+        _counter) && result;
+
+    acc = 0;
+
+    result = d_assert_standalone(
+        (d_functional_fold_parallel(values, count, sizeof(int), &acc,
+                                    sizeof(acc), &identity,
+                                    reduce_step_sum_int,
+                                    reduce_acc_sum_ll_merge, NULL,
+                                    D_FUNCTIONAL_MAX_THREADS * 4)) &&
+        (acc == expected),
+        "fold_parallel_sum_clamped",
+        "thread counts above the maximum should be clamped",
+        _counter) && result;
+
+    // test 4: initial value
+    acc = 1000;
+
+    result = d_assert_standalone(
+        (d_functional_fold_parallel(values, count, sizeof(int), &acc,
+                                    sizeof(acc), &identity,
+                                    reduce_step_sum_int,
+                                    reduce_acc_sum_ll_merge, NULL, 3)) &&
+        (acc == expected + 1000),
+        "fold_parallel_sum_initial",
+        "the initial accumulator value should be merged with the result",
+        _counter) && result;
+
+    free(values);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_reduce_fold_parallel_mean
+  Tests d_functional_fold_parallel with a generated mean accumulator.
+  Tests the following:
+  - state larger than the element is carried through partials
+  - sum and count match the input
+*/
+bool
+d_tests_sa_reduce_fold_parallel_mean
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                    result;
+    int*                    values;
+    size_t                  count;
+    struct d_acc_mean_state acc;
+    struct d_acc_mean_state identity;
+
+    result = true;
+    count  = (D_FUNCTIONAL_PARALLEL_MIN_CHUNK * 3) + 1;
+    values = reduce_fill_sequence(count);
+
+    if (!values)
+    {
+        return result;
+    }
+
+    memset(&acc, 0, sizeof(acc));
+    memset(&identity, 0, sizeof(identity));
+
+    // test 1: mean
+    result = d_assert_standalone(
+        (d_functional_fold_parallel(values, count, sizeof(int), &acc,
+                                    sizeof(acc), &identity,
+                                    reduce_acc_mean_int,
+                                    reduce_acc_mean_int_merge,
+                                    NULL, 4))                        &&
+        (acc.count == count)                                         &&
+        (acc.sum / (double)acc.count == (double)(count + 1) / 2.0),
+        "fold_parallel_mean",
+        "parallel mean should match the serial mean",
+        _counter) && result;
+
+    free(values);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_reduce_fold_parallel_failure
+  Tests failure propagation in d_functional_fold_parallel.
+  Tests the following:
+  - a failing step in a worker chunk fails the whole fold
+  - the accumulator is left unchanged
+*/
+bool
+d_tests_sa_reduce_fold_parallel_failure
+(
+    struct d_test_counter* _counter
+)
+{
+    bool      result;
+    int*      values;
+    size_t    count;
+    int       poison;
+    long long acc;
+    long long identity;
+
+    result   = true;
+    count    = D_FUNCTIONAL_PARALLEL_MIN_CHUNK * 4;
+    values   = reduce_fill_sequence(count);
+    identity = 0;
+    acc      = 7;
+
+    if (!values)
+    {
+        return result;
+    }
+
+    // fail in the last chunk, which runs on a worker thread
+    poison = (int)count - 1;
+
+    // test 1: failure
+    result = d_assert_standalone(
+        (!d_functional_fold_parallel(values, count, sizeof(int), &acc,
+                                     sizeof(acc), &identity,
+                                     reduce_step_sum_int,
+                                     reduce_acc_sum_ll_merge,
+                                     &poison, 4)) &&
+        (acc == 7),
+        "fold_parallel_failure",
+        "a failing step should fail the fold and keep the accumulator",
+        _counter) && result;
+
+    free(values);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_reduce_fold_all
+  Aggregation function that runs all parallel fold tests.
+*/
+bool
+d_tests_sa_reduce_fold_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Parallel Fold\n");
+    printf("  -----------------------\n");
+
+    result = d_tests_sa_reduce_acc_merge(_counter) && result;
+    result = d_tests_sa_reduce_fold_parallel_validation(_counter) && result;
+    result = d_tests_sa_reduce_fold_parallel_sum(_counter) && result;
+    result = d_tests_sa_reduce_fold_parallel_mean(_counter) && result;
+    result = d_tests_sa_reduce_fold_parallel_failure(_counter) && result;
+
+    return result;
+}
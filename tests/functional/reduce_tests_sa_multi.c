@@ -0,0 +1,300 @@
+#include ".\reduce_tests_sa.h"
+
+
+D_DEFINE_ACC_SUM(multi_acc_sum_int, int)
+D_DEFINE_ACC_MIN(multi_acc_min_int, int)
+D_DEFINE_ACC_MAX(multi_acc_max_int, int)
+D_DEFINE_ACC_COUNT(multi_acc_count)
+D_DEFINE_ACC_MEAN(multi_acc_mean_int, int)
+
+
+// multi_record_order
+//   helper: accumulator appending the int element to a log whose write
+// position is the first int of the state; fails once the log is full.
+static bool
+multi_record_order
+(
+    void*       _accumulated,
+    const void* _element,
+    void*       _context
+)
+{
+    int* log;
+
+    log = (int*)_accumulated;
+
+    if (log[0] >= *(const int*)_context)
+    {
+        return false;
+    }
+
+    log[1 + log[0]] = *(const int*)_element;
+    log[0]++;
+
+    return true;
+}
+
+
+/*
+d_tests_sa_reduce_fold_multi_validation
+  Tests parameter validation of d_functional_fold_multi.
+  Tests the following:
+  - NULL input / specs rejection
+  - zero count / element size / spec count rejection
+  - a spec without accumulator or step is rejected
+*/
+bool
+d_tests_sa_reduce_fold_multi_validation
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    int                values[3];
+    int                sum;
+    struct d_fold_spec specs[2];
+
+    result    = true;
+    values[0] = 1;
+    values[1] = 2;
+    values[2] = 3;
+    sum       = 0;
+
+    specs[0].accumulator = &sum;
+    specs[0].step        = multi_acc_sum_int;
+    specs[0].context     = NULL;
+    specs[1].accumulator = &sum;
+    specs[1].step        = NULL;
+    specs[1].context     = NULL;
+
+    // test 1: NULL / zero
+    result = d_assert_standalone(
+        (!d_functional_fold_multi(NULL, 3, sizeof(int), specs, 1))    &&
+        (!d_functional_fold_multi(values, 3, sizeof(int), NULL, 1))   &&
+        (!d_functional_fold_multi(values, 0, sizeof(int), specs, 1))  &&
+        (!d_functional_fold_multi(values, 3, 0, specs, 1))            &&
+        (!d_functional_fold_multi(values, 3, sizeof(int), specs, 0)),
+        "fold_multi_null_zero",
+        "NULL pointers or zero sizes should be rejected",
+        _counter) && result;
+
+    // test 2: incomplete spec
+    result = d_assert_standalone(
+        (!d_functional_fold_multi(values, 3, sizeof(int), specs, 2)) &&
+        (sum == 0),
+        "fold_multi_incomplete_spec",
+        "a spec without step should be rejected before folding",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_reduce_fold_multi_aggregates
+  Tests d_functional_fold_multi computing several aggregates at once.
+  Tests the following:
+  - sum, min, max, count, and mean in one pass
+  - inputs spanning several blocks
+  - results match separate d_functional_fold_left calls
+*/
+bool
+d_tests_sa_reduce_fold_multi_aggregates
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                    result;
+    int*                    values;
+    size_t                  count;
+    size_t                  i;
+    int                     sum;
+    int                     min;
+    int                     max;
+    size_t                  n;
+    struct d_acc_mean_state mean;
+    int                     single_sum;
+    struct d_fold_spec      specs[5];
+
+    result = true;
+    count  = (D_FUNCTIONAL_FOLD_MULTI_BLOCK_BYTES / sizeof(int)) * 3 + 7;
+    values = malloc(count * sizeof(int));
+
+    if (!values)
+    {
+        return result;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        values[i] = (int)((i * 31) % 101) - 50;
+    }
+
+    sum        = 0;
+    min        = values[0];
+    max        = values[0];
+    n          = 0;
+    mean.sum   = 0.0;
+    mean.count = 0;
+    single_sum = 0;
+
+    specs[0].accumulator = &sum;
+    specs[0].step        = multi_acc_sum_int;
+    specs[0].context     = NULL;
+    specs[1].accumulator = &min;
+    specs[1].step        = multi_acc_min_int;
+    specs[1].context     = NULL;
+    specs[2].accumulator = &max;
+    specs[2].step        = multi_acc_max_int;
+    specs[2].context     = NULL;
+    specs[3].accumulator = &n;
+    specs[3].step        = multi_acc_count;
+    specs[3].context     = NULL;
+    specs[4].accumulator = &mean;
+    specs[4].step        = multi_acc_mean_int;
+    specs[4].context     = NULL;
+
+    d_functional_fold_left(values,
+                           count,
+                           sizeof(int),
+                           &single_sum,
+                           multi_acc_sum_int,
+                           NULL);
+
+    // test 1: all aggregates
+    result = d_assert_standalone(
+        (d_functional_fold_multi(values, count, sizeof(int), specs, 5)) &&
+        (sum == single_sum)                                             &&
+        (min == -50)                                                    &&
+        (max == 50)                                                     &&
+        (n == count)                                                    &&
+        (mean.count == count)                                           &&
+        (mean.sum == (double)single_sum),
+        "fold_multi_aggregates",
+        "every aggregate should match a separate fold",
+        _counter) && result;
+
+    free(values);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_reduce_fold_multi_order
+  Tests element order and failure in d_functional_fold_multi.
+  Tests the following:
+  - every accumulator sees every element once, in input order, across
+    block boundaries
+  - a failing accumulator fails the fold
+*/
+bool
+d_tests_sa_reduce_fold_multi_order
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    int*               values;
+    int*               log_a;
+    int*               log_b;
+    int                capacity;
+    int                small_capacity;
+    size_t             count;
+    size_t             i;
+    bool               ordered;
+    struct d_fold_spec specs[2];
+
+    result   = true;
+    count    = (D_FUNCTIONAL_FOLD_MULTI_BLOCK_BYTES / sizeof(int)) + 5;
+    capacity = (int)count;
+    values   = malloc(count * sizeof(int));
+    log_a    = malloc((count + 1) * sizeof(int));
+    log_b    = malloc((count + 1) * sizeof(int));
+
+    if ( (!values) ||
+         (!log_a)  ||
+         (!log_b) )
+    {
+        free(values);
+        free(log_a);
+        free(log_b);
+
+        return result;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        values[i] = (int)i;
+    }
+
+    log_a[0] = 0;
+    log_b[0] = 0;
+
+    specs[0].accumulator = log_a;
+    specs[0].step        = multi_record_order;
+    specs[0].context     = &capacity;
+    specs[1].accumulator = log_b;
+    specs[1].step        = multi_record_order;
+    specs[1].context     = &capacity;
+
+    // test 1: order
+    ordered = d_functional_fold_multi(values, count, sizeof(int), specs, 2) &&
+              (log_a[0] == (int)count)                                      &&
+              (log_b[0] == (int)count);
+
+    for (i = 0; (ordered) && (i < count); i++)
+    {
+        ordered = (log_a[1 + i] == (int)i) &&
+                  (log_b[1 + i] == (int)i);
+    }
+
+    result = d_assert_standalone(
+        ordered,
+        "fold_multi_order",
+        "each accumulator should see all elements in order",
+        _counter) && result;
+
+    // test 2: failure
+    small_capacity   = 2;
+    log_a[0]         = 0;
+    log_b[0]         = 0;
+    specs[1].context = &small_capacity;
+
+    result = d_assert_standalone(
+        (!d_functional_fold_multi(values, count, sizeof(int), specs, 2)),
+        "fold_multi_failure",
+        "a failing accumulator should fail the fold",
+        _counter) && result;
+
+    free(values);
+    free(log_a);
+    free(log_b);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_reduce_multi_all
+  Aggregation function that runs all multi-accumulator fold tests.
+*/
+bool
+d_tests_sa_reduce_multi_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Multi-Accumulator Fold\n");
+    printf("  --------------------------------\n");
+
+    result = d_tests_sa_reduce_fold_multi_validation(_counter) && result;
+    result = d_tests_sa_reduce_fold_multi_aggregates(_counter) && result;
+    result = d_tests_sa_reduce_fold_multi_order(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,391 @@
+#include ".\reduce_tests_sa.h"
+
+
+// reduce_add_ll
+//   helper: reducer adding two long long values.
+static bool
+reduce_add_ll
+(
+    const void* _element1,
+    const void* _element2,
+    void*       _result,
+    void*       _context
+)
+{
+    (void)_context;
+
+    *(long long*)_result = *(const long long*)_element1 +
+                           *(const long long*)_element2;
+
+    return true;
+}
+
+// reduce_span
+//   helper: element for the non-commutative span reducer. Concatenating
+// [first, last] with [first', last'] is only valid when last + 1 == first'.
+struct reduce_span
+{
+    size_t first;
+    size_t last;
+    bool   valid;
+};
+
+// reduce_concat_span
+//   helper: non-commutative reducer joining adjacent spans; the result is
+// invalid if the spans are out of order.
+static bool
+reduce_concat_span
+(
+    const void* _element1,
+    const void* _element2,
+    void*       _result,
+    void*       _context
+)
+{
+    const struct reduce_span* left;
+    const struct reduce_span* right;
+    struct reduce_span*       out;
+
+    (void)_context;
+
+    left  = (const struct reduce_span*)_element1;
+    right = (const struct reduce_span*)_element2;
+    out   = (struct reduce_span*)_result;
+
+    out->first = left->first;
+    out->last  = right->last;
+    out->valid = (left->valid) &&
+                 (right->valid) &&
+                 (left->last + 1 == right->first);
+
+    return true;
+}
+
+// reduce_fail_over
+//   helper: reducer adding ints that fails once the sum exceeds the limit
+// given as context.
+static bool
+reduce_fail_over
+(
+    const void* _element1,
+    const void* _element2,
+    void*       _result,
+    void*       _context
+)
+{
+    int sum;
+
+    sum = *(const int*)_element1 + *(const int*)_element2;
+
+    if (sum > *(const int*)_context)
+    {
+        return false;
+    }
+
+    *(int*)_result = sum;
+
+    return true;
+}
+
+
+/*
+d_tests_sa_reduce_tree_validation
+  Tests parameter validation of d_functional_reduce_tree.
+  Tests the following:
+  - NULL input / result / reducer rejection
+  - zero count / element size rejection
+*/
+bool
+d_tests_sa_reduce_tree_validation
+(
+    struct d_test_counter* _counter
+)
+{
+    bool      result;
+    long long values[3];
+    long long out;
+
+    result    = true;
+    values[0] = 1;
+    values[1] = 2;
+    values[2] = 3;
+
+    // test 1: NULL pointers
+    result = d_assert_standalone(
+        (!d_functional_reduce_tree(NULL, 3, sizeof(long long), &out,
+                                   reduce_add_ll, NULL, 1))           &&
+        (!d_functional_reduce_tree(values, 3, sizeof(long long), NULL,
+                                   reduce_add_ll, NULL, 1))           &&
+        (!d_functional_reduce_tree(values, 3, sizeof(long long), &out,
+                                   NULL, NULL, 1)),
+        "reduce_tree_null",
+        "NULL pointers should be rejected",
+        _counter) && result;
+
+    // test 2: zero sizes
+    result = d_assert_standalone(
+        (!d_functional_reduce_tree(values, 0, sizeof(long long), &out,
+                                   reduce_add_ll, NULL, 1))           &&
+        (!d_functional_reduce_tree(values, 3, 0, &out,
+                                   reduce_add_ll, NULL, 1)),
+        "reduce_tree_zero",
+        "zero count or element size should be rejected",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_reduce_tree_values
+  Tests d_functional_reduce_tree results.
+  Tests the following:
+  - a single element is copied through
+  - counts that are not powers of two
+  - large inputs reduced across threads
+  - reducer failure propagates
+*/
+bool
+d_tests_sa_reduce_tree_values
+(
+    struct d_test_counter* _counter
+)
+{
+    bool       result;
+    long long* values;
+    long long  out;
+    size_t     count;
+    size_t     i;
+    bool       ok;
+    int        small[4];
+    int        limit;
+    int        int_out;
+
+    result = true;
+    count  = (D_FUNCTIONAL_PARALLEL_MIN_CHUNK * 4) + 77;
+    values = malloc(count * sizeof(long long));
+
+    if (!values)
+    {
+        return result;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        values[i] = (long long)(i + 1);
+    }
+
+    // test 1: single element
+    out = 0;
+
+    result = d_assert_standalone(
+        (d_functional_reduce_tree(values, 1, sizeof(long long), &out,
+                                  reduce_add_ll, NULL, 1)) &&
+        (out == 1),
+        "reduce_tree_single",
+        "a single element should be copied to the result",
+        _counter) && result;
+
+    // test 2: every count up to 33
+    ok = true;
+
+    for (i = 1; i <= 33; i++)
+    {
+        out = 0;
+        ok  = (d_functional_reduce_tree(values, i, sizeof(long long), &out,
+                                        reduce_add_ll, NULL, 1)) &&
+              (out == (long long)((i * (i + 1)) / 2)) &&
+              ok;
+    }
+
+    result = d_assert_standalone(
+        ok,
+        "reduce_tree_small_counts",
+        "tree reduction should be correct for any count",
+        _counter) && result;
+
+    // test 3: threaded
+    out = 0;
+
+    result = d_assert_standalone(
+        (d_functional_reduce_tree(values, count, sizeof(long long), &out,
+                                  reduce_add_ll, NULL, 4)) &&
+        (out == (long long)((count * (count + 1)) / 2)),
+        "reduce_tree_threads",
+        "threaded tree reduction should match the serial sum",
+        _counter) && result;
+
+    // test 4: failure
+    small[0] = 1;
+    small[1] = 2;
+    small[2] = 3;
+    small[3] = 4;
+    limit    = 5;
+
+    result = d_assert_standalone(
+        (!d_functional_reduce_tree(small, 4, sizeof(int), &int_out,
+                                   reduce_fail_over, &limit, 1)),
+        "reduce_tree_failure",
+        "a failing reducer should fail the reduction",
+        _counter) && result;
+
+    free(values);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_reduce_tree_order
+  Tests that d_functional_reduce_tree preserves element order.
+  Tests the following:
+  - a non-commutative reducer sees adjacent spans in order (serial)
+  - the same holds when chunks are reduced on several threads
+*/
+bool
+d_tests_sa_reduce_tree_order
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                result;
+    struct reduce_span* spans;
+    struct reduce_span  out;
+    size_t              count;
+    size_t              i;
+
+    result = true;
+    count  = (D_FUNCTIONAL_PARALLEL_MIN_CHUNK * 3) + 5;
+    spans  = malloc(count * sizeof(struct reduce_span));
+
+    if (!spans)
+    {
+        return result;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        spans[i].first = i;
+        spans[i].last  = i;
+        spans[i].valid = true;
+    }
+
+    // test 1: serial
+    memset(&out, 0, sizeof(out));
+
+    result = d_assert_standalone(
+        (d_functional_reduce_tree(spans, 1000, sizeof(struct reduce_span),
+                                  &out, reduce_concat_span, NULL, 1)) &&
+        (out.valid)                                                   &&
+        (out.first == 0)                                              &&
+        (out.last == 999),
+        "reduce_tree_order_serial",
+        "tree reduction should combine elements in order",
+        _counter) && result;
+
+    // test 2: threaded
+    memset(&out, 0, sizeof(out));
+
+    result = d_assert_standalone(
+        (d_functional_reduce_tree(spans, count, sizeof(struct reduce_span),
+                                  &out, reduce_concat_span, NULL, 3)) &&
+        (out.valid)                                                   &&
+        (out.first == 0)                                              &&
+        (out.last == count - 1),
+        "reduce_tree_order_threads",
+        "threaded tree reduction should combine chunks in order",
+        _counter) && result;
+
+    free(spans);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_reduce_tree_allocator
+  Tests that d_functional_reduce_tree allocates from the caller's allocator.
+  Tests the following:
+  - the worker threads' scratch buffers are counted by the caller's
+    allocator, and all of them are released
+*/
+bool
+d_tests_sa_reduce_tree_allocator
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_functional_allocator  counting;
+    struct d_functional_allocator* previous;
+    bool                           result;
+    bool                           ok;
+    long long*                     values;
+    long long                      out;
+    size_t                         count;
+    size_t                         i;
+
+    result = true;
+    count  = (D_FUNCTIONAL_PARALLEL_MIN_CHUNK * 4) + 77;
+    values = malloc(count * sizeof(long long));
+
+    if (!values)
+    {
+        return result;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        values[i] = (long long)(i + 1);
+    }
+
+    d_functional_allocator_init(&counting, NULL, NULL, NULL, NULL, true);
+
+    // test 1: four chunks, each with its own scratch buffer
+    out      = 0;
+    previous = d_functional_allocator_push(&counting);
+    ok       = d_functional_reduce_tree(values, count, sizeof(long long),
+                                        &out, reduce_add_ll, NULL, 4);
+    d_functional_allocator_pop(previous);
+
+    // partials, one scratch per chunk, and one for combining the partials
+    result = d_assert_standalone(
+        (ok) &&
+        (out == (long long)((count * (count + 1)) / 2)) &&
+        (counting.stats.allocations == 6) &&
+        (counting.stats.frees == 6) &&
+        (counting.stats.bytes_live == 0),
+        "reduce_tree_allocator_threads",
+        "worker threads should allocate from the caller's allocator",
+        _counter) && result;
+
+    d_functional_allocator_destroy(&counting);
+    free(values);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_reduce_tree_all
+  Aggregation function that runs all tree reduction tests.
+*/
+bool
+d_tests_sa_reduce_tree_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Tree Reduction\n");
+    printf("  ------------------------\n");
+
+    result = d_tests_sa_reduce_tree_validation(_counter) && result;
+    result = d_tests_sa_reduce_tree_values(_counter) && result;
+    result = d_tests_sa_reduce_tree_order(_counter) && result;
+    result = d_tests_sa_reduce_tree_allocator(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,26 @@
+#include ".\scan_tests_sa.h"
+
+
+/*
+d_tests_sa_scan_run_all
+  Module-level aggregation function that runs all scan tests.
+  Executes tests for all categories:
+  - Forward and reverse predicate searches, including compiled programs
+  - Bytewise value searches
+*/
+bool
+d_tests_sa_scan_run_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    // run all test categories
+    result = d_tests_sa_scan_predicate_all(_counter) && result;
+    result = d_tests_sa_scan_value_all(_counter)     && result;
+
+    return result;
+}
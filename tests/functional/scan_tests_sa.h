@@ -0,0 +1,56 @@
+/******************************************************************************
+* djinterp [test]                                               scan_tests_sa.h
+*
+*   Unit test declarations for `scan.h` module.
+*   Provides testing of the context-carrying forward and reverse predicate
+* searches, their batched path for compiled predicate programs, and the
+* bytewise value searches across element sizes, lengths that do and do not
+* fill whole SIMD chunks, and unaligned inputs.
+*
+*
+* path:      \tests\functional\scan_tests_sa.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_TESTS_SCAN_SA_
+#define DJINTERP_TESTS_SCAN_SA_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "..\..\inc\djinterp.h"
+#include "..\..\inc\test\test_standalone.h"
+#include "..\..\inc\functional\functional.h"
+#include "..\..\inc\functional\scan.h"
+
+
+/******************************************************************************
+ * I. PREDICATE SEARCH TESTS
+ *****************************************************************************/
+bool d_tests_sa_scan_predicate_validation(struct d_test_counter* _counter);
+bool d_tests_sa_scan_predicate_context(struct d_test_counter* _counter);
+bool d_tests_sa_scan_predicate_program(struct d_test_counter* _counter);
+
+// I.   aggregation function
+bool d_tests_sa_scan_predicate_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * II. VALUE SEARCH TESTS
+ *****************************************************************************/
+bool d_tests_sa_scan_value_validation(struct d_test_counter* _counter);
+bool d_tests_sa_scan_value_sizes(struct d_test_counter* _counter);
+bool d_tests_sa_scan_value_positions(struct d_test_counter* _counter);
+
+// II.  aggregation function
+bool d_tests_sa_scan_value_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * MODULE-LEVEL AGGREGATION
+ *****************************************************************************/
+bool d_tests_sa_scan_run_all(struct d_test_counter* _counter);
+
+
+#endif  // DJINTERP_TESTS_SCAN_SA_
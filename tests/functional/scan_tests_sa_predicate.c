@@ -0,0 +1,330 @@
+#include ".\scan_tests_sa.h"
+
+
+// scan_equals_context
+//   helper: predicate true when the int element equals the int context.
+static bool
+scan_equals_context
+(
+    const void* _element,
+    void*       _context
+)
+{
+    return (*(const int*)_element == *(const int*)_context);
+}
+
+// scan_is_multiple
+//   helper: predicate true when the int element is a non-zero multiple of
+// the int context.
+static bool
+scan_is_multiple
+(
+    const void* _element,
+    void*       _context
+)
+{
+    int value;
+
+    value = *(const int*)_element;
+
+    return (value != 0) && ((value % *(const int*)_context) == 0);
+}
+
+// scan_is_odd
+//   helper: context-free predicate true for odd ints.
+static bool
+scan_is_odd
+(
+    const void* _element,
+    void*       _context
+)
+{
+    (void)_context;
+
+    return ((*(const int*)_element % 2) != 0);
+}
+
+// scan_counted_match
+//   helper: predicate true when the int element equals bound[0]; counts its
+// calls in bound[1].
+static bool
+scan_counted_match
+(
+    const void* _element,
+    void*       _context
+)
+{
+    int* bound;
+
+    bound = (int*)_context;
+    bound[1]++;
+
+    return (*(const int*)_element == bound[0]);
+}
+
+
+/*
+d_tests_sa_scan_predicate_validation
+  Tests parameter validation of the predicate searches.
+  Tests the following:
+  - NULL input / predicate, zero count, and zero element size rejection
+  - no match gives (size_t)-1 or NULL
+*/
+bool
+d_tests_sa_scan_predicate_validation
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+    int  values[4] = { 1, 2, 3, 4 };
+    int  target;
+
+    result = true;
+    target = 9;
+
+    // test 1: rejection
+    result = d_assert_standalone(
+        (d_functional_index_of_context(NULL, 4, sizeof(int),
+                                       scan_equals_context,
+                                       &target) == (size_t)-1)          &&
+        (d_functional_last_index_of_context(values, 4, sizeof(int),
+                                            NULL,
+                                            &target) == (size_t)-1)     &&
+        (d_functional_last_index_of_context(values, 0, sizeof(int),
+                                            scan_equals_context,
+                                            &target) == (size_t)-1)     &&
+        (d_functional_find_last_context(values, 4, 0,
+                                        scan_equals_context,
+                                        &target) == NULL),
+        "scan_predicate_rejection",
+        "NULL pointers and zero sizes should be rejected",
+        _counter) && result;
+
+    // test 2: no match
+    result = d_assert_standalone(
+        (d_functional_index_of_context(values, 4, sizeof(int),
+                                       scan_equals_context,
+                                       &target) == (size_t)-1)          &&
+        (d_functional_last_index_of_context(values, 4, sizeof(int),
+                                            scan_equals_context,
+                                            &target) == (size_t)-1)     &&
+        (d_functional_find_last_context(values, 4, sizeof(int),
+                                        scan_equals_context,
+                                        &target) == NULL),
+        "scan_predicate_no_match",
+        "a predicate matching nothing should give (size_t)-1 / NULL",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_scan_predicate_context
+  Tests the context-carrying searches and the NULL-context wrappers.
+  Tests the following:
+  - first and last match of a parameterized predicate
+  - find_last returns a pointer into the input
+  - a reverse search stops at the last match
+  - d_functional_last_index_of still works through the new path
+*/
+bool
+d_tests_sa_scan_predicate_context
+(
+    struct d_test_counter* _counter
+)
+{
+    bool   result;
+    int    values[100];
+    int    factor;
+    int    bound[2];
+    int*   found;
+    size_t i;
+
+    result = true;
+
+    for (i = 0; i < 100; i++)
+    {
+        values[i] = (int)i;
+    }
+
+    factor = 7;
+
+    // test 1: first and last multiple
+    found = (int*)d_functional_find_last_context(values,
+                                                 100,
+                                                 sizeof(int),
+                                                 scan_is_multiple,
+                                                 &factor);
+
+    result = d_assert_standalone(
+        (d_functional_index_of_context(values, 100, sizeof(int),
+                                       scan_is_multiple,
+                                       &factor) == 7)                   &&
+        (d_functional_last_index_of_context(values, 100, sizeof(int),
+                                            scan_is_multiple,
+                                            &factor) == 98)             &&
+        (found == &values[98]),
+        "scan_predicate_multiples",
+        "the first and last multiples of 7 should be at 7 and 98",
+        _counter) && result;
+
+    // test 2: early exit from the end
+    bound[0] = 95;
+    bound[1] = 0;
+
+    result = d_assert_standalone(
+        (d_functional_last_index_of_context(values, 100, sizeof(int),
+                                            scan_counted_match,
+                                            bound) == 95)               &&
+        (bound[1] == 5),
+        "scan_predicate_early_exit",
+        "a reverse search should stop at the last match",
+        _counter) && result;
+
+    // test 3: NULL-context wrappers
+    result = d_assert_standalone(
+        (d_functional_last_index_of(values, 100, sizeof(int),
+                                    scan_is_odd) == 99)                 &&
+        (d_functional_index_of(values, 100, sizeof(int),
+                               scan_is_odd) == 1)                       &&
+        (d_functional_find_last(values, 99, sizeof(int),
+                                scan_is_odd) == &values[97]),
+        "scan_predicate_wrappers",
+        "the NULL-context searches should match the context variants",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_scan_predicate_program
+  Tests the batched path for compiled predicate programs.
+  Tests the following:
+  - forward and reverse searches agree with a scalar scan
+  - matches in the first, a middle, and the last (partial) 64-element block
+  - no match
+*/
+bool
+d_tests_sa_scan_predicate_program
+(
+    struct d_test_counter* _counter
+)
+{
+    struct d_predicate_expr*    expr;
+    struct d_predicate_program* program;
+    bool                        result;
+    bool                        ok;
+    int                         values[200];
+    int                         factor;
+    size_t                      i;
+
+    result = true;
+    factor = 61;
+
+    for (i = 0; i < 200; i++)
+    {
+        values[i] = (int)i;
+    }
+
+    expr    = d_predicate_expr_new();
+    ok      = d_predicate_expr_leaf(expr, scan_is_multiple, &factor);
+    program = d_predicate_expr_compile(expr);
+
+    result = d_assert_standalone(
+        (ok) && (program != NULL),
+        "scan_program_compile",
+        "the predicate program should compile",
+        _counter) && result;
+
+    if (!program)
+    {
+        d_predicate_expr_free(expr);
+
+        return result;
+    }
+
+    // test 1: multiples of 61 below 200 are 61, 122, 183
+    result = d_assert_standalone(
+        (d_functional_index_of_context(values, 200, sizeof(int),
+                                       d_predicate_program_test,
+                                       program) == 61)                  &&
+        (d_functional_last_index_of_context(values, 200, sizeof(int),
+                                            d_predicate_program_test,
+                                            program) == 183)            &&
+        (d_functional_last_index_of_context(values, 183, sizeof(int),
+                                            d_predicate_program_test,
+                                            program) == 122),
+        "scan_program_matches",
+        "batched searches should find the first and last multiples",
+        _counter) && result;
+
+    // test 2: matches at block edges agree with a scalar scan
+    factor = 64;
+    ok     = true;
+
+    for (i = 1; (ok) && (i <= 200); i += 13)
+    {
+        ok = (d_functional_last_index_of_context(values, i, sizeof(int),
+                                                 d_predicate_program_test,
+                                                 program) ==
+              d_functional_last_index_of_context(values, i, sizeof(int),
+                                                 scan_is_multiple,
+                                                 &factor))              &&
+             (d_functional_index_of_context(values, i, sizeof(int),
+                                            d_predicate_program_test,
+                                            program) ==
+              d_functional_index_of_context(values, i, sizeof(int),
+                                            scan_is_multiple,
+                                            &factor));
+    }
+
+    result = d_assert_standalone(
+        ok,
+        "scan_program_agrees",
+        "batched and scalar searches should agree for every length",
+        _counter) && result;
+
+    // test 3: no match
+    factor = 1000;
+
+    result = d_assert_standalone(
+        (d_functional_last_index_of_context(values, 200, sizeof(int),
+                                            d_predicate_program_test,
+                                            program) == (size_t)-1),
+        "scan_program_no_match",
+        "a program matching nothing should give (size_t)-1",
+        _counter) && result;
+
+    d_predicate_program_free(program);
+    d_predicate_expr_free(expr);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_scan_predicate_all
+  Aggregation function that runs all predicate search tests.
+*/
+bool
+d_tests_sa_scan_predicate_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Predicate Searches\n");
+    printf("  ----------------------------\n");
+
+    result = d_tests_sa_scan_predicate_validation(_counter) && result;
+    result = d_tests_sa_scan_predicate_context(_counter) && result;
+    result = d_tests_sa_scan_predicate_program(_counter) && result;
+
+    return result;
+}
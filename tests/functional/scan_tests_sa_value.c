@@ -0,0 +1,281 @@
+#include ".\scan_tests_sa.h"
+
+
+// scan_record
+//   helper: a 12-byte element, which has no typed kernel.
+struct scan_record
+{
+    int32_t id;
+    int32_t group;
+    int32_t flags;
+};
+
+
+/*
+d_tests_sa_scan_value_validation
+  Tests parameter validation of the value searches.
+  Tests the following:
+  - NULL input / value, zero count, and zero element size rejection
+  - an absent value gives (size_t)-1
+*/
+bool
+d_tests_sa_scan_value_validation
+(
+    struct d_test_counter* _counter
+)
+{
+    bool    result;
+    int32_t values[40];
+    int32_t probe;
+    size_t  i;
+
+    result = true;
+    probe  = 5;
+
+    for (i = 0; i < 40; i++)
+    {
+        values[i] = 100 + (int32_t)i;
+    }
+
+    // test 1: rejection
+    result = d_assert_standalone(
+        (d_functional_index_of_value(NULL, 40, sizeof(int32_t),
+                                     &probe) == (size_t)-1)             &&
+        (d_functional_index_of_value(values, 40, sizeof(int32_t),
+                                     NULL) == (size_t)-1)               &&
+        (d_functional_last_index_of_value(values, 0, sizeof(int32_t),
+                                          &probe) == (size_t)-1)        &&
+        (d_functional_last_index_of_value(values, 40, 0,
+                                          &probe) == (size_t)-1),
+        "scan_value_rejection",
+        "NULL pointers and zero sizes should be rejected",
+        _counter) && result;
+
+    // test 2: absent value
+    result = d_assert_standalone(
+        (d_functional_index_of_value(values, 40, sizeof(int32_t),
+                                     &probe) == (size_t)-1)             &&
+        (d_functional_last_index_of_value(values, 40, sizeof(int32_t),
+                                          &probe) == (size_t)-1),
+        "scan_value_absent",
+        "an absent value should give (size_t)-1",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_scan_value_sizes
+  Tests the value searches for each element size.
+  Tests the following:
+  - 1-, 2-, 4-, and 8-byte elements with duplicates, forward and reverse
+  - a 12-byte struct element
+  - 8-byte lanes with only one equal 32-bit half do not match
+  - doubles compare bytewise
+*/
+bool
+d_tests_sa_scan_value_sizes
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    uint8_t            bytes[300];
+    uint16_t           shorts[300];
+    uint32_t           words[300];
+    uint64_t           longs[300];
+    struct scan_record records[50];
+    struct scan_record record;
+    double             reals[20];
+    uint8_t            byte_probe;
+    uint16_t           short_probe;
+    uint32_t           word_probe;
+    uint64_t           long_probe;
+    double             real_probe;
+    size_t             i;
+
+    result = true;
+
+    // every value appears at i and i + 150
+    for (i = 0; i < 300; i++)
+    {
+        bytes[i]  = (uint8_t)(i % 150);
+        shorts[i] = (uint16_t)(1000 + (i % 150));
+        words[i]  = (uint32_t)(70000 + (i % 150));
+        longs[i]  = ((uint64_t)(i % 150) << 32) | 7;
+    }
+
+    byte_probe  = 77;
+    short_probe = 1077;
+    word_probe  = 70077;
+    long_probe  = ((uint64_t)77 << 32) | 7;
+
+    // test 1: typed element sizes
+    result = d_assert_standalone(
+        (d_functional_index_of_value(bytes, 300, 1,
+                                     &byte_probe) == 77)                &&
+        (d_functional_last_index_of_value(bytes, 300, 1,
+                                          &byte_probe) == 227)          &&
+        (d_functional_index_of_value(shorts, 300, 2,
+                                     &short_probe) == 77)               &&
+        (d_functional_last_index_of_value(shorts, 300, 2,
+                                          &short_probe) == 227)         &&
+        (d_functional_index_of_value(words, 300, 4,
+                                     &word_probe) == 77)                &&
+        (d_functional_last_index_of_value(words, 300, 4,
+                                          &word_probe) == 227)          &&
+        (d_functional_index_of_value(longs, 300, 8,
+                                     &long_probe) == 77)                &&
+        (d_functional_last_index_of_value(longs, 300, 8,
+                                          &long_probe) == 227),
+        "scan_value_typed",
+        "every typed size should find both copies of the value",
+        _counter) && result;
+
+    // test 2: 8-byte lanes need both halves equal (low halves all match)
+    long_probe = ((uint64_t)500 << 32) | 7;
+
+    result = d_assert_standalone(
+        (d_functional_index_of_value(longs, 300, 8,
+                                     &long_probe) == (size_t)-1)        &&
+        (d_functional_last_index_of_value(longs, 300, 8,
+                                          &long_probe) == (size_t)-1),
+        "scan_value_half_match",
+        "an 8-byte element equal in one half only should not match",
+        _counter) && result;
+
+    // test 3: struct elements
+    for (i = 0; i < 50; i++)
+    {
+        records[i].id    = (int32_t)i;
+        records[i].group = (int32_t)(i % 5);
+        records[i].flags = 0;
+    }
+
+    record = records[31];
+
+    result = d_assert_standalone(
+        (d_functional_index_of_value(records, 50, sizeof(record),
+                                     &record) == 31)                    &&
+        (d_functional_last_index_of_value(records, 50, sizeof(record),
+                                          &record) == 31),
+        "scan_value_struct",
+        "a 12-byte element should be found with the generic loop",
+        _counter) && result;
+
+    // test 4: doubles compare bytewise
+    for (i = 0; i < 20; i++)
+    {
+        reals[i] = (double)i;
+    }
+
+    reals[3]   = -0.0;
+    real_probe = 0.0;
+
+    result = d_assert_standalone(
+        (d_functional_last_index_of_value(reals, 20, sizeof(double),
+                                          &real_probe) == 0),
+        "scan_value_bytewise",
+        "-0.0 should not match 0.0",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_scan_value_positions
+  Tests the value searches against a scalar scan for every position.
+  Tests the following:
+  - a single match at each position of arrays of several lengths, covering
+    whole 64-byte chunks, whole 16-byte blocks, and a scalar tail
+  - an unaligned input
+*/
+bool
+d_tests_sa_scan_value_positions
+(
+    struct d_test_counter* _counter
+)
+{
+    bool     result;
+    bool     ok;
+    uint16_t buffer[101];
+    uint16_t probe;
+    size_t   lengths[4];
+    size_t   n;
+    size_t   at;
+    size_t   l;
+
+    result     = true;
+    probe      = 0xBEEF;
+    lengths[0] = 7;
+    lengths[1] = 32;
+    lengths[2] = 40;
+    lengths[3] = 100;
+    ok         = true;
+
+    // test 1: one match at every position
+    for (l = 0; (ok) && (l < 4); l++)
+    {
+        n = lengths[l];
+
+        for (at = 0; (ok) && (at < n); at++)
+        {
+            memset(buffer, 0, sizeof(buffer));
+            buffer[at] = probe;
+
+            ok = (d_functional_index_of_value(buffer, n, 2,
+                                              &probe) == at)            &&
+                 (d_functional_last_index_of_value(buffer, n, 2,
+                                                   &probe) == at);
+        }
+    }
+
+    result = d_assert_standalone(
+        ok,
+        "scan_value_every_position",
+        "a single match should be found at every position",
+        _counter) && result;
+
+    // test 2: unaligned input, two matches
+    memset(buffer, 0, sizeof(buffer));
+    buffer[5]  = probe;
+    buffer[90] = probe;
+
+    result = d_assert_standalone(
+        (d_functional_index_of_value(&buffer[1], 100, 2,
+                                     &probe) == 4)                      &&
+        (d_functional_last_index_of_value(&buffer[1], 100, 2,
+                                          &probe) == 89),
+        "scan_value_unaligned",
+        "an input not aligned to 16 bytes should be searched correctly",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_scan_value_all
+  Aggregation function that runs all value search tests.
+*/
+bool
+d_tests_sa_scan_value_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Value Searches\n");
+    printf("  ------------------------\n");
+
+    result = d_tests_sa_scan_value_validation(_counter) && result;
+    result = d_tests_sa_scan_value_sizes(_counter) && result;
+    result = d_tests_sa_scan_value_positions(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,28 @@
+#include ".\sort_tests_sa.h"
+
+
+/*
+d_tests_sa_sort_run_all
+  Module-level aggregation function that runs all sort tests.
+  Executes tests for all categories:
+  - Full sorts, including the radix fast path
+  - Partial sort, nth element, and top-k selection
+  - Lower / upper bound, equal range, and partition point
+*/
+bool
+d_tests_sa_sort_run_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    // run all test categories
+    result = d_tests_sa_sort_sort_all(_counter)   && result;
+    result = d_tests_sa_sort_select_all(_counter) && result;
+    result = d_tests_sa_sort_search_all(_counter) && result;
+
+    return result;
+}
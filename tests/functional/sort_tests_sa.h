@@ -0,0 +1,69 @@
+/******************************************************************************
+* djinterp [test]                                               sort_tests_sa.h
+*
+*   Unit test declarations for `sort.h` module.
+*   Provides testing of introsort with context-carrying comparators, the
+* radix fast path for the built-in comparators, partial sort, nth element,
+* bounded-heap top-k selection, and the binary searches. Inputs include
+* duplicates, presorted and reversed runs, and adversarial patterns for the
+* quicksort pivot.
+*
+*
+* path:      \tests\functional\sort_tests_sa.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_TESTS_SORT_SA_
+#define DJINTERP_TESTS_SORT_SA_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "..\..\inc\djinterp.h"
+#include "..\..\inc\test\test_standalone.h"
+#include "..\..\inc\functional\functional.h"
+#include "..\..\inc\functional\sort.h"
+
+
+/******************************************************************************
+ * I. SORT TESTS
+ *****************************************************************************/
+bool d_tests_sa_sort_validation(struct d_test_counter* _counter);
+bool d_tests_sa_sort_patterns(struct d_test_counter* _counter);
+bool d_tests_sa_sort_context(struct d_test_counter* _counter);
+bool d_tests_sa_sort_radix(struct d_test_counter* _counter);
+
+// I.   aggregation function
+bool d_tests_sa_sort_sort_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * II. SELECTION TESTS
+ *****************************************************************************/
+bool d_tests_sa_sort_partial_sort(struct d_test_counter* _counter);
+bool d_tests_sa_sort_nth_element(struct d_test_counter* _counter);
+bool d_tests_sa_sort_top_k(struct d_test_counter* _counter);
+
+// II.  aggregation function
+bool d_tests_sa_sort_select_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * III. BINARY SEARCH TESTS
+ *****************************************************************************/
+bool d_tests_sa_sort_lower_upper_bound(struct d_test_counter* _counter);
+bool d_tests_sa_sort_equal_range(struct d_test_counter* _counter);
+bool d_tests_sa_sort_partition_point(struct d_test_counter* _counter);
+
+// III. aggregation function
+bool d_tests_sa_sort_search_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * MODULE-LEVEL AGGREGATION
+ *****************************************************************************/
+bool d_tests_sa_sort_run_all(struct d_test_counter* _counter);
+
+
+#endif  // DJINTERP_TESTS_SORT_SA_
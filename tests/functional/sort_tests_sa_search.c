@@ -0,0 +1,376 @@
+#include ".\sort_tests_sa.h"
+
+
+// search_cmp_int
+//   helper: ascending int comparator distinct from the built-in one, so the
+// generic search loop is exercised.
+static int
+search_cmp_int
+(
+    const void* _a,
+    const void* _b,
+    void*       _context
+)
+{
+    (void)_context;
+
+    return d_functional_compare_int(_a, _b, NULL);
+}
+
+// search_cmp_mod
+//   helper: orders ints by their remainder modulo the int context.
+static int
+search_cmp_mod
+(
+    const void* _a,
+    const void* _b,
+    void*       _context
+)
+{
+    int a;
+    int b;
+
+    a = *(const int*)_a % *(const int*)_context;
+    b = *(const int*)_b % *(const int*)_context;
+
+    return (a < b) ? -1 : ( (a > b) ? 1 : 0 );
+}
+
+// search_less_than
+//   helper: predicate true while the element is below the int context;
+// counts its calls through the second int of the context.
+static bool
+search_less_than
+(
+    const void* _element,
+    void*       _context
+)
+{
+    int* bound;
+
+    bound = (int*)_context;
+    bound[1]++;
+
+    return (*(const int*)_element < bound[0]);
+}
+
+// search_fill_runs
+//   helper: fills _values with the ascending sequence 0,0,0,1,1,1,2,...
+static void
+search_fill_runs
+(
+    int*   _values,
+    size_t _count
+)
+{
+    size_t i;
+
+    for (i = 0; i < _count; i++)
+    {
+        _values[i] = (int)(i / 3);
+    }
+
+    return;
+}
+
+
+/*
+d_tests_sa_sort_lower_upper_bound
+  Tests d_functional_lower_bound and d_functional_upper_bound.
+  Tests the following:
+  - NULL input / value / comparator and zero element size rejection
+  - bounds of present values with duplicates
+  - values below, between, and above the stored values
+  - the built-in and a custom comparator agree for int, size_t, and double
+*/
+bool
+d_tests_sa_sort_lower_upper_bound
+(
+    struct d_test_counter* _counter
+)
+{
+    bool   result;
+    bool   ok;
+    int    values[300];
+    size_t sizes[50];
+    double reals[50];
+    int    probe;
+    size_t size_probe;
+    double real_probe;
+    size_t i;
+
+    result = true;
+
+    search_fill_runs(values, 300);
+
+    for (i = 0; i < 50; i++)
+    {
+        sizes[i] = i * 2;
+        reals[i] = (double)i * 0.5;
+    }
+
+    probe = 7;
+
+    // test 1: rejection
+    result = d_assert_standalone(
+        (d_functional_lower_bound(NULL, 10, sizeof(int), &probe,
+                                  search_cmp_int, NULL) == (size_t)-1)  &&
+        (d_functional_lower_bound(values, 10, sizeof(int), NULL,
+                                  search_cmp_int, NULL) == (size_t)-1)  &&
+        (d_functional_upper_bound(values, 10, sizeof(int), &probe,
+                                  NULL, NULL) == (size_t)-1)            &&
+        (d_functional_upper_bound(values, 10, 0, &probe,
+                                  search_cmp_int, NULL) == (size_t)-1),
+        "bound_rejection",
+        "NULL pointers or zero element size should be rejected",
+        _counter) && result;
+
+    // test 2: duplicates, with the generic and the typed loop
+    result = d_assert_standalone(
+        (d_functional_lower_bound(values, 300, sizeof(int), &probe,
+                                  search_cmp_int, NULL) == 21)          &&
+        (d_functional_upper_bound(values, 300, sizeof(int), &probe,
+                                  search_cmp_int, NULL) == 24)          &&
+        (d_functional_lower_bound(values, 300, sizeof(int), &probe,
+                                  d_functional_compare_int,
+                                  NULL) == 21)                          &&
+        (d_functional_upper_bound(values, 300, sizeof(int), &probe,
+                                  d_functional_compare_int,
+                                  NULL) == 24),
+        "bound_duplicates",
+        "a run of three 7s should span [21, 24)",
+        _counter) && result;
+
+    // test 3: out-of-range probes
+    probe = -5;
+    ok    = (d_functional_lower_bound(values, 300, sizeof(int), &probe,
+                                      d_functional_compare_int,
+                                      NULL) == 0);
+    probe = 500;
+    ok    = ok &&
+            (d_functional_upper_bound(values, 300, sizeof(int), &probe,
+                                      search_cmp_int, NULL) == 300) &&
+            (d_functional_lower_bound(values, 0, sizeof(int), &probe,
+                                      search_cmp_int, NULL) == 0);
+
+    result = d_assert_standalone(
+        ok,
+        "bound_out_of_range",
+        "probes outside the values should bound at the ends",
+        _counter) && result;
+
+    // test 4: size_t and double fast paths between stored values
+    size_probe = 31;
+    real_probe = 10.25;
+
+    result = d_assert_standalone(
+        (d_functional_lower_bound(sizes, 50, sizeof(size_t), &size_probe,
+                                  d_functional_compare_size_t,
+                                  NULL) == 16)                          &&
+        (d_functional_upper_bound(sizes, 50, sizeof(size_t), &size_probe,
+                                  d_functional_compare_size_t,
+                                  NULL) == 16)                          &&
+        (d_functional_lower_bound(reals, 50, sizeof(double), &real_probe,
+                                  d_functional_compare_double,
+                                  NULL) == 21)                          &&
+        (d_functional_upper_bound(reals, 50, sizeof(double), &real_probe,
+                                  d_functional_compare_double,
+                                  NULL) == 21),
+        "bound_typed",
+        "absent size_t and double probes should bound at the next value",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_sort_equal_range
+  Tests d_functional_equal_range.
+  Tests the following:
+  - NULL output pointer rejection
+  - the range of a present value, and an empty range for an absent one
+  - a context-carrying comparator
+*/
+bool
+d_tests_sa_sort_equal_range
+(
+    struct d_test_counter* _counter
+)
+{
+    bool   result;
+    int    values[300];
+    int    modulus[12];
+    int    probe;
+    int    modulus_value;
+    size_t first;
+    size_t last;
+    size_t i;
+
+    result = true;
+
+    search_fill_runs(values, 300);
+
+    probe = 42;
+
+    // test 1: rejection
+    result = d_assert_standalone(
+        (!d_functional_equal_range(values, 300, sizeof(int), &probe,
+                                   search_cmp_int, NULL, NULL, &last))   &&
+        (!d_functional_equal_range(values, 300, sizeof(int), &probe,
+                                   search_cmp_int, NULL, &first, NULL)),
+        "equal_range_rejection",
+        "NULL output pointers should be rejected",
+        _counter) && result;
+
+    // test 2: present and absent values
+    result = d_assert_standalone(
+        (d_functional_equal_range(values, 300, sizeof(int), &probe,
+                                  d_functional_compare_int, NULL,
+                                  &first, &last))                       &&
+        (first == 126)                                                  &&
+        (last == 129),
+        "equal_range_present",
+        "a run of three 42s should span [126, 129)",
+        _counter) && result;
+
+    probe = 1000;
+
+    result = d_assert_standalone(
+        (d_functional_equal_range(values, 300, sizeof(int), &probe,
+                                  search_cmp_int, NULL, &first, &last)) &&
+        (first == 300)                                                  &&
+        (last == 300),
+        "equal_range_absent",
+        "an absent value should give an empty range at its position",
+        _counter) && result;
+
+    // test 3: context-carrying comparator (remainders 0,0,0,0,1,1,1,1,2,...)
+    modulus_value = 3;
+
+    for (i = 0; i < 12; i++)
+    {
+        modulus[i] = (int)((i / 4) + (3 * i));
+    }
+
+    probe = 7;
+
+    result = d_assert_standalone(
+        (d_functional_equal_range(modulus, 12, sizeof(int), &probe,
+                                  search_cmp_mod, &modulus_value,
+                                  &first, &last))                       &&
+        (first == 4)                                                    &&
+        (last == 8),
+        "equal_range_context",
+        "the comparator context should define the equivalence",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_sort_partition_point
+  Tests d_functional_partition_point.
+  Tests the following:
+  - NULL input / predicate rejection
+  - the boundary for thresholds inside and outside the values
+  - the predicate is called a logarithmic number of times
+*/
+bool
+d_tests_sa_sort_partition_point
+(
+    struct d_test_counter* _counter
+)
+{
+    bool   result;
+    int    values[3000];
+    int    bound[2];
+    size_t point;
+    size_t i;
+
+    result = true;
+
+    for (i = 0; i < 3000; i++)
+    {
+        values[i] = (int)i;
+    }
+
+    bound[0] = 10;
+    bound[1] = 0;
+
+    // test 1: rejection
+    result = d_assert_standalone(
+        (d_functional_partition_point(NULL, 10, sizeof(int),
+                                      search_less_than,
+                                      bound) == (size_t)-1)             &&
+        (d_functional_partition_point(values, 10, sizeof(int), NULL,
+                                      bound) == (size_t)-1),
+        "partition_point_rejection",
+        "NULL input or predicate should be rejected",
+        _counter) && result;
+
+    // test 2: interior boundary with few predicate calls
+    bound[0] = 1234;
+    bound[1] = 0;
+    point    = d_functional_partition_point(values,
+                                            3000,
+                                            sizeof(int),
+                                            search_less_than,
+                                            bound);
+
+    result = d_assert_standalone(
+        (point == 1234) &&
+        (bound[1] <= 13),
+        "partition_point_interior",
+        "the boundary should be found in O(log n) predicate calls",
+        _counter) && result;
+
+    // test 3: predicate true / false everywhere
+    bound[0] = 5000;
+
+    result = d_assert_standalone(
+        (d_functional_partition_point(values, 3000, sizeof(int),
+                                      search_less_than,
+                                      bound) == 3000),
+        "partition_point_all_true",
+        "an always-true predicate should give the count",
+        _counter) && result;
+
+    bound[0] = -1;
+
+    result = d_assert_standalone(
+        (d_functional_partition_point(values, 3000, sizeof(int),
+                                      search_less_than,
+                                      bound) == 0),
+        "partition_point_all_false",
+        "an always-false predicate should give 0",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_sort_search_all
+  Aggregation function that runs all binary search tests.
+*/
+bool
+d_tests_sa_sort_search_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Binary Search\n");
+    printf("  -----------------------\n");
+
+    result = d_tests_sa_sort_lower_upper_bound(_counter) && result;
+    result = d_tests_sa_sort_equal_range(_counter) && result;
+    result = d_tests_sa_sort_partition_point(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,380 @@
+#include ".\sort_tests_sa.h"
+
+
+// select_cmp_int
+//   helper: ascending int comparator distinct from the built-in one.
+static int
+select_cmp_int
+(
+    const void* _a,
+    const void* _b,
+    void*       _context
+)
+{
+    (void)_context;
+
+    return d_functional_compare_int(_a, _b, NULL);
+}
+
+// select_cmp_int_desc
+//   helper: descending int comparator.
+static int
+select_cmp_int_desc
+(
+    const void* _a,
+    const void* _b,
+    void*       _context
+)
+{
+    (void)_context;
+
+    return d_functional_compare_int(_b, _a, NULL);
+}
+
+// select_cmp_distance
+//   helper: orders ints by distance from the int context, nearest last.
+static int
+select_cmp_distance
+(
+    const void* _a,
+    const void* _b,
+    void*       _context
+)
+{
+    int a;
+    int b;
+
+    a = abs(*(const int*)_a - *(const int*)_context);
+    b = abs(*(const int*)_b - *(const int*)_context);
+
+    return (a > b) ? -1 : ( (a < b) ? 1 : 0 );
+}
+
+// select_fill
+//   helper: fills _values with a permutation of [0, _count).
+static void
+select_fill
+(
+    int*   _values,
+    size_t _count
+)
+{
+    size_t i;
+
+    // 7919 is prime, so i * 7919 mod count is a permutation unless count is
+    // a multiple of it
+    for (i = 0; i < _count; i++)
+    {
+        _values[i] = (int)((i * 7919) % _count);
+    }
+
+    return;
+}
+
+
+/*
+d_tests_sa_sort_partial_sort
+  Tests d_functional_partial_sort.
+  Tests the following:
+  - NULL input / comparator and zero element size rejection
+  - the first k elements are the k least, in ascending order
+  - k = 0 and k >= count
+*/
+bool
+d_tests_sa_sort_partial_sort
+(
+    struct d_test_counter* _counter
+)
+{
+    bool   result;
+    bool   ok;
+    int    values[1000];
+    size_t i;
+
+    result = true;
+
+    select_fill(values, 1000);
+
+    // test 1: rejection
+    result = d_assert_standalone(
+        (!d_functional_partial_sort(NULL, 10, sizeof(int), 3,
+                                    select_cmp_int, NULL))            &&
+        (!d_functional_partial_sort(values, 10, sizeof(int), 3,
+                                    NULL, NULL))                      &&
+        (!d_functional_partial_sort(values, 10, 0, 3,
+                                    select_cmp_int, NULL)),
+        "partial_sort_rejection",
+        "NULL pointers or zero element size should be rejected",
+        _counter) && result;
+
+    // test 2: k least in order
+    ok = d_functional_partial_sort(values,
+                                   1000,
+                                   sizeof(int),
+                                   25,
+                                   select_cmp_int,
+                                   NULL);
+
+    for (i = 0; (ok) && (i < 25); i++)
+    {
+        ok = (values[i] == (int)i);
+    }
+
+    result = d_assert_standalone(
+        ok,
+        "partial_sort_prefix",
+        "the first k elements should be 0..k-1 in order",
+        _counter) && result;
+
+    // test 3: k = 0 and k >= count
+    select_fill(values, 1000);
+
+    ok = d_functional_partial_sort(values,
+                                   1000,
+                                   sizeof(int),
+                                   0,
+                                   select_cmp_int,
+                                   NULL)                        &&
+         (values[1] == 7919 % 1000)                             &&
+         d_functional_partial_sort(values,
+                                   1000,
+                                   sizeof(int),
+                                   5000,
+                                   select_cmp_int,
+                                   NULL)                        &&
+         d_functional_is_sorted(values,
+                                1000,
+                                sizeof(int),
+                                select_cmp_int);
+
+    result = d_assert_standalone(
+        ok,
+        "partial_sort_bounds",
+        "k = 0 should be a no-op and k >= count a full sort",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_sort_nth_element
+  Tests d_functional_nth_element.
+  Tests the following:
+  - NULL input and out-of-range n rejection
+  - the nth element is placed, with smaller elements before it and larger
+    after it, for several positions
+  - a context-carrying comparator
+*/
+bool
+d_tests_sa_sort_nth_element
+(
+    struct d_test_counter* _counter
+)
+{
+    bool   result;
+    bool   ok;
+    int    values[2000];
+    int    target;
+    size_t positions[5];
+    size_t p;
+    size_t i;
+
+    result       = true;
+    positions[0] = 0;
+    positions[1] = 1;
+    positions[2] = 999;
+    positions[3] = 1500;
+    positions[4] = 1999;
+
+    select_fill(values, 2000);
+
+    // test 1: rejection
+    result = d_assert_standalone(
+        (!d_functional_nth_element(NULL, 10, sizeof(int), 3,
+                                   select_cmp_int, NULL))             &&
+        (!d_functional_nth_element(values, 10, sizeof(int), 10,
+                                   select_cmp_int, NULL))             &&
+        (!d_functional_nth_element(values, 10, sizeof(int), 3,
+                                   NULL, NULL)),
+        "nth_element_rejection",
+        "NULL pointers or n >= count should be rejected",
+        _counter) && result;
+
+    // test 2: positions
+    ok = true;
+
+    for (p = 0; (ok) && (p < 5); p++)
+    {
+        select_fill(values, 2000);
+
+        ok = d_functional_nth_element(values,
+                                      2000,
+                                      sizeof(int),
+                                      positions[p],
+                                      select_cmp_int,
+                                      NULL)                    &&
+             (values[positions[p]] == (int)positions[p]);
+
+        for (i = 0; (ok) && (i < 2000); i++)
+        {
+            ok = (i < positions[p])
+                 ? (values[i] < (int)positions[p])
+                 : (values[i] >= (int)positions[p]);
+        }
+    }
+
+    result = d_assert_standalone(
+        ok,
+        "nth_element_positions",
+        "the nth element should partition the array",
+        _counter) && result;
+
+    // test 3: context comparator (nearest to 1234 ends up last)
+    select_fill(values, 2000);
+    target = 1234;
+
+    result = d_assert_standalone(
+        (d_functional_nth_element(values,
+                                  2000,
+                                  sizeof(int),
+                                  1999,
+                                  select_cmp_distance,
+                                  &target)) &&
+        (values[1999] == 1234),
+        "nth_element_context",
+        "the comparator context should be forwarded",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_sort_top_k
+  Tests d_functional_top_k.
+  Tests the following:
+  - NULL input / output / comparator rejection
+  - k greatest elements, greatest first
+  - the input is not modified
+  - k > count and k = 0
+  - a reversed comparator selects the k least
+*/
+bool
+d_tests_sa_sort_top_k
+(
+    struct d_test_counter* _counter
+)
+{
+    bool   result;
+    bool   ok;
+    int    values[3000];
+    int    copy[3000];
+    int    out[3000];
+    size_t written;
+    size_t i;
+
+    result = true;
+
+    select_fill(values, 3000);
+    memcpy(copy, values, sizeof(values));
+
+    // test 1: rejection
+    result = d_assert_standalone(
+        (d_functional_top_k(NULL, 10, sizeof(int), 3, out,
+                            select_cmp_int, NULL) == 0)               &&
+        (d_functional_top_k(values, 10, sizeof(int), 3, NULL,
+                            select_cmp_int, NULL) == 0)               &&
+        (d_functional_top_k(values, 10, sizeof(int), 3, out,
+                            NULL, NULL) == 0),
+        "top_k_rejection",
+        "NULL pointers should be rejected",
+        _counter) && result;
+
+    // test 2: greatest first, input untouched
+    written = d_functional_top_k(values,
+                                 3000,
+                                 sizeof(int),
+                                 10,
+                                 out,
+                                 select_cmp_int,
+                                 NULL);
+    ok      = (written == 10);
+
+    for (i = 0; (ok) && (i < 10); i++)
+    {
+        ok = (out[i] == (int)(2999 - i));
+    }
+
+    result = d_assert_standalone(
+        ok && (memcmp(values, copy, sizeof(values)) == 0),
+        "top_k_greatest",
+        "top_k should return the greatest elements without modifying input",
+        _counter) && result;
+
+    // test 3: bounds
+    written = d_functional_top_k(values,
+                                 5,
+                                 sizeof(int),
+                                 100,
+                                 out,
+                                 select_cmp_int,
+                                 NULL);
+
+    result = d_assert_standalone(
+        (written == 5)                                    &&
+        (d_functional_is_sorted(out,
+                                5,
+                                sizeof(int),
+                                select_cmp_int_desc))     &&
+        (d_functional_top_k(values, 3000, sizeof(int), 0, out,
+                            select_cmp_int, NULL) == 0),
+        "top_k_bounds",
+        "k > count should return every element and k = 0 none",
+        _counter) && result;
+
+    // test 4: reversed comparator
+    written = d_functional_top_k(values,
+                                 3000,
+                                 sizeof(int),
+                                 3,
+                                 out,
+                                 select_cmp_int_desc,
+                                 NULL);
+
+    result = d_assert_standalone(
+        (written == 3) &&
+        (out[0] == 0)  &&
+        (out[1] == 1)  &&
+        (out[2] == 2),
+        "top_k_least",
+        "a reversed comparator should select the least elements",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_sort_select_all
+  Aggregation function that runs all selection tests.
+*/
+bool
+d_tests_sa_sort_select_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Selection\n");
+    printf("  -------------------\n");
+
+    result = d_tests_sa_sort_partial_sort(_counter) && result;
+    result = d_tests_sa_sort_nth_element(_counter) && result;
+    result = d_tests_sa_sort_top_k(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,570 @@
+#include ".\sort_tests_sa.h"
+#include <limits.h>
+#include <math.h>
+
+
+// sort_test_record
+//   helper: element larger than the swap buffer, keyed by `key`.
+struct sort_test_record
+{
+    int    key;
+    char   payload[76];
+    size_t original;
+};
+
+
+// sort_cmp_int
+//   helper: ascending int comparator distinct from the built-in one, so the
+// introsort path is taken.
+static int
+sort_cmp_int
+(
+    const void* _a,
+    const void* _b,
+    void*       _context
+)
+{
+    (void)_context;
+
+    return d_functional_compare_int(_a, _b, NULL);
+}
+
+// sort_cmp_size_t
+//   helper: ascending size_t comparator distinct from the built-in one.
+static int
+sort_cmp_size_t
+(
+    const void* _a,
+    const void* _b,
+    void*       _context
+)
+{
+    (void)_context;
+
+    return d_functional_compare_size_t(_a, _b, NULL);
+}
+
+// sort_cmp_double
+//   helper: ascending double comparator distinct from the built-in one.
+static int
+sort_cmp_double
+(
+    const void* _a,
+    const void* _b,
+    void*       _context
+)
+{
+    (void)_context;
+
+    return d_functional_compare_double(_a, _b, NULL);
+}
+
+// sort_cmp_mod_desc
+//   helper: orders ints by descending value modulo the int context and counts
+// comparisons in the second int of the context.
+static int
+sort_cmp_mod_desc
+(
+    const void* _a,
+    const void* _b,
+    void*       _context
+)
+{
+    int* context;
+    int  a;
+    int  b;
+
+    context = (int*)_context;
+    a       = *(const int*)_a % context[0];
+    b       = *(const int*)_b % context[0];
+
+    context[1]++;
+
+    return (a > b) ? -1 : ( (a < b) ? 1 : 0 );
+}
+
+// sort_cmp_record
+//   helper: ascending comparator on sort_test_record keys.
+static int
+sort_cmp_record
+(
+    const void* _a,
+    const void* _b,
+    void*       _context
+)
+{
+    (void)_context;
+
+    return d_functional_compare_int(&((const struct sort_test_record*)_a)->key,
+                                    &((const struct sort_test_record*)_b)->key,
+                                    NULL);
+}
+
+// sort_fill
+//   helper: fills _values with pattern _pattern over the range [0, 1000).
+static void
+sort_fill
+(
+    int*   _values,
+    size_t _count,
+    int    _pattern
+)
+{
+    size_t   i;
+    uint32_t state;
+
+    state = 12345u;
+
+    for (i = 0; i < _count; i++)
+    {
+        switch (_pattern)
+        {
+        case 0:
+            state      = (state * 1103515245u) + 12345u;
+            _values[i] = (int)((state >> 8) % 1000);
+
+            break;
+
+        case 1:
+            _values[i] = (int)(i % 1000);
+
+            break;
+
+        case 2:
+            _values[i] = (int)((_count - i) % 1000);
+
+            break;
+
+        case 3:
+            _values[i] = 7;
+
+            break;
+
+        case 4:
+            _values[i] = (int)(i % 3);
+
+            break;
+
+        default:
+            // organ pipe
+            _values[i] = (int)(((i < _count / 2) ? i : (_count - i)) % 1000);
+
+            break;
+        }
+    }
+
+    return;
+}
+
+// sort_same_histogram
+//   helper: true if two arrays of values in [0, 1000) are permutations of
+// each other.
+static bool
+sort_same_histogram
+(
+    const int* _a,
+    const int* _b,
+    size_t     _count
+)
+{
+    long   histogram[1000];
+    size_t i;
+
+    memset(histogram, 0, sizeof(histogram));
+
+    for (i = 0; i < _count; i++)
+    {
+        histogram[_a[i]]++;
+        histogram[_b[i]]--;
+    }
+
+    for (i = 0; i < 1000; i++)
+    {
+        if (histogram[i] != 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+/*
+d_tests_sa_sort_validation
+  Tests parameter validation of d_functional_sort.
+  Tests the following:
+  - NULL input / comparator rejection
+  - zero element size rejection
+  - empty and single-element arrays succeed
+*/
+bool
+d_tests_sa_sort_validation
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+    int  values[2];
+
+    result    = true;
+    values[0] = 2;
+    values[1] = 1;
+
+    // test 1: NULL / zero
+    result = d_assert_standalone(
+        (!d_functional_sort(NULL, 2, sizeof(int), sort_cmp_int, NULL))   &&
+        (!d_functional_sort(values, 2, sizeof(int), NULL, NULL))         &&
+        (!d_functional_sort(values, 2, 0, sort_cmp_int, NULL)),
+        "sort_null_zero",
+        "NULL pointers or zero element size should be rejected",
+        _counter) && result;
+
+    // test 2: trivial sizes
+    result = d_assert_standalone(
+        (d_functional_sort(values, 0, sizeof(int), sort_cmp_int, NULL)) &&
+        (d_functional_sort(values, 1, sizeof(int), sort_cmp_int, NULL)) &&
+        (values[0] == 2),
+        "sort_trivial",
+        "empty and single-element arrays should be left alone",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_sort_patterns
+  Tests d_functional_sort on structured inputs.
+  Tests the following:
+  - random, sorted, reversed, constant, few-distinct, and organ-pipe inputs
+  - lengths around the insertion-sort threshold and well above it
+  - output is sorted and a permutation of the input
+  - elements larger than the internal swap buffer
+*/
+bool
+d_tests_sa_sort_patterns
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                     result;
+    bool                     sorted;
+    size_t                   sizes[7];
+    size_t                   s;
+    size_t                   i;
+    int                      pattern;
+    int*                     values;
+    int*                     original;
+    struct sort_test_record* records;
+
+    result   = true;
+    sizes[0] = 2;
+    sizes[1] = D_SORT_INSERTION_THRESHOLD;
+    sizes[2] = D_SORT_INSERTION_THRESHOLD + 1;
+    sizes[3] = 100;
+    sizes[4] = 1000;
+    sizes[5] = 4099;
+    sizes[6] = 20000;
+    values   = malloc(sizes[6] * sizeof(int));
+    original = malloc(sizes[6] * sizeof(int));
+    records  = malloc(1000 * sizeof(struct sort_test_record));
+
+    if ( (!values)   ||
+         (!original) ||
+         (!records) )
+    {
+        free(values);
+        free(original);
+        free(records);
+
+        return result;
+    }
+
+    // test 1: patterns and sizes
+    sorted = true;
+
+    for (pattern = 0; (sorted) && (pattern < 6); pattern++)
+    {
+        for (s = 0; (sorted) && (s < 7); s++)
+        {
+            sort_fill(original, sizes[s], pattern);
+            memcpy(values, original, sizes[s] * sizeof(int));
+
+            sorted = d_functional_sort(values,
+                                       sizes[s],
+                                       sizeof(int),
+                                       sort_cmp_int,
+                                       NULL)                          &&
+                     d_functional_is_sorted(values,
+                                            sizes[s],
+                                            sizeof(int),
+                                            sort_cmp_int)             &&
+                     sort_same_histogram(values, original, sizes[s]);
+        }
+    }
+
+    result = d_assert_standalone(
+        sorted,
+        "sort_patterns",
+        "every pattern and size should sort to a permutation",
+        _counter) && result;
+
+    // test 2: large elements
+    sort_fill(original, 1000, 0);
+
+    for (i = 0; i < 1000; i++)
+    {
+        records[i].key      = original[i];
+        records[i].original = i;
+        memset(records[i].payload, (int)(i & 0x7F), sizeof(records[i].payload));
+    }
+
+    sorted = d_functional_sort(records,
+                               1000,
+                               sizeof(struct sort_test_record),
+                               sort_cmp_record,
+                               NULL);
+
+    for (i = 0; (sorted) && (i < 1000); i++)
+    {
+        sorted = ( (i == 0) || (records[i - 1].key <= records[i].key) ) &&
+                 (records[i].key == original[records[i].original])      &&
+                 (records[i].payload[75] ==
+                      (char)(records[i].original & 0x7F));
+    }
+
+    result = d_assert_standalone(
+        sorted,
+        "sort_large_elements",
+        "elements larger than the swap buffer should move intact",
+        _counter) && result;
+
+    free(values);
+    free(original);
+    free(records);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_sort_context
+  Tests that d_functional_sort forwards the comparator context.
+  Tests the following:
+  - a context-parameterized ordering is honoured
+  - the comparator receives the same context on every call
+*/
+bool
+d_tests_sa_sort_context
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+    bool sorted;
+    int  values[50];
+    int  context[2];
+    int  i;
+
+    result     = true;
+    context[0] = 10;
+    context[1] = 0;
+
+    for (i = 0; i < 50; i++)
+    {
+        values[i] = (i * 37) % 50;
+    }
+
+    // test 1: descending by value mod 10
+    sorted = d_functional_sort(values,
+                               50,
+                               sizeof(int),
+                               sort_cmp_mod_desc,
+                               context);
+
+    for (i = 1; (sorted) && (i < 50); i++)
+    {
+        sorted = (values[i - 1] % 10) >= (values[i] % 10);
+    }
+
+    result = d_assert_standalone(
+        sorted && (context[1] > 0),
+        "sort_context",
+        "the comparator should be called with the caller's context",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_sort_radix
+  Tests the radix fast path for the built-in comparators.
+  Tests the following:
+  - int input with negatives and extreme values matches introsort
+  - size_t input with large values matches introsort
+  - double input with negatives and infinities matches introsort
+  - -0.0 sorts before 0.0
+*/
+bool
+d_tests_sa_sort_radix
+(
+    struct d_test_counter* _counter
+)
+{
+    bool     result;
+    size_t   count;
+    size_t   i;
+    uint32_t state;
+    int*     ints;
+    int*     ints_ref;
+    size_t*  sizes;
+    size_t*  sizes_ref;
+    double*  doubles;
+    double*  doubles_ref;
+    double   zeros[D_SORT_RADIX_THRESHOLD];
+
+    result      = true;
+    count       = 5000;
+    state       = 99u;
+    ints        = malloc(count * sizeof(int));
+    ints_ref    = malloc(count * sizeof(int));
+    sizes       = malloc(count * sizeof(size_t));
+    sizes_ref   = malloc(count * sizeof(size_t));
+    doubles     = malloc(count * sizeof(double));
+    doubles_ref = malloc(count * sizeof(double));
+
+    if ( (!ints)      || (!ints_ref)  ||
+         (!sizes)     || (!sizes_ref) ||
+         (!doubles)   || (!doubles_ref) )
+    {
+        free(ints);
+        free(ints_ref);
+        free(sizes);
+        free(sizes_ref);
+        free(doubles);
+        free(doubles_ref);
+
+        return result;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        state      = (state * 1664525u) + 1013904223u;
+        ints[i]    = (int)(state ^ (state << 7));
+        sizes[i]   = ((size_t)state << 3) ^ (size_t)i;
+        doubles[i] = ((double)(int32_t)state) / 1024.0;
+    }
+
+    ints[0]    = INT_MIN;
+    ints[1]    = INT_MAX;
+    ints[2]    = 0;
+    ints[3]    = -1;
+    sizes[0]   = (size_t)-1;
+    sizes[1]   = 0;
+    doubles[0] = -HUGE_VAL;
+    doubles[1] = HUGE_VAL;
+    doubles[2] = -1.0e-300;
+
+    memcpy(ints_ref, ints, count * sizeof(int));
+    memcpy(sizes_ref, sizes, count * sizeof(size_t));
+    memcpy(doubles_ref, doubles, count * sizeof(double));
+
+    d_functional_sort(ints_ref, count, sizeof(int), sort_cmp_int, NULL);
+    d_functional_sort(sizes_ref, count, sizeof(size_t), sort_cmp_size_t, NULL);
+    d_functional_sort(doubles_ref, count, sizeof(double), sort_cmp_double, NULL);
+
+    // test 1: int
+    result = d_assert_standalone(
+        (d_functional_sort(ints,
+                           count,
+                           sizeof(int),
+                           d_functional_compare_int,
+                           NULL)) &&
+        (memcmp(ints, ints_ref, count * sizeof(int)) == 0),
+        "sort_radix_int",
+        "radix-sorted ints should match introsort",
+        _counter) && result;
+
+    // test 2: size_t
+    result = d_assert_standalone(
+        (d_functional_sort(sizes,
+                           count,
+                           sizeof(size_t),
+                           d_functional_compare_size_t,
+                           NULL)) &&
+        (memcmp(sizes, sizes_ref, count * sizeof(size_t)) == 0),
+        "sort_radix_size_t",
+        "radix-sorted size_t values should match introsort",
+        _counter) && result;
+
+    // test 3: double
+    result = d_assert_standalone(
+        (d_functional_sort(doubles,
+                           count,
+                           sizeof(double),
+                           d_functional_compare_double,
+                           NULL)) &&
+        (memcmp(doubles, doubles_ref, count * sizeof(double)) == 0) &&
+        (doubles[0] == -HUGE_VAL) &&
+        (doubles[count - 1] == HUGE_VAL),
+        "sort_radix_double",
+        "radix-sorted doubles should match introsort",
+        _counter) && result;
+
+    // test 4: signed zeros
+    for (i = 0; i < D_SORT_RADIX_THRESHOLD; i++)
+    {
+        zeros[i] = (i % 2) ? 0.0 : -0.0;
+    }
+
+    d_functional_sort(zeros,
+                      D_SORT_RADIX_THRESHOLD,
+                      sizeof(double),
+                      d_functional_compare_double,
+                      NULL);
+
+    result = d_assert_standalone(
+        (signbit(zeros[0]))                                &&
+        (signbit(zeros[(D_SORT_RADIX_THRESHOLD / 2) - 1])) &&
+        (!signbit(zeros[D_SORT_RADIX_THRESHOLD / 2])),
+        "sort_radix_signed_zero",
+        "-0.0 should sort before 0.0",
+        _counter) && result;
+
+    free(ints);
+    free(ints_ref);
+    free(sizes);
+    free(sizes_ref);
+    free(doubles);
+    free(doubles_ref);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_sort_sort_all
+  Aggregation function that runs all sort tests.
+*/
+bool
+d_tests_sa_sort_sort_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Sort\n");
+    printf("  --------------\n");
+
+    result = d_tests_sa_sort_validation(_counter) && result;
+    result = d_tests_sa_sort_patterns(_counter) && result;
+    result = d_tests_sa_sort_context(_counter) && result;
+    result = d_tests_sa_sort_radix(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,24 @@
+#include ".\specialize_tests_sa.h"
+
+
+/*
+d_tests_sa_specialize_run_all
+  Module-level aggregation function that runs all specialization tests.
+  Executes tests for all categories:
+  - Typed map, filter, fold, quantifiers, and fused filter-map-fold
+*/
+bool
+d_tests_sa_specialize_run_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    // run all test categories
+    result = d_tests_sa_specialize_ops_all(_counter) && result;
+
+    return result;
+}
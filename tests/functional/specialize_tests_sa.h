@@ -0,0 +1,47 @@
+/******************************************************************************
+* djinterp [test]                                         specialize_tests_sa.h
+*
+*   Unit test declarations for `specialize.h` module.
+*   Provides testing of the typed families emitted by
+* D_FUNCTIONAL_SPECIALIZE for a primitive and a struct type: parameter
+* validation, agreement with the generic d_functional_* functions, short
+* circuiting, and the fused filter-map-fold.
+*
+*
+* path:      \tests\functional\specialize_tests_sa.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_TESTS_SPECIALIZE_SA_
+#define DJINTERP_TESTS_SPECIALIZE_SA_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "..\..\inc\djinterp.h"
+#include "..\..\inc\test\test_standalone.h"
+#include "..\..\inc\functional\functional.h"
+#include "..\..\inc\functional\specialize.h"
+
+
+/******************************************************************************
+ * I. SPECIALIZATION TESTS
+ *****************************************************************************/
+bool d_tests_sa_specialize_validation(struct d_test_counter* _counter);
+bool d_tests_sa_specialize_agreement(struct d_test_counter* _counter);
+bool d_tests_sa_specialize_short_circuit(struct d_test_counter* _counter);
+bool d_tests_sa_specialize_fused(struct d_test_counter* _counter);
+bool d_tests_sa_specialize_struct(struct d_test_counter* _counter);
+
+// I.   aggregation function
+bool d_tests_sa_specialize_ops_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * MODULE-LEVEL AGGREGATION
+ *****************************************************************************/
+bool d_tests_sa_specialize_run_all(struct d_test_counter* _counter);
+
+
+#endif  // DJINTERP_TESTS_SPECIALIZE_SA_
@@ -0,0 +1,526 @@
+#include ".\specialize_tests_sa.h"
+
+
+// spec_point
+//   helper: struct element type for the struct specialization.
+struct spec_point
+{
+    int x;
+    int y;
+};
+
+D_GEN_FUNCTIONAL_PREDICATE_POSITIVE(spec_is_positive, int)
+D_GEN_FUNCTIONAL_PREDICATE_GT_CONTEXT(spec_greater_than, int)
+D_GEN_FUNCTIONAL_DEFINE_XFORM_SQUARE(spec_square, int)
+D_DEFINE_ACC_SUM(spec_sum, int)
+
+D_FUNCTIONAL_SPECIALIZE(spec_int, int)
+D_FUNCTIONAL_SPECIALIZE(spec_point_array, struct spec_point)
+
+// spec_counted_negative
+//   helper: predicate true for negative ints; counts its calls through the
+// int context.
+static bool
+spec_counted_negative
+(
+    const void* _element,
+    void*       _context
+)
+{
+    (*(int*)_context)++;
+
+    return (*(const int*)_element < 0);
+}
+
+// spec_fail_at_zero
+//   helper: transformer copying ints that fails on 0.
+static bool
+spec_fail_at_zero
+(
+    const void* _input,
+    void*       _output,
+    void*       _context
+)
+{
+    (void)_context;
+
+    if (*(const int*)_input == 0)
+    {
+        return false;
+    }
+
+    *(int*)_output = *(const int*)_input;
+
+    return true;
+}
+
+// spec_on_diagonal
+//   helper: predicate true for points with x == y.
+static bool
+spec_on_diagonal
+(
+    const void* _element,
+    void*       _context
+)
+{
+    const struct spec_point* point;
+
+    (void)_context;
+
+    point = (const struct spec_point*)_element;
+
+    return (point->x == point->y);
+}
+
+// spec_swap_point
+//   helper: transformer exchanging x and y.
+static bool
+spec_swap_point
+(
+    const void* _input,
+    void*       _output,
+    void*       _context
+)
+{
+    const struct spec_point* in;
+    struct spec_point*       out;
+
+    (void)_context;
+
+    in     = (const struct spec_point*)_input;
+    out    = (struct spec_point*)_output;
+    out->x = in->y;
+    out->y = in->x;
+
+    return true;
+}
+
+// spec_sum_x
+//   helper: accumulator adding the x of each point to an int.
+static bool
+spec_sum_x
+(
+    void*       _accumulated,
+    const void* _element,
+    void*       _context
+)
+{
+    (void)_context;
+
+    *(int*)_accumulated += ((const struct spec_point*)_element)->x;
+
+    return true;
+}
+
+// spec_fill
+//   helper: fills _values with a mix of negative and positive ints.
+static void
+spec_fill
+(
+    int*   _values,
+    size_t _count
+)
+{
+    size_t i;
+
+    for (i = 0; i < _count; i++)
+    {
+        _values[i] = (int)((i * 37) % 100) - 40;
+    }
+
+    return;
+}
+
+
+/*
+d_tests_sa_specialize_validation
+  Tests parameter validation of the specialized functions.
+  Tests the following:
+  - NULL input / output / callback rejection
+  - zero count gives the same results as the generic functions
+*/
+bool
+d_tests_sa_specialize_validation
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+    int  values[4] = { 1, 2, 3, 4 };
+    int  out[4];
+    int  total;
+
+    result = true;
+    total  = 0;
+
+    // test 1: NULL rejection
+    result = d_assert_standalone(
+        (!spec_int_map(NULL, out, 4, spec_square, NULL))                &&
+        (!spec_int_map(values, NULL, 4, spec_square, NULL))             &&
+        (spec_int_filter(values, out, 4, NULL, NULL) == 0)              &&
+        (!spec_int_fold(values, 4, NULL, spec_sum, NULL))               &&
+        (spec_int_count_if(NULL, 4, spec_is_positive, NULL) == 0)       &&
+        (spec_int_find_if(values, 4, NULL, NULL) == NULL)               &&
+        (!spec_int_filter_map_fold(values, 4, NULL, NULL,
+                                   NULL, NULL,
+                                   &total, spec_sum, NULL)),
+        "specialize_rejection",
+        "NULL pointers and callbacks should be rejected",
+        _counter) && result;
+
+    // test 2: zero count matches the generic API
+    result = d_assert_standalone(
+        (spec_int_map(values, out, 0, spec_square, NULL) ==
+             d_functional_map(values, out, 0, sizeof(int),
+                              spec_square, NULL))                       &&
+        (spec_int_fold(values, 0, &total, spec_sum, NULL) ==
+             d_functional_fold_left(values, 0, sizeof(int),
+                                    &total, spec_sum, NULL))            &&
+        (spec_int_all(values, 0, spec_is_positive, NULL) ==
+             d_functional_all(values, 0, sizeof(int),
+                              spec_is_positive, NULL))                  &&
+        (spec_int_none(values, 0, spec_is_positive, NULL) ==
+             d_functional_none(values, 0, sizeof(int),
+                               spec_is_positive, NULL))                 &&
+        (!spec_int_any(values, 0, spec_is_positive, NULL)),
+        "specialize_zero_count",
+        "empty inputs should behave like the generic functions",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_specialize_agreement
+  Tests that the specialized functions agree with the generic ones.
+  Tests the following:
+  - map, filter, fold, count_if, find_if, any, all, none
+  - a context-carrying predicate
+*/
+bool
+d_tests_sa_specialize_agreement
+(
+    struct d_test_counter* _counter
+)
+{
+    bool   result;
+    int    values[100];
+    int    typed_out[100];
+    int    generic_out[100];
+    int    typed_total;
+    int    generic_total;
+    int    threshold;
+    size_t typed_count;
+    size_t generic_count;
+    size_t i;
+
+    result = true;
+
+    spec_fill(values, 100);
+
+    // test 1: map
+    result = d_assert_standalone(
+        (spec_int_map(values, typed_out, 100, spec_square, NULL))      &&
+        (d_functional_map(values, generic_out, 100, sizeof(int),
+                          spec_square, NULL))                           &&
+        (memcmp(typed_out, generic_out, sizeof(typed_out)) == 0),
+        "specialize_map",
+        "typed map should match d_functional_map",
+        _counter) && result;
+
+    // test 2: filter with a context
+    threshold     = 25;
+    typed_count   = spec_int_filter(values, typed_out, 100,
+                                    spec_greater_than, &threshold);
+    generic_count = 0;
+
+    for (i = 0; i < 100; i++)
+    {
+        if (values[i] > threshold)
+        {
+            generic_out[generic_count++] = values[i];
+        }
+    }
+
+    result = d_assert_standalone(
+        (typed_count == generic_count)                                  &&
+        (typed_count > 0)                                               &&
+        (memcmp(typed_out, generic_out,
+                typed_count * sizeof(int)) == 0),
+        "specialize_filter",
+        "typed filter should keep the matching elements in order",
+        _counter) && result;
+
+    // test 3: fold
+    typed_total   = 0;
+    generic_total = 0;
+
+    result = d_assert_standalone(
+        (spec_int_fold(values, 100, &typed_total, spec_sum, NULL))     &&
+        (d_functional_fold_left(values, 100, sizeof(int),
+                                &generic_total, spec_sum, NULL))        &&
+        (typed_total == generic_total),
+        "specialize_fold",
+        "typed fold should match d_functional_fold_left",
+        _counter) && result;
+
+    // test 4: quantifiers
+    result = d_assert_standalone(
+        (spec_int_count_if(values, 100, spec_is_positive, NULL) ==
+             d_functional_count_if(values, 100, sizeof(int),
+                                   spec_is_positive, NULL))             &&
+        (spec_int_find_if(values, 100, spec_greater_than, &threshold) ==
+             d_functional_find_if(values, 100, sizeof(int),
+                                  spec_greater_than, &threshold))       &&
+        (spec_int_any(values, 100, spec_is_positive, NULL))             &&
+        (!spec_int_all(values, 100, spec_is_positive, NULL))            &&
+        (!spec_int_none(values, 100, spec_is_positive, NULL))           &&
+        (spec_int_all(&values[2], 1, spec_is_positive, NULL)),
+        "specialize_quantifiers",
+        "typed quantifiers should match the generic ones",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_specialize_short_circuit
+  Tests that the specialized quantifiers stop early.
+  Tests the following:
+  - any / find_if stop at the first match
+  - all stops at the first failure
+  - fold and map stop at the first failing callback
+*/
+bool
+d_tests_sa_specialize_short_circuit
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+    int  values[10] = { 5, 4, -3, 2, -1, 0, 1, 2, 3, 4 };
+    int  out[10];
+    int  calls;
+
+    result = true;
+
+    // test 1: any and find_if
+    calls = 0;
+
+    result = d_assert_standalone(
+        (spec_int_any(values, 10, spec_counted_negative, &calls))      &&
+        (calls == 3),
+        "specialize_any_early",
+        "any should stop at the first match",
+        _counter) && result;
+
+    calls = 0;
+
+    result = d_assert_standalone(
+        (spec_int_find_if(values, 10, spec_counted_negative,
+                          &calls) == &values[2])                        &&
+        (calls == 3),
+        "specialize_find_if_early",
+        "find_if should return the first match",
+        _counter) && result;
+
+    // test 2: all
+    calls = 0;
+
+    result = d_assert_standalone(
+        (!spec_int_all(values, 10, spec_is_positive, NULL))            &&
+        (!spec_int_none(values, 10, spec_counted_negative, &calls))    &&
+        (calls == 3),
+        "specialize_all_early",
+        "all and none should stop at the deciding element",
+        _counter) && result;
+
+    // test 3: failing callbacks
+    result = d_assert_standalone(
+        (!spec_int_map(values, out, 10, spec_fail_at_zero, NULL))      &&
+        (out[4] == -1),
+        "specialize_map_failure",
+        "map should stop at the first failing transform",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_specialize_fused
+  Tests the fused filter-map-fold.
+  Tests the following:
+  - the result matches filter, then map, then fold
+  - a NULL test folds every element
+  - a failing transform is reported
+*/
+bool
+d_tests_sa_specialize_fused
+(
+    struct d_test_counter* _counter
+)
+{
+    bool   result;
+    int    values[100];
+    int    filtered[100];
+    int    mapped[100];
+    int    fused_total;
+    int    staged_total;
+    int    threshold;
+    size_t kept;
+
+    result    = true;
+    threshold = 10;
+
+    spec_fill(values, 100);
+
+    // test 1: fused vs staged
+    kept         = spec_int_filter(values, filtered, 100,
+                                   spec_greater_than, &threshold);
+    staged_total = 0;
+    fused_total  = 0;
+
+    spec_int_map(filtered, mapped, kept, spec_square, NULL);
+    spec_int_fold(mapped, kept, &staged_total, spec_sum, NULL);
+
+    result = d_assert_standalone(
+        (spec_int_filter_map_fold(values, 100,
+                                  spec_greater_than, &threshold,
+                                  spec_square, NULL,
+                                  &fused_total, spec_sum, NULL))        &&
+        (fused_total == staged_total)                                   &&
+        (fused_total > 0),
+        "specialize_fused_matches",
+        "the fused pass should equal filter, map, then fold",
+        _counter) && result;
+
+    // test 2: no test
+    fused_total  = 0;
+    staged_total = 0;
+
+    spec_int_map(values, mapped, 100, spec_square, NULL);
+    spec_int_fold(mapped, 100, &staged_total, spec_sum, NULL);
+
+    result = d_assert_standalone(
+        (spec_int_filter_map_fold(values, 100,
+                                  NULL, NULL,
+                                  spec_square, NULL,
+                                  &fused_total, spec_sum, NULL))        &&
+        (fused_total == staged_total),
+        "specialize_fused_no_test",
+        "a NULL test should fold every mapped element",
+        _counter) && result;
+
+    // test 3: failing transform
+    values[50]  = 0;
+    fused_total = 0;
+
+    result = d_assert_standalone(
+        (!spec_int_filter_map_fold(values, 100,
+                                   NULL, NULL,
+                                   spec_fail_at_zero, NULL,
+                                   &fused_total, spec_sum, NULL)),
+        "specialize_fused_failure",
+        "a failing transform should fail the fused pass",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_specialize_struct
+  Tests a specialization over a struct type.
+  Tests the following:
+  - count_if and find_if over struct elements
+  - map writes whole structs
+  - fused filter-map-fold with a different accumulator type
+*/
+bool
+d_tests_sa_specialize_struct
+(
+    struct d_test_counter* _counter
+)
+{
+    bool               result;
+    struct spec_point  points[20];
+    struct spec_point  swapped[20];
+    struct spec_point* found;
+    int                total;
+    size_t             i;
+
+    result = true;
+
+    for (i = 0; i < 20; i++)
+    {
+        points[i].x = (int)i;
+        points[i].y = (int)((i % 4 == 0) ? i : (i + 1));
+    }
+
+    // test 1: quantifiers
+    found = spec_point_array_find_if(&points[1], 19,
+                                     spec_on_diagonal, NULL);
+
+    result = d_assert_standalone(
+        (spec_point_array_count_if(points, 20,
+                                   spec_on_diagonal, NULL) == 5)        &&
+        (found == &points[4]),
+        "specialize_struct_query",
+        "struct quantifiers should see every fifth element",
+        _counter) && result;
+
+    // test 2: map
+    result = d_assert_standalone(
+        (spec_point_array_map(points, swapped, 20,
+                              spec_swap_point, NULL))                   &&
+        (swapped[3].x == 4)                                             &&
+        (swapped[3].y == 3),
+        "specialize_struct_map",
+        "struct map should write whole elements",
+        _counter) && result;
+
+    // test 3: fused into an int
+    total = 0;
+
+    result = d_assert_standalone(
+        (spec_point_array_filter_map_fold(points, 20,
+                                          spec_on_diagonal, NULL,
+                                          spec_swap_point, NULL,
+                                          &total, spec_sum_x, NULL))    &&
+        (total == 0 + 4 + 8 + 12 + 16),
+        "specialize_struct_fused",
+        "the fused pass may fold into a different type",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_specialize_ops_all
+  Aggregation function that runs all specialization tests.
+*/
+bool
+d_tests_sa_specialize_ops_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Typed Specializations\n");
+    printf("  -------------------------------\n");
+
+    result = d_tests_sa_specialize_validation(_counter) && result;
+    result = d_tests_sa_specialize_agreement(_counter) && result;
+    result = d_tests_sa_specialize_short_circuit(_counter) && result;
+    result = d_tests_sa_specialize_fused(_counter) && result;
+    result = d_tests_sa_specialize_struct(_counter) && result;
+
+    return result;
+}
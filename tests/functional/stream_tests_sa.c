@@ -0,0 +1,26 @@
+#include ".\stream_tests_sa.h"
+
+
+/*
+d_tests_sa_stream_run_all
+  Module-level aggregation function that runs all stream tests.
+  Executes tests for all categories:
+  - Chunked array sources
+  - Streams: stages, take, terminal operations, and errors
+*/
+bool
+d_tests_sa_stream_run_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    // run all test categories
+    result = d_tests_sa_stream_source_all(_counter)   && result;
+    result = d_tests_sa_stream_pipeline_all(_counter) && result;
+
+    return result;
+}
@@ -0,0 +1,56 @@
+/******************************************************************************
+* djinterp [test]                                             stream_tests_sa.h
+*
+*   Unit test declarations for `stream.h` module.
+*   Provides testing of chunked array sources and of streams over them:
+* stage counters carried across chunk boundaries, a satisfied take that
+* stops pulling, streams used as sources, and fold, fold_multi, and collect
+* results that match the eager operations for every chunk size.
+*
+*
+* path:      \tests\functional\stream_tests_sa.h
+* link(s):   TBA
+* author(s): Samuel 'teer' Neal-Blim                          date: 2026.02.09
+******************************************************************************/
+
+#ifndef DJINTERP_TESTS_STREAM_SA_
+#define DJINTERP_TESTS_STREAM_SA_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "..\..\inc\djinterp.h"
+#include "..\..\inc\test\test_standalone.h"
+#include "..\..\inc\functional\functional.h"
+#include "..\..\inc\functional\stream.h"
+
+
+/******************************************************************************
+ * I. SOURCE TESTS
+ *****************************************************************************/
+bool d_tests_sa_stream_source_array(struct d_test_counter* _counter);
+bool d_tests_sa_stream_source_validation(struct d_test_counter* _counter);
+
+// I.   aggregation function
+bool d_tests_sa_stream_source_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * II. PIPELINE TESTS
+ *****************************************************************************/
+bool d_tests_sa_stream_pipeline_stages(struct d_test_counter* _counter);
+bool d_tests_sa_stream_pipeline_take(struct d_test_counter* _counter);
+bool d_tests_sa_stream_pipeline_terminal(struct d_test_counter* _counter);
+bool d_tests_sa_stream_pipeline_errors(struct d_test_counter* _counter);
+
+// II.  aggregation function
+bool d_tests_sa_stream_pipeline_all(struct d_test_counter* _counter);
+
+
+/******************************************************************************
+ * MODULE-LEVEL AGGREGATION
+ *****************************************************************************/
+bool d_tests_sa_stream_run_all(struct d_test_counter* _counter);
+
+
+#endif  // DJINTERP_TESTS_STREAM_SA_
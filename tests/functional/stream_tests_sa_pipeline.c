@@ -0,0 +1,623 @@
+#include ".\stream_tests_sa.h"
+
+
+D_DEFINE_ACC_SUM(stream_acc_sum_int, int)
+D_DEFINE_ACC_COUNT(stream_acc_count)
+
+
+// stream_is_even
+//   helper: predicate true for even ints.
+static bool
+stream_is_even
+(
+    const void* _element,
+    void*       _context
+)
+{
+    (void)_context;
+
+    return ((*(const int*)_element % 2) == 0);
+}
+
+// stream_double
+//   helper: transformer doubling an int; fails on the int context, if any.
+static bool
+stream_double
+(
+    const void* _input,
+    void*       _output,
+    void*       _context
+)
+{
+    if ( (_context) &&
+         (*(const int*)_input == *(const int*)_context) )
+    {
+        return false;
+    }
+
+    *(int*)_output = *(const int*)_input * 2;
+
+    return true;
+}
+
+// stream_increment
+//   helper: consumer adding one to an int and counting its calls in the
+// size_t context.
+static void
+stream_increment
+(
+    void* _element,
+    void* _context
+)
+{
+    (*(int*)_element)++;
+    (*(size_t*)_context)++;
+
+    return;
+}
+
+// stream_counting_next
+//   helper: fn_source_next forwarding to the source in state[0] and
+// counting the pulls that returned elements in state[1].
+static bool
+stream_counting_next
+(
+    void*        _context,
+    const void** _chunk,
+    size_t*      _count
+)
+{
+    void** state;
+    bool   ok;
+
+    state = (void**)_context;
+    ok    = d_functional_source_next(
+                (struct d_functional_source*)state[0], _chunk, _count);
+
+    if ( (ok) &&
+         (*_count > 0) )
+    {
+        (*(size_t*)state[1])++;
+    }
+
+    return ok;
+}
+
+// stream_failing_next
+//   helper: fn_source_next that always fails.
+static bool
+stream_failing_next
+(
+    void*        _context,
+    const void** _chunk,
+    size_t*      _count
+)
+{
+    (void)_context;
+    (void)_chunk;
+    (void)_count;
+
+    return false;
+}
+
+
+/*
+d_tests_sa_stream_pipeline_stages
+  Tests streams of map, filter, for_each, take, and skip stages.
+  Tests the following:
+  - the output is the same for chunk sizes from 1 element to the whole
+    input, so skip and take counters carry across chunks
+  - for_each sees (and may modify) exactly the elements reaching it, and
+    does not modify the source array
+  - for_each after a skip over mapped data modifies the emitted elements,
+    not the skipped ones
+  - a stream used as the source of another stream
+*/
+bool
+d_tests_sa_stream_pipeline_stages
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                             result;
+    bool                             ok;
+    struct d_functional_array_source state;
+    struct d_functional_stream*      stream;
+    struct d_functional_stream*      outer;
+    int                              values[100];
+    int*                             collected;
+    size_t                           chunk_sizes[5];
+    size_t                           calls;
+    size_t                           n;
+    size_t                           s;
+    size_t                           i;
+
+    result = true;
+
+    for (i = 0; i < 100; i++)
+    {
+        values[i] = (int)i;
+    }
+
+    chunk_sizes[0] = 1;
+    chunk_sizes[1] = 3;
+    chunk_sizes[2] = 7;
+    chunk_sizes[3] = 64;
+    chunk_sizes[4] = 0;
+    ok             = true;
+
+    // test 1: skip 5, evens, +1, doubled, take 10 -> 14, 18, ..., 50
+    for (s = 0; s < 5; s++)
+    {
+        calls  = 0;
+        stream = d_functional_stream_new(
+                     d_functional_source_array(&state,
+                                               values,
+                                               100,
+                                               sizeof(int),
+                                               chunk_sizes[s]));
+
+        d_functional_stream_skip(stream, 5);
+        d_functional_stream_filter(stream, stream_is_even, NULL);
+        d_functional_stream_for_each(stream, stream_increment, &calls);
+        d_functional_stream_map(stream, stream_double, NULL);
+        d_functional_stream_take(stream, 10);
+
+        collected = d_functional_stream_collect(stream, &n);
+        ok        = ok && (collected) && (n == 10);
+
+        for (i = 0; (ok) && (i < n); i++)
+        {
+            ok = (collected[i] == (int)(14 + (4 * i)));
+        }
+
+        // for_each only ran on the chunks that were pulled
+        ok = ok && (calls >= 10) && (values[6] == 6);
+
+        d_functional_free(collected);
+        d_functional_stream_free(stream);
+    }
+
+    result = d_assert_standalone(
+        ok,
+        "stream_stages_chunk_sizes",
+        "every chunk size should give the same stage output",
+        _counter) && result;
+
+    // test 2: map, skip 2, for_each over 1..6 -> 7, 9, 11, 13
+    calls  = 0;
+    stream = d_functional_stream_new(
+                 d_functional_source_array(&state, values + 1, 6,
+                                           sizeof(int), 0));
+
+    d_functional_stream_map(stream, stream_double, NULL);
+    d_functional_stream_skip(stream, 2);
+    d_functional_stream_for_each(stream, stream_increment, &calls);
+
+    collected = d_functional_stream_collect(stream, &n);
+    ok        = (collected) && (n == 4) && (calls == 4);
+
+    for (i = 0; (ok) && (i < n); i++)
+    {
+        ok = (collected[i] == (int)(7 + (2 * i)));
+    }
+
+    result = d_assert_standalone(
+        ok,
+        "stream_stages_for_each_after_skip",
+        "for_each after a skip should modify the emitted elements",
+        _counter) && result;
+
+    d_functional_free(collected);
+    d_functional_stream_free(stream);
+
+    // test 3: a stream as a source
+    stream = d_functional_stream_filter(
+                 d_functional_stream_new(
+                     d_functional_source_array(&state, values, 100,
+                                               sizeof(int), 9)),
+                 stream_is_even,
+                 NULL);
+    outer  = d_functional_stream_map(
+                 d_functional_stream_new(d_functional_stream_source(stream)),
+                 stream_double,
+                 NULL);
+
+    collected = d_functional_stream_collect(outer, &n);
+    ok        = (collected) && (n == 50);
+
+    for (i = 0; (ok) && (i < n); i++)
+    {
+        ok = (collected[i] == (int)(4 * i));
+    }
+
+    result = d_assert_standalone(
+        ok,
+        "stream_as_source",
+        "a stream should feed another stream",
+        _counter) && result;
+
+    d_functional_free(collected);
+    d_functional_stream_free(outer);
+    d_functional_stream_free(stream);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_stream_pipeline_take
+  Tests that a satisfied take stops pulling from the source.
+  Tests the following:
+  - take(5) over 2-element chunks pulls 3 chunks
+  - take(5) after a filter pulls only until 5 elements passed
+  - take(0) pulls nothing
+*/
+bool
+d_tests_sa_stream_pipeline_take
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                             result;
+    struct d_functional_array_source state;
+    struct d_functional_source       inner;
+    struct d_functional_source       counted;
+    struct d_functional_stream*      stream;
+    void*                            counter_state[2];
+    int                              values[100];
+    int*                             collected;
+    size_t                           pulls;
+    size_t                           n;
+    size_t                           i;
+
+    result = true;
+
+    for (i = 0; i < 100; i++)
+    {
+        values[i] = (int)i;
+    }
+
+    counter_state[0]     = &inner;
+    counter_state[1]     = &pulls;
+    counted.next_chunk   = stream_counting_next;
+    counted.context      = counter_state;
+    counted.element_size = sizeof(int);
+
+    // test 1: plain take
+    pulls  = 0;
+    inner  = d_functional_source_array(&state, values, 100, sizeof(int), 2);
+    stream = d_functional_stream_take(d_functional_stream_new(counted), 5);
+
+    collected = d_functional_stream_collect(stream, &n);
+
+    result = d_assert_standalone(
+        (collected)      &&
+        (n == 5)         &&
+        (collected[4] == 4) &&
+        (pulls == 3),
+        "stream_take_pulls",
+        "take(5) over 2-element chunks should pull 3 chunks",
+        _counter) && result;
+
+    d_functional_free(collected);
+    d_functional_stream_free(stream);
+
+    // test 2: take after filter (evens 0..8 are in the first 9 elements)
+    pulls  = 0;
+    inner  = d_functional_source_array(&state, values, 100, sizeof(int), 3);
+    stream = d_functional_stream_new(counted);
+    d_functional_stream_filter(stream, stream_is_even, NULL);
+    d_functional_stream_take(stream, 5);
+
+    collected = d_functional_stream_collect(stream, &n);
+
+    result = d_assert_standalone(
+        (collected)          &&
+        (n == 5)             &&
+        (collected[4] == 8)  &&
+        (pulls == 3),
+        "stream_take_after_filter",
+        "take(5) of evens over 3-element chunks should pull 3 chunks",
+        _counter) && result;
+
+    d_functional_free(collected);
+    d_functional_stream_free(stream);
+
+    // test 3: take(0)
+    pulls  = 0;
+    inner  = d_functional_source_array(&state, values, 100, sizeof(int), 2);
+    stream = d_functional_stream_take(d_functional_stream_new(counted), 0);
+
+    collected = d_functional_stream_collect(stream, &n);
+
+    result = d_assert_standalone(
+        (collected) &&
+        (n == 0)    &&
+        (pulls == 0),
+        "stream_take_zero",
+        "take(0) should pull nothing and give an empty result",
+        _counter) && result;
+
+    d_functional_free(collected);
+    d_functional_stream_free(stream);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_stream_pipeline_terminal
+  Tests the terminal operations.
+  Tests the following:
+  - fold carries its accumulator across chunks and matches
+    d_functional_fold_left
+  - fold_multi matches d_functional_fold_multi
+  - collect of an empty output is a non-NULL allocation of 0 elements
+  - chunk-at-a-time consumption with d_functional_stream_next
+*/
+bool
+d_tests_sa_stream_pipeline_terminal
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                             result;
+    struct d_functional_array_source state;
+    struct d_functional_stream*      stream;
+    struct d_fold_spec               specs[2];
+    const void*                      chunk;
+    int                              values[1000];
+    int                              sum;
+    int                              eager_sum;
+    int*                             collected;
+    size_t                           count;
+    size_t                           total;
+    size_t                           chunks;
+    size_t                           n;
+    size_t                           i;
+
+    result = true;
+
+    for (i = 0; i < 1000; i++)
+    {
+        values[i] = (int)((i * 37) % 101) - 50;
+    }
+
+    // test 1: fold
+    sum       = 0;
+    eager_sum = 0;
+    stream    = d_functional_stream_new(
+                    d_functional_source_array(&state, values, 1000,
+                                              sizeof(int), 33));
+    d_functional_fold_left(values, 1000, sizeof(int), &eager_sum,
+                           stream_acc_sum_int, NULL);
+
+    result = d_assert_standalone(
+        (d_functional_stream_fold(stream, &sum,
+                                  stream_acc_sum_int, NULL))   &&
+        (sum == eager_sum),
+        "stream_fold",
+        "a streamed fold should match d_functional_fold_left",
+        _counter) && result;
+
+    d_functional_stream_free(stream);
+
+    // test 2: fold_multi over the evens
+    sum                  = 0;
+    count                = 0;
+    specs[0].accumulator = &sum;
+    specs[0].step        = stream_acc_sum_int;
+    specs[0].context     = NULL;
+    specs[1].accumulator = &count;
+    specs[1].step        = stream_acc_count;
+    specs[1].context     = NULL;
+    eager_sum            = 0;
+    total                = 0;
+
+    for (i = 0; i < 1000; i++)
+    {
+        if ((values[i] % 2) == 0)
+        {
+            eager_sum += values[i];
+            total++;
+        }
+    }
+
+    stream = d_functional_stream_filter(
+                 d_functional_stream_new(
+                     d_functional_source_array(&state, values, 1000,
+                                               sizeof(int), 64)),
+                 stream_is_even,
+                 NULL);
+
+    result = d_assert_standalone(
+        (d_functional_stream_fold_multi(stream, specs, 2)) &&
+        (sum == eager_sum)                                 &&
+        (count == total),
+        "stream_fold_multi",
+        "a streamed fold_multi should match the eager aggregates",
+        _counter) && result;
+
+    d_functional_stream_free(stream);
+
+    // test 3: empty collect
+    stream = d_functional_stream_skip(
+                 d_functional_stream_new(
+                     d_functional_source_array(&state, values, 1000,
+                                               sizeof(int), 64)),
+                 5000);
+
+    collected = d_functional_stream_collect(stream, &n);
+
+    result = d_assert_standalone(
+        (collected != NULL) &&
+        (n == 0),
+        "stream_collect_empty",
+        "an empty output should be a non-NULL allocation of 0 elements",
+        _counter) && result;
+
+    d_functional_free(collected);
+    d_functional_stream_free(stream);
+
+    // test 4: chunk-at-a-time consumption
+    stream = d_functional_stream_new(
+                 d_functional_source_array(&state, values, 1000,
+                                           sizeof(int), 100));
+    total  = 0;
+    chunks = 0;
+
+    while ( (d_functional_stream_next(stream, &chunk, &n)) &&
+            (n > 0) )
+    {
+        total += n;
+        chunks++;
+    }
+
+    result = d_assert_standalone(
+        (total == 1000) &&
+        (chunks == 10)  &&
+        (stream->error_code == 0),
+        "stream_next_chunks",
+        "stream_next should return each chunk, then 0 elements",
+        _counter) && result;
+
+    d_functional_stream_free(stream);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_stream_pipeline_errors
+  Tests error handling of streams.
+  Tests the following:
+  - an invalid source gives no stream
+  - a NULL stage callback sets error_code; later stages are no-ops
+  - a failing transformer and a failing source set error_code and make the
+    terminal operations fail
+  - NULL-safety of stages and free
+*/
+bool
+d_tests_sa_stream_pipeline_errors
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                             result;
+    struct d_functional_array_source state;
+    struct d_functional_source       failing;
+    struct d_functional_stream*      stream;
+    int                              values[10];
+    int                              poison;
+    int                              sum;
+    size_t                           n;
+    size_t                           i;
+
+    result = true;
+
+    for (i = 0; i < 10; i++)
+    {
+        values[i] = (int)i;
+    }
+
+    // test 1: invalid source
+    result = d_assert_standalone(
+        (d_functional_stream_new(
+             d_functional_source_array(NULL, values, 10,
+                                       sizeof(int), 2)) == NULL),
+        "stream_invalid_source",
+        "a source without next_chunk should give no stream",
+        _counter) && result;
+
+    // test 2: NULL stage callback
+    stream = d_functional_stream_new(
+                 d_functional_source_array(&state, values, 10,
+                                           sizeof(int), 2));
+    d_functional_stream_map(stream, NULL, NULL);
+    d_functional_stream_take(stream, 3);
+
+    result = d_assert_standalone(
+        (stream->error_code != 0)                            &&
+        (stream->stage_count == 0)                           &&
+        (d_functional_stream_collect(stream, &n) == NULL),
+        "stream_null_stage",
+        "a NULL callback should set error_code and block later stages",
+        _counter) && result;
+
+    d_functional_stream_free(stream);
+
+    // test 3: failing transformer
+    poison = 7;
+    sum    = 0;
+    stream = d_functional_stream_map(
+                 d_functional_stream_new(
+                     d_functional_source_array(&state, values, 10,
+                                               sizeof(int), 3)),
+                 stream_double,
+                 &poison);
+
+    result = d_assert_standalone(
+        (!d_functional_stream_fold(stream, &sum,
+                                   stream_acc_sum_int, NULL))   &&
+        (stream->error_code != 0),
+        "stream_transform_failure",
+        "a failing transformer should fail the fold",
+        _counter) && result;
+
+    d_functional_stream_free(stream);
+
+    // test 4: failing source
+    failing.next_chunk   = stream_failing_next;
+    failing.context      = NULL;
+    failing.element_size = sizeof(int);
+    stream               = d_functional_stream_new(failing);
+
+    result = d_assert_standalone(
+        (d_functional_stream_collect(stream, &n) == NULL) &&
+        (n == 0)                                          &&
+        (stream->error_code != 0),
+        "stream_source_failure",
+        "a failing source should fail collect",
+        _counter) && result;
+
+    d_functional_stream_free(stream);
+
+    // test 5: NULL safety
+    result = d_assert_standalone(
+        (d_functional_stream_take(NULL, 1) == NULL)                  &&
+        (d_functional_stream_filter(NULL, stream_is_even, NULL) == NULL),
+        "stream_null_safety",
+        "stages on a NULL stream should return NULL",
+        _counter) && result;
+
+    d_functional_stream_free(NULL);
+
+    return result;
+}
+
+
+/*
+d_tests_sa_stream_pipeline_all
+  Aggregation function that runs all stream pipeline tests.
+*/
+bool
+d_tests_sa_stream_pipeline_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Streams\n");
+    printf("  -----------------\n");
+
+    result = d_tests_sa_stream_pipeline_stages(_counter)   && result;
+    result = d_tests_sa_stream_pipeline_take(_counter)     && result;
+    result = d_tests_sa_stream_pipeline_terminal(_counter) && result;
+    result = d_tests_sa_stream_pipeline_errors(_counter)   && result;
+
+    return result;
+}
@@ -0,0 +1,171 @@
+#include ".\stream_tests_sa.h"
+
+
+/*
+d_tests_sa_stream_source_array
+  Tests d_functional_source_array and d_functional_source_next.
+  Tests the following:
+  - chunks of the requested size, with a short final chunk
+  - a chunk count of 0 hands out the whole array at once
+  - the end of the input is a chunk of 0 elements, repeatedly
+  - chunks point into the original array
+*/
+bool
+d_tests_sa_stream_source_array
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                             result;
+    bool                             ok;
+    struct d_functional_array_source state;
+    struct d_functional_source       source;
+    const void*                      chunk;
+    int                              values[10];
+    size_t                           sizes[4];
+    size_t                           pulls;
+    size_t                           n;
+    size_t                           i;
+
+    result = true;
+
+    for (i = 0; i < 10; i++)
+    {
+        values[i] = (int)i;
+    }
+
+    // test 1: chunks of 4, 4, and 2
+    source = d_functional_source_array(&state, values, 10, sizeof(int), 4);
+    ok     = true;
+    pulls  = 0;
+
+    while ( (ok) && (pulls < 4) )
+    {
+        ok = d_functional_source_next(&source, &chunk, &n);
+        sizes[pulls] = n;
+
+        if ( (ok) && (n > 0) )
+        {
+            ok = (chunk == &values[pulls * 4]);
+        }
+
+        pulls++;
+    }
+
+    result = d_assert_standalone(
+        (ok)              &&
+        (sizes[0] == 4)   &&
+        (sizes[1] == 4)   &&
+        (sizes[2] == 2)   &&
+        (sizes[3] == 0),
+        "source_array_chunks",
+        "an array source should hand out 4, 4, 2, then 0 elements",
+        _counter) && result;
+
+    // test 2: end of input is repeatable
+    result = d_assert_standalone(
+        (d_functional_source_next(&source, &chunk, &n)) &&
+        (n == 0),
+        "source_array_end",
+        "pulling past the end should keep returning 0 elements",
+        _counter) && result;
+
+    // test 3: whole array at once
+    source = d_functional_source_array(&state, values, 10, sizeof(int), 0);
+
+    result = d_assert_standalone(
+        (d_functional_source_next(&source, &chunk, &n)) &&
+        (n == 10)                                       &&
+        (chunk == values)                               &&
+        (d_functional_source_next(&source, &chunk, &n)) &&
+        (n == 0),
+        "source_array_whole",
+        "a chunk count of 0 should hand out the whole array",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_stream_source_validation
+  Tests parameter validation of the sources.
+  Tests the following:
+  - NULL state, NULL data with elements, and zero element size give a
+    source without next_chunk
+  - an empty array is a valid source that ends immediately
+  - NULL parameters to d_functional_source_next are rejected
+*/
+bool
+d_tests_sa_stream_source_validation
+(
+    struct d_test_counter* _counter
+)
+{
+    bool                             result;
+    struct d_functional_array_source state;
+    struct d_functional_source       source;
+    const void*                      chunk;
+    int                              values[2] = { 1, 2 };
+    size_t                           n;
+
+    result = true;
+
+    // test 1: invalid sources
+    result = d_assert_standalone(
+        (d_functional_source_array(NULL, values, 2,
+                                   sizeof(int), 1).next_chunk == NULL)  &&
+        (d_functional_source_array(&state, NULL, 2,
+                                   sizeof(int), 1).next_chunk == NULL)  &&
+        (d_functional_source_array(&state, values, 2,
+                                   0, 1).next_chunk == NULL),
+        "source_array_rejection",
+        "invalid parameters should give a source without next_chunk",
+        _counter) && result;
+
+    // test 2: empty input
+    source = d_functional_source_array(&state, NULL, 0, sizeof(int), 4);
+
+    result = d_assert_standalone(
+        (source.next_chunk != NULL)                     &&
+        (d_functional_source_next(&source, &chunk, &n)) &&
+        (n == 0),
+        "source_array_empty",
+        "an empty array should end immediately",
+        _counter) && result;
+
+    // test 3: NULL parameters
+    result = d_assert_standalone(
+        (!d_functional_source_next(NULL, &chunk, &n))    &&
+        (!d_functional_source_next(&source, NULL, &n))   &&
+        (!d_functional_source_next(&source, &chunk, NULL)),
+        "source_next_rejection",
+        "NULL parameters to source_next should be rejected",
+        _counter) && result;
+
+    return result;
+}
+
+
+/*
+d_tests_sa_stream_source_all
+  Aggregation function that runs all source tests.
+*/
+bool
+d_tests_sa_stream_source_all
+(
+    struct d_test_counter* _counter
+)
+{
+    bool result;
+
+    result = true;
+
+    printf("\n  [SECTION] Sources\n");
+    printf("  -----------------\n");
+
+    result = d_tests_sa_stream_source_array(_counter)      && result;
+    result = d_tests_sa_stream_source_validation(_counter) && result;
+
+    return result;
+}